@@ -12,6 +12,7 @@
 #include "brain/index_tuner.h"
 
 #include <algorithm>
+#include <thread>
 #include <unordered_map>
 #include <include/brain/brain_util.h>
 
@@ -94,43 +95,32 @@ static void AddIndex(storage::DataTable* table,
 
 void IndexTuner::BuildIndex(storage::DataTable* table,
                             std::shared_ptr<index::Index> index) {
-  auto table_schema = table->GetSchema();
-  auto index_tile_group_offset = index->GetIndexedTileGroupOff();
-  auto table_tile_group_count = table->GetTileGroupCount();
-  oid_t tile_groups_indexed = 0;
-
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  while (index_tile_group_offset < table_tile_group_count &&
-         (tile_groups_indexed < tile_groups_indexed_per_iteration)) {
-    std::unique_ptr<storage::Tuple> tuple_ptr(
-        new storage::Tuple(table_schema, true));
-
-    auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-      // Setup container tuple
-      expression::ContainerTuple<storage::TileGroup> container_tuple(
-          tile_group.get(), tuple_id);
-
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
+  size_t index_tile_group_offset = index->GetIndexedTileGroupOff();
+  size_t table_tile_group_count = table->GetTileGroupCount();
+
+  // The first build covers all tile groups, so that the index is built
+  // bottom-up in one pass. Later builds add the tile groups that were added
+  // to the table since then, a few at a time.
+  size_t end_tile_group_offset = table_tile_group_count;
+  if (index_tile_group_offset > 0) {
+    end_tile_group_offset =
+        std::min<size_t>(index_tile_group_offset +
+                             tile_groups_indexed_per_iteration,
+                         table_tile_group_count);
+  }
 
-      // Set the key
-      key->SetFromTuple(&container_tuple, indexed_columns, index->GetPool());
+  if (index_tile_group_offset >= end_tile_group_offset) {
+    return;
+  }
 
-      // Insert in specific index
-      // TODO: Allocate itempointer ?
-      index->InsertEntry(key.get(), &location);
-    }
+  size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  table->BuildIndex(index.get(), index_tile_group_offset,
+                    end_tile_group_offset, thread_count);
 
-    // Update indexed tile group offset (set of tgs indexed)
+  // Update indexed tile group offset (set of tgs indexed)
+  oid_t tile_groups_indexed = 0;
+  while (index_tile_group_offset < end_tile_group_offset) {
     index->IncrementIndexedTileGroupOffset();
-
     index_tile_group_offset++;
     tile_groups_indexed++;
   }
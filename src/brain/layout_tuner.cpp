@@ -19,7 +19,12 @@
 #include "catalog/schema.h"
 #include "common/logger.h"
 #include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_freezer.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace brain {
@@ -29,9 +34,8 @@ LayoutTuner& LayoutTuner::GetInstance() {
   return layout_tuner;
 }
 
-LayoutTuner::LayoutTuner() {
-  // Nothing to do here !
-}
+LayoutTuner::LayoutTuner()
+    : layout_tuning_stop(true), transformed_tile_group_count(0) {}
 
 LayoutTuner::~LayoutTuner() {}
 
@@ -150,25 +154,171 @@ void LayoutTuner::UpdateDefaultPartition(storage::DataTable* table) {
   table->SetDefaultLayout(layout);
 }
 
-void LayoutTuner::Tune() {
-  Timer<std::milli> timer;
-  // Continue till signal is not false
-  while (layout_tuning_stop == false) {
-    // Go over all tables
-    for (auto table : tables) {
-      // Transform
-      auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
+// Lock a slot of a cold tile group. The latest version of a tuple is locked
+// the way an updating transaction would. Empty slots and older versions that
+// no transaction can read anymore are claimed directly, which also keeps the
+// garbage collector from resetting them until they are released.
+static bool LockVersion(concurrency::Transaction* txn,
+                        storage::TileGroupHeader* tile_group_header,
+                        const oid_t tuple_id, const cid_t expired_cid,
+                        bool& is_empty) {
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn_id = txn->GetTransactionId();
+
+  is_empty = tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID;
+  if (is_empty == true) {
+    return tile_group_header->SetAtomicTransactionId(
+               tuple_id, INVALID_TXN_ID, txn_id) == INVALID_TXN_ID;
+  }
+
+  if (tile_group_header->GetTransactionId(tuple_id) != INITIAL_TXN_ID ||
+      tile_group_header->GetDeltaRecord(tuple_id) != nullptr) {
+    return false;
+  }
+
+  cid_t end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  if (end_cid != MAX_CID) {
+    if (end_cid > expired_cid ||
+        tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+      return false;
+    }
+  } else if (txn_manager.AcquireOwnership(txn, tile_group_header, tuple_id) ==
+             false) {
+    return false;
+  }
+
+  // another transaction may have updated the version in the meantime, or the
+  // garbage collector made the older version the latest one again
+  if (tile_group_header->GetEndCommitId(tuple_id) != end_cid ||
+      tile_group_header->GetDeltaRecord(tuple_id) != nullptr) {
+    txn_manager.YieldOwnership(txn, tile_group_header, tuple_id);
+    return false;
+  }
+
+  return true;
+}
 
-      LOG_TRACE("Transforming tile group at offset: %lu", tile_group_offset);
-      table->TransformTileGroup(tile_group_offset, theta);
+bool LayoutTuner::TransformTileGroup(storage::DataTable* table,
+                                     const oid_t tile_group_offset,
+                                     const cid_t expired_cid) {
+  // The tile group is looked up again once its versions are locked
+  auto tile_group = table->InspectTileGroup(tile_group_offset);
+  if (tile_group == nullptr || tile_group->IsVersionTileGroup()) {
+    return false;
+  }
 
-      // Update partitioning periodically
-      UpdateDefaultPartition(table);
+  // Check threshold for transformation
+  auto diff = tile_group->GetSchemaDifference(table->GetDefaultLayout());
+  if (diff < theta) {
+    return false;
+  }
 
-      // Sleep a bit
-      std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
+  // Hot tile groups would keep their transactions waiting
+  if (storage::TileGroupFreezer::IsFreezable(tile_group.get(), expired_cid) ==
+      false) {
+    return false;
+  }
+
+  // A transaction that got hold of an empty slot writes it without owning
+  // it. The ones that do so after the reservation thaw the tile group, which
+  // cancels the transform or waits for it to finish. The ones that found the
+  // tile group unreserved have to finish first, so a later round transforms
+  // it.
+  tile_group->ReserveTransform();
+  auto reservation_lock = tile_group->LockReservation(expired_cid >> 32);
+  if (reservation_lock.owns_lock() == false) {
+    return false;
+  }
+
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tuple_count = tile_group->GetAllocatedTupleCount();
+  std::vector<bool> is_empty(tuple_count, false);
+  oid_t locked_count = 0;
+  while (locked_count < tuple_count) {
+    bool is_empty_slot = false;
+    if (LockVersion(txn, tile_group_header, locked_count, expired_cid,
+                    is_empty_slot) == false) {
+      break;
     }
+    is_empty[locked_count] = is_empty_slot;
+    locked_count++;
+  }
+
+  storage::TileGroup* new_tile_group = nullptr;
+  if (locked_count == tuple_count) {
+    LOG_TRACE("Transforming tile group at offset: %u", tile_group_offset);
+    new_tile_group = table->TransformTileGroup(tile_group_offset, theta);
+  }
+
+  // The copied versions are released in the new tile group, while the ones
+  // in the replaced tile group stay locked.
+  auto released_header = (new_tile_group != nullptr)
+                             ? new_tile_group->GetHeader()
+                             : tile_group_header;
+  for (oid_t tuple_id = 0; tuple_id < locked_count; tuple_id++) {
+    if (is_empty[tuple_id] == true) {
+      released_header->SetTransactionId(tuple_id, INVALID_TXN_ID);
+    } else {
+      txn_manager.YieldOwnership(txn, released_header, tuple_id);
+    }
+  }
+
+  txn_manager.CommitTransaction(txn);
+
+  return new_tile_group != nullptr;
+}
+
+oid_t LayoutTuner::TransformTable(storage::DataTable* table,
+                                  const cid_t expired_cid) {
+  oid_t transformed_count = 0;
+  oid_t tile_group_count = table->GetTileGroupCount();
+  auto& tile_group_offset = next_tile_group_offsets[table];
+
+  // Resume where the last round stopped
+  for (oid_t inspected_count = 0;
+       inspected_count < inspect_budget && inspected_count < tile_group_count &&
+           transformed_count < transform_budget;
+       inspected_count++) {
+    if (tile_group_offset >= tile_group_count) {
+      tile_group_offset = 0;
+    }
+
+    if (TransformTileGroup(table, tile_group_offset, expired_cid) == true) {
+      transformed_count++;
+    }
+    tile_group_offset++;
+  }
+
+  transformed_tile_group_count += transformed_count;
+  return transformed_count;
+}
+
+void LayoutTuner::Tune() {
+  // Continue till signal is not false
+  while (layout_tuning_stop == false) {
+    auto expired_cid =
+        concurrency::EpochManagerFactory::GetInstance().GetExpiredCid();
+
+    {
+      std::lock_guard<std::mutex> lock(layout_tuner_mutex);
+      // Go over all tables
+      for (auto table : tables) {
+        // Transform
+        UNUSED_ATTRIBUTE auto transformed_count =
+            TransformTable(table, expired_cid);
+        LOG_TRACE("Transformed %u tile groups of table %s", transformed_count,
+                  table->GetName().c_str());
+
+        // Update partitioning periodically
+        UpdateDefaultPartition(table);
+      }
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::microseconds(sleep_duration));
   }
 }
 
@@ -180,6 +330,8 @@ void LayoutTuner::Stop() {
   layout_tuner_thread.join();
 
   LOG_INFO("Stopped layout tuner");
+  LOG_INFO("Transformed tile groups : %lu",
+           transformed_tile_group_count.load());
 }
 
 void LayoutTuner::AddTable(storage::DataTable* table) {
@@ -195,6 +347,7 @@ void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    next_tile_group_offsets.clear();
   }
 }
 
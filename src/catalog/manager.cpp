@@ -17,6 +17,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace catalog {
@@ -50,9 +51,19 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
 
   location = tile_group_locator_.Find(oid);
 
+  // Keep the raw tiles of a frozen tile group around while it is in use
+  if (location != nullptr && location->IsFrozen() == true) {
+    location->RecordAccess();
+  }
+
   return location;
 }
 
+std::shared_ptr<storage::TileGroup> Manager::InspectTileGroup(
+    const oid_t oid) {
+  return tile_group_locator_.Find(oid);
+}
+
 // used for logging test
 void Manager::ClearTileGroup() { tile_group_locator_.Clear(empty_tile_group_); }
 
@@ -13,8 +13,11 @@
 #include "codegen/code_context.h"
 
 #include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/raw_os_ostream.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Transforms/Scalar.h"
@@ -22,6 +25,7 @@
 #include "llvm/Transforms/Scalar/GVN.h"
 #endif
 
+#include "codegen/object_cache.h"
 #include "common/logger.h"
 
 namespace peloton {
@@ -29,13 +33,43 @@ namespace codegen {
 
 static std::atomic<uint64_t> kIdCounter{0};
 
+namespace {
+
+// Hands the object found in the object cache to the JIT engine, or adds the
+// object the engine compiled to the cache
+class JITObjectCache : public llvm::ObjectCache {
+ public:
+  JITObjectCache(const std::string &key, std::shared_ptr<std::string> object)
+      : key_(key), object_(std::move(object)) {}
+
+  void notifyObjectCompiled(UNUSED_ATTRIBUTE const llvm::Module *module,
+                            llvm::MemoryBufferRef object) override {
+    auto &object_cache = codegen::ObjectCache::GetInstance();
+    object_cache.Insert(key_, object.getBufferStart(), object.getBufferSize());
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(
+      UNUSED_ATTRIBUTE const llvm::Module *module) override {
+    if (object_ == nullptr) {
+      return nullptr;
+    }
+    return llvm::MemoryBuffer::getMemBufferCopy(*object_);
+  }
+
+ private:
+  std::string key_;
+  std::shared_ptr<std::string> object_;
+};
+
+}  // namespace
+
 //===----------------------------------------------------------------------===//
 // Constructor
 //===----------------------------------------------------------------------===//
 CodeContext::CodeContext()
     : id_(kIdCounter++),
       context_(new llvm::LLVMContext()),
-      module_(new llvm::Module("_" + std::to_string(id_) + "_plan", *context_)),
+      module_(new llvm::Module("plan", *context_)),
       builder_(*context_),
       func_(nullptr),
       opt_pass_manager_(module_),
@@ -66,7 +100,8 @@ CodeContext::CodeContext()
   module_->setDataLayout(data_layout);
 #endif
 
-  // The set of optimization passes we include
+  // The set of optimization passes we include. Bump kCodegenVersion when
+  // changing them.
   opt_pass_manager_.add(llvm::createInstructionCombiningPass());
   opt_pass_manager_.add(llvm::createReassociatePass());
   opt_pass_manager_.add(llvm::createGVNPass());
@@ -118,15 +153,32 @@ bool CodeContext::Compile() {
     return false;
   }
 
+  // Queries with equal code share the machine code compiled for it. We look
+  // for it before optimizing, so that a hit skips the optimization passes too.
+  std::string object_key;
+  std::shared_ptr<std::string> object;
+  if (ObjectCache::IsEnabled()) {
+    object_key = GetObjectKey();
+    object = ObjectCache::GetInstance().Find(object_key);
+  }
+
   // Run each of our optimization passes over the functions in this module
-  opt_pass_manager_.doInitialization();
-  for (auto fn = module_->begin(), end = module_->end(); fn != end; fn++) {
-    opt_pass_manager_.run(*fn);
+  if (object == nullptr) {
+    opt_pass_manager_.doInitialization();
+    for (auto fn = module_->begin(), end = module_->end(); fn != end; fn++) {
+      opt_pass_manager_.run(*fn);
+    }
+    opt_pass_manager_.doFinalization();
   }
-  opt_pass_manager_.doFinalization();
 
-  // Finalize the object, this is where the JIT happens
+  // Finalize the object, this is where the JIT happens (or where the engine
+  // loads the cached object)
+  JITObjectCache jit_object_cache{object_key, object};
+  if (!object_key.empty()) {
+    jit_engine_->setObjectCache(&jit_object_cache);
+  }
   jit_engine_->finalizeObject();
+  jit_engine_->setObjectCache(nullptr);
 
   // Log the module
   LOG_TRACE("%s\n", GetIR().c_str());
@@ -160,6 +212,24 @@ void CodeContext::DumpContents() const {
   }
 }
 
+// The key of the code in this context in the object cache. The same code
+// compiles to the same object as long as it is compiled by the same engine:
+// the same version of LLVM, for the same CPU, with the same optimization
+// passes, which kCodegenVersion stands for.
+std::string CodeContext::GetObjectKey() const {
+  llvm::MD5 md5;
+  md5.update(LLVM_VERSION_STRING);
+  md5.update(llvm::sys::getHostCPUName());
+  md5.update(std::to_string(kCodegenVersion));
+  md5.update(GetIR());
+
+  llvm::MD5::MD5Result result;
+  md5.final(result);
+  llvm::SmallString<32> key;
+  llvm::MD5::stringifyResult(result, key);
+  return key.str();
+}
+
 // Get the textual form of the IR in this context
 std::string CodeContext::GetIR() const {
   std::string module_str;
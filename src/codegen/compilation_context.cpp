@@ -13,20 +13,24 @@
 #include "codegen/compilation_context.h"
 
 #include "codegen/proxy/catalog_proxy.h"
+#include "codegen/proxy/profile_runtime_proxy.h"
 #include "codegen/proxy/transaction_proxy.h"
 #include "codegen/proxy/executor_context_proxy.h"
 #include "common/logger.h"
 #include "common/timer.h"
+#include "executor/query_profile.h"
 
 namespace peloton {
 namespace codegen {
 
 // Constructor
 CompilationContext::CompilationContext(Query &query,
-                                       QueryResultConsumer &result_consumer)
+                                       QueryResultConsumer &result_consumer,
+                                       executor::QueryProfile *profile)
     : query_(query),
       result_consumer_(result_consumer),
-      codegen_(query_.GetCodeContext()) {
+      codegen_(query_.GetCodeContext()),
+      profile_(profile) {
   // Allocate a catalog and transaction instance in the runtime state
   auto &runtime_state = GetRuntimeState();
 
@@ -50,6 +54,10 @@ void CompilationContext::Prepare(const planner::AbstractPlan &op,
                                  Pipeline &pipeline) {
   auto translator = translator_factory_.CreateTranslator(op, *this, pipeline);
   op_translators_.insert(std::make_pair(&op, std::move(translator)));
+
+  if (profile_ != nullptr) {
+    op_pipelines_[&op] = &pipeline;
+  }
 }
 
 // Prepare the translator for the given expression
@@ -62,7 +70,55 @@ void CompilationContext::Prepare(const expression::AbstractExpression &exp) {
 void CompilationContext::Produce(const planner::AbstractPlan &op) {
   auto *translator = GetTranslator(op);
   PL_ASSERT(translator != nullptr);
+
+  if (profile_ == nullptr) {
+    translator->Produce();
+    return;
+  }
+
+  // Time the code the operator produces, which includes the code of the
+  // children it drives
+  auto *executor_context_ptr = GetExecutorContextPtr();
+  auto *operator_id = codegen_.Const32(profile_op_ids_[translator]);
+  codegen_.CallFunc(ProfileRuntimeProxy::_StartOperator::GetFunction(codegen_),
+                    {executor_context_ptr, operator_id});
   translator->Produce();
+  codegen_.CallFunc(ProfileRuntimeProxy::_StopOperator::GetFunction(codegen_),
+                    {GetExecutorContextPtr(), operator_id});
+}
+
+// Count rows output by the given operator in the profile of the query
+void CompilationContext::CountRows(const OperatorTranslator *translator,
+                                   llvm::Value *num_rows) {
+  PL_ASSERT(profile_ != nullptr);
+  auto iter = profile_op_ids_.find(translator);
+  if (iter == profile_op_ids_.end()) return;
+
+  codegen_.CallFunc(
+      ProfileRuntimeProxy::_CountRows::GetFunction(codegen_),
+      {GetExecutorContextPtr(), codegen_.Const32(iter->second), num_rows});
+}
+
+// Register the operators and pipelines of the query in the profile
+void CompilationContext::PrepareProfile() {
+  std::unordered_map<const Pipeline *, oid_t> pipeline_ids;
+  for (oid_t op_id = 0; op_id < profile_->GetOperatorCount(); op_id++) {
+    auto *plan = profile_->GetOperator(op_id).plan;
+
+    // Some plan nodes (e.g., the hash of a hash join) have no translator
+    auto *translator = GetTranslator(*plan);
+    if (translator == nullptr) continue;
+    profile_op_ids_[translator] = op_id;
+
+    // Pipelines are numbered in the order of their last operator
+    auto *pipeline = op_pipelines_[plan];
+    auto iter = pipeline_ids.find(pipeline);
+    if (iter == pipeline_ids.end()) {
+      iter = pipeline_ids.insert(std::make_pair(
+          pipeline, profile_->AddPipeline(pipeline->GetInfo()))).first;
+    }
+    profile_->SetOperatorPipeline(op_id, iter->second);
+  }
 }
 
 // Generate all plan functions for the given query
@@ -83,6 +139,10 @@ void CompilationContext::GeneratePlan(QueryCompiler::CompileStats *stats) {
 
   LOG_DEBUG("Main pipeline: %s", main_pipeline_.GetInfo().c_str());
 
+  if (profile_ != nullptr) {
+    PrepareProfile();
+  }
+
   // Generate the helper functions the query needs
   GenerateHelperFunctions();
 
@@ -145,10 +205,9 @@ llvm::Function *CompilationContext::GenerateInitFunction() {
   auto &code_context = query_.GetCodeContext();
   auto &runtime_state = query_.GetRuntimeState();
 
-  auto init_fn_name = "_" + std::to_string(code_context.GetID()) + "_init";
   FunctionBuilder function_builder{
       code_context,
-      init_fn_name,
+      "_init",
       codegen_.VoidType(),
       {{"runtimeState", runtime_state.FinalizeType(codegen_)->getPointerTo()}}};
 
@@ -175,10 +234,9 @@ llvm::Function *CompilationContext::GeneratePlanFunction(
   auto &code_context = query_.GetCodeContext();
   auto &runtime_state = query_.GetRuntimeState();
 
-  auto plan_fn_name = "_" + std::to_string(code_context.GetID()) + "_plan";
   FunctionBuilder function_builder{
       code_context,
-      plan_fn_name,
+      "_plan",
       codegen_.VoidType(),
       {{"runtimeState", runtime_state.FinalizeType(codegen_)->getPointerTo()}}};
 
@@ -201,10 +259,9 @@ llvm::Function *CompilationContext::GenerateTearDownFunction() {
   auto &code_context = query_.GetCodeContext();
   auto &runtime_state = query_.GetRuntimeState();
 
-  auto fn_name = "_" + std::to_string(code_context.GetID()) + "_tearDown";
   FunctionBuilder function_builder{
       code_context,
-      fn_name,
+      "_tearDown",
       codegen_.VoidType(),
       {{"runtimeState", runtime_state.FinalizeType(codegen_)->getPointerTo()}}};
 
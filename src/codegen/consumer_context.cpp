@@ -24,6 +24,9 @@ ConsumerContext::ConsumerContext(CompilationContext &compilation_context,
 
 // Pass the row batch to the next operator in the pipeline
 void ConsumerContext::Consume(RowBatch &batch) {
+  // The batch is the output of the current operator
+  CountRows(batch);
+
   auto *translator = pipeline_.NextStep();
   if (translator == nullptr) {
     // We're at the end of the query pipeline, we now send the output tuples
@@ -36,6 +39,11 @@ void ConsumerContext::Consume(RowBatch &batch) {
       translator->Consume(*this, batch);
       // When the call returns here, the pipeline position has been shifted to
       // the start of a new stage.
+      if (pipeline_.AtStageBoundary()) {
+        // The rows output by the last operator of the stage were only marked
+        // valid in the batch, count them now
+        CountRows(batch);
+      }
     } while ((translator = pipeline_.NextStep()) != nullptr);
   }
 }
@@ -51,8 +59,9 @@ void ConsumerContext::Consume(RowBatch::Row &row) {
     return;
   }
 
-  // Otherwise, we move along to the next operator in the pipeline and deliver
-  // the row there.
+  // Otherwise, the row is the output of the current operator. We move along
+  // to the next operator in the pipeline and deliver the row there.
+  CountRow();
   auto *translator = pipeline_.NextStep();
   if (translator != nullptr) {
     translator->Consume(*this, row);
@@ -65,6 +74,22 @@ void ConsumerContext::Consume(RowBatch::Row &row) {
   consumer.ConsumeResult(*this, row);
 }
 
+// Count the valid rows of the batch as the output of the current operator
+void ConsumerContext::CountRows(RowBatch &batch) {
+  if (compilation_context_.IsProfiled()) {
+    compilation_context_.CountRows(pipeline_.GetCurrentStep(),
+                                   batch.GetNumValidRows(GetCodeGen()));
+  }
+}
+
+// Count one row as the output of the current operator
+void ConsumerContext::CountRow() {
+  if (compilation_context_.IsProfiled()) {
+    compilation_context_.CountRows(pipeline_.GetCurrentStep(),
+                                   GetCodeGen().Const32(1));
+  }
+}
+
 CodeGen &ConsumerContext::GetCodeGen() const {
   return compilation_context_.GetCodeGen();
 }
@@ -0,0 +1,349 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// function_translator.cpp
+//
+// Identification: src/codegen/expression/function_translator.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/expression/function_translator.h"
+
+#include "codegen/lang/if.h"
+#include "codegen/proxy/functions_runtime_proxy.h"
+#include "codegen/type/boolean_type.h"
+#include "codegen/type/decimal_type.h"
+#include "codegen/type/integer_type.h"
+#include "codegen/type/varchar_type.h"
+#include "expression/constant_value_expression.h"
+#include "expression/function_expression.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+// The longest constant LIKE pattern we compare inline
+constexpr uint32_t kMaxInlinedPatternLength = 16;
+
+// The length of the string without its null terminator, if it has one
+llvm::Value *CharLength(CodeGen &codegen, const codegen::Value &str) {
+  llvm::Value *len = str.GetLength();
+  lang::If not_empty{codegen, codegen->CreateICmpUGT(len, codegen.Const32(0))};
+  llvm::Value *last_pos = codegen->CreateSub(len, codegen.Const32(1));
+  llvm::Value *last = codegen->CreateLoad(codegen->CreateInBoundsGEP(
+      codegen.ByteType(), str.GetValue(), last_pos));
+  llvm::Value *stripped_len = codegen->CreateSelect(
+      codegen->CreateICmpEQ(last, codegen.Const8(0)), last_pos, len);
+  not_empty.EndIf();
+  return not_empty.BuildPHI(stripped_len, len);
+}
+
+// Cast the value to the given SQL type, keeping whether it is nullable
+codegen::Value CastTo(CodeGen &codegen, const codegen::Value &val,
+                      const type::SqlType &sql_type) {
+  if (val.GetType().GetSqlType() == sql_type) {
+    return val;
+  }
+  return val.CastTo(codegen, type::Type{sql_type, val.IsNullable()});
+}
+
+// The integer constant the expression is, if it is one
+bool GetConstantInteger(const expression::AbstractExpression &exp,
+                        int32_t &val) {
+  if (exp.GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+  const auto &constant =
+      static_cast<const expression::ConstantValueExpression &>(exp).GetValue();
+  if (constant.GetTypeId() != peloton::type::TypeId::INTEGER ||
+      constant.IsNull()) {
+    return false;
+  }
+  val = peloton::type::ValuePeeker::PeekInteger(constant);
+  return true;
+}
+
+// If the expression is a constant LIKE pattern that matches a literal prefix
+// (i.e., a literal with an optional trailing '%'), return the literal and
+// whether the pattern has the '%'
+bool GetPrefixPattern(const expression::AbstractExpression &exp,
+                      std::string &literal, bool &is_prefix) {
+  if (exp.GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+  const auto &constant =
+      static_cast<const expression::ConstantValueExpression &>(exp).GetValue();
+  if (constant.GetTypeId() != peloton::type::TypeId::VARCHAR ||
+      constant.IsNull()) {
+    return false;
+  }
+  std::string pattern = peloton::type::ValuePeeker::PeekVarchar(constant);
+  is_prefix = !pattern.empty() && pattern.back() == '%';
+  literal = is_prefix ? pattern.substr(0, pattern.size() - 1) : pattern;
+  return literal.size() <= kMaxInlinedPatternLength &&
+         literal.find_first_of("%_") == std::string::npos;
+}
+
+}  // namespace
+
+// Constructor
+FunctionTranslator::FunctionTranslator(
+    const expression::AbstractExpression &exp, CompilationContext &context)
+    : ExpressionTranslator(exp, context), builtin_(GetBuiltin(exp)) {
+  PL_ASSERT(builtin_ != Builtin::Invalid);
+}
+
+codegen::Value FunctionTranslator::DeriveValue(CodeGen &codegen,
+                                               RowBatch::Row &row) const {
+  const auto &exp = GetExpressionAs<expression::AbstractExpression>();
+
+  std::vector<codegen::Value> args;
+  for (uint32_t i = 0; i < exp.GetChildrenSize(); i++) {
+    args.push_back(row.DeriveValue(codegen, *exp.GetChild(i)));
+  }
+
+  codegen::Value result;
+  switch (builtin_) {
+    case Builtin::Substr: {
+      result = Substr(codegen, args);
+      break;
+    }
+    case Builtin::CharLength:
+    case Builtin::OctetLength: {
+      // Strings are single-byte, so both lengths are the same
+      result = codegen::Value{type::Integer::Instance(),
+                              CharLength(codegen, args[0])};
+      break;
+    }
+    case Builtin::Ascii: {
+      result = Ascii(codegen, args);
+      break;
+    }
+    case Builtin::Sqrt: {
+      auto decimal = CastTo(codegen, args[0], type::Decimal::Instance());
+      auto *sqrt_func = FunctionsRuntimeProxy::_Sqrt::GetFunction(codegen);
+      result = codegen::Value{
+          type::Decimal::Instance(),
+          codegen.CallFunc(sqrt_func, {decimal.GetValue()})};
+      break;
+    }
+    case Builtin::Extract: {
+      result = Extract(codegen, args);
+      break;
+    }
+    case Builtin::Like:
+    case Builtin::NotLike: {
+      result = Like(codegen, args);
+      break;
+    }
+    default: {
+      throw Exception{"Invalid built-in function for translation"};
+    }
+  }
+
+  // The result is NULL if any of the arguments is
+  llvm::Value *null = nullptr;
+  for (const auto &arg : args) {
+    if (arg.IsNullable()) {
+      llvm::Value *arg_null = arg.IsNull(codegen);
+      null = (null == nullptr ? arg_null : codegen->CreateOr(null, arg_null));
+    }
+  }
+  if (null == nullptr) {
+    return result;
+  }
+  return codegen::Value{result.GetType().AsNullable(), result.GetValue(),
+                        result.GetLength(), null};
+}
+
+// SUBSTR(str, from, count) is the part of the string starting at the
+// one-based position from, with at most count characters. The part is clamped
+// to the string, so we just have to point into it.
+codegen::Value FunctionTranslator::Substr(
+    CodeGen &codegen, const std::vector<codegen::Value> &args) const {
+  const auto &str = args[0];
+  auto from = CastTo(codegen, args[1], type::Integer::Instance());
+  auto count = CastTo(codegen, args[2], type::Integer::Instance());
+
+  // Do the math on 64-bit values, so that nothing overflows
+  llvm::Value *len =
+      codegen->CreateZExt(CharLength(codegen, str), codegen.Int64Type());
+  llvm::Value *start = codegen->CreateSub(
+      codegen->CreateSExt(from.GetValue(), codegen.Int64Type()),
+      codegen.Const64(1));
+  llvm::Value *end = codegen->CreateAdd(
+      start, codegen->CreateSExt(count.GetValue(), codegen.Int64Type()));
+
+  auto clamp = [&codegen](llvm::Value *val, llvm::Value *min,
+                          llvm::Value *max) {
+    val = codegen->CreateSelect(codegen->CreateICmpSLT(val, min), min, val);
+    return codegen->CreateSelect(codegen->CreateICmpSGT(val, max), max, val);
+  };
+  start = clamp(start, codegen.Const64(0), len);
+  end = clamp(end, start, len);
+
+  llvm::Value *ptr =
+      codegen->CreateInBoundsGEP(codegen.ByteType(), str.GetValue(), start);
+  llvm::Value *substr_len = codegen->CreateTrunc(
+      codegen->CreateSub(end, start), codegen.Int32Type());
+  return codegen::Value{type::Varchar::Instance(), ptr, substr_len};
+}
+
+// ASCII(str) is the code of the first character, or zero for an empty string
+codegen::Value FunctionTranslator::Ascii(
+    CodeGen &codegen, const std::vector<codegen::Value> &args) const {
+  const auto &str = args[0];
+  llvm::Value *len = CharLength(codegen, str);
+  lang::If not_empty{codegen, codegen->CreateICmpUGT(len, codegen.Const32(0))};
+  llvm::Value *first = codegen->CreateSExt(
+      codegen->CreateLoad(str.GetValue()), codegen.Int32Type());
+  not_empty.EndIf();
+  return codegen::Value{type::Integer::Instance(),
+                        not_empty.BuildPHI(first, codegen.Const32(0))};
+}
+
+// EXTRACT(part FROM ts). The fields that are directly encoded in the timestamp
+// are decoded inline when the part is a constant, in the same way as
+// DateFunctions::Extract() does. Everything else goes through the runtime.
+codegen::Value FunctionTranslator::Extract(
+    CodeGen &codegen, const std::vector<codegen::Value> &args) const {
+  const auto &exp = GetExpressionAs<expression::AbstractExpression>();
+  llvm::Value *timestamp = args[1].GetValue();
+
+  int32_t part;
+  bool inlined = GetConstantInteger(*exp.GetChild(0), part);
+  if (inlined) {
+    auto udiv = [&codegen](llvm::Value *val, uint64_t divisor) {
+      return codegen->CreateUDiv(val, codegen.Const64(divisor));
+    };
+    auto urem = [&codegen](llvm::Value *val, uint64_t divisor) {
+      return codegen->CreateURem(val, codegen.Const64(divisor));
+    };
+
+    // Seconds since the start of the day, and the date, skipping the time zone
+    llvm::Value *secs = udiv(timestamp, 1000000);
+    llvm::Value *time = urem(secs, 100000);
+    llvm::Value *date = udiv(secs, 100000);
+
+    llvm::Value *field = nullptr;
+    switch (static_cast<DatePartType>(part)) {
+      case DatePartType::YEAR:
+        field = urem(date, 10000);
+        break;
+      case DatePartType::MONTH:
+        field = udiv(udiv(date, 10000 * 27), 32);
+        break;
+      case DatePartType::DAY:
+        field = urem(udiv(date, 10000 * 27), 32);
+        break;
+      case DatePartType::HOUR:
+        field = urem(udiv(time, 3600), 24);
+        break;
+      case DatePartType::MINUTE:
+        field = urem(udiv(time, 60), 60);
+        break;
+      default:
+        inlined = false;
+        break;
+    }
+    if (inlined) {
+      return codegen::Value{
+          type::Decimal::Instance(),
+          codegen->CreateUIToFP(field, codegen.DoubleType())};
+    }
+  }
+
+  auto *extract_func = FunctionsRuntimeProxy::_Extract::GetFunction(codegen);
+  auto date_part = CastTo(codegen, args[0], type::Integer::Instance());
+  return codegen::Value{
+      type::Decimal::Instance(),
+      codegen.CallFunc(extract_func, {date_part.GetValue(), timestamp})};
+}
+
+// str LIKE pattern. A constant pattern matching a short literal, or a prefix
+// of the string, is compared byte by byte inline. Other patterns are matched
+// by the runtime.
+codegen::Value FunctionTranslator::Like(
+    CodeGen &codegen, const std::vector<codegen::Value> &args) const {
+  const auto &exp = GetExpressionAs<expression::AbstractExpression>();
+  const auto &str = args[0];
+  const auto &pattern = args[1];
+
+  llvm::Value *matches = nullptr;
+
+  std::string literal;
+  bool is_prefix;
+  if (GetPrefixPattern(*exp.GetChild(1), literal, is_prefix)) {
+    // The string has to be as long as the literal (or exactly as long, if we
+    // aren't matching a prefix) before we look at its characters
+    llvm::Value *len = CharLength(codegen, str);
+    llvm::Value *literal_len = codegen.Const32(literal.size());
+    llvm::Value *long_enough = is_prefix
+                                   ? codegen->CreateICmpUGE(len, literal_len)
+                                   : codegen->CreateICmpEQ(len, literal_len);
+    lang::If check_chars{codegen, long_enough};
+    llvm::Value *chars_match = codegen.ConstBool(true);
+    for (uint32_t i = 0; i < literal.size(); i++) {
+      llvm::Value *c = codegen->CreateLoad(codegen->CreateInBoundsGEP(
+          codegen.ByteType(), str.GetValue(), codegen.Const32(i)));
+      chars_match = codegen->CreateAnd(
+          chars_match, codegen->CreateICmpEQ(c, codegen.Const8(literal[i])));
+    }
+    check_chars.EndIf();
+    matches = check_chars.BuildPHI(chars_match, codegen.ConstBool(false));
+  } else {
+    auto *like_func = FunctionsRuntimeProxy::_Like::GetFunction(codegen);
+    matches = codegen.CallFunc(
+        like_func, {str.GetValue(), str.GetLength(), pattern.GetValue(),
+                    pattern.GetLength()});
+  }
+
+  if (builtin_ == Builtin::NotLike) {
+    matches = codegen->CreateNot(matches);
+  }
+  return codegen::Value{type::Boolean::Instance(), matches};
+}
+
+bool FunctionTranslator::IsSupported(
+    const expression::AbstractExpression &exp) {
+  return GetBuiltin(exp) != Builtin::Invalid;
+}
+
+FunctionTranslator::Builtin FunctionTranslator::GetBuiltin(
+    const expression::AbstractExpression &exp) {
+  switch (exp.GetExpressionType()) {
+    case ExpressionType::COMPARE_LIKE:
+      return Builtin::Like;
+    case ExpressionType::COMPARE_NOTLIKE:
+      return Builtin::NotLike;
+    case ExpressionType::FUNCTION:
+      break;
+    default:
+      return Builtin::Invalid;
+  }
+
+  const auto &func_name =
+      static_cast<const expression::FunctionExpression &>(exp).func_name_;
+  if (func_name == "substr") {
+    return Builtin::Substr;
+  } else if (func_name == "char_length") {
+    return Builtin::CharLength;
+  } else if (func_name == "octet_length") {
+    return Builtin::OctetLength;
+  } else if (func_name == "ascii") {
+    return Builtin::Ascii;
+  } else if (func_name == "sqrt") {
+    return Builtin::Sqrt;
+  } else if (func_name == "extract") {
+    return Builtin::Extract;
+  }
+  return Builtin::Invalid;
+}
+
+}  // namespace codegen
+}  // namespace peloton
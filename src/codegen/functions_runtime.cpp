@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// functions_runtime.cpp
+//
+// Identification: src/codegen/functions_runtime.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/functions_runtime.h"
+
+#include <vector>
+
+#include "expression/date_functions.h"
+#include "expression/decimal_functions.h"
+#include "type/value_factory.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+// The length of the string without its null terminator, if it has one
+uint32_t CharLength(const char *str, uint32_t len) {
+  return (len > 0 && str[len - 1] == '\0') ? len - 1 : len;
+}
+
+}  // namespace
+
+// Match the string against the pattern, where '%' matches any sequence of
+// characters and '_' matches any single character. When a character doesn't
+// match, we go back to the last '%' seen and let it swallow one more
+// character of the string.
+bool FunctionsRuntime::Like(const char *str, uint32_t str_len,
+                            const char *pattern, uint32_t pattern_len) {
+  str_len = CharLength(str, str_len);
+  pattern_len = CharLength(pattern, pattern_len);
+
+  uint32_t s = 0, p = 0;
+  // Whether a '%' has been seen, the position in the pattern after the last
+  // one, and the position in the string it has been matched up to
+  bool seen_percent = false;
+  uint32_t percent_p = 0, percent_s = 0;
+  while (s < str_len) {
+    if (p < pattern_len && pattern[p] == '%') {
+      seen_percent = true;
+      percent_p = ++p;
+      percent_s = s;
+    } else if (p < pattern_len && (pattern[p] == '_' || pattern[p] == str[s])) {
+      s++;
+      p++;
+    } else if (seen_percent) {
+      p = percent_p;
+      s = ++percent_s;
+    } else {
+      return false;
+    }
+  }
+
+  // Only '%' may be left in the pattern
+  while (p < pattern_len && pattern[p] == '%') {
+    p++;
+  }
+  return p == pattern_len;
+}
+
+double FunctionsRuntime::Extract(int32_t date_part, int64_t timestamp) {
+  std::vector<peloton::type::Value> args = {
+      peloton::type::ValueFactory::GetIntegerValue(date_part),
+      peloton::type::ValueFactory::GetTimestampValue(timestamp)};
+  auto result = expression::DateFunctions::Extract(args);
+  return peloton::type::ValuePeeker::PeekDouble(result);
+}
+
+double FunctionsRuntime::Sqrt(double value) {
+  std::vector<peloton::type::Value> args = {
+      peloton::type::ValueFactory::GetDecimalValue(value)};
+  auto result = expression::DecimalFunctions::Sqrt(args);
+  return peloton::type::ValuePeeker::PeekDouble(result);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -36,15 +36,16 @@ const planner::AttributeInfo OAHashTable::kHashAI{type::Integer::Instance(), 0,
 // CONSTRUCTORS
 //===----------------------------------------------------------------------===//
 
-OAHashTable::OAHashTable() {
+OAHashTable::OAHashTable() : track_matches_(false) {
   // This constructor shouldn't generally be used at all, but there are
   // cases when the key-type is not known at construction time.
 }
 
 OAHashTable::OAHashTable(CodeGen &codegen,
                          const std::vector<type::Type> &key_type,
-                         uint64_t value_size)
-    : value_size_(value_size) {
+                         uint64_t value_size, bool track_matches)
+    : value_size_(value_size + (track_matches ? kMatchFlagSize : 0)),
+      track_matches_(track_matches) {
   key_storage_.Setup(codegen, key_type);
 
   // Configure the size of each HashEntry
@@ -228,6 +229,24 @@ std::pair<llvm::Value *, llvm::Value *> OAHashTable::GetDataCountAndPointer(
   return std::make_pair(final_data_count, final_data_ptr);
 }
 
+// The value of a slot starts after its match flag
+llvm::Value *OAHashTable::GetValuePtr(CodeGen &codegen,
+                                      llvm::Value *slot_ptr) const {
+  if (!track_matches_) {
+    return slot_ptr;
+  }
+  return AdvancePointer(codegen, slot_ptr, kMatchFlagSize);
+}
+
+// A new value starts out unmatched
+llvm::Value *OAHashTable::InitValueSlot(CodeGen &codegen,
+                                        llvm::Value *slot_ptr) const {
+  if (track_matches_) {
+    codegen->CreateStore(codegen.Const8(0), slot_ptr);
+  }
+  return GetValuePtr(codegen, slot_ptr);
+}
+
 //===----------------------------------------------------------------------===//
 // Translate the looping and probing framework for probing
 //
@@ -415,12 +434,13 @@ void OAHashTable::ProbeOrInsert(CodeGen &codegen, llvm::Value *ht_ptr,
                                 const std::vector<codegen::Value> &key,
                                 ProbeCallback &probe_callback,
                                 InsertCallback &insert_callback) const {
-  auto key_found = [&codegen, &probe_callback](llvm::Value *data_ptr) {
-    probe_callback.ProcessEntry(codegen, data_ptr);
+  auto key_found = [this, &codegen, &probe_callback](llvm::Value *data_ptr) {
+    probe_callback.ProcessEntry(codegen, GetValuePtr(codegen, data_ptr));
   };
 
-  auto key_not_found = [&codegen, &insert_callback](llvm::Value *data_ptr) {
-    insert_callback.StoreValue(codegen, data_ptr);
+  auto key_not_found = [this, &codegen,
+                        &insert_callback](llvm::Value *data_ptr) {
+    insert_callback.StoreValue(codegen, InitValueSlot(codegen, data_ptr));
   };
 
   TranslateProbing(codegen, ht_ptr, hash, key,
@@ -435,12 +455,13 @@ void OAHashTable::Insert(CodeGen &codegen, llvm::Value *ht_ptr,
                          llvm::Value *hash,
                          const std::vector<codegen::Value> &key,
                          InsertCallback &insert_callback) const {
-  auto key_found = [&codegen, &insert_callback](llvm::Value *data_ptr) {
-    insert_callback.StoreValue(codegen, data_ptr);
+  auto key_found = [this, &codegen, &insert_callback](llvm::Value *data_ptr) {
+    insert_callback.StoreValue(codegen, InitValueSlot(codegen, data_ptr));
   };
 
-  auto key_not_found = [&codegen, &insert_callback](llvm::Value *data_ptr) {
-    insert_callback.StoreValue(codegen, data_ptr);
+  auto key_not_found = [this, &codegen,
+                        &insert_callback](llvm::Value *data_ptr) {
+    insert_callback.StoreValue(codegen, InitValueSlot(codegen, data_ptr));
   };
 
   TranslateProbing(codegen, ht_ptr, hash, key,
@@ -511,7 +532,8 @@ void OAHashTable::Iterate(CodeGen &codegen, llvm::Value *hash_table,
         val_index = read_value_loop.GetLoopVar(0);
         data_ptr = read_value_loop.GetLoopVar(1);
 
-        callback.ProcessEntry(codegen, entry_key, data_ptr);
+        callback.ProcessEntry(codegen, entry_key,
+                              GetValuePtr(codegen, data_ptr));
         data_ptr = AdvancePointer(codegen, data_ptr, value_size_);
 
         val_index = codegen->CreateAdd(val_index, codegen.Const64(1));
@@ -603,8 +625,8 @@ void OAHashTable::VectorizedIterate(
 void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
                           const std::vector<codegen::Value> &key,
                           IterateCallback &callback) const {
-  auto key_found = [&codegen, &callback, &key](llvm::Value *data_ptr) {
-    callback.ProcessEntry(codegen, key, data_ptr);
+  auto key_found = [this, &codegen, &callback, &key](llvm::Value *data_ptr) {
+    callback.ProcessEntry(codegen, key, GetValuePtr(codegen, data_ptr));
   };
 
   // It does not do anything for a key that is not found
@@ -618,6 +640,28 @@ void OAHashTable::FindAll(CodeGen &codegen, llvm::Value *ht_ptr,
                    false);         // If key is missing create it in empty slot
 }
 
+void OAHashTable::MarkMatched(CodeGen &codegen, llvm::Value *value_ptr) const {
+  PL_ASSERT(track_matches_);
+  llvm::Value *flag_ptr =
+      AdvancePointer(codegen, value_ptr, -static_cast<int64_t>(kMatchFlagSize));
+  codegen->CreateStore(codegen.Const8(1), flag_ptr);
+}
+
+llvm::Value *OAHashTable::IsMatched(CodeGen &codegen,
+                                    llvm::Value *value_ptr) const {
+  PL_ASSERT(track_matches_);
+  llvm::Value *flag_ptr =
+      AdvancePointer(codegen, value_ptr, -static_cast<int64_t>(kMatchFlagSize));
+  llvm::Value *flag = codegen->CreateLoad(flag_ptr);
+  return codegen->CreateICmpNE(flag, codegen.Const8(0));
+}
+
+void OAHashTable::Reset(CodeGen &codegen, llvm::Value *ht_ptr,
+                        llvm::Value *estimated_num_entries) const {
+  auto *ht_reset_func = OAHashTableProxy::_Reset::GetFunction(codegen);
+  codegen.CallFunc(ht_reset_func, {ht_ptr, estimated_num_entries});
+}
+
 void OAHashTable::Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const {
   auto *ht_destroy_func = OAHashTableProxy::_Destroy::GetFunction(codegen);
   codegen.CallFunc(ht_destroy_func, {ht_ptr});
@@ -669,7 +713,8 @@ llvm::Value *OAHashTable::OAHashTableAccess::BucketValue(
   llvm::Value *entry_ptr = hash_table_.GetEntry(codegen, ht_ptr_, index);
   llvm::Value *key_ptr = hash_table_.GetKeyPtr(codegen, entry_ptr);
   uint32_t key_size = hash_table_.key_storage_.MaxStorageSize();
-  return hash_table_.AdvancePointer(codegen, key_ptr, key_size);
+  return hash_table_.GetValuePtr(
+      codegen, hash_table_.AdvancePointer(codegen, key_ptr, key_size));
 }
 
 }  // namespace codegen
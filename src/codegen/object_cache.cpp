@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// object_cache.cpp
+//
+// Identification: src/codegen/object_cache.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/object_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <boost/filesystem.hpp>
+
+#include "common/logger.h"
+#include "configuration/configuration.h"
+
+namespace peloton {
+namespace codegen {
+
+ObjectCache &ObjectCache::GetInstance() {
+  static ObjectCache object_cache;
+  return object_cache;
+}
+
+ObjectCache::ObjectCache()
+    : objects_(new Cache<std::string, std::string>(FLAGS_codegen_cache_size)),
+      memory_hits_(0),
+      disk_hits_(0),
+      misses_(0) {}
+
+bool ObjectCache::IsEnabled() {
+  return FLAGS_codegen_cache_size > 0 || !FLAGS_codegen_cache_dir.empty();
+}
+
+std::shared_ptr<std::string> ObjectCache::Find(const std::string &key) {
+  if (FLAGS_codegen_cache_size > 0) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto iter = objects_->find(key);
+    if (iter != objects_->end()) {
+      memory_hits_++;
+      return *iter;
+    }
+  }
+
+  auto object = ReadFile(key);
+  if (object == nullptr) {
+    misses_++;
+    return nullptr;
+  }
+  disk_hits_++;
+
+  // Keep it in memory for the next query
+  if (FLAGS_codegen_cache_size > 0) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    objects_->insert(std::make_pair(key, object));
+  }
+  return object;
+}
+
+void ObjectCache::Insert(const std::string &key, const char *object,
+                         size_t size) {
+  std::shared_ptr<std::string> object_copy{new std::string(object, size)};
+  if (FLAGS_codegen_cache_size > 0) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    objects_->insert(std::make_pair(key, object_copy));
+  }
+  WriteFile(key, *object_copy);
+}
+
+void ObjectCache::ClearMemory() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  objects_.reset(new Cache<std::string, std::string>(FLAGS_codegen_cache_size));
+}
+
+std::string ObjectCache::GetPath(const std::string &key) const {
+  return FLAGS_codegen_cache_dir + "/" + key + ".o";
+}
+
+std::shared_ptr<std::string> ObjectCache::ReadFile(
+    const std::string &key) const {
+  if (FLAGS_codegen_cache_dir.empty()) {
+    return nullptr;
+  }
+  std::ifstream in{GetPath(key), std::ios::binary};
+  if (!in) {
+    return nullptr;
+  }
+  std::shared_ptr<std::string> object{
+      new std::string{std::istreambuf_iterator<char>(in),
+                      std::istreambuf_iterator<char>()}};
+  if (in.bad() || object->empty()) {
+    LOG_WARN("Could not read the cached object %s", GetPath(key).c_str());
+    return nullptr;
+  }
+  return object;
+}
+
+// Objects are written to a temporary file that is then renamed, so that
+// readers (possibly in other processes sharing the directory) never see a
+// partially written object
+void ObjectCache::WriteFile(const std::string &key,
+                            const std::string &object) const {
+  if (FLAGS_codegen_cache_dir.empty()) {
+    return;
+  }
+  boost::system::error_code error;
+  boost::filesystem::create_directories(FLAGS_codegen_cache_dir, error);
+
+  std::string path = GetPath(key);
+  std::string temp_path =
+      path + "." + boost::filesystem::unique_path().string();
+  {
+    std::ofstream out{temp_path, std::ios::binary | std::ios::trunc};
+    out.write(object.data(), object.size());
+    if (!out) {
+      LOG_WARN("Could not write the cached object %s", path.c_str());
+      std::remove(temp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    LOG_WARN("Could not write the cached object %s", path.c_str());
+    std::remove(temp_path.c_str());
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
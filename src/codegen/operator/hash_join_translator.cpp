@@ -13,8 +13,11 @@
 #include "codegen/operator/hash_join_translator.h"
 
 #include "codegen/proxy/oa_hash_table_proxy.h"
+#include "codegen/proxy/radix_partitioner_proxy.h"
 #include "codegen/expression/tuple_value_translator.h"
 #include "codegen/lang/vectorized_loop.h"
+#include "codegen/type/sql_type.h"
+#include "codegen/util/radix_partitioner.h"
 #include "expression/tuple_value_expression.h"
 #include "planner/hash_join_plan.h"
 
@@ -23,6 +26,12 @@ namespace codegen {
 
 std::atomic<bool> HashJoinTranslator::kUsePrefetch{false};
 
+std::atomic<bool> HashJoinTranslator::kUseRadixPartitioning{false};
+
+// Partition when the hash table wouldn't fit into a typical last-level cache
+std::atomic<uint64_t> HashJoinTranslator::kRadixPartitioningThreshold{
+    8 * 1024 * 1024};
+
 //===----------------------------------------------------------------------===//
 // HASH JOIN TRANSLATOR
 //===----------------------------------------------------------------------===//
@@ -31,34 +40,20 @@ std::atomic<bool> HashJoinTranslator::kUsePrefetch{false};
 HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
                                        CompilationContext &context,
                                        Pipeline &pipeline)
-    : OperatorTranslator(context, pipeline), join_(join), left_pipeline_(this) {
+    : OperatorTranslator(context, pipeline),
+      join_(join),
+      left_pipeline_(this),
+      right_pipeline_(this),
+      output_pipeline_(pipeline) {
   LOG_DEBUG("Constructing HashJoinTranslator ...");
 
   auto &codegen = GetCodeGen();
   auto &runtime_state = context.GetRuntimeState();
 
-  // If we should be prefetching into the hash-table, install a boundary in the
-  // both the left and right pipeline at the input into this translator to
-  // ensure it receives a vector of input tuples
-  if (UsePrefetching()) {
-    left_pipeline_.InstallBoundaryAtInput(this);
-    pipeline.InstallBoundaryAtInput(this);
-
-    // Allocate slot for prefetch array
-    prefetch_vector_id_ = runtime_state.RegisterState(
-        "hjPFVec", codegen.VectorType(codegen.Int64Type(),
-                                      OAHashTable::kDefaultGroupPrefetchSize),
-        true);
-  }
-
   // Allocate state for our hash table
   hash_table_id_ =
       runtime_state.RegisterState("join", OAHashTableProxy::GetType(codegen));
 
-  // Prepare translators for the left and right input operators
-  context.Prepare(*join_.GetChild(0), left_pipeline_);
-  context.Prepare(*join_.GetChild(1)->GetChild(0), pipeline);
-
   // Prepare the expressions that produce the build-size keys
   join.GetLeftHashKeys(left_key_exprs_);
 
@@ -116,6 +111,85 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   }
   left_value_storage_.Setup(codegen, left_value_types);
 
+  // Create the hash table. If the left tuples without a partner are output,
+  // the hash table tracks which tuples found one.
+  hash_table_ = OAHashTable{codegen, left_key_type,
+                            left_value_storage_.MaxStorageSize(),
+                            PreservesLeft()};
+
+  // Partition the inputs if the hash table won't fit into the cache
+  use_radix_partitioning_ =
+      kUseRadixPartitioning ||
+      EstimateHashTableSize() > kRadixPartitioningThreshold;
+
+  // If we should be prefetching into the hash-table, install a boundary in the
+  // both the left and right pipeline at the input into this translator to
+  // ensure it receives a vector of input tuples
+  if (UsePrefetching()) {
+    left_pipeline_.InstallBoundaryAtInput(this);
+    pipeline.InstallBoundaryAtInput(this);
+
+    // Allocate slot for prefetch array
+    prefetch_vector_id_ = runtime_state.RegisterState(
+        "hjPFVec", codegen.VectorType(codegen.Int64Type(),
+                                      OAHashTable::kDefaultGroupPrefetchSize),
+        true);
+  }
+
+  if (UseRadixPartitioning()) {
+    // The right side stores the attributes the join outputs, along with those
+    // its keys and the predicate need
+    std::unordered_set<const planner::AttributeInfo *> left_ais{
+        left_key_ais.begin(), left_key_ais.end()};
+    left_ais.insert(left_val_ais_.begin(), left_val_ais_.end());
+
+    std::unordered_set<const planner::AttributeInfo *> used_ais{
+        join.GetRightAttributes().begin(), join.GetRightAttributes().end()};
+    for (const auto *right_key : right_key_exprs_) {
+      right_key->GetUsedAttributes(used_ais);
+    }
+    if (predicate != nullptr) {
+      predicate->GetUsedAttributes(used_ais);
+    }
+    for (const auto *ai : used_ais) {
+      if (left_ais.count(ai) == 0) {
+        right_ais_.push_back(ai);
+      }
+    }
+
+    // The format of the partitions
+    std::vector<type::Type> left_types{left_key_type};
+    left_types.insert(left_types.end(), left_value_types.begin(),
+                      left_value_types.end());
+    left_partition_storage_.Setup(codegen, left_types);
+
+    std::vector<type::Type> right_types;
+    for (const auto *right_ai : right_ais_) {
+      right_types.push_back(right_ai->type);
+    }
+    right_partition_storage_.Setup(codegen, right_types);
+
+    // Allocate the partitioners
+    left_partitioner_id_ = runtime_state.RegisterState(
+        "joinLeftParts", RadixPartitionerProxy::GetType(codegen));
+    right_partitioner_id_ = runtime_state.RegisterState(
+        "joinRightParts", RadixPartitionerProxy::GetType(codegen));
+  }
+
+  // Allocate the selection vector for the batches this join starts
+  if (UseRadixPartitioning() || PreservesLeft()) {
+    output_vector_id_ = runtime_state.RegisterState(
+        "hjSelVec",
+        codegen.VectorType(codegen.Int32Type(), Vector::kDefaultVectorSize),
+        true);
+  }
+
+  // Allocate the flag saying whether a right tuple found a partner
+  if (TracksRightMatches()) {
+    right_matched_id_ =
+        runtime_state.RegisterState("hjMatched", codegen.BoolType(), true);
+  }
+
   // Check if the join needs an output vector to store saved probes
   if (pipeline.GetTranslatorStage(this) != 0) {
     // The join isn't the last operator in the pipeline, let's use a vector
@@ -125,26 +199,52 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlan &join,
   }
   needs_output_vector_ = false;
 
-  // Create the hash table
-  hash_table_ =
-      OAHashTable{codegen, left_key_type, left_value_storage_.MaxStorageSize()};
+  // Prepare translators for the left and right input operators. When the
+  // inputs are partitioned, both sides are buffered and this join starts the
+  // pipeline it is part of.
+  context.Prepare(*join_.GetChild(0), left_pipeline_);
+  context.Prepare(*join_.GetChild(1)->GetChild(0),
+                  UseRadixPartitioning() ? right_pipeline_ : pipeline);
 
   LOG_DEBUG("Finished constructing HashJoinTranslator ...");
 }
 
-// Initialize the hash-table instance
+// Initialize the hash-table instance, and the partitioners
 void HashJoinTranslator::InitializeState() {
-  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  auto &codegen = GetCodeGen();
+  hash_table_.Init(codegen, LoadStatePtr(hash_table_id_));
+
+  if (UseRadixPartitioning()) {
+    auto *init_fn = RadixPartitionerProxy::_Init::GetFunction(codegen);
+    codegen.CallFunc(
+        init_fn,
+        {LoadStatePtr(left_partitioner_id_),
+         codegen.Const32(left_partition_storage_.MaxStorageSize())});
+    codegen.CallFunc(
+        init_fn,
+        {LoadStatePtr(right_partitioner_id_),
+         codegen.Const32(right_partition_storage_.MaxStorageSize())});
+  }
 }
 
 // Produce!
 void HashJoinTranslator::Produce() const {
   // Let the left child produce tuples which we materialize into the hash-table
+  // (or into the left partitions)
   GetCompilationContext().Produce(*join_.GetChild(0));
 
   // Let the right child produce tuples, which we use to probe the hash table
+  // (or materialize into the right partitions)
   GetCompilationContext().Produce(*join_.GetChild(1)->GetChild(0));
 
+  // With partitioned inputs, the join happens once both sides are buffered.
+  // Otherwise, all that's left are the left tuples without a partner.
+  if (UseRadixPartitioning()) {
+    JoinPartitions();
+  } else if (PreservesLeft()) {
+    OutputUnmatchedLeft(LoadStatePtr(hash_table_id_));
+  }
+
   // That's it, we've produced all the tuples
 }
 
@@ -266,6 +366,12 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &,
     hash = hash_val.GetValue();
   }
 
+  // Buffer the tuple if the hash table is built later, one partition at a time
+  if (UseRadixPartitioning()) {
+    BufferLeft(row, hash, key, vals);
+    return;
+  }
+
   // Insert tuples from the left side into the hash table
   InsertLeft insert_left{left_value_storage_, vals};
   hash_table_.Insert(codegen, LoadStatePtr(hash_table_id_), hash, key,
@@ -275,24 +381,284 @@ void HashJoinTranslator::ConsumeFromLeft(ConsumerContext &,
 // The given row is from the right child. Probe hash-table.
 void HashJoinTranslator::ConsumeFromRight(ConsumerContext &context,
                                           RowBatch::Row &row) const {
+  // Buffer the tuple if the hash table is probed later
+  if (UseRadixPartitioning()) {
+    BufferRight(row);
+    return;
+  }
+
+  ProbeHashTable(context, row, LoadStatePtr(hash_table_id_));
+}
+
+// Find all join partners of the given row of the right side
+void HashJoinTranslator::ProbeHashTable(ConsumerContext &context,
+                                        RowBatch::Row &row,
+                                        llvm::Value *ht_ptr) const {
+  auto &codegen = GetCodeGen();
+
   // Pull out the values of the keys we probe the hash-table with
   std::vector<codegen::Value> key;
   CollectKeys(row, right_key_exprs_, key);
 
-  const auto &join_plan = GetJoinPlan();
+  if (!TracksRightMatches()) {
+    ProbeRight probe_right{*this, context, row, key, nullptr};
+    hash_table_.FindAll(codegen, ht_ptr, key, probe_right);
+    return;
+  }
 
-  // Check the join type
-  if (join_plan.GetJoinType() == JoinType::INNER) {
-    // For inner joins, find all join partners
-    ProbeRight probe_right{*this, context, row, key};
-    hash_table_.FindAll(GetCodeGen(), LoadStatePtr(hash_table_id_), key,
-                        probe_right);
+  // Depending on whether it found a partner, the right tuple is output once
+  // more after probing. This happens from copies of the row and the pipeline
+  // taken beforehand: the row mustn't see the left values cached while
+  // probing, and the pipeline must start at this join again.
+  RowBatch::Row unmatched_row{row};
+  Pipeline unmatched_pipeline{context.GetPipeline()};
+  ConsumerContext unmatched_context{GetCompilationContext(),
+                                    unmatched_pipeline};
+
+  // The value of local state is its stack slot
+  llvm::Value *matched_ptr = LoadStateValue(right_matched_id_);
+  codegen->CreateStore(codegen.ConstBool(false), matched_ptr);
+
+  ProbeRight probe_right{*this, context, row, key, matched_ptr};
+  hash_table_.FindAll(codegen, ht_ptr, key, probe_right);
+
+  llvm::Value *matched = codegen->CreateLoad(matched_ptr);
+  if (join_.GetJoinType() == JoinType::SEMI) {
+    // Semi joins output the right tuples that have a partner
+    lang::If has_partner{codegen, matched};
+    {
+      unmatched_context.Consume(unmatched_row);
+    }
+    has_partner.EndIf();
+  } else {
+    // Anti and outer joins output those that have none, outer joins with
+    // NULLs for the left side
+    lang::If no_partner{codegen, codegen->CreateNot(matched)};
+    {
+      if (PreservesRight()) {
+        RegisterLeftNulls(unmatched_row);
+      }
+      unmatched_context.Consume(unmatched_row);
+    }
+    no_partner.EndIf();
   }
 }
 
-// Cleanup by destroying the hash-table instance
+// Iterate over the hash table, outputting the left tuples that weren't
+// flagged as matched while probing
+void HashJoinTranslator::OutputUnmatchedLeft(llvm::Value *ht_ptr) const {
+  auto &codegen = GetCodeGen();
+
+  // Every left tuple is output in a batch of its own, which is only there to
+  // hold the row. All attributes are registered in the row.
+  Vector selection_vector{LoadStateValue(output_vector_id_),
+                          Vector::kDefaultVectorSize, codegen.Int32Type()};
+  RowBatch batch{GetCompilationContext(), codegen.Const32(0),
+                 codegen.Const32(1), selection_vector, false};
+
+  // The tuples are sent from the position of this join in its pipeline
+  Pipeline pipeline{output_pipeline_};
+  ConsumerContext context{GetCompilationContext(), pipeline};
+
+  ProduceUnmatchedLeft produce_unmatched{*this, context, batch};
+  hash_table_.Iterate(codegen, ht_ptr, produce_unmatched);
+}
+
+void HashJoinTranslator::RegisterLeftNulls(RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+  for (const auto *ai : left_val_ais_) {
+    codegen::Value null_val = ai->type.GetSqlType().GetNullValue(codegen);
+    row.RegisterAttributeValue(ai, null_val);
+  }
+  for (const auto *exp : left_key_exprs_) {
+    if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+      auto *ai = static_cast<const expression::TupleValueExpression *>(exp)
+                     ->GetAttributeRef();
+      codegen::Value null_val = ai->type.GetSqlType().GetNullValue(codegen);
+      row.RegisterAttributeValue(ai, null_val);
+    }
+  }
+}
+
+void HashJoinTranslator::RegisterRightNulls(RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+  for (const auto *ai : join_.GetRightAttributes()) {
+    codegen::Value null_val = ai->type.GetSqlType().GetNullValue(codegen);
+    row.RegisterAttributeValue(ai, null_val);
+  }
+}
+
+// Store a tuple of the left side, with the hash of its key
+void HashJoinTranslator::BufferLeft(
+    RowBatch::Row &, llvm::Value *hash, const std::vector<codegen::Value> &key,
+    const std::vector<codegen::Value> &vals) const {
+  auto &codegen = GetCodeGen();
+  if (hash == nullptr) {
+    hash = hash_table_.HashKey(codegen, key);
+  }
+
+  auto *store_fn =
+      RadixPartitionerProxy::_StoreInputTuple::GetFunction(codegen);
+  auto *space =
+      codegen.CallFunc(store_fn, {LoadStatePtr(left_partitioner_id_), hash});
+
+  std::vector<codegen::Value> tuple{key};
+  tuple.insert(tuple.end(), vals.begin(), vals.end());
+  left_partition_storage_.StoreValues(codegen, space, tuple);
+}
+
+// Store a tuple of the right side, with the hash of its key
+void HashJoinTranslator::BufferRight(RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  std::vector<codegen::Value> key;
+  CollectKeys(row, right_key_exprs_, key);
+  llvm::Value *hash = hash_table_.HashKey(codegen, key);
+
+  std::vector<codegen::Value> vals;
+  CollectValues(row, right_ais_, vals);
+
+  auto *store_fn =
+      RadixPartitionerProxy::_StoreInputTuple::GetFunction(codegen);
+  auto *space =
+      codegen.CallFunc(store_fn, {LoadStatePtr(right_partitioner_id_), hash});
+  right_partition_storage_.StoreValues(codegen, space, vals);
+}
+
+// Partition both sides on the same bits of the hash of their keys. Matching
+// tuples end up in partitions with the same number, so every left partition
+// is built into the hash table, and probed with the right partition.
+void HashJoinTranslator::JoinPartitions() const {
+  auto &codegen = GetCodeGen();
+  auto *left_parts = LoadStatePtr(left_partitioner_id_);
+  auto *right_parts = LoadStatePtr(right_partitioner_id_);
+  auto *ht_ptr = LoadStatePtr(hash_table_id_);
+
+  // The number of bits is chosen so that the hash table of a left partition
+  // fits into the cache
+  auto *radix_bits = codegen.CallFunc(
+      RadixPartitionerProxy::_ComputeRadixBits::GetFunction(codegen),
+      {left_parts, codegen.Const64(hash_table_.HashEntrySize())});
+  auto *partition_fn = RadixPartitionerProxy::_Partition::GetFunction(codegen);
+  codegen.CallFunc(partition_fn, {left_parts, radix_bits});
+  codegen.CallFunc(partition_fn, {right_parts, radix_bits});
+
+  auto *num_partitions = codegen.CallFunc(
+      RadixPartitionerProxy::_GetNumPartitions::GetFunction(codegen),
+      {left_parts});
+  auto *start_fn =
+      RadixPartitionerProxy::_GetPartitionStart::GetFunction(codegen);
+  auto *size_fn =
+      RadixPartitionerProxy::_GetPartitionSize::GetFunction(codegen);
+
+  uint32_t left_entry_size = util::RadixPartitioner::ComputeEntrySize(
+      left_partition_storage_.MaxStorageSize());
+  uint32_t right_entry_size = util::RadixPartitioner::ComputeEntrySize(
+      right_partition_storage_.MaxStorageSize());
+
+  Vector selection_vector{LoadStateValue(output_vector_id_),
+                          Vector::kDefaultVectorSize, codegen.Int32Type()};
+
+  llvm::Value *partition = codegen.Const32(0);
+  lang::Loop partition_loop{codegen,
+                            codegen->CreateICmpULT(partition, num_partitions),
+                            {{"partition", partition}}};
+  {
+    partition = partition_loop.GetLoopVar(0);
+
+    // Build the hash table on the left partition. The table is sized for all
+    // entries up front, at a load factor of 50%.
+    auto *left_start = codegen.CallFunc(start_fn, {left_parts, partition});
+    auto *left_size = codegen.CallFunc(size_fn, {left_parts, partition});
+    hash_table_.Reset(codegen, ht_ptr,
+                      codegen->CreateShl(left_size, codegen.Const64(1)));
+
+    auto *left_end = codegen->CreateInBoundsGEP(
+        left_start,
+        codegen->CreateMul(left_size, codegen.Const64(left_entry_size)));
+    lang::Loop build_loop{codegen,
+                          codegen->CreateICmpNE(left_start, left_end),
+                          {{"entry", left_start}}};
+    {
+      llvm::Value *entry = build_loop.GetLoopVar(0);
+
+      // The entry is the hash, followed by the key and the values
+      llvm::Value *hash = codegen->CreateLoad(
+          codegen->CreateBitCast(entry, codegen.Int64Type()->getPointerTo()));
+      std::vector<codegen::Value> tuple;
+      left_partition_storage_.LoadValues(
+          codegen, codegen->CreateConstInBoundsGEP1_32(
+                       codegen.ByteType(), entry, sizeof(uint64_t)),
+          tuple);
+
+      std::vector<codegen::Value> key{tuple.begin(),
+                                      tuple.begin() + left_key_exprs_.size()};
+      std::vector<codegen::Value> vals{tuple.begin() + left_key_exprs_.size(),
+                                       tuple.end()};
+      InsertLeft insert_left{left_value_storage_, vals};
+      hash_table_.Insert(codegen, ht_ptr, hash, key, insert_left);
+
+      entry = codegen->CreateConstInBoundsGEP1_32(codegen.ByteType(), entry,
+                                                  left_entry_size);
+      build_loop.LoopEnd(codegen->CreateICmpNE(entry, left_end), {entry});
+    }
+
+    // Probe with the right partition, in vectors of tuples. The join starts
+    // the pipeline, so the matches are sent on to the next operator.
+    auto *right_start = codegen.CallFunc(start_fn, {right_parts, partition});
+    auto *right_size = codegen->CreateTruncOrBitCast(
+        codegen.CallFunc(size_fn, {right_parts, partition}),
+        codegen.Int32Type());
+
+    lang::VectorizedLoop probe_loop{
+        codegen, right_size, selection_vector.GetCapacity(), {}};
+    {
+      auto curr_range = probe_loop.GetCurrentRange();
+      RowBatch batch{GetCompilationContext(), curr_range.start, curr_range.end,
+                     selection_vector, false};
+
+      ConsumerContext context{GetCompilationContext(), GetPipeline()};
+      batch.Iterate(codegen, [&](RowBatch::Row &row) {
+        // Load the attributes of the right tuple into the row
+        llvm::Value *entry = codegen->CreateInBoundsGEP(
+            right_start, codegen->CreateMul(row.GetTID(codegen),
+                                            codegen.Const32(right_entry_size)));
+        std::vector<codegen::Value> vals;
+        right_partition_storage_.LoadValues(
+            codegen, codegen->CreateConstInBoundsGEP1_32(
+                         codegen.ByteType(), entry, sizeof(uint64_t)),
+            vals);
+        for (uint32_t i = 0; i < right_ais_.size(); i++) {
+          row.RegisterAttributeValue(right_ais_[i], vals[i]);
+        }
+
+        ProbeHashTable(context, row, ht_ptr);
+      });
+
+      probe_loop.LoopEnd(codegen, {});
+    }
+
+    // The matches of the left partition are complete
+    if (PreservesLeft()) {
+      OutputUnmatchedLeft(ht_ptr);
+    }
+
+    partition = codegen->CreateAdd(partition, codegen.Const32(1));
+    partition_loop.LoopEnd(codegen->CreateICmpULT(partition, num_partitions),
+                           {partition});
+  }
+}
+
+// Cleanup by destroying the hash-table instance and the partitioners
 void HashJoinTranslator::TearDownState() {
-  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+  auto &codegen = GetCodeGen();
+  hash_table_.Destroy(codegen, LoadStatePtr(hash_table_id_));
+
+  if (UseRadixPartitioning()) {
+    auto *destroy_fn = RadixPartitionerProxy::_Destroy::GetFunction(codegen);
+    codegen.CallFunc(destroy_fn, {LoadStatePtr(left_partitioner_id_)});
+    codegen.CallFunc(destroy_fn, {LoadStatePtr(right_partitioner_id_)});
+  }
 }
 
 // Get the stringified name of this join
@@ -319,22 +685,47 @@ std::string HashJoinTranslator::GetName() const {
       name.append("Semi");
       break;
     }
+    case JoinType::ANTI: {
+      name.append("Anti");
+      break;
+    }
     case JoinType::INVALID:
       throw Exception{"Invalid join type"};
   }
   return name;
 }
 
-// Estimate the size of the dynamically constructed hash-table
+// Estimate the size of the dynamically constructed hash-table, which holds
+// every tuple of the left side at a load factor of 50%
 uint64_t HashJoinTranslator::EstimateHashTableSize() const {
-  // TODO: Implement me
-  return 0;
+  return 2 * join_.GetBuildSizeEstimate() * hash_table_.HashEntrySize();
 }
 
-// Should this aggregation use prefetching
+bool HashJoinTranslator::PreservesLeft() const {
+  return join_.GetJoinType() == JoinType::LEFT ||
+         join_.GetJoinType() == JoinType::OUTER;
+}
+
+bool HashJoinTranslator::PreservesRight() const {
+  return join_.GetJoinType() == JoinType::RIGHT ||
+         join_.GetJoinType() == JoinType::OUTER;
+}
+
+bool HashJoinTranslator::OutputsMatches() const {
+  return join_.GetJoinType() != JoinType::SEMI &&
+         join_.GetJoinType() != JoinType::ANTI;
+}
+
+bool HashJoinTranslator::TracksRightMatches() const {
+  return PreservesRight() || !OutputsMatches();
+}
+
+// Should this aggregation use prefetching. The hash table of a partitioned
+// join is only built after both sides are buffered, there's nothing to
+// prefetch while they are consumed.
 bool HashJoinTranslator::UsePrefetching() const {
   // TODO: Implement me
-  return kUsePrefetch;
+  return kUsePrefetch && !UseRadixPartitioning();
 }
 
 void HashJoinTranslator::CollectKeys(
@@ -360,11 +751,13 @@ void HashJoinTranslator::CollectValues(
 
 HashJoinTranslator::ProbeRight::ProbeRight(
     const HashJoinTranslator &join_translator, ConsumerContext &context,
-    RowBatch::Row &row, const std::vector<codegen::Value> &right_key)
+    RowBatch::Row &row, const std::vector<codegen::Value> &right_key,
+    llvm::Value *matched_ptr)
     : join_translator_(join_translator),
       context_(context),
       row_(row),
-      right_key_(right_key) {}
+      right_key_(right_key),
+      matched_ptr_(matched_ptr) {}
 
 // The callback invoked when iterating the hash table.  The key and value of
 // the current hash table entry are provided as parameters.  We add these to
@@ -401,6 +794,20 @@ void HashJoinTranslator::ProbeRight::ProcessEntry(
     }
   }
 
+  // The tuples are partners. Flag that both sides found one, if that's
+  // tracked, and send the joined row up to the parent.
+  auto output_match = [&]() {
+    if (matched_ptr_ != nullptr) {
+      codegen->CreateStore(codegen.ConstBool(true), matched_ptr_);
+    }
+    if (join_translator_.PreservesLeft()) {
+      join_translator_.hash_table_.MarkMatched(codegen, data_area);
+    }
+    if (join_translator_.OutputsMatches()) {
+      context_.Consume(row_);
+    }
+  };
+
   // Check predicate if one exists
   auto *predicate = join_translator_.GetJoinPlan().GetPredicate();
   if (predicate != nullptr) {
@@ -408,14 +815,59 @@ void HashJoinTranslator::ProbeRight::ProcessEntry(
     auto valid_row = row_.DeriveValue(codegen, *predicate);
     lang::If is_valid_row{codegen, valid_row};
     {
-      // Send row up to the parent
-      context_.Consume(row_);
+      output_match();
     }
     is_valid_row.EndIf();
   } else {
+    output_match();
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// PRODUCE UNMATCHED LEFT
+//===----------------------------------------------------------------------===//
+
+HashJoinTranslator::ProduceUnmatchedLeft::ProduceUnmatchedLeft(
+    const HashJoinTranslator &join_translator, ConsumerContext &context,
+    RowBatch &batch)
+    : join_translator_(join_translator), context_(context), batch_(batch) {}
+
+// The callback invoked for every entry of the hash table. Entries that weren't
+// flagged as matched are sent up the tree, with NULLs for the right side.
+void HashJoinTranslator::ProduceUnmatchedLeft::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &key,
+    llvm::Value *data_area) const {
+  const auto &hash_table = join_translator_.hash_table_;
+  lang::If is_unmatched{
+      codegen, codegen->CreateNot(hash_table.IsMatched(codegen, data_area))};
+  {
+    RowBatch::Row row = batch_.GetRowAt(codegen.Const32(0));
+
+    // LoadValues all the values from the hash entry
+    std::vector<codegen::Value> left_vals;
+    join_translator_.left_value_storage_.LoadValues(codegen, data_area,
+                                                    left_vals);
+
+    // Put the values and the keys into the row
+    const auto &left_val_ais = join_translator_.left_val_ais_;
+    for (uint32_t i = 0; i < left_val_ais.size(); i++) {
+      row.RegisterAttributeValue(left_val_ais[i], left_vals[i]);
+    }
+    const auto &left_key_exprs = join_translator_.left_key_exprs_;
+    for (uint32_t i = 0; i < left_key_exprs.size(); i++) {
+      const auto *exp = left_key_exprs[i];
+      if (exp->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+        auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+        codegen::Value v = key[i];
+        row.RegisterAttributeValue(tve->GetAttributeRef(), v);
+      }
+    }
+    join_translator_.RegisterRightNulls(row);
+
     // Send the row up to the parent
-    context_.Consume(row_);
+    context_.Consume(row);
   }
+  is_unmatched.EndIf();
 }
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_translator.cpp
+//
+// Identification: src/codegen/operator/index_join_translator.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/index_join_translator.h"
+
+#include <set>
+#include <unordered_set>
+
+#include "codegen/compilation_context.h"
+#include "codegen/lang/if.h"
+#include "codegen/lang/loop.h"
+#include "codegen/proxy/catalog_proxy.h"
+#include "codegen/proxy/index_probe_proxy.h"
+#include "codegen/proxy/runtime_functions_proxy.h"
+#include "codegen/type/sql_type.h"
+#include "codegen/util/index_probe.h"
+#include "codegen/value_proxy.h"
+#include "index/index.h"
+#include "planner/index_join_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// INDEX JOIN TRANSLATOR
+//===----------------------------------------------------------------------===//
+
+// Constructor
+IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlan &join,
+                                         CompilationContext &context,
+                                         Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline),
+      join_(join),
+      tile_group_(*join.GetTable()->GetSchema()) {
+  LOG_DEBUG("Constructing IndexJoinTranslator ...");
+
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = context.GetRuntimeState();
+
+  // Keys are probed in groups, so we want to receive batches of outer rows
+  pipeline.InstallBoundaryAtInput(this);
+
+  // Prepare the outer child
+  context.Prepare(*join_.GetChild(0), pipeline);
+
+  // Prepare the expressions that produce the keys
+  join_.GetOuterKeys(outer_key_exprs_);
+  for (const auto *outer_key : outer_key_exprs_) {
+    context.Prepare(*outer_key);
+  }
+
+  // Prepare the predicates
+  const auto *predicate = join_.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+  const auto *inner_predicate = join_.GetInnerPredicate();
+  if (inner_predicate != nullptr) {
+    context.Prepare(*inner_predicate);
+  }
+
+  // Load the columns on the right side of the join, and the ones the inner
+  // predicate needs
+  join_.GetInnerAttributes(inner_ais_);
+  std::set<oid_t> inner_col_ids{join_.GetColumnIds().begin(),
+                                join_.GetColumnIds().end()};
+  if (inner_predicate != nullptr) {
+    std::unordered_set<const planner::AttributeInfo *> used_ais;
+    inner_predicate->GetUsedAttributes(used_ais);
+    for (const auto *ai : used_ais) {
+      inner_col_ids.insert(ai->attribute_id);
+    }
+  }
+  inner_col_ids_.assign(inner_col_ids.begin(), inner_col_ids.end());
+
+  // Allocate state for the probe, the key and the layout of the inner table
+  probe_id_ = runtime_state.RegisterState("indexProbe",
+                                          IndexProbeProxy::GetType(codegen));
+  key_values_id_ = runtime_state.RegisterState(
+      "indexKey", codegen.VectorType(ValueProxy::GetType(codegen),
+                                     outer_key_exprs_.size()),
+      true);
+  auto *layout_type =
+      RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(codegen);
+  column_layouts_id_ = runtime_state.RegisterState(
+      "innerLayouts",
+      codegen.VectorType(layout_type,
+                         join_.GetTable()->GetSchema()->GetColumnCount()),
+      true);
+
+  LOG_DEBUG("Finished constructing IndexJoinTranslator ...");
+}
+
+// Initialize the probe for the index of the inner table
+void IndexJoinTranslator::InitializeState() {
+  auto &codegen = GetCodeGen();
+  const auto *table = join_.GetTable();
+
+  llvm::Value *table_ptr = codegen.CallFunc(
+      CatalogProxy::_GetTableWithOid::GetFunction(codegen),
+      {GetCatalogPtr(), codegen.Const32(table->GetDatabaseOid()),
+       codegen.Const32(table->GetOid())});
+  codegen.CallFunc(IndexProbeProxy::_Init::GetFunction(codegen),
+                   {LoadStatePtr(probe_id_), table_ptr,
+                    codegen.Const32(join_.GetIndex()->GetOid())});
+}
+
+// Produce!
+void IndexJoinTranslator::Produce() const {
+  // Let the outer child produce the rows we look up in the index
+  GetCompilationContext().Produce(*join_.GetChild(0));
+}
+
+// Probe the index with the keys of groups of rows in the batch
+void IndexJoinTranslator::Consume(ConsumerContext &context,
+                                  RowBatch &batch) const {
+  auto &codegen = GetCodeGen();
+
+  auto probe_group = [&](
+      RowBatch::VectorizedIterateCallback::IterationInstance &iter_instance) {
+    llvm::Value *p = codegen.Const32(0);
+    llvm::Value *end =
+        codegen->CreateSub(iter_instance.end, iter_instance.start);
+
+    // The first loop adds the keys of all rows in the group
+    lang::Loop key_loop{codegen, codegen->CreateICmpULT(p, end), {{"p", p}}};
+    {
+      p = key_loop.GetLoopVar(0);
+      RowBatch::Row row =
+          batch.GetRowAt(codegen->CreateAdd(p, iter_instance.start));
+      AddKey(row);
+
+      p = codegen->CreateAdd(p, codegen.Const32(1));
+      key_loop.LoopEnd(codegen->CreateICmpULT(p, end), {p});
+    }
+
+    // Probe the index with all keys at once
+    llvm::Value *num_matches = Probe();
+
+    // The second loop joins every match with the row that produced its key
+    llvm::Value *m = codegen.Const32(0);
+    lang::Loop match_loop{
+        codegen, codegen->CreateICmpULT(m, num_matches), {{"m", m}}};
+    {
+      m = match_loop.GetLoopVar(0);
+      llvm::Value *read_pos =
+          codegen->CreateAdd(GetMatchKey(m), iter_instance.start);
+      RowBatch::Row row = batch.GetRowAt(read_pos);
+      JoinMatch(context, row, m);
+
+      m = codegen->CreateAdd(m, codegen.Const32(1));
+      match_loop.LoopEnd(codegen->CreateICmpULT(m, num_matches), {m});
+    }
+
+    // The join doesn't filter the batch, all rows stay valid
+    return iter_instance.end;
+  };
+
+  batch.VectorizedIterate(codegen, util::IndexProbe::kDefaultBatchSize,
+                          probe_group);
+}
+
+// Probe the index with the key of a single row
+void IndexJoinTranslator::Consume(ConsumerContext &context,
+                                  RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  AddKey(row);
+  llvm::Value *num_matches = Probe();
+
+  llvm::Value *m = codegen.Const32(0);
+  lang::Loop match_loop{
+      codegen, codegen->CreateICmpULT(m, num_matches), {{"m", m}}};
+  {
+    m = match_loop.GetLoopVar(0);
+    JoinMatch(context, row, m);
+
+    m = codegen->CreateAdd(m, codegen.Const32(1));
+    match_loop.LoopEnd(codegen->CreateICmpULT(m, num_matches), {m});
+  }
+}
+
+// Cleanup by destroying the probe
+void IndexJoinTranslator::TearDownState() {
+  auto &codegen = GetCodeGen();
+  codegen.CallFunc(IndexProbeProxy::_Destroy::GetFunction(codegen),
+                   {LoadStatePtr(probe_id_)});
+}
+
+// Get the stringified name of this join
+std::string IndexJoinTranslator::GetName() const {
+  return "IndexJoin('" + join_.GetIndex()->GetName() + "')";
+}
+
+// Write the values of the key into the key array, and add it to the probe
+void IndexJoinTranslator::AddKey(RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+  llvm::Value *key_values = LoadStateValue(key_values_id_);
+
+  for (size_t i = 0; i < outer_key_exprs_.size(); i++) {
+    codegen::Value val = row.DeriveValue(codegen, *outer_key_exprs_[i]);
+    const auto &sql_type = val.GetType().GetSqlType();
+
+    // If the value is NULL, store the NULL value for the given type
+    Value null_val;
+    lang::If val_is_null{codegen, val.IsNull(codegen)};
+    {
+      null_val = sql_type.GetNullValue(codegen);
+    }
+    val_is_null.EndIf();
+    val = val_is_null.BuildPHI(null_val, val);
+
+    // Write the value using the type's output function
+    auto *output_func = sql_type.GetOutputFunction(codegen, val.GetType());
+    std::vector<llvm::Value *> args = {key_values, codegen.Const64(i),
+                                       val.GetValue()};
+    if (val.GetLength() != nullptr) args.push_back(val.GetLength());
+    codegen.CallFunc(output_func, args);
+  }
+
+  codegen.CallFunc(IndexProbeProxy::_AddKey::GetFunction(codegen),
+                   {LoadStatePtr(probe_id_), key_values});
+}
+
+llvm::Value *IndexJoinTranslator::Probe() const {
+  auto &codegen = GetCodeGen();
+  llvm::Value *txn = GetCompilationContext().GetTransactionPtr();
+  return codegen.CallFunc(IndexProbeProxy::_Probe::GetFunction(codegen),
+                          {LoadStatePtr(probe_id_), txn});
+}
+
+llvm::Value *IndexJoinTranslator::GetMatchKey(llvm::Value *match_idx) const {
+  auto &codegen = GetCodeGen();
+  return codegen.CallFunc(IndexProbeProxy::_GetMatchKey::GetFunction(codegen),
+                          {LoadStatePtr(probe_id_), match_idx});
+}
+
+// Load the columns of the matching inner tuple into the row, check the
+// predicates and send the row up to the parent
+void IndexJoinTranslator::JoinMatch(ConsumerContext &context,
+                                    RowBatch::Row &row,
+                                    llvm::Value *match_idx) const {
+  auto &codegen = GetCodeGen();
+  llvm::Value *probe_ptr = LoadStatePtr(probe_id_);
+
+  llvm::Value *tile_group_ptr = codegen.CallFunc(
+      IndexProbeProxy::_GetMatchTileGroup::GetFunction(codegen),
+      {probe_ptr, match_idx});
+  llvm::Value *tid =
+      codegen.CallFunc(IndexProbeProxy::_GetMatchTid::GetFunction(codegen),
+                       {probe_ptr, match_idx});
+
+  // Load the inner columns into the row
+  auto layouts = tile_group_.GetColumnLayouts(
+      codegen, tile_group_ptr, LoadStateValue(column_layouts_id_));
+  TileGroup::TileGroupAccess tile_group_access{tile_group_, layouts};
+  auto inner_row = tile_group_access.GetRow(tid);
+  for (oid_t col_id : inner_col_ids_) {
+    codegen::Value val = inner_row.LoadColumn(codegen, col_id);
+    row.RegisterAttributeValue(inner_ais_[col_id], val);
+  }
+
+  // Check the inner and the join predicate, if any
+  const auto *inner_predicate = join_.GetInnerPredicate();
+  const auto *predicate = join_.GetPredicate();
+  if (inner_predicate == nullptr && predicate == nullptr) {
+    context.Consume(row);
+    return;
+  }
+
+  codegen::Value valid_row;
+  if (inner_predicate != nullptr && predicate != nullptr) {
+    valid_row = row.DeriveValue(codegen, *inner_predicate)
+                    .LogicalAnd(codegen, row.DeriveValue(codegen, *predicate));
+  } else if (inner_predicate != nullptr) {
+    valid_row = row.DeriveValue(codegen, *inner_predicate);
+  } else {
+    valid_row = row.DeriveValue(codegen, *predicate);
+  }
+
+  lang::If is_valid_row{codegen, valid_row};
+  {
+    // Send row up to the parent
+    context.Consume(row);
+  }
+  is_valid_row.EndIf();
+}
+
+}  // namespace codegen
+}  // namespace peloton
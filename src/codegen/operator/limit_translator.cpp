@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.cpp
+//
+// Identification: src/codegen/operator/limit_translator.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/operator/limit_translator.h"
+
+#include <limits>
+
+#include "codegen/lang/if.h"
+#include "planner/limit_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+LimitTranslator::LimitTranslator(const planner::LimitPlan &plan,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline), plan_(plan) {
+  // Prepare translator for our child
+  context.Prepare(*plan_.GetChild(0), pipeline);
+
+  // The counter lives on the stack of the plan function
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = context.GetRuntimeState();
+  count_id_ =
+      runtime_state.RegisterState("limitCount", codegen.Int64Type(), true);
+}
+
+void LimitTranslator::Produce() const {
+  auto &codegen = GetCodeGen();
+  codegen->CreateStore(codegen.Const64(0), LoadStateValue(count_id_));
+
+  GetCompilationContext().Produce(*plan_.GetChild(0));
+}
+
+void LimitTranslator::Consume(ConsumerContext &context,
+                              RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  // Count the row. The value of local state is its stack slot.
+  llvm::Value *count_ptr = LoadStateValue(count_id_);
+  llvm::Value *count = codegen->CreateLoad(count_ptr);
+  codegen->CreateStore(codegen->CreateAdd(count, codegen.Const64(1)),
+                       count_ptr);
+
+  // Only rows past the offset and before the end of the limit are passed on
+  llvm::Value *past_offset =
+      codegen->CreateICmpUGE(count, codegen.Const64(plan_.GetOffset()));
+  llvm::Value *before_end =
+      codegen->CreateICmpULT(count, codegen.Const64(GetEnd()));
+  lang::If in_limit{codegen, codegen->CreateAnd(past_offset, before_end)};
+  {
+    // Send row up to the parent
+    context.Consume(row);
+  }
+  in_limit.EndIf();
+}
+
+llvm::Value *LimitTranslator::IsFinished() const {
+  auto &codegen = GetCodeGen();
+  llvm::Value *count = codegen->CreateLoad(LoadStateValue(count_id_));
+  return codegen->CreateICmpUGE(count, codegen.Const64(GetEnd()));
+}
+
+std::string LimitTranslator::GetName() const {
+  return "Limit(" + std::to_string(plan_.GetLimit()) + ", " +
+         std::to_string(plan_.GetOffset()) + ")";
+}
+
+// The end of the limit saturates, since "no limit" may be given as the largest
+// possible limit
+uint64_t LimitTranslator::GetEnd() const {
+  uint64_t offset = plan_.GetOffset(), limit = plan_.GetLimit();
+  if (limit > std::numeric_limits<uint64_t>::max() - offset) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return offset + limit;
+}
+
+}  // namespace codegen
+}  // namespace peloton
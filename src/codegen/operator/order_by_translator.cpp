@@ -107,9 +107,17 @@ OrderByTranslator::OrderByTranslator(const planner::OrderByPlan &plan,
   LOG_DEBUG("Finished constructing OrderByTranslator ...");
 }
 
-// Initialize the sorter instance
+// Initialize the sorter instance. If the sort feeds a limit, the sorter only
+// needs to retain the tuples up to the end of the limit.
 void OrderByTranslator::InitializeState() {
-  sorter_.Init(GetCodeGen(), LoadStatePtr(sorter_id_), compare_func_);
+  auto &codegen = GetCodeGen();
+  if (plan_.GetLimit()) {
+    uint64_t top_k = plan_.GetLimitOffset() + plan_.GetLimitNumber();
+    sorter_.InitTopK(codegen, LoadStatePtr(sorter_id_), compare_func_,
+                     codegen.Const64(top_k));
+  } else {
+    sorter_.Init(codegen, LoadStatePtr(sorter_id_), compare_func_);
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -261,14 +269,20 @@ void OrderByTranslator::Consume(ConsumerContext &, RowBatch::Row &row) const {
   }
 
   // Append the tuple into the sorter
-  sorter_.Append(codegen, LoadStatePtr(sorter_id_), tuple);
+  if (plan_.GetLimit()) {
+    sorter_.AppendTopK(codegen, LoadStatePtr(sorter_id_), tuple);
+  } else {
+    sorter_.Append(codegen, LoadStatePtr(sorter_id_), tuple);
+  }
 }
 
 void OrderByTranslator::TearDownState() {
   sorter_.Destroy(GetCodeGen(), LoadStatePtr(sorter_id_));
 }
 
-std::string OrderByTranslator::GetName() const { return "OrderBy"; }
+std::string OrderByTranslator::GetName() const {
+  return plan_.GetLimit() ? "OrderBy(TopN)" : "OrderBy";
+}
 
 //===----------------------------------------------------------------------===//
 // PRODUCE RESULTS
@@ -14,8 +14,11 @@
 
 #include "codegen/lang/if.h"
 #include "codegen/proxy/catalog_proxy.h"
+#include "codegen/proxy/compressed_filter_proxy.h"
 #include "codegen/proxy/transaction_runtime_proxy.h"
 #include "codegen/type/boolean_type.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
 
@@ -46,6 +49,11 @@ TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
     if (predicate->IsSIMDable()) {
       pipeline.InstallBoundaryAtOutput(this);
     }
+
+    // Check if the predicate can be evaluated on compressed tile groups
+    if (!CollectCompressedTerms(*predicate, compressed_terms_)) {
+      compressed_terms_.clear();
+    }
   }
 
   auto &codegen = GetCodeGen();
@@ -55,9 +63,45 @@ TableScanTranslator::TableScanTranslator(const planner::SeqScanPlan &scan,
       codegen.VectorType(codegen.Int32Type(), Vector::kDefaultVectorSize),
       true);
 
+  if (!compressed_terms_.empty()) {
+    compressed_filter_id_ = runtime_state.RegisterState(
+        "compressedFilter", CompressedFilterProxy::GetType(codegen));
+  }
+
   LOG_DEBUG("Finished constructing TableScanTranslator ...");
 }
 
+// Add the terms of the predicate to the compressed filter
+void TableScanTranslator::InitializeState() {
+  if (compressed_terms_.empty()) {
+    return;
+  }
+
+  auto &codegen = GetCodeGen();
+  llvm::Value *filter_ptr = LoadStatePtr(compressed_filter_id_);
+  codegen.CallFunc(CompressedFilterProxy::_Init::GetFunction(codegen),
+                   {filter_ptr});
+
+  for (const auto &term : compressed_terms_) {
+    llvm::Value *column_id = codegen.Const32(term.column_id);
+    llvm::Value *comparison =
+        codegen.Const32(static_cast<int32_t>(term.comparison));
+    if (term.constant.GetTypeId() == peloton::type::TypeId::VARCHAR) {
+      std::string str = term.constant.ToString();
+      codegen.CallFunc(
+          CompressedFilterProxy::_AddStringTerm::GetFunction(codegen),
+          {filter_ptr, column_id, comparison, codegen.ConstStringPtr(str),
+           codegen.Const32(static_cast<int32_t>(str.length()))});
+    } else {
+      int64_t val = term.constant.CastAs(peloton::type::TypeId::BIGINT)
+                        .GetAs<int64_t>();
+      codegen.CallFunc(
+          CompressedFilterProxy::_AddIntegerTerm::GetFunction(codegen),
+          {filter_ptr, column_id, comparison, codegen.Const64(val)});
+    }
+  }
+}
+
 // Produce!
 void TableScanTranslator::Produce() const {
   auto &codegen = GetCodeGen();
@@ -76,13 +120,30 @@ void TableScanTranslator::Produce() const {
   Vector sel_vec{LoadStateValue(selection_vector_id_),
                  Vector::kDefaultVectorSize, codegen.Int32Type()};
 
+  // The filter for compressed tile groups, if the predicate allows it
+  llvm::Value *compressed_filter_ptr = nullptr;
+  if (!compressed_terms_.empty()) {
+    compressed_filter_ptr = LoadStatePtr(compressed_filter_id_);
+  }
+
   // Generate the scan
-  ScanConsumer scan_consumer{*this, sel_vec};
+  ScanConsumer scan_consumer{*this, sel_vec, compressed_filter_ptr};
   table_.GenerateScan(codegen, table_ptr, sel_vec.GetCapacity(), scan_consumer);
 
   LOG_DEBUG("TableScan on [%u] finished producing tuples ...", table.GetOid());
 }
 
+// Cleanup by destroying the compressed filter
+void TableScanTranslator::TearDownState() {
+  if (compressed_terms_.empty()) {
+    return;
+  }
+
+  auto &codegen = GetCodeGen();
+  codegen.CallFunc(CompressedFilterProxy::_Destroy::GetFunction(codegen),
+                   {LoadStatePtr(compressed_filter_id_)});
+}
+
 // Get the stringified name of this scan
 std::string TableScanTranslator::GetName() const {
   std::string name = "Scan('" + GetTable().GetName() + "'";
@@ -99,14 +160,113 @@ const storage::DataTable &TableScanTranslator::GetTable() const {
   return *scan_.GetTable();
 }
 
+namespace {
+
+// The types compressed columns and their constants are encoded as
+bool IsCompressedIntegerType(peloton::type::TypeId type_id) {
+  switch (type_id) {
+    case peloton::type::TypeId::TINYINT:
+    case peloton::type::TypeId::SMALLINT:
+    case peloton::type::TypeId::INTEGER:
+    case peloton::type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // anonymous namespace
+
+bool TableScanTranslator::CollectCompressedTerms(
+    const expression::AbstractExpression &predicate,
+    std::vector<CompressedTerm> &terms) const {
+  auto expr_type = predicate.GetExpressionType();
+  if (expr_type == ExpressionType::CONJUNCTION_AND) {
+    return CollectCompressedTerms(*predicate.GetChild(0), terms) &&
+           CollectCompressedTerms(*predicate.GetChild(1), terms);
+  }
+
+  switch (expr_type) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+
+  const auto *left = predicate.GetChild(0);
+  const auto *right = predicate.GetChild(1);
+
+  // Normalize to "column <comparison> constant"
+  if (left->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+      right->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    switch (expr_type) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        expr_type = ExpressionType::COMPARE_GREATERTHAN;
+        break;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        expr_type = ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        expr_type = ExpressionType::COMPARE_LESSTHAN;
+        break;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        expr_type = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      right->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+
+  const auto *ai =
+      static_cast<const expression::TupleValueExpression *>(left)
+          ->GetAttributeRef();
+  const auto &constant =
+      static_cast<const expression::ConstantValueExpression *>(right)
+          ->GetValue();
+  if (constant.IsNull()) {
+    return false;
+  }
+
+  // Integer columns are compared with integer constants, and varchar columns
+  // (encoded with a dictionary) with varchar constants
+  auto column_type = GetTable().GetSchema()->GetType(ai->attribute_id);
+  auto constant_type = constant.GetTypeId();
+  bool encodable =
+      (IsCompressedIntegerType(column_type) &&
+       IsCompressedIntegerType(constant_type)) ||
+      (column_type == peloton::type::TypeId::VARCHAR &&
+       constant_type == peloton::type::TypeId::VARCHAR);
+  if (!encodable) {
+    return false;
+  }
+
+  terms.push_back(CompressedTerm{ai->attribute_id, expr_type, constant});
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // VECTORIZED SCAN CONSUMER
 //===----------------------------------------------------------------------===//
 
 // Constructor
 TableScanTranslator::ScanConsumer::ScanConsumer(
-    const TableScanTranslator &translator, Vector &selection_vector)
-    : translator_(translator), selection_vector_(selection_vector) {}
+    const TableScanTranslator &translator, Vector &selection_vector,
+    llvm::Value *compressed_filter_ptr)
+    : translator_(translator),
+      selection_vector_(selection_vector),
+      compressed_filter_ptr_(compressed_filter_ptr),
+      pipeline_position_(translator.GetPipeline().GetPosition()) {}
 
 // Generate the body of the vectorized scan
 void TableScanTranslator::ScanConsumer::ProcessTuples(
@@ -121,8 +281,13 @@ void TableScanTranslator::ScanConsumer::ProcessTuples(
   auto *predicate = GetPredicate();
   if (predicate != nullptr) {
     // First perform a vectorized filter, putting TIDs into the selection vector
-    FilterRowsByPredicate(codegen, tile_group_access, tid_start, tid_end,
-                          selection_vector_);
+    if (compressed_filter_ptr_ != nullptr) {
+      FilterRowsByCompressedPredicate(codegen, tile_group_access, tid_start,
+                                      tid_end, selection_vector_);
+    } else {
+      FilterRowsByPredicate(codegen, tile_group_access, tid_start, tid_end,
+                            selection_vector_);
+    }
   }
 
   // 3. Setup the (filtered) row batch and setup attribute accessors
@@ -132,7 +297,8 @@ void TableScanTranslator::ScanConsumer::ProcessTuples(
   std::vector<TableScanTranslator::AttributeAccess> attribute_accesses;
   SetupRowBatch(batch, tile_group_access, attribute_accesses);
 
-  // 4. Push the batch into the pipeline
+  // 4. Push the batch into the pipeline, starting from the scan
+  translator_.GetPipeline().SetPosition(pipeline_position_);
   ConsumerContext context{translator_.GetCompilationContext(),
                           translator_.GetPipeline()};
   context.Consume(batch);
@@ -227,6 +393,37 @@ void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
   });
 }
 
+void TableScanTranslator::ScanConsumer::FilterRowsByCompressedPredicate(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+    llvm::Value *tid_start, llvm::Value *tid_end,
+    Vector &selection_vector) const {
+  llvm::Value *is_frozen = codegen.CallFunc(
+      CompressedFilterProxy::_LoadTileGroup::GetFunction(codegen),
+      {compressed_filter_ptr_, tile_group_ptr_, tid_end});
+
+  llvm::Value *filtered_count = nullptr;
+  llvm::Value *evaluated_count = nullptr;
+  lang::If on_compressed{codegen, is_frozen, "filterCompressed"};
+  {
+    // Evaluate the predicate on the encoded columns
+    filtered_count = codegen.CallFunc(
+        CompressedFilterProxy::_Filter::GetFunction(codegen),
+        {compressed_filter_ptr_, selection_vector.GetVectorPtr(),
+         selection_vector.GetNumElements()});
+  }
+  on_compressed.ElseBlock("filterDecompressed");
+  {
+    // Evaluate the predicate on the tiles
+    FilterRowsByPredicate(codegen, access, tid_start, tid_end,
+                          selection_vector);
+    evaluated_count = selection_vector.GetNumElements();
+  }
+  on_compressed.EndIf();
+
+  selection_vector.SetNumElements(
+      on_compressed.BuildPHI(filtered_count, evaluated_count));
+}
+
 //===----------------------------------------------------------------------===//
 // ATTRIBUTE ACCESS
 //===----------------------------------------------------------------------===//
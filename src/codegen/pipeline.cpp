@@ -12,6 +12,7 @@
 
 #include "codegen/pipeline.h"
 
+#include "codegen/codegen.h"
 #include "codegen/operator/operator_translator.h"
 
 namespace peloton {
@@ -53,6 +54,11 @@ bool Pipeline::AtStageBoundary() const {
                    pipeline_index_) != stage_boundaries_.end();
 }
 
+// Get the current operator in this pipeline
+const OperatorTranslator *Pipeline::GetCurrentStep() const {
+  return pipeline_[pipeline_index_];
+}
+
 // Get the child of the current operator in this pipeline
 const OperatorTranslator *Pipeline::GetChild() const {
   return pipeline_index_ < pipeline_.size() - 1 ? pipeline_[pipeline_index_ + 1]
@@ -68,6 +74,30 @@ const OperatorTranslator *Pipeline::NextStep() {
   }
 }
 
+// Get the current position in this pipeline
+uint32_t Pipeline::GetPosition() const { return pipeline_index_; }
+
+// Rewind this pipeline to the given position
+void Pipeline::SetPosition(uint32_t position) {
+  PL_ASSERT(position < pipeline_.size());
+  pipeline_index_ = position;
+}
+
+// Check every operator in the pipeline
+llvm::Value *Pipeline::IsFinished(CodeGen &codegen) const {
+  llvm::Value *finished = nullptr;
+  for (const auto *translator : pipeline_) {
+    llvm::Value *translator_finished = translator->IsFinished();
+    if (translator_finished == nullptr) {
+      continue;
+    }
+    finished = (finished == nullptr
+                    ? translator_finished
+                    : codegen->CreateOr(finished, translator_finished));
+  }
+  return finished;
+}
+
 uint32_t Pipeline::GetNumStages() const {
   return static_cast<uint32_t>(stage_boundaries_.size()) + 1;
 }
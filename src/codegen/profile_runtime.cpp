@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// profile_runtime.cpp
+//
+// Identification: src/codegen/profile_runtime.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/profile_runtime.h"
+
+#include "executor/executor_context.h"
+#include "executor/query_profile.h"
+
+namespace peloton {
+namespace codegen {
+
+void ProfileRuntime::StartOperator(executor::ExecutorContext *executor_context,
+                                   uint32_t operator_id) {
+  executor_context->GetQueryProfile()->StartOperator(operator_id);
+}
+
+void ProfileRuntime::StopOperator(executor::ExecutorContext *executor_context,
+                                  uint32_t operator_id) {
+  executor_context->GetQueryProfile()->StopOperator(operator_id);
+}
+
+void ProfileRuntime::CountRows(executor::ExecutorContext *executor_context,
+                               uint32_t operator_id, uint32_t num_rows) {
+  executor_context->GetQueryProfile()->CountOutput(operator_id, num_rows, 0);
+}
+
+}  // namespace codegen
+}  // namespace peloton
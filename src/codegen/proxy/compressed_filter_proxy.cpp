@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_filter_proxy.cpp
+//
+// Identification: src/codegen/proxy/compressed_filter_proxy.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/compressed_filter_proxy.h"
+
+#include "codegen/proxy/tile_group_proxy.h"
+#include "codegen/util/compressed_filter.h"
+
+namespace peloton {
+namespace codegen {
+
+llvm::Type *CompressedFilterProxy::GetType(CodeGen &codegen) {
+  static const std::string kCompressedFilterTypeName =
+      "peloton::codegen::util::CompressedFilter";
+
+  auto *filter_type = codegen.LookupTypeByName(kCompressedFilterTypeName);
+  if (filter_type != nullptr) {
+    return filter_type;
+  }
+
+  // The filter is only accessed through its functions, so its fields are
+  // opaque
+  auto *opaque_arr_type =
+      codegen.VectorType(codegen.Int8Type(), sizeof(util::CompressedFilter));
+  return llvm::StructType::create(codegen.GetContext(), {opaque_arr_type},
+                                  kCompressedFilterTypeName);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::Init()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_Init::GetFunctionName() {
+  static const std::string kInitFnName =
+      "_ZN7peloton7codegen4util16CompressedFilter4InitEv";
+  return kInitFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_Init::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo()};  // filter *
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::AddIntegerTerm()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_AddIntegerTerm::GetFunctionName() {
+  static const std::string kAddIntegerTermFnName =
+      "_ZN7peloton7codegen4util16CompressedFilter14AddIntegerTermEjjl";
+  return kAddIntegerTermFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_AddIntegerTerm::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo(),  // filter *
+      codegen.Int32Type(),                                      // column_id
+      codegen.Int32Type(),                                      // comparison
+      codegen.Int64Type()};                                     // constant
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::AddStringTerm()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_AddStringTerm::GetFunctionName() {
+  static const std::string kAddStringTermFnName =
+      "_ZN7peloton7codegen4util16CompressedFilter13AddStringTermEjjPKcj";
+  return kAddStringTermFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_AddStringTerm::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo(),  // filter *
+      codegen.Int32Type(),                                      // column_id
+      codegen.Int32Type(),                                      // comparison
+      codegen.CharPtrType(),                                    // constant
+      codegen.Int32Type()};                                     // length
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::LoadTileGroup()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_LoadTileGroup::GetFunctionName() {
+  static const std::string kLoadTileGroupFnName =
+      "_ZN7peloton7codegen4util16CompressedFilter13LoadTileGroupEPKNS_"
+      "7storage9TileGroupEj";
+  return kLoadTileGroupFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_LoadTileGroup::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo(),  // filter *
+      TileGroupProxy::GetType(codegen)->getPointerTo(),         // tile_group *
+      codegen.Int32Type()};                                     // tid_end
+  auto *fn_type = llvm::FunctionType::get(codegen.BoolType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::Filter()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_Filter::GetFunctionName() {
+  static const std::string kFilterFnName =
+      "_ZNK7peloton7codegen4util16CompressedFilter6FilterEPjj";
+  return kFilterFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_Filter::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo(),  // filter *
+      codegen.Int32Type()->getPointerTo(),                      // sel_vec
+      codegen.Int32Type()};                                     // num_selected
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::CompressedFilter::Destroy()
+//===----------------------------------------------------------------------===//
+const std::string &CompressedFilterProxy::_Destroy::GetFunctionName() {
+  static const std::string kDestroyFnName =
+      "_ZN7peloton7codegen4util16CompressedFilter7DestroyEv";
+  return kDestroyFnName;
+}
+
+llvm::Function *CompressedFilterProxy::_Destroy::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      CompressedFilterProxy::GetType(codegen)->getPointerTo()};  // filter *
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// functions_runtime_proxy.cpp
+//
+// Identification: src/codegen/proxy/functions_runtime_proxy.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/functions_runtime_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// LIKE
+//===----------------------------------------------------------------------===//
+
+const std::string &FunctionsRuntimeProxy::_Like::GetFunctionName() {
+  static const std::string kLikeFnName =
+      "_ZN7peloton7codegen16FunctionsRuntime4LikeEPKcjS3_j";
+  return kLikeFnName;
+}
+
+llvm::Function *FunctionsRuntimeProxy::_Like::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {codegen.CharPtrType(),  // str
+                                         codegen.Int32Type(),    // str length
+                                         codegen.CharPtrType(),  // pattern
+                                         codegen.Int32Type()};   // pattern len
+  auto *fn_type = llvm::FunctionType::get(codegen.BoolType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// EXTRACT
+//===----------------------------------------------------------------------===//
+
+const std::string &FunctionsRuntimeProxy::_Extract::GetFunctionName() {
+  static const std::string kExtractFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen16FunctionsRuntime7ExtractEix";
+#else
+      "_ZN7peloton7codegen16FunctionsRuntime7ExtractEil";
+#endif
+  return kExtractFnName;
+}
+
+llvm::Function *FunctionsRuntimeProxy::_Extract::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {codegen.Int32Type(),   // date part
+                                         codegen.Int64Type()};  // timestamp
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.DoubleType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// SQRT
+//===----------------------------------------------------------------------===//
+
+const std::string &FunctionsRuntimeProxy::_Sqrt::GetFunctionName() {
+  static const std::string kSqrtFnName =
+      "_ZN7peloton7codegen16FunctionsRuntime4SqrtEd";
+  return kSqrtFnName;
+}
+
+llvm::Function *FunctionsRuntimeProxy::_Sqrt::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {codegen.DoubleType()};
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.DoubleType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
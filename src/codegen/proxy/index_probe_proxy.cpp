@@ -0,0 +1,222 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_probe_proxy.cpp
+//
+// Identification: src/codegen/proxy/index_probe_proxy.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/index_probe_proxy.h"
+
+#include "codegen/proxy/data_table_proxy.h"
+#include "codegen/proxy/tile_group_proxy.h"
+#include "codegen/proxy/transaction_proxy.h"
+#include "codegen/util/index_probe.h"
+#include "codegen/value_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+llvm::Type *IndexProbeProxy::GetType(CodeGen &codegen) {
+  static const std::string kIndexProbeTypeName =
+      "peloton::codegen::util::IndexProbe";
+
+  auto *index_probe_type = codegen.LookupTypeByName(kIndexProbeTypeName);
+  if (index_probe_type != nullptr) {
+    return index_probe_type;
+  }
+
+  // The probe is only accessed through its functions, so its fields are opaque
+  auto *opaque_arr_type =
+      codegen.VectorType(codegen.Int8Type(), sizeof(util::IndexProbe));
+  return llvm::StructType::create(codegen.GetContext(), {opaque_arr_type},
+                                  kIndexProbeTypeName);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::Init()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_Init::GetFunctionName() {
+  static const std::string kInitFnName =
+      "_ZN7peloton7codegen4util10IndexProbe4InitEPNS_7storage9DataTableEj";
+  return kInitFnName;
+}
+
+llvm::Function *IndexProbeProxy::_Init::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),  // probe *
+      DataTableProxy::GetType(codegen)->getPointerTo(),   // table *
+      codegen.Int32Type()};                               // index_oid
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::AddKey()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_AddKey::GetFunctionName() {
+  static const std::string kAddKeyFnName =
+      "_ZN7peloton7codegen4util10IndexProbe6AddKeyEPc";
+  return kAddKeyFnName;
+}
+
+llvm::Function *IndexProbeProxy::_AddKey::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),  // probe *
+      ValueProxy::GetType(codegen)->getPointerTo()};      // values
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::Probe()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_Probe::GetFunctionName() {
+  static const std::string kProbeFnName =
+      "_ZN7peloton7codegen4util10IndexProbe5ProbeEPNS_11concurrency"
+      "11TransactionE";
+  return kProbeFnName;
+}
+
+llvm::Function *IndexProbeProxy::_Probe::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),    // probe *
+      TransactionProxy::GetType(codegen)->getPointerTo()};  // txn *
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::GetMatchKey()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_GetMatchKey::GetFunctionName() {
+  static const std::string kGetMatchKeyFnName =
+      "_ZNK7peloton7codegen4util10IndexProbe11GetMatchKeyEj";
+  return kGetMatchKeyFnName;
+}
+
+llvm::Function *IndexProbeProxy::_GetMatchKey::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),  // probe *
+      codegen.Int32Type()};                               // match_idx
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::GetMatchTileGroup()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_GetMatchTileGroup::GetFunctionName() {
+  static const std::string kGetMatchTileGroupFnName =
+      "_ZNK7peloton7codegen4util10IndexProbe17GetMatchTileGroupEj";
+  return kGetMatchTileGroupFnName;
+}
+
+llvm::Function *IndexProbeProxy::_GetMatchTileGroup::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),  // probe *
+      codegen.Int32Type()};                               // match_idx
+  auto *fn_type = llvm::FunctionType::get(
+      TileGroupProxy::GetType(codegen)->getPointerTo(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::GetMatchTid()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_GetMatchTid::GetFunctionName() {
+  static const std::string kGetMatchTidFnName =
+      "_ZNK7peloton7codegen4util10IndexProbe11GetMatchTidEj";
+  return kGetMatchTidFnName;
+}
+
+llvm::Function *IndexProbeProxy::_GetMatchTid::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo(),  // probe *
+      codegen.Int32Type()};                               // match_idx
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::IndexProbe::Destroy()
+//===----------------------------------------------------------------------===//
+const std::string &IndexProbeProxy::_Destroy::GetFunctionName() {
+  static const std::string kDestroyFnName =
+      "_ZN7peloton7codegen4util10IndexProbe7DestroyEv";
+  return kDestroyFnName;
+}
+
+llvm::Function *IndexProbeProxy::_Destroy::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      IndexProbeProxy::GetType(codegen)->getPointerTo()};  // probe *
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -104,6 +104,44 @@ llvm::Function *OAHashTableProxy::_Init::GetFunction(CodeGen &codegen) {
   return codegen.RegisterFunction(fn_name, fn_type);
 };
 
+//===----------------------------------------------------------------------===//
+// RESET PROXY
+//===----------------------------------------------------------------------===//
+
+const std::string &OAHashTableProxy::_Reset::GetFunctionName() {
+  static const std::string kResetFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen4util11OAHashTable5ResetEm";
+#else
+      "_ZN7peloton7codegen4util11OAHashTable5ResetEm";
+#endif
+  return kResetFnName;
+}
+
+llvm::Function *OAHashTableProxy::_Reset::GetFunction(CodeGen &codegen) {
+  const std::string fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now
+
+  // Setup the function arguments
+  std::vector<llvm::Type *> arg_types = {
+      // The OAHashTable * instance
+      OAHashTableProxy::GetType(codegen)->getPointerTo(),
+
+      // An estimate on the number of entries the table will store
+      codegen.Int64Type()};
+
+  // Now create the prototype and register it
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
 //===----------------------------------------------------------------------===//
 // DESTROY PROXY
 //===----------------------------------------------------------------------===//
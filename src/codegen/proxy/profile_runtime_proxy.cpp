@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// profile_runtime_proxy.cpp
+//
+// Identification: src/codegen/proxy/profile_runtime_proxy.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/profile_runtime_proxy.h"
+
+#include "codegen/proxy/executor_context_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+const std::string &ProfileRuntimeProxy::_StartOperator::GetFunctionName() {
+  static const std::string kStartOperatorFnName =
+      "_ZN7peloton7codegen14ProfileRuntime13StartOperatorEPNS_8executor15"
+      "ExecutorContextEj";
+  return kStartOperatorFnName;
+}
+
+llvm::Function *ProfileRuntimeProxy::_StartOperator::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      ExecutorContextProxy::GetType(codegen)->getPointerTo(),  // context *
+      codegen.Int32Type()};                                    // operator_id
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+const std::string &ProfileRuntimeProxy::_StopOperator::GetFunctionName() {
+  static const std::string kStopOperatorFnName =
+      "_ZN7peloton7codegen14ProfileRuntime12StopOperatorEPNS_8executor15"
+      "ExecutorContextEj";
+  return kStopOperatorFnName;
+}
+
+llvm::Function *ProfileRuntimeProxy::_StopOperator::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      ExecutorContextProxy::GetType(codegen)->getPointerTo(),  // context *
+      codegen.Int32Type()};                                    // operator_id
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+const std::string &ProfileRuntimeProxy::_CountRows::GetFunctionName() {
+  static const std::string kCountRowsFnName =
+      "_ZN7peloton7codegen14ProfileRuntime9CountRowsEPNS_8executor15"
+      "ExecutorContextEjj";
+  return kCountRowsFnName;
+}
+
+llvm::Function *ProfileRuntimeProxy::_CountRows::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      ExecutorContextProxy::GetType(codegen)->getPointerTo(),  // context *
+      codegen.Int32Type(),                                     // operator_id
+      codegen.Int32Type()};                                    // num_rows
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,248 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// radix_partitioner_proxy.cpp
+//
+// Identification: src/codegen/proxy/radix_partitioner_proxy.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/proxy/radix_partitioner_proxy.h"
+
+#include "codegen/util/radix_partitioner.h"
+
+namespace peloton {
+namespace codegen {
+
+llvm::Type *RadixPartitionerProxy::GetType(CodeGen &codegen) {
+  static const std::string kRadixPartitionerTypeName =
+      "peloton::codegen::util::RadixPartitioner";
+
+  auto *partitioner_type = codegen.LookupTypeByName(kRadixPartitionerTypeName);
+  if (partitioner_type != nullptr) {
+    return partitioner_type;
+  }
+
+  // The partitioner is only accessed through its functions, so its fields are
+  // opaque
+  auto *opaque_arr_type =
+      codegen.VectorType(codegen.Int8Type(), sizeof(util::RadixPartitioner));
+  return llvm::StructType::create(codegen.GetContext(), {opaque_arr_type},
+                                  kRadixPartitionerTypeName);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::Init()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_Init::GetFunctionName() {
+  static const std::string kInitFnName =
+      "_ZN7peloton7codegen4util16RadixPartitioner4InitEj";
+  return kInitFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_Init::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int32Type()};                                     // tuple_size
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::StoreInputTuple()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_StoreInputTuple::GetFunctionName() {
+  static const std::string kStoreInputTupleFnName =
+      "_ZN7peloton7codegen4util16RadixPartitioner15StoreInputTupleEm";
+  return kStoreInputTupleFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_StoreInputTuple::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int64Type()};                                     // hash
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.CharPtrType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::ComputeRadixBits()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_ComputeRadixBits::GetFunctionName() {
+  static const std::string kComputeRadixBitsFnName =
+      "_ZNK7peloton7codegen4util16RadixPartitioner16ComputeRadixBitsEm";
+  return kComputeRadixBitsFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_ComputeRadixBits::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int64Type()};                                     // entry size
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::Partition()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_Partition::GetFunctionName() {
+  static const std::string kPartitionFnName =
+      "_ZN7peloton7codegen4util16RadixPartitioner9PartitionEj";
+  return kPartitionFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_Partition::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int32Type()};                                     // radix_bits
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::GetNumPartitions()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_GetNumPartitions::GetFunctionName() {
+  static const std::string kGetNumPartitionsFnName =
+      "_ZNK7peloton7codegen4util16RadixPartitioner16GetNumPartitionsEv";
+  return kGetNumPartitionsFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_GetNumPartitions::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo()};
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::GetPartitionStart()
+//===----------------------------------------------------------------------===//
+const std::string &
+RadixPartitionerProxy::_GetPartitionStart::GetFunctionName() {
+  static const std::string kGetPartitionStartFnName =
+      "_ZNK7peloton7codegen4util16RadixPartitioner17GetPartitionStartEj";
+  return kGetPartitionStartFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_GetPartitionStart::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int32Type()};                                     // partition
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.CharPtrType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::GetPartitionSize()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_GetPartitionSize::GetFunctionName() {
+  static const std::string kGetPartitionSizeFnName =
+      "_ZNK7peloton7codegen4util16RadixPartitioner16GetPartitionSizeEj";
+  return kGetPartitionSizeFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_GetPartitionSize::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo(),  // partitioner *
+      codegen.Int32Type()};                                     // partition
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int64Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===----------------------------------------------------------------------===//
+// The proxy for codegen::util::RadixPartitioner::Destroy()
+//===----------------------------------------------------------------------===//
+const std::string &RadixPartitionerProxy::_Destroy::GetFunctionName() {
+  static const std::string kDestroyFnName =
+      "_ZN7peloton7codegen4util16RadixPartitioner7DestroyEv";
+  return kDestroyFnName;
+}
+
+llvm::Function *RadixPartitionerProxy::_Destroy::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      RadixPartitionerProxy::GetType(codegen)->getPointerTo()};
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -48,7 +48,8 @@ llvm::Type *SorterProxy::GetType(CodeGen &codegen) {
       codegen.CharPtrType(),  // buffer position
       codegen.CharPtrType(),  // buffer end
       codegen.Int32Type(),    // tuple size
-      codegen.CharPtrType()   // comparison function pointer
+      codegen.CharPtrType(),  // comparison function pointer
+      codegen.Int64Type()     // top K
   };
   sorter_type = llvm::StructType::create(codegen.GetContext(), sorter_fields,
                                          kSorterTypeName);
@@ -129,6 +130,114 @@ llvm::Function *SorterProxy::_StoreInputTuple::GetFunction(CodeGen &codegen) {
   return codegen.RegisterFunction(fn_name, fn_type);
 }
 
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::util::Sorter::InitTopK()
+//===--------------------------------------------------------------------===//
+const std::string &SorterProxy::_InitTopK::GetFunctionName() {
+  static const std::string kInitTopKFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen4util6Sorter8InitTopKEPFiPKvS4_Ejm";
+#else
+      "_ZN7peloton7codegen4util6Sorter8InitTopKEPFiPKvS4_Ejm";
+#endif
+  return kInitTopKFnName;
+}
+
+llvm::Function *SorterProxy::_InitTopK::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+
+  // The function type of the comparison function is int(*)(void *, void*)
+  auto *comparison_fn_type = llvm::FunctionType::get(
+      codegen.Int32Type(), {codegen.CharPtrType(), codegen.CharPtrType()},
+      false);
+
+  // We need to create a function type whose signature matches
+  // codegen::util::Sorter::InitTopK(...). It should match:
+  //
+  // void InitTopK(Sorter *, int(*)(void *, void *), uint32_t, uint64_t)
+
+  std::vector<llvm::Type *> fn_args = {
+      SorterProxy::GetType(codegen)->getPointerTo(),
+      comparison_fn_type->getPointerTo(), codegen.Int32Type(),
+      codegen.Int64Type()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::util::Sorter::StoreInputTupleTopK()
+//===--------------------------------------------------------------------===//
+const std::string &SorterProxy::_StoreInputTupleTopK::GetFunctionName() {
+  static const std::string kStoreInputTupleTopKFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen4util6Sorter19StoreInputTupleTopKEv";
+#else
+      "_ZN7peloton7codegen4util6Sorter19StoreInputTupleTopKEv";
+#endif
+  return kStoreInputTupleTopKFnName;
+}
+
+llvm::Function *SorterProxy::_StoreInputTupleTopK::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  // We need to create a function type whose signature matches
+  // codegen::util::Sorter::StoreInputTupleTopK(...)
+  std::vector<llvm::Type *> fn_args = {
+      SorterProxy::GetType(codegen)->getPointerTo()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.CharPtrType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::util::Sorter::FinishStoreTopK()
+//===--------------------------------------------------------------------===//
+const std::string &SorterProxy::_FinishStoreTopK::GetFunctionName() {
+  static const std::string kFinishStoreTopKFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen4util6Sorter15FinishStoreTopKEv";
+#else
+      "_ZN7peloton7codegen4util6Sorter15FinishStoreTopKEv";
+#endif
+  return kFinishStoreTopKFnName;
+}
+
+llvm::Function *SorterProxy::_FinishStoreTopK::GetFunction(CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  // We need to create a function type whose signature matches
+  // codegen::util::Sorter::FinishStoreTopK(...)
+  std::vector<llvm::Type *> fn_args = {
+      SorterProxy::GetType(codegen)->getPointerTo()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
 //===--------------------------------------------------------------------===//
 // The proxy for codegen::util::Sorter::Sort()
 //===--------------------------------------------------------------------===//
@@ -13,9 +13,12 @@
 #include "codegen/query_compiler.h"
 
 #include "codegen/compilation_context.h"
+#include "codegen/expression/function_translator.h"
 #include "planner/seq_scan_plan.h"
 #include "planner/aggregate_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/index_join_plan.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace codegen {
@@ -26,12 +29,12 @@ QueryCompiler::QueryCompiler() : next_id_(0) {}
 // Compile the given query statement
 std::unique_ptr<Query> QueryCompiler::Compile(
     const planner::AbstractPlan &root, QueryResultConsumer &result_consumer,
-    CompileStats *stats) {
+    CompileStats *stats, executor::QueryProfile *profile) {
   // The query statement we compile
   std::unique_ptr<Query> query{new Query(root)};
 
   // Set up the compilation context
-  CompilationContext context{*query, result_consumer};
+  CompilationContext context{*query, result_consumer, profile};
 
   // Perform the compilation
   context.GeneratePlan(stats);
@@ -48,8 +51,20 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan) {
 bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
                                 const planner::AbstractPlan *parent) {
   switch (plan.GetPlanNodeType()) {
-    case PlanNodeType::SEQSCAN:
+    case PlanNodeType::SEQSCAN: {
+      // The generated scans read the slots directly. They can't rebuild the
+      // versions of a table that keeps its updates as delta records, nor
+      // follow the updated tuples into a version store
+      const auto &scan_plan = static_cast<const planner::SeqScanPlan &>(plan);
+      if (scan_plan.GetTable() != nullptr &&
+          (scan_plan.GetTable()->IsDeltaVersioning() ||
+           scan_plan.GetTable()->HasVersionStore())) {
+        return false;
+      }
+      break;
+    }
     case PlanNodeType::ORDERBY:
+    case PlanNodeType::LIMIT:
     case PlanNodeType::DELETE:
     case PlanNodeType::AGGREGATE_V2: {
       break;
@@ -60,10 +75,19 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
     }
     case PlanNodeType::HASHJOIN: {
       const auto &hjp = static_cast<const planner::HashJoinPlan &>(plan);
-      // Right now, only support inner joins
-      if (hjp.GetJoinType() == JoinType::INNER) {
+      if (hjp.GetJoinType() != JoinType::INVALID) {
         break;
       }
+      return false;
+    }
+    case PlanNodeType::NESTLOOPINDEX: {
+      const auto &ijp = static_cast<const planner::IndexJoinPlan &>(plan);
+      // Right now, only support inner joins on tables without delta records
+      if (ijp.GetJoinType() == JoinType::INNER &&
+          !ijp.GetTable()->IsDeltaVersioning()) {
+        break;
+      }
+      return false;
     }
     case PlanNodeType::HASH: {
       // Right now, only support hash's in hash-joins
@@ -93,6 +117,22 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
       pred = hj_plan.GetPredicate();
       break;
     }
+    case PlanNodeType::NESTLOOPINDEX: {
+      auto &ij_plan = static_cast<const planner::IndexJoinPlan &>(plan);
+      const auto *inner_pred = ij_plan.GetInnerPredicate();
+      if (inner_pred != nullptr && !IsExpressionSupported(*inner_pred)) {
+        return false;
+      }
+      std::vector<const expression::AbstractExpression *> outer_keys;
+      ij_plan.GetOuterKeys(outer_keys);
+      for (const auto *outer_key : outer_keys) {
+        if (!IsExpressionSupported(*outer_key)) {
+          return false;
+        }
+      }
+      pred = ij_plan.GetPredicate();
+      break;
+    }
     default: { break; }
   }
 
@@ -115,9 +155,13 @@ bool QueryCompiler::IsExpressionSupported(
     const expression::AbstractExpression &expr) {
   switch (expr.GetExpressionType()) {
     case ExpressionType::STAR:
-    case ExpressionType::FUNCTION:
     case ExpressionType::VALUE_PARAMETER:
       return false;
+    case ExpressionType::FUNCTION:
+      if (!FunctionTranslator::IsSupported(expr)) {
+        return false;
+      }
+      break;
     default:
       break;
   }
@@ -42,6 +42,14 @@ void Sorter::Init(CodeGen &codegen, llvm::Value *sorter_ptr,
                    {sorter_ptr, comparison_func, tuple_size});
 }
 
+// Just make a call to util::Sorter::InitTopK(...)
+void Sorter::InitTopK(CodeGen &codegen, llvm::Value *sorter_ptr,
+                      llvm::Value *comparison_func, llvm::Value *top_k) const {
+  auto *tuple_size = codegen.Const32(storage_format_.GetStorageSize());
+  codegen.CallFunc(SorterProxy::_InitTopK::GetFunction(codegen),
+                   {sorter_ptr, comparison_func, tuple_size, top_k});
+}
+
 // Append the given tuple into the sorter instance
 void Sorter::Append(CodeGen &codegen, llvm::Value *sorter_ptr,
                     const std::vector<codegen::Value> &tuple) const {
@@ -51,16 +59,20 @@ void Sorter::Append(CodeGen &codegen, llvm::Value *sorter_ptr,
   auto *space = codegen.CallFunc(store_func, {sorter_ptr});
 
   // Now, individually store the attributes of the tuple into the free space
-  UpdateableStorage::NullBitmap null_bitmap{codegen, storage_format_, space};
-  for (uint32_t col_id = 0; col_id < tuple.size(); col_id++) {
-    if (!null_bitmap.IsNullable(col_id)) {
-      storage_format_.SetValueSkipNull(codegen, space, col_id, tuple[col_id]);
-    } else {
-      storage_format_.SetValue(codegen, space, col_id, tuple[col_id],
-                               null_bitmap);
-    }
-  }
-  null_bitmap.WriteBack(codegen);
+  StoreTuple(codegen, space, tuple);
+}
+
+// Appending to a top-K sorter materializes the tuple into the space after the
+// heap, and then lets the sorter decide whether the tuple is retained
+void Sorter::AppendTopK(CodeGen &codegen, llvm::Value *sorter_ptr,
+                        const std::vector<codegen::Value> &tuple) const {
+  auto *store_func = SorterProxy::_StoreInputTupleTopK::GetFunction(codegen);
+  auto *space = codegen.CallFunc(store_func, {sorter_ptr});
+
+  StoreTuple(codegen, space, tuple);
+
+  auto *finish_func = SorterProxy::_FinishStoreTopK::GetFunction(codegen);
+  codegen.CallFunc(finish_func, {sorter_ptr});
 }
 
 // Just make a call to util::Sorter::Sort(...). This actually sorts the data
@@ -159,6 +171,21 @@ llvm::Value *Sorter::GetNumberOfStoredTuples(CodeGen &codegen,
   return codegen->CreateTruncOrBitCast(num_tuples, codegen.Int32Type());
 }
 
+// Store the attributes of the tuple, and its null bitmap, into the space
+void Sorter::StoreTuple(CodeGen &codegen, llvm::Value *space,
+                        const std::vector<codegen::Value> &tuple) const {
+  UpdateableStorage::NullBitmap null_bitmap{codegen, storage_format_, space};
+  for (uint32_t col_id = 0; col_id < tuple.size(); col_id++) {
+    if (!null_bitmap.IsNullable(col_id)) {
+      storage_format_.SetValueSkipNull(codegen, space, col_id, tuple[col_id]);
+    } else {
+      storage_format_.SetValue(codegen, space, col_id, tuple[col_id],
+                               null_bitmap);
+    }
+  }
+  null_bitmap.WriteBack(codegen);
+}
+
 // Pull out the 'start_pos_' instance member from the provided Sorter instance
 llvm::Value *Sorter::GetStartPosition(CodeGen &codegen,
                                       llvm::Value *sorter_ptr) const {
@@ -12,6 +12,9 @@
 
 #include "codegen/table.h"
 
+#include <algorithm>
+#include <map>
+
 #include "catalog/schema.h"
 #include "codegen/proxy/data_table_proxy.h"
 #include "codegen/lang/loop.h"
@@ -53,7 +56,8 @@ llvm::Value *Table::GetTileGroup(CodeGen &codegen, llvm::Value *table_ptr,
 // for (; tile_group_idx < num_tile_groups; ++tile_group_idx) {
 //   tile_group_ptr := GetTileGroup(table_ptr, tile_group_idx)
 //   consumer.TileGroupStart(tile_group_ptr);
-//   tile_group.TidScan(tile_group_ptr, column_layouts, vector_size, consumer);
+//   tile_group.TidScan(tile_group_ptr, column_layouts, known_layouts,
+//                      vector_size, consumer);
 //   consumer.TileGroupEnd(tile_group_ptr);
 // }
 //
@@ -65,6 +69,9 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
   const uint32_t num_columns =
       static_cast<uint32_t>(table_.GetSchema()->GetColumnCount());
 
+  // The layouts the scan loop is specialized for
+  auto known_layouts = GetKnownLayouts();
+
   llvm::Value *column_layouts = codegen->CreateAlloca(
       RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(codegen),
       codegen.Const32(num_columns));
@@ -73,9 +80,17 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
   llvm::Value *tile_group_idx = codegen.Const64(0);
   llvm::Value *num_tile_groups = GetTileGroupCount(codegen, table_ptr);
 
-  // Iterate over all tile groups in the table
-  lang::Loop loop{codegen,
-                  codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
+  // Iterate over all tile groups in the table, unless the consumer is finished
+  // before reaching the end
+  auto has_next = [&codegen, &consumer, num_tile_groups](llvm::Value *idx) {
+    llvm::Value *cond = codegen->CreateICmpULT(idx, num_tile_groups);
+    llvm::Value *finished = consumer.IsFinished(codegen);
+    if (finished != nullptr) {
+      cond = codegen->CreateAnd(cond, codegen->CreateNot(finished));
+    }
+    return cond;
+  };
+  lang::Loop loop{codegen, has_next(tile_group_idx),
                   {{"tileGroupIdx", tile_group_idx}}};
   {
     // Get the tile group with the given tile group ID
@@ -91,16 +106,74 @@ void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
 
     // Generate the scan cover over the given tile group
     tile_group_.GenerateTidScan(codegen, tile_group_ptr, column_layouts,
-                                batch_size, consumer);
+                                known_layouts, batch_size, consumer);
 
     // Invoke the consumer to let her know that we're done with this tile group
     consumer.TileGroupFinish(codegen, tile_group_ptr);
 
     // Move to next tile group in the table
     tile_group_idx = codegen->CreateAdd(tile_group_idx, codegen.Const64(1));
-    loop.LoopEnd(codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
-                 {tile_group_idx});
+    loop.LoopEnd(has_next(tile_group_idx), {tile_group_idx});
+  }
+}
+
+// The stride of a column is the length of the tuples of the tile that the
+// column is stored in. Tile groups whose layouts only differ in the order of
+// the columns within a tile share the same strides.
+static TileGroup::ColumnStrides GetLayoutStrides(
+    const catalog::Schema &schema, const column_map_type &layout) {
+  std::map<oid_t, uint32_t> tile_lengths;
+  for (const auto &entry : layout) {
+    tile_lengths[entry.second.first] += schema.GetLength(entry.first);
   }
+  TileGroup::ColumnStrides strides(schema.GetColumnCount(), 0);
+  for (const auto &entry : layout) {
+    strides[entry.first] = tile_lengths[entry.second.first];
+  }
+  return strides;
+}
+
+// The layouts are counted by the table as tile groups are added and
+// transformed, so compiling a scan never touches the tile groups themselves
+std::vector<TileGroup::ColumnStrides> Table::GetKnownLayouts() const {
+  const auto &schema = *table_.GetSchema();
+
+  // Count the tile groups of every layout
+  std::map<TileGroup::ColumnStrides, size_t> layout_counts;
+  for (const auto &entry : table_.GetLayoutCounts()) {
+    layout_counts[GetLayoutStrides(schema, entry.first)] += entry.second;
+  }
+
+  // The default layout of the table
+  auto default_strides = GetLayoutStrides(schema, table_.GetDefaultLayout());
+
+  // Pick the most common layouts, making room for the default one
+  std::vector<std::pair<size_t, TileGroup::ColumnStrides>> counted_layouts;
+  for (const auto &entry : layout_counts) {
+    counted_layouts.emplace_back(entry.second, entry.first);
+  }
+  std::stable_sort(counted_layouts.begin(), counted_layouts.end(),
+                   [](const std::pair<size_t, TileGroup::ColumnStrides> &a,
+                      const std::pair<size_t, TileGroup::ColumnStrides> &b) {
+                     return a.first > b.first;
+                   });
+
+  std::vector<TileGroup::ColumnStrides> known_layouts;
+  for (const auto &entry : counted_layouts) {
+    if (known_layouts.size() == kMaxKnownLayouts) {
+      break;
+    }
+    known_layouts.push_back(entry.second);
+  }
+  if (std::find(known_layouts.begin(), known_layouts.end(), default_strides) ==
+      known_layouts.end()) {
+    if (known_layouts.size() == kMaxKnownLayouts) {
+      known_layouts.pop_back();
+    }
+    known_layouts.push_back(default_strides);
+  }
+
+  return known_layouts;
 }
 
 }  // namespace codegen
@@ -0,0 +1,328 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tiered_compiler.cpp
+//
+// Identification: src/codegen/tiered_compiler.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/tiered_compiler.h"
+
+#include <algorithm>
+
+#include "codegen/buffering_consumer.h"
+#include "codegen/object_cache.h"
+#include "codegen/query_compiler.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "configuration/configuration.h"
+#include "expression/abstract_expression.h"
+#include "planner/abstract_join_plan.h"
+#include "planner/abstract_scan_plan.h"
+#include "planner/binding_context.h"
+#include "planner/delete_plan.h"
+#include "planner/index_join_plan.h"
+#include "storage/data_table.h"
+#include "storage/storage_manager.h"
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+// The number of plans whose statistics we keep. Beyond this, the statistics of
+// the plans that are still interpreted are forgotten.
+constexpr size_t kMaxTrackedPlans = 4096;
+
+// A fingerprint of the structure of the plan: the types of its operators, the
+// tables it scans and its predicates
+hash_t GetFingerprint(const planner::AbstractPlan &plan) {
+  auto plan_type = plan.GetPlanNodeType();
+  hash_t hash = HashUtil::Hash(&plan_type);
+
+  const expression::AbstractExpression *predicate = nullptr;
+  switch (plan_type) {
+    case PlanNodeType::SEQSCAN: {
+      auto &scan = static_cast<const planner::AbstractScan &>(plan);
+      oid_t table_oid = scan.GetTable()->GetOid();
+      hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&table_oid));
+      const auto &column_ids = scan.GetColumnIds();
+      hash = HashUtil::CombineHashes(
+          hash, HashUtil::HashBytes(
+                    reinterpret_cast<const char *>(column_ids.data()),
+                    column_ids.size() * sizeof(oid_t)));
+      predicate = scan.GetPredicate();
+      break;
+    }
+    case PlanNodeType::HASHJOIN:
+    case PlanNodeType::NESTLOOPINDEX: {
+      auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
+      predicate = join.GetPredicate();
+      break;
+    }
+    default:
+      break;
+  }
+  if (predicate != nullptr) {
+    hash = HashUtil::CombineHashes(hash, predicate->Hash());
+  }
+
+  for (const auto &child : plan.GetChildren()) {
+    hash = HashUtil::CombineHashes(hash, GetFingerprint(*child));
+  }
+  return hash;
+}
+
+// Collect the tables the plan accesses
+void GetTables(const planner::AbstractPlan &plan,
+               std::vector<std::pair<oid_t, oid_t>> &tables) {
+  const storage::DataTable *table = nullptr;
+  switch (plan.GetPlanNodeType()) {
+    case PlanNodeType::SEQSCAN: {
+      table = static_cast<const planner::AbstractScan &>(plan).GetTable();
+      break;
+    }
+    case PlanNodeType::NESTLOOPINDEX: {
+      table = static_cast<const planner::IndexJoinPlan &>(plan).GetTable();
+      break;
+    }
+    case PlanNodeType::DELETE: {
+      table = static_cast<const planner::DeletePlan &>(plan).GetTable();
+      break;
+    }
+    default:
+      break;
+  }
+  if (table != nullptr) {
+    tables.emplace_back(table->GetDatabaseOid(), table->GetOid());
+  }
+
+  for (const auto &child : plan.GetChildren()) {
+    GetTables(*child, tables);
+  }
+}
+
+// A deep copy of the plan, or nullptr if some operator can't be copied
+std::unique_ptr<planner::AbstractPlan> CopyPlan(
+    const planner::AbstractPlan &plan) {
+  auto copy = plan.Copy();
+  if (copy == nullptr) {
+    return nullptr;
+  }
+  for (const auto &child : plan.GetChildren()) {
+    auto child_copy = CopyPlan(*child);
+    if (child_copy == nullptr) {
+      return nullptr;
+    }
+    copy->AddChild(std::move(child_copy));
+  }
+  return copy;
+}
+
+}  // anonymous namespace
+
+TieredCompiler &TieredCompiler::GetInstance() {
+  static TieredCompiler tiered_compiler;
+  return tiered_compiler;
+}
+
+TieredCompiler::TieredCompiler() : running_(false), num_compiled_(0) {}
+
+TieredCompiler::~TieredCompiler() { Stop(); }
+
+void TieredCompiler::Start() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  compiler_thread_ = std::thread(&TieredCompiler::Run, this);
+
+  LOG_INFO("Started tiered compiler");
+}
+
+void TieredCompiler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  queue_cv_.notify_all();
+  compiler_thread_.join();
+
+  // Plans that were still queued go back to the interpreter
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (const auto &task : queue_) {
+    auto iter = plans_.find(task.fingerprint);
+    if (iter != plans_.end()) {
+      iter->second.state = PlanState::Interpreted;
+    }
+  }
+  queue_.clear();
+
+  LOG_INFO("Stopped tiered compiler");
+}
+
+bool TieredCompiler::IsEnabled() const {
+  return running_ && ObjectCache::IsEnabled();
+}
+
+bool TieredCompiler::IsCompiled(const planner::AbstractPlan &plan) {
+  hash_t fingerprint = GetFingerprint(plan);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto iter = plans_.find(fingerprint);
+  return iter != plans_.end() && iter->second.state == PlanState::Compiled;
+}
+
+void TieredCompiler::RecordInterpreted(const planner::AbstractPlan &plan,
+                                       double ms) {
+  hash_t fingerprint = GetFingerprint(plan);
+
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto iter = plans_.find(fingerprint);
+    if (iter == plans_.end()) {
+      if (plans_.size() >= kMaxTrackedPlans) {
+        for (auto cold = plans_.begin(); cold != plans_.end();) {
+          if (cold->second.state == PlanState::Interpreted) {
+            cold = plans_.erase(cold);
+          } else {
+            ++cold;
+          }
+        }
+        if (plans_.size() >= kMaxTrackedPlans) {
+          return;
+        }
+      }
+      iter = plans_.emplace(fingerprint, PlanStats()).first;
+    }
+
+    auto &stats = iter->second;
+    if (!running_ || stats.state != PlanState::Interpreted) {
+      return;
+    }
+    stats.executions++;
+    stats.interpreted_ms += ms;
+    if (stats.executions < FLAGS_codegen_tiering_executions &&
+        stats.interpreted_ms < FLAGS_codegen_tiering_ms) {
+      return;
+    }
+    stats.state = PlanState::Queued;
+  }
+
+  // The plan is hot. The caller owns the plan, so the background thread gets a
+  // copy of it.
+  auto copy = CopyPlan(plan);
+  std::vector<TableId> tables;
+  GetTables(plan, tables);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto iter = plans_.find(fingerprint);
+  if (iter == plans_.end()) {
+    return;
+  }
+  if (copy == nullptr) {
+    iter->second.state = PlanState::Failed;
+    return;
+  }
+  LOG_DEBUG("Queueing plan %lu for compilation after %lu executions (%.2lf ms)",
+            fingerprint, iter->second.executions, iter->second.interpreted_ms);
+  queue_.push_back(CompileTask{fingerprint, std::move(copy), std::move(tables)});
+  queue_cv_.notify_one();
+}
+
+void TieredCompiler::Run() {
+  for (;;) {
+    CompileTask task;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      queue_cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+      if (!running_) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      compiling_tables_ = task.tables;
+    }
+
+    // A table may have been dropped before the plan was dequeued
+    bool compiled = HasTables(task.tables) && Compile(*task.plan);
+    if (compiled) {
+      num_compiled_++;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      compiling_tables_.clear();
+      auto iter = plans_.find(task.fingerprint);
+      if (iter != plans_.end()) {
+        iter->second.state = compiled ? PlanState::Compiled : PlanState::Failed;
+      }
+    }
+    compiling_cv_.notify_all();
+  }
+}
+
+void TieredCompiler::DropTable(oid_t database_oid, oid_t table_oid) {
+  TableId table{database_oid, table_oid};
+  auto accesses_table = [&table](const std::vector<TableId> &tables) {
+    return std::find(tables.begin(), tables.end(), table) != tables.end();
+  };
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  for (auto iter = queue_.begin(); iter != queue_.end();) {
+    if (accesses_table(iter->tables)) {
+      plans_.erase(iter->fingerprint);
+      iter = queue_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  compiling_cv_.wait(lock, [this, &accesses_table] {
+    return !accesses_table(compiling_tables_);
+  });
+}
+
+bool TieredCompiler::HasTables(const std::vector<TableId> &tables) {
+  auto *storage_manager = storage::StorageManager::GetInstance();
+  for (const auto &table : tables) {
+    try {
+      storage_manager->GetTableWithOid(table.first, table.second);
+    } catch (const CatalogException &) {
+      LOG_DEBUG("Not compiling plan of dropped table %u", table.second);
+      return false;
+    }
+  }
+  return true;
+}
+
+// The plan is compiled exactly like PlanExecutor compiles it, so that the
+// object lands in the cache under the key the executed plan will look up
+bool TieredCompiler::Compile(planner::AbstractPlan &plan) {
+  try {
+    planner::BindingContext context;
+    plan.PerformBinding(context);
+
+    std::vector<oid_t> columns;
+    plan.GetOutputColumns(columns);
+    BufferingConsumer consumer{columns, context};
+
+    QueryCompiler compiler;
+    compiler.Compile(plan, consumer);
+    return true;
+  } catch (const std::exception &e) {
+    LOG_WARN("Could not compile plan in the background: %s", e.what());
+    return false;
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
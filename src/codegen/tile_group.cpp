@@ -38,20 +38,78 @@ TileGroup::TileGroup(const catalog::Schema &schema) : schema_(schema) {}
 // col_layouts := GetColumnLayouts(tile_group_ptr, column_layouts)
 // num_tuples := GetNumTuples(tile_group_ptr)
 //
-// for (start := 0; start < num_tuples; start += vector_size) {
-//   end := min(start + vector_size, num_tuples)
-//   ProcessTuples(start, end, tile_group_ptr);
+// if (col_layouts.strides == known_layouts[0]) {
+//   for (start := 0; start < num_tuples; start += vector_size) {
+//     end := min(start + vector_size, num_tuples)
+//     ProcessTuples(start, end, tile_group_ptr, known_layouts[0]);
+//   }
+// } else if (...) {
+//   ...
+// } else {
+//   for (start := 0; start < num_tuples; start += vector_size) {
+//     end := min(start + vector_size, num_tuples)
+//     ProcessTuples(start, end, tile_group_ptr, col_layouts.strides);
+//   }
 // }
 // @endcode
 //
 void TileGroup::GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
                                 llvm::Value *column_layouts,
+                                const std::vector<ColumnStrides> &known_layouts,
                                 uint32_t batch_size,
                                 ScanCallback &consumer) const {
   // Get the column layouts
   auto col_layouts = GetColumnLayouts(codegen, tile_group_ptr, column_layouts);
 
   llvm::Value *num_tuples = GetNumTuples(codegen, tile_group_ptr);
+  GenerateLayoutScan(codegen, col_layouts, num_tuples, known_layouts, 0,
+                     batch_size, consumer);
+}
+
+void TileGroup::GenerateLayoutScan(
+    CodeGen &codegen, const std::vector<ColumnLayout> &col_layouts,
+    llvm::Value *num_tuples, const std::vector<ColumnStrides> &known_layouts,
+    uint32_t layout_idx, uint32_t batch_size, ScanCallback &consumer) const {
+  // None of the known layouts matched, use the strides of the tile group
+  if (layout_idx == known_layouts.size()) {
+    GenerateTupleLoop(codegen, col_layouts, num_tuples, batch_size, consumer);
+    return;
+  }
+
+  // Check whether the tile group has the layout, and replace the strides with
+  // the constant ones of the layout
+  const auto &strides = known_layouts[layout_idx];
+  PL_ASSERT(strides.size() == col_layouts.size());
+
+  llvm::Value *has_layout = codegen.ConstBool(true);
+  std::vector<ColumnLayout> layout_col_layouts;
+  for (uint32_t col_id = 0; col_id < strides.size(); col_id++) {
+    const auto &col_layout = col_layouts[col_id];
+    llvm::Value *stride = codegen.Const32(strides[col_id]);
+    has_layout = codegen->CreateAnd(
+        has_layout, codegen->CreateICmpEQ(col_layout.col_stride, stride));
+    layout_col_layouts.push_back(ColumnLayout{col_layout.col_id,
+                                              col_layout.col_start_ptr, stride,
+                                              col_layout.is_columnar});
+  }
+
+  lang::If layout_check{codegen, has_layout, "knownLayout"};
+  {
+    GenerateTupleLoop(codegen, layout_col_layouts, num_tuples, batch_size,
+                      consumer);
+  }
+  layout_check.ElseBlock("otherLayout");
+  {
+    GenerateLayoutScan(codegen, col_layouts, num_tuples, known_layouts,
+                       layout_idx + 1, batch_size, consumer);
+  }
+  layout_check.EndIf();
+}
+
+void TileGroup::GenerateTupleLoop(CodeGen &codegen,
+                                  const std::vector<ColumnLayout> &col_layouts,
+                                  llvm::Value *num_tuples, uint32_t batch_size,
+                                  ScanCallback &consumer) const {
   lang::VectorizedLoop loop{codegen, num_tuples, batch_size, {}};
   {
     lang::VectorizedLoop::Range curr_range = loop.GetCurrentRange();
@@ -43,6 +43,11 @@ uint32_t TransactionRuntime::PerformVectorizedRead(
     out_idx += (visibility == VisibilityType::OK);
   }
 
+  // Read-only transactions can read every visible tuple
+  if (txn.GetIsolationLevel() == IsolationLevelType::READ_ONLY) {
+    return out_idx;
+  }
+
   uint32_t tile_group_idx = tile_group.GetTileGroupId();
 
   // Perform a read operation for every visible tuple we found
@@ -17,10 +17,13 @@
 #include "codegen/expression/comparison_translator.h"
 #include "codegen/expression/conjunction_translator.h"
 #include "codegen/expression/constant_translator.h"
+#include "codegen/expression/function_translator.h"
 #include "codegen/operator/delete_translator.h"
 #include "codegen/operator/global_group_by_translator.h"
 #include "codegen/operator/hash_group_by_translator.h"
 #include "codegen/operator/hash_join_translator.h"
+#include "codegen/operator/index_join_translator.h"
+#include "codegen/operator/limit_translator.h"
 #include "codegen/expression/negation_translator.h"
 #include "codegen/operator/order_by_translator.h"
 #include "codegen/operator/projection_translator.h"
@@ -36,6 +39,8 @@
 #include "planner/aggregate_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/index_join_plan.h"
+#include "planner/limit_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -67,6 +72,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new HashJoinTranslator(join, context, pipeline);
       break;
     }
+    case PlanNodeType::NESTLOOPINDEX: {
+      auto &join = static_cast<const planner::IndexJoinPlan &>(plan_node);
+      translator = new IndexJoinTranslator(join, context, pipeline);
+      break;
+    }
     case PlanNodeType::AGGREGATE_V2: {
       const auto &aggregate_plan =
           static_cast<const planner::AggregatePlan &>(plan_node);
@@ -87,6 +97,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new OrderByTranslator(order_by, context, pipeline);
       break;
     }
+    case PlanNodeType::LIMIT: {
+      auto &limit = static_cast<const planner::LimitPlan &>(plan_node);
+      translator = new LimitTranslator(limit, context, pipeline);
+      break;
+    }
     case PlanNodeType::DELETE: {
       auto &delete_plan = const_cast<planner::DeletePlan &>(
           static_cast<const planner::DeletePlan &>(plan_node));
@@ -161,6 +176,12 @@ std::unique_ptr<ExpressionTranslator> TranslatorFactory::CreateTranslator(
       translator = new CaseTranslator(case_exp, context);
       break;
     }
+    case ExpressionType::COMPARE_LIKE:
+    case ExpressionType::COMPARE_NOTLIKE:
+    case ExpressionType::FUNCTION: {
+      translator = new FunctionTranslator(exp, context);
+      break;
+    }
     default: {
       throw Exception{"We don't have a translator for expression type: " +
                       ExpressionTypeToString(exp.GetExpressionType())};
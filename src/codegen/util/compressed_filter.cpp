@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_filter.cpp
+//
+// Identification: src/codegen/util/compressed_filter.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/compressed_filter.h"
+
+#include <new>
+#include <string>
+
+#include "storage/compressed_column.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+CompressedFilter::CompressedFilter() : evaluated_(false) {}
+
+CompressedFilter::~CompressedFilter() {}
+
+void CompressedFilter::Init() { new (this) CompressedFilter(); }
+
+void CompressedFilter::AddIntegerTerm(uint32_t column_id, uint32_t comparison,
+                                      int64_t constant) {
+  auto value = peloton::type::ValueFactory::GetBigIntValue(constant);
+  terms_.push_back(
+      Term{column_id, static_cast<ExpressionType>(comparison), value});
+}
+
+void CompressedFilter::AddStringTerm(uint32_t column_id, uint32_t comparison,
+                                     const char *constant, uint32_t length) {
+  auto value = peloton::type::ValueFactory::GetVarcharValue(
+      std::string(constant, length));
+  terms_.push_back(
+      Term{column_id, static_cast<ExpressionType>(comparison), value});
+}
+
+bool CompressedFilter::LoadTileGroup(const storage::TileGroup *tile_group,
+                                     uint32_t tid_end) {
+  auto compressed_tile_group = tile_group->GetCompressedTileGroup();
+  if (compressed_tile_group == nullptr ||
+      compressed_tile_group->GetTupleCount() < tid_end) {
+    return false;
+  }
+
+  // The matches are computed once for all batches of the tile group
+  if (compressed_tile_group == compressed_tile_group_) {
+    return evaluated_;
+  }
+  compressed_tile_group_ = compressed_tile_group;
+
+  matches_.assign(compressed_tile_group->GetTupleCount(), true);
+  evaluated_ = true;
+  for (const auto &term : terms_) {
+    auto *column = compressed_tile_group->GetColumn(term.column_id);
+    if (column == nullptr ||
+        !column->EvaluatePredicate(term.comparison, term.constant, matches_)) {
+      evaluated_ = false;
+      break;
+    }
+  }
+  return evaluated_;
+}
+
+uint32_t CompressedFilter::Filter(uint32_t *selection_vector,
+                                  uint32_t num_selected) const {
+  uint32_t out_idx = 0;
+  for (uint32_t idx = 0; idx < num_selected; idx++) {
+    uint32_t tid = selection_vector[idx];
+    selection_vector[out_idx] = tid;
+    out_idx += matches_[tid];
+  }
+  return out_idx;
+}
+
+void CompressedFilter::Destroy() { this->~CompressedFilter(); }
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,197 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_probe.cpp
+//
+// Identification: src/codegen/util/index_probe.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/index_probe.h"
+
+#include <new>
+
+#include "catalog/manager.h"
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "index/index.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+IndexProbe::IndexProbe(std::shared_ptr<index::Index> index)
+    : index_(std::move(index)),
+      is_primary_(index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY),
+      num_keys_(0),
+      pool_(new peloton::type::EphemeralPool()) {
+  keys_.reserve(kDefaultBatchSize);
+  key_ids_.reserve(kDefaultBatchSize);
+}
+
+IndexProbe::~IndexProbe() {}
+
+void IndexProbe::Init(storage::DataTable *table, uint32_t index_oid) {
+  auto index = table->GetIndexWithOid(index_oid);
+  PL_ASSERT(index != nullptr);
+  new (this) IndexProbe(std::move(index));
+}
+
+void IndexProbe::AddKey(char *values) {
+  const auto *vals = reinterpret_cast<const peloton::type::Value *>(values);
+  uint32_t key_idx = num_keys_++;
+
+  // Reuse the key tuples of earlier probes
+  if (keys_.size() == key_tuples_.size()) {
+    key_tuples_.emplace_back(
+        new storage::Tuple(index_->GetKeySchema(), true));
+  }
+  storage::Tuple *key = key_tuples_[keys_.size()].get();
+
+  for (oid_t col_id = 0; col_id < index_->GetColumnCount(); col_id++) {
+    if (vals[col_id].IsNull()) {
+      return;
+    }
+    try {
+      key->SetValue(col_id, vals[col_id], pool_.get());
+    } catch (ValueOutOfRangeException &e) {
+      return;
+    }
+  }
+
+  keys_.push_back(key);
+  key_ids_.push_back(key_idx);
+}
+
+uint32_t IndexProbe::Probe(concurrency::Transaction *txn) {
+  matches_.clear();
+
+  if (!keys_.empty()) {
+    std::vector<std::vector<ItemPointer *>> key_locations;
+    index_->ScanKeyBatch(keys_, key_locations);
+    PL_ASSERT(key_locations.size() == keys_.size());
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto &manager = catalog::Manager::GetInstance();
+
+    for (uint32_t i = 0; i < keys_.size(); i++) {
+      for (auto *tuple_location_ptr : key_locations[i]) {
+        ItemPointer visible = FindVisibleVersion(*txn, *tuple_location_ptr);
+        if (visible.IsNull()) {
+          continue;
+        }
+
+        if (!is_primary_ && !CheckKey(visible, *keys_[i])) {
+          continue;
+        }
+
+        // As in a scan, tuples that can't be read are skipped
+        if (!txn_manager.PerformRead(txn, visible)) {
+          continue;
+        }
+
+        auto *tile_group = manager.GetTileGroup(visible.block).get();
+        matches_.push_back(Match{key_ids_[i], tile_group, visible.offset});
+      }
+    }
+  }
+
+  // Start the next batch
+  num_keys_ = 0;
+  keys_.clear();
+  key_ids_.clear();
+  pool_.reset(new peloton::type::EphemeralPool());
+
+  return static_cast<uint32_t>(matches_.size());
+}
+
+uint32_t IndexProbe::GetMatchKey(uint32_t match_idx) const {
+  return matches_[match_idx].key_idx;
+}
+
+storage::TileGroup *IndexProbe::GetMatchTileGroup(uint32_t match_idx) const {
+  return matches_[match_idx].tile_group;
+}
+
+uint32_t IndexProbe::GetMatchTid(uint32_t match_idx) const {
+  return matches_[match_idx].tid;
+}
+
+void IndexProbe::Destroy() { this->~IndexProbe(); }
+
+ItemPointer IndexProbe::FindVisibleVersion(concurrency::Transaction &txn,
+                                           ItemPointer tuple_location) const {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group = manager.GetTileGroup(tuple_location.block);
+  auto tile_group_header = tile_group->GetHeader();
+  size_t chain_length = 0;
+
+  while (true) {
+    ++chain_length;
+
+    auto visibility =
+        txn_manager.IsVisible(&txn, tile_group_header, tuple_location.offset);
+    if (visibility == VisibilityType::OK) {
+      return tuple_location;
+    } else if (visibility == VisibilityType::DELETED) {
+      return INVALID_ITEMPOINTER;
+    }
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     txn.GetReadId());
+    if (is_acquired && is_alive) {
+      // The version chain was modified by another transaction, start over
+      // from the head of the chain
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      chain_length = 0;
+    } else {
+      tuple_location = tile_group_header->GetNextItemPointer(
+          tuple_location.offset);
+      if (tuple_location.IsNull()) {
+        LOG_TRACE("No visible version after %lu versions", chain_length);
+        return INVALID_ITEMPOINTER;
+      }
+    }
+
+    tile_group = manager.GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+bool IndexProbe::CheckKey(const ItemPointer &tuple_location,
+                          const storage::Tuple &key) const {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tuple_location.block);
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                       tuple_location.offset);
+
+  const auto &key_attrs = index_->GetMetadata()->GetKeyAttrs();
+  for (oid_t i = 0; i < key_attrs.size(); i++) {
+    if (tuple.GetValue(key_attrs[i]).CompareEquals(key.GetValue(i)) !=
+        peloton::type::CMP_TRUE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -13,6 +13,7 @@
 #include "codegen/util/oa_hash_table.h"
 
 #include <string.h>
+#include <algorithm>
 
 #include "common/logger.h"
 #include "common/platform.h"
@@ -358,14 +359,35 @@ void OAHashTable::Resize(HashEntry **entry_p_p) {
 }
 
 //===----------------------------------------------------------------------===//
-// Clean up any resources this hash table has
-//
-// We need to first scan the array to find out all collision kv lists, delete
-// them, and then delete the entire array.
+// Remove all entries from the hash table, making room for the given number of
+// entries. The bucket array is only reallocated if its size changes.
 //===----------------------------------------------------------------------===//
-void OAHashTable::Destroy() {
-  LOG_DEBUG("Cleaning up hash table with %ld entries ...", num_entries_);
+void OAHashTable::Reset(uint64_t estimated_num_entries) {
+  // Tiny tables still get a few buckets
+  static constexpr uint64_t kMinNumBuckets = 16;
+
+  LOG_DEBUG("Resetting hash table with %ld entries ...", num_entries_);
+
+  FreeKeyValueLists();
+
+  uint64_t num_buckets =
+      NextPowerOf2(std::max(estimated_num_entries, kMinNumBuckets));
+  if (num_buckets != num_buckets_) {
+    free(buckets_);
+    num_buckets_ = num_buckets;
+    bucket_mask_ = num_buckets_ - 1;
+    resize_threshold_ = num_buckets_ >> 1;
+    buckets_ = static_cast<HashEntry *>(malloc(entry_size_ * num_buckets_));
+  }
+
+  num_entries_ = num_valid_buckets_ = 0;
+  InitializeArray(buckets_);
+}
 
+//===----------------------------------------------------------------------===//
+// Free the overflow kv lists of all occupied buckets
+//===----------------------------------------------------------------------===//
+void OAHashTable::FreeKeyValueLists() {
   uint64_t processed_count = 0;
   char *current_entry_char_p = reinterpret_cast<char *>(buckets_);
 
@@ -386,6 +408,18 @@ void OAHashTable::Destroy() {
 
     current_entry_char_p += entry_size_;
   }
+}
+
+//===----------------------------------------------------------------------===//
+// Clean up any resources this hash table has
+//
+// We need to first scan the array to find out all collision kv lists, delete
+// them, and then delete the entire array.
+//===----------------------------------------------------------------------===//
+void OAHashTable::Destroy() {
+  LOG_DEBUG("Cleaning up hash table with %ld entries ...", num_entries_);
+
+  FreeKeyValueLists();
 
   // Free main buckets array
   free(buckets_);
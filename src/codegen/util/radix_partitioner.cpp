@@ -0,0 +1,277 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// radix_partitioner.cpp
+//
+// Identification: src/codegen/util/radix_partitioner.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/util/radix_partitioner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common/logger.h"
+#include "common/platform.h"
+#include "common/timer.h"
+#include "storage/backend_manager.h"
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+namespace {
+
+// The space allocated for the tuples when the partitioner is initialized
+constexpr uint64_t kInitialBufferSize = 1 * 1024 * 1024;
+
+// The partition of the given hash value in a pass, which is given by the
+// radix_bits bits below the top shift bits
+inline uint32_t RadixOf(uint64_t hash, uint32_t shift, uint32_t radix_bits) {
+  return static_cast<uint32_t>((hash << shift) >> (64 - radix_bits));
+}
+
+inline uint64_t HashOf(const char *entry) {
+  return *reinterpret_cast<const uint64_t *>(entry);
+}
+
+}  // namespace
+
+// Partitions should hold a hash table that fits into the L2 cache
+uint64_t RadixPartitioner::kTargetPartitionSize = 256 * 1024;
+
+void RadixPartitioner::Init(uint32_t tuple_size) {
+  tuple_size_ = tuple_size;
+
+  entry_size_ = ComputeEntrySize(tuple_size);
+
+  buffer_start_ = Allocate(kInitialBufferSize);
+  buffer_pos_ = buffer_start_;
+  buffer_end_ = buffer_start_ + kInitialBufferSize;
+
+  radix_bits_ = 0;
+  partition_offsets_ = nullptr;
+}
+
+char *RadixPartitioner::StoreInputTuple(uint64_t hash) {
+  if (buffer_pos_ + entry_size_ > buffer_end_) {
+    Resize();
+  }
+  char *entry = buffer_pos_;
+  buffer_pos_ += entry_size_;
+  *reinterpret_cast<uint64_t *>(entry) = hash;
+  return entry + sizeof(uint64_t);
+}
+
+// The hash table of a partition keeps its load factor below 50%, so it has
+// twice as many buckets as entries
+uint32_t RadixPartitioner::ComputeRadixBits(uint64_t hash_entry_size) const {
+  uint64_t table_size = 2 * GetNumTuples() * hash_entry_size;
+  uint32_t radix_bits = 0;
+  while (radix_bits < kMaxRadixBits &&
+         (table_size >> radix_bits) > kTargetPartitionSize) {
+    radix_bits++;
+  }
+  return radix_bits;
+}
+
+void RadixPartitioner::Partition(uint32_t radix_bits) {
+  PL_ASSERT(radix_bits <= kMaxRadixBits);
+
+  uint64_t num_entries = GetNumTuples();
+  uint32_t num_partitions = 1u << radix_bits;
+
+  radix_bits_ = radix_bits;
+  delete[] partition_offsets_;
+  partition_offsets_ = new uint64_t[num_partitions + 1];
+  partition_offsets_[num_partitions] = num_entries;
+
+  // Nothing to move around
+  if (radix_bits == 0 || num_entries == 0) {
+    for (uint32_t p = 0; p < num_partitions; p++) {
+      partition_offsets_[p] = (p == 0 ? 0 : num_entries);
+    }
+    return;
+  }
+
+  Timer<std::ratio<1, 1000>> timer;
+  timer.Start();
+
+  uint64_t alloc_size = buffer_end_ - buffer_start_;
+  char *temp = Allocate(alloc_size);
+
+  if (radix_bits <= kMaxRadixBitsPerPass) {
+    // A single pass from the buffer into the new space
+    std::vector<uint64_t> histogram(num_partitions);
+    BuildHistogram(buffer_start_, num_entries, 0, radix_bits, histogram.data());
+    PartitionPass(buffer_start_, num_entries, temp, 0, radix_bits,
+                  histogram.data());
+
+    uint64_t offset = 0;
+    for (uint32_t p = 0; p < num_partitions; p++) {
+      partition_offsets_[p] = offset;
+      offset += histogram[p];
+    }
+
+    Release(buffer_start_);
+    buffer_start_ = temp;
+    buffer_pos_ = buffer_start_ + num_entries * entry_size_;
+    buffer_end_ = buffer_start_ + alloc_size;
+  } else {
+    // The first pass goes into the new space, and the second one partitions
+    // every partition of the first pass back into the buffer
+    uint32_t first_bits = (radix_bits + 1) / 2;
+    uint32_t second_bits = radix_bits - first_bits;
+
+    std::vector<uint64_t> first_histogram(1u << first_bits);
+    BuildHistogram(buffer_start_, num_entries, 0, first_bits,
+                   first_histogram.data());
+    PartitionPass(buffer_start_, num_entries, temp, 0, first_bits,
+                  first_histogram.data());
+
+    std::vector<uint64_t> second_histogram(1u << second_bits);
+    uint64_t offset = 0;
+    for (uint32_t first_p = 0; first_p < first_histogram.size(); first_p++) {
+      uint64_t count = first_histogram[first_p];
+      char *input = temp + offset * entry_size_;
+      char *output = buffer_start_ + offset * entry_size_;
+
+      BuildHistogram(input, count, first_bits, second_bits,
+                     second_histogram.data());
+      PartitionPass(input, count, output, first_bits, second_bits,
+                    second_histogram.data());
+
+      for (uint32_t second_p = 0; second_p < second_histogram.size();
+           second_p++) {
+        partition_offsets_[(first_p << second_bits) | second_p] = offset;
+        offset += second_histogram[second_p];
+      }
+    }
+
+    Release(temp);
+  }
+
+  timer.Stop();
+  LOG_DEBUG("Partitioned %lu tuples into %u partitions in %.2f ms",
+            num_entries, num_partitions, timer.GetDuration());
+}
+
+uint32_t RadixPartitioner::GetNumPartitions() const {
+  return 1u << radix_bits_;
+}
+
+char *RadixPartitioner::GetPartitionStart(uint32_t partition) const {
+  return buffer_start_ + partition_offsets_[partition] * entry_size_;
+}
+
+uint64_t RadixPartitioner::GetPartitionSize(uint32_t partition) const {
+  return partition_offsets_[partition + 1] - partition_offsets_[partition];
+}
+
+void RadixPartitioner::Destroy() {
+  if (buffer_start_ != nullptr) {
+    Release(buffer_start_);
+  }
+  buffer_start_ = buffer_pos_ = buffer_end_ = nullptr;
+
+  delete[] partition_offsets_;
+  partition_offsets_ = nullptr;
+}
+
+// Double the buffer space, copying over the stored entries
+void RadixPartitioner::Resize() {
+  uint64_t curr_alloc_size = buffer_end_ - buffer_start_;
+  uint64_t curr_used_size = buffer_pos_ - buffer_start_;
+  uint64_t next_alloc_size = curr_alloc_size << 1;
+
+  char *new_buffer_start = Allocate(next_alloc_size);
+  PL_MEMCPY(new_buffer_start, buffer_start_, curr_used_size);
+  Release(buffer_start_);
+
+  buffer_start_ = new_buffer_start;
+  buffer_pos_ = buffer_start_ + curr_used_size;
+  buffer_end_ = buffer_start_ + next_alloc_size;
+}
+
+void RadixPartitioner::BuildHistogram(const char *input, uint64_t num_entries,
+                                      uint32_t shift, uint32_t radix_bits,
+                                      uint64_t *histogram) const {
+  std::fill(histogram, histogram + (1u << radix_bits), 0);
+  for (uint64_t i = 0; i < num_entries; i++) {
+    histogram[RadixOf(HashOf(input + i * entry_size_), shift, radix_bits)]++;
+  }
+}
+
+// Entries are first copied into the write combining buffer of their
+// partition. A full buffer is written out at once, so the output of every
+// partition sees sequential writes of whole cache lines instead of one random
+// write per entry.
+void RadixPartitioner::PartitionPass(const char *input, uint64_t num_entries,
+                                     char *output, uint32_t shift,
+                                     uint32_t radix_bits,
+                                     const uint64_t *histogram) const {
+  uint32_t num_partitions = 1u << radix_bits;
+
+  // Every buffer holds at least one entry
+  uint32_t buffer_entries =
+      std::max(1u, static_cast<uint32_t>(CACHELINE_SIZE) / entry_size_);
+  uint64_t buffer_size = buffer_entries * entry_size_;
+
+  std::unique_ptr<char[]> buffer_space{
+      new char[num_partitions * buffer_size + CACHELINE_SIZE]};
+  char *buffers = reinterpret_cast<char *>(
+      (reinterpret_cast<uintptr_t>(buffer_space.get()) + CACHELINE_SIZE - 1) &
+      ~static_cast<uintptr_t>(CACHELINE_SIZE - 1));
+
+  // The output position of every partition, and the number of entries in its
+  // buffer
+  std::vector<uint64_t> positions(num_partitions);
+  std::vector<uint32_t> buffered(num_partitions, 0);
+  uint64_t position = 0;
+  for (uint32_t p = 0; p < num_partitions; p++) {
+    positions[p] = position;
+    position += histogram[p];
+  }
+
+  for (uint64_t i = 0; i < num_entries; i++) {
+    const char *entry = input + i * entry_size_;
+    uint32_t p = RadixOf(HashOf(entry), shift, radix_bits);
+
+    char *buffer = buffers + p * buffer_size;
+    PL_MEMCPY(buffer + buffered[p] * entry_size_, entry, entry_size_);
+    if (++buffered[p] == buffer_entries) {
+      PL_MEMCPY(output + positions[p] * entry_size_, buffer, buffer_size);
+      positions[p] += buffer_entries;
+      buffered[p] = 0;
+    }
+  }
+
+  // Flush what's left in the buffers
+  for (uint32_t p = 0; p < num_partitions; p++) {
+    if (buffered[p] > 0) {
+      PL_MEMCPY(output + positions[p] * entry_size_,
+                buffers + p * buffer_size, buffered[p] * entry_size_);
+    }
+  }
+}
+
+char *RadixPartitioner::Allocate(uint64_t size) {
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  return reinterpret_cast<char *>(
+      backend_manager.Allocate(BackendType::MM, size));
+}
+
+void RadixPartitioner::Release(char *buffer) {
+  auto &backend_manager = storage::BackendManager::GetInstance();
+  backend_manager.Release(BackendType::MM, buffer);
+}
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -12,6 +12,7 @@
 
 #include "codegen/util/sorter.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "common/logger.h"
@@ -29,7 +30,8 @@ Sorter::Sorter()
       buffer_pos_(nullptr),
       buffer_end_(nullptr),
       tuple_size_(std::numeric_limits<uint32_t>::max()),
-      cmp_func_(nullptr) {}
+      cmp_func_(nullptr),
+      top_k_(0) {}
 
 // Destruction calls the destroy method to clean up the resources.
 Sorter::~Sorter() { Destroy(); }
@@ -53,6 +55,15 @@ void Sorter::Init(ComparisonFunction func, uint32_t tuple_size) {
            kInitialBufferSize / 1024, tuple_size_);
 }
 
+// A top-K sorter only ever holds K tuples plus the one being added, so the
+// buffer is never resized once the heap is full
+void Sorter::InitTopK(ComparisonFunction func, uint32_t tuple_size,
+                      uint64_t top_k) {
+  Init(func, tuple_size);
+  top_k_ = top_k;
+  LOG_DEBUG("Sorter retains the top %lu tuples", top_k_);
+}
+
 // StoreValue a tuple of the given size in this sorter. We return a buffer that
 // has room to store tuple_size bytes.  We should also resize the existing
 // buffer space if we don't have sufficient room for the incoming tuple.
@@ -65,7 +76,28 @@ char *Sorter::StoreInputTuple() {
   return ret;
 }
 
-// Sort the buffer
+// The incoming tuple is written into the free slot right after the heap
+char *Sorter::StoreInputTupleTopK() {
+  if (!EnoughSpace(tuple_size_)) {
+    Resize();
+  }
+  return buffer_pos_;
+}
+
+// Add the tuple in the slot after the heap to the heap. While the heap isn't
+// full, the tuple is simply pushed. Otherwise, it replaces the largest tuple in
+// the heap if it's smaller than that, and is dropped if it isn't.
+void Sorter::FinishStoreTopK() {
+  uint64_t num_tuples = GetNumTuples();
+  if (num_tuples < top_k_) {
+    buffer_pos_ += tuple_size_;
+    HeapSiftUp(num_tuples);
+  } else if (num_tuples > 0 && HeapLess(num_tuples, 0)) {
+    PL_MEMCPY(GetHeapTuple(0), GetHeapTuple(num_tuples), tuple_size_);
+    HeapSiftDown(0);
+  }
+}
+
 void Sorter::Sort() {
   // Nothing to sort if nothing has been stored
   if (GetUsedSpace() <= 0) {
@@ -134,6 +166,45 @@ void Sorter::Resize() {
   backend_manager.Release(BackendType::MM, old_buffer_start);
 }
 
+//===----------------------------------------------------------------------===//
+// Top-K heap
+//===----------------------------------------------------------------------===//
+
+void Sorter::HeapSwap(uint64_t l, uint64_t r) {
+  char *left = GetHeapTuple(l);
+  std::swap_ranges(left, left + tuple_size_, GetHeapTuple(r));
+}
+
+void Sorter::HeapSiftUp(uint64_t idx) {
+  while (idx > 0) {
+    uint64_t parent = (idx - 1) / 2;
+    if (!HeapLess(parent, idx)) {
+      break;
+    }
+    HeapSwap(parent, idx);
+    idx = parent;
+  }
+}
+
+void Sorter::HeapSiftDown(uint64_t idx) {
+  uint64_t num_tuples = GetNumTuples();
+  while (true) {
+    uint64_t largest = idx;
+    uint64_t left = 2 * idx + 1, right = 2 * idx + 2;
+    if (left < num_tuples && HeapLess(largest, left)) {
+      largest = left;
+    }
+    if (right < num_tuples && HeapLess(largest, right)) {
+      largest = right;
+    }
+    if (largest == idx) {
+      break;
+    }
+    HeapSwap(idx, largest);
+    idx = largest;
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Iterators
 //===----------------------------------------------------------------------===//
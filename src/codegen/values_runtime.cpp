@@ -60,13 +60,21 @@ void ValuesRuntime::OutputDecimal(char *values, uint32_t idx, double val) {
 }
 
 void ValuesRuntime::OutputVarchar(char *values, uint32_t idx, char *str,
-                                  UNUSED_ATTRIBUTE uint32_t len) {
+                                  uint32_t len) {
   type::Value *vals = reinterpret_cast<type::Value *>(values);
+  if (str == nullptr) {
+    vals[idx] = type::ValueFactory::GetVarcharValue(nullptr, false);
+    return;
+  }
   // There are two types of VARCHAR: one is from storage and the other is from
-  // the query, e.g. CASE. In the latter case, the variable 'len' does not
-  // include a null terminator at the end of the array, while it does in the
-  // former. This function is used for both of them, so computes based on 'str'.
-  vals[idx] = type::ValueFactory::GetVarcharValue(str, false);
+  // the query, e.g. CASE or SUBSTR. In the latter case, the variable 'len'
+  // does not include a null terminator at the end of the array, while it does
+  // in the former. The string may also point into the middle of another one,
+  // so we copy exactly 'len' characters, minus the terminator if there is one.
+  if (len > 0 && str[len - 1] == '\0') {
+    len--;
+  }
+  vals[idx] = type::ValueFactory::GetVarcharValue(std::string(str, len));
 }
 
 void ValuesRuntime::OutputVarbinary(char *values, uint32_t idx, char *ptr,
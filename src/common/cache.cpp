@@ -143,4 +143,5 @@ template class Cache<std::string,
                      const planner::AbstractPlan>; /* Actual in use */
 
 template class Cache<std::string, Statement >;
+template class Cache<std::string, std::string>; /* Compiled query objects */
 }
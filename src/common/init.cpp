@@ -12,15 +12,18 @@
 #include "catalog/catalog.h"
 
 #include "common/init.h"
+#include "common/numa.h"
 #include "common/thread_pool.h"
 
 #include "configuration/configuration.h"
 
 #include "brain/index_tuner.h"
 #include "brain/layout_tuner.h"
+#include "codegen/tiered_compiler.h"
 #include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 #include "storage/data_table.h"
+#include "storage/tile_group_freezer.h"
 
 #include <google/protobuf/stubs/common.h>
 
@@ -32,6 +35,7 @@ ThreadPool thread_pool;
 
 void PelotonInit::Initialize() {
   CONNECTION_THREAD_COUNT = std::thread::hardware_concurrency();
+  EXECUTION_THREAD_COUNT = std::thread::hardware_concurrency();
   LOGGING_THREAD_COUNT = 1;
   GC_THREAD_COUNT = 1;
   EPOCH_THREAD_COUNT = 1;
@@ -40,10 +44,21 @@ void PelotonInit::Initialize() {
   // set max thread number.
   thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
 
+  // every core may insert into its own active tile group. the tables start
+  // with one and only open more once inserters contend for it.
+  storage::DataTable::SetActiveTileGroupCount(
+      std::thread::hardware_concurrency());
+
   int parallelism = (std::thread::hardware_concurrency() + 3) / 4;
-  storage::DataTable::SetActiveTileGroupCount(parallelism);
   storage::DataTable::SetActiveIndirectionArrayCount(parallelism);
 
+  // place tile groups and pin threads by NUMA node
+  if (FLAGS_numa_aware == true) {
+    storage::DataTable::SetNumaAwarePlacement(true);
+    NumaTopology::GetInstance().SetThreadPinning(true);
+    LOG_INFO("%s", NumaTopology::GetInstance().GetInfo().c_str());
+  }
+
   // start epoch.
   concurrency::EpochManagerFactory::GetInstance().StartEpoch();
 
@@ -64,6 +79,16 @@ void PelotonInit::Initialize() {
     layout_tuner.Start();
   }
 
+  // start tile group freezer
+  if (FLAGS_tile_group_freezer == true) {
+    storage::TileGroupFreezer::GetInstance().Start();
+  }
+
+  // start tiered compiler
+  if (FLAGS_codegen_tiering == true) {
+    codegen::TieredCompiler::GetInstance().Start();
+  }
+
   // Initialize catalog
   auto pg_catalog = catalog::Catalog::GetInstance();
   pg_catalog->Bootstrap();  // Additional catalogs
@@ -92,6 +117,16 @@ void PelotonInit::Shutdown() {
     layout_tuner.Stop();
   }
 
+  // shut down tile group freezer
+  if (FLAGS_tile_group_freezer == true) {
+    storage::TileGroupFreezer::GetInstance().Stop();
+  }
+
+  // shut down tiered compiler
+  if (FLAGS_codegen_tiering == true) {
+    codegen::TieredCompiler::GetInstance().Stop();
+  }
+
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
 
@@ -0,0 +1,197 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa.cpp
+//
+// Identification: src/common/numa.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "common/logger.h"
+
+// Memory policy of mbind(2), without depending on libnuma
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+#define NUMA_SYSFS_DIR "/sys/devices/system/node/"
+
+namespace peloton {
+
+thread_local int NumaTopology::pinned_node_ = NUMA_NODE_ANY;
+
+NumaTopology &NumaTopology::GetInstance() {
+  static NumaTopology numa_topology;
+  return numa_topology;
+}
+
+NumaTopology::NumaTopology() { Detect(); }
+
+std::vector<size_t> NumaTopology::ParseCpuList(const std::string &cpu_list) {
+  std::vector<size_t> cpus;
+  std::stringstream stream(cpu_list);
+  std::string range;
+
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range[0] == '\n') continue;
+
+    auto dash = range.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(std::stoul(range));
+    } else {
+      size_t begin = std::stoul(range.substr(0, dash));
+      size_t end = std::stoul(range.substr(dash + 1));
+      for (size_t cpu = begin; cpu <= end; cpu++) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+
+  return cpus;
+}
+
+void NumaTopology::Detect() {
+  size_t cpu_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+  node_cpus_.clear();
+  cpu_nodes_.assign(cpu_count, 0);
+  is_emulated_ = false;
+
+  for (int node = 0; node < MAX_NUMA_NODES; node++) {
+    std::ifstream cpu_list_file(NUMA_SYSFS_DIR "node" + std::to_string(node) +
+                                "/cpulist");
+    if (cpu_list_file.good() == false) break;
+
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    node_cpus_.push_back(ParseCpuList(cpu_list));
+
+    for (auto cpu : node_cpus_.back()) {
+      if (cpu >= cpu_nodes_.size()) cpu_nodes_.resize(cpu + 1, 0);
+      cpu_nodes_[cpu] = node;
+    }
+  }
+
+  // No NUMA information: a single node with all the CPUs
+  if (node_cpus_.empty()) {
+    node_cpus_.resize(1);
+    for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+      node_cpus_[0].push_back(cpu);
+    }
+  }
+
+  LOG_TRACE("%s", GetInfo().c_str());
+}
+
+void NumaTopology::Emulate(const size_t node_count) {
+  PL_ASSERT(node_count > 0 && node_count <= MAX_NUMA_NODES);
+  size_t cpu_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+  node_cpus_.assign(node_count, std::vector<size_t>());
+  cpu_nodes_.assign(cpu_count, 0);
+  is_emulated_ = true;
+
+  // Contiguous ranges of CPUs, like sockets usually are
+  for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+    int node = static_cast<int>(cpu * node_count / cpu_count);
+    node_cpus_[node].push_back(cpu);
+    cpu_nodes_[cpu] = node;
+  }
+
+  LOG_TRACE("%s", GetInfo().c_str());
+}
+
+int NumaTopology::GetCpuNode(const size_t cpu) const {
+  if (cpu >= cpu_nodes_.size()) return 0;
+  return cpu_nodes_[cpu];
+}
+
+int NumaTopology::GetCurrentNode() const {
+  if (pinned_node_ != NUMA_NODE_ANY &&
+      pinned_node_ < static_cast<int>(GetNodeCount())) {
+    return pinned_node_;
+  }
+
+  int cpu = sched_getcpu();
+  if (cpu < 0) return 0;
+  return GetCpuNode(cpu);
+}
+
+bool NumaTopology::PinThreadToNode(const int node) {
+  PL_ASSERT(node >= 0 && node < static_cast<int>(GetNodeCount()));
+  pinned_node_ = node;
+
+  // Emulated nodes may have no CPU of their own
+  auto &cpus = node_cpus_[node];
+  if (cpus.empty()) return false;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) !=
+      0) {
+    LOG_ERROR("Failed to pin thread to NUMA node %d", node);
+    return false;
+  }
+  return true;
+}
+
+void NumaTopology::PinThread(const size_t thread_id) {
+  if (thread_pinning_ == false) return;
+
+  PinThreadToNode(static_cast<int>(thread_id % GetNodeCount()));
+}
+
+bool NumaTopology::BindMemory(void *address, const size_t size,
+                              const int node) const {
+  if (is_emulated_ || GetNodeCount() <= 1 || node == NUMA_NODE_ANY) {
+    return true;
+  }
+
+  const size_t bits_per_word = 8 * sizeof(unsigned long);
+  unsigned long node_mask[MAX_NUMA_NODES / bits_per_word + 1] = {0};
+  node_mask[node / bits_per_word] |= (1UL << (node % bits_per_word));
+
+  // Prefer the node, rather than failing allocations when it is full
+  if (syscall(SYS_mbind, address, size, MPOL_PREFERRED, node_mask,
+              MAX_NUMA_NODES + 1, 0) != 0) {
+    LOG_ERROR("Failed to bind memory to NUMA node %d", node);
+    return false;
+  }
+  return true;
+}
+
+const std::string NumaTopology::GetInfo() const {
+  std::ostringstream os;
+
+  os << "NUMA topology : " << GetNodeCount() << " nodes"
+     << (is_emulated_ ? " (emulated)" : "") << "\n";
+  for (size_t node = 0; node < GetNodeCount(); node++) {
+    os << "Node " << node << " :";
+    for (auto cpu : node_cpus_[node]) {
+      os << " " << cpu;
+    }
+    os << "\n";
+  }
+
+  return os.str();
+}
+
+}  // End peloton namespace
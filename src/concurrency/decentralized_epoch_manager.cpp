@@ -58,6 +58,35 @@ namespace concurrency {
   }
 
 
+  cid_t DecentralizedEpochManager::EnterReadOnlyEpoch(const size_t thread_id) {
+
+    PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+
+    auto &local_epoch = local_epochs_.at(thread_id);
+
+    while (true) {
+      eid_t epoch_id = snapshot_global_epoch_id_.load();
+
+      local_epoch->EnterReadOnlyEpoch(epoch_id);
+
+      // the snapshot epoch only advances past epochs that have expired.
+      // if it has not moved, the epoch was registered before it could expire.
+      if (snapshot_global_epoch_id_.load() == epoch_id) {
+        return (epoch_id << 32) | 0x0;
+      }
+
+      local_epoch->ExitReadOnlyEpoch(epoch_id);
+    }
+  }
+
+  void DecentralizedEpochManager::ExitReadOnlyEpoch(const size_t thread_id,
+                                                    const eid_t epoch_id) {
+
+    PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+
+    local_epochs_.at(thread_id)->ExitReadOnlyEpoch(epoch_id);
+  }
+
   eid_t DecentralizedEpochManager::GetExpiredEpochId() {
     eid_t global_expired_eid = MAX_EID;
     
@@ -83,6 +83,72 @@ namespace concurrency {
     epoch_lock_.Unlock();
   }
 
+  static const uint64_t READ_ONLY_COUNT_MASK = 0xFFFFFFFF;
+  static const uint64_t READ_ONLY_MOVING = 1ULL << 32;
+  static const uint64_t READ_ONLY_GENERATION = 1ULL << 33;
+
+  // read the epoch of a slot that holds read-only transactions.
+  // returns false if the slot has changed since its state was read.
+  static bool ReadSlotEpoch(const ReadOnlySlot &slot, const uint64_t state,
+                            eid_t &epoch_id) {
+    epoch_id = slot.epoch_id_.load();
+    return slot.state_.load() == state;
+  }
+
+  void LocalEpoch::EnterReadOnlyEpoch(const eid_t epoch_id) {
+    while (true) {
+      for (size_t probe = 0; probe < READ_ONLY_SLOT_COUNT; probe++) {
+        auto &slot = read_only_slots_[(epoch_id + probe) % READ_ONLY_SLOT_COUNT];
+        uint64_t state = slot.state_.load();
+        if ((state & READ_ONLY_MOVING) != 0) {
+          continue;
+        }
+
+        if ((state & READ_ONLY_COUNT_MASK) == 0) {
+          // move the empty slot to the epoch.
+          uint64_t moving = state + READ_ONLY_GENERATION + READ_ONLY_MOVING;
+          if (slot.state_.compare_exchange_strong(state, moving) == true) {
+            slot.epoch_id_ = epoch_id;
+            slot.state_ = moving - READ_ONLY_MOVING + 1;
+            return;
+          }
+          continue;
+        }
+
+        eid_t slot_epoch_id;
+        if (ReadSlotEpoch(slot, state, slot_epoch_id) == true &&
+            slot_epoch_id == epoch_id &&
+            slot.state_.compare_exchange_strong(state, state + 1) == true) {
+          return;
+        }
+      }
+
+      // every slot holds the read-only transactions of another epoch.
+      std::this_thread::yield();
+    }
+  }
+
+  void LocalEpoch::ExitReadOnlyEpoch(const eid_t epoch_id) {
+    while (true) {
+      for (size_t probe = 0; probe < READ_ONLY_SLOT_COUNT; probe++) {
+        auto &slot = read_only_slots_[(epoch_id + probe) % READ_ONLY_SLOT_COUNT];
+        uint64_t state = slot.state_.load();
+        if ((state & READ_ONLY_MOVING) != 0 ||
+            (state & READ_ONLY_COUNT_MASK) == 0) {
+          continue;
+        }
+
+        // any slot of the epoch will do, they all count its transactions.
+        eid_t slot_epoch_id;
+        if (ReadSlotEpoch(slot, state, slot_epoch_id) == true &&
+            slot_epoch_id == epoch_id &&
+            slot.state_.compare_exchange_strong(state, state - 1) == true) {
+          return;
+        }
+      }
+    }
+  }
+
   uint64_t LocalEpoch::GetExpiredEpochId(const uint64_t epoch_id) {
     epoch_lock_.Lock();
     // there's no epoch in this thread.
@@ -107,6 +173,24 @@ namespace concurrency {
     uint64_t ret = epoch_id_lower_bound_;
     
     epoch_lock_.Unlock();
+
+    // running read-only transactions hold the lower bound back as well.
+    // a slot that is being moved belongs to a transaction that has yet to
+    // check that its epoch is still the snapshot epoch.
+    for (auto &slot : read_only_slots_) {
+      uint64_t state;
+      eid_t slot_epoch_id = 0;
+      do {
+        state = slot.state_.load();
+      } while ((state & READ_ONLY_MOVING) == 0 &&
+               (state & READ_ONLY_COUNT_MASK) != 0 &&
+               ReadSlotEpoch(slot, state, slot_epoch_id) == false);
+
+      if ((state & READ_ONLY_MOVING) == 0 &&
+          (state & READ_ONLY_COUNT_MASK) != 0 && slot_epoch_id - 1 < ret) {
+        ret = slot_epoch_id - 1;
+      }
+    }
     return ret;
   }
 
@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance(
+      const ProtocolType protocol,
+      const IsolationLevelType isolation,
+      const ConflictAvoidanceType conflict) {
+
+  static OptimisticTransactionManager txn_manager;
+
+  txn_manager.Init(protocol, isolation, conflict);
+
+  return txn_manager;
+}
+
+// no reader can prevent a transaction from owning the version.
+// conflicts with readers are detected when the readers commit.
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (tile_group_header->SetAtomicTransactionId(
+          tuple_id, current_txn->GetTransactionId()) == false) {
+    return false;
+  }
+  // another transaction may have committed an update of the version since it
+  // was checked to be ownable. updating it would cut that version out of the
+  // chain, and the read set no longer covers it once it is updated.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    YieldOwnership(current_txn, tile_group_header, tuple_id);
+    return false;
+  }
+  // a tuple slot kept up to date by delta records stays the latest version,
+  // so an update committed after the transaction began shows up as a delta
+  // record instead. overwriting the slot would lose that update.
+  if (HasNewerDelta(current_txn, tile_group_header, tuple_id) == true) {
+    YieldOwnership(current_txn, tile_group_header, tuple_id);
+    return false;
+  }
+  return true;
+}
+
+// reads do not write to the version. as in timestamp ordering, a version that
+// is owned by another transaction cannot be read.
+bool OptimisticTransactionManager::MarkRead(
+    UNUSED_ATTRIBUTE Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id,
+    const bool is_owner) {
+  return is_owner == true ||
+         tile_group_header->GetTransactionId(tuple_id) == INITIAL_TXN_ID;
+}
+
+bool OptimisticTransactionManager::ValidateReadSet(
+    Transaction *const current_txn) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto txn_id = current_txn->GetTransactionId();
+
+  for (auto &tile_group_entry : current_txn->GetReadWriteSet()) {
+    auto tile_group_header =
+        manager.GetTileGroup(tile_group_entry.first)->GetHeader();
+
+    for (auto &tuple_entry : tile_group_entry.second) {
+      if (tuple_entry.second != RWType::READ) {
+        continue;
+      }
+      auto tuple_slot = tuple_entry.first;
+
+      // the owner is checked first: a writer sets the end commit id of the
+      // version before it releases the ownership.
+      auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+      if (tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != txn_id) {
+        return false;
+      }
+
+      COMPILER_MEMORY_FENCE;
+
+      if (tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+        return false;
+      }
+
+      // updates of a delta versioned tuple leave the end commit id alone.
+      if (HasNewerDelta(current_txn, tile_group_header, tuple_slot) == true) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+ResultType OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::READ_ONLY) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  // the transaction is serialized at the time it commits, with its writes
+  // already locked.
+  cid_t commit_id = EpochManagerFactory::GetInstance().EnterEpoch(
+      current_txn->GetThreadId(), TimestampType::COMMIT);
+  current_txn->SetCommitId(commit_id);
+
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::SERIALIZABLE ||
+      current_txn->GetIsolationLevel() ==
+          IsolationLevelType::REPEATABLE_READS) {
+    if (ValidateReadSet(current_txn) == false) {
+      LOG_TRACE("Validation failed for peloton txn : %lu ",
+                current_txn->GetTransactionId());
+      return AbortTransaction(current_txn);
+    }
+  }
+
+  return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+}
+
+}  // End storage namespace
+}  // End peloton namespace
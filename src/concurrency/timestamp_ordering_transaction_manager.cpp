@@ -17,8 +17,10 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "concurrency/transaction.h"
+#include "concurrency/tuple_lock_manager.h"
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager_factory.h"
+#include "storage/delta_record.h"
 
 namespace peloton {
 namespace concurrency {
@@ -73,6 +75,103 @@ bool TimestampOrderingTransactionManager::SetLastReaderCommitId(
   }
 }
 
+bool TimestampOrderingTransactionManager::MarkRead(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id,
+    const bool is_owner) {
+  while (SetLastReaderCommitId(tile_group_header, tuple_id,
+                               current_txn->GetCommitId(), is_owner) == false) {
+    if (WaitForOwner(current_txn, tile_group_header, tuple_id) == false) {
+      return false;
+    }
+    // the owner has committed a newer version that the transaction
+    // should have read instead.
+    if (tile_group_header->GetEndCommitId(tuple_id) <=
+        current_txn->GetReadId()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// wait-die: a transaction only waits for younger transactions, so that no
+// cycle of waiting transactions can form. a younger transaction aborts.
+bool TimestampOrderingTransactionManager::WaitForOwner(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (conflict_avoidance_ != ConflictAvoidanceType::WAIT) {
+    return false;
+  }
+
+  txn_id_t owner_id = tile_group_header->GetTransactionId(tuple_id);
+  if (owner_id == INITIAL_TXN_ID) {
+    // the version has already been released.
+    return true;
+  }
+  if (owner_id == INVALID_TXN_ID ||
+      current_txn->GetTransactionId() >= owner_id) {
+    return false;
+  }
+
+  return TupleLockManager::GetInstance().WaitForRelease(tile_group_header,
+                                                        tuple_id, owner_id);
+}
+
+void TimestampOrderingTransactionManager::NotifyOwnerReleased(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  if (conflict_avoidance_ == ConflictAvoidanceType::WAIT) {
+    TupleLockManager::GetInstance().NotifyRelease(tile_group_header, tuple_id);
+  }
+}
+
+bool TimestampOrderingTransactionManager::HasNewerDelta(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  for (auto delta_record = tile_group_header->GetDeltaRecord(tuple_id);
+       delta_record != nullptr; delta_record = delta_record->next) {
+    // skip the aborted records and the ones of the current transaction.
+    if (delta_record->begin_cid == INVALID_CID ||
+        delta_record->begin_cid == MAX_CID) {
+      continue;
+    }
+    return delta_record->begin_cid > current_txn->GetReadId();
+  }
+  return false;
+}
+
+void TimestampOrderingTransactionManager::CommitDeltaRecords(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const cid_t &end_commit_id) {
+  // the records of the owner are the newest ones.
+  for (auto delta_record = tile_group_header->GetDeltaRecord(tuple_id);
+       delta_record != nullptr && delta_record->begin_cid == MAX_CID;
+       delta_record = delta_record->next) {
+    delta_record->commit_epoch_id = end_commit_id >> 32;
+
+    // the GC must not see the commit id without the epoch.
+    COMPILER_MEMORY_FENCE;
+
+    delta_record->begin_cid = end_commit_id;
+  }
+}
+
+bool TimestampOrderingTransactionManager::AbortDeltaRecords(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  bool is_aborted = false;
+  for (auto delta_record = tile_group_header->GetDeltaRecord(tuple_id);
+       delta_record != nullptr && delta_record->begin_cid == MAX_CID;
+       delta_record = delta_record->next) {
+    delta_record->begin_cid = INVALID_CID;
+    is_aborted = true;
+  }
+  return is_aborted;
+}
+
 // Initiate reserved area of a tuple
 void TimestampOrderingTransactionManager::InitTupleReserved(
     const storage::TileGroupHeader *const tile_group_header,
@@ -83,6 +182,13 @@ void TimestampOrderingTransactionManager::InitTupleReserved(
   *(cid_t *)(reserved_area + LAST_READER_OFFSET) = 0;
 }
 
+void TimestampOrderingTransactionManager::ThawClaimedTileGroup(
+    storage::TileGroup *tile_group) {
+  // pairs with the fence in TileGroupFreezer::FreezeTable
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  tile_group->Thaw();
+}
+
 TimestampOrderingTransactionManager &
 TimestampOrderingTransactionManager::GetInstance(
       const ProtocolType protocol,
@@ -144,14 +250,23 @@ bool TimestampOrderingTransactionManager::IsWritten(
 
 // if the tuple is not owned by any transaction and is visible to current
 // transaction.
+// in WAIT mode, a tuple owned by a younger transaction is ownable as well,
+// as the current transaction can wait for its owner.
 bool TimestampOrderingTransactionManager::IsOwnable(
-    UNUSED_ATTRIBUTE Transaction *const current_txn,
+    Transaction *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID &&
-         tuple_end_cid == MAX_CID;
+  if (tuple_end_cid != MAX_CID) {
+    return false;
+  }
+  if (tuple_txn_id == INITIAL_TXN_ID) {
+    return true;
+  }
+  return conflict_avoidance_ == ConflictAvoidanceType::WAIT &&
+         tuple_txn_id != INVALID_TXN_ID &&
+         tuple_txn_id > current_txn->GetTransactionId();
 }
 
 bool TimestampOrderingTransactionManager::AcquireOwnership(
@@ -179,10 +294,30 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
     if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
       GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
-      return false;
+      // the tuple is owned by another transaction. in WAIT mode, retry once
+      // the owner has released it.
+      if (WaitForOwner(current_txn, tile_group_header, tuple_id) == false) {
+        return false;
+      }
+      if (AcquireOwnership(current_txn, tile_group_header, tuple_id) == false) {
+        return false;
+      }
+      // if the owner has committed, the version is no longer the latest one.
+      if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID ||
+          HasNewerDelta(current_txn, tile_group_header, tuple_id) == true) {
+        YieldOwnership(current_txn, tile_group_header, tuple_id);
+        return false;
+      }
+      return true;
     } else {
       GetSpinlockField(tile_group_header, tuple_id)->Unlock();
 
+      // a tuple slot kept up to date by delta records stays the latest
+      // version, so a newer update shows up as a delta record instead.
+      if (HasNewerDelta(current_txn, tile_group_header, tuple_id) == true) {
+        YieldOwnership(current_txn, tile_group_header, tuple_id);
+        return false;
+      }
       return true;
     }
   }
@@ -200,6 +335,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
     const oid_t &tuple_id) {
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+  NotifyOwnerReleased(tile_group_header, tuple_id);
 }
 
 bool TimestampOrderingTransactionManager::PerformRead(
@@ -263,8 +399,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
       
       // Increment table read op stats
       if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        auto tile_group = tile_group_header->GetTileGroup();
         stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-            location.block);
+            tile_group->GetDatabaseId(), tile_group->GetTableId());
       }
 
       return true;
@@ -276,8 +413,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
       // Increment table read op stats
       if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        auto tile_group = tile_group_header->GetTileGroup();
         stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-            location.block);
+            tile_group->GetDatabaseId(), tile_group->GetTableId());
       }
       return true;
     }
@@ -318,8 +456,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
       PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id) == true);
       // Increment table read op stats
       if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        auto tile_group = tile_group_header->GetTileGroup();
         stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-            location.block);
+            tile_group->GetDatabaseId(), tile_group->GetTableId());
       }
       return true;
 
@@ -334,8 +473,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
           // Increment table read op stats
           if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+            auto tile_group = tile_group_header->GetTileGroup();
             stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-                location.block);
+                tile_group->GetDatabaseId(), tile_group->GetTableId());
           }
           return true;
 
@@ -355,8 +495,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
         // Increment table read op stats
         if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+          auto tile_group = tile_group_header->GetTileGroup();
           stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-              location.block);
+              tile_group->GetDatabaseId(), tile_group->GetTableId());
         }
         return true;
 
@@ -401,8 +542,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
         // now we have already obtained the ownership.
         // then attempt to set last reader cid.
         UNUSED_ATTRIBUTE bool ret = 
-            SetLastReaderCommitId(tile_group_header, tuple_id,
-                                  current_txn->GetCommitId(), true);
+            MarkRead(current_txn, tile_group_header, tuple_id, true);
 
         PL_ASSERT(ret == true);
         // there's no need to maintain read set for timestamp ordering protocol.
@@ -417,8 +557,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
                 GetLastReaderCommitId(tile_group_header, tuple_id) == 0);
       // Increment table read op stats
       if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        auto tile_group = tile_group_header->GetTileGroup();
         stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-            location.block);
+            tile_group->GetDatabaseId(), tile_group->GetTableId());
       }
       return true;
 
@@ -428,16 +569,16 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
         // if the current transaction does not own this tuple, 
         // then attempt to set last reader cid.
-        if (SetLastReaderCommitId(tile_group_header, tuple_id,
-                                  current_txn->GetCommitId(), false) == true) {
+        if (MarkRead(current_txn, tile_group_header, tuple_id, false) == true) {
           
           // update read set.
           current_txn->RecordRead(location);
 
           // Increment table read op stats
           if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+            auto tile_group = tile_group_header->GetTileGroup();
             stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-                location.block);
+                tile_group->GetDatabaseId(), tile_group->GetTableId());
           }
           return true;
         } else {
@@ -461,8 +602,9 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
         // Increment table read op stats
         if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+          auto tile_group = tile_group_header->GetTileGroup();
           stats::BackendStatsContext::GetInstance()->IncrementTableReads(
-              location.block);
+              tile_group->GetDatabaseId(), tile_group->GetTableId());
         }
         return true;
       }
@@ -480,7 +622,8 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  auto tile_group_header = tile_group->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -491,6 +634,8 @@ void TimestampOrderingTransactionManager::PerformInsert(
 
   tile_group_header->SetTransactionId(tuple_id, transaction_id);
 
+  ThawClaimedTileGroup(tile_group.get());
+
   // no need to set next item pointer.
 
   // Add the new tuple into the insert set
@@ -504,7 +649,65 @@ void TimestampOrderingTransactionManager::PerformInsert(
   // Increment table insert op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementTableInserts(
-        location.block);
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
+  }
+}
+
+// the slots of a batch are reserved in contiguous ranges, so consecutive
+// locations mostly share their tile group.
+void TimestampOrderingTransactionManager::PerformInserts(
+    Transaction *const current_txn, const std::vector<ItemPointer> &locations,
+    const std::vector<ItemPointer *> &index_entry_ptrs) {
+  PL_ASSERT(current_txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY);
+  PL_ASSERT(index_entry_ptrs.empty() ||
+            index_entry_ptrs.size() == locations.size());
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto transaction_id = current_txn->GetTransactionId();
+
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroup *tile_group = nullptr;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+
+  for (size_t i = 0; i < locations.size(); ++i) {
+    auto &location = locations[i];
+    oid_t tuple_id = location.offset;
+
+    if (location.block != tile_group_id) {
+      if (tile_group != nullptr) {
+        ThawClaimedTileGroup(tile_group);
+      }
+      tile_group_id = location.block;
+      tile_group = manager.GetTileGroup(tile_group_id).get();
+      tile_group_header = tile_group->GetHeader();
+    }
+
+    // check MVCC info
+    // the tuple slot must be empty.
+    PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID);
+    PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
+    PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
+
+    tile_group_header->SetTransactionId(tuple_id, transaction_id);
+
+    // Add the new tuple into the insert set
+    current_txn->RecordInsert(location);
+
+    InitTupleReserved(tile_group_header, tuple_id);
+
+    // Write down the head pointer's address in tile group header
+    tile_group_header->SetIndirection(
+        tuple_id, index_entry_ptrs.empty() ? nullptr : index_entry_ptrs[i]);
+
+    // Increment table insert op stats
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementTableInserts(
+          tile_group->GetDatabaseId(), tile_group->GetTableId());
+    }
+  }
+
+  if (tile_group != nullptr) {
+    ThawClaimedTileGroup(tile_group);
   }
 }
 
@@ -522,11 +725,14 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group_header = manager.GetTileGroup(old_location.block)
-                                  ->GetHeader();
+  auto tile_group = manager.GetTileGroup(old_location.block);
+  auto tile_group_header = tile_group->GetHeader();
   auto new_tile_group_header = manager.GetTileGroup(new_location.block)
                                       ->GetHeader();
 
+  // the tile group is no longer cold
+  tile_group->Thaw();
+
   auto transaction_id = current_txn->GetTransactionId();
   // if we can perform update, then we must have already locked the older
   // version.
@@ -600,7 +806,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   // Increment table update op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementTableUpdates(
-        new_location.block);
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
   }
 }
 
@@ -628,8 +834,43 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   // Increment table update op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto tile_group = tile_group_header->GetTileGroup();
     stats::BackendStatsContext::GetInstance()->IncrementTableUpdates(
-        location.block);
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
+  }
+}
+
+void TimestampOrderingTransactionManager::PerformDeltaUpdate(
+    Transaction *const current_txn, const ItemPointer &location,
+    storage::DeltaRecord *delta_record) {
+  PL_ASSERT(current_txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY);
+
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+
+  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
+            current_txn->GetTransactionId());
+  PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
+  PL_ASSERT(delta_record->begin_cid == MAX_CID);
+
+  // the GC may detach the older records meanwhile.
+  storage::DeltaRecord *head_record;
+  do {
+    head_record = tile_group_header->GetDeltaRecord(tuple_id);
+    delta_record->next = head_record;
+  } while (tile_group_header->SetAtomicDeltaRecord(tuple_id, head_record,
+                                                   delta_record) == false);
+
+  current_txn->RecordUpdate(location);
+
+  // Increment table update op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto tile_group = tile_group_header->GetTileGroup();
+    stats::BackendStatsContext::GetInstance()->IncrementTableUpdates(
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
   }
 }
 
@@ -644,15 +885,19 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group_header = manager.GetTileGroup(old_location.block)
-                                  ->GetHeader();
+  auto tile_group = manager.GetTileGroup(old_location.block);
+  auto tile_group_header = tile_group->GetHeader();
   auto new_tile_group_header = manager.GetTileGroup(new_location.block)
                                       ->GetHeader();
 
+  // the tile group is no longer cold
+  tile_group->Thaw();
+
   auto transaction_id = current_txn->GetTransactionId();
 
   PL_ASSERT(GetLastReaderCommitId(tile_group_header, old_location.offset) ==
-            current_txn->GetCommitId());
+            current_txn->GetCommitId() || 
+            GetLastReaderCommitId(tile_group_header, old_location.offset) == 0);
 
   PL_ASSERT(tile_group_header->GetTransactionId(old_location.offset) ==
             transaction_id);
@@ -722,7 +967,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   // Increment table delete op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementTableDeletes(
-        old_location.block);
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
   }
 }
 
@@ -754,9 +999,141 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   // Increment table delete op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto tile_group = tile_group_header->GetTileGroup();
     stats::BackendStatsContext::GetInstance()->IncrementTableDeletes(
-        location.block);
+        tile_group->GetDatabaseId(), tile_group->GetTableId());
+  }
+}
+
+// the anchor is the slot of a tuple in the tile groups of its table. it is
+// superseded by versions in the version store, and is only reclaimed once
+// the tuple is deleted.
+// updates do not copy the old image out and overwrite the anchor in place:
+// scans hand out logical tiles that point at the anchor and read its values
+// later, so a transaction that found the old image visible would read the
+// new one. the anchor is only overwritten here, once no transaction can read
+// it anymore.
+bool TimestampOrderingTransactionManager::FoldVersion(
+    const ItemPointer &anchor_location, const eid_t &expired_eid,
+    ItemPointer &head_location) {
+  auto &manager = catalog::Manager::GetInstance();
+  head_location = INVALID_ITEMPOINTER;
+
+  auto anchor_tile_group = manager.GetTileGroup(anchor_location.block);
+  if (anchor_tile_group == nullptr) {
+    return false;
+  }
+  auto anchor_header = anchor_tile_group->GetHeader();
+  oid_t anchor_id = anchor_location.offset;
+
+  ItemPointer *indirection = anchor_header->GetIndirection(anchor_id);
+  if (indirection == nullptr) {
+    return false;
+  }
+
+  ItemPointer head = *indirection;
+  if (head.block == anchor_location.block &&
+      head.offset == anchor_location.offset) {
+    head_location = anchor_location;
+    return true;
+  }
+
+  auto head_tile_group = manager.GetTileGroup(head.block);
+  if (head_tile_group == nullptr) {
+    return false;
+  }
+  auto head_header = head_tile_group->GetHeader();
+  oid_t head_id = head.offset;
+
+  // the slot of a deleted tuple's last version has been reclaimed already.
+  if (head_header->GetIndirection(head_id) != indirection) {
+    return true;
+  }
+
+  // a transaction may still read an older version of the tuple.
+  cid_t head_begin_cid = head_header->GetBeginCommitId(head_id);
+  if (head_begin_cid == MAX_CID || (head_begin_cid >> 32) > expired_eid) {
+    return false;
+  }
+
+  // the tuple has been deleted.
+  if (head_header->GetTransactionId(head_id) == INVALID_TXN_ID) {
+    return true;
+  }
+
+  if (head_header->GetDeltaRecord(head_id) != nullptr) {
+    return false;
+  }
+
+  // own both versions, so that no transaction writes them meanwhile. readers
+  // that find the head owned retry once it is released.
+  if (anchor_header->SetAtomicTransactionId(anchor_id, MAX_TXN_ID) == false) {
+    return false;
+  }
+
+  GetSpinlockField(head_header, head_id)->Lock();
+  bool is_owned = head_header->SetAtomicTransactionId(head_id, MAX_TXN_ID);
+  cid_t last_reader_cid = GetLastReaderCommitId(head_header, head_id);
+  GetSpinlockField(head_header, head_id)->Unlock();
+
+  if (is_owned == false || indirection->block != head.block ||
+      indirection->offset != head.offset ||
+      head_header->GetEndCommitId(head_id) != MAX_CID) {
+    if (is_owned == true) {
+      head_header->SetTransactionId(head_id, INITIAL_TXN_ID);
+      NotifyOwnerReleased(head_header, head_id);
+    }
+    anchor_header->SetTransactionId(anchor_id, INITIAL_TXN_ID);
+    return false;
   }
+
+  // no transaction can see the anchor, so its contents can be replaced and
+  // the overwritten varlen values freed.
+  anchor_tile_group->Thaw();
+  oid_t column_count = anchor_tile_group->GetAbstractTable()
+                           ->GetSchema()
+                           ->GetColumnCount();
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    auto value = head_tile_group->GetValue(head_id, column_id);
+    anchor_tile_group->ReplaceValue(value, anchor_id, column_id);
+  }
+
+  *(cid_t *)(anchor_header->GetReservedFieldRef(anchor_id) +
+             LAST_READER_OFFSET) = last_reader_cid;
+  anchor_header->SetBeginCommitId(anchor_id, head_begin_cid);
+  anchor_header->SetNextItemPointer(anchor_id, INVALID_ITEMPOINTER);
+
+  COMPILER_MEMORY_FENCE;
+
+  anchor_header->SetEndCommitId(anchor_id, MAX_CID);
+
+  // the anchor becomes the head of the version chain before it stops
+  // pointing to the newer versions. readers that still reach the retired
+  // version move on to the anchor.
+  COMPILER_MEMORY_FENCE;
+
+  UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(indirection,
+                                                      anchor_location);
+  PL_ASSERT(res == true);
+
+  anchor_header->SetPrevItemPointer(anchor_id, INVALID_ITEMPOINTER);
+  head_header->SetNextItemPointer(head_id, anchor_location);
+
+  COMPILER_MEMORY_FENCE;
+
+  head_header->SetEndCommitId(head_id, head_begin_cid);
+
+  // we should set the version before releasing the lock.
+  COMPILER_MEMORY_FENCE;
+
+  head_header->SetTransactionId(head_id, INVALID_TXN_ID);
+  NotifyOwnerReleased(head_header, head_id);
+
+  anchor_header->SetTransactionId(anchor_id, INITIAL_TXN_ID);
+  NotifyOwnerReleased(anchor_header, anchor_id);
+
+  head_location = head;
+  return true;
 }
 
 ResultType TimestampOrderingTransactionManager::CommitTransaction(
@@ -813,6 +1190,22 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_header, tuple_slot);
+      } else if (tuple_entry.second == RWType::UPDATE &&
+                 tile_group_header->GetPrevItemPointer(tuple_slot).IsNull()) {
+        // the update is kept as delta records of the tuple.
+        CommitDeltaRecords(tile_group_header, tuple_slot, end_commit_id);
+
+        // we should set the version before releasing the lock.
+        COMPILER_MEMORY_FENCE;
+
+        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
+
+        // fold the records into the tuple slot once they have expired.
+        current_txn->RecordDeltaUpdate(ItemPointer(tile_group_id, tuple_slot));
+
+        log_manager.LogUpdate(ItemPointer(tile_group_id, tuple_slot));
+
       } else if (tuple_entry.second == RWType::UPDATE) {
         // we must guarantee that, at any time point, only one version is
         // visible.
@@ -839,6 +1232,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INITIAL_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
 
         // add to gc set.
         gc_set->operator[](tile_group_id)[tuple_slot] = false;
@@ -867,6 +1261,7 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INVALID_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
 
         // add to gc set.
         // we need to recycle both old and new versions.
@@ -937,8 +1332,13 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
 
 ResultType TimestampOrderingTransactionManager::AbortTransaction(
     Transaction *const current_txn) {
-  // a pre-declared read-only transaction will never abort.
-  PL_ASSERT(current_txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY);
+  // a pre-declared read-only transaction never conflicts, but the statement
+  // it runs may still fail. it has nothing to roll back.
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::READ_ONLY) {
+    current_txn->SetResult(ResultType::ABORTED);
+    EndTransaction(current_txn);
+    return ResultType::ABORTED;
+  }
 
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
@@ -966,6 +1366,21 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         // update/delete yet
         // Yield the ownership
         YieldOwnership(current_txn, tile_group_header, tuple_slot);
+      } else if (tuple_entry.second == RWType::UPDATE &&
+                 tile_group_header->GetPrevItemPointer(tuple_slot).IsNull()) {
+        // the update is kept as delta records of the tuple, which readers
+        // skip once they are marked as aborted.
+        AbortDeltaRecords(tile_group_header, tuple_slot);
+
+        // we should set the version before releasing the lock.
+        COMPILER_MEMORY_FENCE;
+
+        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
+
+        // detach the aborted records.
+        current_txn->RecordDeltaUpdate(ItemPointer(tile_group_id, tuple_slot));
+
       } else if (tuple_entry.second == RWType::UPDATE) {
         ItemPointer new_version =
             tile_group_header->GetPrevItemPointer(tuple_slot);
@@ -1020,6 +1435,7 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
         COMPILER_MEMORY_FENCE;
 
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
 
         // add to gc set.
         gc_set->operator[](new_version.block)[new_version.offset] = false;
@@ -1070,10 +1486,17 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
 
         tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
+        // the tuple may have been updated through delta records before.
+        if (AbortDeltaRecords(tile_group_header, tuple_slot) == true) {
+          current_txn->RecordDeltaUpdate(
+              ItemPointer(tile_group_id, tuple_slot));
+        }
+
         // we should set the version before releasing the lock.
         COMPILER_MEMORY_FENCE;
 
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyOwnerReleased(tile_group_header, tuple_slot);
 
         // add to gc set.
         gc_set->operator[](new_version.block)[new_version.offset] = false;
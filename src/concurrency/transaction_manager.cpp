@@ -17,6 +17,7 @@
 #include "statistics/stats_aggregator.h"
 #include "logging/log_manager.h"
 #include "gc/gc_manager_factory.h"
+#include "storage/delta_record.h"
 #include "storage/tile_group.h"
 
 
@@ -36,8 +37,9 @@ Transaction *TransactionManager::BeginTransaction(const size_t thread_id, const
   
   if (type == IsolationLevelType::READ_ONLY) {
 
-    // transaction processing with decentralized epoch manager
-    cid_t read_id = EpochManagerFactory::GetInstance().EnterEpoch(thread_id, TimestampType::SNAPSHOT_READ);
+    // read-only transactions read a snapshot that no writer can change, so
+    // they neither join the epoch queue nor leave any trace in the tuples.
+    cid_t read_id = EpochManagerFactory::GetInstance().EnterReadOnlyEpoch(thread_id);
     txn = new Transaction(thread_id, type, read_id); 
   
   } else if (type == IsolationLevelType::SNAPSHOT) {
@@ -79,17 +81,30 @@ void TransactionManager::EndTransaction(Transaction *current_txn) {
 
   auto &epoch_manager = EpochManagerFactory::GetInstance();
 
-  epoch_manager.ExitEpoch(current_txn->GetThreadId(), current_txn->GetEpochId());
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::READ_ONLY) {
+    epoch_manager.ExitReadOnlyEpoch(current_txn->GetThreadId(),
+                                    current_txn->GetEpochId());
+  } else {
+    epoch_manager.ExitEpoch(current_txn->GetThreadId(), current_txn->GetEpochId());
+  }
   
   if (current_txn->GetIsolationLevel() != IsolationLevelType::READ_ONLY) {
 
     if (current_txn->GetResult() == ResultType::SUCCESS) {
       if (current_txn->IsGCSetEmpty() != true) {
+        // the old versions become garbage in the epoch of the commit id,
+        // which can be later than the epoch the transaction began in.
         gc::GCManagerFactory::GetInstance().
             RecycleTransaction(current_txn->GetGCSetPtr(), 
-                               current_txn->GetEpochId(), 
+                               current_txn->GetCommitId() >> 32, 
                                current_txn->GetThreadId());
       }
+      if (current_txn->IsDeltaSetEmpty() != true) {
+        gc::GCManagerFactory::GetInstance().
+            RecycleDeltaRecords(current_txn->GetDeltaSetPtr(),
+                                current_txn->GetCommitId() >> 32,
+                                current_txn->GetThreadId());
+      }
     } else {
       if (current_txn->IsGCSetEmpty() != true) {
         // consider what parameter we should use.
@@ -98,6 +113,13 @@ void TransactionManager::EndTransaction(Transaction *current_txn) {
                                epoch_manager.GetNextEpochId(),
                                current_txn->GetThreadId());
       }
+      if (current_txn->IsDeltaSetEmpty() != true) {
+        // the aborted delta records are detached as well.
+        gc::GCManagerFactory::GetInstance().
+            RecycleDeltaRecords(current_txn->GetDeltaSetPtr(),
+                                epoch_manager.GetNextEpochId(),
+                                current_txn->GetThreadId());
+      }
     }
   }
 
@@ -236,6 +258,9 @@ VisibilityType TransactionManager::IsVisible(
     } else if (tuple_end_cid == INVALID_CID) {
       // tuple being deleted by current txn
       return VisibilityType::DELETED;
+    } else if (tile_group_header->GetDeltaRecord(tuple_id) != nullptr) {
+      // tuple being updated by current txn through a delta record
+      return VisibilityType::OK;
     } else {
       // old version of the tuple that is being updated by current txn
       return VisibilityType::INVISIBLE;
@@ -266,6 +291,45 @@ VisibilityType TransactionManager::IsVisible(
   }
 }
 
+const storage::DeltaRecord *TransactionManager::GetVisibleDelta(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const VisibilityIdType type) {
+  const storage::DeltaRecord *delta_record =
+      tile_group_header->GetDeltaRecord(tuple_id);
+
+  // most tuples have never been updated since the GC last folded them.
+  if (delta_record == nullptr) {
+    return nullptr;
+  }
+
+  cid_t txn_vis_id;
+  if (type == VisibilityIdType::READ_ID) {
+    txn_vis_id = current_txn->GetReadId();
+  } else {
+    PL_ASSERT(type == VisibilityIdType::COMMIT_ID);
+    txn_vis_id = current_txn->GetCommitId();
+  }
+
+  bool own = (current_txn->GetTransactionId() ==
+              tile_group_header->GetTransactionId(tuple_id));
+
+  for (; delta_record != nullptr; delta_record = delta_record->next) {
+    cid_t delta_begin_cid = delta_record->begin_cid;
+    if (delta_begin_cid == MAX_CID) {
+      // only the owner of the tuple sees its uncommitted updates.
+      if (own == true) {
+        return delta_record;
+      }
+    } else if (delta_begin_cid != INVALID_CID &&
+               txn_vis_id >= delta_begin_cid) {
+      return delta_record;
+    }
+  }
+
+  return nullptr;
+}
+
 
 }
 }
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tuple_lock_manager.cpp
+//
+// Identification: src/concurrency/tuple_lock_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/tuple_lock_manager.h"
+
+#include <chrono>
+
+#include "storage/tile_group_header.h"
+#include "util/hash_util.h"
+
+namespace peloton {
+namespace concurrency {
+
+TupleLockManager &TupleLockManager::GetInstance() {
+  static TupleLockManager lock_manager;
+  return lock_manager;
+}
+
+TupleLockManager::WaitQueue &TupleLockManager::GetWaitQueue(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  hash_t hash = HashUtil::Hash(&tile_group_header);
+  hash = HashUtil::CombineHashes(hash, HashUtil::Hash(&tuple_id));
+  return wait_queues_[hash % WAIT_QUEUE_COUNT];
+}
+
+bool TupleLockManager::WaitForRelease(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const txn_id_t &owner_id) {
+  auto &wait_queue = GetWaitQueue(tile_group_header, tuple_id);
+  auto released = [&]() {
+    return tile_group_header->GetTransactionId(tuple_id) != owner_id;
+  };
+
+  // the waiter is registered before the owner is checked, so that an owner
+  // that releases the version afterwards sees the waiter and wakes it up.
+  wait_queue.waiter_count++;
+
+  bool rt;
+  {
+    std::unique_lock<std::mutex> lock(wait_queue.mutex);
+    rt = wait_queue.cv.wait_for(
+        lock, std::chrono::microseconds(timeout_us_.load()), released);
+  }
+
+  wait_queue.waiter_count--;
+
+  return rt;
+}
+
+void TupleLockManager::NotifyRelease(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto &wait_queue = GetWaitQueue(tile_group_header, tuple_id);
+
+  // order the release of the owner before the check for waiters.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (wait_queue.waiter_count.load() == 0) {
+    return;
+  }
+
+  // taking the mutex guarantees that a waiter is either not yet checking the
+  // owner, or already waiting for the notification.
+  { std::lock_guard<std::mutex> lock(wait_queue.mutex); }
+  wait_queue.cv.notify_all();
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -36,7 +36,11 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10lu", "Max Connections", FLAGS_max_connections);
   LOG_INFO("%30s: %10s", "Index Tuner", FLAGS_index_tuner ? "enabled" : "disabled");
   LOG_INFO("%30s: %10s", "Layout Tuner", FLAGS_layout_tuner ? "enabled" : "disabled");
+  LOG_INFO("%30s: %10s", "Tile Group Freezer", FLAGS_tile_group_freezer ? "enabled" : "disabled");
+  LOG_INFO("%30s: %10s", "Read-only Snapshots", FLAGS_read_only_snapshot ? "enabled" : "disabled");
   LOG_INFO("%30s: %10s",  "Code-generation", FLAGS_codegen ? "enabled" : "disabled");
+  LOG_INFO("%30s: %10lu", "Code Cache Size", FLAGS_codegen_cache_size);
+  LOG_INFO("%30s: %10s", "Tiered Compilation", FLAGS_codegen_tiering ? "enabled" : "disabled");
 
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
@@ -81,6 +85,11 @@ DEFINE_string(certificate_file,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_bool(numa_aware,
+            false,
+            "Enable NUMA-aware tile group placement and thread pinning "
+            "(default: false)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -117,6 +126,21 @@ DEFINE_bool(layout_tuner,
             false,
             "Enable layout tuner (default: false)");
 
+DEFINE_bool(tile_group_freezer,
+            false,
+            "Compress cold tile groups and release their raw tiles "
+            "(default: false)");
+
+//===----------------------------------------------------------------------===//
+// TRANSACTIONS
+//===----------------------------------------------------------------------===//
+
+DEFINE_bool(read_only_snapshot,
+            false,
+            "Run single-statement SELECTs as read-only snapshot transactions, "
+            "which may miss the commits of the last few epochs "
+            "(default: false)");
+
 //===----------------------------------------------------------------------===//
 //
 //===----------------------------------------------------------------------===//
@@ -125,6 +149,30 @@ DEFINE_bool(codegen,
             true,
             "Enable code-generation for query execution (default: true)");
 
+DEFINE_uint64(codegen_cache_size,
+              256,
+              "Number of compiled queries kept in memory (default: 256)");
+
+DEFINE_string(codegen_cache_dir,
+              "",
+              "Directory of the compiled queries kept on disk "
+              "(default: none)");
+
+DEFINE_bool(codegen_tiering,
+            false,
+            "Interpret queries first, and compile the hot ones in the "
+            "background (default: false)");
+
+DEFINE_uint64(codegen_tiering_executions,
+              3,
+              "Interpreted executions after which a query is compiled "
+              "(default: 3)");
+
+DEFINE_double(codegen_tiering_ms,
+              10.0,
+              "Interpreted time (in ms) after which a query is compiled "
+              "(default: 10)");
+
 // Layout mode
 int peloton_layout_mode = peloton::LAYOUT_TYPE_ROW;
 
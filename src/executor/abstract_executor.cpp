@@ -14,6 +14,7 @@
 #include "common/logger.h"
 #include "executor/abstract_executor.h"
 #include "executor/executor_context.h"
+#include "executor/query_profile.h"
 #include "planner/abstract_plan.h"
 
 namespace peloton {
@@ -75,6 +76,16 @@ bool AbstractExecutor::Init() {
     return false;
   }
 
+  // Look up our operator once, if the query is profiled
+  if (executor_context_ != nullptr &&
+      executor_context_->GetQueryProfile() != nullptr) {
+    auto profile = executor_context_->GetQueryProfile();
+    profile_operator_id_ = profile->GetOperatorId(node_);
+    if (profile_operator_id_ != INVALID_OID) {
+      profile_ = profile;
+    }
+  }
+
   return true;
 }
 
@@ -90,7 +101,27 @@ bool AbstractExecutor::Execute() {
   // TODO In the future, we might want to pass some kind of executor state to
   // GetNextTile. e.g. params for prepared plans.
 
+  if (profile_ != nullptr) {
+    return ProfiledExecute();
+  }
+
+  bool status = DExecute();
+
+  return status;
+}
+
+/**
+ * @brief Executes the executor and records its time and output in the
+ * profile of the query.
+ */
+bool AbstractExecutor::ProfiledExecute() {
+  profile_->StartOperator(profile_operator_id_);
   bool status = DExecute();
+  profile_->StopOperator(profile_operator_id_);
+
+  if (status == true && output != nullptr) {
+    profile_->CountOutput(profile_operator_id_, output->GetTupleCount(), 1);
+  }
 
   return status;
 }
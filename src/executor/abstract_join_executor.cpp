@@ -41,7 +41,8 @@ AbstractJoinExecutor::AbstractJoinExecutor(const planner::AbstractPlan *node,
  * @return true on success, false otherwise.
  */
 bool AbstractJoinExecutor::DInit() {
-  PL_ASSERT(children_.size() == 2);
+  // An index join reads its right side from the index, not from a child
+  PL_ASSERT(children_.size() == 2 || children_.size() == 1);
 
   // Grab data from plan node.
   const planner::AbstractJoinPlan &node =
@@ -11,6 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <concurrency/transaction_manager_factory.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -20,15 +25,477 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
 #include "planner/copy_plan.h"
+#include "storage/data_table.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "common/timer.h"
+#include "type/value_factory.h"
+#include "util/string_util.h"
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 
 namespace peloton {
 namespace executor {
 
+//===--------------------------------------------------------------------===//
+// Bulk Loader
+//===--------------------------------------------------------------------===//
+
+/**
+ * Loads the lines of a COPY FROM input into a table.
+ *
+ * The input is split into chunks that end at line boundaries. A pool of
+ * threads parses the chunks, and every thread fills tile groups of its own
+ * directly, without going through the table's active tile groups. Once the
+ * input is parsed, the tuples are registered as inserts of the loading
+ * transaction, which commits or aborts them with its other writes. The
+ * indexes are built after that, also in parallel, and the tile groups are
+ * only appended to the table once they are complete.
+ */
+class BulkLoader {
+ public:
+  BulkLoader(storage::DataTable *table, concurrency::Transaction *txn,
+             bool csv, char delimiter)
+      : table_(table),
+        schema_(table->GetSchema()),
+        txn_(txn),
+        csv_(csv),
+        delimiter_(delimiter) {}
+
+  // Parses and loads the input, after the header line if there is one.
+  // Returns false if a line is invalid.
+  bool Load(const char *data, size_t size, bool header, size_t thread_count);
+
+  // Registers the loaded tuples as inserts of the loading transaction
+  void RegisterInserts();
+
+  // Builds the index entries of the loaded tuples. Returns false if a unique
+  // constraint is violated.
+  bool BuildIndexes(size_t thread_count);
+
+  // Appends the loaded tile groups to the table
+  void Append();
+
+  // Drops the loaded tuples: the tile groups are released if the tuples are
+  // not registered yet, and appended otherwise, so that the loading
+  // transaction aborts the tuples like its other inserts
+  void Discard(bool registered);
+
+  size_t GetRowCount() const { return row_count_; }
+
+  size_t GetThreadCount() const { return thread_count_; }
+
+  const std::string &GetError() const { return error_; }
+
+ private:
+  struct Chunk {
+    const char *begin;
+    const char *end;
+  };
+
+  // The state of one loading thread
+  struct Worker {
+    std::shared_ptr<storage::TileGroup> tile_group;
+    std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+    size_t row_count = 0;
+
+    // The fields of the current line
+    std::vector<std::string> fields;
+    std::vector<bool> nulls;
+  };
+
+  void SplitInput(const char *data, size_t size);
+
+  void LoadChunks(Worker &worker);
+
+  // Parses the line starting at pos into the fields of the worker, and moves
+  // pos to the next line
+  bool ParseLine(const char *&pos, const char *end, Worker &worker);
+
+  bool ParseValue(const std::string &field, type::TypeId type,
+                  type::Value &value);
+
+  bool InsertLine(Worker &worker, const char *line);
+
+  void SetError(const std::string &error);
+
+  storage::DataTable *table_;
+  const catalog::Schema *schema_;
+  concurrency::Transaction *txn_;
+  bool csv_;
+  char delimiter_;
+
+  const char *data_ = nullptr;
+  std::vector<Chunk> chunks_;
+  std::atomic<size_t> next_chunk_{0};
+
+  std::vector<Worker> workers_;
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups_;
+  size_t row_count_ = 0;
+  size_t thread_count_ = 0;
+
+  std::atomic<bool> failed_{false};
+  std::mutex error_mutex_;
+  std::string error_;
+};
+
+void BulkLoader::SplitInput(const char *data, size_t size) {
+  const char *end = data + size;
+  const char *chunk_begin = data;
+  while (chunk_begin < end) {
+    size_t chunk_size =
+        std::min(static_cast<size_t>(end - chunk_begin),
+                 static_cast<size_t>(COPY_CHUNK_SIZE));
+    const char *chunk_end = chunk_begin + chunk_size;
+
+    // A line break only ends a CSV line outside of quotes, and the quotes of
+    // complete lines are balanced
+    size_t quote_count = csv_ ? std::count(chunk_begin, chunk_end, '"') : 0;
+    while (chunk_end < end) {
+      char ch = *chunk_end++;
+      if (ch == '"' && csv_) {
+        quote_count++;
+      } else if (ch == '\n' && quote_count % 2 == 0) {
+        break;
+      }
+    }
+    chunks_.push_back({chunk_begin, chunk_end});
+    chunk_begin = chunk_end;
+  }
+}
+
+bool BulkLoader::Load(const char *data, size_t size, bool header,
+                      size_t thread_count) {
+  data_ = data;
+  const char *end = data + size;
+  if (header) {
+    auto header_end = std::find(data, end, '\n');
+    data = (header_end == end) ? end : header_end + 1;
+  }
+  SplitInput(data, end - data);
+
+  thread_count_ = std::max<size_t>(std::min(thread_count, chunks_.size()), 1);
+  workers_.resize(thread_count_);
+
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count_; thread_itr++) {
+    threads.emplace_back(&BulkLoader::LoadChunks, this,
+                         std::ref(workers_[thread_itr]));
+  }
+  LoadChunks(workers_[0]);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (auto &worker : workers_) {
+    row_count_ += worker.row_count;
+    tile_groups_.insert(tile_groups_.end(), worker.tile_groups.begin(),
+                        worker.tile_groups.end());
+  }
+  workers_.clear();
+  return failed_ == false;
+}
+
+void BulkLoader::LoadChunks(Worker &worker) {
+  worker.fields.resize(schema_->GetColumnCount());
+  worker.nulls.resize(schema_->GetColumnCount());
+
+  while (failed_ == false) {
+    size_t chunk_id = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+    if (chunk_id >= chunks_.size()) {
+      break;
+    }
+
+    const char *pos = chunks_[chunk_id].begin;
+    const char *end = chunks_[chunk_id].end;
+    while (pos < end && failed_ == false) {
+      const char *line = pos;
+      if (ParseLine(pos, end, worker) == false ||
+          InsertLine(worker, line) == false) {
+        break;
+      }
+    }
+  }
+}
+
+bool BulkLoader::ParseLine(const char *&pos, const char *end, Worker &worker) {
+  const char *line = pos;
+  size_t column_count = worker.fields.size();
+  size_t field_count = 0;
+  bool end_of_line = false;
+
+  while (end_of_line == false) {
+    if (field_count == column_count) {
+      SetError(StringUtil::Format(
+          "extra data after last expected column at byte %lu",
+          static_cast<size_t>(line - data_)));
+      return false;
+    }
+    std::string &field = worker.fields[field_count];
+    field.clear();
+    bool is_null = false;
+
+    if (csv_) {
+      // An unquoted empty field is NULL
+      if (pos < end && *pos == '"') {
+        pos++;
+        while (true) {
+          if (pos >= end) {
+            SetError(StringUtil::Format("unterminated CSV quoted field at "
+                                        "byte %lu",
+                                        static_cast<size_t>(line - data_)));
+            return false;
+          }
+          if (*pos == '"') {
+            if (pos + 1 < end && pos[1] == '"') {
+              field.push_back('"');
+              pos += 2;
+              continue;
+            }
+            pos++;
+            break;
+          }
+          field.push_back(*pos++);
+        }
+      } else {
+        const char *field_begin = pos;
+        while (pos < end && *pos != delimiter_ && *pos != '\n' &&
+               *pos != '\r') {
+          pos++;
+        }
+        field.assign(field_begin, pos);
+        is_null = field.empty();
+      }
+    } else {
+      // \N is NULL
+      if (pos + 1 < end && pos[0] == '\\' && pos[1] == 'N' &&
+          (pos + 2 == end || pos[2] == delimiter_ || pos[2] == '\n' ||
+           pos[2] == '\r')) {
+        is_null = true;
+        pos += 2;
+      }
+      while (pos < end && *pos != delimiter_ && *pos != '\n' &&
+             *pos != '\r') {
+        char ch = *pos++;
+        if (ch == '\\' && pos < end) {
+          ch = *pos++;
+          switch (ch) {
+            case 'n':
+              ch = '\n';
+              break;
+            case 't':
+              ch = '\t';
+              break;
+            case 'r':
+              ch = '\r';
+              break;
+            default:
+              break;
+          }
+        }
+        field.push_back(ch);
+      }
+    }
+
+    worker.nulls[field_count] = is_null;
+    field_count++;
+
+    // The field ends the line, or is followed by a delimiter
+    if (pos >= end || *pos == '\n' || *pos == '\r') {
+      if (pos < end && *pos == '\r') pos++;
+      if (pos < end && *pos == '\n') pos++;
+      end_of_line = true;
+    } else if (*pos == delimiter_) {
+      pos++;
+    } else {
+      SetError(StringUtil::Format("unexpected character after quoted field "
+                                  "at byte %lu",
+                                  static_cast<size_t>(line - data_)));
+      return false;
+    }
+  }
+
+  if (field_count != column_count) {
+    SetError(StringUtil::Format("missing data for column %lu at byte %lu",
+                                field_count,
+                                static_cast<size_t>(line - data_)));
+    return false;
+  }
+  return true;
+}
+
+bool BulkLoader::ParseValue(const std::string &field, type::TypeId type,
+                            type::Value &value) {
+  const char *str = field.c_str();
+  char *str_end = nullptr;
+  errno = 0;
+
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT: {
+      long long integer = strtoll(str, &str_end, 10);
+      if (str_end == str || *str_end != '\0' || errno == ERANGE) return false;
+      if (type == type::TypeId::TINYINT) {
+        if (integer < type::PELOTON_INT8_MIN || integer > type::PELOTON_INT8_MAX)
+          return false;
+        value = type::ValueFactory::GetTinyIntValue(integer);
+      } else if (type == type::TypeId::SMALLINT) {
+        if (integer < type::PELOTON_INT16_MIN || integer > type::PELOTON_INT16_MAX)
+          return false;
+        value = type::ValueFactory::GetSmallIntValue(integer);
+      } else if (type == type::TypeId::INTEGER) {
+        if (integer < type::PELOTON_INT32_MIN || integer > type::PELOTON_INT32_MAX)
+          return false;
+        value = type::ValueFactory::GetIntegerValue(integer);
+      } else {
+        if (integer < type::PELOTON_INT64_MIN) return false;
+        value = type::ValueFactory::GetBigIntValue(integer);
+      }
+      return true;
+    }
+    case type::TypeId::DECIMAL: {
+      double decimal = strtod(str, &str_end);
+      if (str_end == str || *str_end != '\0' || errno == ERANGE) return false;
+      value = type::ValueFactory::GetDecimalValue(decimal);
+      return true;
+    }
+    case type::TypeId::VARCHAR:
+      // The value only references the field until it is copied into the tile
+      value = type::ValueFactory::GetVarcharValue(str, field.size() + 1, false);
+      return true;
+    default:
+      try {
+        value = type::ValueFactory::GetVarcharValue(field).CastAs(type);
+      } catch (Exception &e) {
+        return false;
+      }
+      return true;
+  }
+}
+
+bool BulkLoader::InsertLine(Worker &worker, const char *line) {
+  if (worker.tile_group == nullptr ||
+      worker.tile_group->GetNextTupleSlot() ==
+          worker.tile_group->GetAllocatedTupleCount()) {
+    worker.tile_group = table_->GetBulkLoadTileGroup();
+    worker.tile_groups.push_back(worker.tile_group);
+  }
+
+  auto tile_group = worker.tile_group.get();
+  oid_t tuple_id = tile_group->InsertTuple(nullptr);
+  PL_ASSERT(tuple_id != INVALID_OID);
+
+  oid_t column_count = schema_->GetColumnCount();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto type = schema_->GetType(column_itr);
+    type::Value value;
+    if (worker.nulls[column_itr]) {
+      if (schema_->AllowNull(column_itr) == false) {
+        SetError(StringUtil::Format(
+            "null value in column %s violates not-null constraint at byte %lu",
+            schema_->GetColumn(column_itr).GetName().c_str(),
+            static_cast<size_t>(line - data_)));
+        return false;
+      }
+      value = type::ValueFactory::GetNullValueByType(type);
+    } else if (ParseValue(worker.fields[column_itr], type, value) == false) {
+      SetError(StringUtil::Format(
+          "invalid input \"%s\" for column %s at byte %lu",
+          worker.fields[column_itr].c_str(),
+          schema_->GetColumn(column_itr).GetName().c_str(),
+          static_cast<size_t>(line - data_)));
+      return false;
+    }
+    tile_group->SetValue(value, tuple_id, column_itr);
+  }
+
+  worker.row_count++;
+  return true;
+}
+
+void BulkLoader::RegisterInserts() {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  std::vector<ItemPointer> locations;
+  for (auto &tile_group : tile_groups_) {
+    auto tile_group_id = tile_group->GetTileGroupId();
+    auto tuple_count = tile_group->GetNextTupleSlot();
+    locations.clear();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      locations.emplace_back(tile_group_id, tuple_id);
+    }
+    // The index entries are installed by BuildIndexes()
+    transaction_manager.PerformInserts(txn_, locations, {});
+  }
+}
+
+bool BulkLoader::BuildIndexes(size_t thread_count) {
+  if (table_->GetIndexCount() == 0) {
+    return true;
+  }
+
+  std::atomic<size_t> next_tile_group(0);
+  auto build = [this, &next_tile_group]() {
+    while (failed_ == false) {
+      size_t offset = next_tile_group.fetch_add(1, std::memory_order_relaxed);
+      if (offset >= tile_groups_.size()) {
+        break;
+      }
+      if (table_->InsertBulkLoadInIndexes(tile_groups_[offset].get(), txn_) ==
+          false) {
+        SetError("duplicate key value violates unique constraint");
+      }
+    }
+  };
+
+  thread_count = std::max<size_t>(
+      std::min(thread_count, tile_groups_.size()), 1);
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back(build);
+  }
+  build();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return failed_ == false;
+}
+
+void BulkLoader::Append() { table_->AppendBulkLoadTileGroups(tile_groups_); }
+
+void BulkLoader::Discard(bool registered) {
+  if (registered == false) {
+    auto &manager = catalog::Manager::GetInstance();
+    for (auto &tile_group : tile_groups_) {
+      manager.DropTileGroup(tile_group->GetTileGroupId());
+    }
+    tile_groups_.clear();
+    return;
+  }
+
+  // Index entries may point to the tuples, which are invalidated when the
+  // loading transaction aborts
+  Append();
+}
+
+void BulkLoader::SetError(const std::string &error) {
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  if (failed_ == false) {
+    error_ = error;
+    failed_ = true;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Copy Executor
+//===--------------------------------------------------------------------===//
+
 /**
  * @brief Constructor for Copy executor.
  * @param node Copy node corresponding to this executor.
@@ -44,11 +511,16 @@ CopyExecutor::~CopyExecutor() {}
  * @return true on success, false otherwise.
  */
 bool CopyExecutor::DInit() {
-  PL_ASSERT(children_.size() == 1);
-
   // Grab info from plan node and check it
   const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
 
+  // Loading doesn't read from a child
+  if (node.IsImport()) {
+    PL_ASSERT(children_.size() == 0);
+    return true;
+  }
+  PL_ASSERT(children_.size() == 1);
+
   bool success = InitFileHandle(node.file_path.c_str(), "w");
 
   if (success == false) {
@@ -180,6 +652,102 @@ void CopyExecutor::Copy(const char *data, int len, bool end_of_line) {
   PL_ASSERT(buff_size <= COPY_BUFFER_SIZE);
 }
 
+/**
+ * @brief Bulk loads the input file, or the data the client sent, into the
+ * target table.
+ * @return true on success, false if a constraint is violated.
+ */
+bool CopyExecutor::DExecuteImport() {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  done = true;
+
+  if (node.IsFromStdin()) {
+    return Import(node.input_data.data(), node.input_data.size());
+  }
+
+  int fd = open(node.file_path.c_str(), O_RDONLY);
+  struct stat file_stat;
+  if (fd == INVALID_FILE_DESCRIPTOR || fstat(fd, &file_stat) != 0) {
+    if (fd != INVALID_FILE_DESCRIPTOR) close(fd);
+    throw ExecutorException("Failed to open file " + node.file_path +
+                            ". Try absolute path and make sure you have the "
+                            "permission to access this file.");
+  }
+
+  // The parsing threads read the file through one read-only mapping
+  size_t size = file_stat.st_size;
+  const char *data = nullptr;
+  if (size > 0) {
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      throw ExecutorException("Failed to map file " + node.file_path + ": " +
+                              strerror(errno));
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(mapping);
+  }
+  LOG_DEBUG("Opened source copy input file: %s", node.file_path.c_str());
+
+  bool status;
+  try {
+    status = Import(data, size);
+  } catch (Exception &e) {
+    if (data != nullptr) munmap(const_cast<char *>(data), size);
+    close(fd);
+    throw;
+  }
+  if (data != nullptr) munmap(const_cast<char *>(data), size);
+  close(fd);
+  return status;
+}
+
+/**
+ * @brief Loads the lines of the input into the target table.
+ * @return true on success, false if a unique constraint is violated.
+ */
+bool CopyExecutor::Import(const char *data, size_t size) {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  auto current_txn = executor_context_->GetTransaction();
+  Timer<std::ratio<1, 1000>> timer;
+  timer.Start();
+
+  total_bytes_read = size;
+
+  BulkLoader loader(node.target_table, current_txn,
+                    node.copy_type == CopyType::IMPORT_CSV, node.delimiter);
+  size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+  if (loader.Load(data, size, node.header, thread_count) == false) {
+    loader.Discard(false);
+    throw ExecutorException("COPY FROM failed: " + loader.GetError());
+  }
+  loader.RegisterInserts();
+  if (loader.BuildIndexes(thread_count) == false) {
+    LOG_TRACE("COPY FROM failed: %s", loader.GetError().c_str());
+    loader.Discard(true);
+    auto &transaction_manager =
+        concurrency::TransactionManagerFactory::GetInstance();
+    transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
+    return false;
+  }
+  loader.Append();
+
+  timer.Stop();
+  double seconds = std::max(timer.GetDuration() / 1000, 1e-9);
+  auto row_count = loader.GetRowCount();
+  LOG_INFO(
+      "COPY FROM loaded %lu rows (%.2f MB) into %s with %lu threads in "
+      "%.3f ms: %.2f MB/s, %.0f rows/s",
+      row_count, total_bytes_read / (1024.0 * 1024.0),
+      node.target_table->GetName().c_str(), loader.GetThreadCount(),
+      timer.GetDuration(), total_bytes_read / (1024.0 * 1024.0) / seconds,
+      row_count / seconds);
+
+  executor_context_->num_processed += row_count;
+  return true;
+}
+
 /**
  * @return true on success, false otherwise.
  */
@@ -189,6 +757,10 @@ bool CopyExecutor::DExecute() {
     return false;
   }
 
+  if (GetPlanNode<planner::CopyPlan>().IsImport()) {
+    return DExecuteImport();
+  }
+
   while (children_[0]->Execute() == true) {
     // Get input a tile
     std::unique_ptr<LogicalTile> logical_tile(children_[0]->GetOutput());
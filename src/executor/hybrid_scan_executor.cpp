@@ -30,6 +30,7 @@
 #include "executor/hybrid_scan_executor.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
+#include "executor/seq_scan_executor.h"
 #include "expression/abstract_expression.h"
 #include "planner/hybrid_scan_plan.h"
 #include "storage/data_table.h"
@@ -57,6 +58,25 @@ bool HybridScanExecutor::DInit() {
   type_ = node.GetHybridType();
   PL_ASSERT(table_ != nullptr);
 
+  // the tuple slots of these tables may hold stale versions.
+  if (table_->IsDeltaVersioning() == true ||
+      table_->HasVersionStore() == true) {
+    if (type_ == HybridScanType::INDEX) {
+      throw NotImplementedException(
+          "Hybrid index scans do not read the newer versions of table " +
+          table_->GetName() + ", use an index scan instead");
+    }
+
+    LOG_TRACE("Sequential Scan of a versioned table");
+    auto predicate = node.GetPredicate();
+    seq_scan_plan_.reset(new planner::SeqScanPlan(
+        table_, predicate != nullptr ? predicate->Copy() : nullptr,
+        node.GetColumnIds(), node.IsForUpdate()));
+    seq_scan_executor_.reset(
+        new SeqScanExecutor(seq_scan_plan_.get(), executor_context_));
+    return seq_scan_executor_->Init();
+  }
+
   // SEQUENTIAL SCAN
   if (type_ == HybridScanType::SEQUENTIAL) {
     LOG_TRACE("Sequential Scan");
@@ -284,6 +304,14 @@ bool HybridScanExecutor::IndexScanUtil() {
 }
 
 bool HybridScanExecutor::DExecute() {
+  if (seq_scan_executor_ != nullptr) {
+    if (seq_scan_executor_->Execute() == false) {
+      return false;
+    }
+    SetOutput(seq_scan_executor_->GetOutput());
+    return true;
+  }
+
   // SEQUENTIAL SCAN
   if (type_ == HybridScanType::SEQUENTIAL) {
     LOG_TRACE("Sequential Scan");
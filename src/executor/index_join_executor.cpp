@@ -0,0 +1,376 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_executor.cpp
+//
+// Identification: src/executor/index_join_executor.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/index_join_executor.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "catalog/manager.h"
+#include "common/container_tuple.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/index_join_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for index join executor.
+ * @param node Index join node corresponding to this executor.
+ */
+IndexJoinExecutor::IndexJoinExecutor(const planner::AbstractPlan *node,
+                                     ExecutorContext *executor_context)
+    : AbstractJoinExecutor(node, executor_context) {}
+
+/**
+ * @brief Grab the index and the keys from the plan node.
+ * @return true on success, false otherwise.
+ */
+bool IndexJoinExecutor::DInit() {
+  auto status = AbstractJoinExecutor::DInit();
+  if (status == false) {
+    return status;
+  }
+
+  const auto &node = GetPlanNode<planner::IndexJoinPlan>();
+  PL_ASSERT(children_.size() == 1);
+  PL_ASSERT(join_type_ == JoinType::INNER);
+
+  table_ = node.GetTable();
+  index_ = node.GetIndex();
+  outer_keys_.clear();
+  node.GetOuterKeys(outer_keys_);
+  column_ids_ = node.GetColumnIds();
+  inner_predicate_ = node.GetInnerPredicate();
+
+  left_tile_.reset();
+  result_tiles_.clear();
+  result_itr_ = 0;
+
+  return true;
+}
+
+/**
+ * @brief Joins the next outer tile with the inner tuples found in the index.
+ * @return true on success, false otherwise.
+ */
+bool IndexJoinExecutor::DExecute() {
+  while (true) {
+    // Return the buffered result tiles first
+    if (result_itr_ < result_tiles_.size()) {
+      SetOutput(result_tiles_[result_itr_++].release());
+      return true;
+    }
+
+    if (children_[0]->Execute() == false) {
+      LOG_TRACE("Did not get outer tile");
+      return false;
+    }
+
+    left_tile_.reset(children_[0]->GetOutput());
+    result_tiles_.clear();
+    result_itr_ = 0;
+
+    if (ProbeIndex(left_tile_.get()) == false) {
+      return false;
+    }
+  }
+}
+
+bool IndexJoinExecutor::ProbeIndex(LogicalTile *left_tile) {
+  const auto *key_schema = index_->GetKeySchema();
+  const bool is_primary =
+      index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY;
+
+  // Build the keys of all outer tuples. Outer tuples with a NULL key, or a key
+  // that doesn't fit into the key columns, can't have a match
+  type::EphemeralPool pool;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  std::vector<oid_t> key_rows;
+  for (oid_t left_row : *left_tile) {
+    expression::ContainerTuple<LogicalTile> left_tuple(left_tile, left_row);
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+
+    bool has_key = true;
+    for (oid_t i = 0; i < outer_keys_.size() && has_key; i++) {
+      auto value =
+          outer_keys_[i]->Evaluate(&left_tuple, nullptr, executor_context_);
+      if (value.IsNull()) {
+        has_key = false;
+        break;
+      }
+      try {
+        key->SetValue(i, value, &pool);
+      } catch (ValueOutOfRangeException &e) {
+        has_key = false;
+      }
+    }
+
+    if (has_key) {
+      key_ptrs.push_back(key.get());
+      keys.push_back(std::move(key));
+      key_rows.push_back(left_row);
+    }
+  }
+
+  if (keys.empty()) {
+    return true;
+  }
+
+  std::vector<std::vector<ItemPointer *>> key_locations;
+  index_->ScanKeyBatch(key_ptrs, key_locations);
+  PL_ASSERT(key_locations.size() == keys.size());
+
+  // Find the visible versions of the matching inner tuples
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<Match> matches;
+  std::map<oid_t, std::shared_ptr<storage::Tile>> version_tiles;
+  for (size_t key_idx = 0; key_idx < keys.size(); key_idx++) {
+    for (auto tuple_location_ptr : key_locations[key_idx]) {
+      ItemPointer visible;
+      if (FindVisibleVersion(*tuple_location_ptr, visible) == false) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
+      if (visible.IsNull()) {
+        continue;
+      }
+
+      // Slots of a delta table with a visible delta are rebuilt first, and
+      // the key and predicate are checked against the rebuilt version
+      auto tile_group = manager.GetTileGroup(visible.block);
+      expression::ContainerTuple<storage::TileGroup> slot_tuple(
+          tile_group.get(), visible.offset);
+      auto version = RebuildVersion(tile_group, visible, version_tiles);
+      AbstractTuple &inner_tuple =
+          (version != nullptr) ? static_cast<AbstractTuple &>(*version)
+                               : static_cast<AbstractTuple &>(slot_tuple);
+
+      // A secondary index may still point to an older version with a
+      // different key
+      if (!is_primary && CheckKey(inner_tuple, *keys[key_idx]) == false) {
+        continue;
+      }
+
+      if (inner_predicate_ != nullptr) {
+        if (!inner_predicate_->Evaluate(&inner_tuple, nullptr,
+                                        executor_context_).IsTrue()) {
+          continue;
+        }
+      }
+
+      if (transaction_manager.PerformRead(current_txn, visible, false) ==
+          false) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
+
+      matches.push_back(Match{visible.block, visible.offset, key_rows[key_idx],
+                              version != nullptr});
+    }
+  }
+
+  // Build one result tile per inner tile group, keeping the outer order.
+  // Rebuilt versions get a result tile of their own
+  std::stable_sort(matches.begin(), matches.end(),
+                   [](const Match &a, const Match &b) {
+                     if (a.block != b.block) {
+                       return a.block < b.block;
+                     }
+                     return a.is_version < b.is_version;
+                   });
+
+  size_t group_begin = 0;
+  while (group_begin < matches.size()) {
+    const auto &first = matches[group_begin];
+    size_t group_end = group_begin;
+    std::vector<oid_t> offsets;
+    while (group_end < matches.size() &&
+           matches[group_end].block == first.block &&
+           matches[group_end].is_version == first.is_version) {
+      offsets.push_back(matches[group_end].offset);
+      group_end++;
+    }
+
+    std::unique_ptr<LogicalTile> right_tile;
+    if (first.is_version) {
+      right_tile.reset(LogicalTileFactory::WrapVersionTile(
+          version_tiles[first.block], column_ids_, std::move(offsets)));
+    } else {
+      auto tile_group = manager.GetTileGroup(first.block);
+      right_tile.reset(LogicalTileFactory::GetTile());
+      right_tile->AddColumns(tile_group, column_ids_);
+      right_tile->AddPositionList(std::move(offsets));
+    }
+
+    auto output_tile = BuildOutputLogicalTile(left_tile, right_tile.get());
+    LogicalTile::PositionListsBuilder pos_lists_builder(left_tile,
+                                                        right_tile.get());
+    for (size_t i = group_begin; i < group_end; i++) {
+      oid_t left_row = matches[i].left_row;
+      oid_t right_row = i - group_begin;
+
+      if (predicate_ != nullptr) {
+        expression::ContainerTuple<LogicalTile> left_tuple(left_tile, left_row);
+        expression::ContainerTuple<LogicalTile> right_tuple(right_tile.get(),
+                                                            right_row);
+        if (!predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_)
+                 .IsTrue()) {
+          continue;
+        }
+      }
+
+      pos_lists_builder.AddRow(left_row, right_row);
+    }
+
+    if (pos_lists_builder.Size() > 0) {
+      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+      result_tiles_.push_back(std::move(output_tile));
+    }
+
+    group_begin = group_end;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Traverse the version chain until the version that is visible to the
+ * transaction is found. The visible location is null if the tuple is deleted.
+ * @return false if the transaction has to abort, true otherwise.
+ */
+bool IndexJoinExecutor::FindVisibleVersion(ItemPointer tuple_location,
+                                           ItemPointer &visible) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group = manager.GetTileGroup(tuple_location.block);
+  auto tile_group_header = tile_group->GetHeader();
+  size_t chain_length = 0;
+
+  visible = INVALID_ITEMPOINTER;
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+
+    if (visibility == VisibilityType::DELETED) {
+      return true;
+    } else if (visibility == VisibilityType::OK) {
+      visible = tuple_location;
+      return true;
+    }
+
+    PL_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     current_txn->GetReadId());
+    if (is_acquired && is_alive) {
+      // The version chain was modified by another transaction, start over
+      // from the head of the chain
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      tile_group = manager.GetTileGroup(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
+      chain_length = 0;
+      continue;
+    }
+
+    ItemPointer old_item = tuple_location;
+    tuple_location = tile_group_header->GetNextItemPointer(old_item.offset);
+
+    if (tuple_location.IsNull()) {
+      // The tuple was inserted by a transaction that is not visible
+      if (chain_length == 1) {
+        return true;
+      }
+      return false;
+    }
+
+    tile_group = manager.GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+/**
+ * @brief Rebuild the version of a delta table tuple that is visible to the
+ * transaction into the version tile of its tile group.
+ * @return The rebuilt version, or nullptr if the slot itself is visible.
+ */
+std::unique_ptr<storage::Tuple> IndexJoinExecutor::RebuildVersion(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    const ItemPointer &tuple_location,
+    std::map<oid_t, std::shared_ptr<storage::Tile>> &version_tiles) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto delta_record = transaction_manager.GetVisibleDelta(
+      executor_context_->GetTransaction(), tile_group->GetHeader(),
+      tuple_location.offset);
+  if (delta_record == nullptr) {
+    return nullptr;
+  }
+
+  auto &version_tile = version_tiles[tuple_location.block];
+  if (version_tile == nullptr) {
+    version_tile = LogicalTileFactory::GetVersionTile(tile_group);
+  }
+
+  std::unique_ptr<storage::Tuple> version(new storage::Tuple(
+      version_tile->GetSchema(),
+      version_tile->GetTupleLocation(tuple_location.offset)));
+  tile_group->ReconstructTuple(tuple_location.offset, delta_record,
+                               version.get(), version_tile->GetPool());
+
+  return version;
+}
+
+bool IndexJoinExecutor::CheckKey(const AbstractTuple &tuple,
+                                 const storage::Tuple &key) {
+  const auto &key_attrs = index_->GetMetadata()->GetKeyAttrs();
+  for (oid_t i = 0; i < key_attrs.size(); i++) {
+    if (tuple.GetValue(key_attrs[i]).CompareEquals(key.GetValue(i)) !=
+        type::CMP_TRUE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace executor
+}  // namespace peloton
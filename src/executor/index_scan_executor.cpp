@@ -31,7 +31,9 @@
 #include "storage/data_table.h"
 #include "storage/masked_tuple.h"
 #include "storage/tile_group.h"
+#include "storage/tile.h"
 #include "storage/tile_group_header.h"
+#include "storage/tuple.h"
 #include "type/types.h"
 #include "type/value.h"
 
@@ -73,6 +75,8 @@ bool IndexScanExecutor::DInit() {
   result_.clear();
   done_ = false;
   key_ready_ = false;
+  version_tiles_.clear();
+  version_locations_.clear();
 
   column_ids_ = node.GetColumnIds();
   key_column_ids_ = node.GetKeyColumnIds();
@@ -242,14 +246,21 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        // the visible version may be newer than the tuple slot.
+        auto version = RebuildVersion(tile_group, tuple_location);
+
         bool eval = true;
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
           LOG_TRACE("perform predicate evaluate");
           expression::ContainerTuple<storage::TileGroup> tuple(
               tile_group.get(), tuple_location.offset);
-          eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+          const AbstractTuple *candidate_tuple =
+              (version != nullptr)
+                  ? static_cast<const AbstractTuple *>(version.get())
+                  : static_cast<const AbstractTuple *>(&tuple);
+          eval = predicate_->Evaluate(candidate_tuple, nullptr,
+                                      executor_context_).IsTrue();
         }
         // if passed evaluation, then perform write.
         if (eval == true) {
@@ -341,19 +352,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   }
 
   // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
-
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
+  for (auto &tuples : visible_tuples) {
+    AddResultTiles(tuples.first, tuples.second);
   }
 
   done_ = true;
@@ -471,9 +471,16 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
                   tuple_location.offset);
 
         // Further check if the version has the secondary key
-        expression::ContainerTuple<storage::TileGroup> candidate_tuple(
+        expression::ContainerTuple<storage::TileGroup> container_tuple(
             tile_group.get(), tuple_location.offset);
 
+        // the key may have been updated in a delta record.
+        auto version = RebuildVersion(tile_group, tuple_location);
+        AbstractTuple &candidate_tuple =
+            (version != nullptr)
+                ? static_cast<AbstractTuple &>(*version)
+                : static_cast<AbstractTuple &>(container_tuple);
+
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
         // Construct the key tuple
@@ -584,19 +591,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   }
 
   // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
-
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
+  for (auto &tuples : visible_tuples) {
+    AddResultTiles(tuples.first, tuples.second);
   }
 
   done_ = true;
@@ -641,8 +637,20 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
   auto &manager = catalog::Manager::GetInstance();
 
   auto tile_group = manager.GetTileGroup(tuple_location.block);
-  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                       tuple_location.offset);
+  expression::ContainerTuple<storage::TileGroup> container_tuple(
+      tile_group.get(), tuple_location.offset);
+
+  // the keys of a rebuilt version are read from the version tile.
+  std::unique_ptr<storage::Tuple> version;
+  if (version_locations_.count(tuple_location) != 0) {
+    auto &version_tile = version_tiles_[tuple_location.block];
+    version.reset(new storage::Tuple(
+        version_tile->GetSchema(),
+        version_tile->GetTupleLocation(tuple_location.offset)));
+  }
+  const AbstractTuple &tuple =
+      (version != nullptr) ? static_cast<const AbstractTuple &>(*version)
+                           : static_cast<const AbstractTuple &>(container_tuple);
 
   // This is the end of loop
   oid_t cond_num = key_column_ids_.size();
@@ -824,9 +832,84 @@ void IndexScanExecutor::UpdatePredicate(
       .SetTupleColumnValue(index_.get(), key_column_ids, values);
 }
 
+std::unique_ptr<storage::Tuple> IndexScanExecutor::RebuildVersion(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    const ItemPointer &tuple_location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto delta_record = transaction_manager.GetVisibleDelta(
+      executor_context_->GetTransaction(), tile_group->GetHeader(),
+      tuple_location.offset);
+  if (delta_record == nullptr) {
+    return nullptr;
+  }
+
+  auto &version_tile = version_tiles_[tuple_location.block];
+  if (version_tile == nullptr) {
+    version_tile = LogicalTileFactory::GetVersionTile(tile_group);
+  }
+
+  std::unique_ptr<storage::Tuple> version(new storage::Tuple(
+      version_tile->GetSchema(),
+      version_tile->GetTupleLocation(tuple_location.offset)));
+  tile_group->ReconstructTuple(tuple_location.offset, delta_record,
+                               version.get(), version_tile->GetPool());
+  version_locations_.insert(tuple_location);
+
+  return version;
+}
+
+void IndexScanExecutor::AddResultTiles(const oid_t tile_group_id,
+                                       std::vector<oid_t> &offsets) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+
+  // the rebuilt versions are returned in a logical tile of their own.
+  std::vector<oid_t> version_offsets;
+  if (version_tiles_.count(tile_group_id) != 0) {
+    std::vector<oid_t> slot_offsets;
+    for (auto offset : offsets) {
+      if (version_locations_.count(ItemPointer(tile_group_id, offset)) != 0) {
+        version_offsets.push_back(offset);
+      } else {
+        slot_offsets.push_back(offset);
+      }
+    }
+    offsets.swap(slot_offsets);
+  }
+
+  if (offsets.size() != 0) {
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    // Add relevant columns to logical tile
+    logical_tile->AddColumns(tile_group, full_column_ids_);
+    logical_tile->AddPositionList(std::move(offsets));
+    if (column_ids_.size() != 0) {
+      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
+    }
+
+    result_.push_back(logical_tile.release());
+  }
+
+  if (version_offsets.size() != 0) {
+    std::unique_ptr<LogicalTile> logical_tile(
+        LogicalTileFactory::WrapVersionTile(version_tiles_[tile_group_id],
+                                            full_column_ids_,
+                                            std::move(version_offsets)));
+    if (column_ids_.size() != 0) {
+      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
+    }
+
+    result_.push_back(logical_tile.release());
+  }
+}
+
 void IndexScanExecutor::ResetState() {
   result_.clear();
 
+  version_tiles_.clear();
+  version_locations_.clear();
+
   result_itr_ = START_OID;
 
   done_ = false;
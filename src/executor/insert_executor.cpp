@@ -90,39 +90,42 @@ bool InsertExecutor::DExecute() {
     auto target_table_schema = target_table->GetSchema();
     auto column_count = target_table_schema->GetColumnCount();
 
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
+    // Materialize the logical tile, and insert it as one batch
+    std::vector<std::unique_ptr<storage::Tuple>> tuples;
+    std::vector<const storage::Tuple *> batch;
+    tuples.reserve(logical_tile->GetTupleCount());
+    batch.reserve(logical_tile->GetTupleCount());
 
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<LogicalTile> cur_tuple(logical_tile.get(),
                                                         tuple_id);
 
+      std::unique_ptr<storage::Tuple> tuple(
+          new storage::Tuple(target_table_schema, true));
+
       // Materialize the logical tile tuple
       for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
         type::Value val = (cur_tuple.GetValue(column_itr));
         tuple->SetValue(column_itr, val, executor_pool);
       }
 
-      // insert tuple into the table.
-      ItemPointer *index_entry_ptr = nullptr;
-      peloton::ItemPointer location =
-          target_table->InsertTuple(tuple.get(), current_txn, &index_entry_ptr);
-
-      // it is possible that some concurrent transactions have inserted the same
-      // tuple.
-      // in this case, abort the transaction.
-      if (location.block == INVALID_OID) {
-        transaction_manager.SetTransactionResult(
-            current_txn, peloton::ResultType::FAILURE);
-        return false;
-      }
-
-      transaction_manager.PerformInsert(current_txn, location, index_entry_ptr);
+      batch.push_back(tuple.get());
+      tuples.push_back(std::move(tuple));
+    }
 
-      executor_context_->num_processed += 1;  // insert one
+    // insert tuples into the table.
+    // it is possible that some concurrent transactions have inserted the same
+    // tuple.
+    // in this case, abort the transaction.
+    if (target_table->InsertTuples(batch, current_txn) == false) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               peloton::ResultType::FAILURE);
+      return false;
     }
 
+    executor_context_->num_processed += batch.size();
+
     return true;
   }
   // Inserting a collection of tuples from plan node
@@ -156,6 +159,28 @@ bool InsertExecutor::DExecute() {
     }
 
     // Bulk Insert Mode
+    // several tuples are inserted as one batch
+    if (bulk_insert_count > 1) {
+      std::vector<const storage::Tuple *> batch;
+      batch.reserve(bulk_insert_count);
+      for (oid_t insert_itr = 0; insert_itr < bulk_insert_count;
+           insert_itr++) {
+        batch.push_back(project_info ? tuple : node.GetTuple(insert_itr));
+      }
+
+      if (target_table->InsertTuples(batch, current_txn) == false) {
+        LOG_TRACE("Failed to Insert. Set txn failure.");
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return false;
+      }
+
+      executor_context_->num_processed += bulk_insert_count;
+
+      done_ = true;
+      return true;
+    }
+
     for (oid_t insert_itr = 0; insert_itr < bulk_insert_count; insert_itr++) {
       // if we are doing a bulk insert from values not project_info
       if (!project_info) {
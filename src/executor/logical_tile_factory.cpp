@@ -109,5 +109,48 @@ LogicalTile *LogicalTileFactory::WrapTileGroup(
   return new_tile.release();
 }
 
+/**
+ * @brief Creates a tile for the versions that a scan rebuilds from the delta
+ * records of a tile group. The tile has the schema of the table, and every
+ * version is placed at the offset of its tuple slot, so that the tuples can
+ * still be located in the tile group.
+ * @param tile_group Tile group holding the tuple slots.
+ *
+ * @return Tile shadowing the tuple slots of the tile group.
+ */
+std::shared_ptr<storage::Tile> LogicalTileFactory::GetVersionTile(
+    const std::shared_ptr<storage::TileGroup> &tile_group) {
+  auto table = tile_group->GetAbstractTable();
+  return std::shared_ptr<storage::Tile>(storage::TileFactory::GetTile(
+      BackendType::MM, tile_group->GetDatabaseId(), tile_group->GetTableId(),
+      tile_group->GetTileGroupId(), INVALID_OID, tile_group->GetHeader(),
+      *table->GetSchema(), tile_group.get(), tile_group->GetNextTupleSlot()));
+}
+
+/**
+ * @brief Convenience method to construct a logical tile wrapping the
+ * versions rebuilt into a version tile.
+ * @param version_tile Tile created by GetVersionTile().
+ * @param column_ids Columns of the table to be added to the logical tile.
+ * @param position_list Offsets of the rebuilt versions.
+ *
+ * @return Logical tile wrapping the versions.
+ */
+LogicalTile *LogicalTileFactory::WrapVersionTile(
+    const std::shared_ptr<storage::Tile> &version_tile,
+    const std::vector<oid_t> &column_ids,
+    std::vector<oid_t> &&position_list) {
+  std::unique_ptr<LogicalTile> new_tile(new LogicalTile());
+
+  const oid_t position_list_idx = 0;
+  new_tile->AddPositionList(std::move(position_list));
+
+  for (auto column_id : column_ids) {
+    new_tile->AddColumn(version_tile, column_id, position_list_idx);
+  }
+
+  return new_tile.release();
+}
+
 }  // namespace executor
 }  // namespace peloton
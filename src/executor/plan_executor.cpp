@@ -15,9 +15,12 @@
 #include "codegen/buffering_consumer.h"
 #include "codegen/query_compiler.h"
 #include "codegen/query.h"
+#include "codegen/tiered_compiler.h"
 #include "common/logger.h"
+#include "common/timer.h"
 #include "executor/executor_context.h"
 #include "executor/executors.h"
+#include "executor/query_profile.h"
 #include "optimizer/util.h"
 #include "storage/tuple_iterator.h"
 
@@ -48,7 +51,8 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
                                         concurrency::Transaction *txn,
                                         const std::vector<type::Value> &params,
                                         std::vector<StatementResult> &result,
-                                        const std::vector<int> &result_format) {
+                                        const std::vector<int> &result_format,
+                                        QueryProfile *profile) {
   ExecuteResult p_status;
   if (plan == nullptr) return p_status;
 
@@ -64,8 +68,28 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   // network
   std::unique_ptr<executor::ExecutorContext> executor_context(
         BuildExecutorContext(params, txn));
+  executor_context->SetQueryProfile(profile);
+
+  Timer<std::ratio<1, 1000>> timer;
+  if (profile != nullptr) {
+    timer.Start();
+  }
+
+  // With tiered compilation, a query the code generator supports is still
+  // interpreted until it has been compiled in the background
+  bool compile = FLAGS_codegen && codegen::QueryCompiler::IsSupported(*plan);
+  auto &tiered_compiler = codegen::TieredCompiler::GetInstance();
+  bool tiered = compile && tiered_compiler.IsEnabled();
+  if (tiered) {
+    compile = tiered_compiler.IsCompiled(*plan);
+  }
+
+  if (!compile) {
+    Timer<std::ratio<1, 1000>> interpreted_timer;
+    if (tiered) {
+      interpreted_timer.Start();
+    }
 
-  if (!FLAGS_codegen || !codegen::QueryCompiler::IsSupported(*plan)) {
     // Build the executor tree
     LOG_TRACE("Building the executor tree");
     std::unique_ptr<executor::AbstractExecutor> executor_tree(
@@ -122,6 +146,12 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
     // clean up executor tree
     CleanExecutorTree(executor_tree.get());
 
+    if (tiered && p_status.m_result == ResultType::SUCCESS) {
+      interpreted_timer.Stop();
+      tiered_compiler.RecordInterpreted(*plan,
+                                        interpreted_timer.GetDuration());
+    }
+
   } else {
     LOG_TRACE("Compiling and executing query ...");
 
@@ -138,7 +168,13 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
 
     // Compile the query
     codegen::QueryCompiler compiler;
-    auto query = compiler.Compile(*plan, consumer);
+    codegen::QueryCompiler::CompileStats stats;
+    auto query = compiler.Compile(*plan, consumer,
+                                  profile != nullptr ? &stats : nullptr,
+                                  profile);
+    if (profile != nullptr) {
+      profile->SetCompiled(stats.setup_ms, stats.ir_gen_ms, stats.jit_ms);
+    }
 
     // Execute the query
     query->Execute(*txn, executor_context.get(),
@@ -163,6 +199,11 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
     p_status.m_result_slots = nullptr;
   }
 
+  if (profile != nullptr) {
+    timer.Stop();
+    profile->SetExecutionTime(timer.GetDuration());
+  }
+
   return p_status;
 }
 
@@ -335,6 +376,11 @@ executor::AbstractExecutor *BuildExecutorTree(
           new executor::NestedLoopJoinExecutor(plan, executor_context);
       break;
 
+    case PlanNodeType::NESTLOOPINDEX:
+      LOG_TRACE("Adding Index Join Executor");
+      child_executor = new executor::IndexJoinExecutor(plan, executor_context);
+      break;
+
     case PlanNodeType::MERGEJOIN:
       LOG_TRACE("Adding Merge Join Executor");
       child_executor = new executor::MergeJoinExecutor(plan, executor_context);
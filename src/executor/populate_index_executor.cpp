@@ -10,18 +10,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "common/logger.h"
-#include "type/value.h"
-#include "executor/logical_tile.h"
 #include "executor/populate_index_executor.h"
 #include "executor/executor_context.h"
+#include "index/index.h"
 #include "planner/populate_index_plan.h"
-#include "expression/tuple_value_expression.h"
 #include "storage/data_table.h"
-#include "storage/tile.h"
 
 namespace peloton {
 namespace executor {
@@ -46,6 +45,7 @@ bool PopulateIndexExecutor::DInit() {
       GetPlanNode<planner::PopulateIndexPlan>();
   target_table_ = node.GetTable();
   column_ids_ = node.GetColumnIds();
+  index_name_ = node.GetIndexName();
   done_ = false;
 
   return true;
@@ -54,53 +54,36 @@ bool PopulateIndexExecutor::DInit() {
 bool PopulateIndexExecutor::DExecute() {
   LOG_TRACE("Populate Index Executor");
   PL_ASSERT(executor_context_ != nullptr);
-  auto current_txn = executor_context_->GetTransaction();
-  auto executor_pool = executor_context_->GetPool();
-  if (done_ == false) {
-    //Get the output from seq_scan
-    while (children_[0]->Execute()) {
-      child_tiles_.emplace_back(children_[0]->GetOutput());
-    }
-
-    if (child_tiles_.size() == 0) {
-      LOG_TRACE("PopulateIndex Executor : false -- no child tiles ");
-      return false;
-    }
-
-    auto target_table_schema = target_table_->GetSchema();
-
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
-
-    // Go over the logical tile and insert in the index the values
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        expression::ContainerTuple<LogicalTile> cur_tuple(tile, tuple_id);
-
-        // Materialize the logical tile tuple
-        for (oid_t column_itr = 0; column_itr < column_ids_.size();
-             column_itr++) {
-          type::Value val = (cur_tuple.GetValue(column_itr));
-          tuple->SetValue(column_ids_[column_itr], val, executor_pool);
-        }
+  if (done_ == true) {
+    LOG_TRACE("PopulateIndex Executor : false -- done ");
+    return false;
+  }
+  done_ = true;
 
-        ItemPointer location(tile->GetBaseTile(0)->GetTileGroup()->GetTileGroupId(),
-                             tuple_id);
+  // The child creates the index
+  children_[0]->Execute();
 
-        // insert tuple into the index.
-        ItemPointer *index_entry_ptr = nullptr;
-        target_table_->InsertInIndexes(tuple.get(), location, current_txn,
-                                       &index_entry_ptr);
-      }
+  std::shared_ptr<index::Index> index;
+  for (oid_t index_itr = 0; index_itr < target_table_->GetIndexCount();
+       index_itr++) {
+    auto table_index = target_table_->GetIndex(index_itr);
+    if (table_index != nullptr && table_index->GetName() == index_name_) {
+      index = table_index;
     }
-
-    done_ = true;
   }
-  LOG_TRACE("Populate Index Executor : false -- done ");
+  if (index == nullptr) {
+    LOG_TRACE("PopulateIndex Executor : false -- no index %s",
+              index_name_.c_str());
+    return false;
+  }
+
+  // Other transactions keep writing to the table while the index is built
+  size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  target_table_->BuildIndex(index.get(), 0, target_table_->GetTileGroupCount(),
+                            thread_count);
+
+  LOG_TRACE("PopulateIndex Executor : false -- built index %s",
+            index_name_.c_str());
   return false;
 }
 
@@ -0,0 +1,282 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_profile.cpp
+//
+// Identification: src/executor/query_profile.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/query_profile.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logger.h"
+#include "planner/abstract_plan.h"
+#include "util/string_util.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Hardware Counters
+//===--------------------------------------------------------------------===//
+
+/**
+ * The cycle and instruction counters of the calling thread, read through
+ * perf_event_open(2). They are unavailable when the kernel doesn't allow
+ * unprivileged access to the performance counters, or in most VMs.
+ */
+class HardwareCounters {
+ public:
+  HardwareCounters() {
+    cycles_fd_ = Open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (cycles_fd_ < 0) return;
+
+    instructions_fd_ = Open(PERF_COUNT_HW_INSTRUCTIONS, cycles_fd_);
+    if (instructions_fd_ < 0) {
+      close(cycles_fd_);
+      cycles_fd_ = -1;
+      return;
+    }
+
+    ioctl(cycles_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(cycles_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~HardwareCounters() {
+    if (instructions_fd_ >= 0) close(instructions_fd_);
+    if (cycles_fd_ >= 0) close(cycles_fd_);
+  }
+
+  bool IsAvailable() const { return cycles_fd_ >= 0; }
+
+  void Read(uint64_t &cycles, uint64_t &instructions) const {
+    // PERF_FORMAT_GROUP layout: { nr, values[nr] }
+    uint64_t values[3] = {0, 0, 0};
+    if (read(cycles_fd_, values, sizeof(values)) != sizeof(values)) {
+      cycles = instructions = 0;
+      return;
+    }
+    cycles = values[1];
+    instructions = values[2];
+  }
+
+ private:
+  static int Open(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    // This thread, on any CPU
+    return static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+  }
+
+  int cycles_fd_ = -1;
+  int instructions_fd_ = -1;
+};
+
+//===--------------------------------------------------------------------===//
+// Query Profile
+//===--------------------------------------------------------------------===//
+
+QueryProfile::QueryProfile(const planner::AbstractPlan *plan,
+                           bool hardware_counters)
+    : collect_hardware_counters_(hardware_counters) {
+  if (plan != nullptr) {
+    AddOperator(plan, 0);
+  }
+}
+
+QueryProfile::~QueryProfile() {}
+
+void QueryProfile::AddOperator(const planner::AbstractPlan *plan,
+                               uint32_t depth) {
+  oid_t operator_id = static_cast<oid_t>(operators_.size());
+  operators_.emplace_back();
+  operators_.back().plan = plan;
+  operators_.back().depth = depth;
+  operators_.back().pipeline_id = INVALID_OID;
+  operator_ids_[plan] = operator_id;
+
+  for (auto &child : plan->GetChildren()) {
+    operators_[operator_id].children.push_back(
+        static_cast<oid_t>(operators_.size()));
+    AddOperator(child.get(), depth + 1);
+  }
+}
+
+oid_t QueryProfile::GetOperatorId(const planner::AbstractPlan *plan) const {
+  auto iter = operator_ids_.find(plan);
+  return iter == operator_ids_.end() ? INVALID_OID : iter->second;
+}
+
+void QueryProfile::StartOperator(oid_t operator_id) {
+  auto &op = operators_[operator_id];
+
+  if (collect_hardware_counters_) {
+    // Opened by the first operator, on the thread that runs the query
+    if (hardware_counters_ == nullptr) {
+      hardware_counters_.reset(new HardwareCounters());
+      if (hardware_counters_->IsAvailable() == false) {
+        LOG_DEBUG("Hardware counters are not available");
+        collect_hardware_counters_ = false;
+      }
+    }
+    if (collect_hardware_counters_) {
+      hardware_counters_->Read(op.start_cycles, op.start_instructions);
+    }
+  }
+
+  op.start_time = std::chrono::steady_clock::now();
+}
+
+void QueryProfile::StopOperator(oid_t operator_id) {
+  auto end_time = std::chrono::steady_clock::now();
+  auto &op = operators_[operator_id];
+
+  op.calls++;
+  op.time_ms += std::chrono::duration_cast<
+                    std::chrono::duration<double, std::milli>>(
+                    end_time - op.start_time).count();
+
+  if (collect_hardware_counters_) {
+    uint64_t cycles, instructions;
+    hardware_counters_->Read(cycles, instructions);
+    op.cycles += cycles - op.start_cycles;
+    op.instructions += instructions - op.start_instructions;
+  }
+}
+
+oid_t QueryProfile::AddPipeline(const std::string &info) {
+  pipelines_.push_back(info);
+  return static_cast<oid_t>(pipelines_.size()) - 1;
+}
+
+void QueryProfile::SetOperatorPipeline(oid_t operator_id, oid_t pipeline_id) {
+  operators_[operator_id].pipeline_id = pipeline_id;
+}
+
+void QueryProfile::SetCompiled(double setup_ms, double ir_gen_ms,
+                               double jit_ms) {
+  compiled_ = true;
+  setup_ms_ = setup_ms;
+  ir_gen_ms_ = ir_gen_ms;
+  jit_ms_ = jit_ms;
+}
+
+uint64_t QueryProfile::GetRowsIn(oid_t operator_id) const {
+  uint64_t rows_in = 0;
+  for (auto child_id : operators_[operator_id].children) {
+    // A child that never ran (e.g., the hash of a compiled hash join) passes
+    // on the rows of its own children
+    if (operators_[child_id].calls == 0) {
+      rows_in += GetRowsIn(child_id);
+    } else {
+      rows_in += operators_[child_id].rows_out;
+    }
+  }
+  return rows_in;
+}
+
+double QueryProfile::GetChildrenTime(oid_t operator_id) const {
+  double time_ms = 0.0;
+  for (auto child_id : operators_[operator_id].children) {
+    if (operators_[child_id].calls == 0) {
+      time_ms += GetChildrenTime(child_id);
+    } else {
+      time_ms += operators_[child_id].time_ms;
+    }
+  }
+  return time_ms;
+}
+
+double QueryProfile::GetExclusiveTime(oid_t operator_id) const {
+  return std::max(operators_[operator_id].time_ms - GetChildrenTime(operator_id),
+                  0.0);
+}
+
+std::vector<std::string> QueryProfile::GetReport(bool analyze) const {
+  std::vector<std::string> lines;
+
+  for (oid_t operator_id = 0; operator_id < operators_.size(); operator_id++) {
+    auto &op = operators_[operator_id];
+    std::string line = StringUtil::Repeat("  ", op.depth);
+    if (op.depth > 0) line += "-> ";
+    line += PlanNodeTypeToString(op.plan->GetPlanNodeType());
+
+    if (analyze) {
+      if (op.pipeline_id != INVALID_OID) {
+        line += StringUtil::Format(" [pipeline %u]", op.pipeline_id);
+      }
+      line += StringUtil::Format(
+          "  (time=%.3f ms self=%.3f ms rows in=%lu out=%lu tiles=%lu "
+          "calls=%lu",
+          op.time_ms, GetExclusiveTime(operator_id), GetRowsIn(operator_id),
+          op.rows_out, op.tiles_out, op.calls);
+      if (hardware_counters_ != nullptr && collect_hardware_counters_) {
+        double ipc = (op.cycles == 0) ? 0.0 : static_cast<double>(
+                                                  op.instructions) /
+                                                  op.cycles;
+        line += StringUtil::Format(" cycles=%lu instructions=%lu ipc=%.2f",
+                                   op.cycles, op.instructions, ipc);
+      }
+      line += ")";
+    }
+    lines.push_back(line);
+  }
+
+  if (analyze == false) return lines;
+
+  // The pipelines of the compiled query: their operators' exclusive time,
+  // and the rows out of their last operator
+  for (oid_t pipeline_id = 0; pipeline_id < pipelines_.size(); pipeline_id++) {
+    double time_ms = 0.0;
+    uint64_t rows_out = 0;
+    bool last_operator = true;
+    for (oid_t operator_id = 0; operator_id < operators_.size();
+         operator_id++) {
+      if (operators_[operator_id].pipeline_id != pipeline_id) continue;
+      time_ms += GetExclusiveTime(operator_id);
+      // Operators are in preorder, so the first one ends the pipeline
+      if (last_operator) {
+        rows_out = operators_[operator_id].rows_out;
+        last_operator = false;
+      }
+    }
+    lines.push_back(StringUtil::Format("Pipeline %u: %s  (time=%.3f ms rows=%lu)",
+                                       pipeline_id,
+                                       pipelines_[pipeline_id].c_str(),
+                                       time_ms, rows_out));
+  }
+
+  if (compiled_) {
+    lines.push_back(StringUtil::Format(
+        "Execution: compiled (setup=%.3f ms ir_gen=%.3f ms jit=%.3f ms)",
+        setup_ms_, ir_gen_ms_, jit_ms_));
+  } else {
+    lines.push_back("Execution: interpreted");
+  }
+  lines.push_back(StringUtil::Format("Execution time: %.3f ms", execution_ms_));
+
+  return lines;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,13 +12,16 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include <map>
 #include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
 
+#include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
+#include "common/numa.h"
 #include "type/value_factory.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
@@ -31,9 +34,11 @@
 #include "expression/constant_value_expression.h"
 #include "expression/comparison_expression.h"
 #include "planner/create_plan.h"
+#include "storage/compressed_column.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
+#include "storage/tuple.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -68,6 +73,14 @@ bool SeqScanExecutor::DInit() {
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
+    // Read the tile groups of our own socket first
+    tile_group_order_.clear();
+    if (target_table_->GetNumaNodeCount() > 0) {
+      tile_group_order_ = target_table_->GetNumaScanOrder(
+          table_tile_group_count_,
+          NumaTopology::GetInstance().GetCurrentNode());
+    }
+
     if (column_ids_.empty()) {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
@@ -142,6 +155,14 @@ bool SeqScanExecutor::DExecute() {
 
     PL_ASSERT(target_table_ != nullptr);
     PL_ASSERT(column_ids_.size() > 0);
+
+    // return the versions of the previous tile group first.
+    if (version_outputs_.empty() == false) {
+      SetOutput(version_outputs_.back().release());
+      version_outputs_.pop_back();
+      return true;
+    }
+
     if (children_.size() > 0 && !index_done_) {
       children_[0]->Execute();
       // This stops continuous executions due to
@@ -155,28 +176,147 @@ bool SeqScanExecutor::DExecute() {
 
     bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
     auto current_txn = executor_context_->GetTransaction();
+    bool has_version_store = target_table_->HasVersionStore();
 
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
+      auto tile_group_offset = tile_group_order_.empty()
+                                   ? current_tile_group_offset_
+                                   : tile_group_order_[current_tile_group_offset_];
+      current_tile_group_offset_++;
+      auto tile_group = target_table_->GetTileGroup(tile_group_offset);
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+      // If the tile group is frozen, try to evaluate the predicate directly
+      // on the compressed columns.
+      bool compressed_predicate = false;
+      std::vector<bool> compressed_matches;
+      if (predicate_ != nullptr && tile_group->IsFrozen()) {
+        auto compressed_tile_group = tile_group->GetCompressedTileGroup();
+        if (compressed_tile_group != nullptr &&
+            compressed_tile_group->GetTupleCount() == active_tuple_count) {
+          compressed_matches.resize(active_tuple_count, true);
+          compressed_predicate = EvaluateCompressedPredicate(
+              compressed_tile_group.get(), predicate_, compressed_matches);
+        }
+      }
+
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
+
+      // the versions that are newer than their tuple slots.
+      std::shared_ptr<storage::Tile> version_tile;
+      std::vector<oid_t> version_position_list;
+
+      // the visible versions in the version store, by version tile group.
+      std::map<oid_t, std::vector<oid_t>> stored_position_lists;
+
       for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
-        auto visibility = transaction_manager.IsVisible(
-            current_txn, tile_group_header, tuple_id);
+        // only the tuples that have been updated need to walk their version
+        // chain into the version store.
+        bool has_newer_versions =
+            has_version_store == true &&
+            tile_group_header->GetPrevItemPointer(tuple_id).IsNull() == false;
+
+        // skip tuples that failed the predicate on the compressed columns,
+        // unless a newer version is kept in delta records or in the version
+        // store.
+        if (compressed_predicate == true &&
+            compressed_matches[tuple_id] == false &&
+            tile_group_header->GetDeltaRecord(tuple_id) == nullptr &&
+            has_newer_versions == false) {
+          continue;
+        }
+
+        if (has_newer_versions == true) {
+          ItemPointer visible = FindVisibleVersion(tile_group_header, location);
+          if (visible.IsNull() == true) {
+            continue;
+          }
 
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
+          if (visible.block != location.block) {
+            auto version_tile_group =
+                catalog::Manager::GetInstance().GetTileGroup(visible.block);
+            expression::ContainerTuple<storage::TileGroup> version(
+                version_tile_group.get(), visible.offset);
+            if (predicate_ != nullptr &&
+                predicate_->Evaluate(&version, nullptr, executor_context_)
+                        .IsTrue() == false) {
+              continue;
+            }
+            stored_position_lists[visible.block].push_back(visible.offset);
+            auto res = transaction_manager.PerformRead(current_txn, visible,
+                                                       acquire_owner);
+            if (!res) {
+              transaction_manager.SetTransactionResult(current_txn,
+                                                       ResultType::FAILURE);
+              return res;
+            }
+            continue;
+          }
+
+          // the tuple slot itself is visible.
+          if (compressed_predicate == true &&
+              compressed_matches[tuple_id] == false) {
+            continue;
+          }
+        } else {
+          auto visibility = transaction_manager.IsVisible(
+              current_txn, tile_group_header, tuple_id);
+
+          // check transaction visibility
+          if (visibility != VisibilityType::OK) {
+            continue;
+          }
+        }
+
+        auto delta_record = transaction_manager.GetVisibleDelta(
+            current_txn, tile_group_header, tuple_id);
+        if (delta_record != nullptr) {
+          // rebuild the visible version and evaluate the predicate on it.
+          if (version_tile == nullptr) {
+            version_tile = LogicalTileFactory::GetVersionTile(tile_group);
+          }
+          storage::Tuple version(version_tile->GetSchema(),
+                                 version_tile->GetTupleLocation(tuple_id));
+          tile_group->ReconstructTuple(tuple_id, delta_record, &version,
+                                       version_tile->GetPool());
+          if (predicate_ != nullptr &&
+              predicate_->Evaluate(&version, nullptr, executor_context_)
+                      .IsTrue() == false) {
+            continue;
+          }
+          version_position_list.push_back(tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return res;
+          }
+        } else if (predicate_ == nullptr || compressed_predicate == true) {
           // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
+          position_list.push_back(tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     ResultType::FAILURE);
+            return res;
+          }
+        } else {
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), tuple_id);
+          LOG_TRACE("Evaluate predicate for a tuple");
+          auto eval =
+              predicate_->Evaluate(&tuple, nullptr, executor_context_);
+          LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+          if (eval.IsTrue()) {
             position_list.push_back(tuple_id);
             auto res = transaction_manager.PerformRead(current_txn, location,
                                                        acquire_owner);
@@ -184,32 +324,34 @@ bool SeqScanExecutor::DExecute() {
               transaction_manager.SetTransactionResult(current_txn,
                                                        ResultType::FAILURE);
               return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location,
-                                                         acquire_owner);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn,
-                                                         ResultType::FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
+            } else {
+              LOG_TRACE("Sequential Scan Predicate Satisfied");
             }
           }
         }
       }
 
+      if (version_position_list.size() != 0) {
+        version_outputs_.emplace_back(LogicalTileFactory::WrapVersionTile(
+            version_tile, column_ids_, std::move(version_position_list)));
+      }
+
+      for (auto &stored_position_list : stored_position_lists) {
+        std::unique_ptr<LogicalTile> stored_tile(LogicalTileFactory::GetTile());
+        stored_tile->AddColumns(catalog::Manager::GetInstance().GetTileGroup(
+                                    stored_position_list.first),
+                                column_ids_);
+        stored_tile->AddPositionList(std::move(stored_position_list.second));
+        version_outputs_.push_back(std::move(stored_tile));
+      }
+
       // Don't return empty tiles
       if (position_list.size() == 0) {
+        if (version_outputs_.empty() == false) {
+          SetOutput(version_outputs_.back().release());
+          version_outputs_.pop_back();
+          return true;
+        }
         continue;
       }
 
@@ -227,6 +369,106 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+// Walk the version chain of an updated tuple from its head, and return the
+// version that the transaction sees, or a null location if there is none.
+ItemPointer SeqScanExecutor::FindVisibleVersion(
+    const storage::TileGroupHeader *tile_group_header,
+    const ItemPointer &tuple_location) const {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  ItemPointer *indirection =
+      tile_group_header->GetIndirection(tuple_location.offset);
+  ItemPointer location = (indirection != nullptr) ? *indirection
+                                                  : tuple_location;
+
+  while (location.IsNull() == false) {
+    auto tile_group = manager.GetTileGroup(location.block);
+    if (tile_group == nullptr) {
+      break;
+    }
+    auto version_header = tile_group->GetHeader();
+
+    auto visibility = transaction_manager.IsVisible(current_txn, version_header,
+                                                    location.offset);
+    if (visibility == VisibilityType::OK) {
+      return location;
+    } else if (visibility == VisibilityType::DELETED) {
+      break;
+    }
+
+    location = version_header->GetNextItemPointer(location.offset);
+  }
+  return INVALID_ITEMPOINTER;
+}
+
+// Evaluate the predicate on the compressed columns of a frozen tile group.
+// Only conjunctions of comparisons between a column and a constant are
+// supported. Returns false if (part of) the predicate cannot be evaluated on
+// the compressed columns.
+bool SeqScanExecutor::EvaluateCompressedPredicate(
+    const storage::CompressedTileGroup *compressed_tile_group,
+    const expression::AbstractExpression *predicate,
+    std::vector<bool> &matches) const {
+  auto expr_type = predicate->GetExpressionType();
+
+  if (expr_type == ExpressionType::CONJUNCTION_AND) {
+    return EvaluateCompressedPredicate(compressed_tile_group,
+                                       predicate->GetChild(0), matches) &&
+           EvaluateCompressedPredicate(compressed_tile_group,
+                                       predicate->GetChild(1), matches);
+  }
+
+  if (predicate->GetChildrenSize() != 2) {
+    return false;
+  }
+
+  auto left = predicate->GetChild(0);
+  auto right = predicate->GetChild(1);
+
+  // Normalize to "column <comparison> constant"
+  if (left->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+      right->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    switch (expr_type) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        expr_type = ExpressionType::COMPARE_GREATERTHAN;
+        break;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        expr_type = ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        expr_type = ExpressionType::COMPARE_LESSTHAN;
+        break;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        expr_type = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      right->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+
+  auto column_id =
+      static_cast<const expression::TupleValueExpression *>(left)
+          ->GetColumnId();
+  auto column = compressed_tile_group->GetColumn(column_id);
+  if (column == nullptr) {
+    return false;
+  }
+
+  auto constant =
+      static_cast<const expression::ConstantValueExpression *>(right)
+          ->GetValue();
+  return column->EvaluatePredicate(expr_type, constant, matches);
+}
+
 // Update Predicate expression
 // this is used in the NLJoin executor
 void SeqScanExecutor::UpdatePredicate(const std::vector<oid_t> &column_ids,
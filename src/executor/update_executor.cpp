@@ -20,6 +20,7 @@
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
+#include "storage/delta_record.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
 
@@ -101,7 +102,20 @@ bool UpdateExecutor::PerformUpdatePrimaryKey(bool is_owner,
   expression::ContainerTuple<storage::TileGroup> old_tuple(tile_group,
                                                            physical_tuple_id);
 
-  project_info_->Evaluate(&new_tuple, &old_tuple, nullptr, executor_context_);
+  if (target_table_->IsDeltaVersioning() == true) {
+    // the tuple slot may hold an older version than the visible one.
+    storage::Tuple delta_tuple(target_table_schema, true);
+    tile_group->ReconstructTuple(
+        physical_tuple_id,
+        transaction_manager.GetVisibleDelta(current_txn, tile_group_header,
+                                            physical_tuple_id),
+        &delta_tuple, executor_context_->GetPool());
+    project_info_->Evaluate(&new_tuple, &delta_tuple, nullptr,
+                            executor_context_);
+  } else {
+    project_info_->Evaluate(&new_tuple, &old_tuple, nullptr,
+                            executor_context_);
+  }
 
   // insert tuple into the table.
   ItemPointer *index_entry_ptr = nullptr;
@@ -121,6 +135,62 @@ bool UpdateExecutor::PerformUpdatePrimaryKey(bool is_owner,
   return true;
 }
 
+bool UpdateExecutor::PerformDeltaUpdate(bool is_owner,
+                                        storage::TileGroup *tile_group,
+                                        storage::TileGroupHeader *tile_group_header,
+                                        oid_t physical_tuple_id,
+                                        ItemPointer &old_location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto current_txn = executor_context_->GetTransaction();
+
+  auto target_table_schema = target_table_->GetSchema();
+
+  // rebuild the visible version, which may be newer than the tuple slot.
+  storage::Tuple old_tuple(target_table_schema, true);
+  tile_group->ReconstructTuple(
+      physical_tuple_id,
+      transaction_manager.GetVisibleDelta(current_txn, tile_group_header,
+                                          physical_tuple_id),
+      &old_tuple, executor_context_->GetPool());
+
+  storage::Tuple new_tuple(target_table_schema, true);
+  project_info_->Evaluate(&new_tuple, &old_tuple, nullptr, executor_context_);
+
+  // the delta record only keeps the columns the update assigns.
+  auto &target_list = project_info_->GetTargetList();
+  std::vector<oid_t> column_ids;
+  column_ids.reserve(target_list.size());
+  for (auto &target : target_list) {
+    column_ids.push_back(target.first);
+  }
+
+  // the tuple keeps its slot, so the secondary indexes point to the same
+  // version chain.
+  ItemPointer *indirection =
+      tile_group_header->GetIndirection(old_location.offset);
+  if (target_table_->InstallVersion(&new_tuple, &target_list, current_txn,
+                                    indirection) == false) {
+    LOG_TRACE("Fail to insert new tuple. Set txn failure.");
+    if (is_owner == false) {
+      // If the ownership is acquire inside this update executor, we
+      // release it here
+      transaction_manager.YieldOwnership(current_txn, tile_group_header,
+                                         physical_tuple_id);
+    }
+    transaction_manager.SetTransactionResult(current_txn,
+                                             ResultType::FAILURE);
+    return false;
+  }
+
+  transaction_manager.PerformDeltaUpdate(
+      current_txn, old_location,
+      new storage::DeltaRecord(&new_tuple, column_ids));
+
+  return true;
+}
+
 /**
  * @brief updates a set of columns
  * @return true on success, false otherwise.
@@ -263,6 +333,16 @@ bool UpdateExecutor::DExecute() {
           }
         }
 
+        // Normal update of a table that keeps delta versions
+        else if (target_table_->IsDeltaVersioning() == true) {
+          ret = PerformDeltaUpdate(is_owner, tile_group, tile_group_header,
+                                   physical_tuple_id, old_location);
+          if (ret == false) {
+            return false;
+          }
+          executor_context_->num_processed += 1;  // updated one
+        }
+
         // Normal update (no primary key)
         else {
           // if it is the latest version and not locked by other threads, then
@@ -12,13 +12,18 @@
 
 #include "gc/transaction_level_gc_manager.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "storage/tuple.h"
 #include "storage/database.h"
+#include "storage/delta_record.h"
 #include "storage/tile_group.h"
 #include "catalog/manager.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "concurrency/epoch_manager_factory.h"
 #include "common/container_tuple.h"
+#include "common/numa.h"
 
 namespace peloton {
 namespace gc {
@@ -29,26 +34,45 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
 
   auto tile_group_header = tile_group->GetHeader();
 
+  // The layout tuner claims the garbage of a tile group it copies. Own the
+  // slot until it is reset, so that it is not claimed while its varlen values
+  // are freed.
+  txn_id_t txn_id = tile_group_header->GetTransactionId(location.offset);
+  if ((txn_id != INITIAL_TXN_ID && txn_id != INVALID_TXN_ID) ||
+      tile_group_header->SetAtomicTransactionId(location.offset, txn_id,
+                                                MAX_TXN_ID) != txn_id) {
+    return false;
+  }
+
   // Reset the header
-  tile_group_header->SetTransactionId(location.offset, INVALID_TXN_ID);
   tile_group_header->SetBeginCommitId(location.offset, MAX_CID);
   tile_group_header->SetEndCommitId(location.offset, MAX_CID);
   tile_group_header->SetPrevItemPointer(location.offset, INVALID_ITEMPOINTER);
   tile_group_header->SetNextItemPointer(location.offset, INVALID_ITEMPOINTER);
+  tile_group_header->SetIndirection(location.offset, nullptr);
 
   PL_MEMSET(tile_group_header->GetReservedFieldRef(location.offset), 0,
             storage::TileGroupHeader::GetReservedSize());
 
+  tile_group->FreeDeltaRecords(location.offset);
+
   // Reclaim the varlen pool
   CheckAndReclaimVarlenColumns(tile_group, location.offset);
 
+  COMPILER_MEMORY_FENCE;
+
+  tile_group_header->SetTransactionId(location.offset, INVALID_TXN_ID);
+
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
 }
 
 void TransactionLevelGCManager::Running(const int &thread_id) {
   PL_ASSERT(is_running_ == true);
+  NumaTopology::GetInstance().PinThread(thread_id);
+
   uint32_t backoff_shifts = 0;
+  auto idle_check_time = std::chrono::steady_clock::now();
   while (true) {
     auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
     
@@ -64,6 +88,15 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
     int unlinked_count = Unlink(thread_id, expired_eid);
 
+    reclaimed_count += RetryPendingAnchors(thread_id, expired_eid);
+
+    if (thread_id == 0 &&
+        std::chrono::steady_clock::now() - idle_check_time >=
+            std::chrono::milliseconds(FREE_SLOT_IDLE_PERIOD_MS)) {
+      ReturnIdleFreeSlots();
+      idle_check_time = std::chrono::steady_clock::now();
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -90,6 +123,15 @@ void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<GCSet> gc_set
   unlink_queues_[HashToThread(thread_id)]->Enqueue(gc_context);
 }
 
+void TransactionLevelGCManager::RecycleDeltaRecords(
+    std::shared_ptr<DeltaSet> delta_set, const eid_t &epoch_id,
+    const size_t &thread_id) {
+  // the delta records pass through the same two phases as the old versions.
+  std::shared_ptr<GarbageContext> gc_context(
+      new GarbageContext(delta_set, epoch_id));
+  unlink_queues_[HashToThread(thread_id)]->Enqueue(gc_context);
+}
+
 int TransactionLevelGCManager::Unlink(const int &thread_id, const eid_t &expired_eid) {
   
   int tuple_counter = 0;
@@ -145,6 +187,9 @@ int TransactionLevelGCManager::Unlink(const int &thread_id, const eid_t &expired
   eid_t safe_expired_eid = concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
 
   for(auto& item : garbages){
+      if (item->delta_set_ != nullptr) {
+        FoldDeltaRecords(item, expired_eid);
+      }
       reclaim_maps_[thread_id].insert(std::make_pair(safe_expired_eid, item));
   }
   LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
@@ -164,7 +209,7 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const eid_t &expire
     // if the global expired epoch id is no less than the garbage version's epoch id,
     // then recycle the garbage version
     if (garbage_eid <= expired_eid) {
-      AddToRecycleMap(garbage_ctx);
+      AddToRecycleMap(garbage_ctx, thread_id, expired_eid);
 
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
@@ -180,7 +225,17 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id, const eid_t &expire
 
 // Multiple GC thread share the same recycle map
 void TransactionLevelGCManager::AddToRecycleMap(
-    std::shared_ptr<GarbageContext> garbage_ctx) {
+    std::shared_ptr<GarbageContext> garbage_ctx, const int &thread_id,
+    const eid_t &expired_eid) {
+  if (garbage_ctx->delta_set_ != nullptr) {
+    FreeDeltaRecords(garbage_ctx);
+    return;
+  }
+
+  // the versions that are moved back into their tuple slots may still be
+  // read by the active transactions.
+  std::shared_ptr<GCSet> retired_versions(new GCSet());
+
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(entry.first);
@@ -199,40 +254,332 @@ void TransactionLevelGCManager::AddToRecycleMap(
 
     oid_t table_id = table->GetOid();
 
+    bool is_version_tile_group = tile_group->IsVersionTileGroup();
+    auto &table_recycle_queue_map =
+        is_version_tile_group ? version_recycle_queue_map_ : recycle_queue_map_;
+
     for (auto &element : entry.second) {
       // as this transaction has been committed, we should reclaim older
       // versions.
       ItemPointer location(entry.first, element.first);
 
-      // If the tuple being reset no longer exists, just skip it
+      if (table->HasVersionStore() == true) {
+        ItemPointer *indirection =
+            tile_group->GetHeader()->GetIndirection(element.first);
+
+        if (is_version_tile_group == true) {
+          // the tuple slot of the version's tuple may be waiting for it.
+          RetryPendingAnchor(table_id, indirection, expired_eid,
+                             *retired_versions);
+
+        } else if (element.second == false && indirection != nullptr) {
+          // an updated tuple keeps its slot, which receives the newest
+          // version once the older versions are no longer read.
+          if (FoldAnchor(table_id, location, expired_eid,
+                         *retired_versions) == false) {
+            std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+            pending_anchors_[table_id][indirection] = location;
+          }
+          continue;
+        }
+      }
+
+      // A slot held by the layout tuner is reset in a later pass
       if (ResetTuple(location) == false) {
+        (*retired_versions)[location.block][location.offset] = element.second;
         continue;
       }
       // if the entry for table_id exists.
-      if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
+      if (table_recycle_queue_map.find(table_id) !=
+          table_recycle_queue_map.end()) {
+        table_recycle_queue_map[table_id]->Enqueue(location);
       }
     }
   }
+
+  if (retired_versions->empty() == false) {
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    RecycleTransaction(retired_versions, epoch_manager.GetCurrentEpochId(),
+                       thread_id);
+  }
+}
+
+// move the newest version of a tuple into its tuple slot. returns false if
+// the tuple slot has to wait for the older versions to expire, or for the
+// layout tuner to release it.
+bool TransactionLevelGCManager::FoldAnchor(const oid_t &table_id,
+                                           const ItemPointer &anchor_location,
+                                           const eid_t &expired_eid,
+                                           GCSet &retired_versions) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  ItemPointer head_location;
+  if (txn_manager.FoldVersion(anchor_location, expired_eid, head_location) ==
+      false) {
+    return false;
+  }
+
+  if (head_location.IsNull() == true) {
+    // the tuple has been deleted, so its slot can be reused.
+    if (ResetTuple(anchor_location) == false) {
+      return false;
+    }
+    if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+      recycle_queue_map_[table_id]->Enqueue(anchor_location);
+    }
+  } else if (head_location.block != anchor_location.block ||
+             head_location.offset != anchor_location.offset) {
+    retired_versions[head_location.block][head_location.offset] = false;
+  }
+
+  LOG_TRACE("Folded tuple(%u, %u)", anchor_location.block,
+            anchor_location.offset);
+  return true;
+}
+
+void TransactionLevelGCManager::RetryPendingAnchor(const oid_t &table_id,
+                                                   ItemPointer *indirection,
+                                                   const eid_t &expired_eid,
+                                                   GCSet &retired_versions) {
+  if (indirection == nullptr) {
+    return;
+  }
+
+  ItemPointer anchor_location;
+  {
+    std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+    auto table_entry = pending_anchors_.find(table_id);
+    if (table_entry == pending_anchors_.end()) {
+      return;
+    }
+    auto anchor_entry = table_entry->second.find(indirection);
+    if (anchor_entry == table_entry->second.end()) {
+      return;
+    }
+    anchor_location = anchor_entry->second;
+    table_entry->second.erase(anchor_entry);
+  }
+
+  if (FoldAnchor(table_id, anchor_location, expired_eid, retired_versions) ==
+      false) {
+    std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+    pending_anchors_[table_id][indirection] = anchor_location;
+  }
+}
+
+int TransactionLevelGCManager::RetryPendingAnchors(const int &thread_id,
+                                                   const eid_t &expired_eid) {
+  // a fold only fails while the newest version is too young, or is being
+  // written. both change at the earliest once another epoch has expired.
+  std::unordered_map<oid_t, std::unordered_map<ItemPointer *, ItemPointer>>
+      anchors;
+  {
+    std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+    if (pending_anchors_.empty() == true ||
+        expired_eid == pending_anchors_eid_) {
+      return 0;
+    }
+    pending_anchors_eid_ = expired_eid;
+    anchors.swap(pending_anchors_);
+  }
+
+  int fold_count = 0;
+  GCSet retired_versions;
+  for (auto &table_entry : anchors) {
+    for (auto &anchor_entry : table_entry.second) {
+      if (FoldAnchor(table_entry.first, anchor_entry.second, expired_eid,
+                     retired_versions) == true) {
+        fold_count++;
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+      // the table may have been dropped meanwhile.
+      if (recycle_queue_map_.find(table_entry.first) !=
+          recycle_queue_map_.end()) {
+        pending_anchors_[table_entry.first].insert(anchor_entry);
+      }
+    }
+  }
+
+  if (retired_versions.empty() == false) {
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    RecycleTransaction(std::make_shared<GCSet>(std::move(retired_versions)),
+                       epoch_manager.GetCurrentEpochId(), thread_id);
+  }
+
+  LOG_TRACE("Folded %d pending tuple slots", fold_count);
+  return fold_count;
+}
+
+// write the expired delta records into their tuple slots. the detached
+// records stay with the garbage context until it is reclaimed.
+void TransactionLevelGCManager::FoldDeltaRecords(
+    const std::shared_ptr<GarbageContext> &garbage_ctx,
+    const eid_t &expired_eid) {
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &entry : *(garbage_ctx->delta_set_.get())) {
+    auto tile_group = manager.GetTileGroup(entry.first);
+
+    // the table may have been dropped meanwhile.
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    for (auto tuple_slot : entry.second) {
+      auto delta_record = tile_group->FoldDeltaRecords(tuple_slot, expired_eid);
+      if (delta_record != nullptr) {
+        garbage_ctx->delta_records_.push_back(delta_record);
+      }
+    }
+  }
+}
+
+void TransactionLevelGCManager::FreeDeltaRecords(
+    const std::shared_ptr<GarbageContext> &garbage_ctx) {
+  for (auto delta_record : garbage_ctx->delta_records_) {
+    while (delta_record != nullptr) {
+      auto next_record = delta_record->next;
+      delete delta_record;
+      delta_record = next_record;
+    }
+  }
+  garbage_ctx->delta_records_.clear();
+}
+
+thread_local TransactionLevelGCManager::LocalFreeSlots
+    TransactionLevelGCManager::local_free_slots_;
+
+TransactionLevelGCManager::LocalFreeSlots::LocalFreeSlots()
+    : used(false), table_version(0) {
+  auto &gc_manager = TransactionLevelGCManager::GetInstance();
+  std::lock_guard<std::mutex> lock(gc_manager.local_free_slot_caches_mutex_);
+  gc_manager.local_free_slot_caches_.push_back(this);
+}
+
+// a thread that exits hands the slots it did not use back to the tables.
+TransactionLevelGCManager::LocalFreeSlots::~LocalFreeSlots() {
+  auto &gc_manager = TransactionLevelGCManager::GetInstance();
+  {
+    std::lock_guard<std::mutex> lock(gc_manager.local_free_slot_caches_mutex_);
+    auto &caches = gc_manager.local_free_slot_caches_;
+    caches.erase(std::find(caches.begin(), caches.end(), this));
+  }
+
+  for (auto &entry : free_slot_map) {
+    if (entry.second.empty() == false) {
+      gc_manager.FlushFreeSlots(free_slot_map);
+      return;
+    }
+  }
 }
 
 // this function returns a free tuple slot, if one exists
 // called by data_table.
 ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
-  // for catalog tables, we directly return invalid item pointer.
-  if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
+  auto &local_free_slots = local_free_slots_;
+  std::lock_guard<std::mutex> lock(local_free_slots.mutex);
+  local_free_slots.used = true;
+
+  auto table_version = table_version_.load();
+  if (local_free_slots.table_version != table_version) {
+    FlushFreeSlots(local_free_slots.free_slot_map);
+    local_free_slots.table_version = table_version;
+  }
+
+  auto &free_slots = local_free_slots.free_slot_map[table_id];
+  if (free_slots.empty() == true &&
+      RefillFreeSlots(table_id, free_slots) == false) {
+    return INVALID_ITEMPOINTER;
+  }
+
+  ItemPointer location = free_slots.back();
+  free_slots.pop_back();
+  LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
+            location.offset, table_id);
+  return location;
+}
+
+// the versions are placed in the version tile groups one at a time, so
+// their slots are not cached by the threads.
+ItemPointer TransactionLevelGCManager::ReturnFreeVersionSlot(
+    const oid_t &table_id) {
+  auto recycle_queue_entry = version_recycle_queue_map_.find(table_id);
+  if (recycle_queue_entry == version_recycle_queue_map_.end()) {
     return INVALID_ITEMPOINTER;
   }
+
   ItemPointer location;
-  PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
-  auto recycle_queue = recycle_queue_map_[table_id];
+  if (recycle_queue_entry->second->Dequeue(location) == false) {
+    return INVALID_ITEMPOINTER;
+  }
+  LOG_TRACE("Reuse version(%u, %u) in table %u", location.block,
+            location.offset, table_id);
+  return location;
+}
+
+// take a batch of free slots from the recycle queue of the table.
+bool TransactionLevelGCManager::RefillFreeSlots(
+    const oid_t &table_id, std::vector<ItemPointer> &free_slots) {
+  // for catalog tables, there is no recycle queue.
+  auto recycle_queue_entry = recycle_queue_map_.find(table_id);
+  if (recycle_queue_entry == recycle_queue_map_.end()) {
+    return false;
+  }
+
+  free_slots.resize(FREE_SLOT_BATCH_SIZE);
+  auto slot_count = recycle_queue_entry->second->DequeueBulk(
+      free_slots.data(), FREE_SLOT_BATCH_SIZE);
+  free_slots.resize(slot_count);
+
+  if (slot_count == 0) {
+    return false;
+  }
 
-  if (recycle_queue->Dequeue(location) == true) {
-    LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
-              location.offset, table_id);
-    return location;
+  // slots are handed out from the back. sort the batch so that the oldest
+  // tile group is filled up first, and its slots are filled in order.
+  std::sort(free_slots.begin(), free_slots.end(),
+            [](const ItemPointer &lhs, const ItemPointer &rhs) {
+              return lhs.block > rhs.block ||
+                     (lhs.block == rhs.block && lhs.offset > rhs.offset);
+            });
+  return true;
+}
+
+size_t TransactionLevelGCManager::ReturnIdleFreeSlots() {
+  size_t slot_count = 0;
+  std::lock_guard<std::mutex> lock(local_free_slot_caches_mutex_);
+  for (auto local_free_slots : local_free_slot_caches_) {
+    // the thread is taking a slot right now
+    std::unique_lock<std::mutex> cache_lock(local_free_slots->mutex,
+                                            std::try_to_lock);
+    if (cache_lock.owns_lock() == false) {
+      continue;
+    }
+    if (local_free_slots->used == true) {
+      local_free_slots->used = false;
+      continue;
+    }
+
+    for (auto &entry : local_free_slots->free_slot_map) {
+      slot_count += entry.second.size();
+    }
+    FlushFreeSlots(local_free_slots->free_slot_map);
+  }
+  return slot_count;
+}
+
+// give the cached slots back to the tables that still exist.
+void TransactionLevelGCManager::FlushFreeSlots(
+    std::unordered_map<oid_t, std::vector<ItemPointer>> &free_slot_map) {
+  for (auto &entry : free_slot_map) {
+    auto recycle_queue_entry = recycle_queue_map_.find(entry.first);
+    if (recycle_queue_entry != recycle_queue_map_.end()) {
+      for (auto &location : entry.second) {
+        recycle_queue_entry->second->Enqueue(location);
+      }
+    }
   }
-  return INVALID_ITEMPOINTER;
+  free_slot_map.clear();
 }
 
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
@@ -158,6 +158,9 @@ class configuration {
   // epoch type
   EpochType epoch;
 
+  // conflict avoidance
+  ConflictAvoidanceType conflict;
+
   // scale factor
   double scale_factor;
 
@@ -94,6 +94,9 @@ struct Configuration {
   // Do we dictionary encode strings?
   bool dictionary_encode = true;
 
+  // Do hash joins always partition their inputs?
+  bool radix_join = false;
+
   // Which queries will the benchmark run?
   bool queries_to_run[22] = {false};
 
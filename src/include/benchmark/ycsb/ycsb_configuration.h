@@ -43,6 +43,9 @@ class configuration {
   // epoch type
   EpochType epoch;
 
+  // concurrency control protocol
+  ProtocolType protocol;
+
   // size of the table
   int scale_factor;
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -33,6 +34,24 @@ namespace brain {
 // Layout Tuner
 //===--------------------------------------------------------------------===//
 
+/**
+ * Background task that derives the default layout of each table from its
+ * layout samples, and moves the existing tile groups over to that layout.
+ *
+ * Tile groups are transformed online, a few per round, walking each table
+ * from where the last round stopped. Only cold tile groups (see
+ * TileGroupFreezer::IsFreezable) are transformed. The tuner locks the latest
+ * versions like an updating transaction would, and claims the empty slots
+ * and the expired older versions. It then copies the tile group into the new
+ * layout, and installs the copy under the same tile group id in the catalog.
+ * The versions of the replaced tile group stay locked, so that transactions
+ * that still hold on to it fail to modify them instead of losing their
+ * changes.
+ *
+ * Empty slots are written without being owned. A tile group is therefore
+ * reserved first (see TileGroup::ReserveTransform), and only transformed once
+ * the transactions that may have found it unreserved are done.
+ */
 class LayoutTuner {
  public:
   LayoutTuner(const LayoutTuner &) = delete;
@@ -62,16 +81,34 @@ class LayoutTuner {
   // Clear list
   void ClearTables();
 
+  // Transform the next cold tile groups of the table into its default
+  // layout, within the budget of a tuning round.
+  // Returns the number of tile groups that were transformed.
+  oid_t TransformTable(storage::DataTable *table, const cid_t expired_cid);
+
   std::string GetColumnMapInfo(const column_map_type &column_map);
 
+  size_t GetTransformedTileGroupCount() const {
+    return transformed_tile_group_count;
+  }
+
  protected:
   // Update layout of table
   void UpdateDefaultPartition(storage::DataTable *table);
 
+  // Transform a single tile group, if it is cold and not yet in the default
+  // layout. Returns true if the tile group was replaced.
+  bool TransformTileGroup(storage::DataTable *table,
+                          const oid_t tile_group_offset,
+                          const cid_t expired_cid);
+
  private:
   // Tables whose layout must be tuned
   std::vector<storage::DataTable *> tables;
 
+  // Offset of the next tile group to inspect in each table
+  std::map<storage::DataTable *, oid_t> next_tile_group_offsets;
+
   std::mutex layout_tuner_mutex;
 
   // Stop signal
@@ -80,6 +117,8 @@ class LayoutTuner {
   // Tuner thread
   std::thread layout_tuner_thread;
 
+  std::atomic<size_t> transformed_tile_group_count;
+
   //===--------------------------------------------------------------------===//
   // Tuner Parameters
   //===--------------------------------------------------------------------===//
@@ -105,6 +144,14 @@ class LayoutTuner {
   // Desired layout tile count
   oid_t tile_count = 2;
 
+  // Tile groups inspected per table in each round
+  oid_t inspect_budget = 16;
+
+  // Tile groups transformed per table in each round. Transactions that touch
+  // a tile group while it is copied wait or abort, so this bounds the
+  // interference with the workload.
+  oid_t transform_budget = 1;
+
 };
 
 }  // End brain namespace
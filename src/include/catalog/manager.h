@@ -62,6 +62,11 @@ class Manager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Same as GetTileGroup(), but does not record an access to a frozen tile
+  // group (see storage::TileGroup::RecordAccess). For background tasks that
+  // only inspect the tile group header.
+  std::shared_ptr<storage::TileGroup> InspectTileGroup(const oid_t oid);
+
   void ClearTileGroup(void);
 
 
@@ -35,6 +35,10 @@ class FunctionBuilder;
 // instance for every query we see.  We keep instances of these around in the
 // off-chance that we see a query that requires a function we've previously
 // JITed. In reality, this is a thin wrapper around an LLVM Module.
+//
+// Compiled code is shared through the ObjectCache with all contexts that
+// generate the same code, so names in the module must not depend on the ID of
+// the context.
 //===----------------------------------------------------------------------===//
 class CodeContext {
   friend class CodeGen;
@@ -73,6 +77,14 @@ class CodeContext {
   // Get the raw IR in text form
   std::string GetIR() const;
 
+  // Get the key of the compiled code in the object cache
+  std::string GetObjectKey() const;
+
+  // Version of the code generation, part of the object cache key. Bump it
+  // whenever the optimization passes or the way compiled code calls into
+  // the runtime change, so that stale cached objects are not loaded.
+  static constexpr uint32_t kCodegenVersion = 1;
+
   // Get the IR Builder
   llvm::IRBuilder<> &GetBuilder() { return builder_; }
 
@@ -30,6 +30,10 @@ namespace expression {
 class AbstractExpression;
 }  // namespace expression
 
+namespace executor {
+class QueryProfile;
+}  // namespace executor
+
 namespace planner {
 class AbstractPlan;
 }  // namespace planner
@@ -48,8 +52,10 @@ class CompilationContext {
   friend class RowBatch;
 
  public:
-  // Constructor
-  CompilationContext(Query &query, QueryResultConsumer &result_consumer);
+  // Constructor. When given a profile, the generated code reports the time
+  // and output of every operator into it.
+  CompilationContext(Query &query, QueryResultConsumer &result_consumer,
+                     executor::QueryProfile *profile = nullptr);
 
   // Prepare a translator in this context
   void Prepare(const planner::AbstractPlan &op, Pipeline &pipeline);
@@ -84,6 +90,12 @@ class CompilationContext {
   // Get a pointer to the executor context instance
   llvm::Value *GetExecutorContextPtr();
 
+  // Is the query compiled with profiling hooks?
+  bool IsProfiled() const { return profile_ != nullptr; }
+
+  // Count rows output by the given operator in the profile of the query
+  void CountRows(const OperatorTranslator *translator, llvm::Value *num_rows);
+
  private:
   // Generate any auxiliary helper functions that the query needs
   void GenerateHelperFunctions();
@@ -97,6 +109,9 @@ class CompilationContext {
   // Generate the tearDown() function of the query
   llvm::Function *GenerateTearDownFunction();
 
+  // Register the operators and pipelines of the query in the profile
+  void PrepareProfile();
+
   // Get the registered translator for the given operator/expression
   ExpressionTranslator *GetTranslator(
       const expression::AbstractExpression &exp) const;
@@ -130,6 +145,15 @@ class CompilationContext {
   // The mapping of an expression somewhere in the tree to its translator
   std::unordered_map<const expression::AbstractExpression *,
                      std::unique_ptr<ExpressionTranslator>> exp_translators_;
+
+  // The profile the query reports into, if any
+  executor::QueryProfile *profile_;
+
+  // The pipeline of every operator, and the ID of every translator in the
+  // profile (only when profiling)
+  std::unordered_map<const planner::AbstractPlan *, const Pipeline *>
+      op_pipelines_;
+  std::unordered_map<const OperatorTranslator *, oid_t> profile_op_ids_;
 };
 
 }  // namespace codegen
@@ -52,6 +52,11 @@ class ConsumerContext {
   // Get the pipeline
   const Pipeline &GetPipeline() const { return pipeline_; }
 
+ private:
+  // Count the output of the current operator in the profile of the query
+  void CountRows(RowBatch &batch);
+  void CountRow();
+
  private:
   // The compilation context
   CompilationContext &compilation_context_;
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// function_translator.h
+//
+// Identification: src/include/codegen/expression/function_translator.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "codegen/compilation_context.h"
+#include "codegen/expression/expression_translator.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator of calls to built-in functions, and of LIKE and NOT LIKE
+// comparisons. The common cases (SUBSTR, the string lengths, extracting the
+// fields of a timestamp and LIKE with a constant prefix pattern) are generated
+// inline. Everything else calls into the FunctionsRuntime.
+//
+// Only the built-in functions that don't produce a new string are supported,
+// since compiled queries have nowhere to allocate the result from.
+//===----------------------------------------------------------------------===//
+class FunctionTranslator : public ExpressionTranslator {
+ public:
+  // Constructor
+  FunctionTranslator(const expression::AbstractExpression &exp,
+                     CompilationContext &context);
+
+  // Produce the value that is the result of calling the function
+  codegen::Value DeriveValue(CodeGen &codegen,
+                             RowBatch::Row &row) const override;
+
+  // Can the given function or LIKE expression be compiled?
+  static bool IsSupported(const expression::AbstractExpression &exp);
+
+ private:
+  // The built-in functions we know how to translate
+  enum class Builtin {
+    Substr,
+    CharLength,
+    OctetLength,
+    Ascii,
+    Sqrt,
+    Extract,
+    Like,
+    NotLike,
+    Invalid
+  };
+
+  static Builtin GetBuiltin(const expression::AbstractExpression &exp);
+
+  // Generate the call of the built-in on the given (non-NULL) arguments
+  codegen::Value Substr(CodeGen &codegen,
+                        const std::vector<codegen::Value> &args) const;
+  codegen::Value Ascii(CodeGen &codegen,
+                       const std::vector<codegen::Value> &args) const;
+  codegen::Value Extract(CodeGen &codegen,
+                         const std::vector<codegen::Value> &args) const;
+  codegen::Value Like(CodeGen &codegen,
+                      const std::vector<codegen::Value> &args) const;
+
+ private:
+  // The built-in this expression calls
+  Builtin builtin_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
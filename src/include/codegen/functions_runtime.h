@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// functions_runtime.h
+//
+// Identification: src/include/codegen/functions_runtime.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <stdint.h>
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The built-in SQL functions that compiled query plans call instead of
+// generating code for them. Most of them forward to the implementations the
+// interpreted engine uses in expression/.
+//
+// Strings are passed as a pointer and a length. Strings from tables count
+// their null terminator in the length while strings created by the query
+// don't, so a trailing null terminator is never considered part of a string.
+//===----------------------------------------------------------------------===//
+class FunctionsRuntime {
+ public:
+  // Does the string match the SQL LIKE pattern?
+  static bool Like(const char *str, uint32_t str_len, const char *pattern,
+                   uint32_t pattern_len);
+
+  // EXTRACT(date_part FROM timestamp), see expression::DateFunctions
+  static double Extract(int32_t date_part, int64_t timestamp);
+
+  // SQRT(value), see expression::DecimalFunctions
+  static double Sqrt(double value);
+};
+
+}  // namespace codegen
+}  // namespace peloton
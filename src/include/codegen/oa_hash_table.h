@@ -35,6 +35,10 @@ class OAHashTable : public HashTable {
   // A global pointer for attribute hashes
   static const planner::AttributeInfo kHashAI;
 
+  // The space in front of every value that holds its match flag, if the hash
+  // table tracks matches. This keeps the values 8-byte aligned.
+  static constexpr uint32_t kMatchFlagSize = sizeof(uint64_t);
+
   //===--------------------------------------------------------------------===//
   // Convenience class providing a random access interface over the hash-table
   //===--------------------------------------------------------------------===//
@@ -60,7 +64,7 @@ class OAHashTable : public HashTable {
   // Constructor
   OAHashTable();
   OAHashTable(CodeGen &codegen, const std::vector<type::Type> &key_type,
-              uint64_t value_size);
+              uint64_t value_size, bool track_matches = false);
 
   void Init(CodeGen &codegen, llvm::Value *ht_ptr) const override;
 
@@ -103,6 +107,17 @@ class OAHashTable : public HashTable {
   void PrefetchBucket(CodeGen &codegen, llvm::Value *ht_ptr, llvm::Value *hash,
                       PrefetchType pf_type, Locality locality) const;
 
+  // Flag the value at the given address as matched, or check whether it is.
+  // Values start out unmatched when they are inserted. Only valid if the hash
+  // table tracks matches.
+  void MarkMatched(CodeGen &codegen, llvm::Value *value_ptr) const;
+  llvm::Value *IsMatched(CodeGen &codegen, llvm::Value *value_ptr) const;
+
+  // Remove all entries from the hash table, sizing it for the given number of
+  // entries (a 64-bit LLVM value)
+  void Reset(CodeGen &codegen, llvm::Value *ht_ptr,
+             llvm::Value *estimated_num_entries) const;
+
   // Destroy/cleanup the hash table whose address is stored in the given LLVM
   // register/value
   void Destroy(CodeGen &codegen, llvm::Value *ht_ptr) const override;
@@ -166,6 +181,12 @@ class OAHashTable : public HashTable {
   std::pair<llvm::Value *, llvm::Value *> GetDataCountAndPointer(
       CodeGen &codegen, llvm::Value *kv_p, llvm::Value *after_key_p) const;
 
+  // Skip the match flag (if any) of the value slot at the given address
+  llvm::Value *GetValuePtr(CodeGen &codegen, llvm::Value *slot_ptr) const;
+
+  // Prepare a freshly stored value slot, returning where the value goes
+  llvm::Value *InitValueSlot(CodeGen &codegen, llvm::Value *slot_ptr) const;
+
  private:
   // The storage format we use to store the keys inside HashEntrys
   CompactStorage key_storage_;
@@ -175,8 +196,11 @@ class OAHashTable : public HashTable {
   // and additions.
   uint64_t hash_entry_size_;
 
-  // The size of value
+  // The size of value, including the match flag
   uint64_t value_size_;
+
+  // Does every value carry a flag saying whether it found a join partner?
+  bool track_matches_;
 };
 
 }  // namespace codegen
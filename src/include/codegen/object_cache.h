@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// object_cache.h
+//
+// Identification: src/include/codegen/object_cache.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/cache.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A cache of the machine code compiled for queries, so that queries whose
+// code we've seen before don't pay for optimizing and JITing it again.
+//
+// Objects are keyed by a fingerprint of the code of the query and of the
+// engine that compiled it (see CodeContext). The most recently used objects
+// are kept in memory, and all objects are written to a directory on disk if
+// one is configured, so that they survive restarts. Objects on disk are only
+// read on first use.
+//===----------------------------------------------------------------------===//
+class ObjectCache {
+ public:
+  // The cache of this process
+  static ObjectCache &GetInstance();
+
+  // Is any of the in-memory and the on-disk caches enabled?
+  static bool IsEnabled();
+
+  // Find the object with the given key in memory, or else on disk. Returns
+  // nullptr if there is none.
+  std::shared_ptr<std::string> Find(const std::string &key);
+
+  // Add the object compiled for the given key
+  void Insert(const std::string &key, const char *object, size_t size);
+
+  // Drop all objects held in memory. The objects on disk stay, so this is
+  // what the cache looks like after a restart.
+  void ClearMemory();
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  uint64_t GetMemoryHits() const { return memory_hits_; }
+
+  uint64_t GetDiskHits() const { return disk_hits_; }
+
+  uint64_t GetMisses() const { return misses_; }
+
+ private:
+  ObjectCache();
+
+  // The file of the object with the given key
+  std::string GetPath(const std::string &key) const;
+
+  // Read and write the file of an object
+  std::shared_ptr<std::string> ReadFile(const std::string &key) const;
+  void WriteFile(const std::string &key, const std::string &object) const;
+
+ private:
+  // The objects in memory, protected by the latch
+  std::mutex mutex_;
+  std::unique_ptr<Cache<std::string, std::string>> objects_;
+
+  // Statistics
+  std::atomic<uint64_t> memory_hits_;
+  std::atomic<uint64_t> disk_hits_;
+  std::atomic<uint64_t> misses_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(ObjectCache);
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -34,6 +34,12 @@ class HashJoinTranslator : public OperatorTranslator {
   // Global/configurable variable controlling whether hash aggregations prefetch
   static std::atomic<bool> kUsePrefetch;
 
+  // Global/configurable variables controlling whether hash joins partition
+  // their inputs: always, or when the estimated size of the hash table
+  // exceeds the threshold (in bytes)
+  static std::atomic<bool> kUseRadixPartitioning;
+  static std::atomic<uint64_t> kRadixPartitioningThreshold;
+
   HashJoinTranslator(const planner::HashJoinPlan &join,
                      CompilationContext &context, Pipeline &pipeline);
 
@@ -64,6 +70,28 @@ class HashJoinTranslator : public OperatorTranslator {
     return context.GetPipeline().GetChild() == left_pipeline_.GetChild();
   }
 
+  // Store the given row in the left or right partitioner
+  void BufferLeft(RowBatch::Row &row, llvm::Value *hash,
+                  const std::vector<codegen::Value> &key,
+                  const std::vector<codegen::Value> &vals) const;
+  void BufferRight(RowBatch::Row &row) const;
+
+  // Partition both inputs, then join every pair of partitions
+  void JoinPartitions() const;
+
+  // Probe the hash table with the given row of the right side, sending the
+  // results of the join up the pipeline
+  void ProbeHashTable(ConsumerContext &context, RowBatch::Row &row,
+                      llvm::Value *ht_ptr) const;
+
+  // Send the tuples in the hash table that found no partner up the pipeline,
+  // with NULLs for the right side
+  void OutputUnmatchedLeft(llvm::Value *ht_ptr) const;
+
+  // Register NULLs for the attributes of the left or right side in the row
+  void RegisterLeftNulls(RowBatch::Row &row) const;
+  void RegisterRightNulls(RowBatch::Row &row) const;
+
   void CollectKeys(
       RowBatch::Row &row,
       const std::vector<const expression::AbstractExpression *> &key,
@@ -79,6 +107,20 @@ class HashJoinTranslator : public OperatorTranslator {
   // Should this operator employ prefetching?
   bool UsePrefetching() const;
 
+  // Should this operator partition its inputs?
+  bool UseRadixPartitioning() const { return use_radix_partitioning_; }
+
+  // Are the tuples of the left or right side without a partner output?
+  bool PreservesLeft() const;
+  bool PreservesRight() const;
+
+  // Are joined tuples output? Semi and anti joins only output right tuples,
+  // depending on whether they have a partner.
+  bool OutputsMatches() const;
+
+  // Is it tracked whether a right tuple found a partner?
+  bool TracksRightMatches() const;
+
   const planner::HashJoinPlan &GetJoinPlan() const { return join_; }
 
   //===--------------------------------------------------------------------===//
@@ -90,7 +132,8 @@ class HashJoinTranslator : public OperatorTranslator {
     // Constructor
     ProbeRight(const HashJoinTranslator &join_translator,
                ConsumerContext &context, RowBatch::Row &row,
-               const std::vector<codegen::Value> &right_key);
+               const std::vector<codegen::Value> &right_key,
+               llvm::Value *matched_ptr);
 
     // Process the given key and associated data area
     void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
@@ -103,6 +146,31 @@ class HashJoinTranslator : public OperatorTranslator {
     ConsumerContext &context_;
     RowBatch::Row &row_;
     const std::vector<codegen::Value> &right_key_;
+    // Where to flag that the right tuple found a partner, if it's tracked
+    llvm::Value *matched_ptr_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used when we iterate the hash table after probing it, to
+  // output the left tuples that found no partner
+  //===--------------------------------------------------------------------===//
+  class ProduceUnmatchedLeft : public OAHashTable::IterateCallback {
+   public:
+    // Constructor
+    ProduceUnmatchedLeft(const HashJoinTranslator &join_translator,
+                         ConsumerContext &context, RowBatch &batch);
+
+    // Process the given key and associated data area
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &key,
+                      llvm::Value *data_area) const override;
+
+   private:
+    // The translator
+    const HashJoinTranslator &join_translator_;
+    // The context the rows are sent up with
+    ConsumerContext &context_;
+    // The batch holding the rows
+    RowBatch &batch_;
   };
 
   //===--------------------------------------------------------------------===//
@@ -132,6 +200,14 @@ class HashJoinTranslator : public OperatorTranslator {
   // The build-side pipeline
   Pipeline left_pipeline_;
 
+  // The probe-side pipeline, if the inputs are partitioned. Otherwise, the
+  // probe side is part of the pipeline of this join.
+  Pipeline right_pipeline_;
+
+  // The pipeline of this join, positioned at the join. Left tuples without a
+  // partner are sent from here, after the probe side is consumed.
+  Pipeline output_pipeline_;
+
   // The ID of the hash-table in the runtime state
   RuntimeState::StateID hash_table_id_;
 
@@ -151,6 +227,27 @@ class HashJoinTranslator : public OperatorTranslator {
   // The ID of the prefetch vector, if we're prefetching
   RuntimeState::StateID prefetch_vector_id_;
 
+  // Are the inputs radix-partitioned before they are joined?
+  bool use_radix_partitioning_;
+
+  // The IDs of the partitioners of both sides, and of the selection vector
+  // used when probing with the right partitions or outputting unmatched left
+  // tuples
+  RuntimeState::StateID left_partitioner_id_;
+  RuntimeState::StateID right_partitioner_id_;
+  RuntimeState::StateID output_vector_id_;
+
+  // The ID of the flag saying whether the current right tuple found a partner
+  RuntimeState::StateID right_matched_id_;
+
+  // The attributes of the right side that are stored in its partitions
+  std::vector<const planner::AttributeInfo *> right_ais_;
+
+  // The storage format of the tuples in the left partitions (the key, then the
+  // values stored in the hash table), and in the right partitions
+  CompactStorage left_partition_storage_;
+  CompactStorage right_partition_storage_;
+
   // Does this join need an output vector
   bool needs_output_vector_;
 };
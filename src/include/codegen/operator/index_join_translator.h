@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_translator.h
+//
+// Identification: src/include/codegen/operator/index_join_translator.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/operator/operator_translator.h"
+#include "codegen/runtime_state.h"
+#include "codegen/tile_group.h"
+
+namespace peloton {
+
+namespace planner {
+class IndexJoinPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for an index nested-loop join.
+//
+// The join receives batches of outer rows. It adds the keys of a group of rows
+// to an IndexProbe, probes the index with the whole group at once, and then
+// loads the columns of every matching inner tuple into the outer row that
+// produced its key before passing the row up the pipeline.
+//===----------------------------------------------------------------------===//
+class IndexJoinTranslator : public OperatorTranslator {
+ public:
+  IndexJoinTranslator(const planner::IndexJoinPlan &join,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  // Codegen any initialization work for this operator
+  void InitializeState() override;
+
+  // Define any helper functions this translator needs
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch &batch) const override;
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Codegen any cleanup work for this translator
+  void TearDownState() override;
+
+  std::string GetName() const override;
+
+ private:
+  // Add the key of the given outer row to the next probe
+  void AddKey(RowBatch::Row &row) const;
+
+  // Probe the index with the added keys, returning the number of matches
+  llvm::Value *Probe() const;
+
+  // Return the number of the key the given match was found with
+  llvm::Value *GetMatchKey(llvm::Value *match_idx) const;
+
+  // Join the outer row with the inner tuple of the given match
+  void JoinMatch(ConsumerContext &context, RowBatch::Row &row,
+                 llvm::Value *match_idx) const;
+
+  const planner::IndexJoinPlan &GetJoinPlan() const { return join_; }
+
+ private:
+  // The index join plan node
+  const planner::IndexJoinPlan &join_;
+
+  // The generator for the tile groups of the inner table
+  TileGroup tile_group_;
+
+  // The expressions producing the key from an outer row
+  std::vector<const expression::AbstractExpression *> outer_key_exprs_;
+
+  // The attributes of all columns of the inner table, and the columns that
+  // are loaded for every match
+  std::vector<const planner::AttributeInfo *> inner_ais_;
+  std::vector<oid_t> inner_col_ids_;
+
+  // The ID of the index probe in the runtime state
+  RuntimeState::StateID probe_id_;
+
+  // The IDs of the key values and the column layouts of the inner tile group
+  // in the (local) runtime state
+  RuntimeState::StateID key_values_id_;
+  RuntimeState::StateID column_layouts_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
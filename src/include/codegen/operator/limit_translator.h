@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.h
+//
+// Identification: src/include/codegen/operator/limit_translator.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/operator/operator_translator.h"
+#include "codegen/pipeline.h"
+
+namespace peloton {
+
+namespace planner {
+class LimitPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for limits (with offsets). The limit counts the rows it sees,
+// and only passes on the rows between the offset and the end of the limit.
+// Once the end of the limit is reached, the limit is finished, and the
+// producer of its pipeline stops early.
+//===----------------------------------------------------------------------===//
+class LimitTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  LimitTranslator(const planner::LimitPlan &plan, CompilationContext &context,
+                  Pipeline &pipeline);
+
+  // Nothing to initialize, the counter is reset when producing
+  void InitializeState() override {}
+
+  // No helper functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // Produce!
+  void Produce() const override;
+
+  // Consume!
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // No state to tear down
+  void TearDownState() override {}
+
+  // The limit is finished when it has seen every row up to its end
+  llvm::Value *IsFinished() const override;
+
+  // Get the stringified name of this translator
+  std::string GetName() const override;
+
+ private:
+  // The number of rows up to the end of the limit, including the offset
+  uint64_t GetEnd() const;
+
+ private:
+  // The limit plan
+  const planner::LimitPlan &plan_;
+
+  // The number of rows that have reached the limit so far
+  RuntimeState::StateID count_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -63,6 +63,11 @@ class OperatorTranslator {
   // Codegen any cleanup work for this translator
   virtual void TearDownState() = 0;
 
+  // Generate a check whether this operator has seen all the input it needs.
+  // Producers stop early once any operator in their pipeline is finished.
+  // Operators that always need all of their input return nullptr.
+  virtual llvm::Value *IsFinished() const { return nullptr; }
+
   virtual std::string GetName() const = 0;
 
  protected:
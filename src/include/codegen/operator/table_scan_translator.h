@@ -17,9 +17,14 @@
 #include "codegen/operator/operator_translator.h"
 #include "codegen/scan_callback.h"
 #include "codegen/table.h"
+#include "type/value.h"
 
 namespace peloton {
 
+namespace expression {
+class AbstractExpression;
+}  // namespace expression
+
 namespace planner {
 class SeqScanPlan;
 }  // namespace planner
@@ -39,7 +44,8 @@ class TableScanTranslator : public OperatorTranslator {
   TableScanTranslator(const planner::SeqScanPlan &scan,
                       CompilationContext &context, Pipeline &pipeline);
 
-  void InitializeState() override {}
+  // Set up the filter for predicates on compressed tile groups, if any
+  void InitializeState() override;
 
   // Table scans don't rely on any auxiliary functions
   void DefineAuxiliaryFunctions() override {}
@@ -51,8 +57,8 @@ class TableScanTranslator : public OperatorTranslator {
   void Consume(ConsumerContext &, RowBatch &) const override {}
   void Consume(ConsumerContext &, RowBatch::Row &) const override {}
 
-  // Similar to InitializeState(), table scans don't have any state
-  void TearDownState() override {}
+  // Destroy the compressed filter, if any
+  void TearDownState() override;
 
   // Get a stringified version of this translator
   std::string GetName() const override;
@@ -86,7 +92,7 @@ class TableScanTranslator : public OperatorTranslator {
    public:
     // Constructor
     ScanConsumer(const TableScanTranslator &translator,
-                 Vector &selection_vector);
+                 Vector &selection_vector, llvm::Value *compressed_filter_ptr);
 
     // The callback when starting iteration over a new tile group
     void TileGroupStart(CodeGen &, llvm::Value *tile_group_id,
@@ -103,6 +109,11 @@ class TableScanTranslator : public OperatorTranslator {
     // The callback when finishing iteration over a tile group
     void TileGroupFinish(CodeGen &, llvm::Value *) override {}
 
+    // The scan stops once an operator in its pipeline is finished
+    llvm::Value *IsFinished(CodeGen &codegen) override {
+      return translator_.GetPipeline().IsFinished(codegen);
+    }
+
    private:
     // Get the predicate, if one exists
     const expression::AbstractExpression *GetPredicate() const;
@@ -122,6 +133,13 @@ class TableScanTranslator : public OperatorTranslator {
                                llvm::Value *tid_start, llvm::Value *tid_end,
                                Vector &selection_vector) const;
 
+    // Filter the TIDs in the selection vector on the compressed columns of a
+    // frozen tile group, or with FilterRowsByPredicate() if that isn't possible
+    void FilterRowsByCompressedPredicate(
+        CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+        llvm::Value *tid_start, llvm::Value *tid_end,
+        Vector &selection_vector) const;
+
     llvm::Value *SIMDFilterRows(RowBatch &batch,
                                 const TileGroup::TileGroupAccess &access) const;
 
@@ -132,11 +150,19 @@ class TableScanTranslator : public OperatorTranslator {
     // The selection vector used for vectorized scans
     Vector &selection_vector_;
 
+    // The filter for predicates on compressed tile groups (null if the
+    // predicate can't be evaluated on compressed columns)
+    llvm::Value *compressed_filter_ptr_;
+
     // The current tile group id we're scanning over
     llvm::Value *tile_group_id_;
 
     // The current tile group we're scanning over
     llvm::Value *tile_group_ptr_;
+
+    // The position of the scan in its pipeline. The tuples are processed once
+    // for every tile group layout the scan is specialized for.
+    uint32_t pipeline_position_;
   };
 
   // Plan accessor
@@ -145,6 +171,19 @@ class TableScanTranslator : public OperatorTranslator {
   // Table accessor
   const storage::DataTable &GetTable() const;
 
+  // A comparison of a column with a constant in the scan's predicate
+  struct CompressedTerm {
+    oid_t column_id;
+    ExpressionType comparison;
+    peloton::type::Value constant;
+  };
+
+  // Collect the terms of a predicate that is a conjunction of comparisons of
+  // columns with constants, which can be evaluated on compressed columns.
+  // Returns false if the predicate has any other form.
+  bool CollectCompressedTerms(const expression::AbstractExpression &predicate,
+                              std::vector<CompressedTerm> &terms) const;
+
  private:
   // The scan
   const planner::SeqScanPlan &scan_;
@@ -152,6 +191,12 @@ class TableScanTranslator : public OperatorTranslator {
   // The ID of the selection vector in runtime state
   RuntimeState::StateID selection_vector_id_;
 
+  // The terms of the predicate evaluated on compressed tile groups, and the ID
+  // of the filter evaluating them in runtime state. Empty if the predicate
+  // can't be evaluated on compressed columns.
+  std::vector<CompressedTerm> compressed_terms_;
+  RuntimeState::StateID compressed_filter_id_;
+
   // The code-generating table instance
   codegen::Table table_;
 };
@@ -16,9 +16,14 @@
 #include <string>
 #include <vector>
 
+namespace llvm {
+class Value;
+}  // namespace llvm
+
 namespace peloton {
 namespace codegen {
 
+class CodeGen;
 class OperatorTranslator;
 class CompilationContext;
 class ConsumerContext;
@@ -43,12 +48,26 @@ class Pipeline {
 
   bool AtStageBoundary() const;
 
+  // Get the current operator in this pipeline
+  const OperatorTranslator *GetCurrentStep() const;
+
   // Get the child of the current operator in this pipeline
   const OperatorTranslator *GetChild() const;
 
   // Move to the next step in this pipeline
   const OperatorTranslator *NextStep();
 
+  // Get and restore the current position in this pipeline. A producer that
+  // generates the code of its consumers more than once must rewind the
+  // pipeline to its own position before each time.
+  uint32_t GetPosition() const;
+  void SetPosition(uint32_t position);
+
+  // Generate a check whether any operator in this pipeline is finished, in
+  // which case the producer of the pipeline can stop. This is nullptr if all
+  // operators in the pipeline need all of their input.
+  llvm::Value *IsFinished(CodeGen &codegen) const;
+
   uint32_t GetNumStages() const;
   uint32_t GetTranslatorStage(const OperatorTranslator *translator) const;
 
@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// profile_runtime.h
+//
+// Identification: src/include/codegen/profile_runtime.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+namespace peloton {
+
+namespace executor {
+class ExecutorContext;
+}  // namespace executor
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The hooks a compiled query calls to report into the profile of the query
+// (EXPLAIN ANALYZE). Calls to them are only generated when the query is
+// compiled with a profile.
+//===----------------------------------------------------------------------===//
+class ProfileRuntime {
+ public:
+  // Bracket the code produced by an operator
+  static void StartOperator(executor::ExecutorContext *executor_context,
+                            uint32_t operator_id);
+  static void StopOperator(executor::ExecutorContext *executor_context,
+                           uint32_t operator_id);
+
+  // Count the rows output by an operator
+  static void CountRows(executor::ExecutorContext *executor_context,
+                        uint32_t operator_id, uint32_t num_rows);
+};
+
+}  // namespace codegen
+}  // namespace peloton
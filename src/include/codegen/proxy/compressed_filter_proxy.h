@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_filter_proxy.h
+//
+// Identification: src/include/codegen/proxy/compressed_filter_proxy.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class CompressedFilterProxy {
+ public:
+  // Get the LLVM type for peloton::codegen::util::CompressedFilter
+  static llvm::Type *GetType(CodeGen &codegen);
+
+  // The proxy for codegen::util::CompressedFilter::Init()
+  struct _Init {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::CompressedFilter::AddIntegerTerm()
+  struct _AddIntegerTerm {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::CompressedFilter::AddStringTerm()
+  struct _AddStringTerm {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::CompressedFilter::LoadTileGroup()
+  struct _LoadTileGroup {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::CompressedFilter::Filter()
+  struct _Filter {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::CompressedFilter::Destroy()
+  struct _Destroy {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
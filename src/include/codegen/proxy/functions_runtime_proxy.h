@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// functions_runtime_proxy.h
+//
+// Identification: src/include/codegen/proxy/functions_runtime_proxy.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class FunctionsRuntimeProxy {
+ public:
+  // The proxy around FunctionsRuntime::Like()
+  struct _Like {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around FunctionsRuntime::Extract()
+  struct _Extract {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around FunctionsRuntime::Sqrt()
+  struct _Sqrt {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_probe_proxy.h
+//
+// Identification: src/include/codegen/proxy/index_probe_proxy.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class IndexProbeProxy {
+ public:
+  // Get the LLVM type for peloton::codegen::util::IndexProbe
+  static llvm::Type *GetType(CodeGen &codegen);
+
+  // The proxy for codegen::util::IndexProbe::Init()
+  struct _Init {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::AddKey()
+  struct _AddKey {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::Probe()
+  struct _Probe {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::GetMatchKey()
+  struct _GetMatchKey {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::GetMatchTileGroup()
+  struct _GetMatchTileGroup {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::GetMatchTid()
+  struct _GetMatchTid {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::IndexProbe::Destroy()
+  struct _Destroy {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -35,6 +35,14 @@ class OAHashTableProxy {
     static llvm::Function *GetFunction(CodeGen &codegen);
   };
 
+  //===--------------------------------------------------------------------===//
+  // The proxy for HashTable::Reset()
+  //===--------------------------------------------------------------------===//
+  struct _Reset {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
   //===--------------------------------------------------------------------===//
   // The proxy for HashTable::Destroy()
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// profile_runtime_proxy.h
+//
+// Identification: src/include/codegen/proxy/profile_runtime_proxy.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class ProfileRuntimeProxy {
+ public:
+  // The proxy around ProfileRuntime::StartOperator()
+  struct _StartOperator {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around ProfileRuntime::StopOperator()
+  struct _StopOperator {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around ProfileRuntime::CountRows()
+  struct _CountRows {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namepsace codegen
+}  // namespace peloton
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// radix_partitioner_proxy.h
+//
+// Identification: src/include/codegen/proxy/radix_partitioner_proxy.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class RadixPartitionerProxy {
+ public:
+  // Get the LLVM type for peloton::codegen::util::RadixPartitioner
+  static llvm::Type *GetType(CodeGen &codegen);
+
+  // The proxy for codegen::util::RadixPartitioner::Init()
+  struct _Init {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::StoreInputTuple()
+  struct _StoreInputTuple {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::ComputeRadixBits()
+  struct _ComputeRadixBits {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::Partition()
+  struct _Partition {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::GetNumPartitions()
+  struct _GetNumPartitions {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::GetPartitionStart()
+  struct _GetPartitionStart {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::GetPartitionSize()
+  struct _GetPartitionSize {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy for codegen::util::RadixPartitioner::Destroy()
+  struct _Destroy {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
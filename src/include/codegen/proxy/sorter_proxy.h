@@ -38,6 +38,30 @@ class SorterProxy {
     static llvm::Function *GetFunction(CodeGen &codegen);
   };
 
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::util::Sorter::InitTopK()
+  //===--------------------------------------------------------------------===//
+  struct _InitTopK {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::util::Sorter::StoreInputTupleTopK()
+  //===--------------------------------------------------------------------===//
+  struct _StoreInputTupleTopK {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::util::Sorter::FinishStoreTopK()
+  //===--------------------------------------------------------------------===//
+  struct _FinishStoreTopK {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
   //===--------------------------------------------------------------------===//
   // The proxy for codegen::util::Sorter::Sort()
   //===--------------------------------------------------------------------===//
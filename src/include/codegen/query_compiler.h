@@ -20,6 +20,10 @@
 
 namespace peloton {
 
+namespace executor {
+class QueryProfile;
+}  // namespace executor
+
 namespace planner {
 class AbstractPlan;
 }  // namespace plan
@@ -52,10 +56,13 @@ class QueryCompiler {
   // Compile the provided query, returning the compiled plan that can be invoked
   // to return results. Callers can also pass in an (optional) CompileStats
   // object pointer if they want to collect statistics on the compilation
-  // process.
+  // process. Callers passing a QueryProfile get a query that reports the time
+  // and output of its operators into the profile (EXPLAIN ANALYZE); the query
+  // must then be executed with that profile set in its executor context.
   std::unique_ptr<Query> Compile(const planner::AbstractPlan &query_plan,
                                  QueryResultConsumer &consumer,
-                                 CompileStats *stats = nullptr);
+                                 CompileStats *stats = nullptr,
+                                 executor::QueryProfile *profile = nullptr);
 
   // Get the next available query plan ID
   uint64_t NextId() { return next_id_++; }
@@ -44,6 +44,10 @@ class ScanCallback {
   // Callback for when iteration over the given tile group has completed
   virtual void TileGroupFinish(CodeGen &codegen,
                                llvm::Value *tile_group_ptr) = 0;
+
+  // Generate a check whether the scan can stop before the next tile group.
+  // This is nullptr if the whole table has to be scanned.
+  virtual llvm::Value *IsFinished(CodeGen &) { return nullptr; }
 };
 
 }  // namespace codegen
@@ -99,10 +99,19 @@ class Sorter {
   void Init(CodeGen &codegen, llvm::Value *sorter_ptr,
             llvm::Value *comparison_func) const;
 
+  // Initialize the given sorter instance to only retain the first top_k
+  // tuples in the order of the comparison function
+  void InitTopK(CodeGen &codegen, llvm::Value *sorter_ptr,
+                llvm::Value *comparison_func, llvm::Value *top_k) const;
+
   // Append the given tuple into the sorter instance
   void Append(CodeGen &codegen, llvm::Value *sorter_ptr,
               const std::vector<codegen::Value> &tuple) const;
 
+  // Append the given tuple into a sorter instance initialized with InitTopK()
+  void AppendTopK(CodeGen &codegen, llvm::Value *sorter_ptr,
+                  const std::vector<codegen::Value> &tuple) const;
+
   // Sort all the data that has been inserted into the sorter instance
   void Sort(CodeGen &codegen, llvm::Value *sorter_ptr) const;
 
@@ -121,6 +130,10 @@ class Sorter {
                                        llvm::Value *sorter_ptr) const;
 
  private:
+  // Materialize the given tuple into the provided space
+  void StoreTuple(CodeGen &codegen, llvm::Value *space,
+                  const std::vector<codegen::Value> &tuple) const;
+
   //===--------------------------------------------------------------------===//
   // SORTER INSTANCE ACCESSORS
   //
@@ -52,6 +52,16 @@ class Table {
                             llvm::Value *tile_group_id) const;
 
  private:
+  // Collect the strides of the tile group layouts the scan loop is specialized
+  // for: the most common layouts of the table's tile groups, and the default
+  // layout the layout tuner transforms tile groups into.
+  std::vector<TileGroup::ColumnStrides> GetKnownLayouts() const;
+
+ private:
+  // The maximum number of layouts the scan loop is specialized for. Each
+  // layout gets its own copy of the code of the whole pipeline.
+  static constexpr uint32_t kMaxKnownLayouts = 2;
+
   // The table associated with this generator
   storage::DataTable &table_;
 
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tiered_compiler.h
+//
+// Identification: src/include/codegen/tiered_compiler.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// Tiered execution of the queries the code generator supports. Queries start
+// out in the interpreter, which has no startup cost. The tiered compiler counts
+// the executions and the interpreted time of every plan, and once a plan turns
+// out to be hot, it compiles it on a background thread. From then on, the plan
+// is executed through the compiled code.
+//
+// The background compilation only warms the object cache (see ObjectCache):
+// executing a compiled plan still generates its IR, but finds its machine code
+// in the cache instead of optimizing and JITing it again. This is what makes
+// switching tiers safe: plans are only told apart by a fingerprint of their
+// structure, and a plan whose fingerprint collides with a compiled one merely
+// gets compiled in the foreground.
+//===----------------------------------------------------------------------===//
+class TieredCompiler {
+ public:
+  ~TieredCompiler();
+
+  // The tiered compiler of this process
+  static TieredCompiler &GetInstance();
+
+  // Start and stop the background compilation thread
+  void Start();
+  void Stop();
+
+  // Is the tiered compiler running? If not, queries are compiled as soon as
+  // they are executed.
+  bool IsEnabled() const;
+
+  // Has the plan been compiled in the background?
+  bool IsCompiled(const planner::AbstractPlan &plan);
+
+  // Record an interpreted execution of the plan, which took the given time.
+  // The plan is queued for compilation if this makes it hot.
+  void RecordInterpreted(const planner::AbstractPlan &plan, double ms);
+
+  // Forget the queued plans that access the table, and wait for the plan being
+  // compiled if it accesses the table. Called before the table is dropped.
+  void DropTable(oid_t database_oid, oid_t table_oid);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  uint64_t GetNumCompiled() const { return num_compiled_; }
+
+ private:
+  TieredCompiler();
+
+  // What we know about a plan
+  enum class PlanState { Interpreted, Queued, Compiled, Failed };
+  struct PlanStats {
+    uint64_t executions = 0;
+    double interpreted_ms = 0.0;
+    PlanState state = PlanState::Interpreted;
+  };
+
+  // A table, by database oid and table oid
+  using TableId = std::pair<oid_t, oid_t>;
+
+  // A plan waiting to be compiled, and the tables it accesses. The plan points
+  // to the tables, so it must not be compiled once one of them is dropped.
+  struct CompileTask {
+    hash_t fingerprint;
+    std::unique_ptr<planner::AbstractPlan> plan;
+    std::vector<TableId> tables;
+  };
+
+  // The background thread
+  void Run();
+
+  // Do all the tables still exist?
+  static bool HasTables(const std::vector<TableId> &tables);
+
+  // Compile a queued plan, returning true if it succeeded
+  static bool Compile(planner::AbstractPlan &plan);
+
+ private:
+  // The statistics of every plan, and the queue of plans to compile, protected
+  // by the latch
+  std::mutex mutex_;
+  std::unordered_map<hash_t, PlanStats> plans_;
+  std::deque<CompileTask> queue_;
+  std::condition_variable queue_cv_;
+
+  // The tables of the plan being compiled, which can't be dropped until it is
+  // done
+  std::vector<TableId> compiling_tables_;
+  std::condition_variable compiling_cv_;
+
+  // The background thread and its stop signal
+  std::thread compiler_thread_;
+  std::atomic<bool> running_;
+
+  // The number of plans compiled in the background
+  std::atomic<uint64_t> num_compiled_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(TieredCompiler);
+};
+
+}  // namespace codegen
+}  // namespace peloton
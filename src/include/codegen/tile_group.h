@@ -34,19 +34,25 @@ class ScanCallback;
 //===----------------------------------------------------------------------===//
 class TileGroup {
  public:
+  // The stride of every column in a tile group. Tile groups with the same
+  // strides share a scan loop in which the strides are constants.
+  using ColumnStrides = std::vector<uint32_t>;
+
   // Constructor
   TileGroup(const catalog::Schema &schema);
 
-  // Generate code that performs a sequential scan over the provided tile group
+  // Generate code that performs a sequential scan over the provided tile group.
+  // The scan loop is specialized for each of the known layouts, all other
+  // layouts are scanned with strides that are loaded at runtime.
   void GenerateTidScan(CodeGen &codegen, llvm::Value *tile_group_ptr,
-                       llvm::Value *column_layouts, uint32_t batch_size,
-                       ScanCallback &consumer) const;
+                       llvm::Value *column_layouts,
+                       const std::vector<ColumnStrides> &known_layouts,
+                       uint32_t batch_size, ScanCallback &consumer) const;
 
   llvm::Value *GetNumTuples(CodeGen &codegen, llvm::Value *tile_group) const;
 
   llvm::Value *GetTileGroupId(CodeGen &codegen, llvm::Value *tile_group) const;
 
- private:
   // A struct to capture enough information to perform strided accesses
   struct ColumnLayout {
     uint32_t col_id;
@@ -55,6 +61,13 @@ class TileGroup {
     llvm::Value *is_columnar;
   };
 
+  // Discover the layout of all columns of the given tile group, using the
+  // provided stack space for ColumnLayoutInfo structs
+  std::vector<TileGroup::ColumnLayout> GetColumnLayouts(
+      CodeGen &codegen, llvm::Value *tile_group_ptr,
+      llvm::Value *column_layout_infos) const;
+
+ private:
   /*
   //===--------------------------------------------------------------------===//
   // A convenience class to access to a column
@@ -86,9 +99,20 @@ class TileGroup {
   };
   */
 
-  std::vector<TileGroup::ColumnLayout> GetColumnLayouts(
-      CodeGen &codegen, llvm::Value *tile_group_ptr,
-      llvm::Value *column_layout_infos) const;
+  // Generate the scan loop for the first known layout the tile group has,
+  // starting from the layout with the given index
+  void GenerateLayoutScan(CodeGen &codegen,
+                          const std::vector<ColumnLayout> &col_layouts,
+                          llvm::Value *num_tuples,
+                          const std::vector<ColumnStrides> &known_layouts,
+                          uint32_t layout_idx, uint32_t batch_size,
+                          ScanCallback &consumer) const;
+
+  // Generate the scan loop over all tuples with the given column layouts
+  void GenerateTupleLoop(CodeGen &codegen,
+                         const std::vector<ColumnLayout> &col_layouts,
+                         llvm::Value *num_tuples, uint32_t batch_size,
+                         ScanCallback &consumer) const;
 
   // Access a given column for the row with the given tid
   codegen::Value LoadColumn(CodeGen &codegen, llvm::Value *tid,
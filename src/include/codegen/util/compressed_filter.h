@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_filter.h
+//
+// Identification: src/include/codegen/util/compressed_filter.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace storage {
+class CompressedTileGroup;
+class TileGroup;
+}  // namespace storage
+
+namespace codegen {
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// A class that evaluates a scan predicate on the compressed columns of frozen
+// tile groups on behalf of a table scan.
+//
+// The predicate is a conjunction of terms, each comparing a column with a
+// constant. The generated code adds the terms once, then loads every tile
+// group it scans. If the tile group is frozen and all terms can be evaluated
+// on its encoded columns, the matches of the whole tile group are computed
+// once, and the TIDs in the selection vector of every batch are filtered by
+// them. Otherwise, the generated code evaluates the predicate itself.
+//
+// Like the IndexProbe, instances live in the runtime state of the query and
+// are only ever touched through Init() and Destroy(), never constructed
+// directly.
+//===----------------------------------------------------------------------===//
+class CompressedFilter {
+ public:
+  // Initialize this filter with no terms
+  void Init();
+
+  // Add the term "column <comparison> constant" for an integer column
+  void AddIntegerTerm(uint32_t column_id, uint32_t comparison,
+                      int64_t constant);
+
+  // Add the term "column <comparison> constant" for a varchar column
+  void AddStringTerm(uint32_t column_id, uint32_t comparison,
+                     const char *constant, uint32_t length);
+
+  // Prepare to filter the tuples of the tile group with IDs below tid_end.
+  // Returns false if the tile group isn't frozen, or not all terms can be
+  // evaluated on its compressed columns.
+  bool LoadTileGroup(const storage::TileGroup *tile_group, uint32_t tid_end);
+
+  // Remove the TIDs of the loaded tile group that don't satisfy all terms from
+  // the selection vector, returning the number of TIDs left
+  uint32_t Filter(uint32_t *selection_vector, uint32_t num_selected) const;
+
+  // Cleanup all the resources this filter maintains
+  void Destroy();
+
+ private:
+  // Instances are only created in place, through Init()
+  CompressedFilter();
+  ~CompressedFilter();
+
+ private:
+  struct Term {
+    oid_t column_id;
+    ExpressionType comparison;
+    peloton::type::Value constant;
+  };
+
+  // The conjunction of terms the tuples must satisfy
+  std::vector<Term> terms_;
+
+  // The compressed tile group the matches were computed for. Holding on to it
+  // keeps a tile group that is refrozen from being mistaken for this one.
+  std::shared_ptr<const storage::CompressedTileGroup> compressed_tile_group_;
+
+  // Could all terms be evaluated on the loaded tile group?
+  bool evaluated_;
+
+  // The tuples of the loaded tile group that satisfy all terms
+  std::vector<bool> matches_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_probe.h
+//
+// Identification: src/include/codegen/util/index_probe.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/item_pointer.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}  // namespace concurrency
+
+namespace index {
+class Index;
+}  // namespace index
+
+namespace storage {
+class DataTable;
+class TileGroup;
+class Tuple;
+}  // namespace storage
+
+namespace type {
+class EphemeralPool;
+}  // namespace type
+
+namespace codegen {
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// A class that looks up a batch of keys in an index on behalf of an index join.
+//
+// The generated code adds the keys of a group of outer rows one at a time,
+// then probes the index with all of them at once. The probe walks the version
+// chains of the entries the index returns, and keeps the versions that are
+// visible to (and readable by) the transaction. The generated code then
+// iterates over the matches, each one naming the key it was found with and the
+// location of the inner tuple.
+//
+// Like the Sorter, instances live in the runtime state of the query and are
+// only ever touched through Init() and Destroy(), never constructed directly.
+//===----------------------------------------------------------------------===//
+class IndexProbe {
+ public:
+  // The number of keys that are probed together. This matches the group size
+  // of batched lookups in the BwTree.
+  static constexpr uint32_t kDefaultBatchSize = 32;
+
+  // Initialize this probe for the index with the given OID on the table
+  void Init(storage::DataTable *table, uint32_t index_oid);
+
+  // Add the key whose column values are stored in the given array of values.
+  // Keys are numbered in the order they are added since the last probe. A key
+  // with a NULL column, or a column that doesn't fit the index key, can't
+  // match and is dropped (but still takes its number).
+  void AddKey(char *values);
+
+  // Look up all keys added since the last probe, returning the number of
+  // matching tuples that are visible to the transaction
+  uint32_t Probe(concurrency::Transaction *txn);
+
+  // The number of the key, the tile group and the tuple ID of the given match.
+  // These are called from generated code, so they aren't inlined
+  uint32_t GetMatchKey(uint32_t match_idx) const;
+  storage::TileGroup *GetMatchTileGroup(uint32_t match_idx) const;
+  uint32_t GetMatchTid(uint32_t match_idx) const;
+
+  // Cleanup all the resources this probe maintains
+  void Destroy();
+
+ private:
+  // Instances are only created in place, through Init()
+  explicit IndexProbe(std::shared_ptr<index::Index> index);
+  ~IndexProbe();
+
+  // Find the version of the tuple that is visible to the transaction. The
+  // location is null if no version is visible
+  ItemPointer FindVisibleVersion(concurrency::Transaction &txn,
+                                 ItemPointer tuple_location) const;
+
+  // Check that the tuple at the location has the given key
+  bool CheckKey(const ItemPointer &tuple_location,
+                const storage::Tuple &key) const;
+
+ private:
+  struct Match {
+    uint32_t key_idx;
+    storage::TileGroup *tile_group;
+    uint32_t tid;
+  };
+
+  // The index we probe
+  std::shared_ptr<index::Index> index_;
+
+  // Is the index the primary key of the table? If not, the visible version of
+  // a tuple may no longer have the key it was found with.
+  bool is_primary_;
+
+  // The number of keys added since the last probe
+  uint32_t num_keys_;
+
+  // The key tuples, which are reused across probes, and the keys (and their
+  // numbers) that will be looked up in the next probe
+  std::vector<std::unique_ptr<storage::Tuple>> key_tuples_;
+  std::vector<const storage::Tuple *> keys_;
+  std::vector<uint32_t> key_ids_;
+
+  // The pool holding the variable-length columns of the keys
+  std::unique_ptr<peloton::type::EphemeralPool> pool_;
+
+  // The matches of the last probe
+  std::vector<Match> matches_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -120,6 +120,11 @@ class OAHashTable {
   // with the same key as that which is to be inserted.
   char *StoreTuple(HashEntry *entry, uint64_t hash);
 
+  // Remove all entries from the hash-table, and size its buckets for the
+  // given number of entries. The table can be reused for keys and values of
+  // the same size, as is done for every partition of a radix-partitioned join.
+  void Reset(uint64_t estimated_num_entries);
+
   // Clean up any resources this hash-table has.
   void Destroy();
 
@@ -183,6 +188,9 @@ class OAHashTable {
   // its new location. This makes key comparisons during resizing unnecessary.
   void Resize(HashEntry **entry_p_p);
 
+  // Free all the overflow key-value lists in the bucket array
+  void FreeKeyValueLists();
+
   // Given a hash value, find the next free entry
   HashEntry *FindNextFreeEntry(uint64_t hash_value);
 
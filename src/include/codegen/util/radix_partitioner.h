@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// radix_partitioner.h
+//
+// Identification: src/include/codegen/util/radix_partitioner.h
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+namespace peloton {
+namespace codegen {
+namespace util {
+
+//===----------------------------------------------------------------------===//
+// A buffer of fixed-size tuples, each stored along with its hash value, that
+// can be radix-partitioned on the hash values. This is used by the
+// radix-partitioned hash join: both inputs of the join are buffered and
+// partitioned on the same bits, so that every pair of partitions can be joined
+// with a hash table that fits into the cache.
+//
+// Partitioning is done in one pass, or in two passes if the number of
+// partitions is too large to scatter tuples into at once. Every pass builds a
+// histogram of the partitions, and then scatters the tuples through one
+// cache-line-sized buffer per partition (a software write-combining buffer),
+// so that the output of a partition is written a full cache line at a time.
+//
+// The partition of a tuple is given by the high bits of its hash value, since
+// the hash tables built on the partitions use the low bits to find buckets.
+//
+// Like the Sorter, instances live in the runtime state of the query and are
+// only ever touched through Init() and Destroy(), never constructed directly.
+//===----------------------------------------------------------------------===//
+class RadixPartitioner {
+ public:
+  // The largest number of bits partitioned on in a single pass. 2^8 write
+  // combining buffers fit comfortably into the L1 cache and the TLB.
+  static constexpr uint32_t kMaxRadixBitsPerPass = 8;
+
+  // The largest number of bits partitioned on, in two passes
+  static constexpr uint32_t kMaxRadixBits = 2 * kMaxRadixBitsPerPass;
+
+  // The size of the hash table we aim for in every partition
+  static uint64_t kTargetPartitionSize;
+
+  // Initialize this partitioner for tuples of the given size
+  void Init(uint32_t tuple_size);
+
+  // Make room for a tuple with the given hash value, returning the space
+  // where the tuple is to be stored
+  char *StoreInputTuple(uint64_t hash);
+
+  // The number of bits to partition on, so that a hash table with entries of
+  // the given size holding a partition of the stored tuples fits the target
+  // partition size
+  uint32_t ComputeRadixBits(uint64_t hash_entry_size) const;
+
+  // Partition the stored tuples on the given number of bits of their hash
+  void Partition(uint32_t radix_bits);
+
+  // The number of partitions
+  uint32_t GetNumPartitions() const;
+
+  // The first entry and the number of entries of the given partition. An entry
+  // is the 8-byte hash value, followed by the tuple.
+  char *GetPartitionStart(uint32_t partition) const;
+  uint64_t GetPartitionSize(uint32_t partition) const;
+
+  // The size of an entry holding a tuple of the given size. Entries are padded
+  // so that the hash values stay aligned.
+  static uint32_t ComputeEntrySize(uint32_t tuple_size) {
+    return (sizeof(uint64_t) + tuple_size + 7) & ~7u;
+  }
+
+  // The total number of stored tuples
+  uint64_t GetNumTuples() const {
+    return static_cast<uint64_t>(buffer_pos_ - buffer_start_) / entry_size_;
+  }
+
+  // Cleanup all the resources this partitioner maintains
+  void Destroy();
+
+ private:
+  // Instances are only created in place, through Init()
+  RadixPartitioner() = delete;
+  ~RadixPartitioner() = delete;
+
+  // Double the size of the buffer
+  void Resize();
+
+  // Scatter the given entries into the output, on the radix_bits bits of
+  // their hashes below the top shift bits. The histogram holds the number of
+  // entries of every partition of the pass, and the output is written in the
+  // order of the partitions.
+  void PartitionPass(const char *input, uint64_t num_entries, char *output,
+                     uint32_t shift, uint32_t radix_bits,
+                     const uint64_t *histogram) const;
+
+  // Count the entries of every partition of a pass
+  void BuildHistogram(const char *input, uint64_t num_entries, uint32_t shift,
+                      uint32_t radix_bits, uint64_t *histogram) const;
+
+  // Allocate and release buffer space
+  static char *Allocate(uint64_t size);
+  static void Release(char *buffer);
+
+ private:
+  // The entries, which are in the order of their partitions after Partition()
+  char *buffer_start_;
+  char *buffer_pos_;
+  char *buffer_end_;
+
+  // The size of the tuples, and of the entries holding them and their hash
+  uint32_t tuple_size_;
+  uint32_t entry_size_;
+
+  // The number of bits partitioned on
+  uint32_t radix_bits_;
+
+  // The index of the first entry of every partition, with the number of
+  // entries at the end
+  uint64_t *partition_offsets_;
+};
+
+}  // namespace util
+}  // namespace codegen
+}  // namespace peloton
@@ -36,6 +36,13 @@ namespace util {
 //    tuples and let clients worry about serializing types into the allocated
 //    space. We would accept a Serializer type as part of the Init(..) function,
 //    but we don't need it at this moment.
+//
+// A sorter initialized through InitTopK(..) only retains the first K tuples in
+// the sort order. The retained tuples form a binary max-heap (w.r.t. the
+// comparison function) at the front of the buffer. Every incoming tuple is
+// stored in the free slot after the heap and then either pushed into the heap,
+// or replaces the largest tuple in the heap, or is dropped. Sorting the heap
+// afterwards produces the top-K tuples in order.
 //===----------------------------------------------------------------------===//
 class Sorter {
  private:
@@ -54,10 +61,20 @@ class Sorter {
   // Initialize this sorter with the given comparison function
   void Init(ComparisonFunction func, uint32_t tuple_size);
 
+  // Initialize this sorter to only retain the top_k first tuples in the sort
+  // order of the given comparison function
+  void InitTopK(ComparisonFunction func, uint32_t tuple_size, uint64_t top_k);
+
   // StoreValue an input tuple whose size is _equivalent_ to the size of tuple
   // provided at initialization time.
   char *StoreInputTuple();
 
+  // Get space for an input tuple in a top-K sorter. Once the tuple has been
+  // written into the space, FinishStoreTopK() has to be called to add it to
+  // the retained tuples.
+  char *StoreInputTupleTopK();
+  void FinishStoreTopK();
+
   // Perform the sort
   void Sort();
 
@@ -104,6 +121,19 @@ class Sorter {
   // Resize the given array to a larger size
   void Resize();
 
+  // Accessors for the tuples in the heap of a top-K sorter
+  char *GetHeapTuple(uint64_t idx) const {
+    return buffer_start_ + idx * tuple_size_;
+  }
+  bool HeapLess(uint64_t l, uint64_t r) const {
+    return cmp_func_(GetHeapTuple(l), GetHeapTuple(r)) < 0;
+  }
+  void HeapSwap(uint64_t l, uint64_t r);
+
+  // Restore the heap property after the tuple at the given index has moved
+  void HeapSiftUp(uint64_t idx);
+  void HeapSiftDown(uint64_t idx);
+
  private:
   // The contiguous buffer space where tuples are stored.
   //
@@ -122,6 +152,9 @@ class Sorter {
 
   // The comparison function
   ComparisonFunction cmp_func_;
+
+  // The number of tuples a top-K sorter retains
+  uint64_t top_k_;
 };
 
 }  // namespace util
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa.h
+//
+// Identification: src/include/common/numa.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// NUMA Topology
+//===--------------------------------------------------------------------===//
+
+/**
+ * The NUMA nodes of the machine and the CPUs that belong to them.
+ *
+ * The topology is read from sysfs. It can also be emulated, by splitting the
+ * CPUs of the machine into a given number of nodes: placement and pinning
+ * then behave as on a multi-socket machine, but memory is not bound to any
+ * node. This lets single-node boxes run the NUMA code paths.
+ */
+class NumaTopology {
+ public:
+  NumaTopology(NumaTopology const &) = delete;
+  NumaTopology &operator=(NumaTopology const &) = delete;
+
+  NumaTopology();
+
+  // Singleton
+  static NumaTopology &GetInstance();
+
+  // Read the topology of the machine
+  void Detect();
+
+  // Split the CPUs of the machine into node_count emulated nodes
+  void Emulate(const size_t node_count);
+
+  bool IsEmulated() const { return is_emulated_; }
+
+  size_t GetNodeCount() const { return node_cpus_.size(); }
+
+  const std::vector<size_t> &GetNodeCpus(const int node) const {
+    return node_cpus_[node];
+  }
+
+  // Returns the node of the cpu (0 if unknown)
+  int GetCpuNode(const size_t cpu) const;
+
+  // Returns the node the calling thread runs on. Threads pinned with
+  // PinThreadToNode report the node they are pinned to.
+  int GetCurrentNode() const;
+
+  // Pin the calling thread to the CPUs of the node.
+  // Returns false if the affinity could not be set.
+  bool PinThreadToNode(const int node);
+
+  // Pin the calling thread if thread pinning is enabled. Threads are spread
+  // over the nodes round-robin by their id.
+  void PinThread(const size_t thread_id);
+
+  // Bind the pages of [address, address + size) to the node. The address
+  // must be page aligned. Does nothing on emulated or single-node topologies.
+  bool BindMemory(void *address, const size_t size, const int node) const;
+
+  void SetThreadPinning(const bool thread_pinning) {
+    thread_pinning_ = thread_pinning;
+  }
+
+  bool GetThreadPinning() const { return thread_pinning_; }
+
+  const std::string GetInfo() const;
+
+ private:
+  // Parse cpu lists such as "0-3,8-11"
+  static std::vector<size_t> ParseCpuList(const std::string &cpu_list);
+
+  // CPUs of every node
+  std::vector<std::vector<size_t>> node_cpus_;
+
+  // Node of every CPU
+  std::vector<int> cpu_nodes_;
+
+  bool is_emulated_ = false;
+
+  bool thread_pinning_ = false;
+
+  // Node the calling thread is pinned to
+  static thread_local int pinned_node_;
+};
+
+}  // End peloton namespace
@@ -82,6 +82,31 @@ class Statement : public Printable {
 
   inline void SetNeedsPlan(bool replan) { needs_replan_ = replan; }
 
+  // EXPLAIN [ANALYZE]: the plan tree is the one of the explained statement
+  inline void SetExplain(bool analyze, bool hardware_counters) {
+    explain_ = true;
+    explain_analyze_ = analyze;
+    explain_hardware_counters_ = hardware_counters;
+  }
+
+  inline bool IsExplain() const { return explain_; }
+
+  inline bool IsExplainAnalyze() const { return explain_analyze_; }
+
+  inline bool GetExplainHardwareCounters() const {
+    return explain_hardware_counters_;
+  }
+
+  // Schema of the result tuple of the explained statement
+  inline void SetExplainedTupleDescriptor(
+      const std::vector<FieldInfo>& tuple_descriptor) {
+    explained_tuple_descriptor_ = tuple_descriptor;
+  }
+
+  inline const std::vector<FieldInfo>& GetExplainedTupleDescriptor() const {
+    return explained_tuple_descriptor_;
+  }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -116,6 +141,13 @@ class Statement : public Printable {
   // If this flag is true, then somebody wants us to replan this query
   bool needs_replan_ = false;
 
+  // Executing the statement reports its plan (EXPLAIN), or runs it and
+  // reports its profile (EXPLAIN ANALYZE)
+  bool explain_ = false;
+  bool explain_analyze_ = false;
+  bool explain_hardware_counters_ = false;
+  std::vector<FieldInfo> explained_tuple_descriptor_;
+
   // containing pairs of <query_type_string, query_type>
   // use map to speed up searching
   static std::unordered_map<std::string, QueryType> query_type_map_;
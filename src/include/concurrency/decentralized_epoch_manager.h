@@ -21,6 +21,7 @@
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/init.h"
+#include "common/numa.h"
 #include "common/thread_pool.h"
 #include "concurrency/epoch_manager.h"
 #include "concurrency/local_epoch.h"
@@ -105,6 +106,13 @@ public:
   // a transaction exits epoch with thread id
   virtual void ExitEpoch(const size_t thread_id, const eid_t epoch_id) override;
 
+  // a read-only transaction enters epoch with thread id
+  virtual cid_t EnterReadOnlyEpoch(const size_t thread_id) override;
+
+  // a read-only transaction exits epoch with thread id
+  virtual void ExitReadOnlyEpoch(const size_t thread_id,
+                                 const eid_t epoch_id) override;
+
 
   virtual cid_t GetExpiredCid() override {
     uint64_t max_committed_eid = GetExpiredEpochId();
@@ -132,6 +140,7 @@ private:
   void Running() {
 
     PL_ASSERT(is_running_ == true);
+    NumaTopology::GetInstance().PinThread(0);
 
     while (is_running_ == true) {
       // the epoch advances every EPOCH_LENGTH milliseconds.
@@ -153,7 +162,7 @@ private:
   
   // snapshot epoch is an epoch where the corresponding tuples may be still
   // visible to on-the-fly transactions
-  eid_t snapshot_global_epoch_id_;
+  std::atomic<eid_t> snapshot_global_epoch_id_;
 
   bool is_running_;
 
@@ -51,6 +51,13 @@ public:
 
   virtual void ExitEpoch(const size_t thread_id, const eid_t epoch_id) = 0;
 
+  // a read-only transaction obtains a snapshot read id without registering in
+  // the epoch, and without writing to memory shared with other threads.
+  virtual cid_t EnterReadOnlyEpoch(const size_t thread_id) = 0;
+
+  virtual void ExitReadOnlyEpoch(const size_t thread_id,
+                                 const eid_t epoch_id) = 0;
+
   virtual eid_t GetExpiredEpochId() = 0;
 
   virtual eid_t GetNextEpochId() = 0;
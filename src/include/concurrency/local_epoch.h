@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <queue>
 #include <vector>
@@ -40,6 +41,15 @@ struct Epoch {
   size_t txn_count_;
 };
 
+// the read-only transactions of one epoch in a local epoch. the state holds
+// their count in the lower 32 bits, a flag that is set while the slot is moved
+// to another epoch, and a generation that changes with every move, so that the
+// epoch id can be read consistently with the count.
+struct ReadOnlySlot {
+  std::atomic<uint64_t> state_ = ATOMIC_VAR_INIT(0);
+  std::atomic<eid_t> epoch_id_ = ATOMIC_VAR_INIT(0);
+};
+
 struct EpochCompare {
   bool operator()(const std::shared_ptr<Epoch> &lhs, const std::shared_ptr<Epoch> &rhs) {
     return lhs->epoch_id_ > rhs->epoch_id_;
@@ -56,6 +66,15 @@ public:
   bool EnterEpoch(const eid_t epoch_id, const TimestampType ts_type);
 
   void ExitEpoch(const eid_t epoch_id);
+
+  // read-only transactions bypass the epoch queue and its lock. they are
+  // counted per epoch in a few slots, so that an epoch is released as soon
+  // as its own read-only transactions are gone. pool threads that work for a
+  // worker share its thread id, so several threads may update a slot at
+  // once; every update is a compare-and-swap of the slot's state.
+  void EnterReadOnlyEpoch(const eid_t epoch_id);
+
+  void ExitReadOnlyEpoch(const eid_t epoch_id);
   
   uint64_t GetExpiredEpochId(const uint64_t current_epoch_id);
 
@@ -68,6 +87,11 @@ private:
   
   std::priority_queue<std::shared_ptr<Epoch>, std::vector<std::shared_ptr<Epoch>>, EpochCompare> epoch_queue_;
   std::unordered_map<uint64_t, std::shared_ptr<Epoch>> epoch_map_;
+
+  // the epochs of the running read-only transactions. an epoch may be spread
+  // over several slots.
+  static const size_t READ_ONLY_SLOT_COUNT = 32;
+  ReadOnlySlot read_only_slots_[READ_ONLY_SLOT_COUNT];
 };
 
 }
@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//===--------------------------------------------------------------------===//
+
+// Silo-style optimistic concurrency control. Writes lock and install versions
+// exactly like timestamp ordering, but reads leave the versions they read
+// untouched: instead of stamping every version with its reader, a transaction
+// obtains its commit id when it commits, and then validates that every version
+// it read is still the latest one and is not locked by another transaction.
+// Read-mostly workloads therefore no longer write to the tuple headers they
+// read.
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance(
+      const ProtocolType protocol,
+      const IsolationLevelType isolation,
+      const ConflictAvoidanceType conflict);
+
+  // This method is used to acquire the ownership of a tuple for a transaction.
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual ResultType CommitTransaction(Transaction *const current_txn);
+
+ protected:
+  virtual bool MarkRead(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id,
+      const bool is_owner);
+
+ private:
+  // Check that no version read by the transaction has been overwritten or
+  // locked by another transaction since it was read.
+  bool ValidateReadSet(Transaction *const current_txn);
+};
+}
+}
@@ -78,6 +78,11 @@ class TimestampOrderingTransactionManager : public TransactionManager {
                              const ItemPointer &location,
                              ItemPointer *index_entry_ptr = nullptr);
 
+  virtual void PerformInserts(
+      Transaction *const current_txn,
+      const std::vector<ItemPointer> &locations,
+      const std::vector<ItemPointer *> &index_entry_ptrs);
+
   virtual bool PerformRead(Transaction *const current_txn,
                            const ItemPointer &location,
                            bool acquire_ownership = false);
@@ -96,10 +101,36 @@ class TimestampOrderingTransactionManager : public TransactionManager {
   virtual void PerformDelete(Transaction *const current_txn,
                              const ItemPointer &location);
 
+  virtual void PerformDeltaUpdate(Transaction *const current_txn,
+                                  const ItemPointer &location,
+                                  storage::DeltaRecord *delta_record);
+
+  virtual bool FoldVersion(const ItemPointer &anchor_location,
+                           const eid_t &expired_eid,
+                           ItemPointer &head_location);
+
   virtual ResultType CommitTransaction(Transaction *const current_txn);
 
   virtual ResultType AbortTransaction(Transaction *const current_txn);
 
+ protected:
+  // This method is called when a serializable transaction reads a version.
+  // Timestamp ordering records the reader's commit id in the version, so that
+  // older transactions can no longer overwrite it. Returns false if the
+  // version is owned by another transaction.
+  virtual bool MarkRead(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id,
+      const bool is_owner);
+
+  // Returns true if an update of the tuple kept as a delta record has
+  // committed after the snapshot of the transaction. Such a tuple can no
+  // longer be written by the transaction.
+  bool HasNewerDelta(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
 
 private:
   static const int LOCK_OFFSET = 0;
@@ -119,10 +150,38 @@ private:
       const cid_t &current_cid, 
       const bool is_owner);
 
+  // In WAIT mode, block until the owner of the version releases it. Returns
+  // false if the transaction should not wait, or if the wait timed out.
+  bool WaitForOwner(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  // In WAIT mode, wake up the transactions waiting for the version.
+  void NotifyOwnerReleased(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  // Install the commit id in the delta records of the owner of the tuple.
+  void CommitDeltaRecords(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id, const cid_t &end_commit_id);
+
+  // Mark the delta records of the owner of the tuple as aborted. Returns
+  // false if the owner has not written any delta record.
+  bool AbortDeltaRecords(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
   // Initiate reserved area of a tuple
   void InitTupleReserved(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t tuple_id);
+
+  // Empty slots do not keep a tile group from being frozen. Thaw the tile
+  // group once an empty slot in it is claimed, unless the freezer is bound
+  // to see the claim when it re-checks the tile group.
+  void ThawClaimedTileGroup(storage::TileGroup *tile_group);
 };
 }
 }
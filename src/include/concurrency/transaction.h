@@ -80,7 +80,10 @@ class Transaction : public Printable {
     
     insert_count_ = 0;
     
-    gc_set_.reset(new GCSet());
+    // read-only transactions never produce garbage.
+    if (isolation != IsolationLevelType::READ_ONLY) {
+      gc_set_.reset(new GCSet());
+    }
   }
 
  public:
@@ -139,7 +142,24 @@ class Transaction : public Printable {
 
   inline std::shared_ptr<GCSet> GetGCSetPtr() { return gc_set_; }
 
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() {
+    return gc_set_ == nullptr || gc_set_->size() == 0;
+  }
+
+  // record a tuple whose delta records the GC should fold once the
+  // transaction has ended.
+  void RecordDeltaUpdate(const ItemPointer &location) {
+    if (delta_set_ == nullptr) {
+      delta_set_.reset(new DeltaSet());
+    }
+    (*delta_set_)[location.block].insert(location.offset);
+  }
+
+  inline std::shared_ptr<DeltaSet> GetDeltaSetPtr() { return delta_set_; }
+
+  inline bool IsDeltaSetEmpty() {
+    return delta_set_ == nullptr || delta_set_->size() == 0;
+  }
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
@@ -185,6 +205,10 @@ class Transaction : public Printable {
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<GCSet> gc_set_;
 
+  // this set contains the tuples that the transaction updated through delta
+  // records. only allocated by such transactions.
+  std::shared_ptr<DeltaSet> delta_set_;
+
   // result of the transaction
   ResultType result_ = ResultType::SUCCESS;
 
@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
@@ -30,6 +31,7 @@ class ItemPointer;
 namespace storage {
 class DataTable;
 class TileGroupHeader;
+struct DeltaRecord;
 }
 
 namespace catalog {
@@ -65,6 +67,14 @@ class TransactionManager {
       const oid_t &tuple_id,
       const VisibilityIdType type = VisibilityIdType::READ_ID);
 
+  // Returns the newest delta record of a visible tuple that the transaction
+  // can see, or nullptr if it sees the tuple slot itself.
+  const storage::DeltaRecord *GetVisibleDelta(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id,
+      const VisibilityIdType type = VisibilityIdType::READ_ID);
+
   // This method test whether the current transaction is the owner of this version.
   virtual bool IsOwner(
       Transaction *const current_txn, 
@@ -108,6 +118,18 @@ class TransactionManager {
                              const ItemPointer &location, 
                              ItemPointer *index_entry_ptr = nullptr) = 0;
 
+  // Perform the inserts of a batch of tuples. index_entry_ptrs holds the head
+  // pointer of every tuple, or is empty if the table has no index.
+  virtual void PerformInserts(
+      Transaction *const current_txn,
+      const std::vector<ItemPointer> &locations,
+      const std::vector<ItemPointer *> &index_entry_ptrs) {
+    for (size_t i = 0; i < locations.size(); ++i) {
+      PerformInsert(current_txn, locations[i],
+                    index_entry_ptrs.empty() ? nullptr : index_entry_ptrs[i]);
+    }
+  }
+
   virtual bool PerformRead(Transaction *const current_txn, 
                            const ItemPointer &location,
                            bool acquire_ownership = false) = 0;
@@ -126,6 +148,21 @@ class TransactionManager {
   virtual void PerformDelete(Transaction *const current_txn, 
                              const ItemPointer &location) = 0;
 
+  // Record an update of a tuple that is kept as a delta record. The current
+  // transaction must own the tuple.
+  virtual void PerformDeltaUpdate(Transaction *const current_txn,
+                                  const ItemPointer &location,
+                                  storage::DeltaRecord *delta_record) = 0;
+
+  // Move the newest version of a tuple of a table with a version store back
+  // into the tuple's slot in the table's tile groups, once every transaction
+  // that may read an older version has ended. Returns false if the version
+  // cannot be moved yet. Otherwise head_location is the retired version, or
+  // null if the tuple has been deleted, so that its slot can be reclaimed.
+  virtual bool FoldVersion(const ItemPointer &anchor_location,
+                           const eid_t &expired_eid,
+                           ItemPointer &head_location) = 0;
+
   void SetTransactionResult(Transaction *const current_txn, const ResultType result) {
     current_txn->SetResult(result);
   }
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
+#include "concurrency/optimistic_transaction_manager.h"
 
 namespace peloton {
 namespace concurrency {
@@ -25,6 +26,9 @@ class TransactionManagerFactory {
       case ProtocolType::TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance(protocol_, isolation_level_, conflict_avoidance_);
 
+      case ProtocolType::OPTIMISTIC:
+        return OptimisticTransactionManager::GetInstance(protocol_, isolation_level_, conflict_avoidance_);
+
       default:
         return TimestampOrderingTransactionManager::GetInstance(protocol_, isolation_level_, conflict_avoidance_);
     }
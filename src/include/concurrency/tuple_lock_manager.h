@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tuple_lock_manager.h
+//
+// Identification: src/include/concurrency/tuple_lock_manager.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "common/platform.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace storage {
+class TileGroupHeader;
+}
+
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// Tuple Lock Manager
+//===--------------------------------------------------------------------===//
+
+// The tuple lock manager lets a transaction wait for the owner of a version
+// to release it, which is how the WAIT conflict avoidance mode is implemented.
+// The owner is still the txn_id field of the tuple header; the lock manager
+// only keeps the wait queues. The versions are hashed to a fixed number of
+// queues, so the tuple headers need no extra space. A version that nobody
+// waits for costs its owner a single load when it is released.
+class TupleLockManager {
+ public:
+  static TupleLockManager &GetInstance();
+
+  // Block until the transaction owner_id no longer owns the version, or the
+  // timeout expires. Returns true if the version was released.
+  bool WaitForRelease(const storage::TileGroupHeader *const tile_group_header,
+                      const oid_t &tuple_id, const txn_id_t &owner_id);
+
+  // Wake up the transactions waiting for the version. Must be called after
+  // the owner has been cleared from the tuple header.
+  void NotifyRelease(const storage::TileGroupHeader *const tile_group_header,
+                     const oid_t &tuple_id);
+
+  void SetTimeout(const uint64_t timeout_us) { timeout_us_ = timeout_us; }
+
+  uint64_t GetTimeout() const { return timeout_us_; }
+
+ private:
+  TupleLockManager() : timeout_us_(DEFAULT_TIMEOUT_US) {}
+
+  struct CACHE_ALIGNED WaitQueue {
+    WaitQueue() : waiter_count(0) {}
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::atomic<uint32_t> waiter_count;
+  };
+
+  WaitQueue &GetWaitQueue(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  static const size_t WAIT_QUEUE_COUNT = 1024;
+
+  // how long a transaction waits before it gives up and aborts.
+  static const uint64_t DEFAULT_TIMEOUT_US = 10000;
+
+  WaitQueue wait_queues_[WAIT_QUEUE_COUNT];
+
+  std::atomic<uint64_t> timeout_us_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
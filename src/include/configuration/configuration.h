@@ -43,6 +43,9 @@ DECLARE_string(certificate_file);
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+// NUMA-aware placement
+DECLARE_bool(numa_aware);
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -75,12 +78,37 @@ DECLARE_bool(index_tuner);
 // Enable or disable layout tuner
 DECLARE_bool(layout_tuner);
 
+// Enable or disable tile group freezer
+DECLARE_bool(tile_group_freezer);
+
+//===----------------------------------------------------------------------===//
+// TRANSACTIONS
+//===----------------------------------------------------------------------===//
+
+// Run single-statement SELECTs as read-only snapshot transactions
+DECLARE_bool(read_only_snapshot);
+
 //===----------------------------------------------------------------------===//
 // CODEGEN
 //===----------------------------------------------------------------------===//
 
 DECLARE_bool(codegen);
 
+// Number of compiled queries kept in memory
+DECLARE_uint64(codegen_cache_size);
+
+// Directory of the compiled queries kept on disk
+DECLARE_string(codegen_cache_dir);
+
+// Interpret queries first, and compile the hot ones in the background
+DECLARE_bool(codegen_tiering);
+
+// Interpreted executions after which a query is compiled
+DECLARE_uint64(codegen_tiering_executions);
+
+// Interpreted time (in ms) after which a query is compiled
+DECLARE_double(codegen_tiering_ms);
+
 //===----------------------------------------------------------------------===//
 // GENERAL
 //===----------------------------------------------------------------------===//
@@ -47,6 +47,12 @@ class LockFreeQueue {
     return queue_.try_dequeue(item);
   }
 
+  // Dequeues at most max_count items into items, returning the number of
+  // items dequeued
+  size_t DequeueBulk(T *items, const size_t &max_count) {
+    return queue_.try_dequeue_bulk(items, max_count);
+  }
+
   bool IsEmpty() {
     return queue_.size_approx() == 0;
   }
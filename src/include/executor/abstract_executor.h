@@ -27,6 +27,7 @@ class AbstractPlan;
 
 namespace executor {
 class ExecutorContext;
+class QueryProfile;
 }
 
 namespace executor {
@@ -112,6 +113,9 @@ class AbstractExecutor {
   std::vector<AbstractExecutor *> children_;
 
  private:
+  // Execute() when the query is profiled
+  bool ProfiledExecute();
+
   // Output logical tile
   // This is where we will write the results of the plan node's execution
   std::unique_ptr<LogicalTile> output;
@@ -119,6 +123,11 @@ class AbstractExecutor {
   /** @brief Plan node corresponding to this executor. */
   const planner::AbstractPlan *node_ = nullptr;
 
+  // The profile of the query (EXPLAIN ANALYZE), and the operator of this
+  // executor in it
+  QueryProfile *profile_ = nullptr;
+  oid_t profile_operator_id_ = INVALID_OID;
+
  protected:
   // Executor context
   ExecutorContext *executor_context_ = nullptr;
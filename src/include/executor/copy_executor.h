@@ -19,6 +19,7 @@
 #include "wire/packet_manager.h"
 
 #define COPY_BUFFER_SIZE 65536
+#define COPY_CHUNK_SIZE (1 << 20)
 #define INVALID_COL_ID -1
 
 namespace peloton {
@@ -38,6 +39,8 @@ class CopyExecutor : public AbstractExecutor {
 
   inline size_t GetTotalBytesWritten() { return total_bytes_written; }
 
+  inline size_t GetTotalBytesRead() { return total_bytes_read; }
+
  protected:
   bool DInit();
 
@@ -56,6 +59,12 @@ class CopyExecutor : public AbstractExecutor {
   // Copy and escape the content of column to local buffer
   void Copy(const char *data, int len, bool end_of_line);
 
+  // COPY FROM: bulk load the input file or the client's data
+  bool DExecuteImport();
+
+  // Bulk load the input into the target table
+  bool Import(const char *data, size_t size);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -84,6 +93,9 @@ class CopyExecutor : public AbstractExecutor {
   // Total number of bytes written
   size_t total_bytes_written = 0;
 
+  // Total number of bytes loaded
+  size_t total_bytes_read = 0;
+
   // The special column ids in query_metric table
   unsigned int num_param_col_id =
       catalog::QueryMetricsCatalog::ColumnId::NUM_PARAMS;
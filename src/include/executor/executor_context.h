@@ -26,6 +26,8 @@ class Transaction;
 
 namespace executor {
 
+class QueryProfile;
+
 //===--------------------------------------------------------------------===//
 // Executor Context
 //===--------------------------------------------------------------------===//
@@ -55,6 +57,13 @@ class ExecutorContext {
   // Get a pool
   type::EphemeralPool *GetPool();
 
+  // The profile the executors report into (EXPLAIN ANALYZE), or null
+  QueryProfile *GetQueryProfile() const { return query_profile_; }
+
+  void SetQueryProfile(QueryProfile *query_profile) {
+    query_profile_ = query_profile;
+  }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -72,6 +81,9 @@ class ExecutorContext {
   // pool
   std::unique_ptr<type::EphemeralPool> pool_;
 
+  // profile of the query, not owned
+  QueryProfile *query_profile_ = nullptr;
+
 };
 
 }  // namespace executor
@@ -28,6 +28,7 @@
 #include "executor/nested_loop_join_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/hash_join_executor.h"
+#include "executor/index_join_executor.h"
 #include "executor/hash_executor.h"
 #include "executor/order_by_executor.h"
 #include "executor/hash_set_op_executor.h"
@@ -17,6 +17,7 @@
 #include "index/index.h"
 #include "executor/abstract_scan_executor.h"
 #include "planner/hybrid_scan_plan.h"
+#include "planner/seq_scan_plan.h"
 
 #include <set>
 
@@ -93,6 +94,17 @@ class HybridScanExecutor : public AbstractScanExecutor {
   std::set<ItemPointer> item_pointers_;
 
   oid_t block_threshold = 0;
+
+  //===--------------------------------------------------------------------===//
+  // Versioned Tables
+  //===--------------------------------------------------------------------===//
+
+  // The scans above read the tuple slots directly. Tables that keep newer
+  // versions in delta records or in a version store are scanned by a
+  // sequential scan executor instead, which reads the visible versions.
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_plan_;
+
+  std::unique_ptr<AbstractExecutor> seq_scan_executor_;
 };
 
 }  // namespace executor
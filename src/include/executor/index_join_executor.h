@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_executor.h
+//
+// Identification: src/include/executor/index_join_executor.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_join_executor.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class DataTable;
+class Tile;
+class TileGroup;
+class Tuple;
+}
+
+namespace executor {
+
+/**
+ * An index nested-loop join. The executor has a single (outer) child. The
+ * keys of all tuples of an outer tile are looked up in the index of the inner
+ * table in one batch, and the matching inner tuples are joined with the outer
+ * tuples that produced their keys.
+ */
+class IndexJoinExecutor : public AbstractJoinExecutor {
+  IndexJoinExecutor(const IndexJoinExecutor &) = delete;
+  IndexJoinExecutor &operator=(const IndexJoinExecutor &) = delete;
+
+ public:
+  explicit IndexJoinExecutor(const planner::AbstractPlan *node,
+                             ExecutorContext *executor_context);
+
+ protected:
+  bool DInit();
+  bool DExecute();
+
+ private:
+  // A visible inner tuple matching the key of an outer tuple
+  struct Match {
+    oid_t block;
+    oid_t offset;
+    oid_t left_row;
+    // Whether the match is a version rebuilt from the delta records of the
+    // slot rather than the slot itself
+    bool is_version;
+  };
+
+  // Look up the keys of the left tile and build the result tiles
+  bool ProbeIndex(LogicalTile *left_tile);
+
+  // Find the version of the tuple that is visible to the transaction. Returns
+  // false if the transaction has to abort
+  bool FindVisibleVersion(ItemPointer tuple_location, ItemPointer &visible);
+
+  // Rebuild the visible version of a delta table tuple. Returns nullptr if
+  // the slot itself is visible
+  std::unique_ptr<storage::Tuple> RebuildVersion(
+      const std::shared_ptr<storage::TileGroup> &tile_group,
+      const ItemPointer &tuple_location,
+      std::map<oid_t, std::shared_ptr<storage::Tile>> &version_tiles);
+
+  // Check that the visible version still has the key it was found with
+  bool CheckKey(const AbstractTuple &tuple, const storage::Tuple &key);
+
+  //===--------------------------------------------------------------------===//
+  // Plan Info
+  //===--------------------------------------------------------------------===//
+
+  storage::DataTable *table_ = nullptr;
+
+  std::shared_ptr<index::Index> index_;
+
+  // The expressions producing the index key from an outer tuple
+  std::vector<const expression::AbstractExpression *> outer_keys_;
+
+  // The columns of the inner table that form the right side of the join
+  std::vector<oid_t> column_ids_;
+
+  const expression::AbstractExpression *inner_predicate_ = nullptr;
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  // The current outer tile
+  std::unique_ptr<LogicalTile> left_tile_;
+
+  // The result tiles of the current outer tile, and the next one to return
+  std::vector<std::unique_ptr<LogicalTile>> result_tiles_;
+  size_t result_itr_ = 0;
+};
+
+}  // namespace executor
+}  // namespace peloton
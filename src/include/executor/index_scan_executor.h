@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <map>
+#include <set>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -25,6 +27,9 @@ class Index;
 
 namespace storage {
 class AbstractTable;
+class Tile;
+class TileGroup;
+class Tuple;
 }
 
 namespace executor {
@@ -67,6 +72,16 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // conditions on key columns
   bool CheckKeyConditions(const ItemPointer &tuple_location);
 
+  // Rebuild the visible version of a tuple that is newer than its tuple slot
+  // into the version tile of the tile group. Returns nullptr if the tuple
+  // slot holds the visible version.
+  std::unique_ptr<storage::Tuple> RebuildVersion(
+      const std::shared_ptr<storage::TileGroup> &tile_group,
+      const ItemPointer &tuple_location);
+
+  // Construct the logical tiles for the visible tuples of a tile group.
+  void AddResultTiles(const oid_t tile_group_id, std::vector<oid_t> &offsets);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -80,6 +95,11 @@ class IndexScanExecutor : public AbstractScanExecutor {
   /** @brief Computed the result */
   bool done_ = false;
 
+  /** @brief Tiles holding the versions rebuilt from delta records, by tile
+   *  group id, and the locations of those versions. */
+  std::map<oid_t, std::shared_ptr<storage::Tile>> version_tiles_;
+  std::set<ItemPointer> version_locations_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -42,6 +42,14 @@ class LogicalTileFactory {
 
   static LogicalTile *WrapTileGroup(
       const std::shared_ptr<storage::TileGroup> &tile_group);
+
+  static std::shared_ptr<storage::Tile> GetVersionTile(
+      const std::shared_ptr<storage::TileGroup> &tile_group);
+
+  static LogicalTile *WrapVersionTile(
+      const std::shared_ptr<storage::Tile> &version_tile,
+      const std::vector<oid_t> &column_ids,
+      std::vector<oid_t> &&position_list);
 };
 
 }  // namespace executor
@@ -20,6 +20,8 @@
 namespace peloton {
 namespace executor {
 
+class QueryProfile;
+
 //===----------------------------------------------------------------------===//
 // Plan Executor
 //===----------------------------------------------------------------------===//
@@ -66,12 +68,15 @@ class PlanExecutor {
    * for networking
    * Before ExecutePlan, a node first receives value list, so we should
    * pass value list directly rather than passing Postgres's ParamListInfo
+   * When given a profile (EXPLAIN ANALYZE), the time and output of every
+   * operator of the plan are recorded into it.
    */
   static ExecuteResult ExecutePlan(const planner::AbstractPlan *plan,
                                     concurrency::Transaction* txn,
                                     const std::vector<type::Value> &params,
                                     std::vector<StatementResult> &result,
-                                    const std::vector<int> &result_format);
+                                    const std::vector<int> &result_format,
+                                    QueryProfile *profile = nullptr);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
@@ -27,8 +27,8 @@ namespace executor {
 /**
  * The executor class that populates a newly created index
  *
- * It should have a SeqScanExecutor as a child, for retrieving data
- * to be inputted the index. 
+ * Its child creates the index, which is then built over the tuples of the
+ * table in parallel (see storage::DataTable::BuildIndex()).
  */
 class PopulateIndexExecutor : public AbstractExecutor {
  public:
@@ -47,9 +47,6 @@ class PopulateIndexExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
-  /** @brief Input tiles from child node */
-  std::vector<std::unique_ptr<LogicalTile>> child_tiles_;
-
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -57,6 +54,7 @@ class PopulateIndexExecutor : public AbstractExecutor {
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
   std::vector<oid_t> column_ids_;
+  std::string index_name_;
   bool done_ = false;
 };
 
@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_profile.h
+//
+// Identification: src/include/executor/query_profile.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace planner {
+class AbstractPlan;
+}
+
+namespace executor {
+
+class HardwareCounters;
+
+//===--------------------------------------------------------------------===//
+// Query Profile
+//===--------------------------------------------------------------------===//
+
+/**
+ * The execution profile of one plan tree, as reported by EXPLAIN ANALYZE.
+ *
+ * Every plan node gets an operator, identified by its preorder position in
+ * the tree. The interpreted executors and the compiled query report into the
+ * operators while the query runs; nothing is recorded (or generated) when a
+ * query runs without a profile.
+ *
+ * Operator times are inclusive: they contain the time spent in the children
+ * the operator pulls from (interpreted) or drives (compiled). The report
+ * also shows the exclusive time of every operator.
+ *
+ * A profile is only used by the thread that executes the query.
+ */
+class QueryProfile {
+ public:
+  struct OperatorProfile {
+    const planner::AbstractPlan *plan;
+
+    // Depth in the plan tree, and the children operators
+    uint32_t depth;
+    std::vector<uint32_t> children;
+
+    // The pipeline of the operator in the compiled query
+    uint32_t pipeline_id;
+
+    // Number of Execute() calls, or of runs of the compiled operator
+    uint64_t calls = 0;
+
+    // Output of the operator
+    uint64_t tiles_out = 0;
+    uint64_t rows_out = 0;
+
+    // Inclusive wall time and hardware counters
+    double time_ms = 0.0;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+
+    // State of the running call
+    std::chrono::steady_clock::time_point start_time;
+    uint64_t start_cycles = 0;
+    uint64_t start_instructions = 0;
+  };
+
+  QueryProfile(const planner::AbstractPlan *plan, bool hardware_counters);
+  ~QueryProfile();
+
+  //===--------------------------------------------------------------------===//
+  // RECORDING
+  //===--------------------------------------------------------------------===//
+
+  // Returns the operator of the plan node, or INVALID_OID if the node isn't
+  // part of the profiled plan tree
+  oid_t GetOperatorId(const planner::AbstractPlan *plan) const;
+
+  // Brackets one run of the operator
+  void StartOperator(oid_t operator_id);
+  void StopOperator(oid_t operator_id);
+
+  // Counts the output of the operator
+  inline void CountOutput(oid_t operator_id, uint64_t rows, uint64_t tiles) {
+    auto &op = operators_[operator_id];
+    op.rows_out += rows;
+    op.tiles_out += tiles;
+  }
+
+  // The compiled query runs the plan as pipelines of operators
+  oid_t AddPipeline(const std::string &info);
+  void SetOperatorPipeline(oid_t operator_id, oid_t pipeline_id);
+
+  // How the query was executed, and what compiling it cost
+  void SetCompiled(double setup_ms, double ir_gen_ms, double jit_ms);
+
+  // Total execution time of the query
+  void SetExecutionTime(double execution_ms) { execution_ms_ = execution_ms; }
+
+  //===--------------------------------------------------------------------===//
+  // REPORTING
+  //===--------------------------------------------------------------------===//
+
+  const OperatorProfile &GetOperator(oid_t operator_id) const {
+    return operators_[operator_id];
+  }
+
+  size_t GetOperatorCount() const { return operators_.size(); }
+
+  // Sum of the rows output by the children of the operator
+  uint64_t GetRowsIn(oid_t operator_id) const;
+
+  // Time of the operator, minus the time of its children
+  double GetExclusiveTime(oid_t operator_id) const;
+
+  // The lines of the EXPLAIN output: the plan tree only, or the plan tree
+  // with its profile (EXPLAIN ANALYZE)
+  std::vector<std::string> GetReport(bool analyze) const;
+
+ private:
+  void AddOperator(const planner::AbstractPlan *plan, uint32_t depth);
+
+  // Time of the children of the operator that ran
+  double GetChildrenTime(oid_t operator_id) const;
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // The operators, in preorder
+  std::vector<OperatorProfile> operators_;
+
+  std::unordered_map<const planner::AbstractPlan *, oid_t> operator_ids_;
+
+  // The pipelines of the compiled query
+  std::vector<std::string> pipelines_;
+
+  // Compilation
+  bool compiled_ = false;
+  double setup_ms_ = 0.0;
+  double ir_gen_ms_ = 0.0;
+  double jit_ms_ = 0.0;
+
+  double execution_ms_ = 0.0;
+
+  // Open when the hardware counters are collected and available
+  std::unique_ptr<HardwareCounters> hardware_counters_;
+  bool collect_hardware_counters_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -12,10 +12,19 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "executor/abstract_scan_executor.h"
 #include "planner/seq_scan_plan.h"
 
 namespace peloton {
+
+namespace storage {
+class CompressedTileGroup;
+class TileGroupHeader;
+}
+
 namespace executor {
 
 class SeqScanExecutor : public AbstractScanExecutor {
@@ -31,7 +40,10 @@ class SeqScanExecutor : public AbstractScanExecutor {
   void UpdatePredicate(const std::vector<oid_t> &column_ids,
                        const std::vector<type::Value> &values) override;
 
-  void ResetState() { current_tile_group_offset_ = START_OID; }
+  void ResetState() {
+    current_tile_group_offset_ = START_OID;
+    version_outputs_.clear();
+  }
 
  protected:
   bool DInit();
@@ -50,6 +62,15 @@ class SeqScanExecutor : public AbstractScanExecutor {
   expression::AbstractExpression *ColumnValueToCmpExpr(
       const oid_t column_id, const type::Value &value);
 
+  ItemPointer FindVisibleVersion(
+      const storage::TileGroupHeader *tile_group_header,
+      const ItemPointer &tuple_location) const;
+
+  bool EvaluateCompressedPredicate(
+      const storage::CompressedTileGroup *compressed_tile_group,
+      const expression::AbstractExpression *predicate,
+      std::vector<bool> &matches) const;
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -60,6 +81,15 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Order of the tile groups to scan, socket-local ones first.
+   *  Empty if the table is not placed by NUMA node. */
+  std::vector<oid_t> tile_group_order_;
+
+  /** @brief Versions rebuilt from delta records or kept in the version
+   *  store, returned after the logical tile of the tile group whose tuples
+   *  they belong to. */
+  std::vector<std::unique_ptr<LogicalTile>> version_outputs_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -42,6 +42,12 @@ class UpdateExecutor : public AbstractExecutor {
                                oid_t physical_tuple_id,
                                ItemPointer &old_location);
 
+  bool PerformDeltaUpdate(bool is_owner,
+                          storage::TileGroup *tile_group,
+                          storage::TileGroupHeader *tile_group_header,
+                          oid_t physical_tuple_id,
+                          ItemPointer &old_location);
+
   bool DInit();
 
   bool DExecute();
@@ -64,6 +64,12 @@ class GCManager {
     return INVALID_ITEMPOINTER;
   }
 
+  // returns a free slot of the version tile groups of a table, if one exists
+  virtual ItemPointer ReturnFreeVersionSlot(
+      const oid_t &table_id UNUSED_ATTRIBUTE) {
+    return INVALID_ITEMPOINTER;
+  }
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
@@ -74,6 +80,11 @@ class GCManager {
                                   const eid_t &epoch_id UNUSED_ATTRIBUTE, 
                                   const size_t &thread_id UNUSED_ATTRIBUTE) {}
 
+  virtual void RecycleDeltaRecords(
+      std::shared_ptr<DeltaSet> delta_set UNUSED_ATTRIBUTE,
+      const eid_t &epoch_id UNUSED_ATTRIBUTE,
+      const size_t &thread_id UNUSED_ATTRIBUTE) {}
+
  protected:
   void CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id);
 
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <map>
@@ -27,10 +29,19 @@
 #include "container/lock_free_queue.h"
 
 namespace peloton {
+
+namespace storage {
+struct DeltaRecord;
+}
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
+#define FREE_SLOT_BATCH_SIZE 64
+// a thread that has not taken a free slot for this long gives the slots it
+// cached back to the tables
+#define FREE_SLOT_IDLE_PERIOD_MS 100
 
 
 struct GarbageContext {
@@ -40,16 +51,28 @@ struct GarbageContext {
     gc_set_ = gc_set;
     epoch_id_ = epoch_id;
   }
+  GarbageContext(std::shared_ptr<DeltaSet> delta_set,
+                 const eid_t &epoch_id) {
+    delta_set_ = delta_set;
+    epoch_id_ = epoch_id;
+  }
 
   std::shared_ptr<GCSet> gc_set_;
   eid_t epoch_id_;
+
+  // tuples whose delta records are folded once the epoch has expired, and
+  // the records detached from them, which are freed once no transaction can
+  // still walk them.
+  std::shared_ptr<DeltaSet> delta_set_;
+  std::vector<storage::DeltaRecord *> delta_records_;
 };
 
 class TransactionLevelGCManager : public GCManager {
 public:
   TransactionLevelGCManager(const int thread_count) 
     : gc_thread_count_(thread_count),
-      reclaim_maps_(thread_count) {
+      reclaim_maps_(thread_count),
+      table_version_(0) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -93,13 +116,22 @@ public:
 
   virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set, const eid_t &epoch_id, const size_t &thread_id) override;
 
+  virtual void RecycleDeltaRecords(std::shared_ptr<DeltaSet> delta_set,
+                                   const eid_t &epoch_id,
+                                   const size_t &thread_id) override;
+
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual ItemPointer ReturnFreeVersionSlot(const oid_t &table_id) override;
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
       std::shared_ptr<LockFreeQueue<ItemPointer>> recycle_queue(new LockFreeQueue<ItemPointer>(MAX_QUEUE_LENGTH));
       recycle_queue_map_[table_id] = recycle_queue;
+
+      std::shared_ptr<LockFreeQueue<ItemPointer>> version_recycle_queue(new LockFreeQueue<ItemPointer>(MAX_QUEUE_LENGTH));
+      version_recycle_queue_map_[table_id] = version_recycle_queue;
     }
   }
 
@@ -107,6 +139,12 @@ public:
     // Remove dropped tables
     if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
       recycle_queue_map_.erase(table_id);
+      version_recycle_queue_map_.erase(table_id);
+      // the free slots that threads cached for the table are now invalid
+      table_version_++;
+
+      std::lock_guard<std::mutex> lock(pending_anchors_mutex_);
+      pending_anchors_.erase(table_id);
     }
   }
 
@@ -118,6 +156,14 @@ public:
 
   int Reclaim(const int &thread_id, const eid_t &expired_eid);
 
+  // Retry the superseded tuple slots of tables with a version store, once per
+  // expired epoch. Returns the number of tuple slots that were folded.
+  int RetryPendingAnchors(const int &thread_id, const eid_t &expired_eid);
+
+  // Give the free slots cached by the threads that have not taken one since
+  // the previous call back to the tables. Returns the number of slots.
+  size_t ReturnIdleFreeSlots();
+
 private:
 
   inline unsigned int HashToThread(const size_t &thread_id) {
@@ -128,10 +174,30 @@ private:
 
   void Running(const int &thread_id);
 
-  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
+  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx,
+                       const int &thread_id, const eid_t &expired_eid);
+
+  bool FoldAnchor(const oid_t &table_id, const ItemPointer &anchor_location,
+                  const eid_t &expired_eid, GCSet &retired_versions);
+
+  void RetryPendingAnchor(const oid_t &table_id, ItemPointer *indirection,
+                          const eid_t &expired_eid, GCSet &retired_versions);
 
+  bool RefillFreeSlots(const oid_t &table_id,
+                       std::vector<ItemPointer> &free_slots);
+
+  void FlushFreeSlots(std::unordered_map<oid_t, std::vector<ItemPointer>>
+                          &free_slot_map);
+
+  // Returns false if the slot is held by the layout tuner, in which case it
+  // has to be reset again once the tuner releases it.
   bool ResetTuple(const ItemPointer &);
 
+  void FoldDeltaRecords(const std::shared_ptr<GarbageContext> &garbage_ctx,
+                        const eid_t &expired_eid);
+
+  void FreeDeltaRecords(const std::shared_ptr<GarbageContext> &garbage_ctx);
+
   void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
 
   void DeleteTupleFromIndexes(const ItemPointer location);
@@ -161,6 +227,49 @@ private:
   // # recycle_queue_maps == # tables
   std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
 
+  // queues for to-be-reused slots of the version tile groups.
+  // # version_recycle_queue_maps == # tables
+  std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> version_recycle_queue_map_;
+
+  // the superseded tuple slots of tables with a version store, whose newest
+  // version could not be moved back yet. they are keyed by table and by the
+  // head pointer of their version chain, and are retried whenever another
+  // version of the same tuple is reclaimed, and whenever another epoch has
+  // expired.
+  std::unordered_map<oid_t, std::unordered_map<ItemPointer *, ItemPointer>> pending_anchors_;
+
+  // the expired epoch at which the pending anchors were last retried.
+  eid_t pending_anchors_eid_ = 0;
+
+  std::mutex pending_anchors_mutex_;
+
+  // bumped whenever a table is deregistered, so that every thread drops the
+  // free slots it cached before.
+  std::atomic<uint64_t> table_version_;
+
+  // every inserting thread caches a batch of free slots per table, so that
+  // the threads only touch the shared recycle queues once per batch.
+  struct LocalFreeSlots {
+    LocalFreeSlots();
+    ~LocalFreeSlots();
+
+    // held by the owning thread while it takes a slot, and by the GC while it
+    // returns the slots of an idle thread.
+    std::mutex mutex;
+    // whether a slot was taken since the GC last checked
+    bool used;
+    uint64_t table_version;
+    std::unordered_map<oid_t, std::vector<ItemPointer>> free_slot_map;
+  };
+
+  static thread_local LocalFreeSlots local_free_slots_;
+
+  // the caches of all threads, so that the slots of the threads that stopped
+  // inserting are not stranded.
+  std::vector<LocalFreeSlots *> local_free_slot_caches_;
+
+  std::mutex local_free_slot_caches_mutex_;
+
 };
 }
 }
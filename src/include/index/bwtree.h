@@ -159,6 +159,9 @@ extern bool print_flag;
 
 #define PREALLOCATE_THREAD_NUM ((size_t)1024)
 
+// The number of keys whose traversals are interleaved in a batched lookup
+#define BATCH_LOOKUP_GROUP_SIZE ((size_t)32)
+
 /*
  * InnerInlineAllocateOfType() - allocates a chunk of memory from base node and
  *                               initialize it using placement new and then 
@@ -7664,6 +7667,322 @@ before_switch:
     return value_set;
   }
   
+  /*
+   * GetValueBatch() - Looks up a batch of keys with interleaved traversals
+   *
+   * A single lookup stalls on a cache miss at every level of the tree: first
+   * on the mapping table entry, and then on the node. Instead, the keys of a
+   * group descend the tree together, one level at a time. The mapping table
+   * entries of the whole group are prefetched before any of them is read,
+   * and all nodes of a level are prefetched before any of them is searched,
+   * so the misses of the group overlap (group prefetching).
+   *
+   * Only consolidated nodes are searched on this path. A key that reaches a
+   * delta chain, or a node that no longer covers it, is looked up through
+   * GetValue() after the group, which handles all node types. Following the
+   * right sibling is not needed for correctness since that path does it.
+   *
+   * The values of key_p[i] are appended to value_list_p[i]
+   */
+  void GetValueBatch(const KeyType *key_p,
+                     size_t key_count,
+                     std::vector<ValueType> *value_list_p) {
+    bwt_printf("GetValueBatch() %lu keys\n", key_count);
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // Current node of each key in the group, and the keys still descending
+    NodeID node_id_list[BATCH_LOOKUP_GROUP_SIZE];
+    const BaseNode *node_p_list[BATCH_LOOKUP_GROUP_SIZE];
+    size_t active_list[BATCH_LOOKUP_GROUP_SIZE];
+    size_t fallback_list[BATCH_LOOKUP_GROUP_SIZE];
+
+    for(size_t group_start = 0;
+        group_start < key_count;
+        group_start += BATCH_LOOKUP_GROUP_SIZE) {
+      const size_t group_size = std::min(key_count - group_start,
+                                         BATCH_LOOKUP_GROUP_SIZE);
+      const KeyType *group_key_p = key_p + group_start;
+      std::vector<ValueType> *group_value_list_p = value_list_p + group_start;
+
+      size_t active_count = group_size;
+      size_t fallback_count = 0;
+      const NodeID start_node_id = root_id.load();
+      for(size_t i = 0;i < group_size;i++) {
+        node_id_list[i] = start_node_id;
+        active_list[i] = i;
+      }
+
+      while(active_count > 0) {
+        // 1. Load the nodes of the level, and prefetch their headers and
+        //    the first (64 byte) cache line of their items
+        for(size_t j = 0;j < active_count;j++) {
+          size_t i = active_list[j];
+          node_p_list[i] = GetNode(node_id_list[i]);
+          __builtin_prefetch(node_p_list[i]);
+          __builtin_prefetch(reinterpret_cast<const char *>(node_p_list[i]) + \
+                             64);
+        }
+
+        // 2. Search the nodes, and prefetch the mapping table entries of the
+        //    next level
+        size_t next_active_count = 0;
+        for(size_t j = 0;j < active_count;j++) {
+          size_t i = active_list[j];
+          const KeyType &search_key = group_key_p[i];
+          const BaseNode *node_p = node_p_list[i];
+          NodeType type = node_p->GetType();
+
+          if(((type != NodeType::InnerType) && \
+              (type != NodeType::LeafType)) || \
+             ((node_p->GetNextNodeID() != INVALID_NODE_ID) && \
+              (KeyCmpGreaterEqual(search_key, node_p->GetHighKey())))) {
+            fallback_list[fallback_count++] = i;
+            continue;
+          }
+
+          if(type == NodeType::InnerType) {
+            const InnerNode *inner_node_p = \
+              static_cast<const InnerNode *>(node_p);
+            NodeID child_node_id = \
+              LocateSeparatorByKey(search_key,
+                                   inner_node_p,
+                                   inner_node_p->Begin() + 1,
+                                   inner_node_p->End());
+
+            node_id_list[i] = child_node_id;
+            __builtin_prefetch(&mapping_table[child_node_id]);
+            active_list[next_active_count++] = i;
+            continue;
+          }
+
+          const LeafNode *leaf_node_p = static_cast<const LeafNode *>(node_p);
+          auto copy_start_it = \
+            std::lower_bound(leaf_node_p->Begin(),
+                             leaf_node_p->End(),
+                             std::make_pair(search_key, ValueType{}),
+                             key_value_pair_cmp_obj);
+          while((copy_start_it != leaf_node_p->End()) && \
+                (KeyCmpEqual(search_key, copy_start_it->first))) {
+            group_value_list_p[i].push_back(copy_start_it->second);
+            copy_start_it++;
+          }
+        }
+
+        active_count = next_active_count;
+      }
+
+      for(size_t j = 0;j < fallback_count;j++) {
+        size_t i = fallback_list[j];
+        Context context{group_key_p[i]};
+        TraverseReadOptimized(&context, &group_value_list_p[i]);
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Load Interface
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * BulkLoad() - Builds an empty tree bottom-up from sorted key-value pairs
+   *
+   * The pairs must be sorted by key, and must not contain the same key-value
+   * pair twice. Instead of inserting one pair at a time (which posts a delta
+   * record for each pair and consolidates and splits nodes over and over),
+   * this function cuts the pairs into leaf nodes, and builds the inner levels
+   * from the low keys of the level below until the level fits into the root.
+   * Nodes are filled to 3/4 of the split threshold to leave room for later
+   * inserts, and all values of a key stay on the same leaf node.
+   *
+   * The new nodes are invisible until the first leaf node and the root node
+   * are replaced, so concurrent readers either see the empty tree or the
+   * loaded one. There must not be concurrent modifications.
+   *
+   * If the tree is not empty then it is left as is and the return value is
+   * false
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &sorted_items) {
+    bwt_printf("BulkLoad() %lu items\n", sorted_items.size());
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    // An empty tree is an inner root with only the first leaf node, which
+    // has no delta record
+    const NodeID old_root_id = root_id.load();
+    const BaseNode *old_root_p = GetNode(old_root_id);
+    const BaseNode *old_first_leaf_p = GetNode(first_leaf_id);
+    if((old_root_p->GetType() != NodeType::InnerType) || \
+       (old_root_p->GetItemCount() != 1) || \
+       (old_first_leaf_p->GetType() != NodeType::LeafType) || \
+       (old_first_leaf_p->GetItemCount() != 0)) {
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return false;
+    }
+
+    if(sorted_items.empty() == true) {
+      epoch_manager.LeaveEpoch(epoch_node_p);
+
+      return true;
+    }
+
+    const size_t item_count = sorted_items.size();
+
+    // 1. Cut the items into leaf nodes at key boundaries. The last element
+    //    is the end of the last leaf node
+    const size_t leaf_fill = LEAF_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    std::vector<size_t> leaf_starts{};
+    size_t start = 0;
+    while(start < item_count) {
+      leaf_starts.push_back(start);
+
+      size_t end = std::min(start + leaf_fill, item_count);
+      while((end < item_count) && \
+            (KeyCmpEqual(sorted_items[end].first,
+                         sorted_items[end - 1].first) == true)) {
+        end++;
+      }
+
+      start = end;
+    }
+
+    // Do not leave a last leaf node that would be merged right away
+    if((leaf_starts.size() > 1) && \
+       (item_count - leaf_starts.back() < \
+          static_cast<size_t>(LEAF_NODE_SIZE_LOWER_THRESHOLD)) && \
+       (item_count - leaf_starts[leaf_starts.size() - 2] < \
+          static_cast<size_t>(LEAF_NODE_SIZE_UPPER_THRESHOLD))) {
+      leaf_starts.pop_back();
+    }
+
+    leaf_starts.push_back(item_count);
+
+    const size_t leaf_count = leaf_starts.size() - 1;
+
+    // The iterator starts from the first leaf, so it keeps its NodeID
+    std::vector<NodeID> node_ids{};
+    node_ids.push_back(first_leaf_id);
+    for(size_t i = 1;i < leaf_count;i++) {
+      node_ids.push_back(GetNextNodeID());
+    }
+
+    // 2. Build the leaf nodes, and collect the separators of the level above,
+    //    i.e. the low key and NodeID of each node
+    std::vector<KeyNodeIDPair> separators{};
+    separators.reserve(leaf_count);
+    LeafNode *first_leaf_p = nullptr;
+    for(size_t i = 0;i < leaf_count;i++) {
+      const KeyValuePair *begin_p = sorted_items.data() + leaf_starts[i];
+      const KeyValuePair *end_p = sorted_items.data() + leaf_starts[i + 1];
+      int size = static_cast<int>(end_p - begin_p);
+
+      // The low key of the left most leaf is -Inf, and the high key of the
+      // right most leaf is +Inf
+      KeyNodeIDPair low_key_pair = \
+        (i == 0) ? std::make_pair(KeyType(), INVALID_NODE_ID) : \
+                   std::make_pair(begin_p->first, ~INVALID_NODE_ID);
+      KeyNodeIDPair high_key_pair = \
+        (i == leaf_count - 1) ? std::make_pair(KeyType(), INVALID_NODE_ID) : \
+                                std::make_pair(end_p->first, node_ids[i + 1]);
+
+      LeafNode *leaf_node_p = \
+        reinterpret_cast<LeafNode *>(ElasticNode<KeyValuePair>::\
+          Get(size,
+              NodeType::LeafType,
+              0,
+              size,
+              low_key_pair,
+              high_key_pair));
+
+      leaf_node_p->PushBack(begin_p, end_p);
+
+      if(i == 0) {
+        first_leaf_p = leaf_node_p;
+        separators.push_back(std::make_pair(KeyType(), node_ids[i]));
+      } else {
+        InstallNewNode(node_ids[i], leaf_node_p);
+        separators.push_back(std::make_pair(begin_p->first, node_ids[i]));
+      }
+    }
+
+    // 3. Build the inner levels until all separators fit into the root. The
+    //    separators are spread evenly over the nodes of a level, so no node
+    //    is below the merge threshold
+    const size_t inner_fill = INNER_NODE_SIZE_UPPER_THRESHOLD * 3 / 4;
+    InnerNode *new_root_p = nullptr;
+    while(new_root_p == nullptr) {
+      const size_t separator_count = separators.size();
+      const size_t node_count = (separator_count + inner_fill - 1) / inner_fill;
+
+      // The root keeps its NodeID
+      node_ids.clear();
+      for(size_t i = 0;(node_count > 1) && (i < node_count);i++) {
+        node_ids.push_back(GetNextNodeID());
+      }
+
+      std::vector<KeyNodeIDPair> upper_separators{};
+      upper_separators.reserve(node_count);
+      for(size_t i = 0;i < node_count;i++) {
+        const KeyNodeIDPair *begin_p = \
+          separators.data() + separator_count * i / node_count;
+        const KeyNodeIDPair *end_p = \
+          separators.data() + separator_count * (i + 1) / node_count;
+        int size = static_cast<int>(end_p - begin_p);
+
+        // The first separator is also the low key
+        KeyNodeIDPair high_key_pair = \
+          (i == node_count - 1) ? \
+            std::make_pair(KeyType(), INVALID_NODE_ID) : \
+            std::make_pair(end_p->first, node_ids[i + 1]);
+
+        InnerNode *inner_node_p = \
+          reinterpret_cast<InnerNode *>(ElasticNode<KeyNodeIDPair>::\
+            Get(size,
+                NodeType::InnerType,
+                0,
+                size,
+                *begin_p,
+                high_key_pair));
+
+        inner_node_p->PushBack(begin_p, end_p);
+
+        if(node_count == 1) {
+          new_root_p = inner_node_p;
+        } else {
+          InstallNewNode(node_ids[i], inner_node_p);
+          upper_separators.push_back(std::make_pair(begin_p->first,
+                                                    node_ids[i]));
+        }
+      }
+
+      separators.swap(upper_separators);
+    }
+
+    // 4. Publish the tree: after the first leaf node is replaced, readers that
+    //    come from the old root reach the other leaf nodes through its
+    //    sibling chain
+    bool ret = InstallNodeToReplace(first_leaf_id,
+                                    first_leaf_p,
+                                    old_first_leaf_p);
+    assert(ret == true);
+
+    ret = InstallNodeToReplace(old_root_id, new_root_p, old_root_p);
+    assert(ret == true);
+    (void)ret;
+
+    epoch_manager.AddGarbageNode(old_first_leaf_p);
+    epoch_manager.AddGarbageNode(old_root_p);
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return true;
+  }
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection Interface
   ///////////////////////////////////////////////////////////////////
@@ -12,9 +12,12 @@
 
 #pragma once
 
-#include <vector>
-#include <string>
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "catalog/manager.h"
 #include "common/platform.h"
@@ -75,6 +78,13 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate);
 
+  void StartBulkBuild(size_t partition_count);
+
+  void BulkBuildEntry(size_t partition, const storage::Tuple *key,
+                      ItemPointer *value);
+
+  void FinishBulkBuild();
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -96,6 +106,9 @@ class BWTreeIndex : public Index {
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                    std::vector<std::vector<ValueType>> &results);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
@@ -112,6 +125,31 @@ class BWTreeIndex : public Index {
   }
 
  protected:
+  using KeyValuePair = typename MapType::KeyValuePair;
+
+  // A modification of a concurrent writer while the index is built
+  struct CatchUpEntry {
+    bool is_insert;
+    KeyType key;
+    ValueType value;
+  };
+
+  // Returns false while the index is built, after which the modification
+  // goes through LogModification()
+  bool EnterModification();
+
+  void LeaveModification() { active_modifications.fetch_sub(1); }
+
+  // Appends the modification to the catch-up log, and applies it to the tree
+  // too if the build applies modifications directly. Returns false if the
+  // build finished in the meantime, and the tree must be modified instead
+  bool LogModification(bool is_insert, const KeyType &key, ValueType value,
+                       bool &ret);
+
+  // Sorts the bulk build partitions in parallel, and merges them into the
+  // first partition
+  void SortBulkBuildEntries();
+
   // equality checker and comparator
   KeyComparator comparator;
   KeyEqualityChecker equals;
@@ -119,6 +157,20 @@ class BWTreeIndex : public Index {
   
   // container
   MapType container;
+
+  // Bulk build state: the entries scanned by each thread, and the
+  // modifications of concurrent writers that are replayed after the build.
+  // Modifications reach the tree right away too while the index is visible
+  // to readers, and once the scanned entries are in the tree. Conditional
+  // inserts wait until the tree holds every entry.
+  std::atomic<bool> bulk_building;
+  std::atomic<bool> apply_during_build;
+  bool bulk_build_caught_up;
+  std::atomic<size_t> active_modifications;
+  std::vector<std::vector<KeyValuePair>> bulk_build_partitions;
+  std::vector<CatchUpEntry> catch_up_log;
+  std::mutex catch_up_lock;
+  std::condition_variable bulk_build_finished;
 };
 
 }  // End index namespace
@@ -251,6 +251,26 @@ class Index : public Printable {
   virtual bool CondInsertEntry(const storage::Tuple *key, ItemPointer *location,
                                std::function<bool(const void *)> predicate) = 0;
 
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Build
+  ///////////////////////////////////////////////////////////////////
+
+  // Builds the index over the tuples already in the table, while the table
+  // keeps taking writes. StartBulkBuild() is called before the table is
+  // scanned, the scanning threads add the entries of the tuples to their own
+  // partition, and FinishBulkBuild() builds the index from all partitions.
+  //
+  // Indexes without a bulk build path insert the entries one at a time
+  virtual void StartBulkBuild(UNUSED_ATTRIBUTE size_t partition_count) {}
+
+  virtual void BulkBuildEntry(UNUSED_ATTRIBUTE size_t partition,
+                              const storage::Tuple *key,
+                              ItemPointer *location_ptr) {
+    InsertEntry(key, location_ptr);
+  }
+
+  virtual void FinishBulkBuild() {}
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
@@ -284,6 +304,18 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Looks up a batch of keys, and appends the entries of keys[i] to
+  // results[i]. Indexes that can overlap the lookups (e.g., by prefetching
+  // the nodes of all keys before searching any of them) override this;
+  // the default looks up the keys one at a time
+  virtual void ScanKeyBatch(const std::vector<const storage::Tuple *> &keys,
+                            std::vector<std::vector<ItemPointer *>> &results) {
+    results.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], results[i]);
+    }
+  }
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
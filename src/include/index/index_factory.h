@@ -40,6 +40,9 @@ class IndexFactory {
 
   static Index *GetBwTreeGenericKeyIndex(IndexMetadata *metadata);
 
+  static Index *GetBwTreeNormalizedKeyIndex(IndexMetadata *metadata,
+                                            size_t key_size);
+
   //===--------------------------------------------------------------------===//
   // PELOTON::SKIPLIST
   //===--------------------------------------------------------------------===//
@@ -47,6 +50,17 @@ class IndexFactory {
   static Index *GetSkipListIntsKeyIndex(IndexMetadata *metadata);
 
   static Index *GetSkipListGenericKeyIndex(IndexMetadata *metadata);
+
+  static Index *GetSkipListNormalizedKeyIndex(IndexMetadata *metadata,
+                                              size_t key_size);
+
+  //===--------------------------------------------------------------------===//
+  // NORMALIZED KEYS
+  //===--------------------------------------------------------------------===//
+
+  // Returns the size of the NormalizedKey to use for the key schema, or 0 if
+  // the index should use a GenericKey
+  static size_t GetNormalizedKeySize(const catalog::Schema *key_schema);
 };
 
 }  // End index namespace
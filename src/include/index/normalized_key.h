@@ -0,0 +1,360 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key.h
+//
+// Identification: src/include/index/normalized_key.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <endian.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * class NormalizedKeyEncoder - Encodes the columns of a key into a string of
+ *                              bytes that compares with memcmp()
+ *
+ * The columns are encoded one after another, from the most significant to
+ * the least significant column, so that the first differing byte decides the
+ * order of two keys:
+ *
+ *   - Integers are stored in big-endian with the sign bit flipped, as in
+ *     CompactIntsKey
+ *   - DATE and TIMESTAMP are unsigned, and are stored in big-endian
+ *   - DECIMAL flips the sign bit of positive numbers, and all bits of
+ *     negative numbers, before storing them in big-endian. -0.0 is stored
+ *     as 0.0
+ *   - VARCHAR and VARBINARY start with a marker byte, 0x01 for a string
+ *     and 0xFF for NULL (the maximum string in scan keys). The bytes of the
+ *     string follow with 0x00 escaped as 0x00 0xFF, and the string ends with
+ *     0x00 0x00
+ *
+ * Every column encoding is prefix-free, so keys of the same schema never
+ * need the lengths of their encodings to be compared.
+ */
+class NormalizedKeyEncoder {
+ public:
+  /*
+   * IsSupported() - Returns true if all columns of the schema can be encoded
+   */
+  static bool IsSupported(const catalog::Schema *key_schema) {
+    for (const auto &column : key_schema->GetColumns()) {
+      switch (column.GetType()) {
+        case type::TypeId::BOOLEAN:
+        case type::TypeId::TINYINT:
+        case type::TypeId::SMALLINT:
+        case type::TypeId::INTEGER:
+        case type::TypeId::BIGINT:
+        case type::TypeId::DECIMAL:
+        case type::TypeId::DATE:
+        case type::TypeId::TIMESTAMP:
+        case type::TypeId::VARCHAR:
+        case type::TypeId::VARBINARY:
+          break;
+        default:
+          return false;
+      }
+    }
+
+    return true;
+  }
+
+  /*
+   * GetExpectedSize() - Returns the size of a typical encoded key
+   *
+   * Strings take their declared length, or default_string_length bytes if
+   * they have none. Longer keys still work, but only their first bytes
+   * are kept in the key (see NormalizedKey)
+   */
+  static size_t GetExpectedSize(const catalog::Schema *key_schema) {
+    static constexpr size_t default_string_length = 16;
+
+    size_t size = 0;
+    for (const auto &column : key_schema->GetColumns()) {
+      switch (column.GetType()) {
+        case type::TypeId::VARCHAR:
+        case type::TypeId::VARBINARY: {
+          size_t length = column.GetVariableLength();
+          if (length == 0 || length == INVALID_OID) {
+            length = default_string_length;
+          }
+          // Marker, string and terminator
+          size += 1 + length + 2;
+          break;
+        }
+        default:
+          size += type::Type::GetTypeSize(column.GetType());
+          break;
+      }
+    }
+
+    return size;
+  }
+
+  /*
+   * Encode() - Encodes the key stored in the tuple data
+   *
+   * At most capacity bytes are written into the buffer. The return value is
+   * the size of the complete encoding, which is larger than capacity if the
+   * encoding was cut off
+   */
+  static size_t Encode(const catalog::Schema *key_schema, const char *data,
+                       unsigned char *buffer, size_t capacity) {
+    Writer writer{buffer, capacity, 0};
+
+    oid_t column_count = key_schema->GetColumnCount();
+    for (oid_t column_id = 0; column_id < column_count; column_id++) {
+      const char *column_data = data + key_schema->GetOffset(column_id);
+
+      switch (key_schema->GetType(column_id)) {
+        case type::TypeId::BOOLEAN:
+        case type::TypeId::TINYINT:
+          writer.AddInteger<uint8_t>(Load<uint8_t>(column_data) ^ 0x80);
+          break;
+        case type::TypeId::SMALLINT:
+          writer.AddInteger<uint16_t>(
+              htobe16(Load<uint16_t>(column_data) ^ 0x8000));
+          break;
+        case type::TypeId::INTEGER:
+          writer.AddInteger<uint32_t>(
+              htobe32(Load<uint32_t>(column_data) ^ 0x80000000));
+          break;
+        case type::TypeId::BIGINT:
+          writer.AddInteger<uint64_t>(
+              htobe64(Load<uint64_t>(column_data) ^ 0x8000000000000000UL));
+          break;
+        case type::TypeId::DATE:
+          writer.AddInteger<uint32_t>(htobe32(Load<uint32_t>(column_data)));
+          break;
+        case type::TypeId::TIMESTAMP:
+          writer.AddInteger<uint64_t>(htobe64(Load<uint64_t>(column_data)));
+          break;
+        case type::TypeId::DECIMAL: {
+          double value = Load<double>(column_data);
+          uint64_t bits = 0;
+          if (value != 0.0) {
+            memcpy(&bits, &value, sizeof(bits));
+          }
+          if ((bits & 0x8000000000000000UL) != 0) {
+            bits = ~bits;
+          } else {
+            bits ^= 0x8000000000000000UL;
+          }
+          writer.AddInteger<uint64_t>(htobe64(bits));
+          break;
+        }
+        case type::TypeId::VARCHAR:
+        case type::TypeId::VARBINARY: {
+          const char *string_p = column_data;
+          if (key_schema->IsInlined(column_id) == false) {
+            string_p = Load<const char *>(column_data);
+          }
+
+          if (string_p == nullptr) {
+            writer.AddByte(0xFF);
+            break;
+          }
+
+          writer.AddByte(0x01);
+          uint32_t length = Load<uint32_t>(string_p);
+          const unsigned char *byte_p =
+              reinterpret_cast<const unsigned char *>(string_p) +
+              sizeof(uint32_t);
+          for (uint32_t i = 0; i < length; i++) {
+            writer.AddByte(byte_p[i]);
+            if (byte_p[i] == 0x00) {
+              writer.AddByte(0xFF);
+            }
+          }
+          writer.AddByte(0x00);
+          writer.AddByte(0x00);
+          break;
+        }
+        default:
+          throw IndexException("Unsupported column type for normalized key");
+      }
+    }
+
+    return writer.size;
+  }
+
+ private:
+  // Tuple data is packed, so columns may not be aligned
+  template <typename T>
+  static inline T Load(const char *data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+  }
+
+  // Writes into the buffer until it is full, and counts all bytes
+  struct Writer {
+    unsigned char *buffer;
+    size_t capacity;
+    size_t size;
+
+    inline void AddByte(unsigned char byte) {
+      if (size < capacity) {
+        buffer[size] = byte;
+      }
+      size++;
+    }
+
+    template <typename IntType>
+    inline void AddInteger(IntType big_endian) {
+      if (size + sizeof(IntType) <= capacity) {
+        memcpy(buffer + size, &big_endian, sizeof(IntType));
+        size += sizeof(IntType);
+        return;
+      }
+      const unsigned char *byte_p =
+          reinterpret_cast<const unsigned char *>(&big_endian);
+      for (size_t i = 0; i < sizeof(IntType); i++) {
+        AddByte(byte_p[i]);
+      }
+    }
+  };
+};
+
+/*
+ * class NormalizedKey - Key whose bytes compare with memcmp()
+ *
+ * The key holds the normalized encoding of the key columns (see
+ * NormalizedKeyEncoder), so comparing two keys is a single memcmp() instead
+ * of a type dispatch per column.
+ *
+ * If the encoding does not fit into KeySize bytes (e.g., a string longer
+ * than expected), only its first KeySize bytes are stored. The key also
+ * keeps a copy of the tuple data as GenericKey does, and two keys whose
+ * stored bytes are equal but cut off are compared by encoding them in full.
+ */
+template <std::size_t KeySize>
+class NormalizedKey {
+ public:
+  inline void SetFromKey(const storage::Tuple *tuple) {
+    PL_ASSERT(tuple);
+    schema = tuple->GetSchema();
+    PL_ASSERT(schema->GetLength() <= KeySize);
+    PL_MEMCPY(data, tuple->GetData(), tuple->GetLength());
+
+    key_size = NormalizedKeyEncoder::Encode(schema, data, key_data, KeySize);
+
+    // Keys are compared up to the shorter encoding, the rest is never read
+    if (key_size < KeySize) {
+      memset(key_data + key_size, 0x00, KeySize - key_size);
+    }
+  }
+
+  /*
+   * Compare() - Compares two keys of the same schema
+   *
+   * This function has the same semantics as memcmp()
+   */
+  static inline int Compare(const NormalizedKey<KeySize> &a,
+                            const NormalizedKey<KeySize> &b) {
+    size_t stored_size = std::min(a.GetStoredSize(), b.GetStoredSize());
+    int ret = memcmp(a.key_data, b.key_data, stored_size);
+    if (ret != 0) {
+      return ret;
+    }
+
+    if (a.key_size <= KeySize && b.key_size <= KeySize) {
+      return (a.key_size > b.key_size) - (a.key_size < b.key_size);
+    }
+
+    // At least one of the keys was cut off
+    std::vector<unsigned char> a_key_data(a.key_size);
+    std::vector<unsigned char> b_key_data(b.key_size);
+    NormalizedKeyEncoder::Encode(a.schema, a.data, a_key_data.data(),
+                                 a.key_size);
+    NormalizedKeyEncoder::Encode(b.schema, b.data, b_key_data.data(),
+                                 b.key_size);
+
+    ret = memcmp(a_key_data.data(), b_key_data.data(),
+                 std::min(a.key_size, b.key_size));
+    if (ret != 0) {
+      return ret;
+    }
+    return (a.key_size > b.key_size) - (a.key_size < b.key_size);
+  }
+
+  inline size_t GetStoredSize() const { return std::min(key_size, KeySize); }
+
+  // The normalized encoding, cut off after KeySize bytes
+  unsigned char key_data[KeySize];
+
+  // Size of the complete normalized encoding
+  size_t key_size;
+
+  // The tuple data, for encoding the complete key when it was cut off
+  char data[KeySize];
+
+  const catalog::Schema *schema;
+};
+
+/**
+ * Function object returns true if lhs < rhs, used for trees
+ */
+template <std::size_t KeySize>
+class NormalizedComparator {
+ public:
+  inline bool operator()(const NormalizedKey<KeySize> &lhs,
+                         const NormalizedKey<KeySize> &rhs) const {
+    return NormalizedKey<KeySize>::Compare(lhs, rhs) < 0;
+  }
+
+  NormalizedComparator(const NormalizedComparator &) {}
+  NormalizedComparator() {}
+};
+
+/**
+ * Equality-checking function object
+ */
+template <std::size_t KeySize>
+class NormalizedEqualityChecker {
+ public:
+  inline bool operator()(const NormalizedKey<KeySize> &lhs,
+                         const NormalizedKey<KeySize> &rhs) const {
+    return NormalizedKey<KeySize>::Compare(lhs, rhs) == 0;
+  }
+
+  NormalizedEqualityChecker(const NormalizedEqualityChecker &) {}
+  NormalizedEqualityChecker() {}
+};
+
+/**
+ * Hash function object for the stored bytes of a key
+ */
+template <std::size_t KeySize>
+struct NormalizedHasher
+    : std::unary_function<NormalizedKey<KeySize>, std::size_t> {
+  // Equal keys have equal stored bytes, even if they were cut off
+  inline size_t operator()(NormalizedKey<KeySize> const &p) const {
+    size_t seed = 0;
+    boost::hash_range(seed, p.key_data, p.key_data + p.GetStoredSize());
+    return seed;
+  }
+
+  NormalizedHasher(const NormalizedHasher &) {}
+  NormalizedHasher(){};
+};
+
+}  // End index namespace
+}  // End peloton namespace
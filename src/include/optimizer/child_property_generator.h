@@ -44,6 +44,7 @@ class ChildPropertyGenerator : public OperatorVisitor {
   void Visit(const PhysicalRightNLJoin *) override;
   void Visit(const PhysicalOuterNLJoin *) override;
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerIndexJoin *) override;
   void Visit(const PhysicalLeftHashJoin *) override;
   void Visit(const PhysicalRightHashJoin *) override;
   void Visit(const PhysicalOuterHashJoin *) override;
@@ -52,6 +52,7 @@ class CostAndStatsCalculator : public OperatorVisitor {
   void Visit(const PhysicalRightNLJoin *) override;
   void Visit(const PhysicalOuterNLJoin *) override;
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerIndexJoin *) override;
   void Visit(const PhysicalLeftHashJoin *) override;
   void Visit(const PhysicalRightHashJoin *) override;
   void Visit(const PhysicalOuterHashJoin *) override;
@@ -64,6 +65,9 @@ class CostAndStatsCalculator : public OperatorVisitor {
   void Visit(const PhysicalAggregate *) override;
 
  private:
+  // The estimated number of rows of a child, zero if there is no estimate
+  size_t GetChildNumRows(size_t child_idx) const;
+
   ColumnManager &manager_;
 
   // We cannot use reference here because otherwise we have to initialize them
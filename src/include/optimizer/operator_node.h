@@ -58,6 +58,7 @@ enum class OpType {
   RightNLJoin,
   OuterNLJoin,
   InnerHashJoin,
+  InnerIndexJoin,
   LeftHashJoin,
   RightHashJoin,
   OuterHashJoin,
@@ -65,6 +65,7 @@ class OperatorToPlanTransformer : public OperatorVisitor {
   void Visit(const PhysicalOuterNLJoin *) override;
 
   void Visit(const PhysicalInnerHashJoin *) override;
+  void Visit(const PhysicalInnerIndexJoin *) override;
 
   void Visit(const PhysicalLeftHashJoin *) override;
 
@@ -105,9 +106,11 @@ class OperatorToPlanTransformer : public OperatorVisitor {
       group_by_exprs,
       expression::AbstractExpression *having);
 
+  // Generate a hash join, nested loop join or, if index_join is given, an
+  // index join that probes the inner table of the right child
   std::unique_ptr<planner::AbstractPlan> GenerateJoinPlan(
       expression::AbstractExpression *join_predicate, JoinType join_type,
-      bool is_hash);
+      bool is_hash, const PhysicalInnerIndexJoin *index_join = nullptr);
 
   std::unique_ptr<planner::AbstractPlan> output_plan_;
   std::vector<std::unique_ptr<planner::AbstractPlan>> children_plans_;
@@ -37,6 +37,7 @@ class OperatorVisitor {
   virtual void Visit(const PhysicalRightNLJoin *) = 0;
   virtual void Visit(const PhysicalOuterNLJoin *) = 0;
   virtual void Visit(const PhysicalInnerHashJoin *) = 0;
+  virtual void Visit(const PhysicalInnerIndexJoin *) = 0;
   virtual void Visit(const PhysicalLeftHashJoin *) = 0;
   virtual void Visit(const PhysicalRightHashJoin *) = 0;
   virtual void Visit(const PhysicalOuterHashJoin *) = 0;
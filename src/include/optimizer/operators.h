@@ -295,6 +295,19 @@ class PhysicalInnerHashJoin : public OperatorNode<PhysicalInnerHashJoin> {
   static Operator make(std::shared_ptr<expression::AbstractExpression> join_predicate);
 };
 
+//===--------------------------------------------------------------------===//
+// InnerIndexJoin
+//===--------------------------------------------------------------------===//
+class PhysicalInnerIndexJoin : public OperatorNode<PhysicalInnerIndexJoin> {
+ public:
+  std::shared_ptr<expression::AbstractExpression> join_predicate;
+  // The inner table, whose index is probed for every outer tuple
+  storage::DataTable *table;
+  std::string table_alias;
+  static Operator make(std::shared_ptr<expression::AbstractExpression> join_predicate,
+                       storage::DataTable *table, std::string table_alias);
+};
+
 //===--------------------------------------------------------------------===//
 // LeftHashJoin
 //===--------------------------------------------------------------------===//
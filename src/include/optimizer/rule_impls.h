@@ -228,6 +228,19 @@ class InnerJoinToInnerHashJoin : public Rule {
       const override;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerIndexJoin
+class InnerJoinToInnerIndexJoin : public Rule {
+ public:
+  InnerJoinToInnerIndexJoin();
+
+  bool Check(std::shared_ptr<OperatorExpression> plan, Memo *memo) const override;
+
+  void Transform(std::shared_ptr<OperatorExpression> input,
+                 std::vector<std::shared_ptr<OperatorExpression>> &transformed)
+      const override;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LeftJoinToLeftHashJoin
 class LeftJoinToLeftHashJoin : public Rule {
@@ -22,10 +22,16 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 class Stats {
  public:
-  Stats(TupleSample *sample) : sample_(sample){};
+  Stats(TupleSample *sample, size_t num_rows = 0)
+      : sample_(sample), num_rows_(num_rows){};
+
+  // The estimated number of output rows. Zero if there is no estimate.
+  size_t GetNumRows() const { return num_rows_; }
 
  private:
    TupleSample *sample_;
+
+   size_t num_rows_;
 };
 
 } /* namespace optimizer */
@@ -43,6 +43,9 @@ constexpr double default_sorting_cost(size_t n) { return n * std::log2(n); }
 // Default number of index tuple to access for n elements
 constexpr double default_index_height(size_t n) { return std::log2(n); }
 
+// Default number of rows of a join input without an estimate.
+static constexpr size_t DEFAULT_NUM_ROWS = 1000;
+
 //===----------------------------------------------------------------------===//
 // Cost
 //===----------------------------------------------------------------------===//
@@ -123,11 +126,29 @@ class Cost {
                             std::shared_ptr<TableStats>& output_stats);
 
   /*
-   * Join
+   * Join. The outer input is the left child. An input estimated at 0 rows
+   * has no estimate and is assumed to have DEFAULT_NUM_ROWS rows.
+   *
+   * Cost of nested loop join = outer rows * inner rows * tuple cost.
+   */
+  static double InnerNLJoin(size_t outer_rows, size_t inner_rows);
+
+  /*
+   * Cost of hash join = outer rows * (tuple cost + operator cost) to build the
+   * hash table + inner rows * tuple cost to probe it.
    */
-  inline static double InnerNLJoin() { return DEFAULT_COST; }
+  static double InnerHashJoin(size_t outer_rows, size_t inner_rows);
 
-  inline static double InnerHashJoin() { return DEFAULT_COST; }
+  /*
+   * Cost of index join = outer rows * ((index height + 1) * index tuple cost +
+   * matching inner tuples * tuple cost). Unique keys match one tuple,
+   * otherwise the cardinality of the key columns gives the selectivity.
+   * Without stats, every inner tuple is assumed to match.
+   */
+  static double InnerIndexJoin(size_t outer_rows, size_t inner_rows,
+                               const std::shared_ptr<TableStats>& inner_stats,
+                               const std::vector<oid_t>& key_column_ids,
+                               bool unique_keys);
 
   /*
    * Update output statistics given input table and one condition.
@@ -89,6 +89,19 @@ bool ContainsJoinColumns(
     const std::unordered_set<std::string>& r_group_alias,
     const expression::AbstractExpression* expr);
 
+// Collect the columns of the inner table that the join predicate compares for
+// equality with a column of another table. These columns can be looked up in
+// an index of the inner table for every outer tuple
+void GetIndexJoinColumns(const std::string& inner_alias,
+                         const expression::AbstractExpression* expr,
+                         std::vector<oid_t>& inner_column_ids);
+
+// Find an index of the table whose key consists of the given columns only,
+// preferring unique indexes. Returns false if there is none
+bool FindIndexForJoinColumns(storage::DataTable* table,
+                             const std::vector<oid_t>& column_ids,
+                             oid_t& index_offset);
+
 
 std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(parser::CopyStatement* copy_stmt);
 
@@ -30,7 +30,8 @@ struct CopyStatement : SQLStatement {
         cpy_table(NULL),
         type(type),
         file_path(NULL),
-        delimiter(','){};
+        delimiter(','),
+        header(false){};
 
   virtual ~CopyStatement() {
     if (file_path != nullptr) {
@@ -50,8 +51,12 @@ struct CopyStatement : SQLStatement {
 
   CopyType type;
 
+  // NULL for COPY FROM STDIN
   char* file_path;
   char delimiter;
+
+  // Whether the first line of the imported data is a header to skip
+  bool header;
 };
 
 }  // End parser namespace
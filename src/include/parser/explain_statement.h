@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_statement.h
+//
+// Identification: src/include/parser/explain_statement.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/sql_node_visitor.h"
+#include "parser/sql_statement.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct ExplainStatement
+ * @brief Represents "EXPLAIN [ANALYZE] [(COUNTERS)] SELECT ..."
+ */
+struct ExplainStatement : SQLStatement {
+  ExplainStatement()
+      : SQLStatement(StatementType::EXPLAIN),
+        real_sql_stmt(nullptr),
+        analyze(false),
+        hardware_counters(false) {}
+
+  virtual ~ExplainStatement() {
+    if (real_sql_stmt != nullptr) {
+      delete real_sql_stmt;
+    }
+  }
+
+  virtual void Accept(SqlNodeVisitor* v) const override { v->Visit(this); }
+
+  // The statement being explained
+  SQLStatement* real_sql_stmt;
+
+  // Execute the statement and report its profile instead of just its plan
+  bool analyze;
+
+  // Also collect the hardware counters of every operator (EXPLAIN ANALYZE)
+  bool hardware_counters;
+};
+
+}  // End parser namespace
+}  // End peloton namespace
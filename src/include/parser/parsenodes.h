@@ -647,6 +647,12 @@ typedef struct PrepareStmt {
   Node *query;    /* The query itself (as a raw parsetree) */
 } PrepareStmt;
 
+typedef struct ExplainStmt {
+  NodeTag type;
+  Node *query;   /* the query (see comments above) */
+  List *options; /* list of DefElem nodes */
+} ExplainStmt;
+
 typedef enum DefElemAction {
   DEFELEM_UNSPEC, /* no action given */
   DEFELEM_SET,
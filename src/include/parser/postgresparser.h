@@ -232,6 +232,9 @@ class PostgresParser {
 
   // transform helper for analyze statement
   static parser::AnalyzeStatement* VacuumTransform(VacuumStmt* root);
+
+  // transform helper for explain statement
+  static parser::ExplainStatement* ExplainTransform(ExplainStmt* root);
 };
 
 }  // End parser namespace
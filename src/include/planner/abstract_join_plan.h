@@ -76,6 +76,10 @@ class AbstractJoinPlan : public AbstractPlan {
   virtual void HandleSubplanBinding(bool from_left,
                                     const BindingContext &input) = 0;
 
+  // Bind the attributes arriving from the right side of the join. These are
+  // produced by the right child, unless the join reads its right side itself
+  virtual void PerformRightBinding(BindingContext &right_context);
+
  private:
   /** @brief The type of join that we're going to perform */
   JoinType join_type_;
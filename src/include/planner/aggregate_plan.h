@@ -121,11 +121,12 @@ class AggregatePlan : public AbstractPlan {
     std::vector<oid_t> copied_groupby_col_ids(groupby_col_ids_);
 
     std::unique_ptr<const expression::AbstractExpression> predicate_copy(
-        predicate_->Copy());
+        predicate_ != nullptr ? predicate_->Copy() : nullptr);
     std::shared_ptr<const catalog::Schema> output_schema_copy(
         catalog::Schema::CopySchema(GetOutputSchema()));
     AggregatePlan *new_plan = new AggregatePlan(
-        std::move(project_info_->Copy()), std::move(predicate_copy),
+        project_info_ != nullptr ? project_info_->Copy() : nullptr,
+        std::move(predicate_copy),
         std::move(copied_agg_terms), std::move(copied_groupby_col_ids),
         output_schema_copy, agg_strategy_);
     return std::unique_ptr<AbstractPlan>(new_plan);
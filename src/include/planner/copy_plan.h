@@ -32,11 +32,24 @@ class CopyPlan : public AbstractPlan {
  public:
   CopyPlan() = delete;
 
+  // Exports the output of the child scan to the file
   explicit CopyPlan(char *file_path, bool deserialize_parameters)
       : file_path(file_path), deserialize_parameters(deserialize_parameters) {
     LOG_DEBUG("Creating a Copy Plan");
   }
 
+  // Bulk loads the file, or the data sent by the client if the file path is
+  // empty, into the target table
+  CopyPlan(storage::DataTable *target_table, const std::string &file_path,
+           CopyType copy_type, char delimiter, bool header)
+      : file_path(file_path),
+        target_table(target_table),
+        copy_type(copy_type),
+        delimiter(delimiter),
+        header(header) {
+    LOG_DEBUG("Creating a Copy From Plan");
+  }
+
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::COPY; }
 
   const std::string GetInfo() const { return "CopyPlan"; }
@@ -44,12 +57,36 @@ class CopyPlan : public AbstractPlan {
   // TODO: Implement copy mechanism
   std::unique_ptr<AbstractPlan> Copy() const { return nullptr; }
 
+  inline bool IsImport() const {
+    return copy_type == CopyType::IMPORT_CSV ||
+           copy_type == CopyType::IMPORT_TSV;
+  }
+
+  inline bool IsFromStdin() const { return IsImport() && file_path.empty(); }
+
+  // COPY FROM STDIN: the data the client sent before the plan is executed
+  void SetInputData(std::string data) { input_data = std::move(data); }
+
   // The path of the target file
   std::string file_path;
 
   // Whether the copying requires deserialization of parameters
   bool deserialize_parameters = false;
 
+  // The table to load (COPY FROM)
+  storage::DataTable *target_table = nullptr;
+
+  CopyType copy_type = CopyType::EXPORT_OTHER;
+
+  // Field delimiter of the imported data
+  char delimiter = ',';
+
+  // Whether the first line of the imported data is a header to skip
+  bool header = false;
+
+  // The data to import when loading from STDIN
+  std::string input_data;
+
  private:
   DISALLOW_COPY_AND_MOVE(CopyPlan);
 };
@@ -80,14 +80,33 @@ class HashJoinPlan : public AbstractJoinPlan {
     }
   }
 
+  // The estimated number of tuples the left child produces, which the hash
+  // table is built on. Zero if there is no estimate.
+  uint64_t GetBuildSizeEstimate() const { return build_size_estimate_; }
+
+  void SetBuildSizeEstimate(uint64_t build_size_estimate) {
+    build_size_estimate_ = build_size_estimate;
+  }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     std::unique_ptr<const expression::AbstractExpression> predicate_copy(
-        GetPredicate()->Copy());
+        GetPredicate() != nullptr ? GetPredicate()->Copy() : nullptr);
     std::shared_ptr<const catalog::Schema> schema_copy(
         catalog::Schema::CopySchema(GetSchema()));
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        left_hash_keys_copy, right_hash_keys_copy;
+    for (const auto &left_key : left_hash_keys_) {
+      left_hash_keys_copy.emplace_back(left_key->Copy());
+    }
+    for (const auto &right_key : right_hash_keys_) {
+      right_hash_keys_copy.emplace_back(right_key->Copy());
+    }
     HashJoinPlan *new_plan = new HashJoinPlan(
         GetJoinType(), std::move(predicate_copy),
-        std::move(GetProjInfo()->Copy()), schema_copy, outer_column_ids_);
+        GetProjInfo() != nullptr ? GetProjInfo()->Copy() : nullptr,
+        schema_copy, left_hash_keys_copy, right_hash_keys_copy);
+    new_plan->outer_column_ids_ = outer_column_ids_;
+    new_plan->SetBuildSizeEstimate(build_size_estimate_);
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -99,6 +118,8 @@ class HashJoinPlan : public AbstractJoinPlan {
   std::vector<std::unique_ptr<const expression::AbstractExpression>>
       right_hash_keys_;
 
+  uint64_t build_size_estimate_ = 0;
+
  private:
   DISALLOW_COPY_AND_MOVE(HashJoinPlan);
 };
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_plan.h
+//
+// Identification: src/include/planner/index_join_plan.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <numeric>
+
+#include "planner/abstract_join_plan.h"
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace planner {
+
+//===----------------------------------------------------------------------===//
+// An index nested-loop join. The plan has a single (left/outer) child. For
+// every outer tuple, the outer key expressions produce a key of the inner
+// table's index, and the tuples the index returns for the key are joined with
+// the outer tuple.
+//
+// The right side of the join are the given columns of the inner table, in the
+// same way as a scan of the inner table would produce them. The inner
+// predicate only refers to columns of the inner table, while the join
+// predicate refers to the outer tuple and the right side of the join.
+//===----------------------------------------------------------------------===//
+class IndexJoinPlan : public AbstractJoinPlan {
+ public:
+  IndexJoinPlan(
+      JoinType join_type,
+      std::unique_ptr<const expression::AbstractExpression> &&predicate,
+      std::unique_ptr<const ProjectInfo> &&proj_info,
+      std::shared_ptr<const catalog::Schema> &proj_schema,
+      storage::DataTable *table, std::shared_ptr<index::Index> index,
+      std::vector<std::unique_ptr<const expression::AbstractExpression>> &
+          outer_keys,
+      const std::vector<oid_t> &column_ids,
+      std::unique_ptr<const expression::AbstractExpression> &&inner_predicate);
+
+  // The right side of the join are the columns of the inner table
+  void PerformRightBinding(BindingContext &right_context) override;
+
+  void HandleSubplanBinding(bool is_left, const BindingContext &input) override;
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PlanNodeType::NESTLOOPINDEX;
+  }
+
+  void GetOutputColumns(std::vector<oid_t> &columns) const {
+    columns.resize(GetSchema()->GetColumnCount());
+    std::iota(columns.begin(), columns.end(), 0);
+  }
+
+  const std::string GetInfo() const { return "IndexJoin"; }
+
+  std::unique_ptr<AbstractPlan> Copy() const;
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  storage::DataTable *GetTable() const { return table_; }
+
+  std::shared_ptr<index::Index> GetIndex() const { return index_; }
+
+  // The expressions producing the index key, in the order of the key columns
+  void GetOuterKeys(
+      std::vector<const expression::AbstractExpression *> &keys) const {
+    for (const auto &outer_key : outer_keys_) {
+      keys.push_back(outer_key.get());
+    }
+  }
+
+  // The columns of the inner table that form the right side of the join
+  const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
+
+  const expression::AbstractExpression *GetInnerPredicate() const {
+    return inner_predicate_.get();
+  }
+
+  void GetInnerAttributes(std::vector<const AttributeInfo *> &ais) const {
+    for (const auto &ai : inner_attributes_) {
+      ais.push_back(&ai);
+    }
+  }
+
+ private:
+  // The table whose index is probed
+  storage::DataTable *table_;
+
+  // The index that is probed with the keys of the outer tuples
+  std::shared_ptr<index::Index> index_;
+
+  // The expressions producing the index key from an outer tuple
+  std::vector<std::unique_ptr<const expression::AbstractExpression>>
+      outer_keys_;
+
+  // The columns of the inner table that form the right side of the join
+  std::vector<oid_t> column_ids_;
+
+  // The predicate on the inner tuples, evaluated before joining them
+  std::unique_ptr<const expression::AbstractExpression> inner_predicate_;
+
+  // The attributes of all columns of the inner table
+  std::vector<AttributeInfo> inner_attributes_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(IndexJoinPlan);
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -108,6 +108,50 @@ class PlanUtil {
       }
     }
   }
+ public:
+  /**
+   * @brief Check whether the plan only reads the database
+   * @param The plan tree
+   * @return true if no operator in the plan writes, or locks tuples
+   */
+  static bool IsReadOnly(const planner::AbstractPlan *plan) {
+    switch (plan->GetPlanNodeType()) {
+      case PlanNodeType::SEQSCAN:
+      case PlanNodeType::INDEXSCAN: {
+        const planner::AbstractScan *scan_node =
+            reinterpret_cast<const planner::AbstractScan *>(plan);
+        if (scan_node->IsForUpdate()) {
+          return false;
+        }
+        break;
+      }
+      case PlanNodeType::NESTLOOP:
+      case PlanNodeType::NESTLOOPINDEX:
+      case PlanNodeType::MERGEJOIN:
+      case PlanNodeType::HASHJOIN:
+      case PlanNodeType::AGGREGATE:
+      case PlanNodeType::AGGREGATE_V2:
+      case PlanNodeType::UNION:
+      case PlanNodeType::ORDERBY:
+      case PlanNodeType::PROJECTION:
+      case PlanNodeType::MATERIALIZE:
+      case PlanNodeType::LIMIT:
+      case PlanNodeType::DISTINCT:
+      case PlanNodeType::SETOP:
+      case PlanNodeType::APPEND:
+      case PlanNodeType::HASH:
+      case PlanNodeType::RESULT:
+        break;
+      default:
+        return false;
+    }
+    for (auto &child : plan->GetChildren()) {
+      if (child != nullptr && !IsReadOnly(child.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 }
 }
@@ -24,7 +24,8 @@ class DataTable;
 namespace planner {
 
 /**
- * IMPORTANT All tiles got from child must have the same physical schema.
+ * Builds a newly created index over the tuples already in its table. The
+ * child plan creates the index.
  */
 
 class PopulateIndexPlan : public AbstractPlan {
@@ -35,7 +36,8 @@ class PopulateIndexPlan : public AbstractPlan {
   PopulateIndexPlan &operator=(const PopulateIndexPlan &&) = delete;
 
   explicit PopulateIndexPlan(storage::DataTable *table,
-                             std::vector<oid_t> column_ids);
+                             std::vector<oid_t> column_ids,
+                             std::string index_name);
 
   inline PlanNodeType GetPlanNodeType() const {
     return PlanNodeType::POPULATE_INDEX;
@@ -47,9 +49,11 @@ class PopulateIndexPlan : public AbstractPlan {
 
   storage::DataTable *GetTable() const { return target_table_; }
 
+  const std::string &GetIndexName() const { return index_name_; }
+
   std::unique_ptr<AbstractPlan> Copy() const {
     return std::unique_ptr<AbstractPlan>(
-        new PopulateIndexPlan(target_table_, column_ids_));
+        new PopulateIndexPlan(target_table_, column_ids_, index_name_));
   }
 
  private:
@@ -57,6 +61,8 @@ class PopulateIndexPlan : public AbstractPlan {
   storage::DataTable *target_table_ = nullptr;
   /** @brief Column Ids. */
   std::vector<oid_t> column_ids_;
+  /** @brief Name of the index to populate. */
+  std::string index_name_;
 
 };
 }
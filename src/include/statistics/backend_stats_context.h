@@ -23,6 +23,7 @@
 #include "statistics/latency_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
+#include "statistics/table_access_counters.h"
 #include "container/cuckoo_map.h"
 #include "container/lock_free_queue.h"
 
@@ -49,7 +50,7 @@ class BackendStatsContext {
  public:
   static BackendStatsContext* GetInstance();
 
-  BackendStatsContext(size_t max_latency_history, bool regiser_to_aggregator);
+  BackendStatsContext(bool regiser_to_aggregator);
   ~BackendStatsContext();
 
   //===--------------------------------------------------------------------===//
@@ -80,7 +81,20 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Increment the read stat for given table
+  void IncrementTableReads(oid_t database_id, oid_t table_id);
+
+  // Increment the insert stat for given table
+  void IncrementTableInserts(oid_t database_id, oid_t table_id);
+
+  // Increment the update stat for given table
+  void IncrementTableUpdates(oid_t database_id, oid_t table_id);
+
+  // Increment the delete stat for given table
+  void IncrementTableDeletes(oid_t database_id, oid_t table_id);
+
   // Increment the read stat for given tile group
+  // (looks up the table; prefer passing the table if it is known)
   void IncrementTableReads(oid_t tile_group_id);
 
   // Increment the insert stat for given tile group
@@ -147,6 +161,10 @@ class BackendStatsContext {
   // Table metrics
   std::unordered_map<oid_t, std::unique_ptr<TableMetric>> table_metrics_{};
 
+  // Table access counters of this worker, read by the aggregator without
+  // locking (table metrics are only used for tables they can't count)
+  TableAccessCounters table_access_counters_;
+
   // Index metrics
   CuckooMap<oid_t, std::shared_ptr<IndexMetric>> index_metrics_{};
 
@@ -187,6 +205,10 @@ class BackendStatsContext {
   // Mark the on going query as completed and move it to completed query queue
   void CompleteQueryMetric();
 
+  // Count an access to the table
+  void IncrementTableAccess(oid_t database_id, oid_t table_id,
+                            TableAccessCounters::AccessType access_type);
+
   // Get the mapping table of backend stat context for each thread
   static CuckooMap<std::thread::id, std::shared_ptr<BackendStatsContext>> &
     GetBackendContextMap(void);
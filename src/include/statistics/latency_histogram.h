@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.h
+//
+// Identification: src/include/statistics/latency_histogram.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * HDR-style histogram of latencies.
+ *
+ * Latencies are recorded in microseconds into log-linear buckets: values
+ * below SUB_BUCKET_COUNT get a bucket each, and every power of two above is
+ * split into SUB_BUCKET_COUNT / 2 buckets. Any percentile is therefore known
+ * within ~3%, whatever the number of recorded values, in a fixed amount of
+ * memory.
+ *
+ * A histogram has a single writer (its owning thread). Other threads may read
+ * it at any time without locking; they get a snapshot that can miss the
+ * values being recorded concurrently.
+ */
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Records a latency, in milliseconds
+  void Record(double latency_ms);
+
+  // Number of latencies recorded
+  inline int64_t GetCount() const {
+    return total_count_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the latency (in milliseconds) under which the given percentage
+  // of the recorded latencies are
+  double GetPercentile(double percentile) const;
+
+  double GetAverage() const;
+
+  double GetMin() const;
+
+  double GetMax() const;
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  // Adds the latencies recorded by the source histogram
+  void Add(const LatencyHistogram &source);
+
+  void Reset();
+
+  // Bucket of the latency, in microseconds
+  static size_t GetBucketIndex(uint64_t latency_us);
+
+  // Smallest and largest latencies (in microseconds) of the bucket
+  static uint64_t GetBucketLowerBound(size_t bucket_index);
+  static uint64_t GetBucketUpperBound(size_t bucket_index);
+
+  // Latencies are counted exactly below this value (in microseconds)
+  static const size_t SUB_BUCKET_BITS = 6;
+  static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+  static const size_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+
+  // Latencies above 2^MAX_LATENCY_BITS microseconds (~19 hours) are counted
+  // in the last bucket
+  static const size_t MAX_LATENCY_BITS = 36;
+  static const size_t BUCKET_COUNT =
+      SUB_BUCKET_COUNT +
+      (MAX_LATENCY_BITS - SUB_BUCKET_BITS) * SUB_BUCKET_HALF_COUNT;
+
+ private:
+  // Single writer increment, without a locked instruction
+  static inline void Add(std::atomic<int64_t> &counter, int64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  std::atomic<int64_t> bucket_counts_[BUCKET_COUNT];
+
+  std::atomic<int64_t> total_count_;
+
+  // Sum of the recorded latencies, in microseconds
+  std::atomic<int64_t> total_latency_us_;
+
+  // Extreme latencies, in microseconds
+  std::atomic<uint64_t> min_latency_us_;
+  std::atomic<uint64_t> max_latency_us_;
+};
+
+}  // namespace stats
+}  // namespace peloton
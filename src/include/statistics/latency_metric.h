@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -19,9 +20,8 @@
 #include "common/macros.h"
 #include "type/types.h"
 #include "common/exception.h"
-#include "container/circular_buffer.h"
 #include "statistics/abstract_metric.h"
-#include <mutex>
+#include "statistics/latency_histogram.h"
 
 namespace peloton {
 namespace stats {
@@ -38,19 +38,26 @@ struct LatencyMeasurements {
 };
 
 /**
- * Metric for storing raw latency values and computing
+ * Metric for recording latency values and computing
  * latency measurements.
+ *
+ * Latencies are recorded into a histogram, so the measurements cover every
+ * latency recorded since the last reset. A metric created without a histogram
+ * only keeps the latest latency.
  */
 class LatencyMetric : public AbstractMetric {
  public:
-  LatencyMetric(MetricType type, size_t max_history);
+  LatencyMetric(MetricType type, bool record_histogram = true);
 
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
   inline void Reset() {
-    latencies_.Clear();
+    if (histogram_ != nullptr) {
+      histogram_->Reset();
+    }
+    latest_latency_ = 0.0;
     timer_ms_.Reset();
   }
 
@@ -63,21 +70,19 @@ class LatencyMetric : public AbstractMetric {
   // Stops the latency timer and records the total time elapsed
   inline void RecordLatency() {
     timer_ms_.Stop();
-    double latency_value = timer_ms_.GetDuration();
-    // Record this latency only if we can do so without blocking.
-    // Occasionally losing single latency measurements is fine.
-    {
-      std::unique_lock<std::mutex> lock(latency_mutex_, std::defer_lock);
-      if (lock.try_lock()) {
-        latencies_.PushBack(latency_value);
-      }
+    latest_latency_ = timer_ms_.GetDuration();
+    if (histogram_ != nullptr) {
+      histogram_->Record(latest_latency_);
     }
   }
 
-  // Returns the first latency value recorded
-  inline double GetFirstLatencyValue() {
-    PL_ASSERT(latencies_.begin() != latencies_.end());
-    return *(latencies_.begin());
+  // Returns the latest latency value recorded
+  inline double GetLatestLatencyValue() const { return latest_latency_; }
+
+  // Returns the histogram of the latencies recorded
+  // (nullptr if the metric only keeps the latest latency)
+  inline const LatencyHistogram *GetHistogram() const {
+    return histogram_.get();
   }
 
   // Computes the latency measurements using the latencies
@@ -90,30 +95,23 @@ class LatencyMetric : public AbstractMetric {
   // Returns a string representation of this latency metric
   const std::string GetInfo() const;
 
-  // Returns a copy of the latencies collected
-  CircularBuffer<double> Copy();
-
  private:
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  // Circular buffer with capacity N that stores the <= N
-  // most recent latencies collected
-  CircularBuffer<double> latencies_;
+  // Histogram of the latencies collected. Written by the thread owning
+  // this metric only, and read by the aggregator without locking.
+  std::unique_ptr<LatencyHistogram> histogram_;
+
+  // The latest latency recorded
+  double latest_latency_ = 0.0;
 
   // Timer for timing individual latencies
   Timer<std::ratio<1, 1000>> timer_ms_;
 
   // Stores result of last call to ComputeLatencies()
   LatencyMeasurements latency_measurements_;
-
-  // The maximum number of latencies that can be stored
-  // (the capacity size N of the circular buffer)
-  size_t max_history_;
-
-  // Protects accesses to the circular buffer
-  std::mutex latency_mutex_;
 };
 
 }  // namespace stats
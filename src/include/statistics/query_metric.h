@@ -118,8 +118,8 @@ class QueryMetric : public AbstractMetric {
   // The number of tuple accesses
   AccessMetric query_access_{ACCESS_METRIC};
 
-  // Latency metric
-  LatencyMetric latency_metric_{LATENCY_METRIC, 2};
+  // Latency metric (only the latency of this query)
+  LatencyMetric latency_metric_{LATENCY_METRIC, false};
 
   // Processor metric
   ProcessorMetric processor_metric_{PROCESSOR_METRIC};
@@ -34,8 +34,6 @@
 
 #define STATS_AGGREGATION_INTERVAL_MS 1000
 #define STATS_LOG_INTERVALS 10
-#define LATENCY_MAX_HISTORY_THREAD 100
-#define LATENCY_MAX_HISTORY_AGGREGATOR 10000
 
 class BackendStatsContext;
 
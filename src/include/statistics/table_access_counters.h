@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_access_counters.h
+//
+// Identification: src/include/statistics/table_access_counters.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "common/macros.h"
+#include "common/platform.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Per-thread counters of the tuple accesses of every table, indexed directly
+ * by table OID.
+ *
+ * The counters of a thread are only written by that thread, with plain
+ * (non-locked) atomic stores. The aggregator reads them at any time without
+ * locking. Counters are allocated in chunks of TABLE_CHUNK_SIZE tables the
+ * first time one of their tables is accessed. Tables with an OID above
+ * MAX_TABLE_OID are not counted here; the caller falls back to a TableMetric.
+ */
+class TableAccessCounters {
+ public:
+  // The types of accesses
+  enum AccessType {
+    READ_ACCESS = 0,
+    UPDATE_ACCESS = 1,
+    INSERT_ACCESS = 2,
+    DELETE_ACCESS = 3,
+    ACCESS_TYPE_COUNT = 4
+  };
+
+  static const oid_t TABLE_CHUNK_SIZE = 256;
+  static const oid_t MAX_TABLE_CHUNKS = 4096;
+  static const oid_t MAX_TABLE_OID = TABLE_CHUNK_SIZE * MAX_TABLE_CHUNKS;
+
+  TableAccessCounters();
+  ~TableAccessCounters();
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Counts an access to the table. Returns false if the table OID is too
+  // large to be counted here. Must only be called by the owning thread.
+  inline bool Increment(oid_t database_id, oid_t table_id,
+                        AccessType access_type) {
+    if (table_id >= MAX_TABLE_OID) {
+      return false;
+    }
+
+    auto chunk = chunks_[table_id / TABLE_CHUNK_SIZE].load(
+        std::memory_order_acquire);
+    if (chunk == nullptr) {
+      chunk = AllocateChunk(table_id / TABLE_CHUNK_SIZE);
+    }
+
+    auto &table_counter = chunk[table_id % TABLE_CHUNK_SIZE];
+    if (table_counter.database_id.load(std::memory_order_relaxed) !=
+        database_id) {
+      table_counter.database_id.store(database_id, std::memory_order_relaxed);
+    }
+
+    auto &counter = table_counter.counters[access_type];
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+    return true;
+  }
+
+  // Calls the function on the counters of every table accessed so far:
+  // func(database_id, table_id, access_counts). Safe to call concurrently
+  // with Increment().
+  void ForEach(std::function<void(oid_t, oid_t, const int64_t *)> func) const;
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  // Resets all counters to zero
+  void Reset();
+
+ private:
+  // The counters of one table, on their own cache line so that the owning
+  // thread's writes don't disturb the aggregator's reads of other tables
+  struct CACHE_ALIGNED TableCounter {
+    std::atomic<oid_t> database_id;
+    std::atomic<int64_t> counters[ACCESS_TYPE_COUNT];
+  };
+
+  TableCounter *AllocateChunk(oid_t chunk_id);
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  std::atomic<TableCounter *> chunks_[MAX_TABLE_CHUNKS];
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <mutex>
 
 #include "common/platform.h"
@@ -48,6 +50,13 @@ class BackendManager {
 
   void Release(BackendType type, void *address);
 
+  // Allocate memory from the arena of the given NUMA node. Falls back to
+  // Allocate(type, size) for NUMA_NODE_ANY and non-memory backends.
+  void *Allocate(BackendType type, size_t size, int numa_node);
+
+  // Release memory allocated on a NUMA node (size must match the allocation)
+  void Release(BackendType type, void *address, size_t size, int numa_node);
+
   void Sync(BackendType type, void *address, size_t length);
 
   size_t GetMsyncCount() const { return msync_count; }
@@ -56,6 +65,11 @@ class BackendManager {
 
   size_t GetAllocationCount() const { return allocation_count; }
 
+  // Bytes currently allocated on the NUMA node
+  size_t GetNodeAllocationSize(int numa_node) const {
+    return numa_arena_sizes[numa_node];
+  }
+
  private:
   // data file address
   void *data_file_address;
@@ -75,6 +89,9 @@ class BackendManager {
   size_t clflush_count = 0;
 
   size_t allocation_count = 0;
+
+  // size of the per-node arenas
+  std::array<std::atomic<size_t>, MAX_NUMA_NODES> numa_arena_sizes;
 };
 
 }  // End storage namespace
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.h
+//
+// Identification: src/include/storage/compressed_column.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace storage {
+
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Compressed Column
+//===--------------------------------------------------------------------===//
+
+/**
+ * An immutable, encoded copy of a single column of a frozen tile group.
+ *
+ * Integer columns are stored either as bit-packed deltas from the minimum
+ * value (FRAME_OF_REFERENCE) or as (value, run end) pairs (RUN_LENGTH),
+ * whichever is smaller. Varchar columns are stored as bit-packed codes into a
+ * sorted dictionary (DICTIONARY), so that codes preserve the string order.
+ *
+ * Because every encoding is order-preserving, comparisons against a constant
+ * can be evaluated directly on the encoded data, without materializing values.
+ */
+class CompressedColumn {
+  CompressedColumn(CompressedColumn const &) = delete;
+
+ public:
+  CompressedColumn(type::TypeId type_id, ColumnEncodingType encoding_type,
+                   oid_t tuple_count);
+
+  // Encode the first tuple_count slots of the given column of the tile group.
+  // Returns nullptr if the column type is not supported by any encoding.
+  static CompressedColumn *Encode(TileGroup *tile_group, const oid_t column_id,
+                                  const oid_t tuple_count);
+
+  // Returns true if columns of the given type can be encoded
+  static bool IsEncodable(const type::TypeId type_id);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  // Decode the value at the given tuple slot
+  type::Value GetValue(const oid_t tuple_offset) const;
+
+  // Evaluate "column <comparison> constant" on the encoded data. Entries of
+  // matches whose tuple does not satisfy the predicate are set to false.
+  // Returns false (leaving matches untouched) if the comparison or constant
+  // type cannot be evaluated on this encoding.
+  bool EvaluatePredicate(const ExpressionType comparison,
+                         const type::Value &constant,
+                         std::vector<bool> &matches) const;
+
+  ColumnEncodingType GetEncodingType() const { return encoding_type_; }
+
+  type::TypeId GetValueType() const { return type_id_; }
+
+  oid_t GetTupleCount() const { return tuple_count_; }
+
+  // Bytes used by the encoded representation
+  size_t GetCompressedSize() const;
+
+  // Bytes used by the same column in a tile
+  size_t GetUncompressedSize() const { return uncompressed_size_; }
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // Encoders
+  //===--------------------------------------------------------------------===//
+
+  void EncodeIntegers(const std::vector<int64_t> &values);
+
+  void EncodeStrings(const std::vector<std::string> &values);
+
+  void PackCodes(const std::vector<uint64_t> &codes, const uint8_t bit_width);
+
+  inline uint64_t GetCode(const oid_t tuple_offset) const {
+    if (bit_width_ == 0) return 0;
+    size_t bit_offset = static_cast<size_t>(tuple_offset) * bit_width_;
+    size_t word = bit_offset >> 6;
+    size_t shift = bit_offset & 63;
+    uint64_t code = packed_codes_[word] >> shift;
+    if (shift + bit_width_ > 64) {
+      code |= packed_codes_[word + 1] << (64 - shift);
+    }
+    if (bit_width_ < 64) {
+      code &= (1UL << bit_width_) - 1;
+    }
+    return code;
+  }
+
+  inline bool IsNull(const oid_t tuple_offset) const {
+    return nulls_.empty() == false && nulls_[tuple_offset];
+  }
+
+  int64_t GetInteger(const oid_t tuple_offset) const;
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  type::TypeId type_id_;
+
+  ColumnEncodingType encoding_type_;
+
+  oid_t tuple_count_;
+
+  size_t uncompressed_size_ = 0;
+
+  // null bitmap (empty if the column has no nulls)
+  std::vector<bool> nulls_;
+
+  // FRAME_OF_REFERENCE and DICTIONARY: bit-packed codes
+  std::vector<uint64_t> packed_codes_;
+
+  uint8_t bit_width_ = 0;
+
+  // FRAME_OF_REFERENCE: minimum value of the column
+  int64_t base_value_ = 0;
+
+  // FRAME_OF_REFERENCE: maximum delta stored
+  uint64_t max_delta_ = 0;
+
+  // RUN_LENGTH: run values, and the exclusive end offset of every run
+  std::vector<int64_t> run_values_;
+  std::vector<oid_t> run_ends_;
+
+  // DICTIONARY: sorted distinct strings
+  std::vector<std::string> dictionary_;
+};
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile Group
+//===--------------------------------------------------------------------===//
+
+/**
+ * The set of compressed columns built for a frozen tile group. Columns whose
+ * type cannot be encoded are left out, and are read from the tiles instead.
+ */
+class CompressedTileGroup {
+  CompressedTileGroup(CompressedTileGroup const &) = delete;
+
+ public:
+  CompressedTileGroup(TileGroup *tile_group, const oid_t tuple_count);
+
+  // Returns nullptr if the column is not compressed
+  const CompressedColumn *GetColumn(const oid_t column_id) const {
+    return columns_[column_id].get();
+  }
+
+  oid_t GetTupleCount() const { return tuple_count_; }
+
+  size_t GetCompressedSize() const;
+
+  size_t GetUncompressedSize() const;
+
+ private:
+  oid_t tuple_count_;
+
+  std::vector<std::unique_ptr<CompressedColumn>> columns_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
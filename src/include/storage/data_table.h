@@ -17,6 +17,7 @@
 #include <mutex>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "common/item_pointer.h"
 #include "common/platform.h"
@@ -121,6 +122,34 @@ class DataTable : public AbstractTable {
   // aggregate_executor.
   ItemPointer InsertTuple(const Tuple *tuple);
 
+  // insert a batch of tuples in table. the slots are reserved a contiguous
+  // range at a time, the tuples are copied column by column, and the whole
+  // batch is handed to the transaction manager at once: the caller must not
+  // call PerformInsert for them. the locations of the tuples are returned in
+  // locations. returns false if a constraint is violated, in which case the
+  // transaction must be aborted.
+  bool InsertTuples(const std::vector<const Tuple *> &tuples,
+                    concurrency::Transaction *transaction,
+                    std::vector<ItemPointer> *locations = nullptr);
+
+  //===--------------------------------------------------------------------===//
+  // BULK LOAD
+  //===--------------------------------------------------------------------===//
+
+  // Creates a tile group that a bulk load fills directly, without going
+  // through the active tile groups. It isn't part of the table until it is
+  // appended.
+  std::shared_ptr<TileGroup> GetBulkLoadTileGroup();
+
+  // Inserts the index entries of every tuple in a bulk-loaded tile group,
+  // after the load. Returns false if a unique constraint is violated.
+  bool InsertBulkLoadInIndexes(TileGroup *tile_group,
+                               concurrency::Transaction *transaction);
+
+  // Appends the bulk-loaded tile groups to the table
+  void AppendBulkLoadTileGroups(
+      const std::vector<std::shared_ptr<TileGroup>> &tile_groups);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -134,14 +163,25 @@ class DataTable : public AbstractTable {
   std::shared_ptr<storage::TileGroup> GetTileGroup(
       const std::size_t &tile_group_offset) const;
 
+  // Same as GetTileGroup(), for background tasks that only inspect the tile
+  // group header (see catalog::Manager::InspectTileGroup)
+  std::shared_ptr<storage::TileGroup> InspectTileGroup(
+      const std::size_t &tile_group_offset) const;
+
   // ID is the global identifier in the entire DBMS
   std::shared_ptr<storage::TileGroup> GetTileGroupById(
       const oid_t &tile_group_id) const;
 
   size_t GetTileGroupCount() const;
 
+  // Offsets of the first tile_group_count tile groups, with the ones
+  // allocated on the given NUMA node first (in table order otherwise)
+  std::vector<oid_t> GetNumaScanOrder(const size_t tile_group_count,
+                                      const int numa_node) const;
+
   // Get a tile group with given layout
-  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
+  TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning,
+                                    const int numa_node = NUMA_NODE_ANY);
 
   //===--------------------------------------------------------------------===//
   // INDEX
@@ -168,6 +208,13 @@ class DataTable : public AbstractTable {
     return indexes_columns_;
   }
 
+  // Builds the index over the tuples in the tile groups [begin, end), with
+  // thread_count threads extracting the keys of the tile groups. The table
+  // keeps taking writes while the index is built. A range that ends with the
+  // last tile group also covers the version tile groups.
+  void BuildIndex(index::Index *index, size_t begin_tile_group_offset,
+                  size_t end_tile_group_offset, size_t thread_count);
+
   //===--------------------------------------------------------------------===//
   // FOREIGN KEYS
   //===--------------------------------------------------------------------===//
@@ -184,6 +231,10 @@ class DataTable : public AbstractTable {
   // TRANSFORMERS
   //===--------------------------------------------------------------------===//
 
+  // Copy the tile group into the default layout, and swap the copy in under
+  // the same tile group id. The caller must keep the versions of the tile
+  // group from being modified until the copy is installed. Only the values
+  // of committed versions are copied.
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
@@ -217,6 +268,11 @@ class DataTable : public AbstractTable {
 
   column_map_type GetDefaultLayout() const;
 
+  // number of tile groups of the table in every layout, kept up to date as
+  // tile groups are added and transformed so that it can be read without
+  // touching the tile groups
+  std::map<column_map_type, size_t> GetLayoutCounts() const;
+
   //===--------------------------------------------------------------------===//
   // INDEX TUNER
   //===--------------------------------------------------------------------===//
@@ -248,19 +304,61 @@ class DataTable : public AbstractTable {
   // try to insert into all indexes.
   // the last argument is the index entry in primary index holding the new
   // tuple.
-  bool InsertInIndexes(const storage::Tuple *tuple, ItemPointer location,
+  bool InsertInIndexes(const AbstractTuple *tuple, ItemPointer location,
                        concurrency::Transaction *transaction,
                        ItemPointer **index_entry_ptr);
 
+  // Set the maximum number of active tile groups of new tables. A table
+  // starts with one active tile group (one per NUMA node) and opens more as
+  // inserting threads contend for them.
   static void SetActiveTileGroupCount(const size_t active_tile_group_count) {
     default_active_tilegroup_count_ = active_tile_group_count;
   }
 
+  // Number of active tile groups the table currently inserts into
+  size_t GetActiveTileGroupCount() const { return active_tilegroup_count_; }
+
   static void SetActiveIndirectionArrayCount(
       const size_t active_indirection_array_count) {
     default_active_indirection_array_count_ = active_indirection_array_count;
   }
 
+  // Spread the active tile groups of new tables over the NUMA nodes, and
+  // insert into the tile groups of the node of the inserting thread
+  static void SetNumaAwarePlacement(const bool numa_aware_placement) {
+    default_numa_aware_placement_ = numa_aware_placement;
+  }
+
+  static bool GetNumaAwarePlacement() { return default_numa_aware_placement_; }
+
+  // Number of NUMA nodes the active tile groups are spread over
+  // (0 if the table does not use NUMA-aware placement)
+  size_t GetNumaNodeCount() const { return numa_node_count_; }
+
+  // Keep the versions of updated tuples as delta records holding only the
+  // changed columns, instead of copying the whole tuple into a new slot.
+  // Must be set before the table is updated.
+  void SetDeltaVersioning(const bool delta_versioning) {
+    delta_versioning_ = delta_versioning;
+  }
+
+  bool IsDeltaVersioning() const { return delta_versioning_; }
+
+  // Place the versions that updates and deletes create in version tile groups
+  // of their own, so that the tile groups of the table keep a single slot per
+  // tuple. The GC moves the newest version of a tuple back into that slot
+  // once no transaction can read the older ones. Must be set before the table
+  // is updated, and its tuples must be inserted by a transaction.
+  void SetVersionStore(const bool version_store);
+
+  bool HasVersionStore() const { return version_store_; }
+
+  size_t GetVersionTileGroupCount() const;
+
+  // Offset is a 0-based number local to the version tile groups
+  std::shared_ptr<storage::TileGroup> GetVersionTileGroup(
+      const std::size_t &version_tile_group_offset) const;
+
  protected:
   //===--------------------------------------------------------------------===//
   // INTEGRITY CHECKS
@@ -273,21 +371,68 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Claim a version slot, in the version tile groups if the table has a
+  // version store
+  ItemPointer GetEmptyVersionSlot();
+
+  // Pick the active tile group that receives the next tuple. Every inserting
+  // thread sticks to its own active tile group.
+  size_t GetActiveTileGroupId() const;
+
+  // Sequence number of the calling thread among the inserting threads
+  static size_t GetInsertThreadId();
+
+  // NUMA node of the tile groups filling the given active tile group slot
+  int GetActiveTileGroupNumaNode(const size_t active_tile_group_id) const;
+
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
   // tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // open more active tile groups, up to the maximum, if the table still has
+  // the given number. called when inserters wait for each other.
+  void GrowActiveTileGroups(const size_t &active_tile_group_count);
+
+  // replace the active_tile_group_id-th active tile group once it is full.
+  // the spare tile group is handed off, and a new spare is allocated after
+  // the other inserters can proceed.
+  void ReplaceFullTileGroup(const size_t &active_tile_group_id);
+
+  // create a tile group for the active_tile_group_id-th active tile group,
+  // without adding it to the table
+  std::shared_ptr<TileGroup> CreateDefaultTileGroup(
+      const size_t &active_tile_group_id);
+
+  // add a tile group to the table as the active_tile_group_id-th active
+  // tile group
+  oid_t InstallActiveTileGroup(const size_t &active_tile_group_id,
+                               const std::shared_ptr<TileGroup> &tile_group);
+
+  // add a version tile group, and place the next versions in it
+  void AddVersionTileGroup();
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
 
   // Drop all tile groups of the table. Used by recovery
   void DropTileGroups();
 
+  // adjust the number of tile groups in the given layout
+  void CountLayout(const column_map_type &layout, int delta);
+
   //===--------------------------------------------------------------------===//
   // INDEX HELPERS
   //===--------------------------------------------------------------------===//
 
+  // allocate the head pointer of the version chain of a new tuple
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
+  // insert a batch of tuples into all indexes, an index at a time
+  bool InsertBatchInIndexes(const std::vector<const Tuple *> &tuples,
+                            const std::vector<ItemPointer *> &index_entry_ptrs,
+                            concurrency::Transaction *transaction);
+
   bool InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                 const TargetList *targets_ptr,
                                 concurrency::Transaction *transaction,
@@ -301,14 +446,24 @@ class DataTable : public AbstractTable {
 
   static size_t default_active_indirection_array_count_;
 
+  static bool default_numa_aware_placement_;
+
  private:
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
 
-  size_t active_tilegroup_count_;
+  // number of active tile groups in use, and the number the table may grow to
+  std::atomic<size_t> active_tilegroup_count_;
+  size_t max_active_tilegroup_count_;
   size_t active_indirection_array_count_;
 
+  // serializes the growth of the active tile groups
+  std::mutex active_tile_groups_mutex_;
+
+  // NUMA nodes the active tile groups are spread over (0 if not placed)
+  size_t numa_node_count_ = 0;
+
   const oid_t database_oid;
 
   // deprecated, use catalog::TableCatalog::GetInstance()->GetTableName()
@@ -320,10 +475,26 @@ class DataTable : public AbstractTable {
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
+  // the tile groups that receive the next tuples. the entries are accessed
+  // with the std::atomic_* shared_ptr functions, as inserters read them while
+  // full tile groups are replaced.
   std::vector<std::shared_ptr<storage::TileGroup>> active_tile_groups_;
 
+  // the tile groups that replace the active tile groups once they are full.
+  // they are not part of the table until they are handed off.
+  std::vector<std::shared_ptr<storage::TileGroup>> spare_tile_groups_;
+
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
+  // VERSION STORE
+  LockFreeArray<oid_t> version_tile_groups_;
+
+  // the version tile group that receives the next versions. accessed with
+  // the std::atomic_* shared_ptr functions.
+  std::shared_ptr<storage::TileGroup> active_version_tile_group_;
+
+  std::atomic<size_t> version_tile_group_count_ = ATOMIC_VAR_INIT(0);
+
   // INDIRECTIONS
   std::vector<std::shared_ptr<storage::IndirectionArray>>
       active_indirection_arrays_;
@@ -353,6 +524,12 @@ class DataTable : public AbstractTable {
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
 
+  // whether updates are kept as delta records
+  bool delta_versioning_ = false;
+
+  // whether versions are kept in the version tile groups
+  bool version_store_ = false;
+
   //===--------------------------------------------------------------------===//
   // TUNING MEMBERS
   //===--------------------------------------------------------------------===//
@@ -363,6 +540,16 @@ class DataTable : public AbstractTable {
   // default partition map for table
   column_map_type default_partition_;
 
+  // default partition mutex, the layout tuner updates the partition while
+  // queries are compiled against it
+  mutable std::mutex default_partition_mutex_;
+
+  // number of tile groups in every layout
+  std::map<column_map_type, size_t> layout_counts_;
+
+  // layout counts mutex
+  mutable std::mutex layout_counts_mutex_;
+
   // samples for layout tuning
   std::vector<brain::Sample> layout_samples_;
 
@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// delta_record.h
+//
+// Identification: src/include/storage/delta_record.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Delta Record
+//===--------------------------------------------------------------------===//
+
+/**
+ * A delta record holds the columns that an update changed, rather than a copy
+ * of the whole tuple. It is used by the tables that keep delta versions.
+ *
+ * The records of a tuple are chained from its header, from the newest to the
+ * oldest one. The tuple slot keeps the values of the oldest version until the
+ * GC folds the records into it, so that a transaction reading the tuple slot
+ * never sees its values change. A version is rebuilt by taking each column
+ * from the newest record at or below the version that holds the column, and
+ * the remaining columns from the tuple slot.
+ *
+ *  STATUS:
+ *  ===================
+ *  BeginCommitId == MAX_CID --> update of the owner of the tuple, not committed
+ *  BeginCommitId == INVALID_CID --> aborted update, skipped by every reader
+ */
+struct DeltaRecord {
+  DeltaRecord(const AbstractTuple *tuple,
+              const std::vector<oid_t> &column_ids);
+
+  // the commit id of the update.
+  cid_t begin_cid;
+
+  // the epoch in which the update committed. the record can be folded into
+  // the tuple slot once the epoch has expired.
+  eid_t commit_epoch_id;
+
+  std::vector<oid_t> column_ids;
+
+  // the values are copies, so they do not depend on the varlen pool of the
+  // tuple they were taken from.
+  std::vector<type::Value> values;
+
+  // the next (older) record of the tuple.
+  DeltaRecord *next;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
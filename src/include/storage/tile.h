@@ -177,6 +177,18 @@ class Tile : public Printable {
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Tuple Storage
+  //===--------------------------------------------------------------------===//
+
+  // Allocate zeroed fixed-length tuple slots, unless they are allocated
+  void AllocateData();
+
+  // Free the fixed-length tuple slots. Uninlined values are not freed.
+  void ReleaseData();
+
+  bool IsDataReleased() const { return data == NULL; }
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -191,6 +203,9 @@ class Tile : public Printable {
   // backend type
   BackendType backend_type;
 
+  // NUMA node of the tuple storage
+  int numa_node;
+
   // tile schema
   catalog::Schema schema;
 
@@ -52,6 +52,8 @@ class TileGroupHeader;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
+class CompressedTileGroup;
+struct DeltaRecord;
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
@@ -76,7 +78,8 @@ class TileGroup : public Printable {
   // Tile group constructor
   TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-            const column_map_type &column_map, int tuple_count);
+            const column_map_type &column_map, int tuple_count,
+            int numa_node = NUMA_NODE_ANY);
 
   ~TileGroup();
 
@@ -87,6 +90,11 @@ class TileGroup : public Printable {
   // copy tuple in place.
   void CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id);
 
+  // copy tuple_count tuples in place, starting at the given slot. the tuples
+  // are copied a column at a time.
+  void CopyTuples(const Tuple *const *tuples, const oid_t &tuple_slot_id,
+                  const oid_t &tuple_count);
+
   // insert tuple at next available slot in tile if a slot exists
   oid_t InsertTuple(const Tuple *tuple);
 
@@ -125,6 +133,9 @@ class TileGroup : public Printable {
 
   TileGroupHeader *GetHeader() const { return tile_group_header; }
 
+  // NUMA node the tiles are allocated on (NUMA_NODE_ANY if not placed)
+  int GetNumaNode() const { return numa_node; }
+
   void SetHeader(TileGroupHeader *header) { tile_group_header = header; }
 
   unsigned int NumTiles() const { return tiles.size(); }
@@ -132,6 +143,9 @@ class TileGroup : public Printable {
   // Get the tile at given offset in the tile group
   inline Tile *GetTile(const oid_t tile_offset) const {
     PL_ASSERT(tile_offset < tile_count);
+    if (is_released_ == true) {
+      Materialize();
+    }
     Tile *tile = tiles[tile_offset].get();
     return tile;
   }
@@ -180,12 +194,101 @@ class TileGroup : public Printable {
 
   void SetValue(type::Value &value, oid_t tuple_id, oid_t column_id);
 
+  // Set the value, and free the varlen value it overwrites. Only for values
+  // that no transaction can read anymore.
+  void ReplaceValue(type::Value &value, oid_t tuple_id, oid_t column_id);
+
+  //===--------------------------------------------------------------------===//
+  // Delta Versions
+  //===--------------------------------------------------------------------===//
+
+  // Rebuild in tuple the version of the tuple slot that ends with the given
+  // delta record. The remaining columns are taken from the tuple slot.
+  void ReconstructTuple(const oid_t tuple_slot_id,
+                        const DeltaRecord *delta_record, Tuple *tuple,
+                        type::AbstractPool *pool);
+
+  // Write the committed delta records of the tuple slot whose epoch has
+  // expired into the tuple slot, and detach them from the tuple. Returns the
+  // detached records, which may only be freed once no transaction that could
+  // have walked them is still running.
+  DeltaRecord *FoldDeltaRecords(const oid_t tuple_slot_id,
+                                const eid_t expired_eid);
+
+  // Free the delta records of a tuple slot that no transaction can read.
+  void FreeDeltaRecords(const oid_t tuple_slot_id);
+
   double GetSchemaDifference(const storage::column_map_type &new_column_map);
 
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Compression
+  //===--------------------------------------------------------------------===//
+
+  // Build compressed column blocks for all tuple slots of this tile group.
+  // Must only be invoked when no transaction can modify the tile group.
+  void Freeze();
+
+  // Drop the compressed column blocks and the reservation for a layout
+  // transform. Must be invoked before any tuple slot of a frozen or reserved
+  // tile group is rewritten. Waits for a transform that is in progress, after
+  // which the catalog hands out the transformed tile group instead.
+  void Thaw();
+
+  inline bool IsFrozen() const { return is_frozen_; }
+
+  // Free the raw tiles whose columns are all held by the compressed column
+  // blocks. They are re-materialized from the blocks on their next access.
+  // Nothing is released while a transaction that may still hold on to a raw
+  // tile is running, i.e. one that started no later than the epoch in which
+  // the tile group was frozen or last handed out.
+  // Returns the number of bytes released.
+  size_t ReleaseTiles(const eid_t expired_eid);
+
+  inline bool IsReleased() const { return is_released_; }
+
+  // Record that the tile group was handed out in the current epoch.
+  // Only frozen tile groups need to be tracked.
+  void RecordAccess();
+
+  // Returns nullptr if the tile group is not frozen
+  std::shared_ptr<const CompressedTileGroup> GetCompressedTileGroup() const;
+
+  //===--------------------------------------------------------------------===//
+  // Version Store
+  //===--------------------------------------------------------------------===//
+
+  // A version tile group holds the versions that updates and deletes create
+  // in a table with a version store. It is not one of the table's tile groups.
+  void SetVersionTileGroup() { is_version_tile_group_ = true; }
+
+  inline bool IsVersionTileGroup() const { return is_version_tile_group_; }
+
+  //===--------------------------------------------------------------------===//
+  // Layout Transform
+  //===--------------------------------------------------------------------===//
+
+  // Reserve the tile group for a layout transform in the current epoch,
+  // unless it is reserved already. Thaw drops the reservation, so that a
+  // slot that is rewritten meanwhile cancels the transform.
+  // Returns the epoch of the reservation.
+  eid_t ReserveTransform();
+
+  // Lock out Thaw while the reserved tile group is replaced. The lock is not
+  // acquired if the reservation was dropped, or if a transaction that started
+  // no later than the epoch of the reservation may still be running, since it
+  // may be about to rewrite an empty slot.
+  std::unique_lock<std::mutex> LockReservation(const eid_t expired_eid);
+
  protected:
+  // Re-materialize the released raw tiles from the compressed column blocks
+  void Materialize() const;
+
+  // Same as Materialize(), with the compression mutex already held
+  void MaterializeTiles() const;
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -198,6 +301,9 @@ class TileGroup : public Printable {
   // Backend type
   BackendType backend_type;
 
+  // NUMA node of the tiles
+  int numa_node;
+
   // mapping to tile schemas
   std::vector<catalog::Schema> tile_schemas;
 
@@ -221,6 +327,29 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // compressed copy of the tile group, only set while it is frozen.
+  // accessed with the std::atomic_* shared_ptr functions.
+  std::shared_ptr<const CompressedTileGroup> compressed_tile_group_;
+
+  std::atomic<bool> is_frozen_ = ATOMIC_VAR_INIT(false);
+
+  // serializes releasing and re-materializing the raw tiles with thawing
+  mutable std::mutex compression_mutex_;
+
+  // set while the raw tiles of a frozen tile group are released
+  mutable std::atomic<bool> is_released_ = ATOMIC_VAR_INIT(false);
+
+  // latest epoch in which the tile group was frozen or handed out
+  std::atomic<eid_t> access_epoch_id_ = ATOMIC_VAR_INIT(0);
+
+  bool is_version_tile_group_ = false;
+
+  // epoch in which the tile group was reserved for a layout transform
+  std::atomic<eid_t> reserved_epoch_id_ = ATOMIC_VAR_INIT(INVALID_EID);
+
+  // serializes replacing a reserved tile group with thawing
+  std::mutex reservation_mutex_;
 };
 
 }  // namespace storage
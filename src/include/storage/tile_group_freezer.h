@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.h
+//
+// Identification: src/include/storage/tile_group_freezer.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer
+//===--------------------------------------------------------------------===//
+
+/**
+ * Background task that converts cold tile groups into compressed column
+ * blocks (see CompressedTileGroup), and later frees their raw tiles.
+ *
+ * A tile group is cold once all of its slots have been handed out and every
+ * version in it was committed before the oldest active transaction started,
+ * so that no running or future transaction can modify it in place. Frozen
+ * tile groups are thawed by the storage layer as soon as one of their empty
+ * slots is claimed, or a version in them is updated or deleted.
+ *
+ * Once no transaction may still hold on to the raw tiles of a frozen tile
+ * group, the freezer releases the ones the compressed blocks can restore.
+ * The freezer is started at server startup with --tile_group_freezer.
+ */
+class TileGroupFreezer {
+ public:
+  TileGroupFreezer(const TileGroupFreezer &) = delete;
+  TileGroupFreezer &operator=(const TileGroupFreezer &) = delete;
+  TileGroupFreezer(TileGroupFreezer &&) = delete;
+  TileGroupFreezer &operator=(TileGroupFreezer &&) = delete;
+
+  TileGroupFreezer();
+
+  ~TileGroupFreezer();
+
+  // Singleton
+  static TileGroupFreezer &GetInstance();
+
+  // Start freezing
+  void Start();
+
+  // Stop freezing
+  void Stop();
+
+  // Add table to list of tables whose tile groups must be frozen
+  void AddTable(DataTable *table);
+
+  // Remove table from list, before it is dropped
+  void RemoveTable(DataTable *table);
+
+  // Clear list
+  void ClearTables();
+
+  // Freeze all cold tile groups of the table.
+  // Returns the number of tile groups that were frozen.
+  oid_t FreezeTable(DataTable *table, const cid_t expired_cid);
+
+  // Release the raw tiles of the frozen tile groups of the table that no
+  // running transaction may hold on to (see TileGroup::ReleaseTiles).
+  // Returns the number of bytes released.
+  size_t ReleaseTable(DataTable *table, const eid_t expired_eid);
+
+  // Check whether no transaction can modify the tile group anymore
+  static bool IsFreezable(TileGroup *tile_group, const cid_t expired_cid);
+
+  //===--------------------------------------------------------------------===//
+  // Stats
+  //===--------------------------------------------------------------------===//
+
+  size_t GetFrozenTileGroupCount() const { return frozen_tile_group_count_; }
+
+  // Bytes of the encoded columns before compression
+  size_t GetUncompressedSize() const { return uncompressed_size_; }
+
+  // Bytes of the encoded columns after compression
+  size_t GetCompressedSize() const { return compressed_size_; }
+
+  // Bytes of raw tiles released
+  size_t GetReleasedSize() const { return released_size_; }
+
+ private:
+  void Freeze();
+
+  // Tables whose tile groups must be frozen
+  std::vector<DataTable *> tables_;
+
+  std::mutex freezer_mutex_;
+
+  // Stop signal
+  std::atomic<bool> freezer_stop_;
+
+  // Freezer thread
+  std::thread freezer_thread_;
+
+  std::atomic<size_t> frozen_tile_group_count_;
+
+  std::atomic<size_t> uncompressed_size_;
+
+  std::atomic<size_t> compressed_size_;
+
+  std::atomic<size_t> released_size_;
+
+  // Sleeping period (in ms)
+  oid_t sleep_duration_ = 1000;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <iostream>
@@ -28,6 +29,7 @@ namespace peloton {
 namespace storage {
 
 class TileGroup;
+struct DeltaRecord;
 
 //===--------------------------------------------------------------------===//
 // Tile Group Header
@@ -43,7 +45,7 @@ class TileGroup;
  *  -----------------------------------------------------------------------------
  *  | TxnID (8 bytes)  | BeginTimeStamp (8 bytes) | EndTimeStamp (8 bytes) |
  *  | NextItemPointer (8 bytes) | PrevItemPointer (8 bytes) |
- *  | Indirection (8 bytes) | ReservedField (16 bytes)
+ *  | Indirection (8 bytes) | DeltaRecord (8 bytes) | ReservedField (16 bytes)
  *  -----------------------------------------------------------------------------
  *
  *  FIELD DESCRIPTIONS:
@@ -57,6 +59,8 @@ class TileGroup;
  * version chain.
  *  Indirection: the pointer pointing to the index entry that holds the address
  * of the version chain header.
+ *  DeltaRecord: the pointer pointing to the newest delta record of the tuple,
+ * if the table keeps delta versions.
  *  ReservedField: unused space for future usage.
  *
  *  STATUS:
@@ -73,7 +77,8 @@ class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  const int numa_node = NUMA_NODE_ANY);
 
   TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
     // check for self-assignment
@@ -109,6 +114,26 @@ class TileGroupHeader : public Printable {
     }
   }
 
+  // reserve up to count consecutive slots at once. the number of slots that
+  // were reserved is returned in slot_count; it is smaller than count if the
+  // tile group fills up. this function is only called by
+  // DataTable::InsertTuples().
+  oid_t GetNextEmptyTupleSlots(const oid_t &count, oid_t &slot_count) {
+    slot_count = 0;
+    if (next_tuple_slot >= num_tuple_slots) {
+      return INVALID_OID;
+    }
+
+    oid_t tuple_slot_id =
+        next_tuple_slot.fetch_add(count, std::memory_order_relaxed);
+
+    if (tuple_slot_id >= num_tuple_slots) {
+      return INVALID_OID;
+    }
+    slot_count = std::min(count, num_tuple_slots - tuple_slot_id);
+    return tuple_slot_id;
+  }
+
   /**
    * Used by logging
    */
@@ -176,6 +201,10 @@ class TileGroupHeader : public Printable {
     return *(ItemPointer **)(TUPLE_HEADER_LOCATION + indirection_offset);
   }
 
+  inline DeltaRecord *GetDeltaRecord(const oid_t &tuple_slot_id) const {
+    return *((DeltaRecord **)(TUPLE_HEADER_LOCATION + delta_record_offset));
+  }
+
   // constraint: at most 16 bytes.
   inline char *GetReservedFieldRef(const oid_t &tuple_slot_id) const {
     return (char *)(TUPLE_HEADER_LOCATION + reserved_field_offset);
@@ -217,6 +246,26 @@ class TileGroupHeader : public Printable {
         indirection;
   }
 
+  inline void SetDeltaRecord(const oid_t &tuple_slot_id,
+                             DeltaRecord *delta_record) const {
+    *((DeltaRecord **)(TUPLE_HEADER_LOCATION + delta_record_offset)) =
+        delta_record;
+  }
+
+  // the owner of the tuple pushes delta records while the GC may unlink them,
+  // so the newest record is swapped atomically.
+  inline bool SetAtomicDeltaRecord(const oid_t &tuple_slot_id,
+                                   DeltaRecord *old_delta_record,
+                                   DeltaRecord *new_delta_record) const {
+    DeltaRecord **delta_record_ptr =
+        (DeltaRecord **)(TUPLE_HEADER_LOCATION + delta_record_offset);
+    return __sync_bool_compare_and_swap(delta_record_ptr, old_delta_record,
+                                        new_delta_record);
+  }
+
+  // free the delta records of a tuple slot that no transaction can read.
+  void FreeDeltaRecords(const oid_t &tuple_slot_id);
+
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
@@ -252,7 +301,8 @@ class TileGroupHeader : public Printable {
   static const size_t reserved_size = 16;
   static const size_t header_entry_size = sizeof(txn_id_t) + 2 * sizeof(cid_t) +
                                           2 * sizeof(ItemPointer) +
-                                          sizeof(ItemPointer *) + reserved_size;
+                                          sizeof(ItemPointer *) +
+                                          sizeof(DeltaRecord *) + reserved_size;
   static const size_t txn_id_offset = 0;
   static const size_t begin_cid_offset = txn_id_offset + sizeof(txn_id_t);
   static const size_t end_cid_offset = begin_cid_offset + sizeof(cid_t);
@@ -261,8 +311,10 @@ class TileGroupHeader : public Printable {
       next_pointer_offset + sizeof(ItemPointer);
   static const size_t indirection_offset =
       prev_pointer_offset + sizeof(ItemPointer);
+  static const size_t delta_record_offset =
+      indirection_offset + sizeof(ItemPointer *);
   static const size_t reserved_field_offset =
-      indirection_offset + sizeof(ItemPointer);
+      delta_record_offset + sizeof(DeltaRecord *);
 
  private:
   //===--------------------------------------------------------------------===//
@@ -272,6 +324,9 @@ class TileGroupHeader : public Printable {
   // Backend
   BackendType backend_type;
 
+  // NUMA node of the header
+  int numa_node;
+
   // Associated tile_group
   TileGroup *tile_group;
 
@@ -68,7 +68,8 @@ class TrafficCop {
   executor::ExecuteResult ExecuteStatementPlan(
       const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
       std::vector<StatementResult> &result,
-      const std::vector<int> &result_format, const size_t thread_id = 0);
+      const std::vector<int> &result_format, const size_t thread_id = 0,
+      executor::QueryProfile *profile = nullptr);
 
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
@@ -107,6 +108,13 @@ class TrafficCop {
 
   ResultType AbortQueryHelper();
 
+  // EXPLAIN [ANALYZE] - Return the plan of the statement, or run it and
+  // return its profile
+  ResultType ExecuteExplain(const std::shared_ptr<Statement> &statement,
+                            const std::vector<type::Value> &params,
+                            std::vector<StatementResult> &result,
+                            int &rows_changed, const size_t thread_id);
+
   // Get all data tables from a TableRef.
   // For multi-way join
   // still a HACK
@@ -352,6 +352,7 @@ enum class NetworkMessageType : unsigned char {
   READY_FOR_QUERY = 'Z',
   ROW_DESCRIPTION = 'T',
   DATA_ROW = 'D',
+  COPY_IN_RESPONSE = 'G',
   // Errors
   HUMAN_READABLE_ERROR = 'M',
   SQLSTATE_CODE_ERROR = 'C',
@@ -364,6 +365,10 @@ enum class NetworkMessageType : unsigned char {
   PARSE_COMMAND = 'P',
   SIMPLE_QUERY_COMMAND = 'Q',
   CLOSE_COMMAND = 'C',
+  // Copy sub-protocol
+  COPY_DATA_COMMAND = 'd',
+  COPY_DONE_COMMAND = 'c',
+  COPY_FAIL_COMMAND = 'f',
   // SSL willingness
   SSL_YES = 'S',
   SSL_NO = 'N',
@@ -386,7 +391,8 @@ enum SqlStateErrorCode {
 
 enum class ProtocolType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,  // timestamp ordering
+  OPTIMISTIC = 2           // optimistic concurrency control
 };
 std::string ProtocolTypeToString(ProtocolType type);
 ProtocolType StringToProtocolType(const std::string &str);
@@ -496,6 +502,21 @@ std::string BackendTypeToString(BackendType type);
 BackendType StringToBackendType(const std::string &str);
 std::ostream &operator<<(std::ostream &os, const BackendType &type);
 
+//===--------------------------------------------------------------------===//
+// Column Encoding Types
+//===--------------------------------------------------------------------===//
+
+enum class ColumnEncodingType {
+  INVALID = INVALID_TYPE_ID,  // invalid encoding type
+  UNCOMPRESSED = 1,           // plain values
+  DICTIONARY = 2,             // order-preserving dictionary codes
+  FRAME_OF_REFERENCE = 3,     // bit-packed deltas from the minimum value
+  RUN_LENGTH = 4              // (value, run length) pairs
+};
+std::string ColumnEncodingTypeToString(ColumnEncodingType type);
+ColumnEncodingType StringToColumnEncodingType(const std::string &str);
+std::ostream &operator<<(std::ostream &os, const ColumnEncodingType &type);
+
 //===--------------------------------------------------------------------===//
 // Index Types
 //===--------------------------------------------------------------------===//
@@ -671,7 +692,8 @@ enum class StatementType {
   ALTER = 12,                 // alter statement type
   TRANSACTION = 13,           // transaction statement type,
   COPY = 14,                  // copy type
-  ANALYZE = 15                // analyze type
+  ANALYZE = 15,               // analyze type
+  EXPLAIN = 16                // explain type
 };
 std::string StatementTypeToString(StatementType type);
 StatementType StringToStatementType(const std::string &str);
@@ -691,6 +713,7 @@ enum class QueryType {
   QUERY_SHOW,                 // show query
   QUERY_PREPARE,	      // prepare query
   QUERY_EXECUTE, 	      // execute query
+  QUERY_COPY,                 // copy query
   QUERY_OTHER,                // other queries
 };
 
@@ -714,7 +737,8 @@ enum class JoinType {
   RIGHT = 2,                  // right
   INNER = 3,                  // inner
   OUTER = 4,                  // outer
-  SEMI = 5                    // IN+Subquery is SEMI
+  SEMI = 5,                   // IN+Subquery is SEMI
+  ANTI = 6                    // NOT IN+Subquery is ANTI
 };
 std::string JoinTypeToString(JoinType type);
 JoinType StringToJoinType(const std::string &str);
@@ -1061,8 +1085,14 @@ static const cid_t MAX_EID = std::numeric_limits<eid_t>::max();
 // For epoch
 static const size_t EPOCH_LENGTH = 40;
 
+// For NUMA placement (no node preference)
+static const int NUMA_NODE_ANY = -1;
+
+static const int MAX_NUMA_NODES = 64;
+
 // For threads
 extern size_t CONNECTION_THREAD_COUNT;
+extern size_t EXECUTION_THREAD_COUNT;
 extern size_t LOGGING_THREAD_COUNT;
 extern size_t GC_THREAD_COUNT;
 extern size_t EPOCH_THREAD_COUNT;
@@ -1110,6 +1140,9 @@ typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
 // block -> offset -> is_index_deletion
 typedef std::unordered_map<oid_t, std::unordered_map<oid_t, bool>> GCSet;
 
+// block -> offsets of the tuples whose delta records can be folded
+typedef std::unordered_map<oid_t, std::unordered_set<oid_t>> DeltaSet;
+
 //===--------------------------------------------------------------------===//
 // File Handle
 //===--------------------------------------------------------------------===//
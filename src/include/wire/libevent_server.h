@@ -56,6 +56,7 @@ enum ConnState {
   CONN_WRITE,      // State the writes data to the network
   CONN_WAIT,       // State for waiting for some event to happen
   CONN_PROCESS,    // State that runs the wire protocol on received data
+  CONN_EXECUTING,  // State while the execution pool runs the received queries
   CONN_CLOSING,    // State for closing the client connection
   CONN_CLOSED,     // State for closed connection
   CONN_INVALID,    // Invalid STate
@@ -87,6 +88,10 @@ void EventHandler(evutil_socket_t connfd, short ev_flags, void *arg);
 /* Runs the state machine for the protocol. Invoked by event handler callback */
 void StateMachine(LibeventSocket *conn);
 
+/* Runs the connection's queries on an execution pool thread, along with the
+ * messages pipelined after them in the read buffer */
+void ExecutionTask(LibeventSocket *conn);
+
 /* Set the socket to non-blocking mode */
 inline void SetNonBlocking(evutil_socket_t fd) {
   auto flags = fcntl(fd, F_GETFL);
@@ -102,6 +107,13 @@ inline void SetTCPNoDelay(evutil_socket_t fd) {
   setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
 }
 
+/* Messages that run queries, and are handed over to the execution pool */
+inline bool IsExecutionMessage(NetworkMessageType msg_type) {
+  return msg_type == NetworkMessageType::SIMPLE_QUERY_COMMAND ||
+         msg_type == NetworkMessageType::EXECUTE_COMMAND ||
+         msg_type == NetworkMessageType::COPY_DONE_COMMAND;
+}
+
 // Buffers used to batch messages at the socket
 struct Buffer {
   size_t buf_ptr;        // buffer cursor
@@ -163,6 +175,9 @@ class LibeventSocket {
   ConnState state = CONN_INVALID;  // Initial state of connection
   InputPacket rpkt;                // Used for reading a single Postgres packet
 
+  // Result of the packets processed by the execution pool
+  bool process_status = true;
+
  private:
   Buffer rbuf_;                     // Socket's read buffer
   Buffer wbuf_;                     // Socket's write buffer
@@ -205,6 +220,9 @@ class LibeventSocket {
   // Extracts the contents of Postgres packet from the read socket buffer
   bool ReadPacket();
 
+  // Is the whole next packet already in the read buffer?
+  bool IsPacketBuffered();
+
   WriteState WritePackets();
 
   void PrintWriteBuffer();
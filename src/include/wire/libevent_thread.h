@@ -32,6 +32,7 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/thread_pool.h"
 #include "configuration/configuration.h"
 #include "container/lock_free_queue.h"
 #include "wire/libevent_server.h"
@@ -42,6 +43,7 @@ namespace wire {
 
 // Forward Declarations
 struct NewConnQueueItem;
+class LibeventSocket;
 
 class LibeventThread {
  protected:
@@ -98,12 +100,28 @@ class LibeventWorkerThread : public LibeventThread {
   // Notify new connection pipe(receive end)
   int new_conn_receive_fd_;
 
+  // Pool running the queries of this thread's connections
+  // (nullptr if queries are run by this thread)
+  ThreadPool *execution_pool_;
+
  public:
   /* The queue for new connection requests */
   LockFreeQueue<std::shared_ptr<NewConnQueueItem>> new_conn_queue;
 
+  /* The queue for connections whose queries have been executed */
+  LockFreeQueue<LibeventSocket *> executed_conn_queue;
+
  public:
-  LibeventWorkerThread(const int thread_id);
+  LibeventWorkerThread(const int thread_id, ThreadPool *execution_pool);
+
+  bool HasExecutionPool() const { return execution_pool_ != nullptr; }
+
+  /* Hand the connection's current packet over to the execution pool. The
+   * connection stops listening for events until the execution is done */
+  void SubmitExecution(LibeventSocket *conn);
+
+  /* Called by the execution pool to resume the connection on this thread */
+  void NotifyExecutionDone(LibeventSocket *conn);
 
   // Getters and setters
   event *GetNewConnEvent() { return this->new_conn_event_; }
@@ -123,6 +141,12 @@ class LibeventMasterThread : public LibeventThread {
   // TODO: have a smarter dispatch scheduler
   std::atomic<int> next_thread_id_;  // next thread we dispatched to
 
+  // Number of threads running queries (0 if the workers run them)
+  const size_t num_execution_threads_;
+
+  // Pool shared by the worker threads to run queries
+  ThreadPool execution_pool_;
+
  public:
   LibeventMasterThread(const int num_threads, struct event_base *libevent_base);
 
@@ -166,6 +166,14 @@ class PacketManager {
   /* Process the optional CLOSE message of the extended query protocol */
   void ExecCloseMessage(InputPacket* pkt);
 
+  /* Starts the COPY FROM STDIN sub-protocol for a prepared COPY statement */
+  void SendCopyInResponse(int column_count);
+
+  /* Process the CopyData, CopyDone and CopyFail messages of COPY FROM STDIN */
+  void ExecCopyDataMessage(InputPacket* pkt);
+  void ExecCopyDoneMessage(const size_t thread_id);
+  void ExecCopyFailMessage(InputPacket* pkt);
+
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
@@ -179,6 +187,10 @@ class PacketManager {
   // global txn state
   NetworkTransactionStateType txn_state_;
 
+  // COPY FROM STDIN in progress: the statement, and the data received so far
+  std::shared_ptr<Statement> copy_in_statement_;
+  std::string copy_in_data_;
+
   // state to mang skipped queries
   bool skipped_stmt_ = false;
   std::string skipped_query_string_;
@@ -11,6 +11,10 @@
 //===----------------------------------------------------------------------===//
 #include "index/bwtree_index.h"
 
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
 #include "common/logger.h"
 #include "index/index_key.h"
 #include "index/scan_optimizer.h"
@@ -35,7 +39,11 @@ BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
       //
       // NOTE 2: We set the first parameter to false to disable automatic GC
       //
-      container{false, comparator, equals, hash_func} {
+      container{false, comparator, equals, hash_func},
+      bulk_building{false},
+      apply_during_build{false},
+      bulk_build_caught_up{false},
+      active_modifications{0} {
   return;
 }
 
@@ -53,7 +61,17 @@ bool BWTREE_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
   KeyType index_key;
   index_key.SetFromKey(key);
 
-  bool ret = container.Insert(index_key, value);
+  bool ret = true;
+  while (true) {
+    if (EnterModification() == true) {
+      ret = container.Insert(index_key, value);
+      LeaveModification();
+      break;
+    }
+    if (LogModification(true, index_key, value, ret) == true) {
+      break;
+    }
+  }
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
@@ -76,7 +94,17 @@ bool BWTREE_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
 
   // In Delete() since we just use the value for comparison (i.e. read-only)
   // it is unnecessary for us to allocate memory
-  bool ret = container.Delete(index_key, value);
+  bool ret = true;
+  while (true) {
+    if (EnterModification() == true) {
+      ret = container.Delete(index_key, value);
+      LeaveModification();
+      break;
+    }
+    if (LogModification(false, index_key, value, ret) == true) {
+      break;
+    }
+  }
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
@@ -93,12 +121,36 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   index_key.SetFromKey(key);
 
   bool predicate_satisfied = false;
+  bool ret = false;
+
+  while (true) {
+    if (EnterModification() == true) {
+      // This function will complete them in one step
+      // predicate will be set to nullptr if the predicate
+      // returns true for some value
+      ret = container.ConditionalInsert(index_key, value, predicate,
+                                        &predicate_satisfied);
+      LeaveModification();
+      break;
+    }
+
+    // The predicate has to see all values of the key, so while the index is
+    // built a conditional insert waits until the tree holds every entry
+    std::unique_lock<std::mutex> lock(catch_up_lock);
+    bulk_build_finished.wait(lock, [this] {
+      return bulk_building == false || bulk_build_caught_up == true;
+    });
+    if (bulk_building == false) {
+      continue;
+    }
 
-  // This function will complete them in one step
-  // predicate will be set to nullptr if the predicate
-  // returns true for some value
-  bool ret = container.ConditionalInsert(index_key, value, predicate,
-                                         &predicate_satisfied);
+    ret = container.ConditionalInsert(index_key, value, predicate,
+                                      &predicate_satisfied);
+    if (ret == true) {
+      catch_up_log.push_back(CatchUpEntry{true, index_key, value});
+    }
+    break;
+  }
 
   // If predicate is not satisfied then we know insertion successes
   if (predicate_satisfied == false) {
@@ -115,6 +167,231 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * StartBulkBuild() - Prepares the bulk build of the index
+ *
+ * From here on, inserts and deletes of concurrent writers go to the catch-up
+ * log. They are applied to the tree as well if the index is visible to
+ * readers, so that transactions keep finding their own writes. Conditional
+ * inserts wait until the scanned entries are in the tree. Modifications that
+ * already started are waited for, so the table scan that follows sees their
+ * tuples
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::StartBulkBuild(size_t partition_count) {
+  {
+    std::lock_guard<std::mutex> lock(catch_up_lock);
+    PL_ASSERT(bulk_building == false);
+    bulk_build_partitions.clear();
+    bulk_build_partitions.resize(std::max(partition_count, (size_t)1));
+    catch_up_log.clear();
+    apply_during_build = metadata->GetVisibility();
+    bulk_build_caught_up = false;
+    bulk_building = true;
+  }
+
+  while (active_modifications.load() != 0) {
+    std::this_thread::yield();
+  }
+
+  return;
+}
+
+/*
+ * BulkBuildEntry() - Adds an entry to the partition of the scanning thread
+ *
+ * Each partition is only used by one thread, so there is no synchronization
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::BulkBuildEntry(size_t partition,
+                                       const storage::Tuple *key,
+                                       ItemPointer *value) {
+  PL_ASSERT(partition < bulk_build_partitions.size());
+
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bulk_build_partitions[partition].emplace_back(index_key, value);
+
+  return;
+}
+
+/*
+ * FinishBulkBuild() - Builds the tree from the sorted entries, and catches up
+ *                     with the modifications of concurrent writers
+ *
+ * The tree is built bottom-up if it is empty, which it is unless the index
+ * already had entries or took modifications directly; otherwise the entries
+ * are inserted one at a time. From then on, writers apply their modifications
+ * to the tree as well as logging them. The catch-up log is replayed in rounds
+ * while writers keep appending to it, in the order of the modifications, so
+ * that a replayed modification is never older than one already applied. The
+ * first round ends the wait of conditional inserts, and the last round is
+ * replayed under the log latch, so no modification is lost when the writers
+ * switch back to the tree.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::FinishBulkBuild() {
+  SortBulkBuildEntries();
+
+  auto &entries = bulk_build_partitions[0];
+  bool bulk_loaded = container.BulkLoad(entries);
+  if (bulk_loaded == false) {
+    for (auto &entry : entries) {
+      container.Insert(entry.first, entry.second);
+    }
+  }
+
+  LOG_DEBUG("Built index %s with %lu entries (%s)", GetName().c_str(),
+            entries.size(), bulk_loaded ? "bottom-up" : "inserted");
+  bulk_build_partitions.clear();
+
+  auto replay = [this](std::vector<CatchUpEntry> &log) {
+    // The tree ignores inserts of existing entries, e.g. of the tuples that
+    // were inserted and also seen by the table scan
+    for (auto &entry : log) {
+      if (entry.is_insert == true) {
+        container.Insert(entry.key, entry.value);
+      } else {
+        container.Delete(entry.key, entry.value);
+      }
+    }
+  };
+
+  // The modifications logged so far are older than the ones applied from now
+  size_t replayed_count = 0;
+  {
+    std::vector<CatchUpEntry> log;
+    {
+      std::lock_guard<std::mutex> lock(catch_up_lock);
+      apply_during_build = true;
+      log.swap(catch_up_log);
+    }
+    replayed_count += log.size();
+    replay(log);
+
+    std::lock_guard<std::mutex> lock(catch_up_lock);
+    bulk_build_caught_up = true;
+  }
+  bulk_build_finished.notify_all();
+
+  // Rounds that leave the log open to the writers, until it is short
+  static const size_t kCatchUpLogLatchedSize = 1024;
+  while (true) {
+    std::vector<CatchUpEntry> log;
+    {
+      std::lock_guard<std::mutex> lock(catch_up_lock);
+      if (catch_up_log.size() <= kCatchUpLogLatchedSize) {
+        replayed_count += catch_up_log.size();
+        replay(catch_up_log);
+        catch_up_log.clear();
+        bulk_building = false;
+        break;
+      }
+      log.swap(catch_up_log);
+    }
+    replayed_count += log.size();
+    replay(log);
+  }
+
+  bulk_build_finished.notify_all();
+
+  LOG_DEBUG("Replayed %lu concurrent modifications of index %s",
+            replayed_count, GetName().c_str());
+
+  return;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::EnterModification() {
+  // Pairs with the wait in StartBulkBuild(): either the builder sees the
+  // modification as active, or the modification sees the build
+  active_modifications.fetch_add(1);
+  if (bulk_building == false) {
+    return true;
+  }
+
+  active_modifications.fetch_sub(1);
+  return false;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::LogModification(bool is_insert, const KeyType &key,
+                                        ValueType value, bool &ret) {
+  std::lock_guard<std::mutex> lock(catch_up_lock);
+  if (bulk_building == false) {
+    return false;
+  }
+
+  // Applied under the log latch, so the log keeps the order of the tree
+  if (apply_during_build == true) {
+    ret = is_insert ? container.Insert(key, value)
+                    : container.Delete(key, value);
+  }
+
+  catch_up_log.push_back(CatchUpEntry{is_insert, key, value});
+  return true;
+}
+
+/*
+ * SortBulkBuildEntries() - Sorts the entries by key, then by value
+ *
+ * Every partition is sorted by its own thread, then pairs of sorted
+ * partitions are merged in parallel until one partition is left. The same
+ * tuple may be seen twice by the scan (e.g. it moved while being scanned),
+ * so duplicate entries are removed at the end.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::SortBulkBuildEntries() {
+  auto &partitions = bulk_build_partitions;
+  auto less = [this](const KeyValuePair &a, const KeyValuePair &b) {
+    if (comparator(a.first, b.first) == true) return true;
+    if (comparator(b.first, a.first) == true) return false;
+    return std::less<ValueType>()(a.second, b.second);
+  };
+
+  std::vector<std::thread> threads;
+  for (auto &partition : partitions) {
+    threads.emplace_back([&partition, &less] {
+      std::sort(partition.begin(), partition.end(), less);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (size_t width = 1; width < partitions.size(); width *= 2) {
+    threads.clear();
+    for (size_t i = 0; i + width < partitions.size(); i += 2 * width) {
+      threads.emplace_back([&partitions, &less, i, width] {
+        auto &left = partitions[i];
+        auto &right = partitions[i + width];
+
+        std::vector<KeyValuePair> merged;
+        merged.reserve(left.size() + right.size());
+        std::merge(left.begin(), left.end(), right.begin(), right.end(),
+                   std::back_inserter(merged), less);
+
+        left.swap(merged);
+        std::vector<KeyValuePair>().swap(right);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  auto &entries = partitions[0];
+  auto last = std::unique(
+      entries.begin(), entries.end(),
+      [this](const KeyValuePair &a, const KeyValuePair &b) {
+        return equals(a.first, b.first) && a.second == b.second;
+      });
+  entries.erase(last, entries.end());
+
+  return;
+}
+
 /*
  * Scan() - Scans a range inside the index using index scan optimizer
  *
@@ -273,6 +550,37 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanKeyBatch() - Looks up a batch of keys
+ *
+ * The BwTree interleaves the traversals of the keys, so that the cache misses
+ * of different keys overlap instead of being taken one after another
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::ScanKeyBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+
+  results.resize(keys.size());
+  container.GetValueBatch(index_keys.data(), index_keys.size(),
+                          results.data());
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    size_t result_count = 0;
+    for (auto &result : results) {
+      result_count += result.size();
+    }
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result_count, metadata);
+  }
+
+  return;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
@@ -317,6 +625,21 @@ template class BWTreeIndex<GenericKey<256>, ItemPointer *,
                            GenericEqualityChecker<256>, GenericHasher<256>,
                            ItemPointerComparator, ItemPointerHashFunc>;
 
+// Normalized key
+template class BWTreeIndex<NormalizedKey<16>, ItemPointer *,
+                           NormalizedComparator<16>,
+                           NormalizedEqualityChecker<16>, NormalizedHasher<16>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<NormalizedKey<64>, ItemPointer *,
+                           NormalizedComparator<64>,
+                           NormalizedEqualityChecker<64>, NormalizedHasher<64>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<NormalizedKey<256>, ItemPointer *,
+                           NormalizedComparator<256>,
+                           NormalizedEqualityChecker<256>,
+                           NormalizedHasher<256>, ItemPointerComparator,
+                           ItemPointerHashFunc>;
+
 // Tuple key
 template class BWTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
                            TupleKeyEqualityChecker, TupleKeyHasher,
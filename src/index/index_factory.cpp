@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 
 #include "common/logger.h"
@@ -51,6 +52,13 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
     ints_only = false;
   }
 
+  // Other keys are encoded so that they compare with memcmp(), unless they
+  // are too large or have columns that can't be encoded
+  size_t normalized_key_size = 0;
+  if (ints_only == false) {
+    normalized_key_size = GetNormalizedKeySize(metadata->key_schema);
+  }
+
   auto index_type = metadata->GetIndexType();
   Index *index = nullptr;
   LOG_TRACE("Index type : %s", IndexTypeToString(index_type).c_str());
@@ -61,6 +69,9 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   if (index_type == IndexType::BWTREE) {
     if (ints_only) {
       index = IndexFactory::GetBwTreeIntsKeyIndex(metadata);
+    } else if (normalized_key_size > 0) {
+      index = IndexFactory::GetBwTreeNormalizedKeyIndex(metadata,
+                                                        normalized_key_size);
     } else {
       index = IndexFactory::GetBwTreeGenericKeyIndex(metadata);
     }
@@ -71,6 +82,9 @@ Index *IndexFactory::GetIndex(IndexMetadata *metadata) {
   } else if (index_type == IndexType::SKIPLIST) {
     if (ints_only) {
       index = IndexFactory::GetSkipListIntsKeyIndex(metadata);
+    } else if (normalized_key_size > 0) {
+      index = IndexFactory::GetSkipListNormalizedKeyIndex(metadata,
+                                                          normalized_key_size);
     } else {
       index = IndexFactory::GetSkipListGenericKeyIndex(metadata);
     }
@@ -215,6 +229,53 @@ Index *IndexFactory::GetBwTreeGenericKeyIndex(IndexMetadata *metadata) {
   return (index);
 }
 
+Index *IndexFactory::GetBwTreeNormalizedKeyIndex(IndexMetadata *metadata,
+                                                 size_t key_size) {
+  // Our new Index!
+  Index *index = nullptr;
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<16>";
+#endif
+    index = new BWTreeIndex<NormalizedKey<16>, ItemPointer *,
+                            NormalizedComparator<16>,
+                            NormalizedEqualityChecker<16>, NormalizedHasher<16>,
+                            ItemPointerComparator, ItemPointerHashFunc>(
+        metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<64>";
+#endif
+    index = new BWTreeIndex<NormalizedKey<64>, ItemPointer *,
+                            NormalizedComparator<64>,
+                            NormalizedEqualityChecker<64>, NormalizedHasher<64>,
+                            ItemPointerComparator, ItemPointerHashFunc>(
+        metadata);
+  } else if (key_size <= 256) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<256>";
+#endif
+    index = new BWTreeIndex<NormalizedKey<256>, ItemPointer *,
+                            NormalizedComparator<256>,
+                            NormalizedEqualityChecker<256>,
+                            NormalizedHasher<256>, ItemPointerComparator,
+                            ItemPointerHashFunc>(metadata);
+  } else {
+    throw IndexException("Unsupported NormalizedKey scheme");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
 Index *IndexFactory::GetSkipListIntsKeyIndex(IndexMetadata *metadata) {
   // Our new Index!
   Index *index = nullptr;
@@ -341,6 +402,68 @@ Index *IndexFactory::GetSkipListGenericKeyIndex(IndexMetadata *metadata) {
   return (index);
 }
 
+Index *IndexFactory::GetSkipListNormalizedKeyIndex(IndexMetadata *metadata,
+                                                   size_t key_size) {
+  // Our new Index!
+  Index *index = nullptr;
+
+// Debug Output
+#ifdef LOG_TRACE_ENABLED
+  std::string comparatorType;
+#endif
+
+  if (key_size <= 16) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<16>";
+#endif
+    index = new SkipListIndex<NormalizedKey<16>, ItemPointer *,
+                              NormalizedComparator<16>,
+                              NormalizedEqualityChecker<16>,
+                              ItemPointerComparator>(metadata);
+  } else if (key_size <= 64) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<64>";
+#endif
+    index = new SkipListIndex<NormalizedKey<64>, ItemPointer *,
+                              NormalizedComparator<64>,
+                              NormalizedEqualityChecker<64>,
+                              ItemPointerComparator>(metadata);
+  } else if (key_size <= 256) {
+#ifdef LOG_TRACE_ENABLED
+    comparatorType = "NormalizedKey<256>";
+#endif
+    index = new SkipListIndex<NormalizedKey<256>, ItemPointer *,
+                              NormalizedComparator<256>,
+                              NormalizedEqualityChecker<256>,
+                              ItemPointerComparator>(metadata);
+  } else {
+    throw IndexException("Unsupported NormalizedKey scheme");
+  }
+
+#ifdef LOG_TRACE_ENABLED
+  LOG_TRACE("%s", IndexFactory::GetInfo(metadata, comparatorType).c_str());
+#endif
+  return (index);
+}
+
+size_t IndexFactory::GetNormalizedKeySize(const catalog::Schema *key_schema) {
+  if (NormalizedKeyEncoder::IsSupported(key_schema) == false) {
+    return 0;
+  }
+
+  // The key keeps a copy of the tuple data, which must fit
+  size_t tuple_size = key_schema->GetLength();
+  if (tuple_size > 256) {
+    return 0;
+  }
+
+  // Long strings make large keys, and large nodes. Their encoding is cut off
+  // after 64 bytes, which almost always decides the comparison
+  return std::max<size_t>(
+      tuple_size,
+      std::min<size_t>(NormalizedKeyEncoder::GetExpectedSize(key_schema), 64));
+}
+
 std::string IndexFactory::GetInfo(IndexMetadata *metadata,
                                   std::string comparatorType) {
   std::ostringstream os;
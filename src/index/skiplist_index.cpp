@@ -156,6 +156,20 @@ template class SkipListIndex<
     GenericKey<256>, ItemPointer *, FastGenericComparator<256>,
     GenericEqualityChecker<256>, ItemPointerComparator>;
 
+// Normalized key
+template class SkipListIndex<NormalizedKey<16>, ItemPointer *,
+                             NormalizedComparator<16>,
+                             NormalizedEqualityChecker<16>,
+                             ItemPointerComparator>;
+template class SkipListIndex<NormalizedKey<64>, ItemPointer *,
+                             NormalizedComparator<64>,
+                             NormalizedEqualityChecker<64>,
+                             ItemPointerComparator>;
+template class SkipListIndex<NormalizedKey<256>, ItemPointer *,
+                             NormalizedComparator<256>,
+                             NormalizedEqualityChecker<256>,
+                             ItemPointerComparator>;
+
 // Tuple key
 template class SkipListIndex<TupleKey, ItemPointer *, TupleKeyComparator,
                              TupleKeyEqualityChecker, ItemPointerComparator>;
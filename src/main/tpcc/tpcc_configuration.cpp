@@ -38,6 +38,7 @@ void Usage(FILE *out) {
           "   -n --gc_backend_count  :  # of gc backends \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -c --conflict          :  on conflict: abort (default) or wait \n"
   );
 }
 
@@ -54,6 +55,7 @@ static struct option opts[] = {
     { "gc_backend_count", optional_argument, NULL, 'n' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "conflict", optional_argument, NULL, 'c' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -123,6 +125,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.conflict = ConflictAvoidanceType::ABORT;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -138,7 +141,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:l:y:c:", opts, &idx);
 
     if (c == -1) break;
 
@@ -163,6 +166,18 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 'c': {
+        char *conflict = optarg;
+        if (strcmp(conflict, "abort") == 0) {
+          state.conflict = ConflictAvoidanceType::ABORT;
+        } else if (strcmp(conflict, "wait") == 0) {
+          state.conflict = ConflictAvoidanceType::WAIT;
+        } else {
+          LOG_ERROR("Unknown conflict avoidance: %s", conflict);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -221,6 +236,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateWarehouseCount(state);
   ValidateGCBackendCount(state);
 
+  LOG_TRACE("%s : %s", "conflict avoidance",
+            ConflictAvoidanceTypeToString(state.conflict).c_str());
   LOG_TRACE("%s : %d", "Run client affinity", state.affinity);
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
   LOG_TRACE("%s : %d", "Run garbage collection", state.gc_mode);
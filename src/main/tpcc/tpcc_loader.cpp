@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -63,6 +64,9 @@ const size_t credit_length = 2;
 const size_t phone_length = 32;
 const size_t dist_length = 32;
 
+// number of rows that a loader inserts at once
+const size_t load_batch_size = 1000;
+
 double item_min_price = 1.0;
 double item_max_price = 100.0;
 
@@ -1553,14 +1557,22 @@ void LoadItems() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   std::unique_ptr<type::AbstractPool> pool(new type::EphemeralPool());
-  std::unique_ptr<executor::ExecutorContext> context(
-      new executor::ExecutorContext(txn));
+
+  // the items are inserted in batches
+  std::vector<std::unique_ptr<storage::Tuple>> item_tuples;
+  std::vector<const storage::Tuple *> item_batch;
 
   for (auto item_itr = 0; item_itr < state.item_count; item_itr++) {
     auto item_tuple = BuildItemTuple(item_itr, pool);
-    planner::InsertPlan node(item_table, std::move(item_tuple));
-    executor::InsertExecutor executor(&node, context.get());
-    executor.Execute();
+    item_batch.push_back(item_tuple.get());
+    item_tuples.push_back(std::move(item_tuple));
+
+    if (item_batch.size() == load_batch_size ||
+        item_itr == state.item_count - 1) {
+      item_table->InsertTuples(item_batch, txn);
+      item_batch.clear();
+      item_tuples.clear();
+    }
   }
 
   txn_manager.CommitTransaction(txn);
@@ -1661,18 +1673,19 @@ void LoadWarehouses(const int &warehouse_from, const int &warehouse_to) {
         }
 
         // ORDER_LINE
+        // the order lines of an order are inserted as one batch
+        std::vector<std::unique_ptr<storage::Tuple>> order_line_tuples;
+        std::vector<const storage::Tuple *> order_line_batch;
         for (auto order_line_itr = 0; order_line_itr < o_ol_cnt;
              order_line_itr++) {
           int ol_supply_w_id = warehouse_itr;
           auto order_line_tuple = BuildOrderLineTuple(
               orders_itr, district_itr, warehouse_itr, order_line_itr,
               ol_supply_w_id, new_order, pool);
-          planner::InsertPlan order_line_node(order_line_table,
-                                              std::move(order_line_tuple));
-          executor::InsertExecutor order_line_executor(&order_line_node,
-                                                       context.get());
-          order_line_executor.Execute();
+          order_line_batch.push_back(order_line_tuple.get());
+          order_line_tuples.push_back(std::move(order_line_tuple));
         }
+        order_line_table->InsertTuples(order_line_batch, txn);
 
         txn_manager.CommitTransaction(txn);
       }
@@ -1680,15 +1693,22 @@ void LoadWarehouses(const int &warehouse_from, const int &warehouse_to) {
     }  // END DISTRICTS
 
     // STOCK
-    for (auto stock_itr = 0; stock_itr < state.item_count; stock_itr++) {
+    // every batch of stock rows is inserted by its own transaction
+    for (auto stock_from = 0; stock_from < state.item_count;
+         stock_from += load_batch_size) {
+      auto stock_to = std::min(stock_from + (int)load_batch_size,
+                               state.item_count);
       auto txn = txn_manager.BeginTransaction();
-      context.reset(new executor::ExecutorContext(txn));
 
-      int s_w_id = warehouse_itr;
-      auto stock_tuple = BuildStockTuple(stock_itr, s_w_id, pool);
-      planner::InsertPlan stock_node(stock_table, std::move(stock_tuple));
-      executor::InsertExecutor stock_executor(&stock_node, context.get());
-      stock_executor.Execute();
+      std::vector<std::unique_ptr<storage::Tuple>> stock_tuples;
+      std::vector<const storage::Tuple *> stock_batch;
+      for (auto stock_itr = stock_from; stock_itr < stock_to; stock_itr++) {
+        int s_w_id = warehouse_itr;
+        auto stock_tuple = BuildStockTuple(stock_itr, s_w_id, pool);
+        stock_batch.push_back(stock_tuple.get());
+        stock_tuples.push_back(std::move(stock_tuple));
+      }
+      stock_table->InsertTuples(stock_batch, txn);
 
       txn_manager.CommitTransaction(txn);
     }
@@ -1737,6 +1757,15 @@ void LoadTPCCDatabase() {
   UNUSED_ATTRIBUTE double diff = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
   LOG_INFO("database loading time = %lf ms", diff);
 
+  UNUSED_ATTRIBUTE size_t loaded_tuple_count =
+      warehouse_table->GetTupleCount() + district_table->GetTupleCount() +
+      item_table->GetTupleCount() + customer_table->GetTupleCount() +
+      history_table->GetTupleCount() + stock_table->GetTupleCount() +
+      orders_table->GetTupleCount() + new_order_table->GetTupleCount() +
+      order_line_table->GetTupleCount();
+  LOG_INFO("database loading throughput = %lf tuples/s",
+           loaded_tuple_count / diff * 1000);
+
   LOG_INFO("============TABLE SIZES==========");
   LOG_INFO("warehouse count = %lu", warehouse_table->GetTupleCount());
   LOG_INFO("district count  = %lu", district_table->GetTupleCount());
@@ -17,6 +17,7 @@
 #include "benchmark/tpch/tpch_configuration.h"
 #include "benchmark/tpch/tpch_database.h"
 #include "benchmark/tpch/tpch_workload.h"
+#include "codegen/operator/hash_join_translator.h"
 #include "common/logger.h"
 
 namespace peloton {
@@ -31,12 +32,14 @@ void Usage(FILE *out) {
           "   -n --num-runs          :  the number of runs to execute for each query \n"
           "   -s --suffix            :  input file suffix \n"
           "   -d --dict-encode       :  dictionary encode \n"
+          "   -r --radix-join        :  radix partition all hash joins \n"
           "   -q --queries           :  comma-separated list of queries to run (i.g., 1,14 for Q1 and Q14) \n");
 }
 
 static struct option opts[] = {
     {"input-dir", required_argument, NULL, 'i'},
     {"dict-encode", optional_argument, NULL, 'd'},
+    {"radix-join", no_argument, NULL, 'r'},
     {"queries", optional_argument, NULL, 'q'},
     {NULL, 0, NULL, 0}};
 
@@ -46,7 +49,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hi:n:s:dq:", opts, &idx);
+    int c = getopt_long(argc, argv, "hi:n:s:drq:", opts, &idx);
 
     if (c == -1) break;
 
@@ -64,6 +67,10 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
         config.dictionary_encode = true;
         break;
       }
+      case 'r': {
+        config.radix_join = true;
+        break;
+      }
       case 'q': {
         char *csv_queries = optarg;
         config.SetRunnableQueries(csv_queries);
@@ -89,6 +96,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   LOG_INFO("Input directory   : '%s'", config.data_dir.c_str());
   LOG_INFO("Dictionary encode : %s",
            config.dictionary_encode ? "true" : "false");
+  LOG_INFO("Radix join        : %s", config.radix_join ? "true" : "false");
   for (uint32_t i = 0; i < 22; i++) {
     LOG_INFO("Run query %u : %s", i + 1,
              config.queries_to_run[i] ? "true" : "false");
@@ -96,6 +104,12 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
 }
 
 void RunBenchmark(const Configuration &config) {
+  // Joins that are small enough for one hash table are only partitioned when
+  // asked, so Q3 can be compared in both modes
+  if (config.radix_join) {
+    codegen::HashJoinTranslator::kUseRadixPartitioning = true;
+  }
+
   // Create the DB instance
   TPCHDatabase tpch_db{config};
 
@@ -42,6 +42,7 @@ void Usage(FILE *out) {
           "   -n --gc_backend_count  :  # of gc backends \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -t --protocol          :  protocol: timestamp_ordering or optimistic \n"
   );
 }
 
@@ -61,6 +62,7 @@ static struct option opts[] = {
     { "gc_backend_count", optional_argument, NULL, 'n' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "protocol", optional_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -156,6 +158,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.protocol = ProtocolType::TIMESTAMP_ORDERING;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -173,7 +176,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:t:", opts, &idx);
 
     if (c == -1) break;
 
@@ -198,6 +201,18 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 't': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "timestamp_ordering") == 0) {
+          state.protocol = ProtocolType::TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "optimistic") == 0) {
+          state.protocol = ProtocolType::OPTIMISTIC;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -263,6 +278,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateZipfTheta(state);
   ValidateGCBackendCount(state);
 
+  LOG_TRACE("%s : %s", "protocol",
+            ProtocolTypeToString(state.protocol).c_str());
   LOG_TRACE("%s : %d", "Run exponential backoff", state.exp_backoff);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
   LOG_TRACE("%s : %d", "Run garbage collection", state.gc_mode);
@@ -48,6 +48,9 @@ storage::Database *ycsb_database = nullptr;
 
 storage::DataTable *user_table = nullptr;
 
+// number of rows that a loader inserts at once
+static const size_t load_batch_size = 1000;
+
 void CreateYCSBDatabase() {
   const oid_t col_count = state.column_count + 1;
   const bool is_inlined = false;
@@ -139,8 +142,10 @@ void LoadYCSBRows(const int begin_rowid, const int end_rowid) {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   const bool allocate = true;
   auto txn = txn_manager.BeginTransaction();
-  std::unique_ptr<executor::ExecutorContext> context(
-      new executor::ExecutorContext(txn));
+
+  // the rows are inserted in batches
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> batch;
 
   for (int rowid = begin_rowid; rowid < end_rowid; rowid++) {
     std::unique_ptr<storage::Tuple> tuple(
@@ -162,9 +167,14 @@ void LoadYCSBRows(const int begin_rowid, const int end_rowid) {
       }
     }
 
-    planner::InsertPlan node(user_table, std::move(tuple));
-    executor::InsertExecutor executor(&node, context.get());
-    executor.Execute();
+    batch.push_back(tuple.get());
+    tuples.push_back(std::move(tuple));
+
+    if (batch.size() == load_batch_size || rowid == end_rowid - 1) {
+      user_table->InsertTuples(batch, txn);
+      batch.clear();
+      tuples.clear();
+    }
   }
 
   txn_manager.CommitTransaction(txn);
@@ -198,6 +208,8 @@ void LoadYCSBDatabase() {
   std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
   double diff = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
   LOG_INFO("database table loading time = %lf ms", diff);
+  LOG_INFO("database table loading throughput = %lf tuples/s",
+           tuple_count / diff * 1000);
 
   LOG_INFO("============TABLE SIZES==========");
   LOG_INFO("user count = %lu", user_table->GetTupleCount());
@@ -83,6 +83,9 @@ void ChildPropertyGenerator::Visit(const PhysicalOuterNLJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalInnerHashJoin *op) {
   JoinHelper(op);
 };
+void ChildPropertyGenerator::Visit(const PhysicalInnerIndexJoin *op) {
+  JoinHelper(op);
+};
 
 void ChildPropertyGenerator::Visit(const PhysicalLeftHashJoin *){};
 void ChildPropertyGenerator::Visit(const PhysicalRightHashJoin *){};
@@ -321,6 +324,8 @@ void ChildPropertyGenerator::JoinHelper(const BaseOperatorNode *op) {
     join_cond = ((PhysicalInnerHashJoin *)op)->join_predicate.get();
   else if (op->type() == OpType::InnerNLJoin)
     join_cond = ((PhysicalInnerNLJoin *)op)->join_predicate.get();
+  else if (op->type() == OpType::InnerIndexJoin)
+    join_cond = ((PhysicalInnerIndexJoin *)op)->join_predicate.get();
 
   ExprSet child_cols;
   ExprSet provided_cols;
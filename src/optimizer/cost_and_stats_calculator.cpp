@@ -14,6 +14,11 @@
 #include "optimizer/column_manager.h"
 #include "optimizer/stats.h"
 #include "optimizer/properties.h"
+#include "optimizer/stats/cost.h"
+#include "optimizer/stats/stats_storage.h"
+#include "optimizer/util.h"
+#include "index/index.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace optimizer {
@@ -39,16 +44,18 @@ void CostAndStatsCalculator::Visit(const DummyScan *) {
   output_cost_ = 0;
 }
 
-void CostAndStatsCalculator::Visit(const PhysicalSeqScan *) {
+void CostAndStatsCalculator::Visit(const PhysicalSeqScan *op) {
   // TODO : Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
+  // Scan predicates have no selectivity estimates, so a scan is estimated to
+  // produce the whole table
+  output_stats_.reset(new Stats(nullptr, op->table_->GetTupleCount()));
   output_cost_ = 1;
 };
 void CostAndStatsCalculator::Visit(const PhysicalIndexScan *op) {
   // Simple cost function
   // indexSearchable ? Index : SeqScan
   // TODO : Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
+  output_stats_.reset(new Stats(nullptr, op->table_->GetTupleCount()));
   auto predicate_prop =
       output_properties_->GetPropertyOfType(PropertyType::PREDICATE)
           ->As<PropertyPredicate>();
@@ -73,7 +80,7 @@ void CostAndStatsCalculator::Visit(const PhysicalIndexScan *op) {
 };
 void CostAndStatsCalculator::Visit(const PhysicalProject *) {
   // TODO: Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
+  output_stats_.reset(new Stats(nullptr, GetChildNumRows(0)));
   output_cost_ = 0;
 }
 void CostAndStatsCalculator::Visit(const PhysicalOrderBy *) {
@@ -86,15 +93,39 @@ void CostAndStatsCalculator::Visit(const PhysicalLimit *) {
 }
 void CostAndStatsCalculator::Visit(const PhysicalFilter *){};
 void CostAndStatsCalculator::Visit(const PhysicalInnerNLJoin *){
-  // TODO: Replace with more accurate cost
-  output_cost_ = 1;
+  output_cost_ = Cost::InnerNLJoin(GetChildNumRows(0), GetChildNumRows(1));
 };
 void CostAndStatsCalculator::Visit(const PhysicalLeftNLJoin *){};
 void CostAndStatsCalculator::Visit(const PhysicalRightNLJoin *){};
 void CostAndStatsCalculator::Visit(const PhysicalOuterNLJoin *){};
 void CostAndStatsCalculator::Visit(const PhysicalInnerHashJoin *){
-  // TODO: Replace with more accurate cost
-  output_cost_ = 0;
+  output_cost_ = Cost::InnerHashJoin(GetChildNumRows(0), GetChildNumRows(1));
+};
+void CostAndStatsCalculator::Visit(const PhysicalInnerIndexJoin *op) {
+  output_stats_.reset(new Stats(nullptr));
+
+  std::vector<oid_t> join_column_ids;
+  util::GetIndexJoinColumns(op->table_alias, op->join_predicate.get(),
+                            join_column_ids);
+  // The inner table is probed instead of scanned, so it has no child
+  size_t outer_rows = GetChildNumRows(0);
+  size_t inner_rows = op->table->GetTupleCount();
+  oid_t index_offset = 0;
+  if (!util::FindIndexForJoinColumns(op->table, join_column_ids,
+                                     index_offset)) {
+    output_cost_ = Cost::InnerNLJoin(outer_rows, inner_rows);
+    return;
+  }
+
+  auto index = op->table->GetIndex(index_offset);
+  const auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+  std::shared_ptr<TableStats> inner_stats;
+  if (!index->HasUniqueKeys()) {
+    inner_stats = StatsStorage::GetInstance()->GetTableStats(
+        op->table->GetDatabaseOid(), op->table->GetOid());
+  }
+  output_cost_ = Cost::InnerIndexJoin(outer_rows, inner_rows, inner_stats,
+                                      key_attrs, index->HasUniqueKeys());
 };
 void CostAndStatsCalculator::Visit(const PhysicalLeftHashJoin *){};
 void CostAndStatsCalculator::Visit(const PhysicalRightHashJoin *){};
@@ -128,5 +159,12 @@ void CostAndStatsCalculator::Visit(const PhysicalDistinct *) {
   output_cost_ = 0;
 };
 
+size_t CostAndStatsCalculator::GetChildNumRows(size_t child_idx) const {
+  if (child_idx >= child_stats_.size() || child_stats_[child_idx] == nullptr) {
+    return 0;
+  }
+  return child_stats_[child_idx]->GetNumRows();
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -14,6 +14,7 @@
 #include "planner/update_plan.h"
 
 #include "expression/aggregate_expression.h"
+#include "index/index.h"
 #include "optimizer/operator_expression.h"
 #include "optimizer/operator_to_plan_transformer.h"
 #include "optimizer/util.h"
@@ -23,6 +24,7 @@
 #include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
+#include "planner/index_join_plan.h"
 #include "planner/index_scan_plan.h"
 #include "planner/abstract_join_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -199,6 +201,16 @@ void OperatorToPlanTransformer::Visit(const PhysicalLimit *) {
   // Limit Operator does not change the column mapping
   *output_expr_map_ = children_expr_map_[0];
 
+  // A sort below the limit only has to produce the tuples up to the end of
+  // the limit
+  if (children_plans_[0]->GetPlanNodeType() == PlanNodeType::ORDERBY) {
+    auto *order_by_plan =
+        static_cast<planner::OrderByPlan *>(children_plans_[0].get());
+    order_by_plan->SetLimit(true);
+    order_by_plan->SetLimitNumber(limit_prop->GetLimit());
+    order_by_plan->SetLimitOffset(limit_prop->GetOffset());
+  }
+
   unique_ptr<planner::AbstractPlan> limit_plan(
       new planner::LimitPlan(limit_prop->GetLimit(), limit_prop->GetOffset()));
   limit_plan->AddChild(move(children_plans_[0]));
@@ -340,6 +352,11 @@ void OperatorToPlanTransformer::Visit(const PhysicalInnerHashJoin *op) {
       move(GenerateJoinPlan((op->join_predicate).get(), JoinType::INNER, true));
 }
 
+void OperatorToPlanTransformer::Visit(const PhysicalInnerIndexJoin *op) {
+  output_plan_ = move(GenerateJoinPlan((op->join_predicate).get(),
+                                       JoinType::INNER, false, op));
+}
+
 void OperatorToPlanTransformer::Visit(const PhysicalLeftHashJoin *) {}
 
 void OperatorToPlanTransformer::Visit(const PhysicalRightHashJoin *) {}
@@ -549,7 +566,15 @@ OperatorToPlanTransformer::GenerateAggregatePlan(
 
 unique_ptr<planner::AbstractPlan> OperatorToPlanTransformer::GenerateJoinPlan(
     expression::AbstractExpression *join_predicate, JoinType join_type,
-    bool is_hash) {
+    bool is_hash, const PhysicalInnerIndexJoin *index_join) {
+  // The inner columns the index join may look up, decided before the join
+  // predicate is bound to the children
+  vector<oid_t> index_join_column_ids;
+  if (index_join != nullptr) {
+    util::GetIndexJoinColumns(index_join->table_alias, join_predicate,
+                              index_join_column_ids);
+  }
+
   auto cols_prop = requirements_->GetPropertyOfType(PropertyType::COLUMNS)
                        ->As<PropertyColumns>();
 
@@ -662,12 +687,81 @@ unique_ptr<planner::AbstractPlan> OperatorToPlanTransformer::GenerateJoinPlan(
     unique_ptr<planner::HashPlan> hash_plan(new planner::HashPlan(hash_keys));
     hash_plan->AddChild(move(children_plans_[1]));
 
-    join_plan = unique_ptr<planner::AbstractPlan>(
+    unique_ptr<planner::HashJoinPlan> hash_join_plan(
         new planner::HashJoinPlan(join_type, move(predicate), move(proj_info),
                                   schema_ptr, left_hash_keys, right_hash_keys));
 
+    // The compiled join builds its hash table on the left child. A scan is
+    // estimated to produce the whole table, so that joins building on large
+    // tables are radix-partitioned
+    auto left_scan =
+        dynamic_cast<planner::AbstractScan *>(children_plans_[0].get());
+    if (left_scan != nullptr && left_scan->GetTable() != nullptr) {
+      hash_join_plan->SetBuildSizeEstimate(
+          left_scan->GetTable()->GetTupleCount());
+    }
+
+    join_plan = move(hash_join_plan);
     join_plan->AddChild(move(children_plans_[0]));
     join_plan->AddChild(move(hash_plan));
+  } else if (index_join != nullptr) {
+    // Generate index join plan. The right child is the scan of the inner
+    // table, whose columns and predicate are applied to the tuples found in
+    // the index instead
+    auto scan_plan =
+        dynamic_cast<planner::AbstractScan *>(children_plans_[1].get());
+    PL_ASSERT(scan_plan != nullptr);
+    auto table = scan_plan->GetTable();
+    const auto &column_ids = scan_plan->GetColumnIds();
+
+    oid_t index_offset = 0;
+    UNUSED_ATTRIBUTE bool index_found = util::FindIndexForJoinColumns(
+        table, index_join_column_ids, index_offset);
+    PL_ASSERT(index_found);
+    auto index = table->GetIndex(index_offset);
+    const auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+
+    // The outer keys are ordered as the key columns of the index. Join
+    // columns that are not used for the key are checked by the predicate
+    vector<unique_ptr<const expression::AbstractExpression>> outer_keys(
+        key_attrs.size());
+    PL_ASSERT(left_hash_keys.size() == right_hash_keys.size());
+    for (size_t i = 0; i < right_hash_keys.size(); i++) {
+      auto l_key = reinterpret_cast<const expression::TupleValueExpression *>(
+          left_hash_keys[i].get());
+      auto r_key = reinterpret_cast<const expression::TupleValueExpression *>(
+          right_hash_keys[i].get());
+      oid_t col_id = column_ids[r_key->GetColumnId()];
+      auto key_itr = std::find(key_attrs.begin(), key_attrs.end(), col_id);
+      size_t key_offset = key_itr - key_attrs.begin();
+      if (key_itr != key_attrs.end() && outer_keys[key_offset] == nullptr &&
+          std::find(index_join_column_ids.begin(), index_join_column_ids.end(),
+                    col_id) != index_join_column_ids.end()) {
+        outer_keys[key_offset] = move(left_hash_keys[i]);
+        continue;
+      }
+
+      auto *equality = expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL,
+          new expression::TupleValueExpression(l_key->GetValueType(), 0,
+                                               l_key->GetColumnId()),
+          new expression::TupleValueExpression(r_key->GetValueType(), 1,
+                                               r_key->GetColumnId()));
+      if (predicate == nullptr) {
+        predicate.reset(equality);
+      } else {
+        predicate.reset(expression::ExpressionUtil::ConjunctionFactory(
+            ExpressionType::CONJUNCTION_AND, predicate.release(), equality));
+      }
+    }
+
+    unique_ptr<const expression::AbstractExpression> inner_predicate(
+        scan_plan->GetPredicate() != nullptr ? scan_plan->GetPredicate()->Copy()
+                                             : nullptr);
+    join_plan = unique_ptr<planner::AbstractPlan>(new planner::IndexJoinPlan(
+        join_type, move(predicate), move(proj_info), schema_ptr, table, index,
+        outer_keys, column_ids, move(inner_predicate)));
+    join_plan->AddChild(move(children_plans_[0]));
   } else {
     // NL Join plan use offset for join column
     vector<oid_t> left_join_col_ids, right_join_col_ids;
@@ -302,6 +302,18 @@ Operator PhysicalInnerHashJoin::make(std::shared_ptr<expression::AbstractExpress
   return Operator(join);
 }
 
+//===--------------------------------------------------------------------===//
+// InnerIndexJoin
+//===--------------------------------------------------------------------===//
+Operator PhysicalInnerIndexJoin::make(std::shared_ptr<expression::AbstractExpression> join_predicate,
+                                      storage::DataTable *table, std::string table_alias) {
+  PhysicalInnerIndexJoin *join = new PhysicalInnerIndexJoin();
+  join->join_predicate = join_predicate;
+  join->table = table;
+  join->table_alias = table_alias;
+  return Operator(join);
+}
+
 //===--------------------------------------------------------------------===//
 // LeftHashJoin
 //===--------------------------------------------------------------------===//
@@ -539,6 +551,9 @@ template <>
 std::string OperatorNode<PhysicalInnerHashJoin>::name_ =
     "PhysicalInnerHashJoin";
 template <>
+std::string OperatorNode<PhysicalInnerIndexJoin>::name_ =
+    "PhysicalInnerIndexJoin";
+template <>
 std::string OperatorNode<PhysicalLeftHashJoin>::name_ = "PhysicalLeftHashJoin";
 template <>
 std::string OperatorNode<PhysicalRightHashJoin>::name_ =
@@ -615,6 +630,8 @@ OpType OperatorNode<PhysicalOuterNLJoin>::type_ = OpType::OuterNLJoin;
 template <>
 OpType OperatorNode<PhysicalInnerHashJoin>::type_ = OpType::InnerHashJoin;
 template <>
+OpType OperatorNode<PhysicalInnerIndexJoin>::type_ = OpType::InnerIndexJoin;
+template <>
 OpType OperatorNode<PhysicalLeftHashJoin>::type_ = OpType::LeftHashJoin;
 template <>
 OpType OperatorNode<PhysicalRightHashJoin>::type_ = OpType::RightHashJoin;
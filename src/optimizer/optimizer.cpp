@@ -34,7 +34,6 @@
 #include "planner/drop_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
-#include "planner/seq_scan_plan.h"
 #include "planner/populate_index_plan.h"
 #include "planner/analyze_plan.h"
 
@@ -72,6 +71,7 @@ Optimizer::Optimizer() {
   physical_implementation_rules_.emplace_back(new RightJoinToRightNLJoin());
   physical_implementation_rules_.emplace_back(new OuterJoinToOuterNLJoin());
   physical_implementation_rules_.emplace_back(new InnerJoinToInnerHashJoin());
+  physical_implementation_rules_.emplace_back(new InnerJoinToInnerIndexJoin());
 }
 
 shared_ptr<planner::AbstractPlan> Optimizer::BuildPelotonPlanTree(
@@ -158,15 +158,10 @@ unique_ptr<planner::AbstractPlan> Optimizer::HandleDDLStatement(
         for (auto column_name : create_plan->GetIndexAttributes()) {
           column_ids.push_back(schema->GetColumnID(column_name));
         }
-        // Create a plan to retrieve data
-        std::unique_ptr<planner::SeqScanPlan> child_SeqScanPlan(
-            new planner::SeqScanPlan(target_table, nullptr, column_ids, false));
-
-        child_SeqScanPlan->AddChild(std::move(ddl_plan));
-        ddl_plan = std::move(child_SeqScanPlan);
-        // Create a plan to add data to index
+        // Create a plan to build the index over the tuples of the table
         std::unique_ptr<planner::AbstractPlan> child_PopulateIndexPlan(
-            new planner::PopulateIndexPlan(target_table, column_ids));
+            new planner::PopulateIndexPlan(target_table, column_ids,
+                                           create_plan->GetIndexName()));
         child_PopulateIndexPlan->AddChild(std::move(ddl_plan));
         ddl_plan = std::move(child_PopulateIndexPlan);
       }
@@ -569,6 +569,65 @@ void InnerJoinToInnerHashJoin::Transform(
   return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// InnerJoinToInnerIndexJoin
+InnerJoinToInnerIndexJoin::InnerJoinToInnerIndexJoin() {
+  physical = true;
+
+  // The inner side has to be a base table, whose index is probed
+  std::shared_ptr<Pattern> left_child(std::make_shared<Pattern>(OpType::Leaf));
+  std::shared_ptr<Pattern> right_child(std::make_shared<Pattern>(OpType::Get));
+
+  // Initialize a pattern for optimizer to match
+  match_pattern = std::make_shared<Pattern>(OpType::InnerJoin);
+
+  // Add node - we match join relation R and S
+  match_pattern->AddChild(left_child);
+  match_pattern->AddChild(right_child);
+
+  return;
+}
+
+bool InnerJoinToInnerIndexJoin::Check(std::shared_ptr<OperatorExpression> plan,
+                                      Memo *memo) const {
+  (void)memo;
+  auto children = plan->Children();
+  PL_ASSERT(children.size() == 2);
+  const LogicalGet *get = children[1]->Op().As<LogicalGet>();
+  if (get->table == nullptr) return false;
+
+  // The join must compare all key columns of an index of the inner table
+  auto expr = plan->Op().As<LogicalInnerJoin>()->join_predicate.get();
+  std::vector<oid_t> join_column_ids;
+  util::GetIndexJoinColumns(get->table_alias, expr, join_column_ids);
+  if (join_column_ids.empty()) return false;
+
+  oid_t index_offset;
+  return util::FindIndexForJoinColumns(get->table, join_column_ids,
+                                       index_offset);
+}
+
+void InnerJoinToInnerIndexJoin::Transform(
+    std::shared_ptr<OperatorExpression> input,
+    std::vector<std::shared_ptr<OperatorExpression>> &transformed) const {
+  const LogicalInnerJoin *inner_join = input->Op().As<LogicalInnerJoin>();
+  std::vector<std::shared_ptr<OperatorExpression>> children = input->Children();
+  PL_ASSERT(children.size() == 2);
+  const LogicalGet *get = children[1]->Op().As<LogicalGet>();
+  auto result_plan = std::make_shared<OperatorExpression>(
+      PhysicalInnerIndexJoin::make(inner_join->join_predicate, get->table,
+                                   get->table_alias));
+
+  // The inner scan is kept as the right child. Its predicate and columns are
+  // applied to the tuples found in the index
+  result_plan->PushChild(children[0]);
+  result_plan->PushChild(children[1]);
+
+  transformed.push_back(result_plan);
+
+  return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LeftJoinToLeftHashJoin
 LeftJoinToLeftHashJoin::LeftJoinToLeftHashJoin() {
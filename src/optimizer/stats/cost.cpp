@@ -15,6 +15,7 @@
 #include "expression/comparison_expression.h"
 #include "optimizer/stats/cost.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace peloton {
@@ -151,6 +152,49 @@ double ProjectCost(const std::shared_ptr<TableStats> &input_stats,
   return input_stats->num_rows * DEFAULT_TUPLE_COST;
 }
 
+//===----------------------------------------------------------------------===//
+// JOIN
+//===----------------------------------------------------------------------===//
+static double EstimatedRows(size_t num_rows) {
+  return num_rows == 0 ? DEFAULT_NUM_ROWS : num_rows;
+}
+
+double Cost::InnerNLJoin(size_t outer_rows, size_t inner_rows) {
+  return EstimatedRows(outer_rows) * EstimatedRows(inner_rows) *
+         DEFAULT_TUPLE_COST;
+}
+
+double Cost::InnerHashJoin(size_t outer_rows, size_t inner_rows) {
+  double build_cost = EstimatedRows(outer_rows) *
+                      (DEFAULT_TUPLE_COST + DEFAULT_OPERATOR_COST);
+  double probe_cost = EstimatedRows(inner_rows) * DEFAULT_TUPLE_COST;
+  return build_cost + probe_cost;
+}
+
+double Cost::InnerIndexJoin(size_t outer_rows, size_t inner_rows,
+                            const std::shared_ptr<TableStats> &inner_stats,
+                            const std::vector<oid_t> &key_column_ids,
+                            bool unique_keys) {
+  double num_rows = EstimatedRows(inner_rows);
+  double matches = num_rows;
+  if (unique_keys) {
+    matches = 1;
+  } else if (inner_stats != nullptr && inner_stats->num_rows > 0) {
+    double cardinality = 1;
+    for (oid_t column_id : key_column_ids) {
+      cardinality *= inner_stats->GetCardinality(column_id);
+    }
+    double stats_rows = inner_stats->num_rows;
+    cardinality = std::max(1.0, std::min(cardinality, stats_rows));
+    matches = stats_rows / cardinality;
+  }
+
+  double index_cost =
+      (default_index_height(num_rows) + 1) * DEFAULT_INDEX_TUPLE_COST;
+  double probe_cost = index_cost + matches * DEFAULT_TUPLE_COST;
+  return EstimatedRows(outer_rows) * probe_cost;
+}
+
 //===----------------------------------------------------------------------===//
 // LIMIT
 //===----------------------------------------------------------------------===//
@@ -18,6 +18,7 @@
 #include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
 #include "catalog/schema.h"
+#include "index/index.h"
 
 #include <vector>
 #include <include/catalog/query_metrics_catalog.h>
@@ -317,9 +318,105 @@ bool ContainsJoinColumns(
   return false;
 }
 
+// The index key is built from the outer value, so both sides must compare the
+// same way. Integers of different widths are cast into the key
+static bool IsIndexJoinable(type::TypeId l_type, type::TypeId r_type) {
+  if (l_type == r_type) return true;
+  auto is_integer = [](type::TypeId type_id) {
+    return type_id == type::TypeId::TINYINT ||
+           type_id == type::TypeId::SMALLINT ||
+           type_id == type::TypeId::INTEGER || type_id == type::TypeId::BIGINT;
+  };
+  return is_integer(l_type) && is_integer(r_type);
+}
+
+void GetIndexJoinColumns(const std::string& inner_alias,
+                         const expression::AbstractExpression* expr,
+                         std::vector<oid_t>& inner_column_ids) {
+  if (expr == nullptr) return;
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    GetIndexJoinColumns(inner_alias, expr->GetChild(0), inner_column_ids);
+    GetIndexJoinColumns(inner_alias, expr->GetChild(1), inner_column_ids);
+    return;
+  }
+  if (expr->GetExpressionType() != ExpressionType::COMPARE_EQUAL) return;
+
+  auto l_expr = expr->GetChild(0);
+  auto r_expr = expr->GetChild(1);
+  if (l_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      r_expr->GetExpressionType() != ExpressionType::VALUE_TUPLE)
+    return;
+  auto l_tv_expr =
+      reinterpret_cast<const expression::TupleValueExpression*>(l_expr);
+  auto r_tv_expr =
+      reinterpret_cast<const expression::TupleValueExpression*>(r_expr);
+
+  // Exactly one side has to come from the inner table
+  bool l_inner = l_tv_expr->GetTableName() == inner_alias;
+  bool r_inner = r_tv_expr->GetTableName() == inner_alias;
+  if (l_inner == r_inner) return;
+  if (!IsIndexJoinable(l_expr->GetValueType(), r_expr->GetValueType())) return;
+
+  auto inner_tv_expr = l_inner ? l_tv_expr : r_tv_expr;
+  oid_t col_id = std::get<2>(inner_tv_expr->GetBoundOid());
+  if (std::find(inner_column_ids.begin(), inner_column_ids.end(), col_id) ==
+      inner_column_ids.end())
+    inner_column_ids.push_back(col_id);
+}
+
+bool FindIndexForJoinColumns(storage::DataTable* table,
+                             const std::vector<oid_t>& column_ids,
+                             oid_t& index_offset) {
+  bool found = false;
+  bool found_unique = false;
+  size_t found_key_size = 0;
+  for (oid_t offset = 0; offset < table->GetIndexCount(); offset++) {
+    auto index = table->GetIndex(offset);
+    if (index == nullptr || index->GetMetadata()->GetVisibility() == false)
+      continue;
+
+    // Every key column must be known from the outer tuple
+    const auto& key_attrs = index->GetMetadata()->GetKeyAttrs();
+    bool covered = true;
+    for (auto key_attr : key_attrs) {
+      if (std::find(column_ids.begin(), column_ids.end(), key_attr) ==
+          column_ids.end()) {
+        covered = false;
+        break;
+      }
+    }
+    if (!covered) continue;
+
+    // A unique index returns at most one tuple per probe. Otherwise more key
+    // columns are more selective
+    bool unique = index->HasUniqueKeys();
+    if (!found || (unique && !found_unique) ||
+        (unique == found_unique && key_attrs.size() > found_key_size)) {
+      found = true;
+      found_unique = unique;
+      found_key_size = key_attrs.size();
+      index_offset = offset;
+    }
+  }
+  return found;
+}
+
 std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(
     parser::CopyStatement* copy_stmt) {
   std::string table_name(copy_stmt->cpy_table->GetTableName());
+
+  // Loading a table doesn't scan it
+  if (copy_stmt->type == CopyType::IMPORT_CSV ||
+      copy_stmt->type == CopyType::IMPORT_TSV) {
+    auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
+        copy_stmt->cpy_table->GetDatabaseName(), table_name);
+    std::string file_path =
+        copy_stmt->file_path != nullptr ? copy_stmt->file_path : "";
+    return std::unique_ptr<planner::AbstractPlan>(new planner::CopyPlan(
+        target_table, file_path, copy_stmt->type, copy_stmt->delimiter,
+        copy_stmt->header));
+  }
+
   bool deserialize_parameters = false;
 
   // If we're copying the query metric table, then we need to handle the
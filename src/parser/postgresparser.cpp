@@ -1038,19 +1038,56 @@ parser::PrepareStatement* PostgresParser::PrepareTransform(PrepareStmt* root) {
   return res;
 }
 
-// TODO: Only support COPY TABLE TO FILE and DELIMITER option
+// Supports COPY TABLE TO FILE, and COPY TABLE FROM FILE / STDIN with the
+// FORMAT (text or csv), DELIMITER and HEADER options
 parser::CopyStatement* PostgresParser::CopyTransform(CopyStmt* root) {
-  auto res = new CopyStatement(peloton::CopyType::EXPORT_OTHER);
+  if (root->is_program || root->attlist != nullptr ||
+      (root->filename == nullptr && root->is_from == false)) {
+    throw NotImplementedException(
+        "COPY only supports whole tables to files, and from files or STDIN\n");
+  }
+
+  // Postgres imports the text format by default
+  auto res = new CopyStatement(root->is_from ? peloton::CopyType::IMPORT_TSV
+                                             : peloton::CopyType::EXPORT_OTHER);
   res->cpy_table = RangeVarTransform(root->relation);
-  res->file_path = cstrdup(root->filename);
-  for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
-    auto def_elem = reinterpret_cast<DefElem*>(cell->data.ptr_value);
-    if (strcmp(def_elem->defname, "delimiter") == 0) {
-      auto delimiter = reinterpret_cast<value*>(def_elem->arg)->val.str;
-      res->delimiter = *delimiter;
-      break;
+  if (root->filename != nullptr) {
+    res->file_path = cstrdup(root->filename);
+  }
+
+  bool has_delimiter = false;
+  if (root->options != nullptr) {
+    for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
+      auto def_elem = reinterpret_cast<DefElem*>(cell->data.ptr_value);
+      auto val = reinterpret_cast<value*>(def_elem->arg);
+
+      if (strcmp(def_elem->defname, "delimiter") == 0) {
+        res->delimiter = *(val->val.str);
+        has_delimiter = true;
+      } else if (strcmp(def_elem->defname, "format") == 0 && root->is_from) {
+        auto format = StringUtil::Lower(val->val.str);
+        if (format == "csv") {
+          res->type = peloton::CopyType::IMPORT_CSV;
+        } else if (format != "text") {
+          delete res;
+          throw NotImplementedException(StringUtil::Format(
+              "COPY format %s not supported yet...\n", format.c_str()));
+        }
+      } else if (strcmp(def_elem->defname, "header") == 0) {
+        // HEADER without a value is turned on
+        res->header = (val == nullptr) ||
+                      (val->type == T_Integer && val->val.ival != 0) ||
+                      (val->type == T_String &&
+                       StringUtil::Lower(val->val.str) != "false" &&
+                       StringUtil::Lower(val->val.str) != "off");
+      }
     }
   }
+
+  // The text format separates columns with tabs by default
+  if (res->type == peloton::CopyType::IMPORT_TSV && has_delimiter == false) {
+    res->delimiter = '\t';
+  }
   return res;
 }
 
@@ -1068,6 +1105,42 @@ parser::AnalyzeStatement* PostgresParser::VacuumTransform(VacuumStmt* root) {
   return res;
 }
 
+// Transform Postgres ExplainStmt into Peloton ExplainStatement.
+// Supports EXPLAIN ANALYZE and the ANALYZE and COUNTERS options of
+// EXPLAIN (option [value], ...).
+parser::ExplainStatement* PostgresParser::ExplainTransform(ExplainStmt* root) {
+  auto res = new ExplainStatement();
+  if (root->options != nullptr) {
+    for (auto cell = root->options->head; cell != NULL; cell = cell->next) {
+      auto def_elem = reinterpret_cast<DefElem*>(cell->data.ptr_value);
+
+      // An option without a value is turned on
+      bool enabled = true;
+      if (def_elem->arg != nullptr) {
+        auto val = reinterpret_cast<value*>(def_elem->arg);
+        if (val->type == T_Integer) {
+          enabled = (val->val.ival != 0);
+        } else if (val->type == T_String) {
+          auto str = StringUtil::Lower(val->val.str);
+          enabled = (str != "false" && str != "off" && str != "0");
+        }
+      }
+
+      if (strcmp(def_elem->defname, "analyze") == 0) {
+        res->analyze = enabled;
+      } else if (strcmp(def_elem->defname, "counters") == 0) {
+        res->hardware_counters = enabled;
+      } else {
+        delete res;
+        throw NotImplementedException(StringUtil::Format(
+            "EXPLAIN option %s not supported yet...\n", def_elem->defname));
+      }
+    }
+  }
+  res->real_sql_stmt = NodeTransform(root->query);
+  return res;
+}
+
 std::vector<char*>* PostgresParser::ColumnNameTransform(List* root) {
   if (root == nullptr) return nullptr;
 
@@ -1286,6 +1359,9 @@ parser::SQLStatement* PostgresParser::NodeTransform(Node* stmt) {
     case T_AlterTableStmt:
       result = AlterTableTransform((AlterTableStmt*)stmt);
       break;
+    case T_ExplainStmt:
+      result = ExplainTransform((ExplainStmt*)stmt);
+      break;
     default: {
       throw NotImplementedException(StringUtil::Format(
           "Statement of type %d not supported yet...\n", stmt->type));
@@ -17,12 +17,12 @@ namespace planner {
 
 void AbstractJoinPlan::PerformBinding(BindingContext &context) {
   const auto &children = GetChildren();
-  PL_ASSERT(children.size() == 2);
+  PL_ASSERT(children.size() >= 1);
 
   // Let the left and right child populate bind their attributes
   BindingContext left_context, right_context;
   children[0]->PerformBinding(left_context);
-  children[1]->PerformBinding(right_context);
+  PerformRightBinding(right_context);
 
   HandleSubplanBinding(/*is_left*/ true, left_context);
   HandleSubplanBinding(/*is_left*/ false, right_context);
@@ -54,5 +54,11 @@ void AbstractJoinPlan::PerformBinding(BindingContext &context) {
   }
 }
 
+void AbstractJoinPlan::PerformRightBinding(BindingContext &right_context) {
+  const auto &children = GetChildren();
+  PL_ASSERT(children.size() == 2);
+  children[1]->PerformBinding(right_context);
+}
+
 }  // namespace planner
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_plan.cpp
+//
+// Identification: src/planner/index_join_plan.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "planner/index_join_plan.h"
+
+#include "index/index.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace planner {
+
+IndexJoinPlan::IndexJoinPlan(
+    JoinType join_type,
+    std::unique_ptr<const expression::AbstractExpression> &&predicate,
+    std::unique_ptr<const ProjectInfo> &&proj_info,
+    std::shared_ptr<const catalog::Schema> &proj_schema,
+    storage::DataTable *table, std::shared_ptr<index::Index> index,
+    std::vector<std::unique_ptr<const expression::AbstractExpression>> &
+        outer_keys,
+    const std::vector<oid_t> &column_ids,
+    std::unique_ptr<const expression::AbstractExpression> &&inner_predicate)
+    : AbstractJoinPlan(join_type, std::move(predicate), std::move(proj_info),
+                       proj_schema),
+      table_(table),
+      index_(index),
+      outer_keys_(std::move(outer_keys)),
+      column_ids_(column_ids),
+      inner_predicate_(std::move(inner_predicate)) {
+  PL_ASSERT(outer_keys_.size() == index_->GetColumnCount());
+}
+
+void IndexJoinPlan::PerformRightBinding(BindingContext &right_context) {
+  PL_ASSERT(GetChildren().size() == 1);
+
+  // Collect _all_ columns of the inner table
+  const auto *schema = table_->GetSchema();
+  inner_attributes_.clear();
+  for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+    const auto column = schema->GetColumn(col_id);
+    bool nullable = schema->AllowNull(col_id);
+    auto type = codegen::type::Type{column.GetType(), nullable};
+    inner_attributes_.push_back(AttributeInfo{type, col_id, column.GetName()});
+  }
+
+  // The right side of the join are the selected columns
+  for (oid_t col_id = 0; col_id < column_ids_.size(); col_id++) {
+    right_context.BindNew(col_id, &inner_attributes_[column_ids_[col_id]]);
+  }
+
+  // The inner predicate may refer to any column of the inner table
+  if (inner_predicate_ != nullptr) {
+    BindingContext all_cols_context;
+    for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+      all_cols_context.BindNew(col_id, &inner_attributes_[col_id]);
+    }
+    const_cast<expression::AbstractExpression *>(inner_predicate_.get())
+        ->PerformBinding({&all_cols_context});
+  }
+}
+
+void IndexJoinPlan::HandleSubplanBinding(bool is_left,
+                                         const BindingContext &input) {
+  // The keys are produced by the outer tuple
+  if (!is_left) {
+    return;
+  }
+  for (auto &key : outer_keys_) {
+    auto *key_exp = const_cast<expression::AbstractExpression *>(key.get());
+    key_exp->PerformBinding({&input});
+  }
+}
+
+std::unique_ptr<AbstractPlan> IndexJoinPlan::Copy() const {
+  std::unique_ptr<const expression::AbstractExpression> predicate_copy(
+      GetPredicate() != nullptr ? GetPredicate()->Copy() : nullptr);
+  std::shared_ptr<const catalog::Schema> schema_copy(
+      catalog::Schema::CopySchema(GetSchema()));
+
+  std::vector<std::unique_ptr<const expression::AbstractExpression>>
+      outer_keys_copy;
+  for (const auto &outer_key : outer_keys_) {
+    outer_keys_copy.emplace_back(outer_key->Copy());
+  }
+  std::unique_ptr<const expression::AbstractExpression> inner_predicate_copy(
+      inner_predicate_ != nullptr ? inner_predicate_->Copy() : nullptr);
+
+  IndexJoinPlan *new_plan = new IndexJoinPlan(
+      GetJoinType(), std::move(predicate_copy),
+      std::move(GetProjInfo()->Copy()), schema_copy, table_, index_,
+      outer_keys_copy, column_ids_, std::move(inner_predicate_copy));
+  return std::unique_ptr<AbstractPlan>(new_plan);
+}
+
+}  // namespace planner
+}  // namespace peloton
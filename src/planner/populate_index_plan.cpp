@@ -19,7 +19,10 @@
 namespace peloton {
 namespace planner {
 PopulateIndexPlan::PopulateIndexPlan(storage::DataTable *table,
-                                     std::vector<oid_t> column_ids)
-    : target_table_(table), column_ids_(column_ids) {}
+                                     std::vector<oid_t> column_ids,
+                                     std::string index_name)
+    : target_table_(table),
+      column_ids_(column_ids),
+      index_name_(index_name) {}
 }
 }
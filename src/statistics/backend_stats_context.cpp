@@ -33,20 +33,27 @@ BackendStatsContext::GetBackendContextMap() {
 }
 
 BackendStatsContext* BackendStatsContext::GetInstance() {
+  // Contexts are never removed from the map, so the context of this thread
+  // can be cached rather than looked up on every access
+  static thread_local BackendStatsContext* thread_context = nullptr;
+  if (thread_context != nullptr) {
+    return thread_context;
+  }
+
   // Each thread gets a backend stats context
   std::thread::id this_id = std::this_thread::get_id();
   std::shared_ptr<BackendStatsContext> result(nullptr);
   auto& stats_context_map = GetBackendContextMap();
   if (stats_context_map.Find(this_id, result) == false) {
-    result.reset(new BackendStatsContext(LATENCY_MAX_HISTORY_THREAD, true));
+    result.reset(new BackendStatsContext(true));
     stats_context_map.Insert(this_id, result);
   }
-  return result.get();
+  thread_context = result.get();
+  return thread_context;
 }
 
-BackendStatsContext::BackendStatsContext(size_t max_latency_history,
-                                         bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+BackendStatsContext::BackendStatsContext(bool regiser_to_aggregator)
+    : txn_latencies_(LATENCY_METRIC) {
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -106,62 +113,62 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
-void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
-  PL_ASSERT(table_metric != nullptr);
-  table_metric->GetTableAccess().IncrementReads();
+void BackendStatsContext::IncrementTableReads(oid_t database_id,
+                                              oid_t table_id) {
+  IncrementTableAccess(database_id, table_id,
+                       TableAccessCounters::READ_ACCESS);
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetQueryAccess().IncrementReads();
   }
 }
 
-void BackendStatsContext::IncrementTableInserts(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
-  PL_ASSERT(table_metric != nullptr);
-  table_metric->GetTableAccess().IncrementInserts();
+void BackendStatsContext::IncrementTableInserts(oid_t database_id,
+                                                oid_t table_id) {
+  IncrementTableAccess(database_id, table_id,
+                       TableAccessCounters::INSERT_ACCESS);
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetQueryAccess().IncrementInserts();
   }
 }
 
-void BackendStatsContext::IncrementTableUpdates(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
-  PL_ASSERT(table_metric != nullptr);
-  table_metric->GetTableAccess().IncrementUpdates();
+void BackendStatsContext::IncrementTableUpdates(oid_t database_id,
+                                                oid_t table_id) {
+  IncrementTableAccess(database_id, table_id,
+                       TableAccessCounters::UPDATE_ACCESS);
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetQueryAccess().IncrementUpdates();
   }
 }
 
-void BackendStatsContext::IncrementTableDeletes(oid_t tile_group_id) {
-  oid_t table_id =
-      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
-  oid_t database_id = catalog::Manager::GetInstance()
-                          .GetTileGroup(tile_group_id)
-                          ->GetDatabaseId();
-  auto table_metric = GetTableMetric(database_id, table_id);
-  PL_ASSERT(table_metric != nullptr);
-  table_metric->GetTableAccess().IncrementDeletes();
+void BackendStatsContext::IncrementTableDeletes(oid_t database_id,
+                                                oid_t table_id) {
+  IncrementTableAccess(database_id, table_id,
+                       TableAccessCounters::DELETE_ACCESS);
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetQueryAccess().IncrementDeletes();
   }
 }
 
+void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  IncrementTableReads(tile_group->GetDatabaseId(), tile_group->GetTableId());
+}
+
+void BackendStatsContext::IncrementTableInserts(oid_t tile_group_id) {
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  IncrementTableInserts(tile_group->GetDatabaseId(), tile_group->GetTableId());
+}
+
+void BackendStatsContext::IncrementTableUpdates(oid_t tile_group_id) {
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  IncrementTableUpdates(tile_group->GetDatabaseId(), tile_group->GetTableId());
+}
+
+void BackendStatsContext::IncrementTableDeletes(oid_t tile_group_id) {
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  IncrementTableDeletes(tile_group->GetDatabaseId(), tile_group->GetTableId());
+}
+
 void BackendStatsContext::IncrementIndexReads(size_t read_count,
                                               index::IndexMetadata* metadata) {
   oid_t index_id = metadata->GetOid();
@@ -238,6 +245,21 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
     GetDatabaseMetric(database_item.first)->Aggregate(*database_item.second);
   }
 
+  // Aggregate all per-table counters. The source keeps counting while we
+  // read them: we get a snapshot, never a lock.
+  source.table_access_counters_.ForEach([this](
+      oid_t database_id, oid_t table_id, const int64_t* access_counts) {
+    auto& table_access = GetTableMetric(database_id, table_id)->GetTableAccess();
+    table_access.IncrementReads(
+        access_counts[TableAccessCounters::READ_ACCESS]);
+    table_access.IncrementUpdates(
+        access_counts[TableAccessCounters::UPDATE_ACCESS]);
+    table_access.IncrementInserts(
+        access_counts[TableAccessCounters::INSERT_ACCESS]);
+    table_access.IncrementDeletes(
+        access_counts[TableAccessCounters::DELETE_ACCESS]);
+  });
+
   // Aggregate all per-table metrics
   for (auto& table_item : source.table_metrics_) {
     GetTableMetric(table_item.second->GetDatabaseId(),
@@ -273,6 +295,7 @@ void BackendStatsContext::Reset() {
   for (auto& table_item : table_metrics_) {
     table_item.second->Reset();
   }
+  table_access_counters_.Reset();
   for (auto id : index_ids_) {
     std::shared_ptr<IndexMetric> index_metric;
     index_metrics_.Find(id, index_metric);
@@ -358,6 +381,33 @@ std::string BackendStatsContext::ToString() const {
   return ss.str();
 }
 
+void BackendStatsContext::IncrementTableAccess(
+    oid_t database_id, oid_t table_id,
+    TableAccessCounters::AccessType access_type) {
+  if (table_access_counters_.Increment(database_id, table_id, access_type)) {
+    return;
+  }
+
+  // The table OID is too large for the counters
+  auto& table_access = GetTableMetric(database_id, table_id)->GetTableAccess();
+  switch (access_type) {
+    case TableAccessCounters::READ_ACCESS:
+      table_access.IncrementReads();
+      break;
+    case TableAccessCounters::UPDATE_ACCESS:
+      table_access.IncrementUpdates();
+      break;
+    case TableAccessCounters::INSERT_ACCESS:
+      table_access.IncrementInserts();
+      break;
+    case TableAccessCounters::DELETE_ACCESS:
+      table_access.IncrementDeletes();
+      break;
+    default:
+      break;
+  }
+}
+
 void BackendStatsContext::CompleteQueryMetric() {
   if (ongoing_query_metric_ != nullptr) {
     ongoing_query_metric_->GetProcessorMetric().RecordTime();
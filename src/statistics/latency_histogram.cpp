@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.cpp
+//
+// Identification: src/statistics/latency_histogram.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace peloton {
+namespace stats {
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t latency_us) {
+  if (latency_us < SUB_BUCKET_COUNT) {
+    return static_cast<size_t>(latency_us);
+  }
+
+  latency_us = std::min(latency_us, (1UL << MAX_LATENCY_BITS) - 1);
+
+  // Keep the SUB_BUCKET_BITS most significant bits of the latency
+  size_t msb = 63 - __builtin_clzll(latency_us);
+  size_t shift = msb - SUB_BUCKET_BITS + 1;
+  size_t sub_bucket = static_cast<size_t>(latency_us >> shift);
+
+  return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF_COUNT +
+         (sub_bucket - SUB_BUCKET_HALF_COUNT);
+}
+
+uint64_t LatencyHistogram::GetBucketLowerBound(size_t bucket_index) {
+  if (bucket_index < SUB_BUCKET_COUNT) {
+    return bucket_index;
+  }
+
+  size_t offset = bucket_index - SUB_BUCKET_COUNT;
+  size_t shift = offset / SUB_BUCKET_HALF_COUNT + 1;
+  uint64_t sub_bucket = offset % SUB_BUCKET_HALF_COUNT + SUB_BUCKET_HALF_COUNT;
+  return sub_bucket << shift;
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t bucket_index) {
+  if (bucket_index < SUB_BUCKET_COUNT) {
+    return bucket_index;
+  }
+
+  size_t offset = bucket_index - SUB_BUCKET_COUNT;
+  size_t shift = offset / SUB_BUCKET_HALF_COUNT + 1;
+  return GetBucketLowerBound(bucket_index) + (1UL << shift) - 1;
+}
+
+void LatencyHistogram::Record(double latency_ms) {
+  uint64_t latency_us =
+      static_cast<uint64_t>(std::llround(std::max(latency_ms, 0.0) * 1000));
+
+  Add(bucket_counts_[GetBucketIndex(latency_us)], 1);
+  Add(total_count_, 1);
+  Add(total_latency_us_, static_cast<int64_t>(latency_us));
+
+  if (latency_us < min_latency_us_.load(std::memory_order_relaxed)) {
+    min_latency_us_.store(latency_us, std::memory_order_relaxed);
+  }
+  if (latency_us > max_latency_us_.load(std::memory_order_relaxed)) {
+    max_latency_us_.store(latency_us, std::memory_order_relaxed);
+  }
+}
+
+double LatencyHistogram::GetPercentile(double percentile) const {
+  int64_t total_count = GetCount();
+  if (total_count == 0) {
+    return 0.0;
+  }
+
+  // Rank of the value, in [1, total_count]
+  int64_t rank = static_cast<int64_t>(
+      std::ceil(std::min(std::max(percentile, 0.0), 100.0) / 100 * total_count));
+  rank = std::max(rank, static_cast<int64_t>(1));
+
+  int64_t seen_count = 0;
+  for (size_t bucket_index = 0; bucket_index < BUCKET_COUNT; bucket_index++) {
+    seen_count += bucket_counts_[bucket_index].load(std::memory_order_relaxed);
+    if (seen_count >= rank) {
+      // The middle of the bucket, within the range actually recorded
+      double latency_us = (GetBucketLowerBound(bucket_index) +
+                           GetBucketUpperBound(bucket_index)) /
+                          2.0;
+      latency_us = std::max(latency_us, GetMin() * 1000);
+      latency_us = std::min(latency_us, GetMax() * 1000);
+      return latency_us / 1000;
+    }
+  }
+
+  // Concurrent records the buckets don't show yet
+  return GetMax();
+}
+
+double LatencyHistogram::GetAverage() const {
+  int64_t total_count = GetCount();
+  if (total_count == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(
+             total_latency_us_.load(std::memory_order_relaxed)) /
+         total_count / 1000;
+}
+
+double LatencyHistogram::GetMin() const {
+  if (GetCount() == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(min_latency_us_.load(std::memory_order_relaxed)) /
+         1000;
+}
+
+double LatencyHistogram::GetMax() const {
+  return static_cast<double>(max_latency_us_.load(std::memory_order_relaxed)) /
+         1000;
+}
+
+void LatencyHistogram::Add(const LatencyHistogram &source) {
+  for (size_t bucket_index = 0; bucket_index < BUCKET_COUNT; bucket_index++) {
+    int64_t count =
+        source.bucket_counts_[bucket_index].load(std::memory_order_relaxed);
+    if (count != 0) {
+      Add(bucket_counts_[bucket_index], count);
+    }
+  }
+
+  Add(total_count_, source.total_count_.load(std::memory_order_relaxed));
+  Add(total_latency_us_,
+      source.total_latency_us_.load(std::memory_order_relaxed));
+
+  auto source_min = source.min_latency_us_.load(std::memory_order_relaxed);
+  if (source_min < min_latency_us_.load(std::memory_order_relaxed)) {
+    min_latency_us_.store(source_min, std::memory_order_relaxed);
+  }
+  auto source_max = source.max_latency_us_.load(std::memory_order_relaxed);
+  if (source_max > max_latency_us_.load(std::memory_order_relaxed)) {
+    max_latency_us_.store(source_max, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (auto &bucket_count : bucket_counts_) {
+    bucket_count.store(0, std::memory_order_relaxed);
+  }
+  total_count_.store(0, std::memory_order_relaxed);
+  total_latency_us_.store(0, std::memory_order_relaxed);
+  min_latency_us_.store(std::numeric_limits<uint64_t>::max(),
+                        std::memory_order_relaxed);
+  max_latency_us_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -28,8 +28,8 @@ namespace peloton {
 namespace stats {
 
 StatsAggregator::StatsAggregator(int64_t aggregation_interval_ms)
-    : stats_history_(0, false),
-      aggregated_stats_(LATENCY_MAX_HISTORY_AGGREGATOR, false),
+    : stats_history_(false),
+      aggregated_stats_(false),
       aggregation_interval_ms_(aggregation_interval_ms),
       thread_number_(0),
       total_prev_txn_committed_(0) {
@@ -146,7 +146,7 @@ void StatsAggregator::UpdateQueryMetrics(int64_t time_stamp,
     auto updates = table_access.GetUpdates();
     auto deletes = table_access.GetDeletes();
     auto inserts = table_access.GetInserts();
-    auto latency = query_metric->GetQueryLatency().GetFirstLatencyValue();
+    auto latency = query_metric->GetQueryLatency().GetLatestLatencyValue();
     auto cpu_system = query_metric->GetProcessorMetric().GetSystemDuration();
     auto cpu_user = query_metric->GetProcessorMetric().GetUserDuration();
 
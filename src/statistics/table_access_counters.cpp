@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_access_counters.cpp
+//
+// Identification: src/statistics/table_access_counters.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/table_access_counters.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace peloton {
+namespace stats {
+
+TableAccessCounters::TableAccessCounters() {
+  for (auto &chunk : chunks_) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+TableAccessCounters::~TableAccessCounters() {
+  for (auto &chunk : chunks_) {
+    free(chunk.load(std::memory_order_relaxed));
+  }
+}
+
+TableAccessCounters::TableCounter *TableAccessCounters::AllocateChunk(
+    oid_t chunk_id) {
+  // operator new doesn't honour the cache line alignment of the counters
+  void *chunk_memory =
+      aligned_alloc(CACHELINE_SIZE, sizeof(TableCounter) * TABLE_CHUNK_SIZE);
+  PL_ASSERT(chunk_memory != nullptr);
+
+  auto chunk = static_cast<TableCounter *>(chunk_memory);
+  for (oid_t offset = 0; offset < TABLE_CHUNK_SIZE; offset++) {
+    new (&chunk[offset]) TableCounter();
+    chunk[offset].database_id.store(INVALID_OID, std::memory_order_relaxed);
+    for (auto &counter : chunk[offset].counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Publish the initialized chunk to the aggregator
+  chunks_[chunk_id].store(chunk, std::memory_order_release);
+  return chunk;
+}
+
+void TableAccessCounters::ForEach(
+    std::function<void(oid_t, oid_t, const int64_t *)> func) const {
+  for (oid_t chunk_id = 0; chunk_id < MAX_TABLE_CHUNKS; chunk_id++) {
+    auto chunk = chunks_[chunk_id].load(std::memory_order_acquire);
+    if (chunk == nullptr) continue;
+
+    for (oid_t offset = 0; offset < TABLE_CHUNK_SIZE; offset++) {
+      auto database_id =
+          chunk[offset].database_id.load(std::memory_order_relaxed);
+      if (database_id == INVALID_OID) continue;
+
+      int64_t access_counts[ACCESS_TYPE_COUNT];
+      for (size_t access_type = 0; access_type < ACCESS_TYPE_COUNT;
+           access_type++) {
+        access_counts[access_type] =
+            chunk[offset].counters[access_type].load(std::memory_order_relaxed);
+      }
+      func(database_id, chunk_id * TABLE_CHUNK_SIZE + offset, access_counts);
+    }
+  }
+}
+
+void TableAccessCounters::Reset() {
+  for (auto &chunk_ptr : chunks_) {
+    auto chunk = chunk_ptr.load(std::memory_order_acquire);
+    if (chunk == nullptr) continue;
+
+    for (oid_t offset = 0; offset < TABLE_CHUNK_SIZE; offset++) {
+      for (auto &counter : chunk[offset].counters) {
+        counter.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -66,7 +66,7 @@ column_map_type AbstractTable::GetTileGroupLayout(
 
 TileGroup *AbstractTable::GetTileGroupWithLayout(
     oid_t database_id, oid_t tile_group_id, const column_map_type &partitioning,
-    const size_t num_tuples) {
+    const size_t num_tuples, const int numa_node) {
   std::vector<catalog::Schema> schemas;
 
   // Figure out the columns in each tile in new layout
@@ -87,7 +87,8 @@ TileGroup *AbstractTable::GetTileGroupWithLayout(
 
   TileGroup *tile_group =
       TileGroupFactory::GetTileGroup(database_id, GetOid(), tile_group_id, this,
-                                     schemas, partitioning, num_tuples);
+                                     schemas, partitioning, num_tuples,
+                                     numa_node);
 
   return tile_group;
 }
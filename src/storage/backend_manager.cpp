@@ -27,6 +27,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/numa.h"
 #include "type/types.h"
 // #include "logging/logging_util.h"
 #include "storage/backend_manager.h"
@@ -313,6 +314,10 @@ BackendManager &BackendManager::GetInstance(void) {
 
 BackendManager::BackendManager()
     : data_file_address(nullptr), data_file_len(0), data_file_offset(0) {
+  for (auto &numa_arena_size : numa_arena_sizes) {
+    numa_arena_size = 0;
+  }
+
   // // Check if we need a data pool
   // if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)
   // ==
@@ -513,6 +518,57 @@ void BackendManager::Release(BackendType type, void *address) {
   }
 }
 
+// Round allocations on NUMA nodes to whole pages, which are the unit of
+// memory binding
+static size_t GetNumaAllocationSize(size_t size) {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return (size + page_size - 1) / page_size * page_size;
+}
+
+void *BackendManager::Allocate(BackendType type, size_t size, int numa_node) {
+  if (numa_node == NUMA_NODE_ANY ||
+      (type != BackendType::MM && type != BackendType::NVM)) {
+    return Allocate(type, size);
+  }
+
+  PL_ASSERT(numa_node >= 0 && numa_node < MAX_NUMA_NODES);
+
+  // Update allocation count
+  allocation_count++;
+
+  auto allocation_size = GetNumaAllocationSize(size);
+  void *address = mmap(nullptr, allocation_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (address == MAP_FAILED) {
+    throw Exception("no more memory available on numa node " +
+                    std::to_string(numa_node));
+  }
+
+  // Pages are bound before they are touched, so that they are allocated on
+  // the node at the first write
+  NumaTopology::GetInstance().BindMemory(address, allocation_size, numa_node);
+
+  numa_arena_sizes[numa_node] += allocation_size;
+  return address;
+}
+
+void BackendManager::Release(BackendType type, void *address, size_t size,
+                             int numa_node) {
+  if (numa_node == NUMA_NODE_ANY ||
+      (type != BackendType::MM && type != BackendType::NVM)) {
+    Release(type, address);
+    return;
+  }
+
+  auto allocation_size = GetNumaAllocationSize(size);
+  if (munmap(address, allocation_size) != 0) {
+    LOG_ERROR("Failed to release memory on numa node %d", numa_node);
+    return;
+  }
+
+  numa_arena_sizes[numa_node] -= allocation_size;
+}
+
 void BackendManager::Sync(BackendType type, void *address, size_t length) {
   switch (type) {
     case BackendType::MM: {
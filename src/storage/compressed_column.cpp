@@ -0,0 +1,497 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column.cpp
+//
+// Identification: src/storage/compressed_column.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/compressed_column.h"
+
+#include <algorithm>
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/type.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+// Number of bits required to represent the given value
+uint8_t GetBitWidth(uint64_t max_value) {
+  uint8_t bit_width = 0;
+  while (max_value != 0) {
+    bit_width++;
+    max_value >>= 1;
+  }
+  return bit_width;
+}
+
+// Apply a comparison operator to two order-preserving codes
+template <typename T>
+inline bool CompareCodes(const ExpressionType comparison, const T &lhs,
+                         const T &rhs) {
+  switch (comparison) {
+    case ExpressionType::COMPARE_EQUAL:
+      return lhs == rhs;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return lhs != rhs;
+    case ExpressionType::COMPARE_LESSTHAN:
+      return lhs < rhs;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return lhs <= rhs;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return lhs > rhs;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return lhs >= rhs;
+    default:
+      PL_ASSERT(false);
+  }
+  return false;
+}
+
+bool IsComparison(const ExpressionType comparison) {
+  switch (comparison) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsIntegerType(const type::TypeId type_id) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t GetIntegerFromValue(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::TypeId::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::TypeId::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::TypeId::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::TypeId::BIGINT:
+      return value.GetAs<int64_t>();
+    default:
+      PL_ASSERT(false);
+  }
+  return 0;
+}
+
+type::Value GetValueFromInteger(const type::TypeId type_id,
+                                const int64_t integer) {
+  switch (type_id) {
+    case type::TypeId::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(
+          static_cast<int8_t>(integer));
+    case type::TypeId::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(integer));
+    case type::TypeId::INTEGER:
+      return type::ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(integer));
+    case type::TypeId::BIGINT:
+      return type::ValueFactory::GetBigIntValue(integer);
+    default:
+      PL_ASSERT(false);
+  }
+  return type::ValueFactory::GetNullValueByType(type_id);
+}
+
+// Empty (reclaimed or aborted) slots are encoded as nulls. The varlen value
+// of a reclaimed slot is freed already.
+type::Value GetSlotValue(TileGroup *tile_group, const oid_t tuple_id,
+                         const oid_t column_id, const type::TypeId type_id) {
+  if (tile_group->GetHeader()->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+    return type::ValueFactory::GetNullValueByType(type_id);
+  }
+  return tile_group->GetValue(tuple_id, column_id);
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Compressed Column
+//===--------------------------------------------------------------------===//
+
+CompressedColumn::CompressedColumn(type::TypeId type_id,
+                                   ColumnEncodingType encoding_type,
+                                   oid_t tuple_count)
+    : type_id_(type_id),
+      encoding_type_(encoding_type),
+      tuple_count_(tuple_count) {}
+
+bool CompressedColumn::IsEncodable(const type::TypeId type_id) {
+  return IsIntegerType(type_id) || type_id == type::TypeId::VARCHAR;
+}
+
+CompressedColumn *CompressedColumn::Encode(TileGroup *tile_group,
+                                           const oid_t column_id,
+                                           const oid_t tuple_count) {
+  oid_t tile_offset, tile_column_offset;
+  tile_group->LocateTileAndColumn(column_id, tile_offset, tile_column_offset);
+  auto type_id =
+      tile_group->GetTile(tile_offset)->GetSchema()->GetType(tile_column_offset);
+
+  if (IsEncodable(type_id) == false) {
+    return nullptr;
+  }
+
+  std::unique_ptr<CompressedColumn> column(new CompressedColumn(
+      type_id, ColumnEncodingType::UNCOMPRESSED, tuple_count));
+
+  if (type_id == type::TypeId::VARCHAR) {
+    std::vector<std::string> values;
+    values.reserve(tuple_count);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      auto value = GetSlotValue(tile_group, tuple_itr, column_id, type_id);
+      if (value.IsNull()) {
+        if (column->nulls_.empty()) column->nulls_.resize(tuple_count, false);
+        column->nulls_[tuple_itr] = true;
+        values.emplace_back();
+      } else {
+        values.push_back(value.ToString());
+        column->uncompressed_size_ += value.GetLength();
+      }
+    }
+    // The tile itself stores a pointer to the varlen data
+    column->uncompressed_size_ += tuple_count * sizeof(char *);
+    column->EncodeStrings(values);
+  } else {
+    std::vector<int64_t> values;
+    values.reserve(tuple_count);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      auto value = GetSlotValue(tile_group, tuple_itr, column_id, type_id);
+      if (value.IsNull()) {
+        if (column->nulls_.empty()) column->nulls_.resize(tuple_count, false);
+        column->nulls_[tuple_itr] = true;
+        values.push_back(0);
+      } else {
+        values.push_back(GetIntegerFromValue(value));
+      }
+    }
+    column->uncompressed_size_ = tuple_count * type::Type::GetTypeSize(type_id);
+    column->EncodeIntegers(values);
+  }
+
+  LOG_TRACE("Encoded column %u of tile group %u as %s : %lu -> %lu bytes",
+            column_id, tile_group->GetTileGroupId(),
+            ColumnEncodingTypeToString(column->encoding_type_).c_str(),
+            column->GetUncompressedSize(), column->GetCompressedSize());
+
+  return column.release();
+}
+
+void CompressedColumn::PackCodes(const std::vector<uint64_t> &codes,
+                                 const uint8_t bit_width) {
+  bit_width_ = bit_width;
+  packed_codes_.clear();
+  if (bit_width_ == 0) return;
+
+  size_t bit_count = codes.size() * bit_width_;
+  // Add a padding word so that GetCode never reads past the end
+  packed_codes_.resize((bit_count >> 6) + 2, 0);
+
+  for (size_t code_itr = 0; code_itr < codes.size(); code_itr++) {
+    size_t bit_offset = code_itr * bit_width_;
+    size_t word = bit_offset >> 6;
+    size_t shift = bit_offset & 63;
+    packed_codes_[word] |= codes[code_itr] << shift;
+    if (shift + bit_width_ > 64) {
+      packed_codes_[word + 1] |= codes[code_itr] >> (64 - shift);
+    }
+  }
+}
+
+void CompressedColumn::EncodeIntegers(const std::vector<int64_t> &values) {
+  int64_t min_value = 0, max_value = 0;
+  bool first = true;
+  size_t run_count = 0;
+
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    if (IsNull(tuple_itr)) continue;
+    if (first || values[tuple_itr] < min_value) min_value = values[tuple_itr];
+    if (first || values[tuple_itr] > max_value) max_value = values[tuple_itr];
+    if (first || values[tuple_itr] != values[tuple_itr - 1]) run_count++;
+    first = false;
+  }
+
+  uint64_t max_delta =
+      static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+  uint8_t bit_width = GetBitWidth(max_delta);
+
+  size_t packed_size = ((values.size() * bit_width) / 8) + sizeof(uint64_t);
+  size_t run_length_size = run_count * (sizeof(int64_t) + sizeof(oid_t));
+
+  // Run-length encoding does not track nulls
+  if (nulls_.empty() && run_length_size < packed_size) {
+    encoding_type_ = ColumnEncodingType::RUN_LENGTH;
+    for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+      if (tuple_itr == 0 || values[tuple_itr] != values[tuple_itr - 1]) {
+        run_values_.push_back(values[tuple_itr]);
+        run_ends_.push_back(tuple_itr + 1);
+      } else {
+        run_ends_.back() = tuple_itr + 1;
+      }
+    }
+    return;
+  }
+
+  encoding_type_ = ColumnEncodingType::FRAME_OF_REFERENCE;
+  base_value_ = min_value;
+  max_delta_ = max_delta;
+
+  std::vector<uint64_t> codes;
+  codes.reserve(values.size());
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    if (IsNull(tuple_itr)) {
+      codes.push_back(0);
+    } else {
+      codes.push_back(static_cast<uint64_t>(values[tuple_itr]) -
+                      static_cast<uint64_t>(base_value_));
+    }
+  }
+  PackCodes(codes, bit_width);
+}
+
+void CompressedColumn::EncodeStrings(const std::vector<std::string> &values) {
+  encoding_type_ = ColumnEncodingType::DICTIONARY;
+
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    if (IsNull(tuple_itr) == false) dictionary_.push_back(values[tuple_itr]);
+  }
+  std::sort(dictionary_.begin(), dictionary_.end());
+  dictionary_.erase(std::unique(dictionary_.begin(), dictionary_.end()),
+                    dictionary_.end());
+  dictionary_.shrink_to_fit();
+
+  std::vector<uint64_t> codes;
+  codes.reserve(values.size());
+  for (oid_t tuple_itr = 0; tuple_itr < values.size(); tuple_itr++) {
+    if (IsNull(tuple_itr)) {
+      codes.push_back(0);
+    } else {
+      auto entry = std::lower_bound(dictionary_.begin(), dictionary_.end(),
+                                    values[tuple_itr]);
+      codes.push_back(entry - dictionary_.begin());
+    }
+  }
+
+  uint64_t max_code = dictionary_.empty() ? 0 : dictionary_.size() - 1;
+  PackCodes(codes, GetBitWidth(max_code));
+}
+
+int64_t CompressedColumn::GetInteger(const oid_t tuple_offset) const {
+  if (encoding_type_ == ColumnEncodingType::RUN_LENGTH) {
+    auto run = std::upper_bound(run_ends_.begin(), run_ends_.end(),
+                                tuple_offset) -
+               run_ends_.begin();
+    return run_values_[run];
+  }
+  return static_cast<int64_t>(static_cast<uint64_t>(base_value_) +
+                              GetCode(tuple_offset));
+}
+
+type::Value CompressedColumn::GetValue(const oid_t tuple_offset) const {
+  PL_ASSERT(tuple_offset < tuple_count_);
+
+  if (IsNull(tuple_offset)) {
+    return type::ValueFactory::GetNullValueByType(type_id_);
+  }
+
+  if (encoding_type_ == ColumnEncodingType::DICTIONARY) {
+    return type::ValueFactory::GetVarcharValue(
+        dictionary_[GetCode(tuple_offset)]);
+  }
+
+  return GetValueFromInteger(type_id_, GetInteger(tuple_offset));
+}
+
+bool CompressedColumn::EvaluatePredicate(const ExpressionType comparison,
+                                         const type::Value &constant,
+                                         std::vector<bool> &matches) const {
+  PL_ASSERT(matches.size() >= tuple_count_);
+
+  if (IsComparison(comparison) == false) {
+    return false;
+  }
+
+  // Comparisons with NULL never qualify
+  if (constant.IsNull()) {
+    std::fill(matches.begin(), matches.begin() + tuple_count_, false);
+    return true;
+  }
+
+  switch (encoding_type_) {
+    case ColumnEncodingType::DICTIONARY: {
+      if (constant.GetTypeId() != type::TypeId::VARCHAR) return false;
+
+      // Translate the constant into a code range of the sorted dictionary.
+      // For codes: lower <= code < upper  <=>  dictionary[code] == constant
+      auto str = constant.ToString();
+      uint64_t lower = std::lower_bound(dictionary_.begin(), dictionary_.end(),
+                                        str) -
+                       dictionary_.begin();
+      uint64_t upper = std::upper_bound(dictionary_.begin(), dictionary_.end(),
+                                        str) -
+                       dictionary_.begin();
+
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+        if (matches[tuple_itr] == false) continue;
+        if (IsNull(tuple_itr)) {
+          matches[tuple_itr] = false;
+          continue;
+        }
+
+        uint64_t code = GetCode(tuple_itr);
+        bool result;
+        switch (comparison) {
+          case ExpressionType::COMPARE_EQUAL:
+            result = (code >= lower && code < upper);
+            break;
+          case ExpressionType::COMPARE_NOTEQUAL:
+            result = (code < lower || code >= upper);
+            break;
+          case ExpressionType::COMPARE_LESSTHAN:
+            result = (code < lower);
+            break;
+          case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            result = (code < upper);
+            break;
+          case ExpressionType::COMPARE_GREATERTHAN:
+            result = (code >= upper);
+            break;
+          default:
+            result = (code >= lower);
+            break;
+        }
+        matches[tuple_itr] = result;
+      }
+      return true;
+    }
+
+    case ColumnEncodingType::FRAME_OF_REFERENCE: {
+      if (IsIntegerType(constant.GetTypeId()) == false) return false;
+
+      // Rebase the constant onto the stored deltas. Constants outside the
+      // stored range are clamped to just outside of it, which keeps every
+      // comparison outcome unchanged.
+      int64_t constant_value = GetIntegerFromValue(constant);
+      int64_t rebased_constant;
+      if (constant_value < base_value_) {
+        rebased_constant = -1;
+      } else if (static_cast<uint64_t>(constant_value) -
+                     static_cast<uint64_t>(base_value_) >
+                 max_delta_) {
+        rebased_constant = static_cast<int64_t>(max_delta_) + 1;
+      } else {
+        rebased_constant = static_cast<int64_t>(
+            static_cast<uint64_t>(constant_value) -
+            static_cast<uint64_t>(base_value_));
+      }
+
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count_; tuple_itr++) {
+        if (matches[tuple_itr] == false) continue;
+        if (IsNull(tuple_itr)) {
+          matches[tuple_itr] = false;
+          continue;
+        }
+        matches[tuple_itr] =
+            CompareCodes(comparison, static_cast<int64_t>(GetCode(tuple_itr)),
+                         rebased_constant);
+      }
+      return true;
+    }
+
+    case ColumnEncodingType::RUN_LENGTH: {
+      if (IsIntegerType(constant.GetTypeId()) == false) return false;
+
+      // Evaluate once per run
+      int64_t constant_value = GetIntegerFromValue(constant);
+      oid_t run_begin = 0;
+      for (size_t run_itr = 0; run_itr < run_values_.size(); run_itr++) {
+        bool result =
+            CompareCodes(comparison, run_values_[run_itr], constant_value);
+        if (result == false) {
+          std::fill(matches.begin() + run_begin,
+                    matches.begin() + run_ends_[run_itr], false);
+        }
+        run_begin = run_ends_[run_itr];
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+size_t CompressedColumn::GetCompressedSize() const {
+  size_t size = (nulls_.size() + 7) / 8;
+  size += packed_codes_.size() * sizeof(uint64_t);
+  size += run_values_.size() * sizeof(int64_t);
+  size += run_ends_.size() * sizeof(oid_t);
+  for (auto &entry : dictionary_) {
+    size += entry.size() + sizeof(uint32_t);
+  }
+  return size;
+}
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile Group
+//===--------------------------------------------------------------------===//
+
+CompressedTileGroup::CompressedTileGroup(TileGroup *tile_group,
+                                         const oid_t tuple_count)
+    : tuple_count_(tuple_count) {
+  auto column_count = tile_group->GetColumnMap().size();
+  columns_.resize(column_count);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    columns_[column_itr].reset(
+        CompressedColumn::Encode(tile_group, column_itr, tuple_count));
+  }
+}
+
+size_t CompressedTileGroup::GetCompressedSize() const {
+  size_t size = 0;
+  for (auto &column : columns_) {
+    if (column != nullptr) size += column->GetCompressedSize();
+  }
+  return size;
+}
+
+size_t CompressedTileGroup::GetUncompressedSize() const {
+  size_t size = 0;
+  for (auto &column : columns_) {
+    if (column != nullptr) size += column->GetUncompressedSize();
+  }
+  return size;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -10,14 +10,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include "brain/clusterer.h"
 #include "brain/sample.h"
 #include "catalog/foreign_key.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/numa.h"
 #include "common/platform.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -51,6 +56,7 @@ oid_t DataTable::invalid_tile_group_id = -1;
 
 size_t DataTable::default_active_tilegroup_count_ = 1;
 size_t DataTable::default_active_indirection_array_count_ = 1;
+bool DataTable::default_numa_aware_placement_ = false;
 
 DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
                      const oid_t &database_oid, const oid_t &table_oid,
@@ -68,18 +74,30 @@ DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
   }
 
   if (is_catalog == true) {
-    active_tilegroup_count_ = 1;
+    max_active_tilegroup_count_ = 1;
     active_indirection_array_count_ = 1;
   } else {
-    active_tilegroup_count_ = default_active_tilegroup_count_;
+    max_active_tilegroup_count_ = default_active_tilegroup_count_;
     active_indirection_array_count_ = default_active_indirection_array_count_;
+
+    // every node needs the same number of active tile groups
+    if (default_numa_aware_placement_ == true) {
+      numa_node_count_ = NumaTopology::GetInstance().GetNodeCount();
+      max_active_tilegroup_count_ =
+          (max_active_tilegroup_count_ + numa_node_count_ - 1) /
+          numa_node_count_ * numa_node_count_;
+    }
   }
 
-  active_tile_groups_.resize(active_tilegroup_count_);
+  // start with one active tile group per node, more are opened once the
+  // inserters contend for them
+  active_tilegroup_count_ = std::max<size_t>(numa_node_count_, 1);
+  active_tile_groups_.resize(max_active_tilegroup_count_);
+  spare_tile_groups_.resize(max_active_tilegroup_count_);
 
   active_indirection_arrays_.resize(active_indirection_array_count_);
   // Create tile groups.
-  for (size_t i = 0; i < active_tilegroup_count_; ++i) {
+  for (size_t i = 0; i < active_tilegroup_count_.load(); ++i) {
     AddDefaultTileGroup(i);
   }
 
@@ -106,6 +124,17 @@ DataTable::~DataTable() {
     }
   }
 
+  // the version tile groups are only known to the table and the catalog
+  auto version_tile_groups_size = version_tile_groups_.GetSize();
+  for (tile_groups_itr = 0; tile_groups_itr < version_tile_groups_size;
+       tile_groups_itr++) {
+    auto tile_group_id = version_tile_groups_.Find(tile_groups_itr);
+
+    if (tile_group_id != invalid_tile_group_id) {
+      catalog_manager.DropTileGroup(tile_group_id);
+    }
+  }
+
   // clean up foreign keys
   for (auto foreign_key : foreign_keys_) {
     delete foreign_key;
@@ -172,17 +201,23 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
   auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
   if (free_item_pointer.IsNull() == false) {
+    auto &manager = catalog::Manager::GetInstance();
+    auto tile_group = manager.GetTileGroup(free_item_pointer.block);
+    // the recycled slot is about to be rewritten. thawing waits for a layout
+    // transform of the tile group, which installs a new one under its id.
+    tile_group->Thaw();
+    tile_group = manager.GetTileGroup(free_item_pointer.block);
+    tile_group->Thaw();
     // when inserting a tuple
     if (tuple != nullptr) {
-      auto tile_group =
-          catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
       tile_group->CopyTuple(tuple, free_item_pointer.offset);
     }
     return free_item_pointer;
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_count = active_tilegroup_count_;
+  size_t active_tile_group_id = GetActiveTileGroupId();
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
@@ -190,7 +225,7 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   // get valid tuple.
   while (true) {
     // get the last tile group.
-    tile_group = active_tile_groups_[active_tile_group_id];
+    tile_group = std::atomic_load(&active_tile_groups_[active_tile_group_id]);
 
     tuple_slot = tile_group->InsertTuple(tuple);
 
@@ -199,12 +234,15 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
       tile_group_id = tile_group->GetTileGroupId();
       break;
     }
+
+    // another thread filled the tile group and is replacing it
+    GrowActiveTileGroups(active_tile_group_count);
   }
 
   // if this is the last tuple slot we can get
   // then create a new tile group
   if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
-    AddDefaultTileGroup(active_tile_group_id);
+    ReplaceFullTileGroup(active_tile_group_id);
   }
 
   LOG_TRACE("tile group count: %lu, tile group id: %u, address: %p",
@@ -217,12 +255,48 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   return location;
 }
 
+// versions are placed in the table's tile groups like inserted tuples, unless
+// the table has a version store.
+ItemPointer DataTable::GetEmptyVersionSlot() {
+  if (version_store_ == false) {
+    return GetEmptyTupleSlot(nullptr);
+  }
+
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+  auto free_item_pointer = gc_manager.ReturnFreeVersionSlot(this->table_oid);
+  if (free_item_pointer.IsNull() == false) {
+    return free_item_pointer;
+  }
+
+  std::shared_ptr<storage::TileGroup> tile_group;
+  oid_t tuple_slot = INVALID_OID;
+
+  // wait while another thread adds a new version tile group.
+  while (true) {
+    tile_group = std::atomic_load(&active_version_tile_group_);
+
+    tuple_slot = tile_group->InsertTuple(nullptr);
+
+    if (tuple_slot != INVALID_OID) {
+      break;
+    }
+  }
+
+  // if this is the last version slot we can get
+  // then create a new version tile group
+  if (tuple_slot == tile_group->GetAllocatedTupleCount() - 1) {
+    AddVersionTileGroup();
+  }
+
+  return ItemPointer(tile_group->GetTileGroupId(), tuple_slot);
+}
+
 //===--------------------------------------------------------------------===//
 // INSERT
 //===--------------------------------------------------------------------===//
 ItemPointer DataTable::InsertEmptyVersion() {
   // First, claim a slot
-  ItemPointer location = GetEmptyTupleSlot(nullptr);
+  ItemPointer location = GetEmptyVersionSlot();
   if (location.block == INVALID_OID) {
     LOG_TRACE("Failed to get tuple slot.");
     return INVALID_ITEMPOINTER;
@@ -236,7 +310,7 @@ ItemPointer DataTable::InsertEmptyVersion() {
 
 ItemPointer DataTable::AcquireVersion() {
   // First, claim a slot
-  ItemPointer location = GetEmptyTupleSlot(nullptr);
+  ItemPointer location = GetEmptyVersionSlot();
   if (location.block == INVALID_OID) {
     LOG_TRACE("Failed to get tuple slot.");
     return INVALID_ITEMPOINTER;
@@ -283,6 +357,11 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple,
 
   auto index_count = GetIndexCount();
   if (index_count == 0) {
+    // the versions in the version store are only reachable through the head
+    // pointer of the version chain.
+    if (version_store_ == true) {
+      *index_entry_ptr = AllocateIndirection(location);
+    }
     // Increase the table's number of tuples by 1
     IncreaseTupleCount(1);
     return location;
@@ -320,11 +399,168 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
 
   UNUSED_ATTRIBUTE auto index_count = GetIndexCount();
   PL_ASSERT(index_count == 0);
+  PL_ASSERT(version_store_ == false);
   // Increase the table's number of tuples by 1
   IncreaseTupleCount(1);
   return location;
 }
 
+bool DataTable::InsertTuples(const std::vector<const Tuple *> &tuples,
+                             concurrency::Transaction *transaction,
+                             std::vector<ItemPointer> *locations) {
+  oid_t tuple_count = tuples.size();
+  if (tuple_count == 0) {
+    return true;
+  }
+
+  std::vector<ItemPointer> batch_locations;
+  batch_locations.reserve(tuple_count);
+
+  // the batch does not reuse the slots recycled by the GC, as they are
+  // scattered over the table.
+  oid_t tuple_itr = 0;
+  while (tuple_itr < tuple_count) {
+    size_t active_tile_group_count = active_tilegroup_count_;
+    size_t active_tile_group_id = GetActiveTileGroupId();
+    auto tile_group =
+        std::atomic_load(&active_tile_groups_[active_tile_group_id]);
+
+    oid_t slot_count = 0;
+    oid_t tuple_slot = tile_group->GetHeader()->GetNextEmptyTupleSlots(
+        tuple_count - tuple_itr, slot_count);
+
+    // some other thread is adding a new tile group.
+    if (tuple_slot == INVALID_OID) {
+      GrowActiveTileGroups(active_tile_group_count);
+      continue;
+    }
+
+    // if the range ends with the last tuple slot
+    // then create a new tile group
+    if (tuple_slot + slot_count == tile_group->GetAllocatedTupleCount()) {
+      ReplaceFullTileGroup(active_tile_group_id);
+    }
+
+    tile_group->CopyTuples(&tuples[tuple_itr], tuple_slot, slot_count);
+
+    auto tile_group_id = tile_group->GetTileGroupId();
+    for (oid_t slot_itr = 0; slot_itr < slot_count; slot_itr++) {
+      batch_locations.emplace_back(tile_group_id, tuple_slot + slot_itr);
+    }
+    tuple_itr += slot_count;
+  }
+
+  LOG_TRACE("Inserted %u tuples from %u, %u", tuple_count,
+            batch_locations.front().block, batch_locations.front().offset);
+
+  auto index_count = GetIndexCount();
+
+  std::vector<ItemPointer *> index_entry_ptrs;
+  if (index_count != 0 || version_store_ == true) {
+    index_entry_ptrs.reserve(tuple_count);
+    for (auto &location : batch_locations) {
+      index_entry_ptrs.push_back(AllocateIndirection(location));
+    }
+  }
+
+  // unlike InsertTuple, the tuples are owned by the transaction before they
+  // are inserted in the indexes. if a constraint is violated, the abort of
+  // the transaction cleans up the whole batch.
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  transaction_manager.PerformInserts(transaction, batch_locations,
+                                     index_entry_ptrs);
+
+  if (locations != nullptr) {
+    locations->insert(locations->end(), batch_locations.begin(),
+                      batch_locations.end());
+  }
+
+  if (index_count != 0) {
+    // Index checks and updates
+    if (InsertBatchInIndexes(tuples, index_entry_ptrs, transaction) == false) {
+      LOG_TRACE("Index constraint violated");
+      return false;
+    }
+
+    // ForeignKey checks
+    for (auto tuple : tuples) {
+      if (CheckForeignKeyConstraints(tuple) == false) {
+        LOG_TRACE("ForeignKey constraint violated");
+        return false;
+      }
+    }
+  }
+
+  // Increase the table's number of tuples by the size of the batch
+  IncreaseTupleCount(tuple_count);
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// BULK LOAD
+//===--------------------------------------------------------------------===//
+
+std::shared_ptr<TileGroup> DataTable::GetBulkLoadTileGroup() {
+  // Place it on the node of the loading thread, like the active tile groups
+  int numa_node = NUMA_NODE_ANY;
+  if (numa_node_count_ > 0) {
+    numa_node = static_cast<int>(
+        NumaTopology::GetInstance().GetCurrentNode() % numa_node_count_);
+  }
+
+  column_map_type column_map =
+      GetTileGroupLayout((LayoutType)peloton_layout_mode);
+  std::shared_ptr<TileGroup> tile_group(
+      GetTileGroupWithLayout(column_map, numa_node));
+  PL_ASSERT(tile_group.get());
+
+  // The index entries of the loaded tuples are resolved through the catalog
+  catalog::Manager::GetInstance().AddTileGroup(tile_group->GetTileGroupId(),
+                                               tile_group);
+  return tile_group;
+}
+
+bool DataTable::InsertBulkLoadInIndexes(TileGroup *tile_group,
+                                        concurrency::Transaction *transaction) {
+  if (GetIndexCount() == 0) {
+    return true;
+  }
+
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tile_group_header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetNextTupleSlot();
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    expression::ContainerTuple<TileGroup> tuple(tile_group, tuple_id);
+    ItemPointer *index_entry_ptr = nullptr;
+    if (InsertInIndexes(&tuple, ItemPointer(tile_group_id, tuple_id),
+                        transaction, &index_entry_ptr) == false) {
+      LOG_TRACE("Index constraint violated");
+      return false;
+    }
+    tile_group_header->SetIndirection(tuple_id, index_entry_ptr);
+  }
+  return true;
+}
+
+void DataTable::AppendBulkLoadTileGroups(
+    const std::vector<std::shared_ptr<TileGroup>> &tile_groups) {
+  size_t tuple_count = 0;
+  for (auto &tile_group : tile_groups) {
+    tile_groups_.Append(tile_group->GetTileGroupId());
+    CountLayout(tile_group->GetColumnMap(), 1);
+    tuple_count += tile_group->GetNextTupleSlot();
+
+    // we must guarantee that the compiler always add tile group before adding
+    // tile_group_count_.
+    COMPILER_MEMORY_FENCE;
+
+    tile_group_count_++;
+  }
+  IncreaseTupleCount(tuple_count);
+}
+
 /**
  * @brief Insert a tuple into all indexes. If index is primary/unique,
  * check visibility of existing
@@ -334,35 +570,13 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
  * @returns True on success, false if a visible entry exists (in case of
  *primary/unique).
  */
-bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
+bool DataTable::InsertInIndexes(const AbstractTuple *tuple,
                                 ItemPointer location,
                                 concurrency::Transaction *transaction,
                                 ItemPointer **index_entry_ptr) {
   int index_count = GetIndexCount();
 
-  size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
-
-  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-
-  while (true) {
-    auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
-    indirection_offset = active_indirection_array->AllocateIndirection();
-
-    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
-          active_indirection_array->GetIndirectionByOffset(indirection_offset);
-      break;
-    }
-  }
-
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
+  *index_entry_ptr = AllocateIndirection(location);
 
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -414,6 +628,82 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
   return true;
 }
 
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
+  size_t active_indirection_array_id =
+      GetInsertThreadId() % active_indirection_array_count_;
+
+  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *index_entry_ptr = nullptr;
+
+  while (true) {
+    auto active_indirection_array =
+        active_indirection_arrays_[active_indirection_array_id];
+    indirection_offset = active_indirection_array->AllocateIndirection();
+
+    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+      index_entry_ptr =
+          active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      break;
+    }
+  }
+
+  index_entry_ptr->block = location.block;
+  index_entry_ptr->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    AddDefaultIndirectionArray(active_indirection_array_id);
+  }
+
+  return index_entry_ptr;
+}
+
+// the tuples of the batch are already owned by the transaction, so a
+// duplicate key within the batch violates the unique constraints as well.
+bool DataTable::InsertBatchInIndexes(
+    const std::vector<const Tuple *> &tuples,
+    const std::vector<ItemPointer *> &index_entry_ptrs,
+    concurrency::Transaction *transaction) {
+  int index_count = GetIndexCount();
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, transaction, std::placeholders::_1);
+
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index == nullptr) continue;
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    // the key is reused for every tuple of the batch
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+
+    bool is_unique =
+        index->GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+        index->GetIndexType() == IndexConstraintType::UNIQUE;
+
+    for (size_t tuple_itr = 0; tuple_itr < tuples.size(); tuple_itr++) {
+      key->SetFromTuple(tuples[tuple_itr], indexed_columns, index->GetPool());
+
+      if (is_unique == true) {
+        // if in this index there has been a visible or uncommitted
+        // <key, location> pair, this constraint is violated
+        if (index->CondInsertEntry(key.get(), index_entry_ptrs[tuple_itr],
+                                   fn) == false) {
+          return false;
+        }
+      } else {
+        index->InsertEntry(key.get(), index_entry_ptrs[tuple_itr]);
+      }
+    }
+    LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
+  }
+
+  return true;
+}
+
 bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                          const TargetList *targets_ptr,
                                          concurrency::Transaction *transaction,
@@ -598,10 +888,34 @@ void DataTable::ResetDirty() { dirty_ = false; }
 //===--------------------------------------------------------------------===//
 
 TileGroup *DataTable::GetTileGroupWithLayout(
-    const column_map_type &partitioning) {
+    const column_map_type &partitioning, const int numa_node) {
   oid_t tile_group_id = catalog::Manager::GetInstance().GetNextTileGroupId();
-  return (AbstractTable::GetTileGroupWithLayout(
-      database_oid, tile_group_id, partitioning, tuples_per_tilegroup_));
+  return (AbstractTable::GetTileGroupWithLayout(database_oid, tile_group_id,
+                                                partitioning,
+                                                tuples_per_tilegroup_,
+                                                numa_node));
+}
+
+void DataTable::AddVersionTileGroup() {
+  // versions are read a tuple at a time, so they are stored in rows.
+  std::shared_ptr<TileGroup> tile_group(
+      GetTileGroupWithLayout(GetTileGroupLayout(LAYOUT_TYPE_ROW)));
+  PL_ASSERT(tile_group.get());
+  tile_group->SetVersionTileGroup();
+
+  oid_t tile_group_id = tile_group->GetTileGroupId();
+  version_tile_groups_.Append(tile_group_id);
+
+  // add tile group metadata in locator
+  catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
+
+  COMPILER_MEMORY_FENCE;
+
+  std::atomic_store(&active_version_tile_group_, tile_group);
+
+  version_tile_group_count_++;
+
+  LOG_TRACE("Recording version tile group : %u ", tile_group_id);
 }
 
 oid_t DataTable::AddDefaultIndirectionArray(
@@ -620,33 +934,121 @@ oid_t DataTable::AddDefaultIndirectionArray(
   return indirection_array_id;
 }
 
+size_t DataTable::GetInsertThreadId() {
+  static std::atomic<size_t> insert_thread_count(0);
+  static thread_local size_t insert_thread_id = insert_thread_count++;
+  return insert_thread_id;
+}
+
+size_t DataTable::GetActiveTileGroupId() const {
+  size_t insert_thread_id = GetInsertThreadId();
+  size_t active_tile_group_count = active_tilegroup_count_;
+  if (numa_node_count_ == 0) {
+    return insert_thread_id % active_tile_group_count;
+  }
+
+  // Active tile group i lives on node (i % numa_node_count_). Only pick the
+  // ones of the node the inserting thread runs on.
+  size_t numa_node =
+      NumaTopology::GetInstance().GetCurrentNode() % numa_node_count_;
+  size_t node_tile_group_count = active_tile_group_count / numa_node_count_;
+  return numa_node +
+         numa_node_count_ * (insert_thread_id % node_tile_group_count);
+}
+
+int DataTable::GetActiveTileGroupNumaNode(
+    const size_t active_tile_group_id) const {
+  if (numa_node_count_ == 0) {
+    return NUMA_NODE_ANY;
+  }
+  return static_cast<int>(active_tile_group_id % numa_node_count_);
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetActiveTileGroupId();
   return AddDefaultTileGroup(active_tile_group_id);
 }
 
 oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
+  return InstallActiveTileGroup(active_tile_group_id,
+                                CreateDefaultTileGroup(active_tile_group_id));
+}
+
+void DataTable::GrowActiveTileGroups(const size_t &active_tile_group_count) {
+  // the other waiting threads only check if one of them already grew them
+  if (active_tile_group_count >= max_active_tilegroup_count_ ||
+      active_tilegroup_count_ != active_tile_group_count) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(active_tile_groups_mutex_);
+  if (active_tilegroup_count_ != active_tile_group_count) {
+    return;
+  }
+
+  // double the active tile groups. the count stays a multiple of the number
+  // of NUMA nodes, and the new ones are installed before they can be picked.
+  size_t new_count =
+      std::min(active_tile_group_count * 2, max_active_tilegroup_count_);
+  for (size_t i = active_tile_group_count; i < new_count; ++i) {
+    AddDefaultTileGroup(i);
+  }
+  active_tilegroup_count_ = new_count;
+
+  LOG_TRACE("Grew active tile groups to %lu", new_count);
+}
+
+void DataTable::ReplaceFullTileGroup(const size_t &active_tile_group_id) {
+  auto &spare_tile_group = spare_tile_groups_[active_tile_group_id];
+
+  // the other threads that insert into this active tile group wait until it
+  // is replaced. hand off the spare tile group if there is one, so that they
+  // do not wait for an allocation.
+  auto tile_group = std::atomic_exchange(&spare_tile_group,
+                                         std::shared_ptr<TileGroup>());
+  if (tile_group == nullptr) {
+    tile_group = CreateDefaultTileGroup(active_tile_group_id);
+  }
+  InstallActiveTileGroup(active_tile_group_id, tile_group);
+
+  // allocate the tile group that replaces the new active tile group. it is
+  // dropped if another thread has already done so.
+  auto next_tile_group = CreateDefaultTileGroup(active_tile_group_id);
+  std::shared_ptr<TileGroup> no_tile_group;
+  std::atomic_compare_exchange_strong(&spare_tile_group, &no_tile_group,
+                                      next_tile_group);
+}
+
+std::shared_ptr<TileGroup> DataTable::CreateDefaultTileGroup(
+    const size_t &active_tile_group_id) {
   column_map_type column_map;
-  oid_t tile_group_id = INVALID_OID;
 
   // Figure out the partitioning for given tilegroup layout
   column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
 
   // Create a tile group with that partitioning
-  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(
+      column_map, GetActiveTileGroupNumaNode(active_tile_group_id)));
   PL_ASSERT(tile_group.get());
 
-  tile_group_id = tile_group->GetTileGroupId();
+  return tile_group;
+}
+
+oid_t DataTable::InstallActiveTileGroup(
+    const size_t &active_tile_group_id,
+    const std::shared_ptr<TileGroup> &tile_group) {
+  oid_t tile_group_id = tile_group->GetTileGroupId();
 
   LOG_TRACE("Added a tile group ");
   tile_groups_.Append(tile_group_id);
+  CountLayout(tile_group->GetColumnMap(), 1);
 
   // add tile group metadata in locator
   catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
 
   COMPILER_MEMORY_FENCE;
 
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  std::atomic_store(&active_tile_groups_[active_tile_group_id], tile_group);
 
   // we must guarantee that the compiler always add tile group before adding
   // tile_group_count_.
@@ -680,6 +1082,7 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
   if (tile_groups_exists == false) {
     tile_groups_.Append(tile_group_id);
+    CountLayout(column_map, 1);
 
     LOG_TRACE("Added a tile group ");
 
@@ -698,13 +1101,14 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id = GetActiveTileGroupId();
 
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  std::atomic_store(&active_tile_groups_[active_tile_group_id], tile_group);
 
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
   tile_groups_.Append(tile_group_id);
+  CountLayout(tile_group->GetColumnMap(), 1);
 
   // add tile group in catalog
   catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
@@ -730,6 +1134,59 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
   return GetTileGroupById(tile_group_id);
 }
 
+std::shared_ptr<storage::TileGroup> DataTable::InspectTileGroup(
+    const std::size_t &tile_group_offset) const {
+  PL_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+
+  auto &manager = catalog::Manager::GetInstance();
+  return manager.InspectTileGroup(tile_group_id);
+}
+
+void DataTable::SetVersionStore(const bool version_store) {
+  if (version_store == true &&
+      std::atomic_load(&active_version_tile_group_) == nullptr) {
+    AddVersionTileGroup();
+  }
+  version_store_ = version_store;
+}
+
+size_t DataTable::GetVersionTileGroupCount() const {
+  return version_tile_group_count_;
+}
+
+std::shared_ptr<storage::TileGroup> DataTable::GetVersionTileGroup(
+    const std::size_t &version_tile_group_offset) const {
+  PL_ASSERT(version_tile_group_offset < GetVersionTileGroupCount());
+
+  auto tile_group_id = version_tile_groups_.FindValid(
+      version_tile_group_offset, invalid_tile_group_id);
+
+  return GetTileGroupById(tile_group_id);
+}
+
+std::vector<oid_t> DataTable::GetNumaScanOrder(const size_t tile_group_count,
+                                               const int numa_node) const {
+  std::vector<oid_t> local_offsets, remote_offsets;
+  local_offsets.reserve(tile_group_count);
+
+  for (oid_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = GetTileGroup(offset);
+    if (tile_group->GetNumaNode() == NUMA_NODE_ANY ||
+        tile_group->GetNumaNode() == numa_node) {
+      local_offsets.push_back(offset);
+    } else {
+      remote_offsets.push_back(offset);
+    }
+  }
+
+  local_offsets.insert(local_offsets.end(), remote_offsets.begin(),
+                       remote_offsets.end());
+  return local_offsets;
+}
+
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
     const oid_t &tile_group_id) const {
   auto &manager = catalog::Manager::GetInstance();
@@ -754,6 +1211,11 @@ void DataTable::DropTileGroups() {
   // Clear array
   tile_groups_.Clear(invalid_tile_group_id);
 
+  {
+    std::lock_guard<std::mutex> lock(layout_counts_mutex_);
+    layout_counts_.clear();
+  }
+
   tile_group_count_ = 0;
 }
 
@@ -870,6 +1332,82 @@ oid_t DataTable::GetValidIndexCount() const {
   return valid_index_count;
 }
 
+void DataTable::BuildIndex(index::Index *index, size_t begin_tile_group_offset,
+                           size_t end_tile_group_offset, size_t thread_count) {
+  auto tile_group_count = GetTileGroupCount();
+
+  // the versions of the version store are indexed along with the last range
+  // of tile groups
+  size_t version_tile_group_count = 0;
+  if (end_tile_group_offset >= tile_group_count) {
+    version_tile_group_count = GetVersionTileGroupCount();
+  }
+
+  end_tile_group_offset = std::min(end_tile_group_offset, tile_group_count);
+  if (begin_tile_group_offset >= end_tile_group_offset &&
+      version_tile_group_count == 0) {
+    return;
+  }
+  begin_tile_group_offset =
+      std::min(begin_tile_group_offset, end_tile_group_offset);
+
+  size_t last_tile_group_offset =
+      end_tile_group_offset + version_tile_group_count;
+  thread_count = std::max<size_t>(
+      std::min(thread_count, last_tile_group_offset - begin_tile_group_offset),
+      1);
+
+  // From here on, the writes of other transactions reach the index through
+  // its catch-up log
+  index->StartBulkBuild(thread_count);
+
+  // Every thread takes the next tile group, and adds the keys of its tuples
+  // to its own partition of the index build
+  const auto &key_attrs = index->GetMetadata()->GetKeyAttrs();
+  std::atomic<size_t> next_tile_group_offset(begin_tile_group_offset);
+  auto extract_keys = [&](size_t partition) {
+    std::unique_ptr<Tuple> key(new Tuple(index->GetKeySchema(), true));
+    while (true) {
+      size_t tile_group_offset = next_tile_group_offset.fetch_add(1);
+      if (tile_group_offset >= last_tile_group_offset) {
+        break;
+      }
+
+      auto tile_group =
+          tile_group_offset < end_tile_group_offset
+              ? GetTileGroup(tile_group_offset)
+              : GetVersionTileGroup(tile_group_offset - end_tile_group_offset);
+      auto tile_group_header = tile_group->GetHeader();
+      oid_t tuple_count = tile_group->GetNextTupleSlot();
+      for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+        // A version without an index entry pointer is still being inserted,
+        // and its writer adds it to the index
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_id);
+        if (index_entry_ptr == nullptr) {
+          continue;
+        }
+
+        expression::ContainerTuple<TileGroup> tuple(tile_group.get(),
+                                                    tuple_id);
+        key->SetFromTuple(&tuple, key_attrs, index->GetPool());
+        index->BulkBuildEntry(partition, key.get(), index_entry_ptr);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back(extract_keys, thread_itr);
+  }
+  extract_keys(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  index->FinishBulkBuild();
+}
+
 //===--------------------------------------------------------------------===//
 // FOREIGN KEYS
 //===--------------------------------------------------------------------===//
@@ -956,6 +1494,7 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
 
   auto column_count = new_column_map.size();
   auto tuple_count = orig_tile_group->GetAllocatedTupleCount();
+  auto header = orig_tile_group->GetHeader();
   // Go over each column copying onto the new tile group
   for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
     // Locate the original base tile and tile column offset
@@ -968,8 +1507,12 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
     auto new_tile = new_tile_group->GetTile(new_tile_offset);
 
-    // Copy the column over to the new tile group
+    // Copy the column over to the new tile group. Slots without a committed
+    // version are skipped, their varlen values may be freed already.
     for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      if (header->GetBeginCommitId(tuple_itr) == MAX_CID) {
+        continue;
+      }
       type::Value val =
           (orig_tile->GetValue(tuple_itr, orig_tile_column_offset));
       new_tile->SetValue(val, tuple_itr, new_tile_column_offset);
@@ -977,9 +1520,13 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
   }
 
   // Finally, copy over the tile header
-  auto header = orig_tile_group->GetHeader();
   auto new_header = new_tile_group->GetHeader();
   *new_header = *header;
+
+  // the delta records now belong to the new tile group
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    header->SetDeltaRecord(tuple_itr, nullptr);
+  }
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -996,7 +1543,8 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
-  auto diff = tile_group->GetSchemaDifference(default_partition_);
+  auto default_partition = GetDefaultLayout();
+  auto diff = tile_group->GetSchemaDifference(default_partition);
 
   // Check threshold for transformation
   if (diff < theta) {
@@ -1007,15 +1555,15 @@ storage::TileGroup *DataTable::TransformTileGroup(
 
   // Get the schema for the new transformed tile group
   auto new_schema =
-      TransformTileGroupSchema(tile_group.get(), default_partition_);
+      TransformTileGroupSchema(tile_group.get(), default_partition);
 
   // Allocate space for the transformed tile group
   std::shared_ptr<storage::TileGroup> new_tile_group(
       TileGroupFactory::GetTileGroup(
           tile_group->GetDatabaseId(), tile_group->GetTableId(),
           tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
-          new_schema, default_partition_,
-          tile_group->GetAllocatedTupleCount()));
+          new_schema, default_partition,
+          tile_group->GetAllocatedTupleCount(), tile_group->GetNumaNode()));
 
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
@@ -1023,6 +1571,8 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Set the location of the new tile group
   // and clean up the orig tile group
   catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+  CountLayout(tile_group->GetColumnMap(), -1);
+  CountLayout(default_partition, 1);
 
   return new_tile_group.get();
 }
@@ -1077,7 +1627,7 @@ std::map<oid_t, oid_t> DataTable::GetColumnMapStats() {
   std::map<oid_t, oid_t> column_map_stats;
 
   // Cluster per-tile column count
-  for (auto entry : default_partition_) {
+  for (auto entry : GetDefaultLayout()) {
     auto tile_id = entry.second.first;
     auto column_map_itr = column_map_stats.find(tile_id);
     if (column_map_itr == column_map_stats.end())
@@ -1090,12 +1640,29 @@ std::map<oid_t, oid_t> DataTable::GetColumnMapStats() {
 }
 
 void DataTable::SetDefaultLayout(const column_map_type &layout) {
+  std::lock_guard<std::mutex> lock(default_partition_mutex_);
   default_partition_ = layout;
 }
 
 column_map_type DataTable::GetDefaultLayout() const {
+  std::lock_guard<std::mutex> lock(default_partition_mutex_);
   return default_partition_;
 }
 
+void DataTable::CountLayout(const column_map_type &layout, int delta) {
+  std::lock_guard<std::mutex> lock(layout_counts_mutex_);
+  auto &count = layout_counts_[layout];
+  PL_ASSERT(delta > 0 || count >= static_cast<size_t>(-delta));
+  count += delta;
+  if (count == 0) {
+    layout_counts_.erase(layout);
+  }
+}
+
+std::map<column_map_type, size_t> DataTable::GetLayoutCounts() const {
+  std::lock_guard<std::mutex> lock(layout_counts_mutex_);
+  return layout_counts_;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
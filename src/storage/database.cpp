@@ -13,12 +13,15 @@
 #include <sstream>
 
 #include "catalog/foreign_key.h"
+#include "codegen/tiered_compiler.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "configuration/configuration.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "storage/database.h"
 #include "storage/table_factory.h"
+#include "storage/tile_group_freezer.h"
 
 namespace peloton {
 namespace storage {
@@ -49,6 +52,11 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
       auto *gc_manager = &gc::GCManagerFactory::GetInstance();
       assert(gc_manager != nullptr);
       gc_manager->RegisterTable(table->GetOid());
+
+      // Register table to tile group freezer.
+      if (FLAGS_tile_group_freezer == true) {
+        TileGroupFreezer::GetInstance().AddTable(table);
+      }
     }
   }
 }
@@ -75,6 +83,10 @@ storage::DataTable *Database::GetTableWithName(
 }
 
 void Database::DropTableWithOid(const oid_t table_oid) {
+  // Wait for the background compilation of plans that access the table,
+  // which does not take the database latch
+  codegen::TieredCompiler::GetInstance().DropTable(database_oid, table_oid);
+
   {
     std::lock_guard<std::mutex> lock(database_mutex);
 
@@ -93,6 +105,9 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     }
     PL_ASSERT(table_offset < tables.size());
 
+    // Deregister table from tile group freezer.
+    TileGroupFreezer::GetInstance().RemoveTable(tables.at(table_offset));
+
     // Drop the table
     tables.erase(tables.begin() + table_offset);
   }
@@ -114,6 +129,13 @@ storage::DataTable *Database::ReplaceTableWithOid(
 
     auto old_table = tables.at(table_offset);
     tables[table_offset] = new_table;
+
+    auto &tile_group_freezer = TileGroupFreezer::GetInstance();
+    tile_group_freezer.RemoveTable(old_table);
+    if (FLAGS_tile_group_freezer == true) {
+      tile_group_freezer.AddTable(new_table);
+    }
+
     return old_table;
   }
 }
@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// delta_record.cpp
+//
+// Identification: src/storage/delta_record.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/delta_record.h"
+
+#include "common/abstract_tuple.h"
+
+namespace peloton {
+namespace storage {
+
+DeltaRecord::DeltaRecord(const AbstractTuple *tuple,
+                         const std::vector<oid_t> &column_ids)
+    : begin_cid(MAX_CID),
+      commit_epoch_id(MAX_EID),
+      column_ids(column_ids),
+      next(nullptr) {
+  values.reserve(column_ids.size());
+  for (auto column_id : column_ids) {
+    values.push_back(tuple->GetValue(column_id).Copy());
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
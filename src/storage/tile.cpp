@@ -22,6 +22,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/backend_manager.h"
 #include "storage/tile.h"
+#include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
 #include "storage/tuple_iterator.h"
@@ -37,6 +38,8 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       tile_group_id(INVALID_OID),
       tile_id(INVALID_OID),
       backend_type(backend_type),
+      numa_node(tile_group != nullptr ? tile_group->GetNumaNode()
+                                      : NUMA_NODE_ANY),
       schema(tuple_schema),
       data(NULL),
       tile_group(tile_group),
@@ -53,15 +56,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
   tile_size = tuple_count * tuple_length;
 
   // allocate tuple storage space for inlined data
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // data = reinterpret_cast<char *>(
-  // storage_manager.Allocate(backend_type, tile_size));
-
-  data = new char[tile_size];
-  PL_ASSERT(data != NULL);
-
-  // zero out the data
-  PL_MEMSET(data, 0, tile_size);
+  AllocateData();
 
   // allocate pool for blob storage if schema not inlined
   // if (schema.IsInlined() == false) {
@@ -71,11 +66,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
-  // auto &storage_manager = storage::StorageManager::GetInstance();
-  // storage_manager.Release(backend_type, data);
-
-  delete[] data;
-  data = NULL;
+  ReleaseData();
 
   // reclaim the tile memory (UNINLINED data)
   // if (schema.IsInlined() == false) {
@@ -88,6 +79,49 @@ Tile::~Tile() {
   column_header = NULL;
 }
 
+//===--------------------------------------------------------------------===//
+// Tuple Storage
+//===--------------------------------------------------------------------===//
+
+void Tile::AllocateData() {
+  if (data != NULL) {
+    return;
+  }
+
+  // auto &storage_manager = storage::StorageManager::GetInstance();
+  // data = reinterpret_cast<char *>(
+  // storage_manager.Allocate(backend_type, tile_size));
+
+  if (numa_node == NUMA_NODE_ANY) {
+    data = new char[tile_size];
+  } else {
+    auto &backend_manager = storage::BackendManager::GetInstance();
+    data = reinterpret_cast<char *>(
+        backend_manager.Allocate(backend_type, tile_size, numa_node));
+  }
+  PL_ASSERT(data != NULL);
+
+  // zero out the data
+  PL_MEMSET(data, 0, tile_size);
+}
+
+void Tile::ReleaseData() {
+  if (data == NULL) {
+    return;
+  }
+
+  // auto &storage_manager = storage::StorageManager::GetInstance();
+  // storage_manager.Release(backend_type, data);
+
+  if (numa_node == NUMA_NODE_ANY) {
+    delete[] data;
+  } else {
+    auto &backend_manager = storage::BackendManager::GetInstance();
+    backend_manager.Release(backend_type, data, tile_size, numa_node);
+  }
+  data = NULL;
+}
+
 //===--------------------------------------------------------------------===//
 // Tuples
 //===--------------------------------------------------------------------===//
@@ -12,14 +12,18 @@
 
 #include "storage/tile_group.h"
 
+#include <algorithm>
 #include <numeric>
 
 #include "catalog/manager.h"
 #include "common/container_tuple.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "type/types.h"
 #include "storage/abstract_table.h"
+#include "storage/compressed_column.h"
+#include "storage/delta_record.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
@@ -30,11 +34,13 @@ namespace storage {
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
-                     const column_map_type &column_map, int tuple_count)
+                     const column_map_type &column_map, int tuple_count,
+                     int numa_node)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
       backend_type(backend_type),
+      numa_node(numa_node),
       tile_schemas(schemas),
       tile_group_header(tile_group_header),
       table(table),
@@ -127,6 +133,39 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
   }
 }
 
+void TileGroup::CopyTuples(const Tuple *const *tuples,
+                           const oid_t &tuple_slot_id,
+                           const oid_t &tuple_count) {
+  LOG_TRACE("Tile Group Id :: %u status :: %u-%u out of %u slots ",
+            tile_group_id, tuple_slot_id, tuple_slot_id + tuple_count,
+            num_tuple_slots);
+
+  oid_t column_itr = 0;
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    const catalog::Schema &schema = tile_schemas[tile_itr];
+    oid_t tile_column_count = schema.GetColumnCount();
+
+    storage::Tile *tile = GetTile(tile_itr);
+    PL_ASSERT(tile);
+
+    // the schema lookups are amortized over the whole batch
+    for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
+         tile_column_itr++) {
+      size_t column_offset = schema.GetOffset(tile_column_itr);
+      bool is_inlined = schema.IsInlined(tile_column_itr);
+      size_t column_length = schema.GetAppropriateLength(tile_column_itr);
+
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        type::Value val = (tuples[tuple_itr]->GetValue(column_itr));
+        tile->SetValueFast(val, tuple_slot_id + tuple_itr, column_offset,
+                           is_inlined, column_length);
+      }
+      column_itr++;
+    }
+  }
+}
+
 /**
  * Grab next slot (thread-safe) and fill in the tuple if tuple != nullptr
  *
@@ -345,10 +384,143 @@ void TileGroup::SetValue(type::Value &value, oid_t tuple_id,
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
 }
 
+void TileGroup::ReplaceValue(type::Value &value, oid_t tuple_id,
+                             oid_t column_id) {
+  PL_ASSERT(tuple_id < GetNextTupleSlot());
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  Tile *tile = GetTile(tile_offset);
+
+  char *varlen_ptr = nullptr;
+  const catalog::Schema &schema = tile_schemas[tile_offset];
+  auto type_id = schema.GetType(tile_column_id);
+  if ((type_id == type::TypeId::VARCHAR ||
+       type_id == type::TypeId::VARBINARY) &&
+      schema.IsInlined(tile_column_id) == false) {
+    char *field_location =
+        tile->GetTupleLocation(tuple_id) + schema.GetOffset(tile_column_id);
+    varlen_ptr = type::Value::GetDataFromStorage(type_id, field_location);
+  }
+
+  tile->SetValue(value, tuple_id, tile_column_id);
+
+  if (varlen_ptr != nullptr) {
+    tile->GetPool()->Free(varlen_ptr);
+  }
+}
+
+void TileGroup::ReconstructTuple(const oid_t tuple_slot_id,
+                                 const DeltaRecord *delta_record, Tuple *tuple,
+                                 type::AbstractPool *pool) {
+  oid_t column_count = column_map.size();
+  std::vector<bool> is_set(column_count, false);
+  oid_t set_count = 0;
+
+  // the newest record that holds a column decides its value
+  for (; delta_record != nullptr && set_count < column_count;
+       delta_record = delta_record->next) {
+    if (delta_record->begin_cid == INVALID_CID) {
+      continue;
+    }
+    for (size_t itr = 0; itr < delta_record->column_ids.size(); itr++) {
+      oid_t column_id = delta_record->column_ids[itr];
+      if (is_set[column_id] == false) {
+        tuple->SetValue(column_id, delta_record->values[itr], pool);
+        is_set[column_id] = true;
+        set_count++;
+      }
+    }
+  }
+
+  // the GC writes the folded records into the tuple slot before it detaches
+  // them, so the tuple slot must be read after the records.
+  COMPILER_MEMORY_FENCE;
+
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    if (is_set[column_id] == false) {
+      tuple->SetValue(column_id, GetValue(tuple_slot_id, column_id), pool);
+    }
+  }
+}
+
+DeltaRecord *TileGroup::FoldDeltaRecords(const oid_t tuple_slot_id,
+                                         const eid_t expired_eid) {
+  std::lock_guard<std::mutex> lock(tile_group_mutex);
+
+  // find the newest record from which on every record is either aborted, or
+  // committed in an epoch that has expired.
+  DeltaRecord *prev_record = nullptr;
+  DeltaRecord *fold_record = nullptr;
+  DeltaRecord *last_record = nullptr;
+  for (auto delta_record = tile_group_header->GetDeltaRecord(tuple_slot_id);
+       delta_record != nullptr; delta_record = delta_record->next) {
+    bool is_foldable = delta_record->begin_cid == INVALID_CID ||
+                       (delta_record->begin_cid != MAX_CID &&
+                        delta_record->commit_epoch_id <= expired_eid);
+    if (is_foldable == false) {
+      fold_record = nullptr;
+    } else if (fold_record == nullptr) {
+      prev_record = last_record;
+      fold_record = delta_record;
+    }
+    last_record = delta_record;
+  }
+
+  if (fold_record == nullptr) {
+    return nullptr;
+  }
+
+  // write the folded version into the tuple slot, the newest record first.
+  // a transaction only reads a column from the tuple slot if no record that
+  // it can see holds the column. every folded record is visible to all
+  // running transactions, so the overwritten values can be freed right away.
+  Thaw();
+  oid_t column_count = column_map.size();
+  std::vector<bool> is_set(column_count, false);
+  for (auto delta_record = fold_record; delta_record != nullptr;
+       delta_record = delta_record->next) {
+    if (delta_record->begin_cid == INVALID_CID) {
+      continue;
+    }
+    for (size_t itr = 0; itr < delta_record->column_ids.size(); itr++) {
+      oid_t column_id = delta_record->column_ids[itr];
+      if (is_set[column_id] == false) {
+        ReplaceValue(delta_record->values[itr], tuple_slot_id, column_id);
+        is_set[column_id] = true;
+      }
+    }
+  }
+
+  COMPILER_MEMORY_FENCE;
+
+  // detach the folded records. only the owner of the tuple pushes new records
+  // at the head, so the head is the only link that can change meanwhile.
+  while (prev_record == nullptr) {
+    if (tile_group_header->SetAtomicDeltaRecord(tuple_slot_id, fold_record,
+                                                nullptr) == true) {
+      return fold_record;
+    }
+    prev_record = tile_group_header->GetDeltaRecord(tuple_slot_id);
+    while (prev_record->next != fold_record) {
+      prev_record = prev_record->next;
+    }
+  }
+  prev_record->next = nullptr;
+
+  return fold_record;
+}
+
+void TileGroup::FreeDeltaRecords(const oid_t tuple_slot_id) {
+  std::lock_guard<std::mutex> lock(tile_group_mutex);
+  tile_group_header->FreeDeltaRecords(tuple_slot_id);
+}
 
 std::shared_ptr<Tile> TileGroup::GetTileReference(
     const oid_t tile_offset) const {
   PL_ASSERT(tile_offset < tile_count);
+  if (is_released_ == true) {
+    Materialize();
+  }
   return tiles[tile_offset];
 }
 
@@ -379,6 +551,213 @@ void TileGroup::Sync() {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// Compression
+//===--------------------------------------------------------------------===//
+
+void TileGroup::Freeze() {
+  std::shared_ptr<const CompressedTileGroup> compressed_tile_group(
+      new CompressedTileGroup(this, GetNextTupleSlot()));
+
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+  std::atomic_store(&compressed_tile_group_, compressed_tile_group);
+  is_frozen_ = true;
+
+  // Transactions that got hold of the tile group before it was frozen did
+  // not record their access
+  RecordAccess();
+
+  LOG_TRACE("Froze tile group %u : %lu -> %lu bytes", tile_group_id,
+            compressed_tile_group->GetUncompressedSize(),
+            compressed_tile_group->GetCompressedSize());
+}
+
+void TileGroup::Thaw() {
+  if (reserved_epoch_id_ != INVALID_EID) {
+    std::lock_guard<std::mutex> lock(reservation_mutex_);
+    reserved_epoch_id_ = INVALID_EID;
+  }
+
+  if (is_frozen_ == false) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+  if (is_frozen_ == false) {
+    return;
+  }
+
+  // The compressed column blocks are the only copy of released tiles
+  if (is_released_ == true) {
+    MaterializeTiles();
+  }
+
+  is_frozen_ = false;
+  std::atomic_store(&compressed_tile_group_,
+                    std::shared_ptr<const CompressedTileGroup>());
+
+  LOG_TRACE("Thawed tile group %u", tile_group_id);
+}
+
+void TileGroup::RecordAccess() {
+  auto current_epoch_id =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+  auto access_epoch_id = access_epoch_id_.load();
+  while (access_epoch_id < current_epoch_id &&
+         access_epoch_id_.compare_exchange_weak(access_epoch_id,
+                                                current_epoch_id) == false) {
+  }
+}
+
+eid_t TileGroup::ReserveTransform() {
+  auto current_epoch_id =
+      concurrency::EpochManagerFactory::GetInstance().GetCurrentEpochId();
+
+  eid_t reserved_epoch_id = INVALID_EID;
+  if (reserved_epoch_id_.compare_exchange_strong(reserved_epoch_id,
+                                                 current_epoch_id) == true) {
+    return current_epoch_id;
+  }
+  return reserved_epoch_id;
+}
+
+std::unique_lock<std::mutex> TileGroup::LockReservation(
+    const eid_t expired_eid) {
+  std::unique_lock<std::mutex> lock(reservation_mutex_);
+
+  // A transaction that found the tile group unreserved may still rewrite one
+  // of its empty slots without thawing it again.
+  auto reserved_epoch_id = reserved_epoch_id_.load();
+  if (reserved_epoch_id == INVALID_EID || reserved_epoch_id >= expired_eid) {
+    lock.unlock();
+  }
+  return lock;
+}
+
+size_t TileGroup::ReleaseTiles(const eid_t expired_eid) {
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+  if (is_frozen_ == false || is_released_ == true ||
+      access_epoch_id_ >= expired_eid) {
+    return 0;
+  }
+
+  auto compressed_tile_group = GetCompressedTileGroup();
+  PL_ASSERT(compressed_tile_group != nullptr);
+
+  // Only tiles whose columns are all compressed can be re-materialized
+  std::vector<bool> is_releasable(tile_count, true);
+  for (auto &entry : column_map) {
+    if (compressed_tile_group->GetColumn(entry.first) == nullptr) {
+      is_releasable[entry.second.first] = false;
+    }
+  }
+  if (std::find(is_releasable.begin(), is_releasable.end(), true) ==
+      is_releasable.end()) {
+    return 0;
+  }
+
+  // A transaction records its access before it looks at the tiles, so either
+  // it sees the flag and re-materializes them, or we see its access here.
+  is_released_ = true;
+  if (access_epoch_id_ >= expired_eid) {
+    is_released_ = false;
+    return 0;
+  }
+
+  auto tuple_count = compressed_tile_group->GetTupleCount();
+  size_t released_size = 0;
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    if (is_releasable[tile_itr] == false) {
+      continue;
+    }
+
+    // Free the varlen values of all slots that were not reclaimed yet
+    Tile *tile = tiles[tile_itr].get();
+    const catalog::Schema &schema = tile_schemas[tile_itr];
+    for (oid_t tile_column_itr = 0; tile_column_itr < schema.GetColumnCount();
+         tile_column_itr++) {
+      auto type_id = schema.GetType(tile_column_itr);
+      if ((type_id != type::TypeId::VARCHAR &&
+           type_id != type::TypeId::VARBINARY) ||
+          schema.IsInlined(tile_column_itr) == true) {
+        continue;
+      }
+
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        if (tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+          continue;
+        }
+        char *field_location = tile->GetTupleLocation(tuple_itr) +
+                               schema.GetOffset(tile_column_itr);
+        char *varlen_ptr =
+            type::Value::GetDataFromStorage(type_id, field_location);
+        if (varlen_ptr != nullptr) {
+          tile->GetPool()->Free(varlen_ptr);
+        }
+      }
+    }
+
+    released_size += tile->GetAllocatedTupleCount() * schema.GetLength();
+    tile->ReleaseData();
+  }
+
+  LOG_TRACE("Released %lu bytes of frozen tile group %u", released_size,
+            tile_group_id);
+
+  return released_size;
+}
+
+void TileGroup::Materialize() const {
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+  if (is_released_ == true) {
+    MaterializeTiles();
+  }
+}
+
+void TileGroup::MaterializeTiles() const {
+  auto compressed_tile_group = GetCompressedTileGroup();
+  PL_ASSERT(compressed_tile_group != nullptr);
+
+  std::vector<bool> is_released(tile_count, false);
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    Tile *tile = tiles[tile_itr].get();
+    if (tile->IsDataReleased() == true) {
+      is_released[tile_itr] = true;
+      tile->AllocateData();
+    }
+  }
+
+  // Reclaimed slots hold no value, their varlen values are freed already
+  auto tuple_count = compressed_tile_group->GetTupleCount();
+  for (auto &entry : column_map) {
+    auto tile_offset = entry.second.first;
+    if (is_released[tile_offset] == false) {
+      continue;
+    }
+
+    Tile *tile = tiles[tile_offset].get();
+    auto column = compressed_tile_group->GetColumn(entry.first);
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      if (tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+        continue;
+      }
+      tile->SetValue(column->GetValue(tuple_itr), tuple_itr,
+                     entry.second.second);
+    }
+  }
+
+  is_released_ = false;
+
+  LOG_TRACE("Re-materialized tile group %u", tile_group_id);
+}
+
+std::shared_ptr<const CompressedTileGroup> TileGroup::GetCompressedTileGroup()
+    const {
+  return std::atomic_load(&compressed_tile_group_);
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -0,0 +1,215 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.cpp
+//
+// Identification: src/storage/tile_group_freezer.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/tile_group_freezer.h"
+
+#include <algorithm>
+
+#include "common/logger.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "storage/compressed_column.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+TileGroupFreezer &TileGroupFreezer::GetInstance() {
+  static TileGroupFreezer tile_group_freezer;
+  return tile_group_freezer;
+}
+
+TileGroupFreezer::TileGroupFreezer()
+    : freezer_stop_(true),
+      frozen_tile_group_count_(0),
+      uncompressed_size_(0),
+      compressed_size_(0),
+      released_size_(0) {}
+
+TileGroupFreezer::~TileGroupFreezer() {}
+
+void TileGroupFreezer::Start() {
+  // Set signal
+  freezer_stop_ = false;
+
+  // Launch thread
+  freezer_thread_ = std::thread(&storage::TileGroupFreezer::Freeze, this);
+
+  LOG_INFO("Started tile group freezer");
+}
+
+void TileGroupFreezer::Stop() {
+  // Stop freezing
+  freezer_stop_ = true;
+
+  // Stop thread
+  freezer_thread_.join();
+
+  LOG_INFO("Stopped tile group freezer");
+  LOG_INFO("Frozen tile groups : %lu, compressed columns : %lu -> %lu bytes, "
+           "released tiles : %lu bytes",
+           frozen_tile_group_count_.load(), uncompressed_size_.load(),
+           compressed_size_.load(), released_size_.load());
+}
+
+void TileGroupFreezer::AddTable(DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    LOG_TRACE("Tile group freezer adding table : %p", table);
+
+    tables_.push_back(table);
+  }
+}
+
+void TileGroupFreezer::RemoveTable(DataTable *table) {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    LOG_TRACE("Tile group freezer removing table : %p", table);
+
+    tables_.erase(std::remove(tables_.begin(), tables_.end(), table),
+                  tables_.end());
+  }
+}
+
+void TileGroupFreezer::ClearTables() {
+  {
+    std::lock_guard<std::mutex> lock(freezer_mutex_);
+    tables_.clear();
+  }
+}
+
+bool TileGroupFreezer::IsFreezable(TileGroup *tile_group,
+                                   const cid_t expired_cid) {
+  auto tile_group_header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+
+  // Tile groups that still hand out new slots are not cold
+  if (tile_group->GetNextTupleSlot() < tuple_count) {
+    return false;
+  }
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    // Every version must be committed, and older than every active
+    // transaction. Empty (reclaimed or aborted) slots hold no version, and
+    // the tile group is thawed before one of them is reused.
+    auto txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (txn_id == INVALID_TXN_ID) {
+      continue;
+    }
+    if (txn_id != INITIAL_TXN_ID) {
+      return false;
+    }
+    if (tile_group_header->GetBeginCommitId(tuple_id) > expired_cid) {
+      return false;
+    }
+    auto end_cid = tile_group_header->GetEndCommitId(tuple_id);
+    if (end_cid != MAX_CID && end_cid > expired_cid) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+oid_t TileGroupFreezer::FreezeTable(DataTable *table,
+                                    const cid_t expired_cid) {
+  oid_t frozen_count = 0;
+  auto tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    // Freezing records an access by itself
+    auto tile_group = table->InspectTileGroup(tile_group_offset);
+    if (tile_group == nullptr || tile_group->IsFrozen()) {
+      continue;
+    }
+
+    if (IsFreezable(tile_group.get(), expired_cid) == false) {
+      continue;
+    }
+
+    tile_group->Freeze();
+
+    // A slot may have been claimed while the compressed copy was built.
+    // Pairs with the fence of the inserting transaction, which thaws the tile
+    // group if it sees it frozen.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (IsFreezable(tile_group.get(), expired_cid) == false) {
+      tile_group->Thaw();
+      continue;
+    }
+
+    auto compressed_tile_group = tile_group->GetCompressedTileGroup();
+    if (compressed_tile_group != nullptr) {
+      uncompressed_size_ += compressed_tile_group->GetUncompressedSize();
+      compressed_size_ += compressed_tile_group->GetCompressedSize();
+    }
+
+    frozen_tile_group_count_++;
+    frozen_count++;
+  }
+
+  return frozen_count;
+}
+
+size_t TileGroupFreezer::ReleaseTable(DataTable *table,
+                                      const eid_t expired_eid) {
+  size_t released_size = 0;
+  auto tile_group_count = table->GetTileGroupCount();
+
+  for (oid_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->InspectTileGroup(tile_group_offset);
+    if (tile_group == nullptr || tile_group->IsFrozen() == false ||
+        tile_group->IsReleased() == true) {
+      continue;
+    }
+
+    released_size += tile_group->ReleaseTiles(expired_eid);
+  }
+
+  released_size_ += released_size;
+  return released_size;
+}
+
+void TileGroupFreezer::Freeze() {
+  // Continue till signal is not false
+  while (freezer_stop_ == false) {
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    auto expired_eid = epoch_manager.GetExpiredEpochId();
+    auto expired_cid = epoch_manager.GetExpiredCid();
+
+    {
+      std::lock_guard<std::mutex> lock(freezer_mutex_);
+      for (auto table : tables_) {
+        // Tile groups frozen in this round are released in a later one
+        if (expired_eid != MAX_EID) {
+          UNUSED_ATTRIBUTE auto released_size =
+              ReleaseTable(table, expired_eid);
+          LOG_TRACE("Released %lu bytes of table %s", released_size,
+                    table->GetName().c_str());
+        }
+
+        UNUSED_ATTRIBUTE auto frozen_count = FreezeTable(table, expired_cid);
+        LOG_TRACE("Froze %u tile groups of table %s", frozen_count,
+                  table->GetName().c_str());
+      }
+    }
+
+    // Sleep a bit
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_duration_));
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
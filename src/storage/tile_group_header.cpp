@@ -23,14 +23,16 @@
 #include "gc/gc_manager.h"
 #include "logging/log_manager.h"
 #include "storage/backend_manager.h"
+#include "storage/delta_record.h"
 #include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace storage {
 
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count, const int numa_node)
     : backend_type(backend_type),
+      numa_node(numa_node),
       tile_group(nullptr),
       data(nullptr),
       num_tuple_slots(tuple_count),
@@ -42,7 +44,13 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
   // auto &storage_manager = storage::StorageManager::GetInstance();
   // data = reinterpret_cast<char *>(
   // storage_manager.Allocate(backend_type, header_size));
-  data = new char[header_size];
+  if (numa_node == NUMA_NODE_ANY) {
+    data = new char[header_size];
+  } else {
+    auto &backend_manager = storage::BackendManager::GetInstance();
+    data = reinterpret_cast<char *>(
+        backend_manager.Allocate(backend_type, header_size, numa_node));
+  }
   PL_ASSERT(data != nullptr);
 
   // zero out the data
@@ -60,13 +68,35 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
 }
 
 TileGroupHeader::~TileGroupHeader() {
+  // free the delta records that the GC has not folded yet
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+       tuple_slot_id++) {
+    FreeDeltaRecords(tuple_slot_id);
+  }
+
   // reclaim the space
   // auto &storage_manager = storage::StorageManager::GetInstance();
   // storage_manager.Release(backend_type, data);
-  delete[] data;
+  if (numa_node == NUMA_NODE_ANY) {
+    delete[] data;
+  } else {
+    auto &backend_manager = storage::BackendManager::GetInstance();
+    backend_manager.Release(backend_type, data, header_size, numa_node);
+  }
   data = nullptr;
 }
 
+void TileGroupHeader::FreeDeltaRecords(const oid_t &tuple_slot_id) {
+  DeltaRecord *delta_record = GetDeltaRecord(tuple_slot_id);
+  SetDeltaRecord(tuple_slot_id, nullptr);
+
+  while (delta_record != nullptr) {
+    DeltaRecord *next_record = delta_record->next;
+    delete delta_record;
+    delta_record = next_record;
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Tile Group Header
 //===--------------------------------------------------------------------===//
@@ -25,10 +25,12 @@
 #include "common/exception.h"
 #include "expression/aggregate_expression.h"
 #include "expression/expression_util.h"
+#include "parser/explain_statement.h"
 #include "parser/select_statement.h"
 
 #include "catalog/catalog.h"
 #include "executor/plan_executor.h"
+#include "executor/query_profile.h"
 #include "optimizer/optimizer.h"
 #include "planner/plan_util.h"
 
@@ -196,6 +198,10 @@ ResultType TrafficCop::ExecuteStatement(
       case QueryType::QUERY_ROLLBACK:
         return AbortQueryHelper();
       default:
+        if (statement->IsExplain()) {
+          return ExecuteExplain(statement, params, result, rows_changed,
+                                thread_id);
+        }
         auto status =
             ExecuteStatementPlan(statement->GetPlanTree().get(), params, result,
                                  result_format, thread_id);
@@ -210,10 +216,41 @@ ResultType TrafficCop::ExecuteStatement(
   }
 }
 
+ResultType TrafficCop::ExecuteExplain(
+    const std::shared_ptr<Statement> &statement,
+    const std::vector<type::Value> &params,
+    std::vector<StatementResult> &result, int &rows_changed,
+    const size_t thread_id) {
+  auto plan = statement->GetPlanTree().get();
+  executor::QueryProfile profile(plan, statement->GetExplainHardwareCounters());
+
+  if (statement->IsExplainAnalyze()) {
+    // Run the explained statement, its results are discarded
+    std::vector<StatementResult> query_result;
+    std::vector<int> result_format(
+        statement->GetExplainedTupleDescriptor().size(), 0);
+    auto status = ExecuteStatementPlan(plan, params, query_result,
+                                       result_format, thread_id, &profile);
+    if (status.m_result != ResultType::SUCCESS) {
+      return status.m_result;
+    }
+  }
+
+  // One QUERY PLAN row per line of the report
+  result.clear();
+  for (auto &line : profile.GetReport(statement->IsExplainAnalyze())) {
+    auto res = StatementResult();
+    executor::PlanExecutor::copyFromTo(line, res.second);
+    result.push_back(std::move(res));
+  }
+  rows_changed = 0;
+  return ResultType::SUCCESS;
+}
+
 executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
     std::vector<StatementResult> &result, const std::vector<int> &result_format,
-    const size_t thread_id) {
+    const size_t thread_id, executor::QueryProfile *profile) {
   concurrency::Transaction *txn;
   bool single_statement_txn = false, init_failure = false;
   executor::ExecuteResult p_status;
@@ -224,7 +261,12 @@ executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     // new txn, reset result status
     curr_state.second = ResultType::SUCCESS;
-    txn = txn_manager.BeginTransaction(thread_id);
+    if (FLAGS_read_only_snapshot && planner::PlanUtil::IsReadOnly(plan)) {
+      txn = txn_manager.BeginTransaction(thread_id,
+                                         IsolationLevelType::READ_ONLY);
+    } else {
+      txn = txn_manager.BeginTransaction(thread_id);
+    }
     single_statement_txn = true;
   } else {
     // get ptr to current active txn
@@ -234,8 +276,19 @@ executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
   // skip if already aborted
   if (curr_state.second != ResultType::ABORTED) {
     PL_ASSERT(txn);
-    p_status = executor::PlanExecutor::ExecutePlan(plan, txn, params, result,
-                                                   result_format);
+    try {
+      p_status = executor::PlanExecutor::ExecutePlan(plan, txn, params, result,
+                                                     result_format, profile);
+    } catch (Exception &e) {
+      // Don't leave the transaction of the failed statement open
+      auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+      if (single_statement_txn == true) {
+        txn_manager.AbortTransaction(txn);
+      } else {
+        txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      }
+      throw;
+    }
 
     if (p_status.m_result == ResultType::FAILURE) {
       // only possible if init failed
@@ -287,6 +340,30 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     if (sql_stmt->is_valid == false) {
       throw ParserException("Error parsing SQL statement");
     }
+
+    // EXPLAIN plans the statement it explains, and returns a single text
+    // column
+    if (sql_stmt->GetNumStatements() > 0 &&
+        sql_stmt->GetStatement(0)->GetType() == StatementType::EXPLAIN) {
+      auto explain_stmt =
+          static_cast<parser::ExplainStatement *>(sql_stmt->GetStatement(0));
+      if (explain_stmt->real_sql_stmt == nullptr) {
+        throw ParserException("Error parsing EXPLAIN statement");
+      }
+      statement->SetExplain(explain_stmt->analyze,
+                            explain_stmt->hardware_counters);
+      statement->SetExplainedTupleDescriptor(
+          GenerateTupleDescriptor(explain_stmt->real_sql_stmt));
+      statement->SetTupleDescriptor({GetColumnFieldForValueType(
+          "QUERY PLAN", type::TypeId::VARCHAR)});
+
+      // The explained statement is now owned by its own list
+      std::unique_ptr<parser::SQLStatementList> explained_stmt(
+          new parser::SQLStatementList(explain_stmt->real_sql_stmt));
+      explain_stmt->real_sql_stmt = nullptr;
+      sql_stmt = std::move(explained_stmt);
+    }
+
     auto plan = optimizer_->BuildPelotonPlanTree(sql_stmt);
     statement->SetPlanTree(plan);
 
@@ -298,7 +375,8 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
 
     for (auto stmt : sql_stmt->GetStatements()) {
       LOG_TRACE("SQLStatement: %s", stmt->GetInfo().c_str());
-      if (stmt->GetType() == StatementType::SELECT) {
+      if (stmt->GetType() == StatementType::SELECT &&
+          statement->IsExplain() == false) {
         auto tuple_descriptor = GenerateTupleDescriptor(stmt);
         statement->SetTupleDescriptor(tuple_descriptor);
       }
@@ -34,6 +34,8 @@ int TEST_TUPLES_PER_TILEGROUP = 5;
 
 // For threads
 size_t CONNECTION_THREAD_COUNT = 1;
+// 0 runs queries on the connection threads
+size_t EXECUTION_THREAD_COUNT = 0;
 size_t LOGGING_THREAD_COUNT = 1;
 size_t GC_THREAD_COUNT = 1;
 size_t EPOCH_THREAD_COUNT = 1;
@@ -205,6 +207,61 @@ std::ostream& operator<<(std::ostream& os, const BackendType& type) {
   return os;
 }
 
+//===--------------------------------------------------------------------===//
+// ColumnEncodingType <--> String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string ColumnEncodingTypeToString(ColumnEncodingType type) {
+  switch (type) {
+    case ColumnEncodingType::INVALID: {
+      return "INVALID";
+    }
+    case ColumnEncodingType::UNCOMPRESSED: {
+      return "UNCOMPRESSED";
+    }
+    case ColumnEncodingType::DICTIONARY: {
+      return "DICTIONARY";
+    }
+    case ColumnEncodingType::FRAME_OF_REFERENCE: {
+      return "FRAME_OF_REFERENCE";
+    }
+    case ColumnEncodingType::RUN_LENGTH: {
+      return "RUN_LENGTH";
+    }
+    default: {
+      throw ConversionException(StringUtil::Format(
+          "No string conversion for ColumnEncodingType value '%d'",
+          static_cast<int>(type)));
+    }
+  }
+  return "INVALID";
+}
+
+ColumnEncodingType StringToColumnEncodingType(const std::string& str) {
+  std::string upper_str = StringUtil::Upper(str);
+  if (upper_str == "INVALID") {
+    return ColumnEncodingType::INVALID;
+  } else if (upper_str == "UNCOMPRESSED") {
+    return ColumnEncodingType::UNCOMPRESSED;
+  } else if (upper_str == "DICTIONARY") {
+    return ColumnEncodingType::DICTIONARY;
+  } else if (upper_str == "FRAME_OF_REFERENCE") {
+    return ColumnEncodingType::FRAME_OF_REFERENCE;
+  } else if (upper_str == "RUN_LENGTH") {
+    return ColumnEncodingType::RUN_LENGTH;
+  } else {
+    throw ConversionException(StringUtil::Format(
+        "No ColumnEncodingType conversion from string '%s'",
+        upper_str.c_str()));
+  }
+  return ColumnEncodingType::INVALID;
+}
+
+std::ostream& operator<<(std::ostream& os, const ColumnEncodingType& type) {
+  os << ColumnEncodingTypeToString(type);
+  return os;
+}
+
 //===--------------------------------------------------------------------===//
 // Value <--> String Utilities
 //===--------------------------------------------------------------------===//
@@ -366,6 +423,9 @@ std::string StatementTypeToString(StatementType type) {
     case StatementType::ANALYZE: {
       return "ANALYZE";
     }
+    case StatementType::EXPLAIN: {
+      return "EXPLAIN";
+    }
     default: {
       throw ConversionException(StringUtil::Format(
           "No string conversion for StatementType value '%d'",
@@ -403,6 +463,10 @@ StatementType StringToStatementType(const std::string& str) {
     return StatementType::TRANSACTION;
   } else if (upper_str == "COPY") {
     return StatementType::COPY;
+  } else if (upper_str == "ANALYZE") {
+    return StatementType::ANALYZE;
+  } else if (upper_str == "EXPLAIN") {
+    return StatementType::EXPLAIN;
   } else {
     throw ConversionException(StringUtil::Format(
         "No StatementType conversion from string '%s'", upper_str.c_str()));
@@ -1253,6 +1317,9 @@ std::string JoinTypeToString(JoinType type) {
     case JoinType::SEMI: {
       return "SEMI";
     }
+    case JoinType::ANTI: {
+      return "ANTI";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for JoinType value '%d'",
@@ -1276,6 +1343,8 @@ JoinType StringToJoinType(const std::string& str) {
     return JoinType::OUTER;
   } else if (upper_str == "SEMI") {
     return JoinType::SEMI;
+  } else if (upper_str == "ANTI") {
+    return JoinType::ANTI;
   } else {
     throw ConversionException(StringUtil::Format(
         "No JoinType conversion from string '%s'", upper_str.c_str()));
@@ -1777,6 +1846,9 @@ std::string ProtocolTypeToString(ProtocolType type) {
     case ProtocolType::TIMESTAMP_ORDERING: {
       return "TIMESTAMP_ORDERING";
     }
+    case ProtocolType::OPTIMISTIC: {
+      return "OPTIMISTIC";
+    }
     default: {
       throw ConversionException(
           StringUtil::Format("No string conversion for ProtocolType value '%d'",
@@ -1792,6 +1864,8 @@ ProtocolType StringToProtocolType(const std::string &str) {
     return ProtocolType::INVALID;
   } else if (upper_str == "TIMESTAMP_ORDERING") {
     return ProtocolType::TIMESTAMP_ORDERING;
+  } else if (upper_str == "OPTIMISTIC") {
+    return ProtocolType::OPTIMISTIC;
   } else {
     throw ConversionException(StringUtil::Format(
         "No ProtocolType conversion from string '%s'", upper_str.c_str()));
@@ -58,6 +58,25 @@ void WorkerHandleNewConn(evutil_socket_t new_conn_recv_fd,
       break;
     }
 
+    /* queries executed case */
+    case 'e': {
+      // fetch the executed connection from the queue
+      LibeventSocket *executed_conn = nullptr;
+      thread->executed_conn_queue.Dequeue(executed_conn);
+      PL_ASSERT(executed_conn != nullptr);
+      PL_ASSERT(executed_conn->state == CONN_EXECUTING);
+
+      if (executed_conn->process_status == false) {
+        // packet processing can't proceed further
+        executed_conn->TransitState(CONN_CLOSING);
+      } else {
+        // We should have responses ready to send
+        executed_conn->TransitState(CONN_WRITE);
+      }
+      StateMachine(executed_conn);
+      break;
+    }
+
     default:
       LOG_ERROR("Unexpected message. Shouldn't reach here");
   }
@@ -179,6 +198,16 @@ void StateMachine(LibeventSocket *conn) {
           else if (status_res == -1){
             conn->pkt_manager.ssl_sent = true;
           }
+        } else if (IsExecutionMessage(conn->rpkt.msg_type) &&
+                   static_cast<LibeventWorkerThread *>(conn->thread)
+                       ->HasExecutionPool()) {
+          // Don't block the other connections of this thread while the
+          // query runs. The state machine is resumed by WorkerHandleNewConn
+          conn->TransitState(CONN_EXECUTING);
+          static_cast<LibeventWorkerThread *>(conn->thread)
+              ->SubmitExecution(conn);
+          done = true;
+          break;
         } else {
           // Process all other packets
           status = conn->pkt_manager.ProcessPacket(&conn->rpkt,
@@ -201,7 +230,12 @@ void StateMachine(LibeventSocket *conn) {
           case WRITE_COMPLETE: {
             // Input Packet can now be reset, before we parse the next packet
             conn->rpkt.Reset();
-            conn->UpdateEvent(EV_READ | EV_PERSIST);
+            // Only re-register the event when we're not listening for reads
+            // (after an execution or a partial write), so that pipelined
+            // packets don't pay for an event update each
+            if (event_pending(conn->event, EV_READ, nullptr) == 0) {
+              conn->UpdateEvent(EV_READ | EV_PERSIST);
+            }
             conn->TransitState(CONN_PROCESS);
             break;
           }
@@ -222,6 +256,12 @@ void StateMachine(LibeventSocket *conn) {
         break;
       }
 
+      case CONN_EXECUTING: {
+        // The connection is owned by the execution pool
+        done = true;
+        break;
+      }
+
       case CONN_CLOSING: {
         conn->CloseSocket();
         done = true;
@@ -241,6 +281,27 @@ void StateMachine(LibeventSocket *conn) {
   }
 }
 
+void ExecutionTask(LibeventSocket *conn) {
+  while (true) {
+    conn->process_status = conn->pkt_manager.ProcessPacket(
+        &conn->rpkt, (size_t)conn->thread_id);
+
+    // Stop once responses must be flushed (Sync or simple query), or when
+    // the next packet has not been fully received yet
+    if (conn->process_status == false || conn->pkt_manager.force_flush ||
+        conn->IsPacketBuffered() == false) {
+      break;
+    }
+
+    // Process the next pipelined packet without going through the worker
+    conn->rpkt.Reset();
+    conn->ReadPacketHeader();
+    conn->ReadPacket();
+  }
+
+  static_cast<LibeventWorkerThread *>(conn->thread)->NotifyExecutionDone(conn);
+}
+
 /**
  * Stop signal handling
  */
@@ -170,6 +170,28 @@ bool LibeventSocket::ReadPacket() {
   return true;
 }
 
+// Checks whether the next (regular) packet can be read without waiting for
+// more data. Only valid once the startup packet has been processed.
+bool LibeventSocket::IsPacketBuffered() {
+  // msg type + packet size
+  size_t header_size = 1 + sizeof(int32_t);
+  if (IsReadDataAvailable(header_size) == false) {
+    return false;
+  }
+
+  size_t len = 0;
+  for (size_t i = rbuf_.buf_ptr + 1; i < rbuf_.buf_ptr + header_size; i++) {
+    len = (len << 8) | rbuf_.GetByte(i);
+  }
+  len = len - sizeof(int32_t);
+
+  // extended packets are assembled by the connection thread
+  if (len > rbuf_.GetMaxSize()) {
+    return false;
+  }
+  return IsReadDataAvailable(header_size + len);
+}
+
 /**
  * Public Functions
  */
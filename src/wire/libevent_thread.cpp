@@ -15,6 +15,7 @@
 #include <vector>
 #include "boost/thread/future.hpp"
 #include "common/init.h"
+#include "common/numa.h"
 #include "common/thread_pool.h"
 #include "wire/libevent_server.h"
 #include "concurrency/epoch_manager_factory.h"
@@ -39,7 +40,8 @@ LibeventMasterThread::LibeventMasterThread(const int num_threads,
                                            struct event_base *libevent_base)
     : LibeventThread(MASTER_THREAD_ID, libevent_base),
       num_threads_(num_threads),
-      next_thread_id_(0) {
+      next_thread_id_(0),
+      num_execution_threads_(EXECUTION_THREAD_COUNT) {
   auto &threads = GetWorkerThreads();
   threads.clear();
 
@@ -51,10 +53,18 @@ LibeventMasterThread::LibeventMasterThread(const int num_threads,
     }
   }
 
+  // start the execution pool, so that long queries don't block the other
+  // connections of a worker thread
+  ThreadPool *execution_pool = nullptr;
+  if (num_execution_threads_ > 0) {
+    execution_pool_.Initialize(num_execution_threads_, 0);
+    execution_pool = &execution_pool_;
+  }
+
   // create worker threads.
   for (int thread_id = 0; thread_id < num_threads; thread_id++) {
     threads.push_back(std::shared_ptr<LibeventWorkerThread>(
-        new LibeventWorkerThread(thread_id)));
+        new LibeventWorkerThread(thread_id, execution_pool)));
     thread_pool.SubmitDedicatedTask(LibeventMasterThread::StartWorker,
                                     threads[thread_id].get());
   }
@@ -71,6 +81,8 @@ LibeventMasterThread::LibeventMasterThread(const int num_threads,
  * Start with worker event loop
  */
 void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
+  NumaTopology::GetInstance().PinThread(worker_thread->GetThreadID());
+
   event_base_loop(worker_thread->GetEventBase(), 0);
   // Set worker thread's close flag to false to indicate loop has exited
   worker_thread->SetThreadIsClosed(false);
@@ -89,8 +101,12 @@ void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
 * The worker thread creates a pipe for master-worker communication on
 * constructor.
 */
-LibeventWorkerThread::LibeventWorkerThread(const int thread_id)
-    : LibeventThread(thread_id, event_base_new()), new_conn_queue(QUEUE_SIZE) {
+LibeventWorkerThread::LibeventWorkerThread(const int thread_id,
+                                           ThreadPool *execution_pool)
+    : LibeventThread(thread_id, event_base_new()),
+      execution_pool_(execution_pool),
+      new_conn_queue(QUEUE_SIZE),
+      executed_conn_queue(QUEUE_SIZE) {
   int fds[2];
   if (pipe(fds)) {
     LOG_ERROR("Can't create notify pipe to accept connections");
@@ -117,6 +133,33 @@ LibeventWorkerThread::LibeventWorkerThread(const int thread_id)
   }
 }
 
+/*
+ * Run the connection's current packet on the execution pool. The worker
+ * stops listening on the socket, so that the connection is owned by the pool
+ * until it calls NotifyExecutionDone.
+ */
+void LibeventWorkerThread::SubmitExecution(LibeventSocket *conn) {
+  PL_ASSERT(execution_pool_ != nullptr);
+  if (event_del(conn->event) == -1) {
+    LOG_ERROR("Failed to delete event");
+  }
+  execution_pool_->SubmitTask([conn] { ExecutionTask(conn); });
+}
+
+/*
+ * Hand the executed connection back to the worker thread through the
+ * notification pipe
+ */
+void LibeventWorkerThread::NotifyExecutionDone(LibeventSocket *conn) {
+  char buf[1];
+  buf[0] = 'e';
+  executed_conn_queue.Enqueue(conn);
+
+  if (write(GetNewConnSendFd(), buf, 1) != 1) {
+    LOG_ERROR("Failed to write to thread notify pipe");
+  }
+}
+
 /*
 * Dispatch a new connection event to a random worker thread by
 * writing to the worker's pipe
@@ -151,6 +194,11 @@ void LibeventMasterThread::DispatchConnection(int new_conn_fd,
 void LibeventMasterThread::CloseConnection() {
   auto &threads = GetWorkerThreads();
 
+  // Wait for the running queries first
+  if (num_execution_threads_ > 0) {
+    execution_pool_.Shutdown();
+  }
+
   for (int thread_id = 0; thread_id < num_threads_; thread_id++) {
     threads[thread_id].get()->SetThreadIsClosed(true);
   }
@@ -19,9 +19,11 @@
 #include "common/macros.h"
 #include "common/portal.h"
 #include "planner/abstract_plan.h"
+#include "planner/copy_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/update_plan.h"
+#include "storage/data_table.h"
 #include "tcop/tcop.h"
 #include "type/types.h"
 #include "type/value.h"
@@ -452,6 +454,43 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
         }
       	break;
       }
+      case QueryType::QUERY_COPY:
+      {
+        std::string unnamed_statement = "unnamed";
+        auto statement = traffic_cop_->PrepareStatement(
+            unnamed_statement, query, error_message);
+        if (statement.get() == nullptr) {
+          SendErrorResponse(
+              {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+          SendReadyForQuery(NetworkTransactionStateType::IDLE);
+          return;
+        }
+
+        // COPY FROM STDIN runs once the client has sent the data
+        auto copy_plan =
+            static_cast<planner::CopyPlan *>(statement->GetPlanTree().get());
+        if (copy_plan->IsFromStdin()) {
+          copy_in_statement_ = statement;
+          copy_in_data_.clear();
+          SendCopyInResponse(
+              copy_plan->target_table->GetSchema()->GetColumnCount());
+          return;
+        }
+
+        bool unnamed = true;
+        std::vector<type::Value> param_values;
+        std::vector<int> result_format;
+        auto status = traffic_cop_->ExecuteStatement(
+            statement, param_values, unnamed, nullptr, result_format, result,
+            rows_affected, error_message, thread_id);
+        if (status != ResultType::SUCCESS) {
+          SendErrorResponse(
+              {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+          SendReadyForQuery(NetworkTransactionStateType::IDLE);
+          return;
+        }
+        break;
+      }
       default:
       {
         // execute the query using tcop
@@ -1018,6 +1057,88 @@ void PacketManager::ExecCloseMessage(InputPacket *pkt) {
   responses.push_back(std::move(response));
 }
 
+/*
+ * SendCopyInResponse - Tells the client to send the data of COPY FROM STDIN,
+ *  as text rows of column_count columns
+ */
+void PacketManager::SendCopyInResponse(int column_count) {
+  std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+  pkt->msg_type = NetworkMessageType::COPY_IN_RESPONSE;
+
+  // Overall and per column format: textual
+  PacketPutByte(pkt.get(), 0);
+  PacketPutInt(pkt.get(), column_count, 2);
+  for (int column_itr = 0; column_itr < column_count; column_itr++) {
+    PacketPutInt(pkt.get(), 0, 2);
+  }
+  responses.push_back(std::move(pkt));
+}
+
+/*
+ * ExecCopyDataMessage - Buffers the data of COPY FROM STDIN. The rows may be
+ *  split across messages in any way, so they are only parsed at the end.
+ */
+void PacketManager::ExecCopyDataMessage(InputPacket *pkt) {
+  if (copy_in_statement_.get() == nullptr) {
+    LOG_ERROR("CopyData without COPY FROM STDIN");
+    return;
+  }
+  copy_in_data_.append(pkt->Begin() + pkt->ptr, pkt->End());
+  pkt->ptr = pkt->len;
+}
+
+/*
+ * ExecCopyDoneMessage - Loads the data of COPY FROM STDIN
+ */
+void PacketManager::ExecCopyDoneMessage(const size_t thread_id) {
+  if (copy_in_statement_.get() == nullptr) {
+    LOG_ERROR("CopyDone without COPY FROM STDIN");
+    return;
+  }
+  auto statement = std::move(copy_in_statement_);
+
+  auto copy_plan =
+      static_cast<planner::CopyPlan *>(statement->GetPlanTree().get());
+  copy_plan->SetInputData(std::move(copy_in_data_));
+  copy_in_data_.clear();
+
+  std::vector<StatementResult> result;
+  std::vector<type::Value> param_values;
+  std::vector<int> result_format;
+  std::string error_message;
+  int rows_affected = 0;
+  bool unnamed = true;
+  auto status = traffic_cop_->ExecuteStatement(
+      statement, param_values, unnamed, nullptr, result_format, result,
+      rows_affected, error_message, thread_id);
+
+  // Release the data
+  copy_plan->SetInputData(std::string());
+
+  if (status == ResultType::SUCCESS) {
+    CompleteCommand(statement->GetQueryString(), QueryType::QUERY_COPY,
+                    rows_affected);
+  } else {
+    SendErrorResponse(
+        {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+  }
+  SendReadyForQuery(NetworkTransactionStateType::IDLE);
+}
+
+/*
+ * ExecCopyFailMessage - The client aborted COPY FROM STDIN
+ */
+void PacketManager::ExecCopyFailMessage(InputPacket *pkt) {
+  std::string error_message;
+  GetStringToken(pkt, error_message);
+  copy_in_statement_.reset();
+  copy_in_data_.clear();
+
+  SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                      "COPY FROM STDIN failed: " + error_message}});
+  SendReadyForQuery(NetworkTransactionStateType::IDLE);
+}
+
 /*
  * process_packet - Main switch block; process incoming packets,
  *  Returns false if the session needs to be closed.
@@ -1058,6 +1179,20 @@ bool PacketManager::ProcessPacket(InputPacket *pkt, const size_t thread_id) {
       LOG_TRACE("CLOSE_COMMAND");
       ExecCloseMessage(pkt);
     } break;
+    case NetworkMessageType::COPY_DATA_COMMAND: {
+      LOG_TRACE("COPY_DATA_COMMAND");
+      ExecCopyDataMessage(pkt);
+    } break;
+    case NetworkMessageType::COPY_DONE_COMMAND: {
+      LOG_TRACE("COPY_DONE_COMMAND");
+      ExecCopyDoneMessage(thread_id);
+      force_flush = true;
+    } break;
+    case NetworkMessageType::COPY_FAIL_COMMAND: {
+      LOG_TRACE("COPY_FAIL_COMMAND");
+      ExecCopyFailMessage(pkt);
+      force_flush = true;
+    } break;
     case NetworkMessageType::TERMINATE_COMMAND: {
       LOG_TRACE("TERMINATE_COMMAND");
       force_flush = true;
@@ -1122,6 +1257,8 @@ void PacketManager::Reset() {
   statement_cache_.clear();
   table_statement_cache_.clear();
   portals_.clear();
+  copy_in_statement_.reset();
+  copy_in_data_.clear();
   pkt_cntr_ = 0;
 
   traffic_cop_->Reset();
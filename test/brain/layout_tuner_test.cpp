@@ -24,6 +24,7 @@
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace test {
@@ -128,5 +129,164 @@ TEST_F(LayoutTunerTests, BasicTest) {
 
 }
 
+TEST_F(LayoutTunerTests, OnlineTransformTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP * 4;
+
+  // Create a table and populate it
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Remember the values and the full tile groups
+  oid_t column_count = data_table->GetSchema()->GetColumnCount();
+  oid_t tile_group_count = data_table->GetTileGroupCount();
+  std::vector<bool> is_full(tile_group_count, false);
+  std::vector<std::string> old_values;
+  for (oid_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = data_table->GetTileGroup(offset);
+    oid_t next_slot = tile_group->GetNextTupleSlot();
+    is_full[offset] = next_slot == tile_group->GetAllocatedTupleCount();
+    for (oid_t tuple_id = 0; tuple_id < next_slot; tuple_id++) {
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        old_values.push_back(
+            tile_group->GetValue(tuple_id, column_id).ToString());
+      }
+    }
+  }
+
+  // The first two full tile groups
+  std::vector<oid_t> full_offsets;
+  for (oid_t offset = 0; offset < tile_group_count; offset++) {
+    if (is_full[offset] == true) {
+      full_offsets.push_back(offset);
+    }
+  }
+  ASSERT_LE(2, (int)full_offsets.size());
+  oid_t locked_offset = full_offsets[0];
+  oid_t replaced_offset = full_offsets[1];
+
+  // Move the last column into a tile of its own
+  column_map_type layout;
+  layout[0] = std::make_pair(0, 0);
+  layout[1] = std::make_pair(0, 1);
+  layout[2] = std::make_pair(0, 2);
+  layout[3] = std::make_pair(1, 0);
+  data_table->SetDefaultLayout(layout);
+
+  // A transaction that holds a version keeps its tile group from being
+  // transformed
+  auto lock_txn = txn_manager.BeginTransaction();
+  auto locked_tile_group = data_table->GetTileGroup(locked_offset);
+  EXPECT_TRUE(txn_manager.AcquireOwnership(
+      lock_txn, locked_tile_group->GetHeader(), 0));
+
+  auto old_tile_group = data_table->GetTileGroup(replaced_offset);
+
+  brain::LayoutTuner &layout_tuner = brain::LayoutTuner::GetInstance();
+  auto transformed_count = layout_tuner.GetTransformedTileGroupCount();
+  while (layout_tuner.TransformTable(data_table.get(), MAX_CID) > 0) {
+  }
+
+  for (oid_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = data_table->GetTileGroup(offset);
+    bool is_transformed = tile_group->GetSchemaDifference(layout) == 0;
+    EXPECT_EQ(is_full[offset] && offset != locked_offset, is_transformed);
+  }
+
+  // The replaced tile group keeps its versions locked
+  auto new_tile_group = data_table->GetTileGroup(replaced_offset);
+  EXPECT_NE(old_tile_group.get(), new_tile_group.get());
+  EXPECT_EQ(old_tile_group->GetTileGroupId(),
+            new_tile_group->GetTileGroupId());
+  EXPECT_NE(INITIAL_TXN_ID, old_tile_group->GetHeader()->GetTransactionId(0));
+  EXPECT_EQ(INITIAL_TXN_ID, new_tile_group->GetHeader()->GetTransactionId(0));
+
+  // Once the version is released, its tile group is transformed as well
+  txn_manager.YieldOwnership(lock_txn, locked_tile_group->GetHeader(), 0);
+  txn_manager.AbortTransaction(lock_txn);
+  while (layout_tuner.TransformTable(data_table.get(), MAX_CID) > 0) {
+  }
+  EXPECT_EQ(
+      0, data_table->GetTileGroup(locked_offset)->GetSchemaDifference(layout));
+  EXPECT_EQ(transformed_count + full_offsets.size(),
+            layout_tuner.GetTransformedTileGroupCount());
+
+  // The transformed tile groups hold the same tuples
+  std::vector<std::string> new_values;
+  for (oid_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = data_table->GetTileGroup(offset);
+    oid_t next_slot = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < next_slot; tuple_id++) {
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        new_values.push_back(
+            tile_group->GetValue(tuple_id, column_id).ToString());
+      }
+    }
+  }
+  EXPECT_EQ(old_values, new_values);
+
+  layout_tuner.ClearTables();
+}
+
+TEST_F(LayoutTunerTests, EmptySlotTransformTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Create a table and populate it
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto old_tile_group = data_table->GetTileGroup(0);
+  auto old_header = old_tile_group->GetHeader();
+  ASSERT_EQ(old_tile_group->GetAllocatedTupleCount(),
+            old_tile_group->GetNextTupleSlot());
+  auto value = old_tile_group->GetValue(0, 0).ToString();
+
+  // A slot reclaimed by the garbage collector
+  old_header->SetTransactionId(1, INVALID_TXN_ID);
+  old_header->SetBeginCommitId(1, MAX_CID);
+  old_header->SetEndCommitId(1, MAX_CID);
+
+  // An older version of an updated tuple
+  auto end_cid = old_header->GetBeginCommitId(2) + 1;
+  old_header->SetEndCommitId(2, end_cid);
+
+  column_map_type layout;
+  layout[0] = std::make_pair(0, 0);
+  layout[1] = std::make_pair(0, 1);
+  layout[2] = std::make_pair(0, 2);
+  layout[3] = std::make_pair(1, 0);
+  data_table->SetDefaultLayout(layout);
+
+  // The older version is still read
+  brain::LayoutTuner &layout_tuner = brain::LayoutTuner::GetInstance();
+  EXPECT_EQ(0U, layout_tuner.TransformTable(data_table.get(), end_cid - 1));
+  EXPECT_EQ(old_tile_group.get(), data_table->GetTileGroup(0).get());
+
+  // Neither slot keeps the tile group from being transformed
+  EXPECT_EQ(1U, layout_tuner.TransformTable(data_table.get(), MAX_CID));
+  auto new_tile_group = data_table->GetTileGroup(0);
+  auto new_header = new_tile_group->GetHeader();
+  EXPECT_EQ(0, new_tile_group->GetSchemaDifference(layout));
+  EXPECT_EQ(value, new_tile_group->GetValue(0, 0).ToString());
+
+  // The claimed slots are released in the new tile group only
+  EXPECT_NE(INVALID_TXN_ID, old_header->GetTransactionId(1));
+  EXPECT_EQ(INVALID_TXN_ID, new_header->GetTransactionId(1));
+  EXPECT_NE(INITIAL_TXN_ID, old_header->GetTransactionId(2));
+  EXPECT_EQ(INITIAL_TXN_ID, new_header->GetTransactionId(2));
+  EXPECT_EQ(end_cid, new_header->GetEndCommitId(2));
+
+  layout_tuner.ClearTables();
+}
+
 }  // End test namespace
 }  // End peloton namespace
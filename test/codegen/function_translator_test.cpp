@@ -0,0 +1,258 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// function_translator_test.cpp
+//
+// Identification: test/codegen/function_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+
+#include "catalog/catalog.h"
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/comparison_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/function_expression.h"
+#include "planner/projection_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+typedef std::unique_ptr<expression::AbstractExpression> ExprPtr;
+
+class FunctionTranslatorTest : public PelotonCodeGenTest {
+ public:
+  FunctionTranslatorTest() : PelotonCodeGenTest() {
+    // Column d holds the strings "3", "13", "23", ..., "633"
+    LoadTestTable(TestTableId(), NumRowsInTestTable());
+  }
+
+  TableId TestTableId() { return TableId::_1; }
+
+  uint32_t NumRowsInTestTable() const { return 64; }
+
+  ExprPtr ConstVarcharExpr(const std::string &str) {
+    return ExprPtr{new expression::ConstantValueExpression(
+        type::ValueFactory::GetVarcharValue(str))};
+  }
+
+  // A call of the built-in function with the given name
+  ExprPtr FuncExpr(const std::string &name, std::vector<ExprPtr> &&args) {
+    std::vector<expression::AbstractExpression *> children;
+    for (auto &arg : args) {
+      children.push_back(arg.release());
+    }
+    auto *func = new expression::FunctionExpression(name.c_str(), children);
+    auto func_data = catalog::Catalog::GetInstance()->GetFunction(name);
+    func->SetFunctionExpressionParameters(
+        func_data.func_ptr_, func_data.return_type_, func_data.argument_types_);
+    return ExprPtr{func};
+  }
+
+  // The number of rows of the test table satisfying the predicate
+  size_t CountMatches(ExprPtr &&predicate) {
+    planner::SeqScanPlan scan{&GetTestTable(TestTableId()),
+                              predicate.release(), {0, 1, 2, 3}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0}, context};
+    CompileAndExecute(scan, buffer,
+                      reinterpret_cast<char *>(buffer.GetState()));
+    return buffer.GetOutputTuples().size();
+  }
+
+  // The values of the expression for every row of the test table
+  std::vector<type::Value> Project(ExprPtr &&exp) {
+    DirectMapList direct_map_list = {{0, {0, 0}}};
+    TargetList target_list;
+    planner::DerivedAttribute attribute{exp.release()};
+    target_list.emplace_back(1, attribute);
+    std::unique_ptr<planner::ProjectInfo> proj_info{new planner::ProjectInfo(
+        std::move(target_list), std::move(direct_map_list))};
+
+    std::unique_ptr<planner::SeqScanPlan> scan{new planner::SeqScanPlan(
+        &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3})};
+
+    std::shared_ptr<catalog::Schema> schema{
+        new catalog::Schema(*GetTestTable(TestTableId()).GetSchema())};
+    planner::ProjectionPlan projection{std::move(proj_info), schema};
+    projection.AddChild(std::move(scan));
+
+    planner::BindingContext context;
+    projection.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(projection, buffer,
+                      reinterpret_cast<char *>(buffer.GetState()));
+
+    std::vector<type::Value> values;
+    for (const auto &tuple : buffer.GetOutputTuples()) {
+      values.push_back(tuple.GetValue(1));
+    }
+    return values;
+  }
+};
+
+TEST_F(FunctionTranslatorTest, LikePrefixTest) {
+  //
+  // SELECT a FROM table WHERE d LIKE '1%';
+  //
+  // The pattern is compared inline
+  //
+
+  auto like = CmpExpr(ExpressionType::COMPARE_LIKE,
+                      ColRefExpr(type::TypeId::VARCHAR, 3),
+                      ConstVarcharExpr("1%"));
+
+  // "13" and "103" to "193"
+  EXPECT_EQ(11, CountMatches(std::move(like)));
+}
+
+TEST_F(FunctionTranslatorTest, LikeLiteralTest) {
+  //
+  // SELECT a FROM table WHERE d LIKE '13';
+  //
+
+  auto like = CmpExpr(ExpressionType::COMPARE_LIKE,
+                      ColRefExpr(type::TypeId::VARCHAR, 3),
+                      ConstVarcharExpr("13"));
+  EXPECT_EQ(1, CountMatches(std::move(like)));
+}
+
+TEST_F(FunctionTranslatorTest, LikePatternTest) {
+  //
+  // SELECT a FROM table WHERE d LIKE '_3' OR d LIKE '%33';
+  //
+  // The patterns are matched by the runtime
+  //
+
+  auto like = CmpExpr(ExpressionType::COMPARE_LIKE,
+                      ColRefExpr(type::TypeId::VARCHAR, 3),
+                      ConstVarcharExpr("_3"));
+  // "13" to "93"
+  EXPECT_EQ(9, CountMatches(std::move(like)));
+
+  like = CmpExpr(ExpressionType::COMPARE_LIKE,
+                 ColRefExpr(type::TypeId::VARCHAR, 3),
+                 ConstVarcharExpr("%33"));
+  // "33", "133", "233", ..., "633"
+  EXPECT_EQ(7, CountMatches(std::move(like)));
+}
+
+TEST_F(FunctionTranslatorTest, NotLikeTest) {
+  //
+  // SELECT a FROM table WHERE d NOT LIKE '1%';
+  //
+
+  auto not_like = CmpExpr(ExpressionType::COMPARE_NOTLIKE,
+                          ColRefExpr(type::TypeId::VARCHAR, 3),
+                          ConstVarcharExpr("1%"));
+  EXPECT_EQ(NumRowsInTestTable() - 11, CountMatches(std::move(not_like)));
+}
+
+TEST_F(FunctionTranslatorTest, SubstrTest) {
+  //
+  // SELECT a FROM table WHERE SUBSTR(d, 2, 1) = '3';
+  //
+
+  std::vector<ExprPtr> args;
+  args.push_back(ColRefExpr(type::TypeId::VARCHAR, 3));
+  args.push_back(ConstIntExpr(2));
+  args.push_back(ConstIntExpr(1));
+  auto substr_eq_3 =
+      CmpEqExpr(FuncExpr("substr", std::move(args)), ConstVarcharExpr("3"));
+
+  // "13" to "93", and "133", "233", ..., "633"
+  EXPECT_EQ(15, CountMatches(std::move(substr_eq_3)));
+}
+
+TEST_F(FunctionTranslatorTest, SubstrProjectionTest) {
+  //
+  // SELECT a, SUBSTR(d, 0, 3) FROM table;
+  //
+  // The substring starts before the string, so at most two characters remain
+  //
+
+  std::vector<ExprPtr> args;
+  args.push_back(ColRefExpr(type::TypeId::VARCHAR, 3));
+  args.push_back(ConstIntExpr(0));
+  args.push_back(ConstIntExpr(3));
+  auto values = Project(FuncExpr("substr", std::move(args)));
+
+  ASSERT_EQ(NumRowsInTestTable(), values.size());
+  for (uint32_t i = 0; i < values.size(); i++) {
+    std::string expected = std::to_string(10 * i + 3).substr(0, 2);
+    EXPECT_EQ(type::CMP_TRUE,
+              values[i].CompareEquals(
+                  type::ValueFactory::GetVarcharValue(expected)));
+  }
+}
+
+TEST_F(FunctionTranslatorTest, CharLengthTest) {
+  //
+  // SELECT a FROM table WHERE CHAR_LENGTH(d) = 2;
+  //
+
+  std::vector<ExprPtr> args;
+  args.push_back(ColRefExpr(type::TypeId::VARCHAR, 3));
+  auto length_eq_2 =
+      CmpEqExpr(FuncExpr("char_length", std::move(args)), ConstIntExpr(2));
+  EXPECT_EQ(9, CountMatches(std::move(length_eq_2)));
+}
+
+TEST_F(FunctionTranslatorTest, ExtractTest) {
+  //
+  // SELECT a, EXTRACT(part FROM '2017-06-15 10:30:45.5') FROM table;
+  //
+  // The year, month, day, hour and minute are decoded inline, while the
+  // seconds are extracted by the runtime
+  //
+
+  uint64_t timestamp = (6 * 32 + 15) * 27;
+  timestamp = timestamp * 10000 + 2017;
+  timestamp = timestamp * 100000 + (10 * 3600 + 30 * 60 + 45);
+  timestamp = timestamp * 1000000 + 500000;
+
+  std::vector<std::pair<DatePartType, double>> parts = {
+      {DatePartType::YEAR, 2017},  {DatePartType::MONTH, 6},
+      {DatePartType::DAY, 15},     {DatePartType::HOUR, 10},
+      {DatePartType::MINUTE, 30},  {DatePartType::SECOND, 45.5}};
+  for (const auto &part : parts) {
+    std::vector<ExprPtr> args;
+    args.push_back(ConstIntExpr(static_cast<int32_t>(part.first)));
+    args.emplace_back(new expression::ConstantValueExpression(
+        type::ValueFactory::GetTimestampValue(timestamp)));
+    auto values = Project(FuncExpr("extract", std::move(args)));
+
+    ASSERT_EQ(NumRowsInTestTable(), values.size());
+    EXPECT_EQ(part.second, values[0].GetAs<double>());
+  }
+}
+
+TEST_F(FunctionTranslatorTest, SqrtTest) {
+  //
+  // SELECT a, SQRT(c) FROM table;
+  //
+
+  std::vector<ExprPtr> args;
+  args.push_back(ColRefExpr(type::TypeId::DECIMAL, 2));
+  auto values = Project(FuncExpr("sqrt", std::move(args)));
+
+  ASSERT_EQ(NumRowsInTestTable(), values.size());
+  for (uint32_t i = 0; i < values.size(); i++) {
+    EXPECT_DOUBLE_EQ(std::sqrt(10 * i + 2), values[i].GetAs<double>());
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "codegen/operator/hash_join_translator.h"
 #include "codegen/query_compiler.h"
+#include "codegen/util/radix_partitioner.h"
 #include "common/harness.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/comparison_expression.h"
@@ -46,6 +48,85 @@ class HashJoinTranslatorTest : public PelotonCodeGenTest {
   storage::DataTable &GetRightTable() const {
     return GetTestTable(RightTableId());
   }
+
+  // Join the left and right table on their column a. Semi and anti joins only
+  // output the columns a and b of the right table.
+  std::unique_ptr<planner::HashJoinPlan> MakeHashJoinPlan(
+      JoinType join_type = JoinType::INNER) {
+    return MakeHashJoinPlan(join_type, GetLeftTable(), GetRightTable());
+  }
+
+  std::unique_ptr<planner::HashJoinPlan> MakeHashJoinPlan(
+      JoinType join_type, storage::DataTable &left_table,
+      storage::DataTable &right_table) {
+    DirectMapList direct_map_list;
+    std::shared_ptr<const catalog::Schema> schema;
+    if (join_type == JoinType::SEMI || join_type == JoinType::ANTI) {
+      // Projection:  [right_table.a, right_table.b]
+      direct_map_list = {std::make_pair(0, std::make_pair(1, 0)),
+                         std::make_pair(1, std::make_pair(1, 1))};
+      schema.reset(
+          new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                               TestingExecutorUtil::GetColumnInfo(1)}));
+    } else {
+      // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+      direct_map_list = {std::make_pair(0, std::make_pair(0, 0)),
+                         std::make_pair(1, std::make_pair(1, 0)),
+                         std::make_pair(2, std::make_pair(0, 1)),
+                         std::make_pair(3, std::make_pair(1, 2))};
+      schema.reset(
+          new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                               TestingExecutorUtil::GetColumnInfo(0),
+                               TestingExecutorUtil::GetColumnInfo(1),
+                               TestingExecutorUtil::GetColumnInfo(2)}));
+    }
+    std::unique_ptr<planner::ProjectInfo> projection{
+        new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+    // Left and right hash keys
+    std::vector<AbstractExprPtr> left_hash_keys;
+    left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::vector<AbstractExprPtr> right_hash_keys;
+    right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::vector<AbstractExprPtr> hash_keys;
+    hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    // Finally, the fucking join node
+    std::unique_ptr<planner::HashJoinPlan> hj_plan{
+        new planner::HashJoinPlan(join_type, nullptr,
+                                  std::move(projection), schema,
+                                  left_hash_keys, right_hash_keys)};
+    std::unique_ptr<planner::HashPlan> hash_plan{
+        new planner::HashPlan(hash_keys)};
+
+    std::unique_ptr<planner::AbstractPlan> left_scan{
+        new planner::SeqScanPlan(&left_table, nullptr, {0, 1, 2})};
+    std::unique_ptr<planner::AbstractPlan> right_scan{
+        new planner::SeqScanPlan(&right_table, nullptr, {0, 1, 2})};
+
+    hash_plan->AddChild(std::move(right_scan));
+    hj_plan->AddChild(std::move(left_scan));
+    hj_plan->AddChild(std::move(hash_plan));
+    return hj_plan;
+  }
+
+  // Compile and run the join, returning its output
+  std::vector<codegen::WrappedTuple> ExecuteJoin(
+      planner::HashJoinPlan &hj_plan, const std::vector<oid_t> &out_cols) {
+    // Do binding
+    planner::BindingContext context;
+    hj_plan.PerformBinding(context);
+
+    // We collect the results of the query into an in-memory buffer
+    codegen::BufferingConsumer buffer{out_cols, context};
+
+    // COMPILE and run
+    CompileAndExecute(hj_plan, buffer,
+                      reinterpret_cast<char *>(buffer.GetState()));
+    return buffer.GetOutputTuples();
+  }
 };
 
 TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
@@ -58,47 +139,7 @@ TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   //   right_table ON left_table.a = right_table.a
   //
 
-  // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
-  DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
-  DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
-  DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
-  DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
-  DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
-  std::unique_ptr<planner::ProjectInfo> projection{
-      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
-
-  // Output schema
-  auto schema = std::shared_ptr<const catalog::Schema>(
-      new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
-                           TestingExecutorUtil::GetColumnInfo(0),
-                           TestingExecutorUtil::GetColumnInfo(1),
-                           TestingExecutorUtil::GetColumnInfo(2)}));
-
-  // Left and right hash keys
-  std::vector<AbstractExprPtr> left_hash_keys;
-  left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
-
-  std::vector<AbstractExprPtr> right_hash_keys;
-  right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
-
-  std::vector<AbstractExprPtr> hash_keys;
-  hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
-
-  // Finally, the fucking join node
-  std::unique_ptr<planner::HashJoinPlan> hj_plan{
-      new planner::HashJoinPlan(JoinType::INNER, nullptr, std::move(projection),
-                                schema, left_hash_keys, right_hash_keys)};
-  std::unique_ptr<planner::HashPlan> hash_plan{
-      new planner::HashPlan(hash_keys)};
-
-  std::unique_ptr<planner::AbstractPlan> left_scan{
-      new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
-  std::unique_ptr<planner::AbstractPlan> right_scan{
-      new planner::SeqScanPlan(&GetRightTable(), nullptr, {0, 1, 2})};
-
-  hash_plan->AddChild(std::move(right_scan));
-  hj_plan->AddChild(std::move(left_scan));
-  hj_plan->AddChild(std::move(hash_plan));
+  auto hj_plan = MakeHashJoinPlan();
 
   // Do binding
   planner::BindingContext context;
@@ -128,5 +169,175 @@ TEST_F(HashJoinTranslatorTest, SingleHashJoinColumnTest) {
   }
 }
 
+TEST_F(HashJoinTranslatorTest, RadixPartitionedHashJoinTest) {
+  //
+  // The same join as above, but both sides are partitioned before they are
+  // joined. The target partition size is tiny, so that the few tuples in the
+  // tables still end up in many partitions.
+  //
+
+  auto hj_plan = MakeHashJoinPlan();
+
+  bool use_radix_partitioning =
+      codegen::HashJoinTranslator::kUseRadixPartitioning;
+  uint64_t target_partition_size =
+      codegen::util::RadixPartitioner::kTargetPartitionSize;
+  codegen::HashJoinTranslator::kUseRadixPartitioning = true;
+  codegen::util::RadixPartitioner::kTargetPartitionSize = 64;
+
+  // Do binding
+  planner::BindingContext context;
+  hj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*hj_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  codegen::HashJoinTranslator::kUseRadixPartitioning = use_radix_partitioning;
+  codegen::util::RadixPartitioner::kTargetPartitionSize = target_partition_size;
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  // Every row of the left table still finds its partner
+  EXPECT_EQ(20, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_EQ(type::CMP_TRUE,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    // The b column of the left row comes along with its key
+    auto left_b = type::ValueFactory::GetIntegerValue(
+        tuple.GetValue(0).GetAs<int32_t>() + 1);
+    EXPECT_EQ(type::CMP_TRUE, tuple.GetValue(2).CompareEquals(left_b));
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, LeftOuterHashJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // LEFT JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+  // The left side is the table with 80 rows, the hash table is built on them
+  //
+
+  auto hj_plan =
+      MakeHashJoinPlan(JoinType::LEFT, GetRightTable(), GetLeftTable());
+  auto results = ExecuteJoin(*hj_plan, {0, 1, 2, 3});
+
+  // Every left row is output, 60 of them without a partner
+  EXPECT_EQ(80, results.size());
+  uint32_t num_unmatched = 0;
+  for (const auto &tuple : results) {
+    if (tuple.GetValue(1).IsNull()) {
+      num_unmatched++;
+      EXPECT_TRUE(tuple.GetValue(3).IsNull());
+      EXPECT_GE(tuple.GetValue(0).GetAs<int32_t>(), 200);
+    } else {
+      EXPECT_EQ(type::CMP_TRUE,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    }
+  }
+  EXPECT_EQ(60, num_unmatched);
+}
+
+TEST_F(HashJoinTranslatorTest, RightOuterHashJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // RIGHT JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+
+  auto hj_plan = MakeHashJoinPlan(JoinType::RIGHT);
+  auto results = ExecuteJoin(*hj_plan, {0, 1, 2, 3});
+
+  // Every right row is output, 60 of them without a partner
+  EXPECT_EQ(80, results.size());
+  uint32_t num_unmatched = 0;
+  for (const auto &tuple : results) {
+    if (tuple.GetValue(0).IsNull()) {
+      num_unmatched++;
+      EXPECT_TRUE(tuple.GetValue(2).IsNull());
+      EXPECT_GE(tuple.GetValue(1).GetAs<int32_t>(), 200);
+    } else {
+      EXPECT_EQ(type::CMP_TRUE,
+                tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    }
+  }
+  EXPECT_EQ(60, num_unmatched);
+}
+
+TEST_F(HashJoinTranslatorTest, FullOuterHashJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // FULL OUTER JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+
+  auto hj_plan = MakeHashJoinPlan(JoinType::OUTER);
+  auto results = ExecuteJoin(*hj_plan, {0, 1, 2, 3});
+
+  // All left rows have a partner, 60 right rows don't
+  EXPECT_EQ(80, results.size());
+  uint32_t num_matched = 0;
+  for (const auto &tuple : results) {
+    EXPECT_FALSE(tuple.GetValue(1).IsNull());
+    if (!tuple.GetValue(0).IsNull()) {
+      num_matched++;
+    }
+  }
+  EXPECT_EQ(20, num_matched);
+}
+
+TEST_F(HashJoinTranslatorTest, SemiHashJoinTest) {
+  //
+  // SELECT
+  //   right_table.a, right_table.b
+  // FROM
+  //   right_table
+  // WHERE
+  //   right_table.a IN (SELECT left_table.a FROM left_table)
+  //
+
+  auto hj_plan = MakeHashJoinPlan(JoinType::SEMI);
+  auto results = ExecuteJoin(*hj_plan, {0, 1});
+
+  // Only the first 20 rows of the right table have a partner
+  EXPECT_EQ(20, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_LT(tuple.GetValue(0).GetAs<int32_t>(), 200);
+  }
+}
+
+TEST_F(HashJoinTranslatorTest, AntiHashJoinTest) {
+  //
+  // SELECT
+  //   right_table.a, right_table.b
+  // FROM
+  //   right_table
+  // WHERE
+  //   NOT EXISTS (SELECT 1 FROM left_table WHERE left_table.a = right_table.a)
+  //
+
+  auto hj_plan = MakeHashJoinPlan(JoinType::ANTI);
+  auto results = ExecuteJoin(*hj_plan, {0, 1});
+
+  // The last 60 rows of the right table have no partner
+  EXPECT_EQ(60, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_GE(tuple.GetValue(0).GetAs<int32_t>(), 200);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
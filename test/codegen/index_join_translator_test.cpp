@@ -0,0 +1,188 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_join_translator_test.cpp
+//
+// Identification: test/codegen/index_join_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/comparison_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "index/index_factory.h"
+#include "planner/index_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/table_factory.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+typedef std::unique_ptr<const expression::AbstractExpression> AbstractExprPtr;
+
+class IndexJoinTranslatorTest : public PelotonCodeGenTest {
+ public:
+  IndexJoinTranslatorTest() : PelotonCodeGenTest() {
+    // Index the inner table on COL_A, before the table is loaded
+    auto &right_table = GetRightTable();
+    auto *tuple_schema = right_table.GetSchema();
+    std::vector<oid_t> key_attrs = {0};
+    auto *key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+    auto *index_metadata = new index::IndexMetadata(
+        "right_table_pkey", IndexOid(), right_table.GetOid(),
+        GetDatabase().GetOid(), IndexType::BWTREE,
+        IndexConstraintType::PRIMARY_KEY, tuple_schema, key_schema, key_attrs,
+        true);
+    std::shared_ptr<index::Index> pkey_index(
+        index::IndexFactory::GetIndex(index_metadata));
+    right_table.AddIndex(pkey_index);
+
+    // Load the test table
+    uint32_t num_rows = 10;
+    LoadTestTable(LeftTableId(), 2 * num_rows);
+    LoadTestTable(RightTableId(), 8 * num_rows);
+  }
+
+  TableId LeftTableId() const { return TableId::_1; }
+
+  TableId RightTableId() const { return TableId::_2; }
+
+  oid_t IndexOid() const { return 1234; }
+
+  storage::DataTable &GetLeftTable() const {
+    return GetTestTable(LeftTableId());
+  }
+
+  storage::DataTable &GetRightTable() const {
+    return GetTestTable(RightTableId());
+  }
+
+  std::unique_ptr<planner::IndexJoinPlan> MakeIndexJoinPlan(
+      AbstractExprPtr &&predicate, AbstractExprPtr &&inner_predicate) {
+    // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+    DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
+    DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
+    DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
+    DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
+    DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
+    std::unique_ptr<planner::ProjectInfo> projection{
+        new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+    // Output schema
+    auto schema = std::shared_ptr<const catalog::Schema>(
+        new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                             TestingExecutorUtil::GetColumnInfo(0),
+                             TestingExecutorUtil::GetColumnInfo(1),
+                             TestingExecutorUtil::GetColumnInfo(2)}));
+
+    // The key of the index is left_table.a
+    std::vector<AbstractExprPtr> outer_keys;
+    outer_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::unique_ptr<planner::IndexJoinPlan> ij_plan{new planner::IndexJoinPlan(
+        JoinType::INNER, std::move(predicate), std::move(projection), schema,
+        &GetRightTable(), GetRightTable().GetIndexWithOid(IndexOid()),
+        outer_keys, {0, 1, 2}, std::move(inner_predicate))};
+
+    std::unique_ptr<planner::AbstractPlan> left_scan{
+        new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
+    ij_plan->AddChild(std::move(left_scan));
+    return ij_plan;
+  }
+};
+
+TEST_F(IndexJoinTranslatorTest, SingleKeyIndexJoinTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+  // The join probes the index on right_table.a
+  //
+
+  auto ij_plan = MakeIndexJoinPlan(nullptr, nullptr);
+
+  // Do binding
+  planner::BindingContext context;
+  ij_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*ij_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  // The left table has 20 rows, each of them finds its key in the right table
+  EXPECT_EQ(20, results.size());
+  for (const auto &tuple : results) {
+    // Check that the joins keys are actually equal
+    EXPECT_EQ(type::CMP_TRUE,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+  }
+}
+
+TEST_F(IndexJoinTranslatorTest, IndexJoinWithPredicatesTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //               AND left_table.a < right_table.b
+  // WHERE
+  //   right_table.b >= 51
+  //
+
+  // left_table.a < right_table.b holds for all matches, since b is a + 1
+  auto left_a = ColRefExpr(type::TypeId::INTEGER, 0);
+  std::unique_ptr<expression::AbstractExpression> right_b{
+      new expression::TupleValueExpression(type::TypeId::INTEGER, 1, 1)};
+  auto predicate = CmpLtExpr(std::move(left_a), std::move(right_b));
+
+  // right_table.b >= 51, refers to the columns of the inner table
+  auto inner_predicate =
+      CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 1), ConstIntExpr(51));
+
+  auto ij_plan =
+      MakeIndexJoinPlan(std::move(predicate), std::move(inner_predicate));
+
+  // Do binding
+  planner::BindingContext context;
+  ij_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*ij_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // Check results
+  const auto &results = buffer.GetOutputTuples();
+  // Only the left rows 5 to 19 have a partner with right_table.b >= 51
+  EXPECT_EQ(15, results.size());
+  for (const auto &tuple : results) {
+    EXPECT_EQ(type::CMP_TRUE,
+              tuple.GetValue(0).CompareEquals(tuple.GetValue(1)));
+    EXPECT_EQ(type::CMP_TRUE, tuple.GetValue(1).CompareGreaterThanEquals(
+                                  type::ValueFactory::GetIntegerValue(50)));
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
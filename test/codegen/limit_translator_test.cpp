@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator_test.cpp
+//
+// Identification: test/codegen/limit_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "planner/limit_plan.h"
+#include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class LimitTranslatorTest : public PelotonCodeGenTest {
+ public:
+  LimitTranslatorTest() : PelotonCodeGenTest() {
+    // The table spans several tile groups
+    LoadTestTable(TestTableId(), NumRowsInTestTable());
+  }
+
+  TableId TestTableId() { return TableId::_1; }
+
+  uint32_t NumRowsInTestTable() const { return 100; }
+
+  // Run a limit over a scan of the test table, returning the values of the
+  // first column of the results
+  std::vector<int32_t> ExecuteLimit(size_t limit, size_t offset) {
+    std::unique_ptr<planner::LimitPlan> limit_plan{
+        new planner::LimitPlan(limit, offset)};
+    std::unique_ptr<planner::SeqScanPlan> scan_plan{new planner::SeqScanPlan(
+        &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3})};
+    limit_plan->AddChild(std::move(scan_plan));
+
+    // Do binding
+    planner::BindingContext context;
+    limit_plan->PerformBinding(context);
+
+    // We collect the results of the query into an in-memory buffer
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+
+    // COMPILE and execute
+    CompileAndExecute(*limit_plan, buffer,
+                      reinterpret_cast<char *>(buffer.GetState()));
+
+    std::vector<int32_t> results;
+    for (const auto &tuple : buffer.GetOutputTuples()) {
+      results.push_back(tuple.GetValue(0).GetAs<int32_t>());
+    }
+    return results;
+  }
+};
+
+TEST_F(LimitTranslatorTest, SimpleLimitTest) {
+  //
+  // SELECT a, b FROM table LIMIT 10;
+  //
+
+  auto results = ExecuteLimit(10, 0);
+  ASSERT_EQ(10, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(static_cast<int32_t>(10 * i), results[i]);
+  }
+}
+
+TEST_F(LimitTranslatorTest, LimitWithOffsetTest) {
+  //
+  // SELECT a, b FROM table LIMIT 10 OFFSET 45;
+  //
+
+  // The result crosses a tile group boundary
+  auto results = ExecuteLimit(10, 45);
+  ASSERT_EQ(10, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(static_cast<int32_t>(10 * (45 + i)), results[i]);
+  }
+}
+
+TEST_F(LimitTranslatorTest, LimitPastEndTest) {
+  //
+  // SELECT a, b FROM table LIMIT 50 OFFSET 90;
+  //
+
+  // Only the last 10 rows are left after the offset
+  auto results = ExecuteLimit(50, 90);
+  EXPECT_EQ(10, results.size());
+
+  // Nothing is left after an offset past the end of the table
+  results = ExecuteLimit(50, NumRowsInTestTable());
+  EXPECT_EQ(0, results.size());
+}
+
+TEST_F(LimitTranslatorTest, ZeroLimitTest) {
+  //
+  // SELECT a, b FROM table LIMIT 0;
+  //
+
+  auto results = ExecuteLimit(0, 0);
+  EXPECT_EQ(0, results.size());
+}
+
+TEST_F(LimitTranslatorTest, TopNTest) {
+  //
+  // SELECT a, b FROM table ORDER BY a DESC LIMIT 5 OFFSET 2;
+  //
+
+  std::unique_ptr<planner::OrderByPlan> order_by_plan{
+      new planner::OrderByPlan({0}, {true}, {0, 1, 2, 3})};
+  std::unique_ptr<planner::SeqScanPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3})};
+  order_by_plan->AddChild(std::move(scan_plan));
+
+  // The sort only retains the tuples up to the end of the limit
+  order_by_plan->SetLimit(true);
+  order_by_plan->SetLimitNumber(5);
+  order_by_plan->SetLimitOffset(2);
+
+  std::unique_ptr<planner::LimitPlan> limit_plan{new planner::LimitPlan(5, 2)};
+  limit_plan->AddChild(std::move(order_by_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*limit_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // The third to seventh largest values of a, in descending order
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(5, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    int32_t expected = 10 * (NumRowsInTestTable() - 3 - i);
+    EXPECT_EQ(expected, results[i].GetValue(0).GetAs<int32_t>());
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
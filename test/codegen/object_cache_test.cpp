@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// object_cache_test.cpp
+//
+// Identification: test/codegen/object_cache_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <boost/filesystem.hpp>
+
+#include "codegen/object_cache.h"
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "configuration/configuration.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class ObjectCacheTest : public PelotonCodeGenTest {
+ public:
+  ObjectCacheTest() : PelotonCodeGenTest() {
+    LoadTestTable(TestTableId(), NumRowsInTestTable());
+  }
+
+  TableId TestTableId() { return TableId::_1; }
+
+  uint32_t NumRowsInTestTable() const { return 64; }
+
+  // Run SELECT a, b FROM table WHERE a >= val, returning the values of a
+  std::vector<int32_t> ExecuteScan(int64_t val) {
+    auto a_gte_val =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(val));
+    planner::SeqScanPlan scan{&GetTestTable(TestTableId()),
+                              a_gte_val.release(), {0, 1}};
+
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer,
+                      reinterpret_cast<char *>(buffer.GetState()));
+
+    std::vector<int32_t> results;
+    for (const auto &tuple : buffer.GetOutputTuples()) {
+      results.push_back(tuple.GetValue(0).GetAs<int32_t>());
+    }
+    return results;
+  }
+};
+
+TEST_F(ObjectCacheTest, MemoryHitTest) {
+  auto &object_cache = codegen::ObjectCache::GetInstance();
+  object_cache.ClearMemory();
+
+  // The first run compiles the query
+  uint64_t misses = object_cache.GetMisses();
+  auto results = ExecuteScan(200);
+  EXPECT_EQ(misses + 1, object_cache.GetMisses());
+  EXPECT_EQ(44, results.size());
+
+  // The second run finds it in memory, and produces the same results
+  uint64_t memory_hits = object_cache.GetMemoryHits();
+  EXPECT_EQ(results, ExecuteScan(200));
+  EXPECT_EQ(memory_hits + 1, object_cache.GetMemoryHits());
+
+  // A different constant is different code
+  misses = object_cache.GetMisses();
+  EXPECT_EQ(54, ExecuteScan(100).size());
+  EXPECT_EQ(misses + 1, object_cache.GetMisses());
+}
+
+TEST_F(ObjectCacheTest, DiskHitTest) {
+  auto cache_dir = boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path("peloton-%%%%%%%%");
+  FLAGS_codegen_cache_dir = cache_dir.string();
+
+  auto &object_cache = codegen::ObjectCache::GetInstance();
+  object_cache.ClearMemory();
+
+  // The first run writes the object to disk
+  auto results = ExecuteScan(300);
+  EXPECT_EQ(34, results.size());
+  EXPECT_FALSE(boost::filesystem::is_empty(cache_dir));
+
+  // After a "restart", the object is read back from disk
+  object_cache.ClearMemory();
+  uint64_t disk_hits = object_cache.GetDiskHits();
+  EXPECT_EQ(results, ExecuteScan(300));
+  EXPECT_EQ(disk_hits + 1, object_cache.GetDiskHits());
+
+  // From then on, it is in memory
+  uint64_t memory_hits = object_cache.GetMemoryHits();
+  EXPECT_EQ(results, ExecuteScan(300));
+  EXPECT_EQ(memory_hits + 1, object_cache.GetMemoryHits());
+
+  FLAGS_codegen_cache_dir = "";
+  boost::filesystem::remove_all(cache_dir);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "common/harness.h"
@@ -32,6 +33,11 @@ static int CompareTuples(const TestTuple *a, const TestTuple *b) {
   return a->col_b < b->col_b;
 }
 
+// A three-way comparison of TestTuples on column B
+static int CompareTuplesOnB(const TestTuple *a, const TestTuple *b) {
+  return (a->col_b > b->col_b) - (a->col_b < b->col_b);
+}
+
 class SorterTest : public PelotonTest {
  public:
   SorterTest() {
@@ -97,6 +103,40 @@ TEST_F(SorterTest, CanSortTuples) {
   TestSort(10);
 }
 
+TEST_F(SorterTest, CanSortTopKTuples) {
+  // Only retain the 100 tuples with the smallest column B
+  const uint64_t top_k = 100;
+  codegen::util::Sorter top_k_sorter;
+  top_k_sorter.InitTopK(
+      reinterpret_cast<int (*)(const void *, const void *)>(CompareTuplesOnB),
+      sizeof(TestTuple), top_k);
+
+  std::vector<uint32_t> col_b_vals;
+  for (uint32_t i = 0; i < 10000; i++) {
+    TestTuple *tuple =
+        reinterpret_cast<TestTuple *>(top_k_sorter.StoreInputTupleTopK());
+    tuple->col_a = i;
+    tuple->col_b = rand() % 1000000;
+    col_b_vals.push_back(tuple->col_b);
+    top_k_sorter.FinishStoreTopK();
+  }
+  EXPECT_EQ(top_k, top_k_sorter.GetNumTuples());
+
+  top_k_sorter.Sort();
+
+  // The retained tuples are the smallest ones, in order
+  std::sort(col_b_vals.begin(), col_b_vals.end());
+  uint64_t res_tuples = 0;
+  for (auto iter : top_k_sorter) {
+    const auto *tt = reinterpret_cast<const TestTuple *>(iter);
+    EXPECT_EQ(col_b_vals[res_tuples], tt->col_b);
+    res_tuples++;
+  }
+  EXPECT_EQ(top_k, res_tuples);
+
+  top_k_sorter.Destroy();
+}
+
 TEST_F(SorterTest, BenchmarkSorter) {
   // Test sorting 5 million input tuples
   TestSort(5000000);
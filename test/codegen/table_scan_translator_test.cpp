@@ -14,8 +14,10 @@
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
 #include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
 #include "expression/operator_expression.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/tile_group_freezer.h"
 
 #include "codegen/testing_codegen_util.h"
 
@@ -493,5 +495,137 @@ TEST_F(TableScanTranslatorTest, ScanWithModuloPredicate) {
                                 type::ValueFactory::GetIntegerValue(1)));
 }
 
+TEST_F(TableScanTranslatorTest, ScanMixedLayouts) {
+  // Fill another tile group
+  LoadTestTable(TestTableId(), NumRowsInTestTable() / 2);
+  uint32_t num_rows = NumRowsInTestTable() + NumRowsInTestTable() / 2;
+
+  //
+  // Move the first two tile groups into layouts of their own. The scan is
+  // specialized for the row layout of the other tile groups and for the
+  // default layout, so the transformed tile groups take the generic loop.
+  //
+  auto &table = GetTestTable(TestTableId());
+  column_map_type layout;
+  layout[0] = std::make_pair(0, 0);
+  layout[1] = std::make_pair(0, 1);
+  layout[2] = std::make_pair(1, 0);
+  layout[3] = std::make_pair(1, 1);
+  table.SetDefaultLayout(layout);
+  ASSERT_NE(nullptr, table.TransformTileGroup(0, 0.0));
+
+  layout[0] = std::make_pair(0, 0);
+  layout[1] = std::make_pair(1, 0);
+  layout[2] = std::make_pair(1, 1);
+  layout[3] = std::make_pair(1, 2);
+  table.SetDefaultLayout(layout);
+  ASSERT_NE(nullptr, table.TransformTileGroup(1, 0.0));
+
+  layout[0] = std::make_pair(0, 0);
+  layout[1] = std::make_pair(0, 1);
+  layout[2] = std::make_pair(0, 2);
+  layout[3] = std::make_pair(1, 0);
+  table.SetDefaultLayout(layout);
+
+  //
+  // SELECT a, b, c, d FROM table where a >= 20;
+  //
+
+  // Setup the predicate
+  std::unique_ptr<expression::AbstractExpression> a_gt_20 =
+      CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(20));
+
+  // Setup the scan plan node
+  planner::SeqScanPlan scan{&table, a_gt_20.release(), {0, 1, 2, 3}};
+
+  // Do binding
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(scan, buffer, reinterpret_cast<char*>(buffer.GetState()));
+
+  // Every copy of the pipeline filters and outputs the tuples of its layouts
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(num_rows - 2, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    uint32_t rowid = i + 2;
+    EXPECT_TRUE(results[i].GetValue(0).CompareEquals(
+                    type::ValueFactory::GetIntegerValue(10 * rowid)) ==
+                type::CMP_TRUE);
+    EXPECT_TRUE(results[i].GetValue(1).CompareEquals(
+                    type::ValueFactory::GetIntegerValue(10 * rowid + 1)) ==
+                type::CMP_TRUE);
+    EXPECT_TRUE(results[i].GetValue(3).CompareEquals(
+                    type::ValueFactory::GetVarcharValue(
+                        std::to_string(10 * rowid + 3))) == type::CMP_TRUE);
+  }
+}
+
+TEST_F(TableScanTranslatorTest, ScanFrozenTileGroups) {
+  // Freeze the full tile groups, then add rows to a tile group that isn't
+  auto &table = GetTestTable(TestTableId());
+  auto frozen_count =
+      storage::TileGroupFreezer::GetInstance().FreezeTable(&table, MAX_CID);
+  EXPECT_LT(0, frozen_count);
+  LoadTestTable(TestTableId(), 10);
+
+  {
+    //
+    // SELECT a, b FROM table where a >= 20 and 301 > b;
+    //
+
+    // a >= 20 AND 301 > b
+    std::unique_ptr<expression::AbstractExpression> a_gt_20 =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(20));
+    std::unique_ptr<expression::AbstractExpression> b_lt_301 =
+        CmpGtExpr(ConstIntExpr(301), ColRefExpr(type::TypeId::INTEGER, 1));
+    auto *conj = new expression::ConjunctionExpression(
+        ExpressionType::CONJUNCTION_AND, a_gt_20.release(), b_lt_301.release());
+
+    planner::SeqScanPlan scan{&table, conj, {0, 1}};
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 1}, context};
+    CompileAndExecute(scan, buffer, reinterpret_cast<char*>(buffer.GetState()));
+
+    // 20 to 290 from the loaded rows, and 20 to 90 from the added rows
+    const auto &results = buffer.GetOutputTuples();
+    EXPECT_EQ(28 + 8, results.size());
+    for (const auto &tuple : results) {
+      EXPECT_EQ(type::CMP_TRUE,
+                tuple.GetValue(0).CompareGreaterThanEquals(
+                    type::ValueFactory::GetIntegerValue(20)));
+      EXPECT_EQ(type::CMP_TRUE, tuple.GetValue(1).CompareLessThan(
+                                    type::ValueFactory::GetIntegerValue(301)));
+    }
+  }
+
+  {
+    //
+    // SELECT a, d FROM table where d = '203';
+    //
+    std::unique_ptr<expression::AbstractExpression> d_eq_203 = CmpEqExpr(
+        ColRefExpr(type::TypeId::VARCHAR, 3),
+        std::unique_ptr<expression::AbstractExpression>{
+            new expression::ConstantValueExpression(
+                type::ValueFactory::GetVarcharValue("203"))});
+
+    planner::SeqScanPlan scan{&table, d_eq_203.release(), {0, 3}};
+    planner::BindingContext context;
+    scan.PerformBinding(context);
+    codegen::BufferingConsumer buffer{{0, 3}, context};
+    CompileAndExecute(scan, buffer, reinterpret_cast<char*>(buffer.GetState()));
+
+    const auto &results = buffer.GetOutputTuples();
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(type::CMP_TRUE, results[0].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(200)));
+  }
+}
+
 }  // namespace test
-}  // namespace peloton
\ No newline at end of file
+}  // namespace peloton
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tiered_compiler_test.cpp
+//
+// Identification: test/codegen/tiered_compiler_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+#include <thread>
+
+#include "codegen/object_cache.h"
+#include "codegen/tiered_compiler.h"
+#include "common/harness.h"
+#include "configuration/configuration.h"
+#include "executor/plan_executor.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+class TieredCompilerTest : public PelotonCodeGenTest {
+ public:
+  TieredCompilerTest() : PelotonCodeGenTest() {
+    LoadTestTable(TestTableId(), NumRowsInTestTable());
+  }
+
+  TableId TestTableId() { return TableId::_1; }
+
+  uint32_t NumRowsInTestTable() const { return 64; }
+
+  // SELECT a, b FROM table WHERE a >= val
+  std::unique_ptr<planner::SeqScanPlan> ScanPlan(int64_t val) {
+    auto a_gte_val =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(val));
+    return std::unique_ptr<planner::SeqScanPlan>{new planner::SeqScanPlan(
+        &GetTestTable(TestTableId()), a_gte_val.release(), {0, 1})};
+  }
+
+  // Execute the plan the way the traffic cop does, returning its output
+  std::vector<std::vector<unsigned char>> Execute(
+      const planner::AbstractPlan &plan) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto *txn = txn_manager.BeginTransaction();
+    std::vector<StatementResult> result;
+    auto status = executor::PlanExecutor::ExecutePlan(
+        &plan, txn, std::vector<type::Value>(), result, {0, 0});
+    txn_manager.CommitTransaction(txn);
+    EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+
+    std::vector<std::vector<unsigned char>> values;
+    for (const auto &res : result) {
+      values.push_back(res.second);
+    }
+    return values;
+  }
+};
+
+TEST_F(TieredCompilerTest, CompileHotQueryTest) {
+  auto executions = FLAGS_codegen_tiering_executions;
+  auto interpreted_ms = FLAGS_codegen_tiering_ms;
+  FLAGS_codegen_tiering_executions = 3;
+  FLAGS_codegen_tiering_ms = 1000000.0;
+
+  auto &tiered_compiler = codegen::TieredCompiler::GetInstance();
+  auto &object_cache = codegen::ObjectCache::GetInstance();
+  object_cache.ClearMemory();
+  tiered_compiler.Start();
+
+  // The first executions are interpreted
+  auto scan = ScanPlan(200);
+  std::vector<std::vector<unsigned char>> results;
+  for (uint32_t i = 0; i < 3; i++) {
+    EXPECT_FALSE(tiered_compiler.IsCompiled(*scan));
+    results = Execute(*scan);
+    EXPECT_EQ(44 * 2, results.size());
+  }
+
+  // After which the query is compiled in the background
+  for (uint32_t i = 0; i < 1000 && !tiered_compiler.IsCompiled(*scan); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(tiered_compiler.IsCompiled(*scan));
+
+  // The compiled query finds its code in the cache, and produces the same
+  // results
+  uint64_t memory_hits = object_cache.GetMemoryHits();
+  EXPECT_EQ(results, Execute(*scan));
+  EXPECT_EQ(memory_hits + 1, object_cache.GetMemoryHits());
+
+  // A different query is still interpreted
+  EXPECT_FALSE(tiered_compiler.IsCompiled(*ScanPlan(100)));
+  EXPECT_EQ(54 * 2, Execute(*ScanPlan(100)).size());
+
+  tiered_compiler.Stop();
+  FLAGS_codegen_tiering_executions = executions;
+  FLAGS_codegen_tiering_ms = interpreted_ms;
+}
+
+TEST_F(TieredCompilerTest, DropTableTest) {
+  auto executions = FLAGS_codegen_tiering_executions;
+  auto interpreted_ms = FLAGS_codegen_tiering_ms;
+  FLAGS_codegen_tiering_executions = 3;
+  FLAGS_codegen_tiering_ms = 1000000.0;
+
+  auto &tiered_compiler = codegen::TieredCompiler::GetInstance();
+  auto &object_cache = codegen::ObjectCache::GetInstance();
+  object_cache.ClearMemory();
+  tiered_compiler.Start();
+
+  // Make the query hot, and drop its table right away
+  auto scan = ScanPlan(300);
+  uint64_t num_compiled = tiered_compiler.GetNumCompiled();
+  for (uint32_t i = 0; i < 3; i++) {
+    Execute(*scan);
+  }
+  auto &table = GetTestTable(TestTableId());
+  tiered_compiler.DropTable(table.GetDatabaseOid(), table.GetOid());
+
+  // Either the query was compiled before the table was dropped, or it is never
+  // compiled
+  bool compiled = tiered_compiler.IsCompiled(*scan);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(compiled, tiered_compiler.IsCompiled(*scan));
+  EXPECT_EQ(num_compiled + (compiled ? 1 : 0),
+            tiered_compiler.GetNumCompiled());
+
+  tiered_compiler.Stop();
+  FLAGS_codegen_tiering_executions = executions;
+  FLAGS_codegen_tiering_ms = interpreted_ms;
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -137,6 +137,42 @@ TEST_F(DecentralizedEpochManagerTests, MultipleThreadsTest) {
 }
 
 
+TEST_F(DecentralizedEpochManagerTests, ReadOnlyTransactionTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset();
+
+  // register a thread.
+  epoch_manager.RegisterThread(0);
+
+  epoch_manager.SetCurrentEpochId(5);
+
+  // no transaction is running, so the snapshot epoch moves up to 5.
+  uint64_t tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(4, tail_epoch_id);
+
+  // a read-only transaction reads the snapshot at epoch 5.
+  cid_t read_id = epoch_manager.EnterReadOnlyEpoch(0);
+
+  EXPECT_EQ(5, read_id >> 32);
+
+  epoch_manager.SetCurrentEpochId(8);
+
+  // we should expect that the tail stays at 4.
+  tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(4, tail_epoch_id);
+
+  epoch_manager.ExitReadOnlyEpoch(0, read_id >> 32);
+
+  tail_epoch_id = epoch_manager.GetExpiredEpochId();
+
+  EXPECT_EQ(7, tail_epoch_id);
+
+  // deregister a thread.
+  epoch_manager.DeregisterThread(0);
+}
+
 }  // End test namespace
 }  // End peloton namespace
 
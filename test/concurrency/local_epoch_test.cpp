@@ -92,6 +92,73 @@ TEST_F(LocalEpochTests, TransactionTest) {
 }
 
 
+TEST_F(LocalEpochTests, ReadOnlyTransactionTest) {
+  concurrency::LocalEpoch local_epoch(0);
+
+  // a transaction enters epoch 10
+  bool rt = local_epoch.EnterEpoch(10, TimestampType::READ);
+  EXPECT_EQ(rt, true);
+
+  uint64_t max_eid = local_epoch.GetExpiredEpochId(11);
+  EXPECT_EQ(max_eid, 9);
+
+  // read-only transactions at epochs 6 and 8 hold the lower bound back.
+  local_epoch.EnterReadOnlyEpoch(8);
+  local_epoch.EnterReadOnlyEpoch(6);
+
+  max_eid = local_epoch.GetExpiredEpochId(12);
+  EXPECT_EQ(max_eid, 5);
+
+  // an epoch is released as soon as its own read-only transactions are gone.
+  local_epoch.ExitReadOnlyEpoch(6);
+
+  max_eid = local_epoch.GetExpiredEpochId(13);
+  EXPECT_EQ(max_eid, 7);
+
+  local_epoch.ExitReadOnlyEpoch(8);
+
+  max_eid = local_epoch.GetExpiredEpochId(14);
+  EXPECT_EQ(max_eid, 9);
+
+  // read-only transactions do not lower the bound of new transactions.
+  rt = local_epoch.EnterEpoch(9, TimestampType::READ);
+  EXPECT_EQ(rt, false);
+
+  local_epoch.ExitEpoch(10);
+
+  max_eid = local_epoch.GetExpiredEpochId(20);
+  EXPECT_EQ(max_eid, 19);
+}
+
+TEST_F(LocalEpochTests, OverlappingReadOnlyTransactionTest) {
+  concurrency::LocalEpoch local_epoch(0);
+
+  // every read-only transaction starts before the previous one exits, so
+  // there is always one running.
+  local_epoch.EnterReadOnlyEpoch(5);
+  for (uint64_t epoch_id = 6; epoch_id < 200; epoch_id++) {
+    local_epoch.EnterReadOnlyEpoch(epoch_id);
+    local_epoch.ExitReadOnlyEpoch(epoch_id - 1);
+
+    // the expired epoch follows the oldest running transaction.
+    uint64_t max_eid = local_epoch.GetExpiredEpochId(epoch_id + 1);
+    EXPECT_EQ(max_eid, epoch_id - 1);
+  }
+
+  // epochs beyond 32 bits are kept in full.
+  uint64_t large_epoch_id = (1ULL << 40) + 3;
+  local_epoch.EnterReadOnlyEpoch(large_epoch_id);
+  local_epoch.ExitReadOnlyEpoch(199);
+
+  uint64_t max_eid = local_epoch.GetExpiredEpochId(large_epoch_id + 10);
+  EXPECT_EQ(max_eid, large_epoch_id - 1);
+
+  local_epoch.ExitReadOnlyEpoch(large_epoch_id);
+
+  max_eid = local_epoch.GetExpiredEpochId(large_epoch_id + 10);
+  EXPECT_EQ(max_eid, large_epoch_id + 9);
+}
+
 }  // End test namespace
 }  // End peloton namespace
 
@@ -121,6 +121,158 @@ TEST_F(MVCCTests, AbortVersionChainTest) {
   }
 }
 
+TEST_F(MVCCTests, DeltaVersioningTest) {
+  LOG_INFO("DeltaVersioningTest");
+
+  for (auto protocol : PROTOCOL_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        protocol, IsolationLevelType::SERIALIZABLE, ConflictAvoidanceType::ABORT);
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+    table->SetDeltaVersioning(true);
+    auto tile_group = table->GetTileGroup(0);
+    auto slot_count = tile_group->GetNextTupleSlot();
+
+    // read, another txn updates twice and commits, read the old snapshot
+    // again, a new txn reads the update
+    {
+      TransactionScheduler scheduler(3, table, &txn_manager);
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(1).Update(0, 1);
+      scheduler.Txn(1).Update(0, 2);
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(2).Read(0);
+      scheduler.Txn(2).Commit();
+
+      scheduler.Run();
+
+      EXPECT_TRUE(scheduler.schedules[1].txn_result == ResultType::SUCCESS);
+      EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+      EXPECT_EQ(0, scheduler.schedules[0].results[1]);
+      EXPECT_EQ(2, scheduler.schedules[2].results[0]);
+    }
+
+    // update, abort, read
+    {
+      TransactionScheduler scheduler(2, table, &txn_manager);
+      scheduler.Txn(0).Update(0, 3);
+      scheduler.Txn(0).Abort();
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+    }
+
+    // update, scan the updated tuple
+    {
+      TransactionScheduler scheduler(2, table, &txn_manager);
+      scheduler.Txn(0).Update(9, 5);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(1).Scan(9);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(1, (int)scheduler.schedules[1].results.size());
+      EXPECT_EQ(5, scheduler.schedules[1].results[0]);
+    }
+
+    // The updates are kept as delta records of the original slots
+    EXPECT_EQ(slot_count, tile_group->GetNextTupleSlot());
+  }
+}
+
+TEST_F(MVCCTests, VersionStoreTest) {
+  LOG_INFO("VersionStoreTest");
+
+  for (auto protocol : PROTOCOL_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        protocol, IsolationLevelType::SERIALIZABLE, ConflictAvoidanceType::ABORT);
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+    table->SetVersionStore(true);
+    auto tile_group = table->GetTileGroup(0);
+    auto slot_count = tile_group->GetNextTupleSlot();
+
+    // read, another txn updates twice and commits, read the old snapshot
+    // again, a new txn reads the update
+    {
+      TransactionScheduler scheduler(3, table, &txn_manager);
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(1).Update(0, 1);
+      scheduler.Txn(1).Update(0, 2);
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+      scheduler.Txn(0).Read(0);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(2).Read(0);
+      scheduler.Txn(2).Commit();
+
+      scheduler.Run();
+
+      EXPECT_TRUE(scheduler.schedules[1].txn_result == ResultType::SUCCESS);
+      EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+      EXPECT_EQ(0, scheduler.schedules[0].results[1]);
+      EXPECT_EQ(2, scheduler.schedules[2].results[0]);
+    }
+
+    // update, abort, read
+    {
+      TransactionScheduler scheduler(2, table, &txn_manager);
+      scheduler.Txn(0).Update(0, 3);
+      scheduler.Txn(0).Abort();
+      scheduler.Txn(1).Read(0);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(2, scheduler.schedules[1].results[0]);
+    }
+
+    // update, scan the updated tuple
+    {
+      TransactionScheduler scheduler(2, table, &txn_manager);
+      scheduler.Txn(0).Update(9, 5);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(1).Scan(9);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_EQ(1, (int)scheduler.schedules[1].results.size());
+      EXPECT_EQ(5, scheduler.schedules[1].results[0]);
+    }
+
+    // delete an updated tuple, scan the table
+    {
+      TransactionScheduler scheduler(2, table, &txn_manager);
+      scheduler.Txn(0).Delete(9);
+      scheduler.Txn(0).Commit();
+      scheduler.Txn(1).Scan(0);
+      scheduler.Txn(1).Commit();
+
+      scheduler.Run();
+
+      EXPECT_TRUE(scheduler.schedules[0].txn_result == ResultType::SUCCESS);
+      EXPECT_EQ(9, (int)scheduler.schedules[1].results.size());
+    }
+
+    // The versions are kept out of the tile groups of the table
+    EXPECT_EQ(slot_count, tile_group->GetNextTupleSlot());
+    EXPECT_EQ(1, (int)table->GetVersionTileGroupCount());
+    EXPECT_LT(0, (int)table->GetVersionTileGroup(0)->GetNextTupleSlot());
+  }
+}
+
 TEST_F(MVCCTests, VersionChainTest) {
   LOG_INFO("VersionChainTest");
 
@@ -0,0 +1,283 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager_test.cpp
+//
+// Identification: test/concurrency/optimistic_transaction_manager_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include "concurrency/testing_transaction_util.h"
+#include "common/harness.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Optimistic Transaction Manager Tests
+//===--------------------------------------------------------------------===//
+
+class OptimisticTransactionManagerTests : public PelotonTest {};
+
+// a read does not block a later writer. instead, the reader fails its
+// validation if the version it read was overwritten before it committed.
+TEST_F(OptimisticTransactionManagerTests, ReadValidationTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // read, concurrent update commits, reader commits
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  }
+
+  // read, concurrent update is still running when the reader commits
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  // concurrent update of another tuple does not conflict with the read
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(1, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+    EXPECT_EQ(0, scheduler.schedules[0].results[1]);
+  }
+
+  // two readers, one of which then updates the tuple. unlike timestamp
+  // ordering, the older reader may still write, and the other reader aborts.
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[1].txn_result);
+  }
+}
+
+// two writers still conflict on the ownership of the version.
+TEST_F(OptimisticTransactionManagerTests, WriteConflictTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(1).Update(0, 2);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[1].txn_result);
+  }
+}
+
+// the version is checked to be ownable before it is owned, so another writer
+// may commit an update of it in between. owning it then has to fail.
+TEST_F(OptimisticTransactionManagerTests, OwnUpdatedVersionTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  TransactionScheduler scheduler(1, table, &txn_manager);
+  scheduler.Txn(0).Update(0, 1);
+  scheduler.Txn(0).Commit();
+  scheduler.Run();
+  EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+
+  // the older version of the tuple is the only one that has been replaced,
+  // and it is no longer owned by anyone
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  oid_t tuple_id = INVALID_OID;
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+    auto header = table->GetTileGroup(offset)->GetHeader();
+    for (oid_t slot = 0; slot < header->GetCurrentNextTupleSlot(); slot++) {
+      if (header->GetEndCommitId(slot) != MAX_CID) {
+        tile_group_header = header;
+        tuple_id = slot;
+      }
+    }
+  }
+  ASSERT_NE(nullptr, tile_group_header);
+  EXPECT_EQ(INITIAL_TXN_ID, tile_group_header->GetTransactionId(tuple_id));
+
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(txn_manager.AcquireOwnership(txn, tile_group_header, tuple_id));
+  EXPECT_EQ(INITIAL_TXN_ID, tile_group_header->GetTransactionId(tuple_id));
+  txn_manager.AbortTransaction(txn);
+}
+
+void IncrementTest(concurrency::TransactionManager *txn_manager,
+                   storage::DataTable *table,
+                   std::atomic<int> *committed_count,
+                   UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  for (int txn_itr = 0; txn_itr < 100; txn_itr++) {
+    auto txn = txn_manager->BeginTransaction();
+    int value = -1;
+    if (TestingTransactionUtil::ExecuteRead(txn, table, 0, value) == false ||
+        TestingTransactionUtil::ExecuteUpdate(txn, table, 0, value + 1) ==
+            false) {
+      txn_manager->AbortTransaction(txn);
+      continue;
+    }
+    if (txn_manager->CommitTransaction(txn) == ResultType::SUCCESS) {
+      (*committed_count)++;
+    }
+  }
+}
+
+// writers that race to update the same row never lose a committed update.
+TEST_F(OptimisticTransactionManagerTests, ConcurrentUpdateTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+  std::atomic<int> committed_count(0);
+  LaunchParallelTest(2, IncrementTest, &txn_manager, table, &committed_count);
+  EXPECT_LT(0, committed_count.load());
+
+  auto txn = txn_manager.BeginTransaction();
+  int value = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table, 0, value));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(committed_count.load(), value);
+}
+
+// updates of a delta versioned table keep the tuple in its slot, so conflicts
+// must be detected from the delta records instead of the end commit id.
+TEST_F(OptimisticTransactionManagerTests, DeltaVersioningTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // read, concurrent update commits, the reader updates the old snapshot
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+    table->SetDeltaVersioning(true);
+
+    TransactionScheduler scheduler(3, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(0, 2);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[2].txn_result);
+    EXPECT_EQ(1, scheduler.schedules[2].results[0]);
+  }
+
+  // read, concurrent update commits, reader commits
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+    table->SetDeltaVersioning(true);
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  }
+}
+
+// read committed transactions do not validate their reads.
+TEST_F(OptimisticTransactionManagerTests, ReadCommittedTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::OPTIMISTIC, IsolationLevelType::READ_COMMITTED);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  {
+    concurrency::EpochManagerFactory::GetInstance().Reset();
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+
+    TransactionScheduler scheduler(2, table, &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[1].txn_result);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -12,6 +12,7 @@
 
 
 #include "concurrency/testing_transaction_util.h"
+#include "concurrency/tuple_lock_manager.h"
 #include "common/harness.h"
 
 namespace peloton {
@@ -29,5 +30,63 @@ TEST_F(TimestampOrderingTransactionManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+// in WAIT mode, an older transaction waits for a younger owner to release the
+// tuple, while a younger transaction aborts right away.
+TEST_F(TimestampOrderingTransactionManagerTests, WaitDieTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE,
+      ConflictAvoidanceType::WAIT);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &lock_manager = concurrency::TupleLockManager::GetInstance();
+  auto timeout = lock_manager.GetTimeout();
+
+  concurrency::EpochManagerFactory::GetInstance().Reset();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  auto tile_group_header = table->GetTileGroup(0)->GetHeader();
+  oid_t tuple_id = 0;
+
+  auto older_txn = txn_manager.BeginTransaction();
+  auto younger_txn = txn_manager.BeginTransaction();
+
+  // the younger transaction dies
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(older_txn, tile_group_header, tuple_id));
+  EXPECT_FALSE(
+      txn_manager.IsOwnable(younger_txn, tile_group_header, tuple_id));
+  EXPECT_FALSE(
+      txn_manager.AcquireOwnership(younger_txn, tile_group_header, tuple_id));
+  txn_manager.YieldOwnership(older_txn, tile_group_header, tuple_id);
+
+  // the older transaction waits
+  lock_manager.SetTimeout(10000000);
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(younger_txn, tile_group_header, tuple_id));
+  EXPECT_TRUE(txn_manager.IsOwnable(older_txn, tile_group_header, tuple_id));
+  std::thread release_thread([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    txn_manager.YieldOwnership(younger_txn, tile_group_header, tuple_id);
+  });
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(older_txn, tile_group_header, tuple_id));
+  release_thread.join();
+  EXPECT_TRUE(txn_manager.IsOwner(older_txn, tile_group_header, tuple_id));
+  txn_manager.YieldOwnership(older_txn, tile_group_header, tuple_id);
+
+  // but not forever
+  lock_manager.SetTimeout(1000);
+  EXPECT_TRUE(
+      txn_manager.AcquireOwnership(younger_txn, tile_group_header, tuple_id));
+  EXPECT_FALSE(
+      txn_manager.AcquireOwnership(older_txn, tile_group_header, tuple_id));
+  txn_manager.YieldOwnership(younger_txn, tile_group_header, tuple_id);
+
+  txn_manager.AbortTransaction(older_txn);
+  txn_manager.AbortTransaction(younger_txn);
+
+  lock_manager.SetTimeout(timeout);
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING);
+}
+
 }  // End test namespace
 }  // End peloton namespace
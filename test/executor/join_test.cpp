@@ -22,9 +22,11 @@
 
 #include "executor/hash_executor.h"
 #include "executor/hash_join_executor.h"
+#include "executor/index_join_executor.h"
 #include "executor/index_scan_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/nested_loop_join_executor.h"
+#include "executor/seq_scan_executor.h"
 
 #include "expression/abstract_expression.h"
 #include "expression/expression_util.h"
@@ -32,9 +34,11 @@
 
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
+#include "planner/index_join_plan.h"
 #include "planner/index_scan_plan.h"
 #include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
+#include "planner/seq_scan_plan.h"
 
 #include "storage/data_table.h"
 #include "storage/tile.h"
@@ -221,6 +225,77 @@ TEST_F(JoinTests, BasicNestedLoopTest) {
   ExecuteNestedLoopJoinTest(JoinType::INNER, false);
 }
 
+TEST_F(JoinTests, IndexJoinTest) {
+  // Both tables have a primary key index on ATTR 0
+  std::unique_ptr<storage::DataTable> left_table(
+      TestingExecutorUtil::CreateAndPopulateTable());
+  std::unique_ptr<storage::DataTable> right_table(
+      TestingExecutorUtil::CreateAndPopulateTable());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Scan all of the outer table
+  planner::SeqScanPlan left_table_node(left_table.get(), nullptr,
+                                       {0, 1, 2, 3});
+  executor::SeqScanExecutor left_table_scan_executor(&left_table_node,
+                                                     context.get());
+
+  // Probe the primary key of the inner table with LEFT.0, and keep the inner
+  // tuples with RIGHT.0 < 100
+  std::vector<std::unique_ptr<const expression::AbstractExpression>>
+      outer_keys;
+  outer_keys.emplace_back(expression::ExpressionUtil::TupleValueFactory(
+      type::TypeId::INTEGER, 0, 0));
+  std::unique_ptr<const expression::AbstractExpression> inner_predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(100))));
+
+  auto projection = TestingJoinUtil::CreateProjection();
+  auto schema = CreateJoinSchema();
+  planner::IndexJoinPlan index_join_node(
+      JoinType::INNER, nullptr, std::move(projection), schema,
+      right_table.get(), right_table->GetIndex(0), outer_keys, {0, 1},
+      std::move(inner_predicate));
+
+  executor::IndexJoinExecutor index_join_executor(&index_join_node,
+                                                  context.get());
+  index_join_executor.AddChild(&left_table_scan_executor);
+
+  EXPECT_TRUE(index_join_executor.Init());
+
+  // Every outer tuple finds the inner tuple with the same key
+  size_t result_tuple_count = 0;
+  while (index_join_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_logical_tile(
+        index_join_executor.GetOutput());
+    if (result_logical_tile == nullptr) {
+      continue;
+    }
+    for (auto tuple_id : *result_logical_tile) {
+      // LEFT.1 == RIGHT.1 and RIGHT.0 == LEFT.0
+      EXPECT_EQ(type::CMP_TRUE,
+                result_logical_tile->GetValue(tuple_id, 0)
+                    .CompareEquals(result_logical_tile->GetValue(tuple_id, 1)));
+      EXPECT_EQ(type::CMP_TRUE,
+                result_logical_tile->GetValue(tuple_id, 2)
+                    .CompareEquals(result_logical_tile->GetValue(tuple_id, 3)));
+      result_tuple_count++;
+    }
+  }
+
+  // Only the first ten keys pass the inner predicate
+  EXPECT_EQ(10, result_tuple_count);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn) {
   // Random values
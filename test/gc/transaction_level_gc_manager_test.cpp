@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <future>
+#include <thread>
+
 #include "concurrency/testing_transaction_util.h"
 #include "executor/testing_executor_util.h"
 #include "common/harness.h"
@@ -196,5 +199,317 @@ TEST_F(TransactionLevelGCManagerTests, GCTest) {
   EXPECT_FALSE(storage_manager->HasDatabase(db_id));
 }
 
+// the slots recycled by the GC are handed out to an inserting thread in
+// batches, oldest tile group first and in slot order.
+TEST_F(TransactionLevelGCManagerTests, FreeSlotReuseTest) {
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("FREE_SLOT_DB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  // the table is spread over two tile groups of 100 tuples.
+  const int num_key = 150;
+  std::unique_ptr<storage::DataTable> table(
+    TestingTransactionUtil::CreateTable(num_key, "FREE_SLOT_TABLE", db_id, INVALID_OID, 1234, true));
+
+  //===========================
+  // delete every other tuple, in reverse order.
+  //===========================
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int i = num_key - 1; i >= 0; i -= 2) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table.get(), i));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Unlink(0, expired_eid));
+
+  epoch_manager.SetCurrentEpochId(3);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Reclaim(0, expired_eid));
+
+  //===========================
+  // drain the recycled slots.
+  //===========================
+  std::vector<ItemPointer> free_slots;
+  while (true) {
+    auto location = gc_manager.ReturnFreeSlot(table->GetOid());
+    if (location.IsNull() == true) {
+      break;
+    }
+    free_slots.push_back(location);
+  }
+
+  // both the deleted versions and the empty versions that marked the deletes
+  // are recycled.
+  EXPECT_EQ(num_key, (int)free_slots.size());
+
+  // every batch is handed out in (tile group, slot) order.
+  for (size_t i = 1; i < free_slots.size(); i++) {
+    if (i % FREE_SLOT_BATCH_SIZE == 0) {
+      continue;
+    }
+    auto &prev = free_slots[i - 1];
+    auto &curr = free_slots[i];
+    EXPECT_TRUE(prev.block < curr.block ||
+                (prev.block == curr.block && prev.offset < curr.offset));
+  }
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("FREE_SLOT_DB");
+  EXPECT_FALSE(storage_manager->HasDatabase(db_id));
+}
+
+// the slots cached by a thread that stopped inserting are given back to the
+// table once the thread is idle.
+TEST_F(TransactionLevelGCManagerTests, IdleFreeSlotTest) {
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("IDLE_SLOT_DB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  const int num_key = 150;
+  std::unique_ptr<storage::DataTable> table(
+    TestingTransactionUtil::CreateTable(num_key, "IDLE_SLOT_TABLE", db_id, INVALID_OID, 1234, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int i = 0; i < num_key; i += 2) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table.get(), i));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Unlink(0, expired_eid));
+
+  epoch_manager.SetCurrentEpochId(3);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Reclaim(0, expired_eid));
+
+  // give back whatever the threads of the earlier tests left behind.
+  gc_manager.ReturnIdleFreeSlots();
+  gc_manager.ReturnIdleFreeSlots();
+
+  //===========================
+  // another thread takes a slot, and keeps the rest of its batch.
+  //===========================
+  std::promise<ItemPointer> taken_slot;
+  std::promise<void> inserter_done;
+  auto taken_future = taken_slot.get_future();
+  auto done_future = inserter_done.get_future();
+  std::thread inserter([&] {
+    taken_slot.set_value(gc_manager.ReturnFreeSlot(table->GetOid()));
+    done_future.wait();
+  });
+  EXPECT_FALSE(taken_future.get().IsNull());
+
+  // the thread took a slot since the last check.
+  EXPECT_EQ(0, (int)gc_manager.ReturnIdleFreeSlots());
+  // now it is idle.
+  EXPECT_EQ(FREE_SLOT_BATCH_SIZE - 1, (int)gc_manager.ReturnIdleFreeSlots());
+
+  // every other slot can be taken by this thread.
+  int free_slot_count = 0;
+  while (gc_manager.ReturnFreeSlot(table->GetOid()).IsNull() == false) {
+    free_slot_count++;
+  }
+  EXPECT_EQ(num_key - 1, free_slot_count);
+
+  inserter_done.set_value();
+  inserter.join();
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("IDLE_SLOT_DB");
+  EXPECT_FALSE(storage_manager->HasDatabase(db_id));
+}
+
+// the GC moves the newest version of an updated tuple back into the tuple's
+// slot, and recycles the version store slots separately.
+TEST_F(TransactionLevelGCManagerTests, VersionStoreTest) {
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("VERSION_STORE_DB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  const int num_key = 10;
+  std::unique_ptr<storage::DataTable> table(
+    TestingTransactionUtil::CreateTable(num_key, "VERSION_STORE_TABLE", db_id, INVALID_OID, 1234, true));
+  table->SetVersionStore(true);
+  auto tile_group = table->GetTileGroup(0);
+  auto slot_count = tile_group->GetNextTupleSlot();
+
+  //===========================
+  // update a tuple.
+  //===========================
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 1));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Unlink(0, expired_eid));
+
+  epoch_manager.SetCurrentEpochId(3);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Reclaim(0, expired_eid));
+
+  // the tuple slot holds the newest version again, and keeps its slot.
+  size_t folded_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < slot_count; tuple_id++) {
+    auto tile_group_header = tile_group->GetHeader();
+    EXPECT_TRUE(tile_group_header->GetPrevItemPointer(tuple_id).IsNull());
+    auto indirection = tile_group_header->GetIndirection(tuple_id);
+    EXPECT_EQ(tile_group->GetTileGroupId(), indirection->block);
+    EXPECT_EQ(tuple_id, indirection->offset);
+    if (tile_group->GetValue(tuple_id, 1).CompareEquals(
+            type::ValueFactory::GetIntegerValue(1)) == type::CMP_TRUE) {
+      folded_count++;
+    }
+  }
+  EXPECT_EQ(1, (int)folded_count);
+  EXPECT_TRUE(gc_manager.ReturnFreeSlot(table->GetOid()).IsNull());
+
+  txn = txn_manager.BeginTransaction();
+  std::vector<int> results;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteScan(txn, results, table.get(), 0));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(num_key, (int)results.size());
+
+  //===========================
+  // the version is recycled once the transactions that read it have ended.
+  //===========================
+  epoch_manager.SetCurrentEpochId(4);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Unlink(0, expired_eid));
+
+  epoch_manager.SetCurrentEpochId(5);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Reclaim(0, expired_eid));
+
+  auto version_slot = gc_manager.ReturnFreeVersionSlot(table->GetOid());
+  EXPECT_FALSE(version_slot.IsNull());
+  EXPECT_EQ(table->GetVersionTileGroup(0)->GetTileGroupId(), version_slot.block);
+  EXPECT_TRUE(gc_manager.ReturnFreeSlot(table->GetOid()).IsNull());
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("VERSION_STORE_DB");
+  EXPECT_FALSE(storage_manager->HasDatabase(db_id));
+}
+
+// a tuple slot whose newest version is still being written when the older
+// version is reclaimed is folded on a later GC pass.
+TEST_F(TransactionLevelGCManagerTests, PendingAnchorTest) {
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::TransactionLevelGCManager::GetInstance();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase("PENDING_ANCHOR_DB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  const int num_key = 10;
+  std::unique_ptr<storage::DataTable> table(
+    TestingTransactionUtil::CreateTable(num_key, "PENDING_ANCHOR_TABLE", db_id, INVALID_OID, 1234, true));
+  table->SetVersionStore(true);
+  auto tile_group = table->GetTileGroup(0);
+  auto tile_group_header = tile_group->GetHeader();
+
+  //===========================
+  // update a tuple.
+  //===========================
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(txn, table.get(), 0, 1));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  epoch_manager.SetCurrentEpochId(2);
+  auto expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.Unlink(0, expired_eid));
+
+  //===========================
+  // the tuple is updated again while its slot is reclaimed.
+  //===========================
+  auto writer = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteUpdate(writer, table.get(), 0, 2));
+
+  // the writer holds back the expired epoch, so pass it explicitly.
+  epoch_manager.SetCurrentEpochId(3);
+  EXPECT_EQ(1, gc_manager.Reclaim(0, 2));
+  EXPECT_EQ(0, gc_manager.RetryPendingAnchors(0, 2));
+
+  EXPECT_FALSE(tile_group_header->GetPrevItemPointer(0).IsNull());
+  EXPECT_EQ(type::CMP_TRUE, tile_group->GetValue(0, 1).CompareEquals(
+                                type::ValueFactory::GetIntegerValue(0)));
+
+  //===========================
+  // the slot is folded once another epoch has expired, although no other
+  // version of the tuple is reclaimed.
+  //===========================
+  txn_manager.AbortTransaction(writer);
+
+  epoch_manager.SetCurrentEpochId(4);
+  expired_eid = epoch_manager.GetExpiredEpochId();
+  EXPECT_EQ(1, gc_manager.RetryPendingAnchors(0, expired_eid));
+  EXPECT_EQ(0, gc_manager.RetryPendingAnchors(0, expired_eid));
+
+  EXPECT_TRUE(tile_group_header->GetPrevItemPointer(0).IsNull());
+  auto indirection = tile_group_header->GetIndirection(0);
+  EXPECT_EQ(tile_group->GetTileGroupId(), indirection->block);
+  EXPECT_EQ(0U, indirection->offset);
+  EXPECT_EQ(type::CMP_TRUE, tile_group->GetValue(0, 1).CompareEquals(
+                                type::ValueFactory::GetIntegerValue(1)));
+
+  txn = txn_manager.BeginTransaction();
+  int result = -1;
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(1, result);
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase("PENDING_ANCHOR_DB");
+  EXPECT_FALSE(storage_manager->HasDatabase(db_id));
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -50,6 +50,10 @@ class TestingIndexUtil {
 
   static void NonUniqueKeyMultiThreadedStressTest2(const IndexType index_type);
 
+  static void BulkBuildTest(const IndexType index_type);
+
+  static void BatchLookupTest(const IndexType index_type);
+
   //===--------------------------------------------------------------------===//
   // Utility Methods
   //===--------------------------------------------------------------------===//
@@ -65,5 +65,13 @@ TEST_F(BwTreeIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::BWTREE);
 }
 
+TEST_F(BwTreeIndexTests, BulkBuildTest) {
+  TestingIndexUtil::BulkBuildTest(IndexType::BWTREE);
+}
+
+TEST_F(BwTreeIndexTests, BatchLookupTest) {
+  TestingIndexUtil::BatchLookupTest(IndexType::BWTREE);
+}
+
 }  // End test namespace
 }  // End peloton namespace
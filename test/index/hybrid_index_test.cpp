@@ -26,6 +26,7 @@
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "common/timer.h"
+#include "concurrency/testing_transaction_util.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/abstract_executor.h"
@@ -467,6 +468,56 @@ TEST_F(HybridIndexTests, HybridScanTest) {
   index_builder.join();
 }
 
+// the tuple slots of versioned tables may hold stale versions, so hybrid scans
+// of them must read the visible versions.
+TEST_F(HybridIndexTests, VersionedTableTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      ProtocolType::TIMESTAMP_ORDERING, IsolationLevelType::SERIALIZABLE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (bool delta_versioning : {true, false}) {
+    storage::DataTable *table = TestingTransactionUtil::CreateTable();
+    if (delta_versioning == true) {
+      table->SetDeltaVersioning(true);
+    } else {
+      table->SetVersionStore(true);
+    }
+
+    TransactionScheduler scheduler(1, table, &txn_manager);
+    scheduler.Txn(0).Update(0, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_EQ(ResultType::SUCCESS, scheduler.schedules[0].txn_result);
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    planner::IndexScanPlan::IndexScanDesc dummy_index_scan_desc;
+    planner::HybridScanPlan hybrid_scan_node(table, nullptr, {0, 1},
+                                             dummy_index_scan_desc,
+                                             HybridScanType::SEQUENTIAL);
+    executor::HybridScanExecutor hybrid_scan_executor(&hybrid_scan_node,
+                                                      context.get());
+    EXPECT_TRUE(hybrid_scan_executor.Init());
+
+    size_t result_tuple_count = 0;
+    while (hybrid_scan_executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_tile(
+          hybrid_scan_executor.GetOutput());
+      for (auto tuple_id : *result_tile) {
+        result_tuple_count++;
+        auto id = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+        auto value = result_tile->GetValue(tuple_id, 1).GetAs<int32_t>();
+        EXPECT_EQ(id == 0 ? 1 : 0, value);
+      }
+    }
+    EXPECT_EQ(10UL, result_tuple_count);
+
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
 }  // namespace hybrid_index_test
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// normalized_key_test.cpp
+//
+// Identification: test/index/normalized_key_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include <random>
+
+#include "index/index_factory.h"
+#include "index/index_key.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Normalized Key Tests
+//===--------------------------------------------------------------------===//
+
+class NormalizedKeyTests : public PelotonTest {};
+
+// Key schema (INTEGER, VARCHAR(100), DECIMAL, SMALLINT)
+catalog::Schema *BuildNormalizedKeySchema() {
+  std::vector<catalog::Column> column_list;
+  column_list.emplace_back(type::TypeId::INTEGER,
+                           type::Type::GetTypeSize(type::TypeId::INTEGER), "A",
+                           true);
+  column_list.emplace_back(type::TypeId::VARCHAR, 100, "B", false);
+  column_list.emplace_back(type::TypeId::DECIMAL,
+                           type::Type::GetTypeSize(type::TypeId::DECIMAL), "C",
+                           true);
+  column_list.emplace_back(type::TypeId::SMALLINT,
+                           type::Type::GetTypeSize(type::TypeId::SMALLINT),
+                           "D", true);
+  return new catalog::Schema(column_list);
+}
+
+// Returns -1, 0 or 1, comparing the values column by column
+int CompareKeyValues(const storage::Tuple *lhs, const storage::Tuple *rhs) {
+  for (oid_t column_id = 0; column_id < lhs->GetSchema()->GetColumnCount();
+       column_id++) {
+    auto lhs_value = lhs->GetValue(column_id);
+    auto rhs_value = rhs->GetValue(column_id);
+    if (lhs_value.CompareLessThan(rhs_value) == type::CMP_TRUE) return -1;
+    if (lhs_value.CompareGreaterThan(rhs_value) == type::CMP_TRUE) return 1;
+  }
+  return 0;
+}
+
+template <std::size_t KeySize>
+void CheckNormalizedKeyOrder(
+    const std::vector<std::unique_ptr<storage::Tuple>> &keys) {
+  std::vector<index::NormalizedKey<KeySize>> normalized_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    normalized_keys[i].SetFromKey(keys[i].get());
+  }
+
+  index::NormalizedComparator<KeySize> comparator;
+  index::NormalizedEqualityChecker<KeySize> equality_checker;
+  index::NormalizedHasher<KeySize> hasher;
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (size_t j = 0; j < keys.size(); j++) {
+      int expected = CompareKeyValues(keys[i].get(), keys[j].get());
+      EXPECT_EQ(expected < 0,
+                comparator(normalized_keys[i], normalized_keys[j]));
+      EXPECT_EQ(expected == 0,
+                equality_checker(normalized_keys[i], normalized_keys[j]));
+      if (expected == 0) {
+        EXPECT_EQ(hasher(normalized_keys[i]), hasher(normalized_keys[j]));
+      }
+    }
+  }
+}
+
+TEST_F(NormalizedKeyTests, OrderTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::unique_ptr<catalog::Schema> key_schema(BuildNormalizedKeySchema());
+
+  // Few distinct values per column, so that later columns decide often.
+  // Strings share prefixes, contain zero bytes, and are longer than the
+  // smaller keys
+  std::vector<int32_t> ints = {-100000, -1, 0, 1, 7, 100000};
+  std::vector<std::string> strings = {"",
+                                      "a",
+                                      std::string("a\0", 2),
+                                      std::string("a\0b", 3),
+                                      "a\x01",
+                                      "ab",
+                                      "abc",
+                                      "b",
+                                      "\xff",
+                                      std::string(80, 'x'),
+                                      std::string(80, 'x') + "y"};
+  std::vector<double> decimals = {-1e10, -2.5, -0.0, 0.0, 1e-9, 2.5, 1e10};
+  std::vector<int16_t> smallints = {-5, 0, 5};
+
+  std::mt19937 generator(1234);
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (int i = 0; i < 300; i++) {
+    keys.emplace_back(new storage::Tuple(key_schema.get(), true));
+    keys.back()->SetValue(
+        0, type::ValueFactory::GetIntegerValue(
+               ints[generator() % ints.size()]),
+        pool);
+    keys.back()->SetValue(
+        1, type::ValueFactory::GetVarcharValue(
+               strings[generator() % strings.size()]),
+        pool);
+    keys.back()->SetValue(
+        2, type::ValueFactory::GetDecimalValue(
+               decimals[generator() % decimals.size()]),
+        pool);
+    keys.back()->SetValue(
+        3, type::ValueFactory::GetSmallIntValue(
+               smallints[generator() % smallints.size()]),
+        pool);
+  }
+
+  // Long strings are cut off in the smaller key, and fit in the larger one
+  CheckNormalizedKeyOrder<64>(keys);
+  CheckNormalizedKeyOrder<256>(keys);
+}
+
+TEST_F(NormalizedKeyTests, IndexTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // A VARCHAR primary key without a declared length
+  std::vector<catalog::Column> column_list;
+  column_list.emplace_back(type::TypeId::VARCHAR, 0, "A", false);
+  std::vector<oid_t> key_attrs = {0};
+  auto key_schema = new catalog::Schema(column_list);
+  key_schema->SetIndexedColumns(key_attrs);
+  column_list.emplace_back(type::TypeId::INTEGER,
+                           type::Type::GetTypeSize(type::TypeId::INTEGER), "B",
+                           true);
+  std::unique_ptr<catalog::Schema> tuple_schema(
+      new catalog::Schema(column_list));
+
+  auto index_metadata = new index::IndexMetadata(
+      "normalized_key_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+      IndexConstraintType::PRIMARY_KEY, tuple_schema.get(), key_schema,
+      key_attrs, true);
+  std::unique_ptr<index::Index> index(
+      index::IndexFactory::GetIndex(index_metadata));
+
+  // Keys of all lengths, including ones that don't fit into the key
+  const int key_count = 2000;
+  std::vector<ItemPointer> items(key_count);
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (int i = 0; i < key_count; i++) {
+    items[i] = ItemPointer(i, 0);
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    std::string value = std::string(i % 300, 'k') + "_" + std::to_string(i);
+    keys.back()->SetValue(0, type::ValueFactory::GetVarcharValue(value), pool);
+    EXPECT_TRUE(index->InsertEntry(keys.back().get(), &items[i]));
+  }
+
+  for (int i = 0; i < key_count; i++) {
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanKey(keys[i].get(), location_ptrs);
+    EXPECT_EQ(1, location_ptrs.size());
+    if (location_ptrs.size() == 1) {
+      EXPECT_EQ(&items[i], location_ptrs[0]);
+    }
+  }
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count, location_ptrs.size());
+}
+
+}  // End test namespace
+}  // End peloton namespace
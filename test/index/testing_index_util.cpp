@@ -12,6 +12,9 @@
 
 #include "index/testing_index_util.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 #include "common/harness.h"
@@ -653,6 +656,180 @@ void TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(const IndexType inde
 }
 
 
+void TestingIndexUtil::BulkBuildTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(
+      TestingIndexUtil::BuildIndex(index_type, false));
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  // Enough keys for several levels of inner nodes
+  const int key_count = 50000;
+  const size_t partition_count = 4;
+  std::vector<ItemPointer> items(key_count * 2);
+  for (size_t item_itr = 0; item_itr < items.size(); item_itr++) {
+    items[item_itr] = ItemPointer(item_itr, 0);
+  }
+
+  auto set_key = [pool](storage::Tuple *key, int value) {
+    key->SetValue(0, type::ValueFactory::GetIntegerValue(value), pool);
+    key->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  };
+
+  index->StartBulkBuild(partition_count);
+
+  // Every partition takes every 4th key, in descending order. Keys that are
+  // a multiple of 10 have a second value, and the first key is scanned twice
+  std::vector<std::thread> threads;
+  for (size_t partition = 0; partition < partition_count; partition++) {
+    threads.emplace_back([&, partition] {
+      std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+      for (int key_itr = key_count - 1 - partition; key_itr >= 0;
+           key_itr -= partition_count) {
+        set_key(key.get(), key_itr);
+        index->BulkBuildEntry(partition, key.get(), &items[key_itr]);
+        if (key_itr % 10 == 0) {
+          index->BulkBuildEntry(partition, key.get(),
+                                &items[key_count + key_itr]);
+        }
+      }
+      set_key(key.get(), 0);
+      index->BulkBuildEntry(partition, key.get(), &items[0]);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Concurrent writers during the build go to the catch-up log, and to the
+  // tree as well, since the index is visible to readers
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  set_key(key.get(), key_count);
+  index->InsertEntry(key.get(), &items[key_count + 1]);
+  set_key(key.get(), 5);
+  index->DeleteEntry(key.get(), &items[5]);
+
+  set_key(key.get(), key_count);
+  index->ScanKey(key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->FinishBulkBuild();
+
+  // SCAN
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count + key_count / 10, location_ptrs.size());
+  location_ptrs.clear();
+
+  set_key(key.get(), 0);
+  index->ScanKey(key.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  set_key(key.get(), 12345);
+  index->ScanKey(key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(&items[12345], location_ptrs[0]);
+  location_ptrs.clear();
+
+  set_key(key.get(), 5);
+  index->ScanKey(key.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+  location_ptrs.clear();
+
+  set_key(key.get(), key_count);
+  index->ScanKey(key.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // The built index takes inserts and deletes as usual
+  for (int key_itr = 0; key_itr < key_count; key_itr += 2) {
+    set_key(key.get(), key_itr);
+    index->DeleteEntry(key.get(), &items[key_itr]);
+  }
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count / 2 + key_count / 10, location_ptrs.size());
+  location_ptrs.clear();
+
+  delete index->GetMetadata()->GetTupleSchema();
+}
+
+void TestingIndexUtil::BatchLookupTest(const IndexType index_type) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // INDEX
+  std::unique_ptr<index::Index> index(
+      TestingIndexUtil::BuildIndex(index_type, false));
+  const catalog::Schema *key_schema = index->GetKeySchema();
+
+  const int key_count = 20000;
+  std::vector<ItemPointer> items(key_count * 2);
+  for (size_t item_itr = 0; item_itr < items.size(); item_itr++) {
+    items[item_itr] = ItemPointer(item_itr, 0);
+  }
+
+  // Only even keys are in the index
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(0, type::ValueFactory::GetIntegerValue(key_itr),
+                          pool);
+    keys.back()->SetValue(1, type::ValueFactory::GetVarcharValue("a"), pool);
+  }
+
+  // Bulk built nodes are searched in the batch; the inserts and deletes
+  // afterwards leave delta chains that are looked up one key at a time
+  index->StartBulkBuild(1);
+  for (int key_itr = 0; key_itr < key_count / 2; key_itr += 2) {
+    index->BulkBuildEntry(0, keys[key_itr].get(), &items[key_itr]);
+  }
+  index->FinishBulkBuild();
+  for (int key_itr = key_count / 2; key_itr < key_count; key_itr += 2) {
+    index->InsertEntry(keys[key_itr].get(), &items[key_itr]);
+  }
+  for (int key_itr = 0; key_itr < key_count; key_itr += 10) {
+    index->InsertEntry(keys[key_itr].get(), &items[key_count + key_itr]);
+  }
+  for (int key_itr = 0; key_itr < key_count; key_itr += 6) {
+    index->DeleteEntry(keys[key_itr].get(), &items[key_itr]);
+  }
+
+  // Batches of several groups, probing the keys in a scattered order
+  const size_t batch_size = 100;
+  size_t found_count = 0;
+  for (int batch_start = 0; batch_start < key_count;
+       batch_start += batch_size) {
+    std::vector<const storage::Tuple *> batch;
+    for (int key_itr = batch_start;
+         key_itr < std::min<int>(batch_start + batch_size, key_count);
+         key_itr++) {
+      batch.push_back(keys[(key_itr * 7919) % key_count].get());
+    }
+
+    std::vector<std::vector<ItemPointer *>> results;
+    index->ScanKeyBatch(batch, results);
+    EXPECT_EQ(batch.size(), results.size());
+
+    for (size_t i = 0; i < batch.size(); i++) {
+      std::vector<ItemPointer *> location_ptrs;
+      index->ScanKey(batch[i], location_ptrs);
+      std::sort(location_ptrs.begin(), location_ptrs.end());
+      std::sort(results[i].begin(), results[i].end());
+      EXPECT_EQ(location_ptrs, results[i]);
+      found_count += results[i].size();
+    }
+  }
+
+  // Even keys, minus the deleted ones, plus the second values
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(location_ptrs.size(), found_count);
+
+  delete index->GetMetadata()->GetTupleSchema();
+}
+
 index::Index *TestingIndexUtil::BuildIndex(const IndexType index_type,
                                            const bool unique_keys) {
   LOG_DEBUG("Build index type: %s", IndexTypeToString(index_type).c_str());
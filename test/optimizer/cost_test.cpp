@@ -123,5 +123,36 @@ TEST_F(CostTests, ConjunctionTest) {
   EXPECT_LE(output->num_rows, 11626);
 }
 
+TEST_F(CostTests, JoinCostTest) {
+  std::vector<oid_t> key_column_ids = {0};
+  size_t small_rows = 100;
+  size_t large_rows = 1000000;
+
+  // A few outer rows probe a large table's unique index more cheaply than
+  // they scan it
+  double index_cost = Cost::InnerIndexJoin(small_rows, large_rows, nullptr,
+                                           key_column_ids, true);
+  double hash_cost = Cost::InnerHashJoin(small_rows, large_rows);
+  LOG_INFO("small outer: index join %f, hash join %f", index_cost, hash_cost);
+  EXPECT_LT(index_cost, hash_cost);
+
+  // Probing for every row of an outer as large as the inner is not
+  index_cost = Cost::InnerIndexJoin(large_rows, large_rows, nullptr,
+                                    key_column_ids, true);
+  hash_cost = Cost::InnerHashJoin(large_rows, large_rows);
+  LOG_INFO("large outer: index join %f, hash join %f", index_cost, hash_cost);
+  EXPECT_GT(index_cost, hash_cost);
+
+  // Without stats, a non-unique index is assumed to match the whole inner
+  EXPECT_GT(Cost::InnerIndexJoin(small_rows, large_rows, nullptr,
+                                 key_column_ids, false),
+            Cost::InnerNLJoin(small_rows, large_rows));
+
+  // Inputs without an estimate get the default number of rows
+  EXPECT_EQ(Cost::InnerHashJoin(0, 0),
+            Cost::InnerHashJoin(DEFAULT_NUM_ROWS, DEFAULT_NUM_ROWS));
+  EXPECT_LT(Cost::InnerHashJoin(0, 0), Cost::InnerNLJoin(0, 0));
+}
+
 } /* namespace test */
 } /* namespace peloton */
@@ -19,6 +19,7 @@
 #include "expression/function_expression.h"
 #include "expression/operator_expression.h"
 #include "expression/tuple_value_expression.h"
+#include "parser/explain_statement.h"
 #include "parser/postgresparser.h"
 
 namespace peloton {
@@ -949,6 +950,75 @@ TEST_F(PostgresParserTests, CaseTest) {
   delete stmt_list;
 }
 
+TEST_F(PostgresParserTests, ExplainTest) {
+  auto parser = parser::PostgresParser::GetInstance();
+
+  // Plain EXPLAIN
+  auto stmt_list = parser.BuildParseTree("EXPLAIN SELECT * FROM foo;");
+  EXPECT_TRUE(stmt_list->is_valid);
+  EXPECT_EQ(StatementType::EXPLAIN, stmt_list->GetStatement(0)->GetType());
+  auto explain_stmt =
+      (parser::ExplainStatement *)stmt_list->GetStatement(0);
+  EXPECT_FALSE(explain_stmt->analyze);
+  EXPECT_FALSE(explain_stmt->hardware_counters);
+  EXPECT_EQ(StatementType::SELECT, explain_stmt->real_sql_stmt->GetType());
+
+  // EXPLAIN ANALYZE
+  stmt_list = parser.BuildParseTree("EXPLAIN ANALYZE SELECT * FROM foo;");
+  EXPECT_TRUE(stmt_list->is_valid);
+  explain_stmt = (parser::ExplainStatement *)stmt_list->GetStatement(0);
+  EXPECT_TRUE(explain_stmt->analyze);
+  EXPECT_FALSE(explain_stmt->hardware_counters);
+
+  // EXPLAIN with options
+  stmt_list = parser.BuildParseTree(
+      "EXPLAIN (ANALYZE, COUNTERS) DELETE FROM foo WHERE id = 1;");
+  EXPECT_TRUE(stmt_list->is_valid);
+  explain_stmt = (parser::ExplainStatement *)stmt_list->GetStatement(0);
+  EXPECT_TRUE(explain_stmt->analyze);
+  EXPECT_TRUE(explain_stmt->hardware_counters);
+  EXPECT_EQ(StatementType::DELETE, explain_stmt->real_sql_stmt->GetType());
+
+  stmt_list = parser.BuildParseTree(
+      "EXPLAIN (ANALYZE false, COUNTERS) SELECT * FROM foo;");
+  EXPECT_TRUE(stmt_list->is_valid);
+  explain_stmt = (parser::ExplainStatement *)stmt_list->GetStatement(0);
+  EXPECT_FALSE(explain_stmt->analyze);
+  EXPECT_TRUE(explain_stmt->hardware_counters);
+}
+
+TEST_F(PostgresParserTests, CopyFromTest) {
+  auto parser = parser::PostgresParser::GetInstance();
+
+  // The text format, tab separated by default
+  auto stmt_list = parser.BuildParseTree("COPY foo FROM '/tmp/foo.txt';");
+  EXPECT_TRUE(stmt_list->is_valid);
+  EXPECT_EQ(StatementType::COPY, stmt_list->GetStatement(0)->GetType());
+  auto copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(CopyType::IMPORT_TSV, copy_stmt->type);
+  EXPECT_EQ("foo", std::string(copy_stmt->cpy_table->GetTableName()));
+  EXPECT_EQ("/tmp/foo.txt", std::string(copy_stmt->file_path));
+  EXPECT_EQ('\t', copy_stmt->delimiter);
+  EXPECT_FALSE(copy_stmt->header);
+
+  // CSV with a header
+  stmt_list = parser.BuildParseTree(
+      "COPY foo FROM '/tmp/foo.csv' WITH (FORMAT csv, HEADER, "
+      "DELIMITER '|');");
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(CopyType::IMPORT_CSV, copy_stmt->type);
+  EXPECT_EQ('|', copy_stmt->delimiter);
+  EXPECT_TRUE(copy_stmt->header);
+
+  // From the client
+  stmt_list = parser.BuildParseTree("COPY foo FROM STDIN CSV;");
+  EXPECT_TRUE(stmt_list->is_valid);
+  copy_stmt = (parser::CopyStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(CopyType::IMPORT_CSV, copy_stmt->type);
+  EXPECT_EQ(nullptr, copy_stmt->file_path);
+  EXPECT_EQ(',', copy_stmt->delimiter);
+}
 
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// codegen_object_cache_test.cpp
+//
+// Identification: test/performance/codegen_object_cache_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <boost/filesystem.hpp>
+
+#include "codegen/object_cache.h"
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "common/timer.h"
+#include "configuration/configuration.h"
+#include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Code Cache Tests
+//===--------------------------------------------------------------------===//
+
+class CodegenObjectCacheTests : public PelotonCodeGenTest {
+ public:
+  CodegenObjectCacheTests() : PelotonCodeGenTest() {
+    LoadTestTable(TableId::_1, 1000);
+  }
+
+  // SELECT a, b, c, d FROM table WHERE a >= 5000 ORDER BY b, returning the
+  // time it took to compile the query and the number of rows
+  std::pair<double, size_t> ExecuteQuery() {
+    std::unique_ptr<planner::OrderByPlan> order_by{
+        new planner::OrderByPlan({1}, {false}, {0, 1, 2, 3})};
+    auto a_gte_5000 =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(5000));
+    std::unique_ptr<planner::SeqScanPlan> scan{new planner::SeqScanPlan(
+        &GetTestTable(TableId::_1), a_gte_5000.release(), {0, 1, 2, 3})};
+    order_by->AddChild(std::move(scan));
+
+    planner::BindingContext context;
+    order_by->PerformBinding(context);
+
+    codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+    auto stats = CompileAndExecute(*order_by, buffer,
+                                   reinterpret_cast<char *>(buffer.GetState()));
+    return std::make_pair(stats.setup_ms + stats.ir_gen_ms + stats.jit_ms,
+                          buffer.GetOutputTuples().size());
+  }
+
+  // Run the query a few times, returning the average latency
+  double MeasureLatency(bool clear_memory, uint32_t runs) {
+    double total_ms = 0.0;
+    for (uint32_t run = 0; run < runs; run++) {
+      if (clear_memory) {
+        codegen::ObjectCache::GetInstance().ClearMemory();
+      }
+      Timer<std::ratio<1, 1000>> timer;
+      timer.Start();
+      auto result = ExecuteQuery();
+      timer.Stop();
+      EXPECT_EQ(500, result.second);
+      total_ms += timer.GetDuration();
+      LOG_DEBUG("Compilation took %.2lf ms", result.first);
+    }
+    return total_ms / runs;
+  }
+};
+
+TEST_F(CodegenObjectCacheTests, StartupLatencyTest) {
+  const uint32_t runs = 10;
+  auto cache_dir = boost::filesystem::temp_directory_path() /
+                   boost::filesystem::unique_path("peloton-%%%%%%%%");
+  auto &object_cache = codegen::ObjectCache::GetInstance();
+
+  // Cold: every run compiles the query from scratch
+  FLAGS_codegen_cache_dir = "";
+  auto cache_size = FLAGS_codegen_cache_size;
+  FLAGS_codegen_cache_size = 0;
+  double cold_ms = MeasureLatency(false, runs);
+  FLAGS_codegen_cache_size = cache_size;
+
+  // Warm disk: the object was compiled before the "restart"
+  FLAGS_codegen_cache_dir = cache_dir.string();
+  object_cache.ClearMemory();
+  ExecuteQuery();
+  uint64_t disk_hits = object_cache.GetDiskHits();
+  double warm_disk_ms = MeasureLatency(true, runs);
+  EXPECT_EQ(disk_hits + runs, object_cache.GetDiskHits());
+
+  // Warm memory: the object was compiled earlier in this process
+  uint64_t memory_hits = object_cache.GetMemoryHits();
+  double warm_memory_ms = MeasureLatency(false, runs);
+  EXPECT_EQ(memory_hits + runs, object_cache.GetMemoryHits());
+
+  LOG_INFO("Query latency: cold %.2lf ms, warm disk %.2lf ms, "
+           "warm memory %.2lf ms",
+           cold_ms, warm_disk_ms, warm_memory_ms);
+
+  FLAGS_codegen_cache_dir = "";
+  boost::filesystem::remove_all(cache_dir);
+}
+
+}  // namespace test
+}  // namespace peloton
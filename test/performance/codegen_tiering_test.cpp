@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// codegen_tiering_test.cpp
+//
+// Identification: test/performance/codegen_tiering_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/object_cache.h"
+#include "codegen/tiered_compiler.h"
+#include "common/harness.h"
+#include "common/timer.h"
+#include "configuration/configuration.h"
+#include "executor/plan_executor.h"
+#include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tiered Execution Tests
+//===--------------------------------------------------------------------===//
+
+class CodegenTieringTests : public PelotonCodeGenTest {
+ public:
+  CodegenTieringTests() : PelotonCodeGenTest() {
+    LoadTestTable(TableId::_1, 20000);
+    LoadTestTable(TableId::_2, 20);
+  }
+
+  // A short query: SELECT a, b, c, d FROM small_table WHERE a = val. Every
+  // execution uses a different constant, like ad-hoc queries do.
+  std::unique_ptr<planner::AbstractPlan> ShortQuery(int64_t val) {
+    auto a_eq_val =
+        CmpEqExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(val));
+    return std::unique_ptr<planner::AbstractPlan>{new planner::SeqScanPlan(
+        &GetTestTable(TableId::_2), a_eq_val.release(), {0, 1, 2, 3})};
+  }
+
+  // A long query, always the same:
+  // SELECT a, b, c, d FROM large_table WHERE a >= 50000 ORDER BY b
+  std::unique_ptr<planner::AbstractPlan> LongQuery() {
+    std::unique_ptr<planner::OrderByPlan> order_by{
+        new planner::OrderByPlan({1}, {false}, {0, 1, 2, 3})};
+    auto a_gte_50000 =
+        CmpGteExpr(ColRefExpr(type::TypeId::INTEGER, 0), ConstIntExpr(50000));
+    std::unique_ptr<planner::SeqScanPlan> scan{new planner::SeqScanPlan(
+        &GetTestTable(TableId::_1), a_gte_50000.release(), {0, 1, 2, 3})};
+    order_by->AddChild(std::move(scan));
+    return std::move(order_by);
+  }
+
+  // Execute the plan the way the traffic cop does, returning the number of
+  // values it produced
+  size_t Execute(const planner::AbstractPlan &plan) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto *txn = txn_manager.BeginTransaction();
+    std::vector<StatementResult> result;
+    auto status = executor::PlanExecutor::ExecutePlan(
+        &plan, txn, std::vector<type::Value>(), result, {0, 0, 0, 0});
+    txn_manager.CommitTransaction(txn);
+    EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+    return result.size();
+  }
+
+  // Run a mix of short and long queries, returning the average latency of
+  // each kind
+  std::pair<double, double> RunWorkload(uint32_t rounds) {
+    const uint32_t short_per_long = 10;
+    double short_ms = 0.0, long_ms = 0.0;
+    for (uint32_t round = 0; round < rounds; round++) {
+      for (uint32_t i = 0; i < short_per_long; i++) {
+        auto plan = ShortQuery(10 * ((round * short_per_long + i) % 20));
+        Timer<std::ratio<1, 1000>> timer;
+        timer.Start();
+        EXPECT_EQ(4, Execute(*plan));
+        timer.Stop();
+        short_ms += timer.GetDuration();
+      }
+
+      auto plan = LongQuery();
+      Timer<std::ratio<1, 1000>> timer;
+      timer.Start();
+      EXPECT_EQ(15000 * 4, Execute(*plan));
+      timer.Stop();
+      long_ms += timer.GetDuration();
+    }
+    return std::make_pair(short_ms / (rounds * short_per_long),
+                          long_ms / rounds);
+  }
+};
+
+TEST_F(CodegenTieringTests, MixedWorkloadLatencyTest) {
+  const uint32_t rounds = 20;
+  auto &tiered_compiler = codegen::TieredCompiler::GetInstance();
+  auto codegen = FLAGS_codegen;
+
+  // Interpreted: no query is compiled
+  FLAGS_codegen = false;
+  auto interpreted = RunWorkload(rounds);
+
+  // Compiled: every query is compiled before it runs
+  FLAGS_codegen = true;
+  codegen::ObjectCache::GetInstance().ClearMemory();
+  auto compiled = RunWorkload(rounds);
+
+  // Tiered: queries are interpreted until they are compiled in the background
+  codegen::ObjectCache::GetInstance().ClearMemory();
+  uint64_t num_compiled = tiered_compiler.GetNumCompiled();
+  tiered_compiler.Start();
+  auto tiered = RunWorkload(rounds);
+  tiered_compiler.Stop();
+  EXPECT_LT(num_compiled, tiered_compiler.GetNumCompiled());
+
+  LOG_INFO("Short query latency: interpreted %.2lf ms, compiled %.2lf ms, "
+           "tiered %.2lf ms",
+           interpreted.first, compiled.first, tiered.first);
+  LOG_INFO("Long query latency: interpreted %.2lf ms, compiled %.2lf ms, "
+           "tiered %.2lf ms",
+           interpreted.second, compiled.second, tiered.second);
+
+  FLAGS_codegen = codegen;
+}
+
+}  // namespace test
+}  // namespace peloton
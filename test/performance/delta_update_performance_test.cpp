@@ -0,0 +1,240 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// delta_update_performance_test.cpp
+//
+// Identification: test/performance/delta_update_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+
+#include "catalog/schema.h"
+#include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/index_scan_executor.h"
+#include "executor/insert_executor.h"
+#include "executor/update_executor.h"
+#include "expression/expression_util.h"
+#include "gc/gc_manager_factory.h"
+#include "index/index_factory.h"
+#include "planner/index_scan_plan.h"
+#include "planner/insert_plan.h"
+#include "planner/update_plan.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+#include "storage/table_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Delta Update Performance Tests
+//===--------------------------------------------------------------------===//
+
+class DeltaUpdatePerformanceTests : public PelotonTest {};
+
+static const int wide_column_count = 64;
+static const int update_thread_count = 4;
+static const int update_keys_per_thread = 250;
+static const int update_round_count = 10;
+
+std::atomic<size_t> update_txn_count;
+
+//===------------------------------===//
+// Utility
+//===------------------------------===//
+
+// A table with a primary index on the first of many integer columns.
+storage::DataTable *CreateWideTable(storage::Database *database) {
+  std::vector<catalog::Column> columns;
+  for (int i = 0; i < wide_column_count; i++) {
+    columns.emplace_back(type::TypeId::INTEGER,
+                         type::Type::GetTypeSize(type::TypeId::INTEGER),
+                         "c" + std::to_string(i), true);
+  }
+  catalog::Schema *table_schema = new catalog::Schema(columns);
+
+  auto table = storage::TableFactory::GetDataTable(
+      database->GetOid(), TEST_TABLE_OID, table_schema, "WIDE_TABLE", 100,
+      true, false);
+
+  std::vector<oid_t> key_attrs = {0};
+  auto tuple_schema = table->GetSchema();
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  auto index_metadata = new index::IndexMetadata(
+      "wide_pkey_index", 1234, TEST_TABLE_OID, database->GetOid(),
+      IndexType::BWTREE, IndexConstraintType::PRIMARY_KEY, tuple_schema,
+      key_schema, key_attrs, true);
+  std::shared_ptr<index::Index> pkey_index(
+      index::IndexFactory::GetIndex(index_metadata));
+  table->AddIndex(pkey_index);
+
+  database->AddTable(table);
+
+  // Load every key with all columns set
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int key = 0; key < update_thread_count * update_keys_per_thread;
+       key++) {
+    std::unique_ptr<storage::Tuple> tuple(
+        new storage::Tuple(tuple_schema, true));
+    for (int i = 0; i < wide_column_count; i++) {
+      tuple->SetValue(i, type::ValueFactory::GetIntegerValue(key + i),
+                      testing_pool);
+    }
+
+    planner::InsertPlan node(
+        table, TestingTransactionUtil::MakeProjectInfoFromTuple(tuple.get()));
+    executor::InsertExecutor executor(&node, context.get());
+    executor.Execute();
+  }
+  txn_manager.CommitTransaction(txn);
+
+  return table;
+}
+
+// Set the second column of a tuple, copying all other columns like the
+// update plans of the optimizer do.
+bool UpdateWideTuple(concurrency::Transaction *txn, storage::DataTable *table,
+                     int key, int value) {
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  TargetList target_list;
+  DirectMapList direct_map_list;
+  auto *expr = expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetIntegerValue(value));
+  target_list.emplace_back(1, planner::DerivedAttribute{expr});
+  for (oid_t i = 0; i < (oid_t)wide_column_count; i++) {
+    if (i != 1) {
+      direct_map_list.emplace_back(i, std::pair<oid_t, oid_t>(0, i));
+    }
+  }
+
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+  planner::UpdatePlan update_node(table, std::move(project_info));
+  executor::UpdateExecutor update_executor(&update_node, context.get());
+
+  std::vector<expression::AbstractExpression *> runtime_keys;
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      table->GetIndex(0), {0}, {ExpressionType::COMPARE_EQUAL},
+      {type::ValueFactory::GetIntegerValue(key).Copy()}, runtime_keys);
+  std::vector<oid_t> column_ids = {0};
+  std::unique_ptr<planner::IndexScanPlan> idx_scan_node(
+      new planner::IndexScanPlan(table, nullptr, column_ids, index_scan_desc));
+  executor::IndexScanExecutor idx_scan_executor(idx_scan_node.get(),
+                                                context.get());
+
+  update_node.AddChild(std::move(idx_scan_node));
+  update_executor.AddChild(&idx_scan_executor);
+
+  EXPECT_TRUE(update_executor.Init());
+  return update_executor.Execute();
+}
+
+// Every thread repeatedly updates a single column of its own keys.
+void UpdateWideTuples(storage::DataTable *table, uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  int key_base = thread_itr * update_keys_per_thread;
+
+  for (int round = 0; round < update_round_count; round++) {
+    for (int i = 0; i < update_keys_per_thread; i++) {
+      auto txn = txn_manager.BeginTransaction(thread_itr);
+      UpdateWideTuple(txn, table, key_base + i, round);
+      txn_manager.CommitTransaction(txn);
+      update_txn_count++;
+    }
+  }
+}
+
+// Run the update workload against a fresh wide table. Returns the duration
+// and the number of tile groups the table grew by.
+double RunWideUpdates(bool delta_versioning, size_t &tile_group_growth) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+  for (size_t i = 0; i < (size_t)update_thread_count; ++i) {
+    epoch_manager.RegisterThread(i);
+  }
+
+  std::unique_ptr<std::thread> epoch_thread;
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  auto database = TestingExecutorUtil::InitializeDatabase("WIDE_DB");
+  std::unique_ptr<storage::DataTable> table(CreateWideTable(database));
+  table->SetDeltaVersioning(delta_versioning);
+  size_t loaded_tile_group_count = table->GetTileGroupCount();
+
+  epoch_manager.StartEpoch(epoch_thread);
+  gc_manager.StartGC(gc_threads);
+
+  update_txn_count = 0;
+
+  Timer<> timer;
+  timer.Start();
+
+  LaunchParallelTest(update_thread_count, UpdateWideTuples, table.get());
+
+  timer.Stop();
+  auto duration = timer.GetDuration();
+
+  gc_manager.StopGC();
+  epoch_manager.StopEpoch();
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+  epoch_thread->join();
+
+  tile_group_growth = table->GetTileGroupCount() - loaded_tile_group_count;
+
+  LOG_INFO("%s: %.2lf s, throughput: %.2lf txn/s, %lu new tile groups",
+           delta_versioning ? "Delta" : "Full copy", duration,
+           update_txn_count.load() / duration, tile_group_growth);
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase("WIDE_DB");
+  gc::GCManagerFactory::Configure(0);
+
+  return duration;
+}
+
+TEST_F(DeltaUpdatePerformanceTests, WideTableUpdateTest) {
+  size_t full_copy_growth;
+  size_t delta_growth;
+  UNUSED_ATTRIBUTE auto full_copy_duration =
+      RunWideUpdates(false, full_copy_growth);
+  UNUSED_ATTRIBUTE auto delta_duration = RunWideUpdates(true, delta_growth);
+
+  LOG_INFO("Delta updates took %.2lf of the full copy time",
+           delta_duration / full_copy_duration);
+
+  // the delta updates keep every tuple in its slot.
+  EXPECT_EQ(0, (int)delta_growth);
+  EXPECT_LE(delta_growth, full_copy_growth);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,174 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_churn_performance_test.cpp
+//
+// Identification: test/performance/gc_churn_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+
+#include "common/timer.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "gc/gc_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/storage_manager.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// GC Churn Performance Tests
+//===--------------------------------------------------------------------===//
+
+class GCChurnPerformanceTests : public PelotonTest {};
+
+static const int churn_thread_count = 4;
+static const int churn_round_count = 20;
+static const int churn_tuples_per_round = 500;
+
+std::atomic<size_t> churn_txn_count;
+std::atomic<int> churn_finished_count;
+std::atomic<bool> late_inserts_done;
+size_t late_tile_group_count;
+
+//===------------------------------===//
+// Utility
+//===------------------------------===//
+
+// Once the churning threads are done, another thread inserts fresh keys.
+// The churning threads stay alive, so the slots they cached are only given
+// back because they went idle.
+void LateInsertTuples(storage::DataTable *table, uint64_t thread_itr) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  while (churn_finished_count != churn_thread_count) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // let the GC reclaim the last deletes and collect the idle caches
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(4 * FREE_SLOT_IDLE_PERIOD_MS));
+  late_tile_group_count = table->GetTileGroupCount();
+
+  for (int key = 0; key < churn_thread_count * churn_tuples_per_round; key++) {
+    auto txn = txn_manager.BeginTransaction(thread_itr);
+    TestingTransactionUtil::ExecuteInsert(txn, table, key, 0);
+    txn_manager.CommitTransaction(txn);
+    churn_txn_count++;
+  }
+  late_inserts_done = true;
+}
+
+// Every thread inserts a batch of fresh keys and deletes them again, so the
+// table only stays small if the deleted slots are reused by later inserts.
+void ChurnTuples(storage::DataTable *table, uint64_t thread_itr) {
+  if (thread_itr == churn_thread_count) {
+    LateInsertTuples(table, thread_itr);
+    return;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  int key_base = (thread_itr + 1) * churn_round_count * churn_tuples_per_round;
+
+  for (int round = 0; round < churn_round_count; round++) {
+    int round_base = key_base + round * churn_tuples_per_round;
+
+    for (int i = 0; i < churn_tuples_per_round; i++) {
+      auto txn = txn_manager.BeginTransaction(thread_itr);
+      TestingTransactionUtil::ExecuteInsert(txn, table, round_base + i, 0);
+      txn_manager.CommitTransaction(txn);
+      churn_txn_count++;
+    }
+
+    for (int i = 0; i < churn_tuples_per_round; i++) {
+      auto txn = txn_manager.BeginTransaction(thread_itr);
+      TestingTransactionUtil::ExecuteDelete(txn, table, round_base + i);
+      txn_manager.CommitTransaction(txn);
+      churn_txn_count++;
+    }
+  }
+
+  churn_finished_count++;
+  while (late_inserts_done == false) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST_F(GCChurnPerformanceTests, InsertDeleteChurnTest) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+  for (size_t i = 0; i <= (size_t)churn_thread_count; ++i) {
+    epoch_manager.RegisterThread(i);
+  }
+
+  std::unique_ptr<std::thread> epoch_thread;
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  auto storage_manager = storage::StorageManager::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase("CHURN_DB");
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(storage_manager->HasDatabase(db_id));
+
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      0, "CHURN_TABLE", db_id, INVALID_OID, 1234, true));
+
+  epoch_manager.StartEpoch(epoch_thread);
+  gc_manager.StartGC(gc_threads);
+
+  churn_txn_count = 0;
+  churn_finished_count = 0;
+  late_inserts_done = false;
+
+  Timer<> timer;
+  timer.Start();
+
+  LaunchParallelTest(churn_thread_count + 1, ChurnTuples, table.get());
+
+  timer.Stop();
+  UNUSED_ATTRIBUTE auto duration = timer.GetDuration();
+
+  gc_manager.StopGC();
+  epoch_manager.StopEpoch();
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+  epoch_thread->join();
+
+  size_t live_tuple_count = churn_thread_count * churn_tuples_per_round;
+  size_t total_tuple_count = live_tuple_count * (churn_round_count + 1);
+
+  LOG_INFO("Duration: %.2lf s, throughput: %.2lf txn/s", duration,
+           churn_txn_count.load() / duration);
+  LOG_INFO("Tile groups: %lu for %lu inserted tuples",
+           table->GetTileGroupCount(), total_tuple_count);
+
+  // without slot reuse, every insert and every delete takes a new slot.
+  EXPECT_LT(table->GetTileGroupCount() * 100, 2 * total_tuple_count);
+
+  // the late inserts fit in the slots freed by the churning threads
+  EXPECT_EQ(late_tile_group_count, table->GetTileGroupCount());
+
+  table.release();
+  TestingExecutorUtil::DeleteDatabase("CHURN_DB");
+  EXPECT_FALSE(storage_manager->HasDatabase(db_id));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -13,13 +13,16 @@
 #include "common/harness.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <thread>
 #include <vector>
 
 #include "common/logger.h"
 #include "common/platform.h"
 #include "common/timer.h"
+#include "index/bwtree_index.h"
 #include "index/index_factory.h"
+#include "index/index_key.h"
 #include "storage/tuple.h"
 
 namespace peloton {
@@ -364,10 +367,169 @@ static void TestIndexPerformance(const IndexType &index_type) {
   return;
 }
 
+/*
+ * TestBatchLookupPerformance() - Tests ScanKeyBatch() throughput for
+ *                                increasing batch sizes
+ *
+ * The keys are probed in a random order, so that most lookups miss the
+ * cache. A batch size of 1 is the same as calling ScanKey() for every key
+ */
+static void TestBatchLookupPerformance(const IndexType &index_type) {
+  std::unique_ptr<index::Index> index(BuildIndex(false, index_type));
+
+  const size_t num_key = 1024 * 1024;
+
+  // The bulk build leaves only consolidated nodes
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  index->StartBulkBuild(1);
+  for (size_t i = 0; i < num_key; i++) {
+    auto key_value = type::ValueFactory::GetIntegerValue(i);
+    key->SetValue(0, key_value, nullptr);
+    key->SetValue(1, key_value, nullptr);
+    index->BulkBuildEntry(0, key.get(), item.get());
+  }
+  index->FinishBulkBuild();
+
+  std::vector<std::unique_ptr<storage::Tuple>> probe_keys;
+  for (size_t i = 0; i < num_key; i++) {
+    auto key_value = type::ValueFactory::GetIntegerValue(i);
+    probe_keys.emplace_back(new storage::Tuple(key_schema, true));
+    probe_keys.back()->SetValue(0, key_value, nullptr);
+    probe_keys.back()->SetValue(1, key_value, nullptr);
+  }
+  std::random_shuffle(probe_keys.begin(), probe_keys.end());
+
+  Timer<> timer;
+
+  for (size_t batch_size = 1; batch_size <= 64; batch_size *= 2) {
+    std::vector<const storage::Tuple *> batch;
+    std::vector<std::vector<ItemPointer *>> results;
+    size_t found_count = 0;
+
+    timer.Reset();
+    timer.Start();
+
+    for (size_t batch_start = 0; batch_start < num_key;
+         batch_start += batch_size) {
+      batch.clear();
+      for (size_t i = batch_start;
+           i < std::min(batch_start + batch_size, num_key); i++) {
+        batch.push_back(probe_keys[i].get());
+      }
+
+      results.clear();
+      index->ScanKeyBatch(batch, results);
+      for (auto &result : results) {
+        found_count += result.size();
+      }
+    }
+
+    timer.Stop();
+    EXPECT_EQ(num_key, found_count);
+    LOG_INFO("BatchLookupTest :: Type=%s; BatchSize=%lu; Lookups/sec=%.0lf",
+             IndexTypeToString(index_type).c_str(), batch_size,
+             num_key / timer.GetDuration());
+  }
+
+  delete tuple_schema;
+
+  return;
+}
+
+/*
+ * TestVarcharKeyPerformance() - Compares a VARCHAR primary key index with
+ *                               normalized keys against generic keys
+ *
+ * The factory picks the normalized key for the (VARCHAR(32), INTEGER) key;
+ * the generic key index is built directly for comparison
+ */
+static void TestVarcharKeyPerformance() {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  std::vector<catalog::Column> columns;
+  columns.emplace_back(type::TypeId::VARCHAR, 32, "A", false);
+  columns.emplace_back(type::TypeId::INTEGER,
+                       type::Type::GetTypeSize(type::TypeId::INTEGER), "B",
+                       true);
+  std::vector<oid_t> key_attrs = {0, 1};
+  std::unique_ptr<catalog::Schema> varchar_tuple_schema(
+      new catalog::Schema(columns));
+
+  auto build_metadata = [&]() {
+    auto varchar_key_schema = new catalog::Schema(columns);
+    varchar_key_schema->SetIndexedColumns(key_attrs);
+    return new index::IndexMetadata(
+        "varchar_index", 125, INVALID_OID, INVALID_OID, IndexType::BWTREE,
+        IndexConstraintType::PRIMARY_KEY, varchar_tuple_schema.get(),
+        varchar_key_schema, key_attrs, true);
+  };
+
+  std::vector<std::pair<std::string, std::unique_ptr<index::Index>>> indexes;
+  indexes.emplace_back("NormalizedKey",
+                       std::unique_ptr<index::Index>(
+                           index::IndexFactory::GetIndex(build_metadata())));
+  indexes.emplace_back(
+      "GenericKey",
+      std::unique_ptr<index::Index>(
+          new index::BWTreeIndex<
+              index::GenericKey<64>, ItemPointer *,
+              index::FastGenericComparator<64>,
+              index::GenericEqualityChecker<64>, index::GenericHasher<64>,
+              ItemPointerComparator, ItemPointerHashFunc>(
+              build_metadata())));
+
+  // Keys share a long prefix, as generated keys often do
+  const size_t num_key = 1024 * 256;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (size_t i = 0; i < num_key; i++) {
+    keys.emplace_back(
+        new storage::Tuple(indexes[0].second->GetKeySchema(), true));
+    keys.back()->SetValue(0, type::ValueFactory::GetVarcharValue(
+                                 "customer_" + std::to_string(i / 4)),
+                          pool);
+    keys.back()->SetValue(1, type::ValueFactory::GetIntegerValue(i % 4), pool);
+  }
+  std::random_shuffle(keys.begin(), keys.end());
+
+  Timer<> timer;
+
+  for (auto &index : indexes) {
+    timer.Reset();
+    timer.Start();
+    for (auto &key : keys) {
+      EXPECT_TRUE(index.second->InsertEntry(key.get(), item.get()));
+    }
+    timer.Stop();
+    LOG_INFO("VarcharKeyTest :: Key=%s; Insert Duration=%.2lf",
+             index.first.c_str(), timer.GetDuration());
+
+    std::vector<ItemPointer *> location_ptrs;
+    timer.Reset();
+    timer.Start();
+    for (auto &key : keys) {
+      index.second->ScanKey(key.get(), location_ptrs);
+    }
+    timer.Stop();
+    EXPECT_EQ(num_key, location_ptrs.size());
+    LOG_INFO("VarcharKeyTest :: Key=%s; Lookup Duration=%.2lf",
+             index.first.c_str(), timer.GetDuration());
+  }
+
+  return;
+}
+
 TEST_F(IndexPerformanceTests, BwTreeMultiThreadedTest) {
   TestIndexPerformance(IndexType::BWTREE);
 }
 
+TEST_F(IndexPerformanceTests, BwTreeBatchLookupTest) {
+  TestBatchLookupPerformance(IndexType::BWTREE);
+}
+
+TEST_F(IndexPerformanceTests, BwTreeVarcharKeyTest) {
+  TestVarcharKeyPerformance();
+}
+
 // TEST_F(IndexPerformanceTests, BTreeMultiThreadedTest) {
 //  TestIndexPerformance(IndexType::BTREE);
 //}
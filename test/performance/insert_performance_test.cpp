@@ -147,5 +147,107 @@ TEST_F(InsertPerformanceTests, LoadingTest) {
                bytes_to_megabytes_converter);
 }
 
+void InsertScalingTuples(storage::DataTable *table, type::AbstractPool *pool,
+                         oid_t tuple_count, uint64_t thread_itr) {
+  std::unique_ptr<storage::Tuple> tuple(
+      TestingExecutorUtil::GetTuple(table, thread_itr, pool));
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    table->InsertTuple(tuple.get());
+  }
+}
+
+// Every inserting thread has its own active tile group, so the insert
+// throughput should scale with the number of threads
+TEST_F(InsertPerformanceTests, InsertScalingTest) {
+  const oid_t tuples_per_tilegroup = TEST_TUPLES_PER_TILEGROUP;
+  const oid_t tuples_per_thread = 20000;
+  const bool build_indexes = false;
+  const size_t max_thread_count = 64;
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto default_active_tilegroup_count =
+      storage::DataTable::default_active_tilegroup_count_;
+
+  for (size_t thread_count = 1; thread_count <= max_thread_count;
+       thread_count *= 2) {
+    storage::DataTable::SetActiveTileGroupCount(thread_count);
+    std::unique_ptr<storage::DataTable> data_table(
+        TestingExecutorUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+
+    Timer<> timer;
+    timer.Start();
+
+    LaunchParallelTest(thread_count, InsertScalingTuples, data_table.get(),
+                       testing_pool, tuples_per_thread);
+
+    timer.Stop();
+    UNUSED_ATTRIBUTE auto duration = timer.GetDuration();
+
+    LOG_INFO("%lu threads: %.2lf tuples/s", thread_count,
+             thread_count * tuples_per_thread / duration);
+
+    EXPECT_EQ(thread_count * tuples_per_thread, data_table->GetTupleCount());
+  }
+
+  storage::DataTable::SetActiveTileGroupCount(default_active_tilegroup_count);
+}
+
+// Compare loading a table a row at a time with loading it in batches
+TEST_F(InsertPerformanceTests, BatchLoadingTest) {
+  const oid_t tuples_per_tilegroup = TEST_TUPLES_PER_TILEGROUP;
+  const oid_t tuple_count = 100000;
+  const oid_t batch_size = 1000;
+  const bool build_indexes = true;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  std::unique_ptr<storage::DataTable> row_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+  std::unique_ptr<storage::DataTable> batch_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> batch;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tuples.push_back(TestingExecutorUtil::GetTuple(row_table.get(), tuple_itr,
+                                                   testing_pool));
+    batch.push_back(tuples.back().get());
+  }
+
+  Timer<> timer;
+
+  // a row at a time
+  timer.Start();
+  auto txn = txn_manager.BeginTransaction();
+  for (auto tuple : batch) {
+    ItemPointer *index_entry_ptr = nullptr;
+    auto location = row_table->InsertTuple(tuple, txn, &index_entry_ptr);
+    txn_manager.PerformInsert(txn, location, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+  timer.Stop();
+  UNUSED_ATTRIBUTE auto row_duration = timer.GetDuration();
+
+  // in batches
+  timer.Reset();
+  timer.Start();
+  txn = txn_manager.BeginTransaction();
+  for (oid_t batch_itr = 0; batch_itr < tuple_count; batch_itr += batch_size) {
+    std::vector<const storage::Tuple *> sub_batch(
+        batch.begin() + batch_itr, batch.begin() + batch_itr + batch_size);
+    EXPECT_TRUE(batch_table->InsertTuples(sub_batch, txn));
+  }
+  txn_manager.CommitTransaction(txn);
+  timer.Stop();
+  UNUSED_ATTRIBUTE auto batch_duration = timer.GetDuration();
+
+  LOG_INFO("Per-row loading: %.2lf tuples/s", tuple_count / row_duration);
+  LOG_INFO("Batch loading: %.2lf tuples/s", tuple_count / batch_duration);
+
+  EXPECT_EQ(row_table->GetTupleCount(), batch_table->GetTupleCount());
+}
+
 }  // namespace test
 }  // namespace peloton
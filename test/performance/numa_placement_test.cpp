@@ -0,0 +1,191 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// numa_placement_test.cpp
+//
+// Identification: test/performance/numa_placement_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+#include "executor/testing_executor_util.h"
+
+#include "common/numa.h"
+#include "common/timer.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// NUMA Placement Tests
+//===--------------------------------------------------------------------===//
+
+class NumaPlacementTests : public PelotonTest {};
+
+static const size_t numa_node_count = 2;
+static const oid_t numa_tuples_per_tilegroup = 100;
+static const oid_t numa_tuples_per_loader = 20000;
+
+std::atomic<size_t> local_insert_count;
+std::atomic<size_t> remote_insert_count;
+std::atomic<size_t> local_scan_count;
+std::atomic<size_t> remote_scan_count;
+
+//===------------------------------===//
+// Utility
+//===------------------------------===//
+
+// Every loader inserts from its own node
+void NumaLoader(storage::DataTable *table, type::AbstractPool *pool,
+                uint64_t thread_itr) {
+  int numa_node = static_cast<int>(thread_itr % numa_node_count);
+  NumaTopology::GetInstance().PinThreadToNode(numa_node);
+
+  std::unique_ptr<storage::Tuple> tuple(
+      TestingExecutorUtil::GetTuple(table, thread_itr, pool));
+
+  for (oid_t tuple_itr = 0; tuple_itr < numa_tuples_per_loader; tuple_itr++) {
+    auto location = table->InsertTuple(tuple.get());
+    if (location.IsNull()) continue;
+
+    auto tile_group = table->GetTileGroupById(location.block);
+    if (tile_group->GetNumaNode() == numa_node) {
+      local_insert_count++;
+    } else {
+      remote_insert_count++;
+    }
+  }
+}
+
+// Reads the first column of every tuple of the tile group
+static int64_t ScanTileGroup(storage::DataTable *table, oid_t offset,
+                             int numa_node) {
+  auto tile_group = table->GetTileGroup(offset);
+  if (tile_group->GetNumaNode() == numa_node) {
+    local_scan_count++;
+  } else {
+    remote_scan_count++;
+  }
+
+  int64_t sum = 0;
+  auto tuple_count = tile_group->GetNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    sum += tile_group->GetValue(tuple_id, 0).GetAs<int32_t>();
+  }
+  return sum;
+}
+
+// Scanners take their node's tile groups first, then steal the others
+void NumaAwareScanner(storage::DataTable *table,
+                      std::vector<std::atomic<bool>> *claimed,
+                      uint64_t thread_itr) {
+  int numa_node = static_cast<int>(thread_itr % numa_node_count);
+  NumaTopology::GetInstance().PinThreadToNode(numa_node);
+
+  auto scan_order = table->GetNumaScanOrder(claimed->size(), numa_node);
+  UNUSED_ATTRIBUTE int64_t sum = 0;
+  for (auto offset : scan_order) {
+    if ((*claimed)[offset].exchange(true) == true) continue;
+    sum += ScanTileGroup(table, offset, numa_node);
+  }
+}
+
+// Scanners take the next tile group, wherever it lives
+void NumaObliviousScanner(storage::DataTable *table,
+                          std::atomic<oid_t> *next_offset,
+                          uint64_t thread_itr) {
+  int numa_node = static_cast<int>(thread_itr % numa_node_count);
+  NumaTopology::GetInstance().PinThreadToNode(numa_node);
+
+  auto tile_group_count = table->GetTileGroupCount();
+  UNUSED_ATTRIBUTE int64_t sum = 0;
+  while (true) {
+    oid_t offset = (*next_offset)++;
+    if (offset >= tile_group_count) break;
+    sum += ScanTileGroup(table, offset, numa_node);
+  }
+}
+
+TEST_F(NumaPlacementTests, LoadAndScanTest) {
+  // Two emulated sockets, so that the test also runs on single-node boxes
+  NumaTopology::GetInstance().Emulate(numa_node_count);
+  storage::DataTable::SetNumaAwarePlacement(true);
+
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(numa_tuples_per_tilegroup, false));
+  EXPECT_EQ(numa_node_count, data_table->GetNumaNodeCount());
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  oid_t scanner_count = 2 * numa_node_count;
+
+  // Load
+  local_insert_count = 0;
+  remote_insert_count = 0;
+
+  Timer<> timer;
+  timer.Start();
+  LaunchParallelTest(numa_node_count, NumaLoader, data_table.get(),
+                     testing_pool);
+  timer.Stop();
+
+  LOG_INFO("Load duration: %.2lf, local inserts: %lu, remote inserts: %lu",
+           timer.GetDuration(), local_insert_count.load(),
+           remote_insert_count.load());
+  EXPECT_EQ(numa_node_count * numa_tuples_per_loader,
+            local_insert_count.load());
+  EXPECT_EQ(0, remote_insert_count.load());
+
+  auto tile_group_count = data_table->GetTileGroupCount();
+
+  // NUMA-oblivious scan
+  local_scan_count = 0;
+  remote_scan_count = 0;
+  std::atomic<oid_t> next_offset(0);
+
+  timer.Reset();
+  timer.Start();
+  LaunchParallelTest(scanner_count, NumaObliviousScanner, data_table.get(),
+                     &next_offset);
+  timer.Stop();
+
+  auto oblivious_local_ratio =
+      static_cast<double>(local_scan_count) / tile_group_count;
+  LOG_INFO("Oblivious scan duration: %.2lf, local tile groups: %.2lf",
+           timer.GetDuration(), oblivious_local_ratio);
+  EXPECT_EQ(tile_group_count, local_scan_count + remote_scan_count);
+
+  // NUMA-aware scan
+  local_scan_count = 0;
+  remote_scan_count = 0;
+  std::vector<std::atomic<bool>> claimed(tile_group_count);
+  for (auto &flag : claimed) flag = false;
+
+  timer.Reset();
+  timer.Start();
+  LaunchParallelTest(scanner_count, NumaAwareScanner, data_table.get(),
+                     &claimed);
+  timer.Stop();
+
+  auto aware_local_ratio =
+      static_cast<double>(local_scan_count) / tile_group_count;
+  LOG_INFO("Aware scan duration: %.2lf, local tile groups: %.2lf",
+           timer.GetDuration(), aware_local_ratio);
+  EXPECT_EQ(tile_group_count, local_scan_count + remote_scan_count);
+  EXPECT_GE(aware_local_ratio, oblivious_local_ratio);
+
+  storage::DataTable::SetNumaAwarePlacement(false);
+  NumaTopology::GetInstance().Detect();
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// radix_join_performance_test.cpp
+//
+// Identification: test/performance/radix_join_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/buffering_consumer.h"
+#include "codegen/operator/hash_join_translator.h"
+#include "common/harness.h"
+#include "common/timer.h"
+#include "expression/tuple_value_expression.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "planner/aggregate_plan.h"
+#include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/table_factory.h"
+
+#include "codegen/testing_codegen_util.h"
+
+namespace peloton {
+namespace test {
+
+typedef std::unique_ptr<const expression::AbstractExpression> AbstractExprPtr;
+
+//===--------------------------------------------------------------------===//
+// Radix Join Performance Tests
+//===--------------------------------------------------------------------===//
+
+// The 100M x 1B join, scaled down by 200 so that the tables load in seconds.
+// The hash table of the build side still outgrows the last-level cache.
+static const uint32_t build_row_count = 1 << 19;
+static const uint32_t probe_row_count = 10 * build_row_count;
+
+// Rows are loaded this many per transaction
+static const uint32_t load_batch_size = 1 << 16;
+
+static const uint32_t join_run_count = 3;
+
+class RadixJoinPerformanceTests : public PelotonCodeGenTest {
+ public:
+  RadixJoinPerformanceTests() : PelotonCodeGenTest() {
+    build_table_ = CreateJoinTable(BuildTableOid(), "build_table");
+    probe_table_ = CreateJoinTable(ProbeTableOid(), "probe_table");
+
+    // Every probe row finds exactly one build row, in random order
+    LoadJoinTable(*build_table_, build_row_count,
+                  [](uint32_t row) { return row; });
+    LoadJoinTable(*probe_table_, probe_row_count, [](uint32_t row) {
+      return static_cast<uint32_t>((row * 2654435761ULL) % build_row_count);
+    });
+  }
+
+  oid_t BuildTableOid() const { return 48; }
+
+  oid_t ProbeTableOid() const { return 49; }
+
+  // A table of two integer columns: the join key and a payload
+  storage::DataTable *CreateJoinTable(oid_t table_oid,
+                                      const std::string &table_name) {
+    const bool is_inlined = true;
+    std::unique_ptr<catalog::Schema> schema{new catalog::Schema(
+        {catalog::Column{type::TypeId::INTEGER, 4, "KEY", is_inlined},
+         catalog::Column{type::TypeId::INTEGER, 4, "PAYLOAD", is_inlined}})};
+
+    const uint32_t tuples_per_tilegroup = 1 << 16;
+    const bool own_schema = true;
+    const bool adapt_table = false;
+    auto *table = storage::TableFactory::GetDataTable(
+        GetDatabase().GetOid(), table_oid, schema.release(), table_name,
+        tuples_per_tilegroup, own_schema, adapt_table);
+    GetDatabase().AddTable(table, false);
+    return table;
+  }
+
+  void LoadJoinTable(storage::DataTable &table, uint32_t num_rows,
+                     std::function<uint32_t(uint32_t)> key) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    for (uint32_t batch = 0; batch < num_rows; batch += load_batch_size) {
+      auto *txn = txn_manager.BeginTransaction();
+      uint32_t batch_end = std::min(num_rows, batch + load_batch_size);
+      for (uint32_t row = batch; row < batch_end; row++) {
+        storage::Tuple tuple{table.GetSchema(), true};
+        tuple.SetValue(0, type::ValueFactory::GetIntegerValue(key(row)));
+        tuple.SetValue(1, type::ValueFactory::GetIntegerValue(row));
+
+        ItemPointer *index_entry_ptr = nullptr;
+        ItemPointer location = table.InsertTuple(&tuple, txn, &index_entry_ptr);
+        PL_ASSERT(location.block != INVALID_OID);
+        txn_manager.PerformInsert(txn, location, index_entry_ptr);
+      }
+      txn_manager.CommitTransaction(txn);
+    }
+  }
+
+  // SELECT COUNT(*) FROM build_table JOIN probe_table
+  //   ON build_table.key = probe_table.key
+  std::unique_ptr<planner::AbstractPlan> MakeJoinPlan() {
+    // The join only passes on the key of the build side
+    DirectMapList join_map_list = {{0, {0, 0}}};
+    std::unique_ptr<planner::ProjectInfo> join_projection{
+        new planner::ProjectInfo(TargetList{}, std::move(join_map_list))};
+    std::shared_ptr<const catalog::Schema> join_schema{
+        new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0)})};
+
+    std::vector<AbstractExprPtr> left_hash_keys;
+    left_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+    std::vector<AbstractExprPtr> right_hash_keys;
+    right_hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+    std::vector<AbstractExprPtr> hash_keys;
+    hash_keys.emplace_back(ColRefExpr(type::TypeId::INTEGER, 0));
+
+    std::unique_ptr<planner::AbstractPlan> hj_plan{new planner::HashJoinPlan(
+        JoinType::INNER, nullptr, std::move(join_projection), join_schema,
+        left_hash_keys, right_hash_keys)};
+    std::unique_ptr<planner::AbstractPlan> hash_plan{
+        new planner::HashPlan(hash_keys)};
+
+    std::unique_ptr<planner::AbstractPlan> build_scan{
+        new planner::SeqScanPlan(build_table_, nullptr, {0, 1})};
+    std::unique_ptr<planner::AbstractPlan> probe_scan{
+        new planner::SeqScanPlan(probe_table_, nullptr, {0, 1})};
+
+    hash_plan->AddChild(std::move(probe_scan));
+    hj_plan->AddChild(std::move(build_scan));
+    hj_plan->AddChild(std::move(hash_plan));
+
+    // Count the joined rows
+    DirectMapList agg_map_list = {{0, {1, 0}}};
+    std::unique_ptr<planner::ProjectInfo> agg_projection{
+        new planner::ProjectInfo(TargetList{}, std::move(agg_map_list))};
+    std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+        {ExpressionType::AGGREGATE_COUNT_STAR,
+         new expression::TupleValueExpression(type::TypeId::INTEGER, 0, 0)}};
+    std::shared_ptr<const catalog::Schema> agg_schema{
+        new catalog::Schema({{type::TypeId::BIGINT, 8, "COUNT_*"}})};
+
+    std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+        std::move(agg_projection), nullptr, std::move(agg_terms), {},
+        agg_schema, AggregateType::HASH)};
+    agg_plan->AddChild(std::move(hj_plan));
+    return agg_plan;
+  }
+
+  // Run the join in the given mode, returning the average time per run in ms
+  double RunJoin(bool use_radix_partitioning) {
+    bool default_use_radix =
+        codegen::HashJoinTranslator::kUseRadixPartitioning;
+    codegen::HashJoinTranslator::kUseRadixPartitioning = use_radix_partitioning;
+
+    double total_ms = 0.0;
+    for (uint32_t run = 0; run < join_run_count; run++) {
+      auto plan = MakeJoinPlan();
+      planner::BindingContext context;
+      plan->PerformBinding(context);
+      codegen::BufferingConsumer buffer{{0}, context};
+
+      Timer<std::ratio<1, 1000>> timer;
+      timer.Start();
+      auto stats = CompileAndExecute(
+          *plan, buffer, reinterpret_cast<char *>(buffer.GetState()));
+      timer.Stop();
+      total_ms += timer.GetDuration() -
+                  (stats.setup_ms + stats.ir_gen_ms + stats.jit_ms);
+
+      const auto &results = buffer.GetOutputTuples();
+      EXPECT_EQ(1, results.size());
+      EXPECT_TRUE(results[0].GetValue(0).CompareEquals(
+                      type::ValueFactory::GetBigIntValue(probe_row_count)) ==
+                  type::CMP_TRUE);
+    }
+
+    codegen::HashJoinTranslator::kUseRadixPartitioning = default_use_radix;
+    return total_ms / join_run_count;
+  }
+
+ private:
+  storage::DataTable *build_table_;
+  storage::DataTable *probe_table_;
+};
+
+TEST_F(RadixJoinPerformanceTests, LargeBuildJoinTest) {
+  auto single_table_ms = RunJoin(false);
+  auto radix_ms = RunJoin(true);
+
+  LOG_INFO("%u x %u join: single hash table %.2lf ms, radix partitioned "
+           "%.2lf ms (%.2lfx)",
+           build_row_count, probe_row_count, single_table_ms, radix_ms,
+           single_table_ms / radix_ms);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,222 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// copy_sql_test.cpp
+//
+// Identification: test/sql/copy_sql_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+#include "sql/testing_sql_util.h"
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+class CopySQLTests : public PelotonTest {};
+
+// Enough rows to fill several tile groups and input chunks
+static const int kCopyRowCount = 20000;
+
+void WriteCopyInputFile(const std::string &file_path, bool csv) {
+  std::ofstream file(file_path);
+  if (csv) {
+    file << "a,b,c\n";
+  }
+  for (int i = 0; i < kCopyRowCount; i++) {
+    if (csv) {
+      // Quoted fields may contain the delimiter, quotes and line breaks
+      file << i << ",\"name " << i << ", \"\"quoted\"\"\nline\"," << i * 0.5
+           << "\r\n";
+    } else {
+      // \N is NULL in the text format
+      file << i << "\tname\\t" << i << "\t";
+      if (i % 2 == 0) {
+        file << "\\N";
+      } else {
+        file << i * 0.5;
+      }
+      file << "\n";
+    }
+  }
+}
+
+TEST_F(CopySQLTests, CopyFromTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  for (bool csv : {true, false}) {
+    TestingSQLUtil::ExecuteSQLQuery(
+        "CREATE TABLE test(a INT PRIMARY KEY, b VARCHAR(64), c DECIMAL);");
+
+    std::string file_path = csv ? "./copy_input.csv" : "./copy_input.txt";
+    WriteCopyInputFile(file_path, csv);
+
+    std::string copy_sql =
+        "COPY test FROM '" + file_path + "'" +
+        (csv ? " WITH (FORMAT csv, HEADER);" : ";");
+    ResultType status = TestingSQLUtil::ExecuteSQLQuery(
+        copy_sql, result, tuple_descriptor, rows_affected, error_message);
+    EXPECT_EQ(ResultType::SUCCESS, status);
+    EXPECT_EQ(kCopyRowCount, rows_affected);
+
+    // All the rows are visible to later transactions
+    TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+    EXPECT_EQ(kCopyRowCount, result.size());
+
+    // The primary key index was built after the load
+    TestingSQLUtil::ExecuteSQLQuery("SELECT b, c FROM test WHERE a = 7;",
+                                    result);
+    EXPECT_EQ(2, result.size());
+    if (csv) {
+      EXPECT_EQ("name 7, \"quoted\"\nline",
+                TestingSQLUtil::GetResultValueAsString(result, 0));
+    } else {
+      EXPECT_EQ("name\t7", TestingSQLUtil::GetResultValueAsString(result, 0));
+    }
+
+    // Loading the keys again violates the primary key, and loads nothing
+    status = TestingSQLUtil::ExecuteSQLQuery(
+        copy_sql, result, tuple_descriptor, rows_affected, error_message);
+    EXPECT_EQ(ResultType::ABORTED, status);
+    TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+    EXPECT_EQ(kCopyRowCount, result.size());
+
+    std::remove(file_path.c_str());
+    TestingSQLUtil::ExecuteSQLQuery("DROP TABLE test;");
+  }
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+// Counts the tuples of the table that are visible to a new transaction
+size_t CountVisibleTuples(const std::string &table_name) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto table = catalog::Catalog::GetInstance()->GetTableWithName(
+      DEFAULT_DB_NAME, table_name, txn);
+
+  size_t visible_count = 0;
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    auto tile_group_header = tile_group->GetHeader();
+    auto tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        visible_count++;
+      }
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+  return visible_count;
+}
+
+TEST_F(CopySQLTests, CopyFromRollbackTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b VARCHAR(64), c DECIMAL);");
+  std::string file_path = "./copy_input.txt";
+  WriteCopyInputFile(file_path, false);
+  std::string copy_sql = "COPY test FROM '" + file_path + "';";
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  // The loaded rows are only visible to the loading transaction
+  TestingSQLUtil::ExecuteSQLQuery("BEGIN;");
+  ResultType status = TestingSQLUtil::ExecuteSQLQuery(
+      copy_sql, result, tuple_descriptor, rows_affected, error_message);
+  EXPECT_EQ(ResultType::SUCCESS, status);
+  EXPECT_EQ(kCopyRowCount, rows_affected);
+  TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+  EXPECT_EQ(kCopyRowCount, result.size());
+  EXPECT_EQ(0, CountVisibleTuples("test"));
+
+  // Rolling back drops them, and their keys
+  TestingSQLUtil::ExecuteSQLQuery("ROLLBACK;");
+  TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+  EXPECT_EQ(0, result.size());
+  EXPECT_EQ(0, CountVisibleTuples("test"));
+
+  status = TestingSQLUtil::ExecuteSQLQuery(
+      copy_sql, result, tuple_descriptor, rows_affected, error_message);
+  EXPECT_EQ(ResultType::SUCCESS, status);
+  EXPECT_EQ(kCopyRowCount, CountVisibleTuples("test"));
+
+  std::remove(file_path.c_str());
+  TestingSQLUtil::ExecuteSQLQuery("DROP TABLE test;");
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(CopySQLTests, CopyFromInvalidInputTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  TestingSQLUtil::ExecuteSQLQuery("CREATE TABLE test(a INT, b INT NOT NULL);");
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  // A value that isn't an integer, a missing column, and a NULL
+  for (std::string line : {"1,x", "1", "1,"}) {
+    {
+      std::ofstream file("./copy_input.csv");
+      file << "1,1\n" << line << "\n";
+    }
+    ResultType status = TestingSQLUtil::ExecuteSQLQuery(
+        "COPY test FROM './copy_input.csv' CSV;", result, tuple_descriptor,
+        rows_affected, error_message);
+    EXPECT_EQ(ResultType::FAILURE, status);
+    EXPECT_FALSE(error_message.empty());
+  }
+  std::remove("./copy_input.csv");
+
+  // Nothing was loaded
+  TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+  EXPECT_EQ(0, result.size());
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_sql_test.cpp
+//
+// Identification: test/sql/explain_sql_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "sql/testing_sql_util.h"
+#include "catalog/catalog.h"
+#include "common/harness.h"
+#include "configuration/configuration.h"
+
+namespace peloton {
+namespace test {
+
+class ExplainSQLTests : public PelotonTest {};
+
+void CreateAndLoadExplainTable() {
+  // Create a table first
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT, c INT);");
+
+  // Insert tuples into table
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (1, 22, 333);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (2, 22, 333);");
+  TestingSQLUtil::ExecuteSQLQuery("INSERT INTO test VALUES (3, 11, 222);");
+}
+
+// Returns the report lines that contain the string
+size_t CountReportLines(const std::vector<StatementResult> &result,
+                        const std::string &str) {
+  size_t count = 0;
+  for (size_t i = 0; i < result.size(); i++) {
+    auto line = TestingSQLUtil::GetResultValueAsString(result, i);
+    LOG_INFO("%s", line.c_str());
+    if (line.find(str) != std::string::npos) count++;
+  }
+  return count;
+}
+
+TEST_F(ExplainSQLTests, ExplainTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  CreateAndLoadExplainTable();
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  // The plan is returned as a single text column, without running the query
+  ResultType status = TestingSQLUtil::ExecuteSQLQuery(
+      "EXPLAIN SELECT a FROM test WHERE b = 22;", result, tuple_descriptor,
+      rows_affected, error_message);
+  EXPECT_EQ(ResultType::SUCCESS, status);
+  EXPECT_EQ(1, tuple_descriptor.size());
+  EXPECT_EQ("QUERY PLAN", std::get<0>(tuple_descriptor[0]));
+  EXPECT_EQ(1, CountReportLines(result, "SEQSCAN"));
+  EXPECT_EQ(0, CountReportLines(result, "time="));
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(ExplainSQLTests, ExplainAnalyzeTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+
+  CreateAndLoadExplainTable();
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  // Both on the interpreted and the compiled path
+  bool codegen = FLAGS_codegen;
+  for (bool use_codegen : {false, true}) {
+    FLAGS_codegen = use_codegen;
+
+    ResultType status = TestingSQLUtil::ExecuteSQLQuery(
+        "EXPLAIN ANALYZE SELECT a FROM test WHERE b = 22;", result,
+        tuple_descriptor, rows_affected, error_message);
+    EXPECT_EQ(ResultType::SUCCESS, status);
+    EXPECT_EQ(1, tuple_descriptor.size());
+
+    // The scan ran and output the two matching rows
+    EXPECT_EQ(1, CountReportLines(result, "SEQSCAN"));
+    EXPECT_EQ(1, CountReportLines(result, "out=2 "));
+    EXPECT_EQ(1, CountReportLines(result, "Execution time:"));
+
+    // Hardware counters are only reported when available
+    status = TestingSQLUtil::ExecuteSQLQuery(
+        "EXPLAIN (ANALYZE, COUNTERS) SELECT a FROM test WHERE b = 22;", result,
+        tuple_descriptor, rows_affected, error_message);
+    EXPECT_EQ(ResultType::SUCCESS, status);
+    EXPECT_EQ(1, CountReportLines(result, "out=2 "));
+  }
+  FLAGS_codegen = codegen;
+
+  // The explained query ran in its own transaction, and left the table as is
+  TestingSQLUtil::ExecuteSQLQuery("SELECT a FROM test;", result);
+  EXPECT_EQ(3, result.size());
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -24,6 +24,7 @@
 #include "executor/executor_context.h"
 #include "executor/insert_executor.h"
 #include "statistics/backend_stats_context.h"
+#include "statistics/latency_histogram.h"
 #include "statistics/stats_aggregator.h"
 #include "tcop/tcop.h"
 
@@ -193,6 +194,111 @@ TEST_F(StatsTests, MultiThreadStatsTest) {
   catalog->DropDatabaseWithName("emp_db", txn);
   txn_manager.CommitTransaction(txn);
 }
+TEST_F(StatsTests, LatencyHistogramTest) {
+  stats::LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.GetCount());
+  EXPECT_EQ(0.0, histogram.GetPercentile(50));
+
+  // Small latencies have a bucket of their own
+  for (uint64_t latency_us = 0;
+       latency_us < stats::LatencyHistogram::SUB_BUCKET_COUNT; latency_us++) {
+    auto bucket_index = stats::LatencyHistogram::GetBucketIndex(latency_us);
+    EXPECT_EQ(latency_us, bucket_index);
+    EXPECT_EQ(latency_us,
+              stats::LatencyHistogram::GetBucketLowerBound(bucket_index));
+  }
+
+  // Larger latencies fall in a bucket within ~3% of them
+  for (uint64_t latency_us = 1; latency_us < (1UL << 40); latency_us *= 3) {
+    auto bucket_index = stats::LatencyHistogram::GetBucketIndex(latency_us);
+    EXPECT_LT(bucket_index, stats::LatencyHistogram::BUCKET_COUNT);
+    if (latency_us >= (1UL << stats::LatencyHistogram::MAX_LATENCY_BITS)) {
+      continue;
+    }
+    auto lower_bound =
+        stats::LatencyHistogram::GetBucketLowerBound(bucket_index);
+    auto upper_bound =
+        stats::LatencyHistogram::GetBucketUpperBound(bucket_index);
+    EXPECT_LE(lower_bound, latency_us);
+    EXPECT_GE(upper_bound, latency_us);
+    EXPECT_LE(upper_bound - lower_bound, latency_us / 16);
+  }
+
+  // 1 ms to 1000 ms
+  for (int latency_ms = 1; latency_ms <= 1000; latency_ms++) {
+    histogram.Record(latency_ms);
+  }
+  EXPECT_EQ(1000, histogram.GetCount());
+  EXPECT_DOUBLE_EQ(1.0, histogram.GetMin());
+  EXPECT_DOUBLE_EQ(1000.0, histogram.GetMax());
+  EXPECT_NEAR(500.5, histogram.GetAverage(), 0.01);
+  EXPECT_NEAR(250, histogram.GetPercentile(25), 250 * 0.03);
+  EXPECT_NEAR(500, histogram.GetPercentile(50), 500 * 0.03);
+  EXPECT_NEAR(990, histogram.GetPercentile(99), 990 * 0.03);
+
+  // Adding a histogram adds its latencies
+  stats::LatencyHistogram other_histogram;
+  other_histogram.Record(5000);
+  histogram.Add(other_histogram);
+  EXPECT_EQ(1001, histogram.GetCount());
+  EXPECT_DOUBLE_EQ(5000.0, histogram.GetMax());
+
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.GetCount());
+}
+
+TEST_F(StatsTests, TableAccessCountersTest) {
+  std::unique_ptr<stats::BackendStatsContext> worker_stats(
+      new stats::BackendStatsContext(false));
+  std::unique_ptr<stats::BackendStatsContext> aggregated_stats(
+      new stats::BackendStatsContext(false));
+
+  oid_t db_oid = 12345;
+  oid_t table_oid = 12346;
+
+  // Too large to be counted by the per-thread counters
+  oid_t large_table_oid = stats::TableAccessCounters::MAX_TABLE_OID + 1;
+
+  for (int i = 0; i < NUM_TABLE_READ; i++) {
+    worker_stats->IncrementTableReads(db_oid, table_oid);
+    worker_stats->IncrementTableReads(db_oid, large_table_oid);
+  }
+  for (int i = 0; i < NUM_TABLE_UPDATE; i++) {
+    worker_stats->IncrementTableUpdates(db_oid, table_oid);
+  }
+  for (int i = 0; i < NUM_TABLE_INSERT; i++) {
+    worker_stats->IncrementTableInserts(db_oid, table_oid);
+  }
+  for (int i = 0; i < NUM_TABLE_DELETE; i++) {
+    worker_stats->IncrementTableDeletes(db_oid, table_oid);
+  }
+
+  // Aggregate twice, as the aggregator does every interval
+  for (int aggregation = 0; aggregation < 2; aggregation++) {
+    aggregated_stats->Reset();
+    aggregated_stats->Aggregate(*worker_stats);
+
+    auto table_access =
+        aggregated_stats->GetTableMetric(db_oid, table_oid)->GetTableAccess();
+    EXPECT_EQ(NUM_TABLE_READ, table_access.GetReads());
+    EXPECT_EQ(NUM_TABLE_UPDATE, table_access.GetUpdates());
+    EXPECT_EQ(NUM_TABLE_INSERT, table_access.GetInserts());
+    EXPECT_EQ(NUM_TABLE_DELETE, table_access.GetDeletes());
+
+    auto large_table_access =
+        aggregated_stats->GetTableMetric(db_oid, large_table_oid)
+            ->GetTableAccess();
+    EXPECT_EQ(NUM_TABLE_READ, large_table_access.GetReads());
+  }
+
+  worker_stats->Reset();
+  aggregated_stats->Reset();
+  aggregated_stats->Aggregate(*worker_stats);
+  EXPECT_EQ(0, aggregated_stats->GetTableMetric(db_oid, table_oid)
+                   ->GetTableAccess()
+                   .GetReads());
+}
+
 //
 // TEST_F(StatsTests, PerThreadStatsTest) {
 //  FLAGS_stats_mode = STATS_TYPE_ENABLE;
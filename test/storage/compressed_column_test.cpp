@@ -0,0 +1,294 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_column_test.cpp
+//
+// Identification: test/storage/compressed_column_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "executor/testing_executor_util.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/compressed_column.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_freezer.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compressed Column Tests
+//===--------------------------------------------------------------------===//
+
+class CompressedColumnTests : public PelotonTest {};
+
+// Number of tuples per tile group. The table is populated with one full tile
+// group, that can be frozen, and one half-full tile group, that cannot.
+const int compressed_tuple_count = 200;
+const int populated_tuple_count = 300;
+
+storage::DataTable *CreateFrozenTable() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(compressed_tuple_count, false));
+  // Column 0 has two long runs (run-length), column 1 is unique
+  // (frame-of-reference) and column 3 is a varchar (dictionary)
+  TestingExecutorUtil::PopulateTable(table.get(), populated_tuple_count, false,
+                                     false, true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto frozen_count =
+      storage::TileGroupFreezer::GetInstance().FreezeTable(table.get(), MAX_CID);
+  EXPECT_EQ(1, frozen_count);
+
+  return table.release();
+}
+
+TEST_F(CompressedColumnTests, EncodingTest) {
+  std::unique_ptr<storage::DataTable> table(CreateFrozenTable());
+
+  auto tile_group = table->GetTileGroup(0);
+  EXPECT_TRUE(tile_group->IsFrozen());
+
+  auto compressed_tile_group = tile_group->GetCompressedTileGroup();
+  ASSERT_TRUE(compressed_tile_group != nullptr);
+  EXPECT_EQ(compressed_tuple_count, compressed_tile_group->GetTupleCount());
+
+  EXPECT_EQ(ColumnEncodingType::RUN_LENGTH,
+            compressed_tile_group->GetColumn(0)->GetEncodingType());
+  EXPECT_EQ(ColumnEncodingType::FRAME_OF_REFERENCE,
+            compressed_tile_group->GetColumn(1)->GetEncodingType());
+  // Decimals are not compressed
+  EXPECT_TRUE(compressed_tile_group->GetColumn(2) == nullptr);
+  EXPECT_EQ(ColumnEncodingType::DICTIONARY,
+            compressed_tile_group->GetColumn(3)->GetEncodingType());
+
+  // Every compressed value must decode to the value stored in the tiles
+  for (oid_t column_id : {0, 1, 3}) {
+    auto column = compressed_tile_group->GetColumn(column_id);
+    for (oid_t tuple_id = 0; tuple_id < compressed_tuple_count; tuple_id++) {
+      auto expected = tile_group->GetValue(tuple_id, column_id);
+      auto actual = column->GetValue(tuple_id);
+      EXPECT_EQ(type::CMP_TRUE, expected.CompareEquals(actual));
+    }
+  }
+
+  EXPECT_LT(compressed_tile_group->GetCompressedSize(),
+            compressed_tile_group->GetUncompressedSize());
+  LOG_INFO("Compressed columns : %lu -> %lu bytes",
+           compressed_tile_group->GetUncompressedSize(),
+           compressed_tile_group->GetCompressedSize());
+
+  // Thawing drops the compressed copy
+  tile_group->Thaw();
+  EXPECT_FALSE(tile_group->IsFrozen());
+  EXPECT_TRUE(tile_group->GetCompressedTileGroup() == nullptr);
+
+  // Tile groups that are not full can never be frozen
+  auto active_tile_group = table->GetTileGroup(1);
+  EXPECT_FALSE(active_tile_group->IsFrozen());
+  EXPECT_FALSE(storage::TileGroupFreezer::IsFreezable(active_tile_group.get(),
+                                                      MAX_CID));
+}
+
+TEST_F(CompressedColumnTests, ReleaseTest) {
+  // Column 2 is not compressed, so only the other tiles can be released
+  peloton_layout_mode = LAYOUT_TYPE_COLUMN;
+  std::unique_ptr<storage::DataTable> table(CreateFrozenTable());
+  peloton_layout_mode = LAYOUT_TYPE_ROW;
+
+  auto tile_group = table->GetTileGroup(0);
+  ASSERT_TRUE(tile_group->IsFrozen());
+
+  std::vector<std::vector<type::Value>> expected_values(4);
+  for (oid_t column_id = 0; column_id < 4; column_id++) {
+    for (oid_t tuple_id = 0; tuple_id < compressed_tuple_count; tuple_id++) {
+      expected_values[column_id].push_back(
+          tile_group->GetValue(tuple_id, column_id).Copy());
+    }
+  }
+
+  // Nothing is released while a transaction may hold on to the raw tiles
+  EXPECT_EQ(0UL, tile_group->ReleaseTiles(0));
+  EXPECT_FALSE(tile_group->IsReleased());
+
+  EXPECT_LT(0UL, tile_group->ReleaseTiles(MAX_EID));
+  EXPECT_TRUE(tile_group->IsReleased());
+  oid_t tile_offset, tile_column_offset;
+  tile_group->LocateTileAndColumn(2, tile_offset, tile_column_offset);
+  EXPECT_FALSE(tile_group->GetTileReference(tile_offset)->IsDataReleased());
+
+  // The raw tiles are re-materialized on their next access
+  for (oid_t column_id = 0; column_id < 4; column_id++) {
+    for (oid_t tuple_id = 0; tuple_id < compressed_tuple_count; tuple_id++) {
+      auto actual = tile_group->GetValue(tuple_id, column_id);
+      EXPECT_EQ(type::CMP_TRUE,
+                expected_values[column_id][tuple_id].CompareEquals(actual));
+    }
+  }
+  EXPECT_FALSE(tile_group->IsReleased());
+  EXPECT_TRUE(tile_group->IsFrozen());
+
+  // Thawing a released tile group re-materializes it first
+  EXPECT_LT(0UL, tile_group->ReleaseTiles(MAX_EID));
+  tile_group->Thaw();
+  EXPECT_FALSE(tile_group->IsReleased());
+  EXPECT_FALSE(tile_group->IsFrozen());
+  for (oid_t tuple_id = 0; tuple_id < compressed_tuple_count; tuple_id++) {
+    auto actual = tile_group->GetValue(tuple_id, 3);
+    EXPECT_EQ(type::CMP_TRUE,
+              expected_values[3][tuple_id].CompareEquals(actual));
+  }
+
+  // Reclaimed slots do not keep a tile group from being frozen
+  tile_group->GetHeader()->SetTransactionId(0, INVALID_TXN_ID);
+  EXPECT_TRUE(storage::TileGroupFreezer::IsFreezable(tile_group.get(),
+                                                     MAX_CID));
+}
+
+TEST_F(CompressedColumnTests, PredicateTest) {
+  std::unique_ptr<storage::DataTable> table(CreateFrozenTable());
+
+  auto tile_group = table->GetTileGroup(0);
+  auto compressed_tile_group = tile_group->GetCompressedTileGroup();
+  ASSERT_TRUE(compressed_tile_group != nullptr);
+
+  std::vector<ExpressionType> comparisons = {
+      ExpressionType::COMPARE_EQUAL, ExpressionType::COMPARE_NOTEQUAL,
+      ExpressionType::COMPARE_LESSTHAN,
+      ExpressionType::COMPARE_LESSTHANOREQUALTO,
+      ExpressionType::COMPARE_GREATERTHAN,
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO};
+
+  // Constants inside and outside of the range of every column
+  std::vector<std::pair<oid_t, type::Value>> constants = {
+      {0, type::ValueFactory::GetIntegerValue(10)},
+      {0, type::ValueFactory::GetIntegerValue(-5)},
+      {1, type::ValueFactory::GetIntegerValue(
+              TestingExecutorUtil::PopulatedValue(150, 1))},
+      {1, type::ValueFactory::GetIntegerValue(
+              TestingExecutorUtil::PopulatedValue(150, 1) + 3)},
+      {1, type::ValueFactory::GetBigIntValue(1000000)},
+      {1, type::ValueFactory::GetIntegerValue(0)},
+      {3, type::ValueFactory::GetVarcharValue(
+              std::to_string(TestingExecutorUtil::PopulatedValue(150, 3)))},
+      {3, type::ValueFactory::GetVarcharValue("2")},
+      {3, type::ValueFactory::GetVarcharValue("zzz")}};
+
+  for (auto &constant : constants) {
+    auto column = compressed_tile_group->GetColumn(constant.first);
+    for (auto comparison : comparisons) {
+      std::vector<bool> matches(compressed_tuple_count, true);
+      EXPECT_TRUE(column->EvaluatePredicate(comparison, constant.second,
+                                            matches));
+
+      for (oid_t tuple_id = 0; tuple_id < compressed_tuple_count; tuple_id++) {
+        auto value = tile_group->GetValue(tuple_id, constant.first);
+        type::CmpBool expected = type::CMP_FALSE;
+        switch (comparison) {
+          case ExpressionType::COMPARE_EQUAL:
+            expected = value.CompareEquals(constant.second);
+            break;
+          case ExpressionType::COMPARE_NOTEQUAL:
+            expected = value.CompareNotEquals(constant.second);
+            break;
+          case ExpressionType::COMPARE_LESSTHAN:
+            expected = value.CompareLessThan(constant.second);
+            break;
+          case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            expected = value.CompareLessThanEquals(constant.second);
+            break;
+          case ExpressionType::COMPARE_GREATERTHAN:
+            expected = value.CompareGreaterThan(constant.second);
+            break;
+          default:
+            expected = value.CompareGreaterThanEquals(constant.second);
+            break;
+        }
+        EXPECT_EQ(expected == type::CMP_TRUE, matches[tuple_id]);
+      }
+    }
+  }
+
+  // Decimal constants are not evaluated on integer encodings
+  std::vector<bool> matches(compressed_tuple_count, true);
+  EXPECT_FALSE(compressed_tile_group->GetColumn(1)->EvaluatePredicate(
+      ExpressionType::COMPARE_EQUAL, type::ValueFactory::GetDecimalValue(1.0),
+      matches));
+}
+
+TEST_F(CompressedColumnTests, FrozenSeqScanTest) {
+  std::unique_ptr<storage::DataTable> table(CreateFrozenTable());
+
+  // COL_B >= PopulatedValue(50, 1) AND COL_D < PopulatedValue(150, 3)
+  // (string comparison)
+  auto lower_bound = TestingExecutorUtil::PopulatedValue(50, 1);
+  auto upper_bound =
+      std::to_string(TestingExecutorUtil::PopulatedValue(150, 3));
+  auto predicate = expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::TupleValueFactory(type::TypeId::INTEGER,
+                                                        0, 1),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(lower_bound))),
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type::TypeId::VARCHAR,
+                                                        0, 3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetVarcharValue(upper_bound))));
+
+  // Expected result computed on the uncompressed tiles
+  size_t expected_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < populated_tuple_count; tuple_id++) {
+    auto str = std::to_string(TestingExecutorUtil::PopulatedValue(tuple_id, 3));
+    if (TestingExecutorUtil::PopulatedValue(tuple_id, 1) >= lower_bound &&
+        str < upper_bound) {
+      expected_count++;
+    }
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  std::vector<oid_t> column_ids({0, 1, 3});
+  planner::SeqScanPlan node(table.get(), predicate, column_ids);
+  executor::SeqScanExecutor executor(&node, context.get());
+
+  EXPECT_TRUE(executor.Init());
+  size_t result_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      auto value = result_tile->GetValue(tuple_id, 1);
+      EXPECT_GE(value.GetAs<int32_t>(), lower_bound);
+      result_count++;
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(expected_count, result_count);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -14,9 +14,11 @@
 
 #include "storage/data_table.h"
 
+#include "catalog/manager.h"
 #include "executor/testing_executor_util.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
+#include "type/value_peeker.h"
 
 #include "concurrency/transaction_manager_factory.h"
 
@@ -72,8 +74,143 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
   data_table->TransformTileGroup(0, theta);
 }
 
+TEST_F(DataTableTests, LayoutCountsTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Every tile group starts out in the same layout
+  auto layout_counts = data_table->GetLayoutCounts();
+  EXPECT_EQ(1U, layout_counts.size());
+  EXPECT_EQ(data_table->GetTileGroupCount(), layout_counts.begin()->second);
+
+  storage::column_map_type column_map;
+  column_map[0] = std::make_pair(0, 0);
+  column_map[1] = std::make_pair(0, 1);
+  column_map[2] = std::make_pair(1, 0);
+  column_map[3] = std::make_pair(1, 1);
+  data_table->SetDefaultLayout(column_map);
+
+  // The transformed tile group moves over to the new layout
+  EXPECT_NE(nullptr, data_table->TransformTileGroup(0, 0.0));
+  layout_counts = data_table->GetLayoutCounts();
+  EXPECT_EQ(1U, layout_counts[column_map]);
+
+  size_t counted_tile_groups = 0;
+  for (auto &entry : layout_counts) {
+    counted_tile_groups += entry.second;
+  }
+  EXPECT_EQ(data_table->GetTileGroupCount(), counted_tile_groups);
+}
+
+TEST_F(DataTableTests, InsertTuplesTest) {
+  // the batch spans several tile groups
+  const int tuples_per_tilegroup = 5;
+  const int tuple_count = 12;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuples_per_tilegroup, true));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> batch;
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tuples.push_back(
+        TestingExecutorUtil::GetTuple(data_table.get(), tuple_itr,
+                                      testing_pool));
+    batch.push_back(tuples.back().get());
+  }
+
+  auto txn = txn_manager.BeginTransaction();
+  std::vector<ItemPointer> locations;
+  EXPECT_TRUE(data_table->InsertTuples(batch, txn, &locations));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_EQ(tuple_count, (int)locations.size());
+  EXPECT_EQ(tuple_count, (int)data_table->GetTupleCount());
+
+  auto &manager = catalog::Manager::GetInstance();
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    auto &location = locations[tuple_itr];
+    // the slots are reserved in contiguous ranges
+    if (tuple_itr > 0 && location.block == locations[tuple_itr - 1].block) {
+      EXPECT_EQ(locations[tuple_itr - 1].offset + 1, location.offset);
+    }
+
+    auto tile_group = manager.GetTileGroup(location.block);
+    auto tile_group_header = tile_group->GetHeader();
+    EXPECT_EQ(INITIAL_TXN_ID,
+              tile_group_header->GetTransactionId(location.offset));
+    EXPECT_NE(MAX_CID, tile_group_header->GetBeginCommitId(location.offset));
+    EXPECT_EQ(TestingExecutorUtil::PopulatedValue(tuple_itr, 0),
+              type::ValuePeeker::PeekInteger(
+                  tile_group->GetValue(location.offset, 0)));
+    EXPECT_EQ(TestingExecutorUtil::PopulatedValue(tuple_itr, 1),
+              type::ValuePeeker::PeekInteger(
+                  tile_group->GetValue(location.offset, 1)));
+  }
+
+  // a duplicate key within the batch violates the primary key
+  tuples.clear();
+  batch.clear();
+  for (int tuple_itr = tuple_count; tuple_itr < tuple_count + 3; tuple_itr++) {
+    tuples.push_back(
+        TestingExecutorUtil::GetTuple(data_table.get(), tuple_count,
+                                      testing_pool));
+    batch.push_back(tuples.back().get());
+  }
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(data_table->InsertTuples(batch, txn));
+  EXPECT_EQ(ResultType::ABORTED, txn_manager.AbortTransaction(txn));
+
+  EXPECT_EQ(tuple_count, (int)data_table->GetTupleCount());
+}
+
 std::unique_ptr<storage::DataTable> data_table_test_table;
 
+void InsertActiveTuples(storage::DataTable *table, type::AbstractPool *pool,
+                        oid_t tuple_count, uint64_t thread_itr) {
+  std::unique_ptr<storage::Tuple> tuple(
+      TestingExecutorUtil::GetTuple(table, thread_itr, pool));
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    table->InsertTuple(tuple.get());
+  }
+}
+
+TEST_F(DataTableTests, ActiveTileGroupGrowthTest) {
+  const size_t thread_count = 4;
+  const oid_t tuples_per_thread = 10 * TESTS_TUPLES_PER_TILEGROUP;
+
+  auto default_active_tilegroup_count =
+      storage::DataTable::default_active_tilegroup_count_;
+  storage::DataTable::SetActiveTileGroupCount(thread_count);
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+
+  // A new table only has a single active tile group
+  EXPECT_EQ(1U, data_table->GetActiveTileGroupCount());
+  EXPECT_EQ(1U, data_table->GetTileGroupCount());
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  LaunchParallelTest(thread_count, InsertActiveTuples, data_table.get(),
+                     testing_pool, tuples_per_thread);
+
+  // Contending inserters may open more, up to the maximum
+  EXPECT_LE(data_table->GetActiveTileGroupCount(), thread_count);
+  EXPECT_EQ(thread_count * tuples_per_thread, data_table->GetTupleCount());
+
+  storage::DataTable::SetActiveTileGroupCount(default_active_tilegroup_count);
+}
+
 TEST_F(DataTableTests, GlobalTableTest) {
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
 
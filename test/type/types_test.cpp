@@ -102,6 +102,30 @@ TEST_F(TypesTests, BackendTypeTest) {
                peloton::Exception);
 }
 
+TEST_F(TypesTests, ColumnEncodingTypeTest) {
+  std::vector<ColumnEncodingType> list = {
+      ColumnEncodingType::INVALID, ColumnEncodingType::UNCOMPRESSED,
+      ColumnEncodingType::DICTIONARY, ColumnEncodingType::FRAME_OF_REFERENCE,
+      ColumnEncodingType::RUN_LENGTH};
+
+  // Make sure that ToString and FromString work
+  for (auto val : list) {
+    std::string str = peloton::ColumnEncodingTypeToString(val);
+    EXPECT_TRUE(str.size() > 0);
+
+    auto newVal = peloton::StringToColumnEncodingType(str);
+    EXPECT_EQ(val, newVal);
+  }
+
+  // Then make sure that we can't cast garbage
+  std::string invalid("WU TANG");
+  EXPECT_THROW(peloton::StringToColumnEncodingType(invalid),
+               peloton::Exception);
+  EXPECT_THROW(peloton::ColumnEncodingTypeToString(
+                   static_cast<ColumnEncodingType>(-99999)),
+               peloton::Exception);
+}
+
 TEST_F(TypesTests, TypeIdTest) {
   std::vector<type::TypeId> list = {
       type::TypeId::INVALID,   type::TypeId::PARAMETER_OFFSET,
@@ -136,7 +160,8 @@ TEST_F(TypesTests, StatementTypeTest) {
       StatementType::DROP,    StatementType::PREPARE,
       StatementType::EXECUTE, StatementType::RENAME,
       StatementType::ALTER,   StatementType::TRANSACTION,
-      StatementType::COPY};
+      StatementType::COPY,    StatementType::ANALYZE,
+      StatementType::EXPLAIN};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -329,7 +354,8 @@ TEST_F(TypesTests, HybridScanTypeTest) {
 TEST_F(TypesTests, JoinTypeTest) {
   std::vector<JoinType> list = {JoinType::INVALID, JoinType::LEFT,
                                 JoinType::RIGHT,   JoinType::INNER,
-                                JoinType::OUTER,   JoinType::SEMI};
+                                JoinType::OUTER,   JoinType::SEMI,
+                                JoinType::ANTI};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -534,7 +560,8 @@ TEST_F(TypesTests, GarbageCollectionTypeTest) {
 TEST_F(TypesTests, ProtocolTypeTest) {
   std::vector<ProtocolType> list = {
       ProtocolType::INVALID, 
-      ProtocolType::TIMESTAMP_ORDERING
+      ProtocolType::TIMESTAMP_ORDERING,
+      ProtocolType::OPTIMISTIC
   };
 
   // Make sure that ToString and FromString work
@@ -78,6 +78,79 @@ void *SimpleQueryTest(int port) {
   return NULL;
 }
 
+/**
+ * Pipelined query test
+ * All the queries are sent before reading any response
+ */
+void *PipelineQueryTest(int port) {
+  try {
+    pqxx::connection C(StringUtil::Format(
+        "host=127.0.0.1 port=%d user=postgres sslmode=disable", port));
+    LOG_INFO("[PipelineQueryTest] Connected to %s", C.dbname());
+    pqxx::work txn1(C);
+    txn1.exec("DROP TABLE IF EXISTS employee;");
+    txn1.exec("CREATE TABLE employee(id INT, name VARCHAR(100));");
+    txn1.commit();
+
+    pqxx::work txn2(C);
+    pqxx::pipeline P(txn2);
+    P.insert("INSERT INTO employee VALUES (1, 'Han LI');");
+    P.insert("INSERT INTO employee VALUES (2, 'Shaokun ZOU');");
+    P.insert("INSERT INTO employee VALUES (3, 'Yilei CHU');");
+    auto query_id = P.insert("SELECT name FROM employee;");
+    P.complete();
+
+    pqxx::result R = P.retrieve(query_id);
+    txn2.commit();
+
+    EXPECT_EQ(R.size(), 3);
+  } catch (const std::exception &e) {
+    LOG_INFO("[PipelineQueryTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  LOG_INFO("[PipelineQueryTest] Client has closed");
+  return NULL;
+}
+
+/**
+ * COPY FROM STDIN test
+ * The rows are sent in CopyData messages and loaded on CopyDone
+ */
+void *CopyInQueryTest(int port) {
+  try {
+    pqxx::connection C(StringUtil::Format(
+        "host=127.0.0.1 port=%d user=postgres sslmode=disable", port));
+    LOG_INFO("[CopyInQueryTest] Connected to %s", C.dbname());
+    pqxx::work txn1(C);
+    txn1.exec("DROP TABLE IF EXISTS employee;");
+    txn1.exec("CREATE TABLE employee(id INT, name VARCHAR(100));");
+    txn1.commit();
+
+    pqxx::work txn2(C);
+    {
+      pqxx::tablewriter W(txn2, "employee");
+      W.insert(std::vector<std::string>{"1", "Han LI"});
+      W.insert(std::vector<std::string>{"2", "Shaokun ZOU"});
+      W.insert(std::vector<std::string>{"3", "Yilei CHU"});
+      W.complete();
+    }
+    txn2.commit();
+
+    pqxx::work txn3(C);
+    pqxx::result R = txn3.exec("SELECT name FROM employee;");
+    txn3.commit();
+
+    EXPECT_EQ(R.size(), 3);
+  } catch (const std::exception &e) {
+    LOG_INFO("[CopyInQueryTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  LOG_INFO("[CopyInQueryTest] Client has closed");
+  return NULL;
+}
+
 /**
  * rollback test
  * YINGJUN: rewrite wanted.
@@ -172,6 +245,28 @@ TEST_F(SimpleQueryTests, SimpleQueryTest) {
   LOG_INFO("Peloton has shut down");
 }
 
+/**
+ * Queries pipelined by the client are run by the execution pool
+ */
+TEST_F(SimpleQueryTests, PipelineQueryTest) {
+  peloton::PelotonInit::Initialize();
+  LOG_INFO("Server initialized");
+  peloton::wire::LibeventServer libeventserver;
+
+  int port = 15721;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  PipelineQueryTest(port);
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
+
 ///**
 // * Scalability test
 // * Open 2 servers in threads concurrently
@@ -209,6 +304,27 @@ TEST_F(SimpleQueryTests, SimpleQueryTest) {
 //  peloton::PelotonInit::Shutdown();
 //  LOG_INFO("[ScalabilityTest] Peloton has shut down");
 //}
+/**
+ * Rows sent by the client through the copy sub-protocol are bulk loaded
+ */
+TEST_F(SimpleQueryTests, CopyInQueryTest) {
+  peloton::PelotonInit::Initialize();
+  LOG_INFO("Server initialized");
+  peloton::wire::LibeventServer libeventserver;
+
+  int port = 15721;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  CopyInQueryTest(port);
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
 
 }  // End test namespace
 }  // End peloton namespace